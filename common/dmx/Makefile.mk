@@ -1,11 +1,33 @@
 # LIBRARIES
 ##################################################
-common_libolacommon_la_SOURCES += common/dmx/RunLengthEncoder.cpp
+common_libolacommon_la_SOURCES += \
+    common/dmx/RunLengthEncoder.cpp \
+    common/dmx/SharedMemoryUniverseTable.cpp \
+    common/dmx/SlotKernels.cpp
+
+# PROGRAMS
+##################################################
+noinst_PROGRAMS += common/dmx/slot_kernel_benchmark
+
+common_dmx_slot_kernel_benchmark_SOURCES = common/dmx/slot_kernel_benchmark.cpp
+common_dmx_slot_kernel_benchmark_LDADD = common/libolacommon.la
 
 # TESTS
 ##################################################
-test_programs += common/dmx/RunLengthEncoderTester
+test_programs += \
+    common/dmx/RunLengthEncoderTester \
+    common/dmx/SharedMemoryUniverseTableTester \
+    common/dmx/SlotKernelsTester
 
 common_dmx_RunLengthEncoderTester_SOURCES = common/dmx/RunLengthEncoderTest.cpp
 common_dmx_RunLengthEncoderTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_dmx_RunLengthEncoderTester_LDADD = $(COMMON_TESTING_LIBS)
+
+common_dmx_SharedMemoryUniverseTableTester_SOURCES = \
+    common/dmx/SharedMemoryUniverseTableTest.cpp
+common_dmx_SharedMemoryUniverseTableTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+common_dmx_SharedMemoryUniverseTableTester_LDADD = $(COMMON_TESTING_LIBS)
+
+common_dmx_SlotKernelsTester_SOURCES = common/dmx/SlotKernelsTest.cpp
+common_dmx_SlotKernelsTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+common_dmx_SlotKernelsTester_LDADD = $(COMMON_TESTING_LIBS)
@@ -108,9 +108,15 @@ bool RunLengthEncoder::Decode(unsigned int start_channel,
     unsigned int segment_length = src_data[i] & (~REPEAT_FLAG);
     if (src_data[i] & REPEAT_FLAG) {
       i++;
+      if (i == length) {
+        return false;
+      }
       dst->SetRangeToValue(destination_index, src_data[i++], segment_length);
     } else {
       i++;
+      if (length - i < segment_length) {
+        return false;
+      }
       dst->SetRange(destination_index, src_data + i, segment_length);
       i += segment_length;
     }
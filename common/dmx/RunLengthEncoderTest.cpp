@@ -36,12 +36,14 @@ class RunLengthEncoderTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testEncode);
   CPPUNIT_TEST(testEncode2);
   CPPUNIT_TEST(testEncodeDecode);
+  CPPUNIT_TEST(testDecodeTruncated);
   CPPUNIT_TEST_SUITE_END();
 
  public:
     void testEncode();
     void testEncode2();
     void testEncodeDecode();
+    void testDecodeTruncated();
     void setUp();
     void tearDown();
  private:
@@ -169,3 +171,29 @@ void RunLengthEncoderTest::testEncodeDecode() {
   checkEncodeDecode(TEST_DATA2, sizeof(TEST_DATA2));
   checkEncodeDecode(TEST_DATA3, sizeof(TEST_DATA3));
 }
+
+
+/*
+ * Check that Decode fails if the data is truncated
+ */
+void RunLengthEncoderTest::testDecodeTruncated() {
+  DmxBuffer dst;
+
+  // A repeat with no value.
+  const uint8_t TRUNCATED_REPEAT[] = {0x02, 1, 2, 0x85};
+  OLA_ASSERT_FALSE(m_encoder.Decode(0, TRUNCATED_REPEAT,
+                                    sizeof(TRUNCATED_REPEAT), &dst));
+
+  // A literal run that's longer than the data.
+  const uint8_t TRUNCATED_RUN[] = {0x83, 7, 0x04, 1, 2};
+  dst.Reset();
+  OLA_ASSERT_FALSE(m_encoder.Decode(0, TRUNCATED_RUN, sizeof(TRUNCATED_RUN),
+                                    &dst));
+
+  // The complete data decodes.
+  const uint8_t COMPLETE[] = {0x83, 7, 0x02, 1, 2};
+  const uint8_t EXPECTED[] = {7, 7, 7, 1, 2};
+  dst.Reset();
+  OLA_ASSERT_TRUE(m_encoder.Decode(0, COMPLETE, sizeof(COMPLETE), &dst));
+  OLA_ASSERT_DATA_EQUALS(EXPECTED, sizeof(EXPECTED), dst.GetRaw(), dst.Size());
+}
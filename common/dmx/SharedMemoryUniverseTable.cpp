@@ -0,0 +1,490 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SharedMemoryUniverseTable.cpp
+ * DMX frames passed between processes through shared memory.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif  // HAVE_CONFIG_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#ifdef HAVE_SHM_OPEN
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif  // HAVE_SHM_OPEN
+
+#include <algorithm>
+#include <string>
+
+#include "ola/Constants.h"
+#include "ola/Logging.h"
+#include "ola/StringUtils.h"
+#include "ola/dmx/SharedMemoryUniverseTable.h"
+#include "ola/thread/Atomic.h"
+
+namespace ola {
+namespace dmx {
+
+using ola::io::UnmanagedFileDescriptor;
+using ola::thread::AtomicCompareExchange;
+using ola::thread::AtomicExchange;
+using ola::thread::AtomicFenceAcquire;
+using ola::thread::AtomicFenceRelease;
+using ola::thread::AtomicLoadAcquire;
+using ola::thread::AtomicLoadRelaxed;
+using ola::thread::AtomicStoreRelaxed;
+using ola::thread::AtomicStoreRelease;
+using std::string;
+
+namespace {
+const uint32_t TABLE_MAGIC = 0x4f4c4153;  // OLAS
+const uint32_t TABLE_VERSION = 1;
+
+// Slot states
+const uint32_t SLOT_FREE = 0;
+const uint32_t SLOT_CLAIMED = 1;  // being set up by the claimer
+const uint32_t SLOT_ACTIVE = 2;
+
+// How many times Read() retries if the writer is mid-frame.
+const unsigned int MAX_READ_ATTEMPTS = 100;
+}  // namespace
+
+/*
+ * The start of the shared memory, this is padded to a cache line.
+ */
+struct SharedMemoryUniverseTable::SegmentHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t slot_count;
+  uint32_t notify_pending;  // non-0 if a notification has been sent
+  uint8_t padding[48];
+};
+
+/*
+ * A single universe. The sequence number is odd while a frame is being
+ * written. The slot is padded to a multiple of the cache line size so writers
+ * to different slots don't share lines.
+ */
+struct SharedMemoryUniverseTable::Slot {
+  uint32_t state;
+  uint32_t owner;
+  uint32_t direction;
+  uint32_t universe;
+  uint32_t sequence;
+  uint16_t length;
+  uint8_t priority;
+  uint8_t reserved;
+  uint8_t data[DMX_UNIVERSE_SIZE];
+  uint8_t padding[40];
+};
+
+const unsigned int SharedMemoryUniverseTable::DEFAULT_SLOT_COUNT;
+const unsigned int SharedMemoryUniverseTable::INVALID_SLOT;
+
+
+SharedMemoryUniverseTable::SharedMemoryUniverseTable()
+    : m_header(NULL),
+      m_slots(NULL),
+      m_size(0),
+      m_creator(false),
+      m_notify_fd(-1) {
+}
+
+
+SharedMemoryUniverseTable::~SharedMemoryUniverseTable() {
+  Close();
+}
+
+
+bool SharedMemoryUniverseTable::Create(const string &name,
+                                       unsigned int slot_count) {
+  Close();
+#ifdef HAVE_SHM_OPEN
+  if (!slot_count) {
+    return false;
+  }
+
+  // Remove any table left behind by an olad that didn't exit cleanly.
+  shm_unlink(name.c_str());
+  int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (fd < 0) {
+    OLA_WARN << "Failed to create shared memory " << name << ": "
+             << strerror(errno);
+    return false;
+  }
+
+  size_t size = sizeof(SegmentHeader) + slot_count * sizeof(Slot);
+  if (ftruncate(fd, static_cast<off_t>(size)) < 0) {
+    OLA_WARN << "Failed to size shared memory " << name << ": "
+             << strerror(errno);
+    close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  if (!Map(fd, size)) {
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  m_creator = true;
+  m_name = name;
+  m_header->version = TABLE_VERSION;
+  m_header->slot_count = slot_count;
+
+  if (!OpenNotificationSocket(true)) {
+    Close();
+    return false;
+  }
+  // Clients check the magic last, so it's only set once everything is ready.
+  AtomicStoreRelease(&m_header->magic, TABLE_MAGIC);
+  return true;
+#else
+  OLA_WARN << "Shared memory isn't supported on this platform";
+  (void) name;
+  (void) slot_count;
+  return false;
+#endif  // HAVE_SHM_OPEN
+}
+
+
+bool SharedMemoryUniverseTable::Attach(const string &name) {
+  Close();
+#ifdef HAVE_SHM_OPEN
+  int fd = shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0) {
+    OLA_INFO << "Failed to open shared memory " << name << ": "
+             << strerror(errno);
+    return false;
+  }
+
+  struct stat stat_buf;
+  if (fstat(fd, &stat_buf) < 0 ||
+      stat_buf.st_size < static_cast<off_t>(sizeof(SegmentHeader))) {
+    OLA_WARN << "Shared memory " << name << " is too small";
+    close(fd);
+    return false;
+  }
+
+  size_t size = static_cast<size_t>(stat_buf.st_size);
+  if (!Map(fd, size)) {
+    return false;
+  }
+  m_name = name;
+
+  if (AtomicLoadAcquire(&m_header->magic) != TABLE_MAGIC ||
+      m_header->version != TABLE_VERSION ||
+      size < sizeof(SegmentHeader) + m_header->slot_count * sizeof(Slot)) {
+    OLA_WARN << "Shared memory " << name << " isn't a valid universe table";
+    Close();
+    return false;
+  }
+
+  if (!OpenNotificationSocket(false)) {
+    Close();
+    return false;
+  }
+  return true;
+#else
+  (void) name;
+  return false;
+#endif  // HAVE_SHM_OPEN
+}
+
+
+void SharedMemoryUniverseTable::Close() {
+#ifdef HAVE_SHM_OPEN
+  m_notify_descriptor.reset();
+  if (m_notify_fd >= 0) {
+    close(m_notify_fd);
+    m_notify_fd = -1;
+    if (m_creator) {
+      unlink(m_socket_path.c_str());
+    }
+  }
+
+  if (m_header) {
+    munmap(m_header, m_size);
+    if (m_creator) {
+      shm_unlink(m_name.c_str());
+    }
+  }
+#endif  // HAVE_SHM_OPEN
+  m_header = NULL;
+  m_slots = NULL;
+  m_size = 0;
+  m_creator = false;
+  m_name.clear();
+  m_socket_path.clear();
+}
+
+
+unsigned int SharedMemoryUniverseTable::SlotCount() const {
+  return m_header ? m_header->slot_count : 0;
+}
+
+
+unsigned int SharedMemoryUniverseTable::ClaimSlot(Direction direction,
+                                                  unsigned int universe) {
+  const unsigned int owner = static_cast<unsigned int>(getpid());
+  for (unsigned int i = 0; i < SlotCount(); i++) {
+    Slot *slot = m_slots + i;
+    uint32_t expected = SLOT_FREE;
+    if (AtomicCompareExchange(&slot->state, &expected, SLOT_CLAIMED)) {
+      slot->owner = owner;
+      slot->direction = direction;
+      slot->universe = universe;
+      slot->length = 0;
+      AtomicStoreRelease(&slot->state, SLOT_ACTIVE);
+      return i;
+    }
+  }
+  return INVALID_SLOT;
+}
+
+
+void SharedMemoryUniverseTable::ReleaseSlot(unsigned int slot_index) {
+  Slot *slot = GetSlot(slot_index);
+  if (slot) {
+    AtomicStoreRelease(&slot->state, SLOT_FREE);
+  }
+}
+
+
+bool SharedMemoryUniverseTable::ReclaimSlot(unsigned int slot_index,
+                                            unsigned int owner) {
+  Slot *slot = GetSlot(slot_index);
+  if (!slot || slot->owner != owner) {
+    return false;
+  }
+  uint32_t expected = SLOT_ACTIVE;
+  return AtomicCompareExchange(&slot->state, &expected, SLOT_FREE);
+}
+
+
+bool SharedMemoryUniverseTable::GetSlotInfo(unsigned int slot_index,
+                                            SlotInfo *info) const {
+  const Slot *slot = GetSlot(slot_index);
+  if (!slot || AtomicLoadAcquire(&slot->state) != SLOT_ACTIVE) {
+    return false;
+  }
+  info->direction = static_cast<Direction>(slot->direction);
+  info->universe = slot->universe;
+  info->owner = slot->owner;
+  return true;
+}
+
+
+void SharedMemoryUniverseTable::Write(unsigned int slot_index,
+                                      uint8_t priority,
+                                      const DmxBuffer &buffer) {
+  Slot *slot = GetSlot(slot_index);
+  if (!slot) {
+    return;
+  }
+
+  const uint32_t sequence = AtomicLoadRelaxed(&slot->sequence);
+  AtomicStoreRelaxed(&slot->sequence, sequence + 1);
+  AtomicFenceRelease();
+
+  unsigned int length = DMX_UNIVERSE_SIZE;
+  buffer.Get(slot->data, &length);
+  slot->length = static_cast<uint16_t>(length);
+  slot->priority = priority;
+
+  AtomicStoreRelease(&slot->sequence, sequence + 2);
+}
+
+
+bool SharedMemoryUniverseTable::Read(unsigned int slot_index,
+                                     uint32_t *sequence,
+                                     uint8_t *priority,
+                                     DmxBuffer *buffer) const {
+  const Slot *slot = GetSlot(slot_index);
+  if (!slot) {
+    return false;
+  }
+
+  uint8_t data[DMX_UNIVERSE_SIZE];
+  for (unsigned int i = 0; i < MAX_READ_ATTEMPTS; i++) {
+    const uint32_t start = AtomicLoadAcquire(&slot->sequence);
+    if (start & 1) {
+      continue;
+    }
+    if (start == *sequence) {
+      return false;
+    }
+
+    unsigned int length = std::min(
+        static_cast<unsigned int>(slot->length),
+        static_cast<unsigned int>(DMX_UNIVERSE_SIZE));
+    uint8_t frame_priority = slot->priority;
+    memcpy(data, slot->data, length);
+
+    AtomicFenceAcquire();
+    if (AtomicLoadRelaxed(&slot->sequence) != start) {
+      continue;
+    }
+
+    *sequence = start;
+    if (!length) {
+      // The slot has been claimed but nothing has been written yet.
+      return false;
+    }
+    *priority = frame_priority;
+    buffer->Set(data, length);
+    return true;
+  }
+  return false;
+}
+
+
+void SharedMemoryUniverseTable::Notify() {
+#ifdef HAVE_SHM_OPEN
+  if (!m_header || m_notify_fd < 0 || m_creator) {
+    return;
+  }
+
+  if (AtomicExchange(&m_header->notify_pending, static_cast<uint32_t>(1))) {
+    return;
+  }
+
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, m_socket_path.c_str(),
+          sizeof(address.sun_path) - 1);
+
+  uint8_t message = 0;
+  if (sendto(m_notify_fd, &message, sizeof(message), 0,
+             reinterpret_cast<struct sockaddr*>(&address),
+             sizeof(address)) < 0) {
+    // Try again with the next frame.
+    AtomicStoreRelease(&m_header->notify_pending, static_cast<uint32_t>(0));
+  }
+#endif  // HAVE_SHM_OPEN
+}
+
+
+void SharedMemoryUniverseTable::ClearNotifications() {
+#ifdef HAVE_SHM_OPEN
+  if (!m_header || m_notify_fd < 0) {
+    return;
+  }
+
+  uint8_t buffer[64];
+  while (recv(m_notify_fd, buffer, sizeof(buffer), 0) > 0) {}
+  // This is a full barrier, so the slots are read after it's cleared. Any
+  // writes we miss will send another notification.
+  AtomicExchange(&m_header->notify_pending, static_cast<uint32_t>(0));
+#endif  // HAVE_SHM_OPEN
+}
+
+
+string SharedMemoryUniverseTable::NameForPort(uint16_t port) {
+  return "/ola-dmx-" + IntToString(port);
+}
+
+
+bool SharedMemoryUniverseTable::Map(int fd, size_t size) {
+#ifdef HAVE_SHM_OPEN
+  void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    OLA_WARN << "Failed to map shared memory: " << strerror(errno);
+    return false;
+  }
+
+  m_header = reinterpret_cast<SegmentHeader*>(ptr);
+  m_slots = reinterpret_cast<Slot*>(m_header + 1);
+  m_size = size;
+  return true;
+#else
+  (void) fd;
+  (void) size;
+  return false;
+#endif  // HAVE_SHM_OPEN
+}
+
+
+/*
+ * Open the notification socket. The creator binds it, and registers a
+ * descriptor for it.
+ */
+bool SharedMemoryUniverseTable::OpenNotificationSocket(bool bind_socket) {
+#ifdef HAVE_SHM_OPEN
+  m_socket_path = SocketPath(m_name);
+  struct sockaddr_un address;
+  if (m_socket_path.size() >= sizeof(address.sun_path)) {
+    OLA_WARN << "Socket path " << m_socket_path << " is too long";
+    return false;
+  }
+
+  m_notify_fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+  if (m_notify_fd < 0) {
+    OLA_WARN << "Failed to create notification socket: " << strerror(errno);
+    return false;
+  }
+  ola::io::ConnectedDescriptor::SetNonBlocking(m_notify_fd);
+
+  if (!bind_socket) {
+    return true;
+  }
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strncpy(address.sun_path, m_socket_path.c_str(),
+          sizeof(address.sun_path) - 1);
+  unlink(m_socket_path.c_str());
+  if (bind(m_notify_fd, reinterpret_cast<struct sockaddr*>(&address),
+           sizeof(address)) < 0) {
+    OLA_WARN << "Failed to bind " << m_socket_path << ": " << strerror(errno);
+    close(m_notify_fd);
+    m_notify_fd = -1;
+    return false;
+  }
+  chmod(m_socket_path.c_str(), 0600);
+  m_notify_descriptor.reset(new UnmanagedFileDescriptor(m_notify_fd));
+  return true;
+#else
+  (void) bind_socket;
+  return false;
+#endif  // HAVE_SHM_OPEN
+}
+
+
+SharedMemoryUniverseTable::Slot *SharedMemoryUniverseTable::GetSlot(
+    unsigned int slot) const {
+  return slot < SlotCount() ? m_slots + slot : NULL;
+}
+
+
+/*
+ * The notification socket lives in /tmp, alongside the shared memory.
+ */
+string SharedMemoryUniverseTable::SocketPath(const string &name) {
+  return "/tmp" + name + ".sock";
+}
+}  // namespace dmx
+}  // namespace ola
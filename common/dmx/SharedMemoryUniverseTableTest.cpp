@@ -0,0 +1,278 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SharedMemoryUniverseTableTest.cpp
+ * Test fixture for the SharedMemoryUniverseTable class.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+
+#include "ola/Constants.h"
+#include "ola/DmxBuffer.h"
+#include "ola/StringUtils.h"
+#include "ola/dmx/SharedMemoryUniverseTable.h"
+#include "ola/io/SelectServer.h"
+#include "ola/testing/TestUtils.h"
+#include "ola/thread/Thread.h"
+
+using ola::DmxBuffer;
+using ola::dmx::SharedMemoryUniverseTable;
+using std::string;
+
+class SharedMemoryUniverseTableTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(SharedMemoryUniverseTableTest);
+  CPPUNIT_TEST(testAttach);
+  CPPUNIT_TEST(testSlots);
+  CPPUNIT_TEST(testReadWrite);
+  CPPUNIT_TEST(testNotify);
+  CPPUNIT_TEST(testThreaded);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void setUp();
+    void tearDown();
+    void testAttach();
+    void testSlots();
+    void testReadWrite();
+    void testNotify();
+    void testThreaded();
+
+ private:
+    string m_name;
+    SharedMemoryUniverseTable m_table;
+    SharedMemoryUniverseTable m_client;
+
+    void Terminate(ola::io::SelectServer *ss) { ss->Terminate(); }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SharedMemoryUniverseTableTest);
+
+
+/*
+ * Writes frames where every slot holds the frame number.
+ */
+class SlotWriterThread: public ola::thread::Thread {
+ public:
+    SlotWriterThread(SharedMemoryUniverseTable *table, unsigned int slot)
+        : Thread(),
+          m_table(table),
+          m_slot(slot) {
+    }
+
+    void *Run() {
+      uint8_t data[ola::DMX_UNIVERSE_SIZE];
+      DmxBuffer buffer;
+      for (unsigned int i = 1; i <= FRAMES; i++) {
+        memset(data, i, sizeof(data));
+        buffer.Set(data, sizeof(data));
+        m_table->Write(m_slot, 100, buffer);
+      }
+      return NULL;
+    }
+
+    static const unsigned int FRAMES = 255;
+
+ private:
+    SharedMemoryUniverseTable *m_table;
+    unsigned int m_slot;
+};
+
+
+void SharedMemoryUniverseTableTest::setUp() {
+  m_name = "/ola-dmx-test-" + ola::IntToString(getpid());
+  OLA_ASSERT_TRUE(m_table.Create(m_name, 4));
+  OLA_ASSERT_TRUE(m_client.Attach(m_name));
+}
+
+
+void SharedMemoryUniverseTableTest::tearDown() {
+  m_client.Close();
+  m_table.Close();
+}
+
+
+/*
+ * Check attaching to tables.
+ */
+void SharedMemoryUniverseTableTest::testAttach() {
+  OLA_ASSERT_TRUE(m_table.IsOpen());
+  OLA_ASSERT_TRUE(m_client.IsOpen());
+  OLA_ASSERT_EQ(4u, m_table.SlotCount());
+  OLA_ASSERT_EQ(4u, m_client.SlotCount());
+  OLA_ASSERT_NOT_NULL(m_table.NotificationDescriptor());
+  OLA_ASSERT_NULL(m_client.NotificationDescriptor());
+
+  SharedMemoryUniverseTable other;
+  OLA_ASSERT_FALSE(other.Attach(m_name + "-missing"));
+  OLA_ASSERT_FALSE(other.IsOpen());
+
+  OLA_ASSERT_EQ(string("/ola-dmx-9010"),
+                SharedMemoryUniverseTable::NameForPort(9010));
+
+  // Once the creator closes the table, new clients can't attach.
+  m_table.Close();
+  OLA_ASSERT_FALSE(other.Attach(m_name));
+}
+
+
+/*
+ * Check claiming and releasing slots.
+ */
+void SharedMemoryUniverseTableTest::testSlots() {
+  SharedMemoryUniverseTable::SlotInfo info;
+  OLA_ASSERT_FALSE(m_table.GetSlotInfo(0, &info));
+
+  unsigned int slot = m_client.ClaimSlot(
+      SharedMemoryUniverseTable::INPUT_SLOT, 1);
+  OLA_ASSERT_EQ(0u, slot);
+  OLA_ASSERT_TRUE(m_table.GetSlotInfo(slot, &info));
+  OLA_ASSERT_EQ(SharedMemoryUniverseTable::INPUT_SLOT, info.direction);
+  OLA_ASSERT_EQ(1u, info.universe);
+  OLA_ASSERT_EQ(static_cast<unsigned int>(getpid()), info.owner);
+
+  OLA_ASSERT_EQ(1u, m_client.ClaimSlot(
+      SharedMemoryUniverseTable::INPUT_SLOT, 2));
+  OLA_ASSERT_EQ(2u, m_client.ClaimSlot(
+      SharedMemoryUniverseTable::INPUT_SLOT, 3));
+  OLA_ASSERT_EQ(3u, m_client.ClaimSlot(
+      SharedMemoryUniverseTable::INPUT_SLOT, 4));
+  OLA_ASSERT_EQ(SharedMemoryUniverseTable::INVALID_SLOT,
+                m_client.ClaimSlot(SharedMemoryUniverseTable::INPUT_SLOT, 5));
+
+  m_client.ReleaseSlot(1);
+  OLA_ASSERT_FALSE(m_table.GetSlotInfo(1, &info));
+  OLA_ASSERT_EQ(1u, m_client.ClaimSlot(
+      SharedMemoryUniverseTable::INPUT_SLOT, 5));
+  OLA_ASSERT_TRUE(m_table.GetSlotInfo(1, &info));
+  OLA_ASSERT_EQ(5u, info.universe);
+
+  // Slots can only be reclaimed from their owner.
+  OLA_ASSERT_FALSE(m_table.ReclaimSlot(2, info.owner + 1));
+  OLA_ASSERT_TRUE(m_table.ReclaimSlot(2, info.owner));
+  OLA_ASSERT_FALSE(m_table.GetSlotInfo(2, &info));
+  OLA_ASSERT_FALSE(m_table.ReclaimSlot(2, info.owner));
+
+  OLA_ASSERT_FALSE(m_table.GetSlotInfo(10, &info));
+}
+
+
+/*
+ * Check frames are passed between the two ends.
+ */
+void SharedMemoryUniverseTableTest::testReadWrite() {
+  unsigned int slot = m_client.ClaimSlot(
+      SharedMemoryUniverseTable::INPUT_SLOT, 1);
+  uint32_t sequence = 0;
+  uint8_t priority = 0;
+  DmxBuffer buffer;
+  OLA_ASSERT_FALSE(m_table.Read(slot, &sequence, &priority, &buffer));
+
+  DmxBuffer frame;
+  frame.SetFromString("1,2,3,4");
+  m_client.Write(slot, 150, frame);
+  OLA_ASSERT_TRUE(m_table.Read(slot, &sequence, &priority, &buffer));
+  OLA_ASSERT_EQ(frame, buffer);
+  OLA_ASSERT_EQ(static_cast<uint8_t>(150), priority);
+
+  // Nothing has changed
+  OLA_ASSERT_FALSE(m_table.Read(slot, &sequence, &priority, &buffer));
+
+  frame.SetRangeToValue(0, 255, ola::DMX_UNIVERSE_SIZE);
+  m_client.Write(slot, 100, frame);
+  frame.SetChannel(10, 10);
+  m_client.Write(slot, 100, frame);
+  OLA_ASSERT_TRUE(m_table.Read(slot, &sequence, &priority, &buffer));
+  OLA_ASSERT_EQ(frame, buffer);
+  OLA_ASSERT_EQ(static_cast<uint8_t>(100), priority);
+
+  // A newly claimed slot doesn't return the old data.
+  m_client.ReleaseSlot(slot);
+  slot = m_client.ClaimSlot(SharedMemoryUniverseTable::INPUT_SLOT, 2);
+  sequence = 0;
+  OLA_ASSERT_FALSE(m_table.Read(slot, &sequence, &priority, &buffer));
+
+  frame.SetFromString("5,6");
+  m_client.Write(slot, 120, frame);
+  OLA_ASSERT_TRUE(m_table.Read(slot, &sequence, &priority, &buffer));
+  OLA_ASSERT_EQ(frame, buffer);
+  OLA_ASSERT_EQ(static_cast<uint8_t>(120), priority);
+
+  OLA_ASSERT_FALSE(m_table.Read(10, &sequence, &priority, &buffer));
+}
+
+
+/*
+ * Check notifications wake up the creator, and are coalesced.
+ */
+void SharedMemoryUniverseTableTest::testNotify() {
+  ola::io::SelectServer ss;
+  ola::io::UnmanagedFileDescriptor *descriptor =
+      m_table.NotificationDescriptor();
+  descriptor->SetOnData(ola::NewCallback(
+      this, &SharedMemoryUniverseTableTest::Terminate, &ss));
+  ss.AddReadDescriptor(descriptor);
+
+  m_client.Notify();
+  m_client.Notify();
+  ss.Run();
+
+  // Once cleared, the descriptor isn't readable.
+  m_table.ClearNotifications();
+  ss.RegisterSingleTimeout(
+      50, ola::NewSingleCallback(
+          this, &SharedMemoryUniverseTableTest::Terminate, &ss));
+  ss.Run();
+
+  // Once cleared, a new notification is sent.
+  m_client.Notify();
+  ss.Run();
+  ss.RemoveReadDescriptor(descriptor);
+}
+
+
+/*
+ * Check the reader never sees a partially written frame.
+ */
+void SharedMemoryUniverseTableTest::testThreaded() {
+  unsigned int slot = m_client.ClaimSlot(
+      SharedMemoryUniverseTable::INPUT_SLOT, 1);
+  SlotWriterThread writer(&m_client, slot);
+  OLA_ASSERT_TRUE(writer.Start());
+
+  uint32_t sequence = 0;
+  uint8_t priority;
+  DmxBuffer buffer;
+  unsigned int last_frame = 0;
+  while (last_frame < SlotWriterThread::FRAMES) {
+    if (!m_table.Read(slot, &sequence, &priority, &buffer)) {
+      sched_yield();
+      continue;
+    }
+    OLA_ASSERT_EQ(static_cast<unsigned int>(ola::DMX_UNIVERSE_SIZE),
+                  buffer.Size());
+    unsigned int frame = buffer.Get(0);
+    OLA_ASSERT_GT(frame, last_frame);
+    for (unsigned int i = 1; i < buffer.Size(); i++) {
+      OLA_ASSERT_EQ(frame, static_cast<unsigned int>(buffer.Get(i)));
+    }
+    last_frame = frame;
+  }
+  OLA_ASSERT_TRUE(writer.Join());
+}
@@ -0,0 +1,571 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SlotKernels.cpp
+ * Bulk operations on arrays of DMX slots.
+ * Copyright (C) 2026 Simon Newton
+ *
+ * Each implementation provides the same set of functions, the dispatch table
+ * is chosen the first time a kernel is used. The vector implementations only
+ * handle whole vectors, the remaining slots are passed to the scalar
+ * functions.
+ *
+ * The AVX2 functions are compiled with the target attribute rather than
+ * -mavx2, so the rest of the library still runs on CPUs without AVX2.
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <string>
+
+#include "ola/dmx/SlotKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && \
+    defined(__SSE2__)
+#define OLA_SLOT_KERNELS_SSE2
+#include <emmintrin.h>
+#if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9)) || \
+    defined(__clang__)
+#define OLA_SLOT_KERNELS_AVX2
+#include <immintrin.h>
+#endif  // GCC 4.9 or clang
+#endif  // x86 with SSE2
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define OLA_SLOT_KERNELS_NEON
+#include <arm_neon.h>
+#endif  // __ARM_NEON
+
+namespace ola {
+namespace dmx {
+
+using std::max;
+using std::string;
+
+namespace {
+
+typedef struct {
+  SlotKernelType type;
+  void (*max_slots)(uint8_t *dest, const uint8_t *src, unsigned int length);
+  void (*max_slots_many)(uint8_t *dest, const uint8_t *const *sources,
+                         const unsigned int *lengths, unsigned int count,
+                         unsigned int length);
+  bool (*slots_equal)(const uint8_t *a, const uint8_t *b,
+                      unsigned int length);
+  void (*slot_diff_mask)(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                         unsigned int length);
+  unsigned int (*changed_slot_bitmap)(const uint8_t *old_slots,
+                                      const uint8_t *new_slots,
+                                      uint8_t *bitmap,
+                                      unsigned int length);
+} slot_kernels;
+
+
+// Scalar
+//-----------------------------------------------------------------------------
+void ScalarMaxSlots(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  for (unsigned int i = 0; i < length; i++) {
+    dest[i] = max(dest[i], src[i]);
+  }
+}
+
+/*
+ * Merge slots [offset, length) of each source. This is used for the tail of
+ * the vector implementations, as well as by the scalar one.
+ */
+void ScalarMaxSlotsRange(uint8_t *dest, const uint8_t *const *sources,
+                         const unsigned int *lengths, unsigned int count,
+                         unsigned int offset, unsigned int length) {
+  for (unsigned int slot = offset; slot < length; slot++) {
+    uint8_t value = 0;
+    for (unsigned int i = 0; i < count; i++) {
+      if (slot < lengths[i]) {
+        value = max(value, sources[i][slot]);
+      }
+    }
+    dest[slot] = value;
+  }
+}
+
+void ScalarMaxSlotsMany(uint8_t *dest, const uint8_t *const *sources,
+                        const unsigned int *lengths, unsigned int count,
+                        unsigned int length) {
+  ScalarMaxSlotsRange(dest, sources, lengths, count, 0, length);
+}
+
+bool ScalarSlotsEqual(const uint8_t *a, const uint8_t *b,
+                      unsigned int length) {
+  return 0 == memcmp(a, b, length);
+}
+
+void ScalarSlotDiffMask(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                        unsigned int length) {
+  for (unsigned int i = 0; i < length; i++) {
+    mask[i] = a[i] == b[i] ? 0 : 0xff;
+  }
+}
+
+/*
+ * Set the bits for slots [offset, length), offset must be a multiple of 8.
+ */
+unsigned int ScalarChangedSlotBitmapRange(const uint8_t *old_slots,
+                                          const uint8_t *new_slots,
+                                          uint8_t *bitmap,
+                                          unsigned int offset,
+                                          unsigned int length) {
+  unsigned int changed = 0;
+  for (unsigned int i = offset; i < length; i += 8) {
+    uint8_t bits = 0;
+    for (unsigned int j = 0; j < 8 && i + j < length; j++) {
+      if (old_slots[i + j] != new_slots[i + j]) {
+        bits |= (1 << j);
+        changed++;
+      }
+    }
+    bitmap[i / 8] = bits;
+  }
+  return changed;
+}
+
+unsigned int ScalarChangedSlotBitmap(const uint8_t *old_slots,
+                                     const uint8_t *new_slots,
+                                     uint8_t *bitmap,
+                                     unsigned int length) {
+  return ScalarChangedSlotBitmapRange(old_slots, new_slots, bitmap, 0, length);
+}
+
+const slot_kernels SCALAR_KERNELS = {
+  SLOT_KERNEL_SCALAR,
+  ScalarMaxSlots,
+  ScalarMaxSlotsMany,
+  ScalarSlotsEqual,
+  ScalarSlotDiffMask,
+  ScalarChangedSlotBitmap,
+};
+
+
+#ifdef OLA_SLOT_KERNELS_SSE2
+// SSE2
+//-----------------------------------------------------------------------------
+const unsigned int SSE2_WIDTH = sizeof(__m128i);
+
+void SSE2MaxSlots(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  unsigned int i = 0;
+  for (; i + SSE2_WIDTH <= length; i += SSE2_WIDTH) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i),
+                     _mm_max_epu8(a, b));
+  }
+  ScalarMaxSlots(dest + i, src + i, length - i);
+}
+
+void SSE2MaxSlotsMany(uint8_t *dest, const uint8_t *const *sources,
+                      const unsigned int *lengths, unsigned int count,
+                      unsigned int length) {
+  unsigned int slot = 0;
+  for (; slot + SSE2_WIDTH <= length; slot += SSE2_WIDTH) {
+    __m128i value = _mm_setzero_si128();
+    for (unsigned int i = 0; i < count; i++) {
+      if (slot + SSE2_WIDTH <= lengths[i]) {
+        value = _mm_max_epu8(value, _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(sources[i] + slot)));
+      } else if (slot < lengths[i]) {
+        // this source ends part way through the vector
+        uint8_t lane[SSE2_WIDTH] = {0};
+        memcpy(lane, sources[i] + slot, lengths[i] - slot);
+        value = _mm_max_epu8(value, _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(lane)));
+      }
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + slot), value);
+  }
+  ScalarMaxSlotsRange(dest, sources, lengths, count, slot, length);
+}
+
+bool SSE2SlotsEqual(const uint8_t *a, const uint8_t *b, unsigned int length) {
+  unsigned int i = 0;
+  for (; i + SSE2_WIDTH <= length; i += SSE2_WIDTH) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) != 0xffff) {
+      return false;
+    }
+  }
+  return ScalarSlotsEqual(a + i, b + i, length - i);
+}
+
+void SSE2SlotDiffMask(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                      unsigned int length) {
+  const __m128i ones = _mm_set1_epi8(static_cast<char>(0xff));
+  unsigned int i = 0;
+  for (; i + SSE2_WIDTH <= length; i += SSE2_WIDTH) {
+    __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+    __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(mask + i),
+                     _mm_xor_si128(_mm_cmpeq_epi8(x, y), ones));
+  }
+  ScalarSlotDiffMask(a + i, b + i, mask + i, length - i);
+}
+
+unsigned int SSE2ChangedSlotBitmap(const uint8_t *old_slots,
+                                   const uint8_t *new_slots,
+                                   uint8_t *bitmap,
+                                   unsigned int length) {
+  unsigned int changed = 0;
+  unsigned int i = 0;
+  for (; i + SSE2_WIDTH <= length; i += SSE2_WIDTH) {
+    __m128i x = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(old_slots + i));
+    __m128i y = _mm_loadu_si128(
+        reinterpret_cast<const __m128i*>(new_slots + i));
+    unsigned int bits = ~_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xffff;
+    bitmap[i / 8] = bits & 0xff;
+    bitmap[i / 8 + 1] = bits >> 8;
+    changed += __builtin_popcount(bits);
+  }
+  return changed + ScalarChangedSlotBitmapRange(old_slots, new_slots, bitmap,
+                                                i, length);
+}
+
+const slot_kernels SSE2_KERNELS = {
+  SLOT_KERNEL_SSE2,
+  SSE2MaxSlots,
+  SSE2MaxSlotsMany,
+  SSE2SlotsEqual,
+  SSE2SlotDiffMask,
+  SSE2ChangedSlotBitmap,
+};
+#endif  // OLA_SLOT_KERNELS_SSE2
+
+
+#ifdef OLA_SLOT_KERNELS_AVX2
+// AVX2
+//-----------------------------------------------------------------------------
+#define OLA_AVX2 __attribute__((target("avx2")))
+
+const unsigned int AVX2_WIDTH = sizeof(__m256i);
+
+OLA_AVX2 void AVX2MaxSlots(uint8_t *dest, const uint8_t *src,
+                           unsigned int length) {
+  unsigned int i = 0;
+  for (; i + AVX2_WIDTH <= length; i += AVX2_WIDTH) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i));
+    __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i),
+                        _mm256_max_epu8(a, b));
+  }
+  SSE2MaxSlots(dest + i, src + i, length - i);
+}
+
+OLA_AVX2 void AVX2MaxSlotsMany(uint8_t *dest, const uint8_t *const *sources,
+                               const unsigned int *lengths, unsigned int count,
+                               unsigned int length) {
+  unsigned int slot = 0;
+  for (; slot + AVX2_WIDTH <= length; slot += AVX2_WIDTH) {
+    __m256i value = _mm256_setzero_si256();
+    for (unsigned int i = 0; i < count; i++) {
+      if (slot + AVX2_WIDTH <= lengths[i]) {
+        value = _mm256_max_epu8(value, _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(sources[i] + slot)));
+      } else if (slot < lengths[i]) {
+        uint8_t lane[AVX2_WIDTH] = {0};
+        memcpy(lane, sources[i] + slot, lengths[i] - slot);
+        value = _mm256_max_epu8(value, _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(lane)));
+      }
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + slot), value);
+  }
+  ScalarMaxSlotsRange(dest, sources, lengths, count, slot, length);
+}
+
+OLA_AVX2 bool AVX2SlotsEqual(const uint8_t *a, const uint8_t *b,
+                             unsigned int length) {
+  unsigned int i = 0;
+  for (; i + AVX2_WIDTH <= length; i += AVX2_WIDTH) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    if (~_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y))) {
+      return false;
+    }
+  }
+  return SSE2SlotsEqual(a + i, b + i, length - i);
+}
+
+OLA_AVX2 void AVX2SlotDiffMask(const uint8_t *a, const uint8_t *b,
+                               uint8_t *mask, unsigned int length) {
+  const __m256i ones = _mm256_set1_epi8(static_cast<char>(0xff));
+  unsigned int i = 0;
+  for (; i + AVX2_WIDTH <= length; i += AVX2_WIDTH) {
+    __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(mask + i),
+                        _mm256_xor_si256(_mm256_cmpeq_epi8(x, y), ones));
+  }
+  SSE2SlotDiffMask(a + i, b + i, mask + i, length - i);
+}
+
+OLA_AVX2 unsigned int AVX2ChangedSlotBitmap(const uint8_t *old_slots,
+                                            const uint8_t *new_slots,
+                                            uint8_t *bitmap,
+                                            unsigned int length) {
+  unsigned int changed = 0;
+  unsigned int i = 0;
+  for (; i + AVX2_WIDTH <= length; i += AVX2_WIDTH) {
+    __m256i x = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(old_slots + i));
+    __m256i y = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(new_slots + i));
+    uint32_t bits = ~static_cast<uint32_t>(
+        _mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+    bitmap[i / 8] = bits & 0xff;
+    bitmap[i / 8 + 1] = (bits >> 8) & 0xff;
+    bitmap[i / 8 + 2] = (bits >> 16) & 0xff;
+    bitmap[i / 8 + 3] = bits >> 24;
+    changed += __builtin_popcount(bits);
+  }
+  return changed + SSE2ChangedSlotBitmap(old_slots + i, new_slots + i,
+                                         bitmap + i / 8, length - i);
+}
+
+const slot_kernels AVX2_KERNELS = {
+  SLOT_KERNEL_AVX2,
+  AVX2MaxSlots,
+  AVX2MaxSlotsMany,
+  AVX2SlotsEqual,
+  AVX2SlotDiffMask,
+  AVX2ChangedSlotBitmap,
+};
+#endif  // OLA_SLOT_KERNELS_AVX2
+
+
+#ifdef OLA_SLOT_KERNELS_NEON
+// NEON
+//-----------------------------------------------------------------------------
+const unsigned int NEON_WIDTH = sizeof(uint8x16_t);
+
+void NEONMaxSlots(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  unsigned int i = 0;
+  for (; i + NEON_WIDTH <= length; i += NEON_WIDTH) {
+    vst1q_u8(dest + i, vmaxq_u8(vld1q_u8(dest + i), vld1q_u8(src + i)));
+  }
+  ScalarMaxSlots(dest + i, src + i, length - i);
+}
+
+void NEONMaxSlotsMany(uint8_t *dest, const uint8_t *const *sources,
+                      const unsigned int *lengths, unsigned int count,
+                      unsigned int length) {
+  unsigned int slot = 0;
+  for (; slot + NEON_WIDTH <= length; slot += NEON_WIDTH) {
+    uint8x16_t value = vdupq_n_u8(0);
+    for (unsigned int i = 0; i < count; i++) {
+      if (slot + NEON_WIDTH <= lengths[i]) {
+        value = vmaxq_u8(value, vld1q_u8(sources[i] + slot));
+      } else if (slot < lengths[i]) {
+        uint8_t lane[NEON_WIDTH] = {0};
+        memcpy(lane, sources[i] + slot, lengths[i] - slot);
+        value = vmaxq_u8(value, vld1q_u8(lane));
+      }
+    }
+    vst1q_u8(dest + slot, value);
+  }
+  ScalarMaxSlotsRange(dest, sources, lengths, count, slot, length);
+}
+
+bool NEONSlotsEqual(const uint8_t *a, const uint8_t *b, unsigned int length) {
+  unsigned int i = 0;
+  for (; i + NEON_WIDTH <= length; i += NEON_WIDTH) {
+    uint8x16_t diff = veorq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+    uint64x2_t wide = vreinterpretq_u64_u8(diff);
+    if (vgetq_lane_u64(wide, 0) | vgetq_lane_u64(wide, 1)) {
+      return false;
+    }
+  }
+  return ScalarSlotsEqual(a + i, b + i, length - i);
+}
+
+void NEONSlotDiffMask(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                      unsigned int length) {
+  unsigned int i = 0;
+  for (; i + NEON_WIDTH <= length; i += NEON_WIDTH) {
+    vst1q_u8(mask + i, vmvnq_u8(vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i))));
+  }
+  ScalarSlotDiffMask(a + i, b + i, mask + i, length - i);
+}
+
+unsigned int NEONChangedSlotBitmap(const uint8_t *old_slots,
+                                   const uint8_t *new_slots,
+                                   uint8_t *bitmap,
+                                   unsigned int length) {
+  // NEON has no movemask, so AND each lane with its bit and add pairs of
+  // lanes together until each half of the vector is a single byte.
+  static const uint8_t BIT_VALUES[] = {
+    1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128,
+  };
+  const uint8x16_t bit_values = vld1q_u8(BIT_VALUES);
+  unsigned int changed = 0;
+  unsigned int i = 0;
+  for (; i + NEON_WIDTH <= length; i += NEON_WIDTH) {
+    uint8x16_t diff = vmvnq_u8(vceqq_u8(vld1q_u8(old_slots + i),
+                                        vld1q_u8(new_slots + i)));
+    uint8x16_t bits = vandq_u8(diff, bit_values);
+    uint8x8_t sum = vpadd_u8(vget_low_u8(bits), vget_high_u8(bits));
+    sum = vpadd_u8(sum, sum);
+    sum = vpadd_u8(sum, sum);
+    bitmap[i / 8] = vget_lane_u8(sum, 0);
+    bitmap[i / 8 + 1] = vget_lane_u8(sum, 1);
+    changed += __builtin_popcount(bitmap[i / 8]) +
+               __builtin_popcount(bitmap[i / 8 + 1]);
+  }
+  return changed + ScalarChangedSlotBitmapRange(old_slots, new_slots, bitmap,
+                                                i, length);
+}
+
+const slot_kernels NEON_KERNELS = {
+  SLOT_KERNEL_NEON,
+  NEONMaxSlots,
+  NEONMaxSlotsMany,
+  NEONSlotsEqual,
+  NEONSlotDiffMask,
+  NEONChangedSlotBitmap,
+};
+#endif  // OLA_SLOT_KERNELS_NEON
+
+
+// Dispatch
+//-----------------------------------------------------------------------------
+const slot_kernels *KernelsFor(SlotKernelType type) {
+  switch (type) {
+    case SLOT_KERNEL_SCALAR:
+      return &SCALAR_KERNELS;
+#ifdef OLA_SLOT_KERNELS_SSE2
+    case SLOT_KERNEL_SSE2:
+      return &SSE2_KERNELS;
+#endif  // OLA_SLOT_KERNELS_SSE2
+#ifdef OLA_SLOT_KERNELS_AVX2
+    case SLOT_KERNEL_AVX2:
+      __builtin_cpu_init();
+      return __builtin_cpu_supports("avx2") ? &AVX2_KERNELS : NULL;
+#endif  // OLA_SLOT_KERNELS_AVX2
+#ifdef OLA_SLOT_KERNELS_NEON
+    case SLOT_KERNEL_NEON:
+      return &NEON_KERNELS;
+#endif  // OLA_SLOT_KERNELS_NEON
+    default:
+      return NULL;
+  }
+}
+
+const slot_kernels *SelectKernels() {
+  const SlotKernelType preferred[] = {
+    SLOT_KERNEL_AVX2,
+    SLOT_KERNEL_SSE2,
+    SLOT_KERNEL_NEON,
+  };
+  for (unsigned int i = 0; i < sizeof(preferred) / sizeof(preferred[0]);
+       i++) {
+    const slot_kernels *kernels = KernelsFor(preferred[i]);
+    if (kernels) {
+      return kernels;
+    }
+  }
+  return &SCALAR_KERNELS;
+}
+
+/*
+ * The kernels for this CPU. The kernels may be used from more than one thread,
+ * so this is selected by a function local static, which is initialized
+ * exactly once.
+ */
+const slot_kernels *DefaultKernels() {
+  static const slot_kernels *kernels = SelectKernels();
+  return kernels;
+}
+
+// Set by SetSlotKernel(), before any other threads are started.
+const slot_kernels *override_kernels = NULL;
+
+inline const slot_kernels *Kernels() {
+  return override_kernels ? override_kernels : DefaultKernels();
+}
+}  // namespace
+
+
+bool SlotKernelSupported(SlotKernelType type) {
+  return KernelsFor(type) != NULL;
+}
+
+SlotKernelType ActiveSlotKernel() {
+  return Kernels()->type;
+}
+
+bool SetSlotKernel(SlotKernelType type) {
+  const slot_kernels *kernels = KernelsFor(type);
+  if (!kernels) {
+    return false;
+  }
+  override_kernels = kernels;
+  return true;
+}
+
+string SlotKernelName(SlotKernelType type) {
+  switch (type) {
+    case SLOT_KERNEL_SCALAR:
+      return "scalar";
+    case SLOT_KERNEL_SSE2:
+      return "SSE2";
+    case SLOT_KERNEL_AVX2:
+      return "AVX2";
+    case SLOT_KERNEL_NEON:
+      return "NEON";
+    default:
+      return "unknown";
+  }
+}
+
+void MaxSlots(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  Kernels()->max_slots(dest, src, length);
+}
+
+unsigned int MaxSlotsMany(uint8_t *dest,
+                          const uint8_t *const *sources,
+                          const unsigned int *lengths,
+                          unsigned int count) {
+  unsigned int length = 0;
+  for (unsigned int i = 0; i < count; i++) {
+    length = max(length, lengths[i]);
+  }
+  Kernels()->max_slots_many(dest, sources, lengths, count, length);
+  return length;
+}
+
+bool SlotsEqual(const uint8_t *a, const uint8_t *b, unsigned int length) {
+  return Kernels()->slots_equal(a, b, length);
+}
+
+void SlotDiffMask(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                  unsigned int length) {
+  Kernels()->slot_diff_mask(a, b, mask, length);
+}
+
+unsigned int ChangedSlotBitmap(const uint8_t *old_slots,
+                               const uint8_t *new_slots,
+                               uint8_t *bitmap,
+                               unsigned int length) {
+  return Kernels()->changed_slot_bitmap(old_slots, new_slots, bitmap, length);
+}
+}  // namespace dmx
+}  // namespace ola
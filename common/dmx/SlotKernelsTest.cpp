@@ -0,0 +1,247 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SlotKernelsTest.cpp
+ * Test fixture for the slot kernels.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+
+#include "ola/Constants.h"
+#include "ola/base/Array.h"
+#include "ola/dmx/SlotKernels.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::DMX_UNIVERSE_SIZE;
+using ola::dmx::ActiveSlotKernel;
+using ola::dmx::ChangedSlotBitmap;
+using ola::dmx::MaxSlots;
+using ola::dmx::MaxSlotsMany;
+using ola::dmx::SetSlotKernel;
+using ola::dmx::SlotDiffMask;
+using ola::dmx::SlotKernelType;
+using ola::dmx::SlotsEqual;
+
+class SlotKernelsTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(SlotKernelsTest);
+  CPPUNIT_TEST(testMaxSlots);
+  CPPUNIT_TEST(testMaxSlotsMany);
+  CPPUNIT_TEST(testSlotsEqual);
+  CPPUNIT_TEST(testSlotDiffMask);
+  CPPUNIT_TEST(testChangedSlotBitmap);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void setUp();
+    void tearDown();
+    void testMaxSlots();
+    void testMaxSlotsMany();
+    void testSlotsEqual();
+    void testSlotDiffMask();
+    void testChangedSlotBitmap();
+
+ private:
+    static const unsigned int SOURCE_COUNT = 5;
+
+    SlotKernelType m_original_kernel;
+    uint8_t m_sources[SOURCE_COUNT][DMX_UNIVERSE_SIZE];
+
+    static const SlotKernelType ALL_KERNELS[];
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(SlotKernelsTest);
+
+const SlotKernelType SlotKernelsTest::ALL_KERNELS[] = {
+  ola::dmx::SLOT_KERNEL_SCALAR,
+  ola::dmx::SLOT_KERNEL_SSE2,
+  ola::dmx::SLOT_KERNEL_AVX2,
+  ola::dmx::SLOT_KERNEL_NEON,
+};
+
+// Lengths which cover the vector widths and the tail handling.
+static const unsigned int LENGTHS[] = {0, 1, 15, 16, 17, 31, 32, 33, 100, 511,
+                                       512};
+
+
+void SlotKernelsTest::setUp() {
+  m_original_kernel = ActiveSlotKernel();
+  srandom(42);
+  for (unsigned int i = 0; i < SOURCE_COUNT; i++) {
+    for (unsigned int j = 0; j < DMX_UNIVERSE_SIZE; j++) {
+      // plenty of zeros and duplicates
+      m_sources[i][j] = random() % 3 ? 0 : random();
+    }
+  }
+}
+
+
+void SlotKernelsTest::tearDown() {
+  SetSlotKernel(m_original_kernel);
+}
+
+
+/*
+ * Check MaxSlots against a simple loop
+ */
+void SlotKernelsTest::testMaxSlots() {
+  for (unsigned int k = 0; k < arraysize(ALL_KERNELS); k++) {
+    if (!SetSlotKernel(ALL_KERNELS[k])) {
+      continue;
+    }
+    for (unsigned int l = 0; l < arraysize(LENGTHS); l++) {
+      uint8_t expected[DMX_UNIVERSE_SIZE];
+      uint8_t output[DMX_UNIVERSE_SIZE];
+      memcpy(output, m_sources[0], DMX_UNIVERSE_SIZE);
+      memcpy(expected, m_sources[0], DMX_UNIVERSE_SIZE);
+      for (unsigned int i = 0; i < LENGTHS[l]; i++) {
+        expected[i] = std::max(m_sources[0][i], m_sources[1][i]);
+      }
+
+      MaxSlots(output, m_sources[1], LENGTHS[l]);
+      OLA_ASSERT_DATA_EQUALS(expected, DMX_UNIVERSE_SIZE,
+                             output, DMX_UNIVERSE_SIZE);
+    }
+  }
+}
+
+
+/*
+ * Check MaxSlotsMany with sources of different lengths
+ */
+void SlotKernelsTest::testMaxSlotsMany() {
+  const uint8_t *sources[SOURCE_COUNT];
+  unsigned int lengths[SOURCE_COUNT];
+  for (unsigned int i = 0; i < SOURCE_COUNT; i++) {
+    sources[i] = m_sources[i];
+  }
+
+  for (unsigned int k = 0; k < arraysize(ALL_KERNELS); k++) {
+    if (!SetSlotKernel(ALL_KERNELS[k])) {
+      continue;
+    }
+    for (unsigned int l = 0; l < arraysize(LENGTHS); l++) {
+      for (unsigned int i = 0; i < SOURCE_COUNT; i++) {
+        lengths[i] = LENGTHS[(l + i * 3) % arraysize(LENGTHS)];
+      }
+
+      for (unsigned int count = 0; count <= SOURCE_COUNT; count++) {
+        uint8_t expected[DMX_UNIVERSE_SIZE];
+        unsigned int expected_length = 0;
+        memset(expected, 0, DMX_UNIVERSE_SIZE);
+        for (unsigned int i = 0; i < count; i++) {
+          expected_length = std::max(expected_length, lengths[i]);
+          for (unsigned int j = 0; j < lengths[i]; j++) {
+            expected[j] = std::max(expected[j], m_sources[i][j]);
+          }
+        }
+
+        uint8_t output[DMX_UNIVERSE_SIZE];
+        memset(output, 0xaa, DMX_UNIVERSE_SIZE);
+        unsigned int length = MaxSlotsMany(output, sources, lengths, count);
+        OLA_ASSERT_EQ(expected_length, length);
+        OLA_ASSERT_DATA_EQUALS(expected, expected_length, output, length);
+      }
+    }
+  }
+}
+
+
+/*
+ * Check SlotsEqual
+ */
+void SlotKernelsTest::testSlotsEqual() {
+  for (unsigned int k = 0; k < arraysize(ALL_KERNELS); k++) {
+    if (!SetSlotKernel(ALL_KERNELS[k])) {
+      continue;
+    }
+    for (unsigned int l = 0; l < arraysize(LENGTHS); l++) {
+      const unsigned int length = LENGTHS[l];
+      uint8_t copy[DMX_UNIVERSE_SIZE];
+      memcpy(copy, m_sources[0], DMX_UNIVERSE_SIZE);
+      OLA_ASSERT_TRUE(SlotsEqual(m_sources[0], copy, length));
+
+      if (length) {
+        // change the last slot, which is in the tail for most lengths
+        copy[length - 1]++;
+        OLA_ASSERT_FALSE(SlotsEqual(m_sources[0], copy, length));
+        copy[length - 1]--;
+        copy[0]++;
+        OLA_ASSERT_FALSE(SlotsEqual(m_sources[0], copy, length));
+      }
+    }
+  }
+}
+
+
+/*
+ * Check SlotDiffMask
+ */
+void SlotKernelsTest::testSlotDiffMask() {
+  for (unsigned int k = 0; k < arraysize(ALL_KERNELS); k++) {
+    if (!SetSlotKernel(ALL_KERNELS[k])) {
+      continue;
+    }
+    for (unsigned int l = 0; l < arraysize(LENGTHS); l++) {
+      const unsigned int length = LENGTHS[l];
+      uint8_t expected[DMX_UNIVERSE_SIZE];
+      for (unsigned int i = 0; i < length; i++) {
+        expected[i] = m_sources[0][i] == m_sources[1][i] ? 0 : 0xff;
+      }
+
+      uint8_t mask[DMX_UNIVERSE_SIZE];
+      SlotDiffMask(m_sources[0], m_sources[1], mask, length);
+      OLA_ASSERT_DATA_EQUALS(expected, length, mask, length);
+    }
+  }
+}
+
+
+/*
+ * Check ChangedSlotBitmap
+ */
+void SlotKernelsTest::testChangedSlotBitmap() {
+  for (unsigned int k = 0; k < arraysize(ALL_KERNELS); k++) {
+    if (!SetSlotKernel(ALL_KERNELS[k])) {
+      continue;
+    }
+    for (unsigned int l = 0; l < arraysize(LENGTHS); l++) {
+      const unsigned int length = LENGTHS[l];
+      const unsigned int bitmap_size = (length + 7) / 8;
+      uint8_t expected[DMX_UNIVERSE_SIZE / 8];
+      unsigned int expected_changes = 0;
+      memset(expected, 0, sizeof(expected));
+      for (unsigned int i = 0; i < length; i++) {
+        if (m_sources[0][i] != m_sources[1][i]) {
+          expected[i / 8] |= 1 << (i % 8);
+          expected_changes++;
+        }
+      }
+
+      uint8_t bitmap[DMX_UNIVERSE_SIZE / 8];
+      unsigned int changes = ChangedSlotBitmap(m_sources[0], m_sources[1],
+                                               bitmap, length);
+      OLA_ASSERT_EQ(expected_changes, changes);
+      OLA_ASSERT_DATA_EQUALS(expected, bitmap_size, bitmap, bitmap_size);
+
+      OLA_ASSERT_EQ(0u, ChangedSlotBitmap(m_sources[0], m_sources[0],
+                                          bitmap, length));
+    }
+  }
+}
@@ -0,0 +1,134 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * slot_kernel_benchmark.cpp
+ * Compare the throughput of the slot kernel implementations.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "ola/Clock.h"
+#include "ola/Constants.h"
+#include "ola/base/Array.h"
+#include "ola/base/Flags.h"
+#include "ola/base/Init.h"
+#include "ola/dmx/SlotKernels.h"
+
+using ola::Clock;
+using ola::DMX_UNIVERSE_SIZE;
+using ola::TimeInterval;
+using ola::TimeStamp;
+using ola::dmx::SlotKernelType;
+using std::cout;
+using std::endl;
+using std::vector;
+
+DEFINE_s_uint32(iterations, i, 20000, "Number of merges per measurement");
+
+static const unsigned int SOURCE_COUNTS[] = {1, 2, 4, 8, 16, 32, 64};
+static const SlotKernelType KERNELS[] = {
+  ola::dmx::SLOT_KERNEL_SCALAR,
+  ola::dmx::SLOT_KERNEL_SSE2,
+  ola::dmx::SLOT_KERNEL_AVX2,
+  ola::dmx::SLOT_KERNEL_NEON,
+};
+
+/**
+ * Return the throughput in MB/s of source slots merged.
+ */
+double Throughput(const TimeInterval &interval, unsigned int sources) {
+  double bytes = static_cast<double>(FLAGS_iterations) * sources *
+                 DMX_UNIVERSE_SIZE;
+  return bytes / interval.AsInt();  // bytes per us == MB/s
+}
+
+/**
+ * Merge the sources one at a time, as DmxBuffer::HTPMerge does.
+ */
+TimeInterval TimePairwise(const vector<const uint8_t*> &sources,
+                          uint8_t *output) {
+  Clock clock;
+  TimeStamp start, end;
+  clock.CurrentTime(&start);
+  for (unsigned int i = 0; i < FLAGS_iterations; i++) {
+    memset(output, 0, DMX_UNIVERSE_SIZE);
+    for (unsigned int j = 0; j < sources.size(); j++) {
+      ola::dmx::MaxSlots(output, sources[j], DMX_UNIVERSE_SIZE);
+    }
+  }
+  clock.CurrentTime(&end);
+  return end - start;
+}
+
+/**
+ * Merge all sources in a single pass.
+ */
+TimeInterval TimeSinglePass(const vector<const uint8_t*> &sources,
+                            const vector<unsigned int> &lengths,
+                            uint8_t *output) {
+  Clock clock;
+  TimeStamp start, end;
+  clock.CurrentTime(&start);
+  for (unsigned int i = 0; i < FLAGS_iterations; i++) {
+    ola::dmx::MaxSlotsMany(output, &sources[0], &lengths[0], sources.size());
+  }
+  clock.CurrentTime(&end);
+  return end - start;
+}
+
+int main(int argc, char* argv[]) {
+  ola::AppInit(&argc, argv, "[options]",
+               "Benchmark the DMX slot kernels.");
+
+  const unsigned int max_sources = SOURCE_COUNTS[arraysize(SOURCE_COUNTS) - 1];
+  vector<uint8_t> data(max_sources * DMX_UNIVERSE_SIZE);
+  for (unsigned int i = 0; i < data.size(); i++) {
+    data[i] = random();
+  }
+  uint8_t output[DMX_UNIVERSE_SIZE];
+
+  cout << std::setw(8) << "kernel" << std::setw(9) << "sources"
+       << std::setw(16) << "pairwise MB/s" << std::setw(18)
+       << "single pass MB/s" << endl;
+
+  for (unsigned int k = 0; k < arraysize(KERNELS); k++) {
+    if (!ola::dmx::SetSlotKernel(KERNELS[k])) {
+      continue;
+    }
+
+    for (unsigned int s = 0; s < arraysize(SOURCE_COUNTS); s++) {
+      vector<const uint8_t*> sources;
+      vector<unsigned int> lengths;
+      for (unsigned int i = 0; i < SOURCE_COUNTS[s]; i++) {
+        sources.push_back(&data[i * DMX_UNIVERSE_SIZE]);
+        lengths.push_back(DMX_UNIVERSE_SIZE);
+      }
+
+      TimeInterval pairwise = TimePairwise(sources, output);
+      TimeInterval single_pass = TimeSinglePass(sources, lengths, output);
+      cout << std::setw(8) << ola::dmx::SlotKernelName(KERNELS[k])
+           << std::setw(9) << SOURCE_COUNTS[s]
+           << std::setw(16) << std::fixed << std::setprecision(1)
+           << Throughput(pairwise, SOURCE_COUNTS[s])
+           << std::setw(18) << Throughput(single_pass, SOURCE_COUNTS[s])
+           << endl;
+    }
+  }
+  return 0;
+}
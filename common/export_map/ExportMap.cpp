@@ -18,6 +18,8 @@
  * Copyright (C) 2005 Simon Newton
  */
 
+#include <string.h>
+
 #include <algorithm>
 #include <string>
 #include <map>
@@ -26,14 +28,277 @@
 #include "ola/ExportMap.h"
 #include "ola/StringUtils.h"
 #include "ola/stl/STLUtils.h"
+#include "ola/thread/Atomic.h"
+#include "ola/thread/Mutex.h"
 
 namespace ola {
 
+using ola::thread::AtomicCompareExchange;
+using ola::thread::AtomicFetchAdd;
+using ola::thread::AtomicLoadAcquire;
+using ola::thread::AtomicLoadRelaxed;
+using ola::thread::AtomicStoreRelease;
+using ola::thread::MutexLocker;
 using std::map;
 using std::ostringstream;
 using std::string;
 using std::vector;
 
+namespace {
+// The shard used by each thread, plus one so that 0 means unassigned.
+__thread unsigned int thread_shard = 0;
+unsigned int next_thread_shard = 0;
+}  // namespace
+
+const unsigned int CounterVariable::SHARDS;
+
+CounterVariable::CounterVariable(const string &name)
+    : BaseVariable(name) {
+  memset(m_shards, 0, sizeof(m_shards));
+}
+
+void CounterVariable::Reset() {
+  for (unsigned int i = 0; i < SHARDS; i++) {
+    AtomicStoreRelease(&m_shards[i].value, 0u);
+  }
+}
+
+unsigned int CounterVariable::Get() const {
+  unsigned int total = 0;
+  for (unsigned int i = 0; i < SHARDS; i++) {
+    total += AtomicLoadAcquire(&m_shards[i].value);
+  }
+  return total;
+}
+
+const string CounterVariable::Value() const {
+  ostringstream out;
+  out << Get();
+  return out.str();
+}
+
+/*
+ * Threads are given shards in the order they first update a counter.
+ */
+unsigned int CounterVariable::ThreadShard() {
+  if (!thread_shard) {
+    thread_shard = AtomicFetchAdd(&next_thread_shard, 1u) % SHARDS + 1;
+  }
+  return thread_shard - 1;
+}
+
+
+CounterMap::~CounterMap() {
+  STLDeleteValues(&m_counters);
+}
+
+CounterVariable *CounterMap::Counter(const string &key) {
+  MutexLocker lock(&m_mutex);
+  CounterMapType::iterator iter = m_counters.find(key);
+  if (iter == m_counters.end()) {
+    CounterVariable *counter = new CounterVariable(key);
+    m_counters[key] = counter;
+    return counter;
+  }
+  return iter->second;
+}
+
+void CounterMap::Remove(const string &key) {
+  MutexLocker lock(&m_mutex);
+  STLRemoveAndDelete(&m_counters, key);
+}
+
+/*
+ * This uses the same format as the MapVariable.
+ */
+const string CounterMap::Value() const {
+  MutexLocker lock(&m_mutex);
+  ostringstream value;
+  value << "map:" << m_label;
+  CounterMapType::const_iterator iter;
+  for (iter = m_counters.begin(); iter != m_counters.end(); ++iter)
+    value << " " << iter->first << ":" << iter->second->Get();
+  return value.str();
+}
+
+
+GaugeMap::~GaugeMap() {
+  STLDeleteValues(&m_gauges);
+}
+
+GaugeVariable *GaugeMap::Gauge(const string &key) {
+  MutexLocker lock(&m_mutex);
+  GaugeMapType::iterator iter = m_gauges.find(key);
+  if (iter == m_gauges.end()) {
+    GaugeVariable *gauge = new GaugeVariable(key);
+    m_gauges[key] = gauge;
+    return gauge;
+  }
+  return iter->second;
+}
+
+void GaugeMap::Remove(const string &key) {
+  MutexLocker lock(&m_mutex);
+  STLRemoveAndDelete(&m_gauges, key);
+}
+
+/*
+ * This uses the same format as the MapVariable.
+ */
+const string GaugeMap::Value() const {
+  MutexLocker lock(&m_mutex);
+  ostringstream value;
+  value << "map:" << m_label;
+  GaugeMapType::const_iterator iter;
+  for (iter = m_gauges.begin(); iter != m_gauges.end(); ++iter)
+    value << " " << iter->first << ":" << iter->second->Get();
+  return value.str();
+}
+
+
+const unsigned int LatencyHistogram::SUB_BUCKET_BITS;
+const unsigned int LatencyHistogram::SUB_BUCKETS;
+const unsigned int LatencyHistogram::BUCKETS;
+
+LatencyHistogram::LatencyHistogram(const string &name)
+    : BaseVariable(name),
+      m_max(0) {
+  memset(m_buckets, 0, sizeof(m_buckets));
+}
+
+void LatencyHistogram::Record(int64_t usec) {
+  uint32_t value = 0;
+  if (usec > 0xffffffffll) {
+    value = 0xffffffff;
+  } else if (usec > 0) {
+    value = static_cast<uint32_t>(usec);
+  }
+
+  AtomicFetchAdd(&m_buckets[BucketIndex(value)], 1u);
+
+  uint32_t max = AtomicLoadRelaxed(&m_max);
+  while (value > max && !AtomicCompareExchange(&m_max, &max, value)) {
+  }
+}
+
+/*
+ * As with the CounterVariable, values recorded while this runs may be lost.
+ */
+void LatencyHistogram::Reset() {
+  for (unsigned int i = 0; i < BUCKETS; i++) {
+    AtomicStoreRelease(&m_buckets[i], 0u);
+  }
+  AtomicStoreRelease(&m_max, static_cast<uint32_t>(0));
+}
+
+uint64_t LatencyHistogram::Count() const {
+  uint64_t count = 0;
+  for (unsigned int i = 0; i < BUCKETS; i++) {
+    count += AtomicLoadAcquire(&m_buckets[i]);
+  }
+  return count;
+}
+
+uint32_t LatencyHistogram::Max() const {
+  return AtomicLoadAcquire(&m_max);
+}
+
+uint32_t LatencyHistogram::Percentile(double percentile) const {
+  // Take a copy so the total and the walk below agree.
+  unsigned int buckets[BUCKETS];
+  uint64_t count = 0;
+  for (unsigned int i = 0; i < BUCKETS; i++) {
+    buckets[i] = AtomicLoadAcquire(&m_buckets[i]);
+    count += buckets[i];
+  }
+  if (!count) {
+    return 0;
+  }
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  uint64_t rank = static_cast<uint64_t>(percentile * count / 100.0 + 0.5);
+  rank = std::max(rank, static_cast<uint64_t>(1));
+
+  uint64_t seen = 0;
+  for (unsigned int i = 0; i < BUCKETS; i++) {
+    seen += buckets[i];
+    if (seen >= rank) {
+      // The top bucket is wide, the max is a tighter bound.
+      return std::min(BucketUpperBound(i), Max());
+    }
+  }
+  return Max();
+}
+
+const string LatencyHistogram::Value() const {
+  ostringstream out;
+  out << "count=" << Count() << " p50=" << Percentile(50)
+      << " p90=" << Percentile(90) << " p99=" << Percentile(99)
+      << " p99.9=" << Percentile(99.9) << " max=" << Max();
+  return out.str();
+}
+
+/*
+ * Values less than SUB_BUCKETS have a bucket each. After that each power of
+ * two is split into SUB_BUCKETS buckets.
+ */
+unsigned int LatencyHistogram::BucketIndex(uint32_t value) {
+  if (value < SUB_BUCKETS) {
+    return value;
+  }
+  unsigned int bits = 0;
+  while (bits < 32 && (value >> bits)) {
+    bits++;
+  }
+  unsigned int shift = bits - SUB_BUCKET_BITS - 1;
+  return (shift + 1) * SUB_BUCKETS + (value >> shift) - SUB_BUCKETS;
+}
+
+uint32_t LatencyHistogram::BucketUpperBound(unsigned int index) {
+  if (index < SUB_BUCKETS) {
+    return index;
+  }
+  unsigned int shift = index / SUB_BUCKETS - 1;
+  uint64_t top = SUB_BUCKETS + index % SUB_BUCKETS;
+  return static_cast<uint32_t>(((top + 1) << shift) - 1);
+}
+
+
+LatencyHistogramMap::~LatencyHistogramMap() {
+  STLDeleteValues(&m_histograms);
+}
+
+LatencyHistogram *LatencyHistogramMap::Histogram(const string &key) {
+  MutexLocker lock(&m_mutex);
+  HistogramMapType::iterator iter = m_histograms.find(key);
+  if (iter == m_histograms.end()) {
+    LatencyHistogram *histogram = new LatencyHistogram(key);
+    m_histograms[key] = histogram;
+    return histogram;
+  }
+  return iter->second;
+}
+
+void LatencyHistogramMap::Remove(const string &key) {
+  MutexLocker lock(&m_mutex);
+  STLRemoveAndDelete(&m_histograms, key);
+}
+
+/*
+ * This uses the same format as the StringMap.
+ */
+const string LatencyHistogramMap::Value() const {
+  MutexLocker lock(&m_mutex);
+  ostringstream value;
+  value << "map:" << m_label;
+  HistogramMapType::const_iterator iter;
+  for (iter = m_histograms.begin(); iter != m_histograms.end(); ++iter) {
+    value << " " << iter->first << ":\"" << iter->second->Value() << "\"";
+  }
+  return value.str();
+}
+
+
 ExportMap::~ExportMap() {
   STLDeleteValues(&m_bool_variables);
   STLDeleteValues(&m_counter_variables);
@@ -42,6 +307,9 @@ ExportMap::~ExportMap() {
   STLDeleteValues(&m_str_map_variables);
   STLDeleteValues(&m_string_variables);
   STLDeleteValues(&m_uint_map_variables);
+  STLDeleteValues(&m_counter_map_variables);
+  STLDeleteValues(&m_gauge_map_variables);
+  STLDeleteValues(&m_latency_map_variables);
 }
 
 BoolVariable *ExportMap::GetBoolVar(const string &name) {
@@ -94,27 +362,91 @@ UIntMap *ExportMap::GetUIntMapVar(const string &name, const string &label) {
 }
 
 
+/*
+ * Lookup or create a counter map variable
+ * @param name the name of the variable
+ * @param label the label to use for the map (optional)
+ * @return a CounterMap
+ */
+CounterMap *ExportMap::GetCounterMapVar(const string &name,
+                                        const string &label) {
+  return GetMapVar(&m_counter_map_variables, name, label);
+}
+
+
+/*
+ * Lookup or create a gauge map variable
+ * @param name the name of the variable
+ * @param label the label to use for the map (optional)
+ * @return a GaugeMap
+ */
+GaugeMap *ExportMap::GetGaugeMapVar(const string &name, const string &label) {
+  return GetMapVar(&m_gauge_map_variables, name, label);
+}
+
+
+/*
+ * Lookup or create a latency histogram map variable
+ * @param name the name of the variable
+ * @param label the label to use for the map (optional)
+ * @return a LatencyHistogramMap
+ */
+LatencyHistogramMap *ExportMap::GetLatencyMapVar(const string &name,
+                                                 const string &label) {
+  return GetMapVar(&m_latency_map_variables, name, label);
+}
+
+
 /*
  * Return a list of all variables.
  * @return a vector of all variables.
  */
 vector<BaseVariable*> ExportMap::AllVariables() const {
+  MutexLocker lock(&m_mutex);
   vector<BaseVariable*> variables;
-  STLValues(m_bool_variables, &variables);
-  STLValues(m_counter_variables, &variables);
-  STLValues(m_int_map_variables, &variables);
-  STLValues(m_int_variables, &variables);
-  STLValues(m_str_map_variables, &variables);
-  STLValues(m_string_variables, &variables);
-  STLValues(m_uint_map_variables, &variables);
-
-  sort(variables.begin(), variables.end(), VariableLessThan());
+  SortedVariables(&variables);
   return variables;
 }
 
 
+void ExportMap::Snapshot(vector<VariableSnapshot> *snapshot) const {
+  MutexLocker lock(&m_mutex);
+  vector<BaseVariable*> variables;
+  SortedVariables(&variables);
+
+  snapshot->clear();
+  snapshot->reserve(variables.size());
+  vector<BaseVariable*>::const_iterator iter = variables.begin();
+  for (; iter != variables.end(); ++iter) {
+    VariableSnapshot entry;
+    entry.name = (*iter)->Name();
+    entry.value = (*iter)->Value();
+    snapshot->push_back(entry);
+  }
+}
+
+
+/*
+ * Get all the variables, sorted by name. m_mutex must be held.
+ */
+void ExportMap::SortedVariables(vector<BaseVariable*> *variables) const {
+  STLValues(m_bool_variables, variables);
+  STLValues(m_counter_variables, variables);
+  STLValues(m_int_map_variables, variables);
+  STLValues(m_int_variables, variables);
+  STLValues(m_str_map_variables, variables);
+  STLValues(m_string_variables, variables);
+  STLValues(m_uint_map_variables, variables);
+  STLValues(m_counter_map_variables, variables);
+  STLValues(m_gauge_map_variables, variables);
+  STLValues(m_latency_map_variables, variables);
+  sort(variables->begin(), variables->end(), VariableLessThan());
+}
+
+
 template<typename Type>
 Type *ExportMap::GetVar(map<string, Type*> *var_map, const string &name) {
+  MutexLocker lock(&m_mutex);
   typename map<string, Type*>::iterator iter;
   iter = var_map->find(name);
 
@@ -131,6 +463,7 @@ template<typename Type>
 Type *ExportMap::GetMapVar(map<string, Type*> *var_map,
                            const string &name,
                            const string &label) {
+  MutexLocker lock(&m_mutex);
   typename map<string, Type*>::iterator iter;
   iter = var_map->find(name);
 
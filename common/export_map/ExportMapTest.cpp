@@ -24,15 +24,22 @@
 
 #include "ola/ExportMap.h"
 #include "ola/testing/TestUtils.h"
+#include "ola/thread/Thread.h"
 
 using ola::BaseVariable;
 using ola::BoolVariable;
+using ola::CounterMap;
 using ola::CounterVariable;
 using ola::ExportMap;
+using ola::GaugeMap;
+using ola::GaugeVariable;
 using ola::IntMap;
 using ola::IntegerVariable;
+using ola::LatencyHistogram;
+using ola::LatencyHistogramMap;
 using ola::StringMap;
 using ola::StringVariable;
+using ola::VariableSnapshot;
 using std::string;
 using std::vector;
 
@@ -45,7 +52,13 @@ class ExportMapTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testBoolVariable);
   CPPUNIT_TEST(testStringMapVariable);
   CPPUNIT_TEST(testIntMapVariable);
+  CPPUNIT_TEST(testCounterMap);
+  CPPUNIT_TEST(testCounterThreads);
+  CPPUNIT_TEST(testGaugeMap);
+  CPPUNIT_TEST(testLatencyHistogram);
+  CPPUNIT_TEST(testLatencyHistogramMap);
   CPPUNIT_TEST(testExportMap);
+  CPPUNIT_TEST(testSnapshot);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -55,13 +68,42 @@ class ExportMapTest: public CppUnit::TestFixture {
     void testBoolVariable();
     void testStringMapVariable();
     void testIntMapVariable();
+    void testCounterMap();
+    void testCounterThreads();
+    void testGaugeMap();
+    void testLatencyHistogram();
+    void testLatencyHistogramMap();
     void testExportMap();
+    void testSnapshot();
 };
 
 
 CPPUNIT_TEST_SUITE_REGISTRATION(ExportMapTest);
 
 
+/*
+ * Increments a counter from another thread.
+ */
+class CounterThread: public ola::thread::Thread {
+ public:
+  CounterThread(CounterVariable *counter, unsigned int count)
+      : m_counter(counter),
+        m_count(count) {
+  }
+
+  void *Run() {
+    for (unsigned int i = 0; i < m_count; i++) {
+      (*m_counter)++;
+    }
+    return NULL;
+  }
+
+ private:
+  CounterVariable *m_counter;
+  unsigned int m_count;
+};
+
+
 /*
  * Check that the IntegerVariable works correctly.
  */
@@ -103,6 +145,8 @@ void ExportMapTest::testCounterVariable() {
   var += 100;
   OLA_ASSERT_EQ((unsigned int) 111, var.Get());
   OLA_ASSERT_EQ(var.Value(), string("111"));
+  var.Reset();
+  OLA_ASSERT_EQ((unsigned int) 0, var.Get());
 }
 
 
@@ -213,6 +257,176 @@ void ExportMapTest::testIntMapVariable() {
   OLA_ASSERT_EQ(var.Value(), string("map:count key1:1"));
 }
 
+/*
+ * Check that the CounterMap works correctly.
+ */
+void ExportMapTest::testCounterMap() {
+  string name = "foo";
+  string label = "count";
+  CounterMap var(name, label);
+
+  OLA_ASSERT_EQ(var.Name(), name);
+  OLA_ASSERT_EQ(var.Label(), label);
+  OLA_ASSERT_EQ(var.Value(), string("map:count"));
+
+  CounterVariable *counter1 = var.Counter("key1");
+  OLA_ASSERT_EQ(var.Value(), string("map:count key1:0"));
+  (*counter1)++;
+  (*counter1) += 9;
+  OLA_ASSERT_EQ(var.Value(), string("map:count key1:10"));
+
+  // The same key returns the same counter.
+  OLA_ASSERT_EQ(counter1, var.Counter("key1"));
+
+  CounterVariable *counter2 = var.Counter("key2");
+  (*counter2)++;
+  OLA_ASSERT_EQ(var.Value(), string("map:count key1:10 key2:1"));
+
+  var.Remove("key1");
+  var.Remove("key1");
+  OLA_ASSERT_EQ(var.Value(), string("map:count key2:1"));
+}
+
+
+/*
+ * Check that the GaugeMap works correctly.
+ */
+void ExportMapTest::testGaugeMap() {
+  string name = "foo";
+  string label = "port";
+  GaugeMap var(name, label);
+
+  OLA_ASSERT_EQ(var.Name(), name);
+  OLA_ASSERT_EQ(var.Label(), label);
+  OLA_ASSERT_EQ(var.Value(), string("map:port"));
+
+  GaugeVariable *gauge1 = var.Gauge("key1");
+  OLA_ASSERT_EQ(var.Value(), string("map:port key1:0"));
+  gauge1->Set(44);
+  OLA_ASSERT_EQ(44u, gauge1->Get());
+  OLA_ASSERT_EQ(string("44"), gauge1->Value());
+  // Gauges can go down as well as up.
+  gauge1->Set(40);
+  OLA_ASSERT_EQ(var.Value(), string("map:port key1:40"));
+
+  // The same key returns the same gauge.
+  OLA_ASSERT_EQ(gauge1, var.Gauge("key1"));
+
+  var.Gauge("key2")->Set(2);
+  OLA_ASSERT_EQ(var.Value(), string("map:port key1:40 key2:2"));
+
+  var.Remove("key1");
+  var.Remove("key1");
+  OLA_ASSERT_EQ(var.Value(), string("map:port key2:2"));
+}
+
+
+/*
+ * Check the LatencyHistogram.
+ */
+void ExportMapTest::testLatencyHistogram() {
+  LatencyHistogram histogram("foo");
+  OLA_ASSERT_EQ(static_cast<uint64_t>(0), histogram.Count());
+  OLA_ASSERT_EQ(0u, histogram.Max());
+  OLA_ASSERT_EQ(0u, histogram.Percentile(50));
+  OLA_ASSERT_EQ(string("count=0 p50=0 p90=0 p99=0 p99.9=0 max=0"),
+                histogram.Value());
+
+  // small values are exact
+  for (unsigned int i = 1; i <= 10; i++) {
+    histogram.Record(i);
+  }
+  OLA_ASSERT_EQ(static_cast<uint64_t>(10), histogram.Count());
+  OLA_ASSERT_EQ(10u, histogram.Max());
+  OLA_ASSERT_EQ(5u, histogram.Percentile(50));
+  OLA_ASSERT_EQ(9u, histogram.Percentile(90));
+  OLA_ASSERT_EQ(10u, histogram.Percentile(100));
+  OLA_ASSERT_EQ(1u, histogram.Percentile(0));
+
+  // negative values are recorded as 0
+  histogram.Reset();
+  histogram.Record(-100);
+  OLA_ASSERT_EQ(static_cast<uint64_t>(1), histogram.Count());
+  OLA_ASSERT_EQ(0u, histogram.Max());
+
+  // larger values are within 1/16th
+  histogram.Reset();
+  for (unsigned int i = 0; i < 990; i++) {
+    histogram.Record(1000);
+  }
+  for (unsigned int i = 0; i < 10; i++) {
+    histogram.Record(100000);
+  }
+  OLA_ASSERT_EQ(static_cast<uint64_t>(1000), histogram.Count());
+  OLA_ASSERT_EQ(100000u, histogram.Max());
+  uint32_t p50 = histogram.Percentile(50);
+  OLA_ASSERT_TRUE(p50 >= 1000);
+  OLA_ASSERT_TRUE(p50 < 1000 + 1000 / 16);
+  OLA_ASSERT_EQ(p50, histogram.Percentile(99));
+  uint32_t p999 = histogram.Percentile(99.9);
+  OLA_ASSERT_TRUE(p999 > 100000 - 100000 / 16);
+  OLA_ASSERT_TRUE(p999 <= 100000);
+
+  // very large values are clamped
+  histogram.Record(0x1ffffffffll);
+  OLA_ASSERT_EQ(0xffffffffu, histogram.Max());
+  OLA_ASSERT_EQ(0xffffffffu, histogram.Percentile(100));
+}
+
+
+/*
+ * Check the LatencyHistogramMap.
+ */
+void ExportMapTest::testLatencyHistogramMap() {
+  LatencyHistogramMap var("foo", "universe");
+  OLA_ASSERT_EQ(string("universe"), var.Label());
+  OLA_ASSERT_EQ(string("map:universe"), var.Value());
+
+  LatencyHistogram *histogram = var.Histogram("1");
+  OLA_ASSERT_EQ(histogram, var.Histogram("1"));
+  histogram->Record(3);
+  OLA_ASSERT_EQ(
+      string("map:universe 1:\"count=1 p50=3 p90=3 p99=3 p99.9=3 max=3\""),
+      var.Value());
+
+  var.Remove("1");
+  OLA_ASSERT_EQ(string("map:universe"), var.Value());
+
+  ExportMap map;
+  LatencyHistogramMap *map_var = map.GetLatencyMapVar("bar", "port");
+  OLA_ASSERT_EQ(map_var, map.GetLatencyMapVar("bar"));
+  OLA_ASSERT_EQ(string("port"), map_var->Label());
+  vector<BaseVariable*> variables = map.AllVariables();
+  OLA_ASSERT_EQ(static_cast<size_t>(1), variables.size());
+}
+
+
+/*
+ * Check that counters can be updated from many threads at once.
+ */
+void ExportMapTest::testCounterThreads() {
+  const unsigned int THREAD_COUNT = 4;
+  const unsigned int INCREMENTS = 100000;
+  CounterVariable counter("foo");
+
+  vector<CounterThread*> threads;
+  for (unsigned int i = 0; i < THREAD_COUNT; i++) {
+    threads.push_back(new CounterThread(&counter, INCREMENTS));
+  }
+  for (unsigned int i = 0; i < THREAD_COUNT; i++) {
+    OLA_ASSERT_TRUE(threads[i]->Start());
+  }
+  for (unsigned int i = 0; i < THREAD_COUNT; i++) {
+    OLA_ASSERT_TRUE(threads[i]->Join());
+    delete threads[i];
+  }
+  OLA_ASSERT_EQ(THREAD_COUNT * INCREMENTS, counter.Get());
+
+  counter.Reset();
+  OLA_ASSERT_EQ(0u, counter.Get());
+}
+
+
 /*
  * Check the export map works correctly.
  */
@@ -241,3 +455,27 @@ void ExportMapTest::testExportMap() {
   vector<BaseVariable*> variables = map.AllVariables();
   OLA_ASSERT_EQ(variables.size(), (size_t) 4);
 }
+
+
+/*
+ * Check that Snapshot() returns the values of all variables.
+ */
+void ExportMapTest::testSnapshot() {
+  ExportMap map;
+  map.GetBoolVar("bool_var")->Set(true);
+  (*map.GetCounterVar("counter_var")) += 5;
+  (*map.GetCounterMapVar("counter_map", "label")->Counter("1"))++;
+  map.GetStringVar("str_var")->Set("foo");
+
+  vector<VariableSnapshot> snapshot;
+  map.Snapshot(&snapshot);
+  OLA_ASSERT_EQ(static_cast<size_t>(4), snapshot.size());
+  OLA_ASSERT_EQ(string("bool_var"), snapshot[0].name);
+  OLA_ASSERT_EQ(string("1"), snapshot[0].value);
+  OLA_ASSERT_EQ(string("counter_map"), snapshot[1].name);
+  OLA_ASSERT_EQ(string("map:label 1:1"), snapshot[1].value);
+  OLA_ASSERT_EQ(string("counter_var"), snapshot[2].name);
+  OLA_ASSERT_EQ(string("5"), snapshot[2].value);
+  OLA_ASSERT_EQ(string("str_var"), snapshot[3].name);
+  OLA_ASSERT_EQ(string("foo"), snapshot[3].value);
+}
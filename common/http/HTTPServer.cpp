@@ -29,7 +29,7 @@
 #include <ola/http/HTTPServer.h>
 #include <ola/io/Descriptor.h>
 #include <ola/web/Json.h>
-#include <ola/web/JsonWriter.h>
+#include <ola/web/JsonStreamWriter.h>
 
 #ifdef _WIN32
 #include <ola/win/CleanWinSock2.h>
@@ -69,7 +69,7 @@ using std::string;
 using std::vector;
 using ola::io::UnmanagedFileDescriptor;
 using ola::web::JsonValue;
-using ola::web::JsonWriter;
+using ola::web::JsonStreamWriter;
 
 const char HTTPServer::CONTENT_TYPE_PLAIN[] = "text/plain";
 const char HTTPServer::CONTENT_TYPE_HTML[] = "text/html";
@@ -391,19 +391,10 @@ void HTTPResponse::SetHeader(const string &key, const string &value) {
  * @return true on success, false on error
  */
 int HTTPResponse::SendJson(const JsonValue &json) {
-  const string output = JsonWriter::AsString(json);
-  struct MHD_Response *response = HTTPServer::BuildResponse(
-      static_cast<void*>(const_cast<char*>(output.data())),
-      output.length());
-  HeadersMultiMap::const_iterator iter;
-  for (iter = m_headers.begin(); iter != m_headers.end(); ++iter) {
-    MHD_add_response_header(response,
-                            iter->first.c_str(),
-                            iter->second.c_str());
-  }
-  int ret = MHD_queue_response(m_connection, m_status_code, response);
-  MHD_destroy_response(response);
-  return ret;
+  m_data.clear();
+  JsonStreamWriter writer(&m_data);
+  writer.Append(json);
+  return Send();
 }
 
 
@@ -79,13 +79,14 @@ int OlaHTTPServer::DisplayDebug(const HTTPRequest*,
   str << diff.InMilliSeconds();
   m_export_map->GetStringVar(K_UPTIME_VAR)->Set(str.str());
 
-  vector<BaseVariable*> variables = m_export_map->AllVariables();
+  vector<VariableSnapshot> variables;
+  m_export_map->Snapshot(&variables);
   response->SetContentType(HTTPServer::CONTENT_TYPE_PLAIN);
 
-  vector<BaseVariable*>::iterator iter;
+  vector<VariableSnapshot>::const_iterator iter;
   for (iter = variables.begin(); iter != variables.end(); ++iter) {
     ostringstream out;
-    out << (*iter)->Name() << ": " << (*iter)->Value() << "\n";
+    out << iter->name << ": " << iter->value << "\n";
     response->Append(out.str());
   }
   int r = response->Send();
@@ -230,7 +230,8 @@ void BidirectionalFileDescriptor::PerformWrite() {
 // UnmanagedFileDescriptor
 // ------------------------------------------------
 UnmanagedFileDescriptor::UnmanagedFileDescriptor(int fd)
-  : BidirectionalFileDescriptor() {
+  : BidirectionalFileDescriptor(),
+    m_reads_until_empty(false) {
 #ifdef _WIN32
   m_handle.m_handle.m_fd = fd;
   m_handle.m_type = GENERIC_DESCRIPTOR;
@@ -50,7 +50,8 @@ class EPollData {
         read_descriptor(NULL),
         write_descriptor(NULL),
         connected_descriptor(NULL),
-        delete_connected_on_close(false) {
+        delete_connected_on_close(false),
+        edge_triggered(false) {
   }
 
   void Reset() {
@@ -59,6 +60,18 @@ class EPollData {
     write_descriptor = NULL;
     connected_descriptor = NULL;
     delete_connected_on_close = false;
+    edge_triggered = false;
+  }
+
+  /*
+   * The flags to pass to epoll. Edge triggering applies to both directions,
+   * so it's only used while the descriptor isn't in the write set.
+   */
+  uint32_t EPollFlags() const {
+    if (edge_triggered && !(events & EPOLLOUT)) {
+      return events | EPOLLET;
+    }
+    return events;
   }
 
   uint32_t events;
@@ -66,6 +79,7 @@ class EPollData {
   WriteFileDescriptor *write_descriptor;
   ConnectedDescriptor *connected_descriptor;
   bool delete_connected_on_close;
+  bool edge_triggered;
 };
 
 namespace {
@@ -76,7 +90,7 @@ namespace {
  */
 bool AddEvent(int epoll_fd, int fd, EPollData *descriptor) {
   epoll_event event;
-  event.events = descriptor->events;
+  event.events = descriptor->EPollFlags();
   event.data.ptr = descriptor;
 
   OLA_DEBUG << "EPOLL_CTL_ADD " << fd << ", events " << std::hex
@@ -95,7 +109,7 @@ bool AddEvent(int epoll_fd, int fd, EPollData *descriptor) {
  */
 bool UpdateEvent(int epoll_fd, int fd, EPollData *descriptor) {
   epoll_event event;
-  event.events = descriptor->events;
+  event.events = descriptor->EPollFlags();
   event.data.ptr = descriptor;
 
   OLA_DEBUG << "EPOLL_CTL_MOD " << fd << ", events " << std::hex
@@ -123,11 +137,7 @@ bool RemoveEvent(int epoll_fd, int fd) {
 }
 }  // namespace
 
-/**
- * @brief The maximum number of events to return in one epoll cycle
- */
-const int EPoller::MAX_EVENTS = 10;
-
+const unsigned int EPoller::DEFAULT_BATCH_SIZE;
 
 /**
  * @brief the EPOLL flags used for read descriptors.
@@ -139,12 +149,16 @@ const int EPoller::READ_FLAGS = EPOLLIN | EPOLLRDHUP;
  */
 const unsigned int EPoller::MAX_FREE_DESCRIPTORS = 10;
 
-EPoller::EPoller(ExportMap *export_map, Clock* clock)
+EPoller::EPoller(ExportMap *export_map, Clock* clock,
+                 const Options &options)
     : m_export_map(export_map),
       m_loop_iterations(NULL),
       m_loop_time(NULL),
       m_epoll_fd(INVALID_DESCRIPTOR),
-      m_clock(clock) {
+      m_clock(clock),
+      m_edge_triggered(options.edge_triggered),
+      m_busy_poll_interval(options.busy_poll_interval),
+      m_events(std::max(options.batch_size, 1u)) {
   if (m_export_map) {
     m_loop_time = m_export_map->GetCounterVar(K_LOOP_TIME);
     m_loop_iterations = m_export_map->GetCounterVar(K_LOOP_COUNT);
@@ -203,6 +217,8 @@ bool EPoller::AddReadDescriptor(ReadFileDescriptor *descriptor) {
 
   result.first->events |= READ_FLAGS;
   result.first->read_descriptor = descriptor;
+  result.first->edge_triggered = (
+      m_edge_triggered && descriptor->ReadsUntilEmpty());
 
   if (result.second) {
     return AddEvent(m_epoll_fd, descriptor->ReadDescriptor(), result.first);
@@ -234,6 +250,8 @@ bool EPoller::AddReadDescriptor(ConnectedDescriptor *descriptor,
   result.first->events |= READ_FLAGS;
   result.first->connected_descriptor = descriptor;
   result.first->delete_connected_on_close = delete_on_close;
+  result.first->edge_triggered = (
+      m_edge_triggered && descriptor->ReadsUntilEmpty());
 
   if (result.second) {
     return AddEvent(m_epoll_fd, descriptor->ReadDescriptor(), result.first);
@@ -290,7 +308,6 @@ bool EPoller::Poll(TimeoutManager *timeout_manager,
     return false;
   }
 
-  epoll_event events[MAX_EVENTS];
   TimeInterval sleep_interval = poll_interval;
   TimeStamp now;
   m_clock->CurrentTime(&now);
@@ -310,9 +327,7 @@ bool EPoller::Poll(TimeoutManager *timeout_manager,
       (*m_loop_iterations)++;
   }
 
-  int ms_to_sleep = sleep_interval.InMilliSeconds();
-  int ready = epoll_wait(m_epoll_fd, reinterpret_cast<epoll_event*>(&events),
-                         MAX_EVENTS, ms_to_sleep ? ms_to_sleep : 1);
+  int ready = Wait(now, sleep_interval);
 
   if (ready == 0) {
     m_clock->CurrentTime(&m_wake_up_time);
@@ -329,8 +344,8 @@ bool EPoller::Poll(TimeoutManager *timeout_manager,
 
   for (int i = 0; i < ready; i++) {
     EPollData *descriptor = reinterpret_cast<EPollData*>(
-        events[i].data.ptr);
-    CheckDescriptor(&events[i], descriptor);
+        m_events[i].data.ptr);
+    CheckDescriptor(&m_events[i], descriptor);
   }
 
   // Now that we're out of the callback phase, clean up descriptors that were
@@ -352,6 +367,40 @@ bool EPoller::Poll(TimeoutManager *timeout_manager,
 }
 
 
+/*
+ * Wait for events, returning the result of epoll_wait().
+ */
+int EPoller::Wait(const TimeStamp &now, const TimeInterval &sleep_interval) {
+  const int batch_size = static_cast<int>(m_events.size());
+  TimeInterval remaining = sleep_interval;
+
+  if (!m_busy_poll_interval.IsZero()) {
+    TimeStamp wake_up_by = now + sleep_interval;
+    TimeStamp spin_until = now + std::min(sleep_interval,
+                                          m_busy_poll_interval);
+    TimeStamp current = now;
+    // Always poll at least once, even if there is no time to spin for.
+    do {
+      int ready = epoll_wait(m_epoll_fd, &m_events[0], batch_size, 0);
+      if (ready) {
+        return ready;
+      }
+      m_clock->CurrentTime(&current);
+    } while (current < spin_until);
+
+    if (current >= wake_up_by) {
+      return 0;
+    }
+    remaining = wake_up_by - current;
+  }
+
+  // epoll_wait() only has millisecond resolution. If there's less than a
+  // millisecond left, poll rather than sleeping past the next timeout; the
+  // caller loops until it's due.
+  int ms_to_sleep = remaining.InMilliSeconds();
+  return epoll_wait(m_epoll_fd, &m_events[0], batch_size, ms_to_sleep);
+}
+
 /*
  * Check all the registered descriptors:
  *  - Execute the callback for descriptors with data
@@ -444,6 +493,7 @@ bool EPoller::RemoveDescriptor(int fd, int event, bool warn_on_missing) {
   } else if (event & EPOLLIN) {
     epoll_data->read_descriptor = NULL;
     epoll_data->connected_descriptor = NULL;
+    epoll_data->edge_triggered = false;
   }
 
   if (epoll_data->events == 0) {
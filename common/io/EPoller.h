@@ -50,12 +50,43 @@ class EPollData;
  */
 class EPoller : public PollerInterface {
  public :
+  struct Options {
+   public:
+    Options()
+        : batch_size(DEFAULT_BATCH_SIZE),
+          edge_triggered(false) {
+    }
+
+    /**
+     * @brief The maximum number of events to return from each epoll_wait().
+     */
+    unsigned int batch_size;
+
+    /**
+     * @brief Register descriptors which read until empty as edge-triggered.
+     *
+     * This only applies while the descriptor isn't also in the write set.
+     * @sa ReadFileDescriptor::ReadsUntilEmpty()
+     */
+    bool edge_triggered;
+
+    /**
+     * @brief Poll without sleeping for up to this long before blocking.
+     *
+     * This trades CPU for lower latency, and allows timeouts less than 1ms
+     * away to run on time. Zero disables it.
+     */
+    TimeInterval busy_poll_interval;
+  };
+
   /**
    * @brief Create a new EPoller.
    * @param export_map the ExportMap to use
    * @param clock the Clock to use
+   * @param options the options to use
    */
-  EPoller(ExportMap *export_map, Clock *clock);
+  EPoller(ExportMap *export_map, Clock *clock,
+          const Options &options = Options());
 
   ~EPoller();
 
@@ -92,13 +123,17 @@ class EPoller : public PollerInterface {
   int m_epoll_fd;
   Clock *m_clock;
   TimeStamp m_wake_up_time;
+  const bool m_edge_triggered;
+  const TimeInterval m_busy_poll_interval;
+  std::vector<struct epoll_event> m_events;
 
   std::pair<EPollData*, bool> LookupOrCreateDescriptor(int fd);
 
   bool RemoveDescriptor(int fd, int event, bool warn_on_missing);
   void CheckDescriptor(struct epoll_event *event, EPollData *descriptor);
+  int Wait(const TimeStamp &now, const TimeInterval &sleep_interval);
 
-  static const int MAX_EVENTS;
+  static const unsigned int DEFAULT_BATCH_SIZE = 64;
   static const int READ_FLAGS;
   static const unsigned int MAX_FREE_DESCRIPTORS;
 
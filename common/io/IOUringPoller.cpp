@@ -0,0 +1,717 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * IOUringPoller.cpp
+ * A Poller which uses io_uring
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include "common/io/IOUringPoller.h"
+
+#include <endian.h>
+#include <errno.h>
+#include <linux/io_uring.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <utility>
+
+#include "ola/Clock.h"
+#include "ola/Logging.h"
+#include "ola/base/Macro.h"
+#include "ola/io/Descriptor.h"
+#include "ola/stl/STLUtils.h"
+#include "ola/thread/Atomic.h"
+
+namespace ola {
+namespace io {
+
+using ola::thread::AtomicLoadAcquire;
+using ola::thread::AtomicLoadRelaxed;
+using ola::thread::AtomicStoreRelease;
+using std::pair;
+
+/*
+ * Represents a FD
+ */
+class IOUringData {
+ public:
+  IOUringData() {
+    Reset();
+  }
+
+  void Reset() {
+    fd = INVALID_DESCRIPTOR;
+    read_descriptor = NULL;
+    write_descriptor = NULL;
+    connected_descriptor = NULL;
+    delete_connected_on_close = false;
+    read_request = 0;
+    write_request = 0;
+    read_armed = false;
+    write_armed = false;
+    multishot = false;
+  }
+
+  int fd;
+  ReadFileDescriptor *read_descriptor;
+  WriteFileDescriptor *write_descriptor;
+  ConnectedDescriptor *connected_descriptor;
+  bool delete_connected_on_close;
+  // The user_data of the poll requests, 0 if not in the read / write set.
+  uint64_t read_request;
+  uint64_t write_request;
+  // True if the kernel holds a poll request for this direction.
+  bool read_armed;
+  bool write_armed;
+  bool multishot;
+};
+
+namespace {
+
+int SetupRing(unsigned int entries, struct io_uring_params *params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+int EnterRing(int fd, unsigned int to_submit, unsigned int min_complete,
+              unsigned int flags, void *arg, size_t arg_size) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit,
+                                  min_complete, flags, arg, arg_size));
+}
+
+void *MapRing(int fd, size_t size, off_t offset) {
+  void *ptr = mmap(NULL, size, PROT_READ | PROT_WRITE,
+                   MAP_SHARED | MAP_POPULATE, fd, offset);
+  if (ptr == MAP_FAILED) {
+    OLA_WARN << "Failed to mmap io_uring: " << strerror(errno);
+    return NULL;
+  }
+  return ptr;
+}
+
+template <typename T>
+T *RingPointer(void *ring, unsigned int offset) {
+  return reinterpret_cast<T*>(static_cast<uint8_t*>(ring) + offset);
+}
+}  // namespace
+
+const unsigned int IOUringPoller::DEFAULT_BATCH_SIZE;
+const unsigned int IOUringPoller::DEFAULT_RING_SIZE;
+
+/**
+ * @brief The poll events used for read descriptors.
+ */
+const uint32_t IOUringPoller::READ_EVENTS = POLLIN | POLLRDHUP;
+
+/**
+ * @brief The poll events used for write descriptors.
+ */
+const uint32_t IOUringPoller::WRITE_EVENTS = POLLOUT;
+
+/**
+ * @brief The number of pre-allocated IOUringData to have.
+ */
+const unsigned int IOUringPoller::MAX_FREE_DESCRIPTORS = 10;
+
+IOUringPoller::IOUringPoller(ExportMap *export_map, Clock* clock,
+                             const Options &options)
+    : m_export_map(export_map),
+      m_loop_iterations(NULL),
+      m_loop_time(NULL),
+      m_ring_fd(INVALID_DESCRIPTOR),
+      m_clock(clock),
+      m_ring_size(std::max(options.ring_size, 2u)),
+      m_batch_size(std::max(options.batch_size, 1u)),
+      m_next_request(1),
+      m_multishot(true),
+      m_sq_ring(NULL),
+      m_sq_ring_size(0),
+      m_cq_ring(NULL),
+      m_cq_ring_size(0),
+      m_sqes_size(0) {
+  if (m_export_map) {
+    m_loop_time = m_export_map->GetCounterVar(K_LOOP_TIME);
+    m_loop_iterations = m_export_map->GetCounterVar(K_LOOP_COUNT);
+  }
+  memset(&m_sq, 0, sizeof(m_sq));
+  memset(&m_cq, 0, sizeof(m_cq));
+  m_completions.reserve(m_batch_size);
+}
+
+IOUringPoller::~IOUringPoller() {
+  CloseRing();
+
+  {
+    DescriptorMap::iterator iter = m_descriptor_map.begin();
+    for (; iter != m_descriptor_map.end(); ++iter) {
+      if (iter->second->delete_connected_on_close) {
+        delete iter->second->connected_descriptor;
+      }
+      delete iter->second;
+    }
+  }
+
+  DescriptorList::iterator iter = m_orphaned_descriptors.begin();
+  for (; iter != m_orphaned_descriptors.end(); ++iter) {
+    if ((*iter)->delete_connected_on_close) {
+      delete (*iter)->connected_descriptor;
+    }
+    delete *iter;
+  }
+
+  STLDeleteElements(&m_free_descriptors);
+}
+
+bool IOUringPoller::Init() {
+  if (m_ring_fd != INVALID_DESCRIPTOR) {
+    return true;
+  }
+
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  int fd = SetupRing(m_ring_size, &params);
+  if (fd < 0) {
+    OLA_WARN << "io_uring_setup() failed: " << strerror(errno);
+    return false;
+  }
+  m_ring_fd = fd;
+
+  // We need IORING_ENTER_EXT_ARG to wait with a timeout.
+  if (!(params.features & IORING_FEAT_EXT_ARG)) {
+    OLA_WARN << "io_uring doesn't support IORING_FEAT_EXT_ARG, Linux 5.11 or "
+             << "later is required";
+    CloseRing();
+    return false;
+  }
+
+  m_sq_ring_size = params.sq_off.array +
+                   params.sq_entries * sizeof(unsigned int);
+  m_cq_ring_size = params.cq_off.cqes +
+                   params.cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    m_sq_ring_size = m_cq_ring_size = std::max(m_sq_ring_size,
+                                               m_cq_ring_size);
+  }
+
+  m_sq_ring = MapRing(fd, m_sq_ring_size, IORING_OFF_SQ_RING);
+  if (!m_sq_ring) {
+    CloseRing();
+    return false;
+  }
+
+  if (single_mmap) {
+    m_cq_ring = m_sq_ring;
+  } else {
+    m_cq_ring = MapRing(fd, m_cq_ring_size, IORING_OFF_CQ_RING);
+    if (!m_cq_ring) {
+      CloseRing();
+      return false;
+    }
+  }
+
+  m_sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+  m_sq.sqes = reinterpret_cast<struct io_uring_sqe*>(
+      MapRing(fd, m_sqes_size, IORING_OFF_SQES));
+  if (!m_sq.sqes) {
+    CloseRing();
+    return false;
+  }
+
+  m_sq.head = RingPointer<unsigned int>(m_sq_ring, params.sq_off.head);
+  m_sq.tail = RingPointer<unsigned int>(m_sq_ring, params.sq_off.tail);
+  m_sq.array = RingPointer<unsigned int>(m_sq_ring, params.sq_off.array);
+  m_sq.mask = *RingPointer<unsigned int>(m_sq_ring, params.sq_off.ring_mask);
+  m_sq.entries = *RingPointer<unsigned int>(m_sq_ring,
+                                            params.sq_off.ring_entries);
+  m_sq.local_tail = *m_sq.tail;
+  // The SQEs are always used in order, so the index array is fixed.
+  for (unsigned int i = 0; i < m_sq.entries; i++) {
+    m_sq.array[i] = i;
+  }
+
+  m_cq.head = RingPointer<unsigned int>(m_cq_ring, params.cq_off.head);
+  m_cq.tail = RingPointer<unsigned int>(m_cq_ring, params.cq_off.tail);
+  m_cq.mask = *RingPointer<unsigned int>(m_cq_ring, params.cq_off.ring_mask);
+  m_cq.cqes = RingPointer<struct io_uring_cqe>(m_cq_ring,
+                                               params.cq_off.cqes);
+
+  OLA_DEBUG << "io_uring ready with " << m_sq.entries << " entries";
+  return true;
+}
+
+bool IOUringPoller::AddReadDescriptor(ReadFileDescriptor *descriptor) {
+  if (m_ring_fd == INVALID_DESCRIPTOR) {
+    return false;
+  }
+
+  if (!descriptor->ValidReadDescriptor()) {
+    OLA_WARN << "AddReadDescriptor called with invalid descriptor";
+    return false;
+  }
+
+  pair<IOUringData*, bool> result = LookupOrCreateDescriptor(
+      descriptor->ReadDescriptor());
+  if (result.first->read_request) {
+    OLA_WARN << "Descriptor " << descriptor->ReadDescriptor()
+             << " already in read set";
+    return false;
+  }
+
+  result.first->read_descriptor = descriptor;
+  result.first->multishot = m_multishot && descriptor->ReadsUntilEmpty();
+  return ArmRead(result.first);
+}
+
+bool IOUringPoller::AddReadDescriptor(ConnectedDescriptor *descriptor,
+                                      bool delete_on_close) {
+  if (m_ring_fd == INVALID_DESCRIPTOR) {
+    return false;
+  }
+
+  if (!descriptor->ValidReadDescriptor()) {
+    OLA_WARN << "AddReadDescriptor called with invalid descriptor";
+    return false;
+  }
+
+  pair<IOUringData*, bool> result = LookupOrCreateDescriptor(
+      descriptor->ReadDescriptor());
+  if (result.first->read_request) {
+    OLA_WARN << "Descriptor " << descriptor->ReadDescriptor()
+             << " already in read set";
+    return false;
+  }
+
+  result.first->connected_descriptor = descriptor;
+  result.first->delete_connected_on_close = delete_on_close;
+  result.first->multishot = m_multishot && descriptor->ReadsUntilEmpty();
+  return ArmRead(result.first);
+}
+
+bool IOUringPoller::RemoveReadDescriptor(ReadFileDescriptor *descriptor) {
+  return RemoveDescriptor(descriptor->ReadDescriptor(), false, true);
+}
+
+bool IOUringPoller::RemoveReadDescriptor(ConnectedDescriptor *descriptor) {
+  return RemoveDescriptor(descriptor->ReadDescriptor(), false, true);
+}
+
+bool IOUringPoller::AddWriteDescriptor(WriteFileDescriptor *descriptor) {
+  if (m_ring_fd == INVALID_DESCRIPTOR) {
+    return false;
+  }
+
+  if (!descriptor->ValidWriteDescriptor()) {
+    OLA_WARN << "AddWriteDescriptor called with invalid descriptor";
+    return false;
+  }
+
+  pair<IOUringData*, bool> result = LookupOrCreateDescriptor(
+      descriptor->WriteDescriptor());
+  if (result.first->write_request) {
+    OLA_WARN << "Descriptor " << descriptor->WriteDescriptor()
+             << " already in write set";
+    return false;
+  }
+
+  result.first->write_descriptor = descriptor;
+  return ArmWrite(result.first);
+}
+
+bool IOUringPoller::RemoveWriteDescriptor(WriteFileDescriptor *descriptor) {
+  return RemoveDescriptor(descriptor->WriteDescriptor(), true, true);
+}
+
+bool IOUringPoller::Poll(TimeoutManager *timeout_manager,
+                         const TimeInterval &poll_interval) {
+  if (m_ring_fd == INVALID_DESCRIPTOR) {
+    return false;
+  }
+
+  TimeInterval sleep_interval = poll_interval;
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+
+  TimeInterval next_event_in = timeout_manager->ExecuteTimeouts(&now);
+  if (!next_event_in.IsZero()) {
+    sleep_interval = std::min(next_event_in, sleep_interval);
+  }
+
+  // take care of stats accounting
+  if (m_wake_up_time.IsSet()) {
+    TimeInterval loop_time = now - m_wake_up_time;
+    OLA_DEBUG << "ss process time was " << loop_time.ToString();
+    if (m_loop_time)
+      (*m_loop_time) += loop_time.AsInt();
+    if (m_loop_iterations)
+      (*m_loop_iterations)++;
+  }
+
+  int ready = Wait(sleep_interval);
+
+  if (ready == 0) {
+    m_clock->CurrentTime(&m_wake_up_time);
+    timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+    return true;
+  } else if (ready == -1) {
+    if (errno == EINTR)
+      return true;
+    OLA_WARN << "io_uring_enter() error, " << strerror(errno);
+    return false;
+  }
+
+  m_clock->CurrentTime(&m_wake_up_time);
+
+  for (int i = 0; i < ready; i++) {
+    HandleCompletion(m_completions[i]);
+  }
+
+  // Now that we're out of the callback phase, clean up descriptors that were
+  // removed.
+  CleanUp();
+
+  m_clock->CurrentTime(&m_wake_up_time);
+  timeout_manager->ExecuteTimeouts(&m_wake_up_time);
+  return true;
+}
+
+void IOUringPoller::CloseRing() {
+  if (m_sq.sqes) {
+    munmap(m_sq.sqes, m_sqes_size);
+  }
+  if (m_cq_ring && m_cq_ring != m_sq_ring) {
+    munmap(m_cq_ring, m_cq_ring_size);
+  }
+  if (m_sq_ring) {
+    munmap(m_sq_ring, m_sq_ring_size);
+  }
+  memset(&m_sq, 0, sizeof(m_sq));
+  memset(&m_cq, 0, sizeof(m_cq));
+  m_sq_ring = NULL;
+  m_cq_ring = NULL;
+
+  if (m_ring_fd != INVALID_DESCRIPTOR) {
+    close(m_ring_fd);
+    m_ring_fd = INVALID_DESCRIPTOR;
+  }
+}
+
+std::pair<IOUringData*, bool> IOUringPoller::LookupOrCreateDescriptor(
+    int fd) {
+  pair<DescriptorMap::iterator, bool> result = m_descriptor_map.insert(
+      DescriptorMap::value_type(fd, NULL));
+  bool new_descriptor = result.second;
+
+  if (new_descriptor) {
+    if (m_free_descriptors.empty()) {
+      result.first->second = new IOUringData();
+    } else {
+      result.first->second = m_free_descriptors.back();
+      m_free_descriptors.pop_back();
+    }
+    result.first->second->fd = fd;
+  }
+  return std::make_pair(result.first->second, new_descriptor);
+}
+
+bool IOUringPoller::RemoveDescriptor(int fd, bool write,
+                                     bool warn_on_missing) {
+  if (fd == INVALID_DESCRIPTOR) {
+    OLA_WARN << "Attempt to remove an invalid file descriptor";
+    return false;
+  }
+
+  IOUringData *data = STLFindOrNull(m_descriptor_map, fd);
+  if (!data) {
+    if (warn_on_missing) {
+      OLA_WARN << "Couldn't find IOUringData for " << fd;
+    }
+    return false;
+  }
+
+  uint64_t *request = write ? &data->write_request : &data->read_request;
+  bool *armed = write ? &data->write_armed : &data->read_armed;
+  if (*request) {
+    if (*armed) {
+      CancelPoll(*request);
+    }
+    m_requests.erase(*request);
+  }
+  *request = 0;
+  *armed = false;
+
+  if (write) {
+    data->write_descriptor = NULL;
+  } else {
+    data->read_descriptor = NULL;
+    data->connected_descriptor = NULL;
+    data->multishot = false;
+  }
+
+  if (!data->read_request && !data->write_request) {
+    m_orphaned_descriptors.push_back(
+        STLLookupAndRemovePtr(&m_descriptor_map, fd));
+  }
+  return true;
+}
+
+bool IOUringPoller::ArmRead(IOUringData *data) {
+  if (!data->read_request) {
+    data->read_request = m_next_request++;
+    m_requests[data->read_request] = data;
+  }
+
+  if (!AddPoll(data->fd, READ_EVENTS, data->read_request, data->multishot)) {
+    RemoveDescriptor(data->fd, false, false);
+    return false;
+  }
+  data->read_armed = true;
+  return true;
+}
+
+bool IOUringPoller::ArmWrite(IOUringData *data) {
+  if (!data->write_request) {
+    data->write_request = m_next_request++;
+    m_requests[data->write_request] = data;
+  }
+
+  if (!AddPoll(data->fd, WRITE_EVENTS, data->write_request, false)) {
+    RemoveDescriptor(data->fd, true, false);
+    return false;
+  }
+  data->write_armed = true;
+  return true;
+}
+
+bool IOUringPoller::AddPoll(int fd, uint32_t events, uint64_t request,
+                            bool multishot) {
+  struct io_uring_sqe *sqe = NextSubmission();
+  if (!sqe) {
+    OLA_WARN << "Failed to add poll request for " << fd;
+    return false;
+  }
+
+  OLA_DEBUG << "IORING_OP_POLL_ADD " << fd << ", events " << std::hex
+            << events << ", request " << std::dec << request
+            << (multishot ? " (multishot)" : "");
+#if __BYTE_ORDER == __BIG_ENDIAN
+  events = (events << 16) | (events >> 16);
+#endif  // __BYTE_ORDER == __BIG_ENDIAN
+  sqe->opcode = IORING_OP_POLL_ADD;
+  sqe->fd = fd;
+  sqe->poll32_events = events;
+  sqe->len = multishot ? IORING_POLL_ADD_MULTI : 0;
+  sqe->user_data = request;
+  return true;
+}
+
+/*
+ * Cancel a poll request. The cancellation itself completes with a user_data
+ * of 0, which is ignored.
+ */
+void IOUringPoller::CancelPoll(uint64_t request) {
+  struct io_uring_sqe *sqe = NextSubmission();
+  if (!sqe) {
+    OLA_WARN << "Failed to cancel poll request " << request;
+    return;
+  }
+
+  OLA_DEBUG << "IORING_OP_POLL_REMOVE " << request;
+  sqe->opcode = IORING_OP_POLL_REMOVE;
+  sqe->fd = -1;
+  sqe->addr = request;
+  sqe->user_data = 0;
+}
+
+/*
+ * Return the next free SQE, or NULL if the submission queue is full and
+ * couldn't be flushed.
+ */
+struct io_uring_sqe *IOUringPoller::NextSubmission() {
+  if (m_sq.local_tail - AtomicLoadAcquire(m_sq.head) >= m_sq.entries) {
+    unsigned int pending = PublishSubmissions();
+    if (EnterRing(m_ring_fd, pending, 0, 0, NULL, 0) < 0) {
+      OLA_WARN << "io_uring_enter() failed: " << strerror(errno);
+    }
+    if (m_sq.local_tail - AtomicLoadAcquire(m_sq.head) >= m_sq.entries) {
+      return NULL;
+    }
+  }
+
+  struct io_uring_sqe *sqe = &m_sq.sqes[m_sq.local_tail & m_sq.mask];
+  m_sq.local_tail++;
+  memset(sqe, 0, sizeof(*sqe));
+  return sqe;
+}
+
+/*
+ * Make the queued SQEs visible to the kernel, returns the number waiting to
+ * be submitted.
+ */
+unsigned int IOUringPoller::PublishSubmissions() {
+  AtomicStoreRelease(m_sq.tail, m_sq.local_tail);
+  return m_sq.local_tail - AtomicLoadAcquire(m_sq.head);
+}
+
+/*
+ * Submit any queued requests, wait for completions and copy them to
+ * m_completions. Returns the number of completions or -1 on error.
+ */
+int IOUringPoller::Wait(const TimeInterval &sleep_interval) {
+  struct __kernel_timespec timeout;
+  timeout.tv_sec = sleep_interval.Seconds();
+  timeout.tv_nsec = static_cast<int64_t>(sleep_interval.MicroSeconds()) *
+                    ONE_THOUSAND;
+
+  struct io_uring_getevents_arg arg;
+  memset(&arg, 0, sizeof(arg));
+  arg.ts = reinterpret_cast<uintptr_t>(&timeout);
+
+  unsigned int pending = PublishSubmissions();
+  int r = EnterRing(m_ring_fd, pending, 1,
+                    IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                    &arg, sizeof(arg));
+  int error = r < 0 ? errno : 0;
+
+  unsigned int head = AtomicLoadRelaxed(m_cq.head);
+  unsigned int tail = AtomicLoadAcquire(m_cq.tail);
+  m_completions.clear();
+  while (head != tail && m_completions.size() < m_batch_size) {
+    const struct io_uring_cqe &cqe = m_cq.cqes[head & m_cq.mask];
+    // Skip cancellations and requests for removed descriptors here, so they
+    // don't count towards the batch size.
+    if (STLContains(m_requests, cqe.user_data)) {
+      m_completions.push_back(cqe);
+    }
+    head++;
+  }
+  AtomicStoreRelease(m_cq.head, head);
+
+  if (m_completions.empty() && error != 0 && error != ETIME &&
+      error != EBUSY) {
+    errno = error;
+    return -1;
+  }
+  return static_cast<int>(m_completions.size());
+}
+
+void IOUringPoller::HandleCompletion(const struct io_uring_cqe &cqe) {
+  IOUringData *data = STLFindOrNull(m_requests, cqe.user_data);
+  if (!data) {
+    // A cancellation, or a request for a descriptor that has been removed.
+    return;
+  }
+
+  bool write = cqe.user_data == data->write_request;
+  bool *armed = write ? &data->write_armed : &data->read_armed;
+  if (!(cqe.flags & IORING_CQE_F_MORE)) {
+    *armed = false;
+  }
+
+  if (cqe.res < 0) {
+    if (cqe.res == -EINVAL && !write && data->multishot) {
+      OLA_INFO << "Multishot poll isn't supported, falling back to one-shot";
+      m_multishot = false;
+      data->multishot = false;
+      ArmRead(data);
+    } else {
+      OLA_WARN << "Poll of " << data->fd << " failed: " << strerror(-cqe.res);
+    }
+    return;
+  }
+
+  uint32_t events = static_cast<uint32_t>(cqe.res);
+  if (write) {
+    CheckWrite(data, events);
+  } else {
+    CheckRead(data, events);
+  }
+
+  // Re-arm the request, unless the callback removed the descriptor.
+  if (STLFindOrNull(m_requests, cqe.user_data) == data && !*armed) {
+    if (write) {
+      ArmWrite(data);
+    } else {
+      ArmRead(data);
+    }
+  }
+}
+
+/*
+ * Check a descriptor which is ready for reading:
+ *  - Execute the callback for descriptors with data
+ *  - Execute OnClose if a remote end closed the connection
+ */
+void IOUringPoller::CheckRead(IOUringData *data, uint32_t events) {
+  if (events & (POLLHUP | POLLRDHUP)) {
+    if (data->read_descriptor) {
+      data->read_descriptor->PerformRead();
+    } else if (data->connected_descriptor) {
+      ConnectedDescriptor::OnCloseCallback *on_close =
+          data->connected_descriptor->TransferOnClose();
+      if (on_close)
+        on_close->Run();
+
+      // At this point the descriptor may be sitting in the orphan list if the
+      // OnClose handler called into RemoveReadDescriptor()
+      if (data->delete_connected_on_close && data->connected_descriptor) {
+        ConnectedDescriptor *descriptor = data->connected_descriptor;
+        bool removed = RemoveDescriptor(data->fd, false, false);
+        if (removed && m_export_map) {
+          (*m_export_map->GetIntegerVar(K_CONNECTED_DESCRIPTORS_VAR))--;
+        }
+        delete descriptor;
+      }
+    }
+    return;
+  }
+
+  // POLLERR is reported even though we don't ask for it, the read will
+  // return the error.
+  if (events & (POLLIN | POLLERR)) {
+    if (data->read_descriptor) {
+      data->read_descriptor->PerformRead();
+    } else if (data->connected_descriptor) {
+      data->connected_descriptor->PerformRead();
+    }
+  }
+}
+
+void IOUringPoller::CheckWrite(IOUringData *data, uint32_t events) {
+  if (events & (POLLOUT | POLLERR | POLLHUP)) {
+    if (data->write_descriptor) {
+      data->write_descriptor->PerformWrite();
+    }
+  }
+}
+
+void IOUringPoller::CleanUp() {
+  DescriptorList::iterator iter = m_orphaned_descriptors.begin();
+  for (; iter != m_orphaned_descriptors.end(); ++iter) {
+    if (m_free_descriptors.size() == MAX_FREE_DESCRIPTORS) {
+      delete *iter;
+    } else {
+      (*iter)->Reset();
+      m_free_descriptors.push_back(*iter);
+    }
+  }
+  m_orphaned_descriptors.clear();
+}
+}  // namespace io
+}  // namespace ola
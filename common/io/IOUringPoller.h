@@ -0,0 +1,188 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * IOUringPoller.h
+ * A Poller which uses io_uring
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#ifndef COMMON_IO_IOURINGPOLLER_H_
+#define COMMON_IO_IOURINGPOLLER_H_
+
+#include <linux/io_uring.h>
+#include <ola/base/Macro.h>
+#include <ola/Clock.h>
+#include <ola/ExportMap.h>
+#include <ola/io/Descriptor.h>
+#include <stdint.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "common/io/PollerInterface.h"
+#include "common/io/TimeoutManager.h"
+
+namespace ola {
+namespace io {
+
+class IOUringData;
+
+/**
+ * @class IOUringPoller
+ * @brief An implementation of PollerInterface that uses io_uring.
+ *
+ * Each direction of each descriptor has a poll request outstanding on the
+ * ring. Requests are one-shot, and are re-armed once the callback has run.
+ * The re-arm requests are submitted by the same io_uring_enter() call that
+ * waits for the next events, so this costs one system call per loop, no
+ * matter how many descriptors were ready.
+ *
+ * Descriptors which read until they are empty use multishot poll requests,
+ * which stay armed until they're removed.
+ *
+ * This requires Linux 5.11 or later, Init() fails on older kernels.
+ */
+class IOUringPoller : public PollerInterface {
+ public :
+  struct Options {
+   public:
+    Options()
+        : batch_size(DEFAULT_BATCH_SIZE),
+          ring_size(DEFAULT_RING_SIZE) {
+    }
+
+    /**
+     * @brief The maximum number of completions to handle per loop.
+     */
+    unsigned int batch_size;
+
+    /**
+     * @brief The number of entries in the submission queue.
+     */
+    unsigned int ring_size;
+  };
+
+  /**
+   * @brief Create a new IOUringPoller.
+   * @param export_map the ExportMap to use
+   * @param clock the Clock to use
+   * @param options the options to use
+   */
+  IOUringPoller(ExportMap *export_map, Clock *clock,
+                const Options &options = Options());
+
+  ~IOUringPoller();
+
+  /**
+   * @brief Set up the ring.
+   * @returns false if the kernel doesn't support the io_uring features we
+   * need.
+   */
+  bool Init();
+
+  bool AddReadDescriptor(class ReadFileDescriptor *descriptor);
+  bool AddReadDescriptor(class ConnectedDescriptor *descriptor,
+                         bool delete_on_close);
+  bool RemoveReadDescriptor(class ReadFileDescriptor *descriptor);
+  bool RemoveReadDescriptor(class ConnectedDescriptor *descriptor);
+
+  bool AddWriteDescriptor(class WriteFileDescriptor *descriptor);
+  bool RemoveWriteDescriptor(class WriteFileDescriptor *descriptor);
+
+  const TimeStamp *WakeUpTime() const { return &m_wake_up_time; }
+
+  bool Poll(TimeoutManager *timeout_manager,
+            const TimeInterval &poll_interval);
+
+ private:
+  typedef std::map<int, IOUringData*> DescriptorMap;
+  typedef std::map<uint64_t, IOUringData*> RequestMap;
+  typedef std::vector<IOUringData*> DescriptorList;
+
+  struct SubmissionQueue {
+    unsigned int *head;
+    unsigned int *tail;
+    unsigned int *array;
+    unsigned int mask;
+    unsigned int entries;
+    struct io_uring_sqe *sqes;
+    unsigned int local_tail;  // includes the entries not yet published
+  };
+
+  struct CompletionQueue {
+    unsigned int *head;
+    unsigned int *tail;
+    unsigned int mask;
+    struct io_uring_cqe *cqes;
+  };
+
+  DescriptorMap m_descriptor_map;
+  // Maps the user_data of the outstanding poll requests to the descriptor
+  // data. Removing a descriptor removes its requests from this map, so any
+  // completions which arrive afterwards are ignored.
+  RequestMap m_requests;
+
+  // As with the EPoller, removed descriptors are kept here until we're out
+  // of the callback loop.
+  DescriptorList m_orphaned_descriptors;
+  DescriptorList m_free_descriptors;
+  ExportMap *m_export_map;
+  CounterVariable *m_loop_iterations;
+  CounterVariable *m_loop_time;
+  int m_ring_fd;
+  Clock *m_clock;
+  TimeStamp m_wake_up_time;
+  const unsigned int m_ring_size;
+  const unsigned int m_batch_size;
+  uint64_t m_next_request;
+  bool m_multishot;
+
+  void *m_sq_ring;
+  size_t m_sq_ring_size;
+  void *m_cq_ring;
+  size_t m_cq_ring_size;
+  size_t m_sqes_size;
+  SubmissionQueue m_sq;
+  CompletionQueue m_cq;
+  std::vector<struct io_uring_cqe> m_completions;
+
+  void CloseRing();
+  std::pair<IOUringData*, bool> LookupOrCreateDescriptor(int fd);
+  bool RemoveDescriptor(int fd, bool write, bool warn_on_missing);
+
+  bool ArmRead(IOUringData *data);
+  bool ArmWrite(IOUringData *data);
+  bool AddPoll(int fd, uint32_t events, uint64_t request, bool multishot);
+  void CancelPoll(uint64_t request);
+  struct io_uring_sqe *NextSubmission();
+  unsigned int PublishSubmissions();
+  int Wait(const TimeInterval &sleep_interval);
+  void HandleCompletion(const struct io_uring_cqe &cqe);
+  void CheckRead(IOUringData *data, uint32_t events);
+  void CheckWrite(IOUringData *data, uint32_t events);
+  void CleanUp();
+
+  static const unsigned int DEFAULT_BATCH_SIZE = 64;
+  static const unsigned int DEFAULT_RING_SIZE = 256;
+  static const uint32_t READ_EVENTS;
+  static const uint32_t WRITE_EVENTS;
+  static const unsigned int MAX_FREE_DESCRIPTORS;
+
+  DISALLOW_COPY_AND_ASSIGN(IOUringPoller);
+};
+}  // namespace io
+}  // namespace ola
+#endif  // COMMON_IO_IOURINGPOLLER_H_
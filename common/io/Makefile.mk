@@ -14,7 +14,9 @@ common_libolacommon_la_SOURCES += \
     common/io/Serial.cpp \
     common/io/StdinHandler.cpp \
     common/io/TimeoutManager.cpp \
-    common/io/TimeoutManager.h
+    common/io/TimeoutManager.h \
+    common/io/TimerWheel.cpp \
+    common/io/TimerWheel.h
 
 if USING_WIN32
 common_libolacommon_la_SOURCES += \
@@ -32,6 +34,12 @@ common_libolacommon_la_SOURCES += \
     common/io/EPoller.cpp
 endif
 
+if HAVE_IO_URING
+common_libolacommon_la_SOURCES += \
+    common/io/IOUringPoller.h \
+    common/io/IOUringPoller.cpp
+endif
+
 if HAVE_KQUEUE
 common_libolacommon_la_SOURCES += \
     common/io/KQueuePoller.h \
@@ -78,3 +86,24 @@ common_io_StreamTester_SOURCES = common/io/InputStreamTest.cpp \
                                  common/io/OutputStreamTest.cpp
 common_io_StreamTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_io_StreamTester_LDADD = $(COMMON_TESTING_LIBS)
+
+# Run the SelectServer tests against the other pollers as well.
+if HAVE_EPOLL
+test_scripts += common/io/SelectServerEPollTest.sh
+
+common/io/SelectServerEPollTest.sh: common/io/Makefile.mk
+	echo "OLA_USE_EPOLL=true exec ${top_builddir}/common/io/SelectServerTester${EXEEXT}" > common/io/SelectServerEPollTest.sh
+	chmod +x common/io/SelectServerEPollTest.sh
+
+CLEANFILES += common/io/SelectServerEPollTest.sh
+endif
+
+if HAVE_IO_URING
+test_scripts += common/io/SelectServerIOUringTest.sh
+
+common/io/SelectServerIOUringTest.sh: common/io/Makefile.mk
+	echo "OLA_USE_IO_URING=true exec ${top_builddir}/common/io/SelectServerTester${EXEEXT}" > common/io/SelectServerIOUringTest.sh
+	chmod +x common/io/SelectServerIOUringTest.sh
+
+CLEANFILES += common/io/SelectServerIOUringTest.sh
+endif
@@ -41,21 +41,38 @@
 #ifdef _WIN32
 #include "common/io/WindowsPoller.h"
 #else
-#include "ola/base/Flags.h"
-
-
 #include "common/io/SelectPoller.h"
 #endif  // _WIN32
 
+#include "common/io/TimeoutManager.h"
+#include "ola/base/Flags.h"
 #include "ola/io/Descriptor.h"
 #include "ola/Logging.h"
 #include "ola/network/Socket.h"
 #include "ola/stl/STLUtils.h"
 
+DEFINE_default_bool(use_timer_wheel, false,
+                    "Use a timer wheel rather than a priority queue for "
+                    "timeouts");
+
+#if defined(HAVE_EPOLL) || defined(HAVE_IO_URING)
+DEFINE_uint16(poll_batch_size, 64,
+              "The maximum number of events to handle per epoll() call");
+#endif  // defined(HAVE_EPOLL) || defined(HAVE_IO_URING)
+
+#ifdef HAVE_IO_URING
+#include "common/io/IOUringPoller.h"
+DEFINE_default_bool(use_io_uring, false,
+                    "Use io_uring rather than epoll()");
+#endif  // HAVE_IO_URING
+
 #ifdef HAVE_EPOLL
 #include "common/io/EPoller.h"
 DEFINE_default_bool(use_epoll, true,
                     "Disable the use of epoll(), revert to select()");
+DEFINE_default_bool(poll_edge_triggered, false,
+                    "Use edge-triggered epoll() events for descriptors that "
+                    "read until empty");
 #endif  // HAVE_EPOLL
 
 #ifdef HAVE_KQUEUE
@@ -291,18 +308,56 @@ void SelectServer::Init(const Options &options) {
     m_export_map->GetIntegerVar(PollerInterface::K_CONNECTED_DESCRIPTORS_VAR);
   }
 
-  m_timeout_manager.reset(new TimeoutManager(m_export_map, m_clock));
+  bool use_timer_wheel = options.use_timer_wheel || FLAGS_use_timer_wheel;
+  m_timeout_manager.reset(new TimeoutManager(m_export_map, m_clock,
+                                             use_timer_wheel));
+  if (m_export_map) {
+    m_export_map->GetBoolVar("using-timer-wheel")->Set(use_timer_wheel);
+  }
 #ifdef _WIN32
   m_poller.reset(new WindowsPoller(m_export_map, m_clock));
   (void) options;
 #else
 
+#ifdef HAVE_IO_URING
+  bool using_io_uring = false;
+  if ((options.use_io_uring || FLAGS_use_io_uring) && !options.force_select) {
+    IOUringPoller::Options io_uring_options;
+    io_uring_options.batch_size = options.poll_batch_size ?
+        options.poll_batch_size : FLAGS_poll_batch_size;
+    std::auto_ptr<IOUringPoller> poller(
+        new IOUringPoller(m_export_map, m_clock, io_uring_options));
+    if (poller->Init()) {
+      m_poller.reset(poller.release());
+      using_io_uring = true;
+    } else {
+      OLA_WARN << "io_uring isn't available, falling back to epoll()";
+    }
+  }
+  if (m_export_map) {
+    m_export_map->GetBoolVar("using-io-uring")->Set(using_io_uring);
+  }
+#endif  // HAVE_IO_URING
+
 #ifdef HAVE_EPOLL
-  if (FLAGS_use_epoll && !options.force_select) {
-    m_poller.reset(new EPoller(m_export_map, m_clock));
+  bool using_epoll = false;
+  bool fall_back_to_epoll = options.use_io_uring;
+#ifdef HAVE_IO_URING
+  fall_back_to_epoll |= FLAGS_use_io_uring;
+#endif  // HAVE_IO_URING
+  if ((FLAGS_use_epoll || fall_back_to_epoll) && !m_poller.get() &&
+      !options.force_select) {
+    EPoller::Options epoll_options;
+    epoll_options.batch_size = options.poll_batch_size ?
+        options.poll_batch_size : FLAGS_poll_batch_size;
+    epoll_options.edge_triggered = (
+        options.edge_triggered || FLAGS_poll_edge_triggered);
+    epoll_options.busy_poll_interval = options.busy_poll_interval;
+    m_poller.reset(new EPoller(m_export_map, m_clock, epoll_options));
+    using_epoll = true;
   }
   if (m_export_map) {
-    m_export_map->GetBoolVar("using-epoll")->Set(FLAGS_use_epoll);
+    m_export_map->GetBoolVar("using-epoll")->Set(using_epoll);
   }
 #endif  // HAVE_EPOLL
 
@@ -25,6 +25,8 @@
 
 #ifdef _WIN32
 #include <ola/win/CleanWinSock2.h>
+#else
+#include <unistd.h>
 #endif  // _WIN32
 
 #include <cppunit/extensions/HelperMacros.h>
@@ -51,6 +53,7 @@ using ola::io::LoopbackDescriptor;
 using ola::io::PollerInterface;
 using ola::io::SelectServer;
 using ola::io::UnixSocket;
+using ola::io::UnmanagedFileDescriptor;
 using ola::io::WriteFileDescriptor;
 using ola::network::UDPSocket;
 using std::auto_ptr;
@@ -95,6 +98,10 @@ class SelectServerTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testTimeout);
   CPPUNIT_TEST(testOffByOneTimeout);
   CPPUNIT_TEST(testLoopCallbacks);
+  CPPUNIT_TEST(testUseIOUring);
+#ifndef _WIN32
+  CPPUNIT_TEST(testPollOptions);
+#endif  // !_WIN32
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -115,6 +122,8 @@ class SelectServerTest: public CppUnit::TestFixture {
   void testTimeout();
   void testOffByOneTimeout();
   void testLoopCallbacks();
+  void testUseIOUring();
+  void testPollOptions();
 
   void FatalTimeout() {
     OLA_FAIL("Fatal Timeout");
@@ -187,9 +196,19 @@ class SelectServerTest: public CppUnit::TestFixture {
 
   void IncrementLoopCounter() { m_loop_counter++; }
 
+  void ReadByte(ola::io::ReadFileDescriptor *descriptor) {
+    uint8_t data;
+#ifndef _WIN32
+    if (read(descriptor->ReadDescriptor(), &data, sizeof(data)) == 1) {
+      m_read_counter++;
+    }
+#endif  // !_WIN32
+  }
+
  private:
   unsigned int m_timeout_counter;
   unsigned int m_loop_counter;
+  unsigned int m_read_counter;
   ExportMap m_map;
   IntegerVariable *connected_read_descriptor_count;
   IntegerVariable *read_descriptor_count;
@@ -211,6 +230,7 @@ void SelectServerTest::setUp() {
   m_ss = new SelectServer(&m_map);
   m_timeout_counter = 0;
   m_loop_counter = 0;
+  m_read_counter = 0;
 
 #if _WIN32
   WSADATA wsa_data;
@@ -660,3 +680,89 @@ void SelectServerTest::testLoopCallbacks() {
   // we should have at least 5 calls to IncrementLoopCounter
   OLA_ASSERT_TRUE(m_loop_counter >= 5);
 }
+
+
+/*
+ * Check that a SelectServer which asks for io_uring works, even if it fell
+ * back to another poller.
+ */
+void SelectServerTest::testUseIOUring() {
+  SelectServer::Options options;
+  options.export_map = &m_map;
+  options.use_io_uring = true;
+  SelectServer ss(options);
+  OLA_ASSERT_FALSE(m_map.GetBoolVar("using-io-uring")->Get() &&
+                   m_map.GetBoolVar("using-epoll")->Get());
+
+  // This goes through the loopback descriptor.
+  ss.Execute(
+      ola::NewSingleCallback(this, &SelectServerTest::IncrementLoopCounter));
+  ss.RunOnce(ola::TimeInterval(0, 100000));
+  OLA_ASSERT_EQ(1u, m_loop_counter);
+}
+
+
+#ifndef _WIN32
+/*
+ * Check the batch size, edge triggering and busy polling options.
+ */
+void SelectServerTest::testPollOptions() {
+  SelectServer::Options options;
+  options.export_map = &m_map;
+  options.poll_batch_size = 2;
+  options.edge_triggered = true;
+  options.busy_poll_interval = ola::TimeInterval(0, 500);
+  SelectServer ss(options);
+  // The batch size applies to epoll and io_uring, the other options only
+  // apply to epoll, but io_uring's multishot polls behave the same way.
+  bool using_epoll = (m_map.GetBoolVar("using-epoll")->Get() ||
+                      m_map.GetBoolVar("using-io-uring")->Get());
+
+  const unsigned int PIPE_COUNT = 4;
+  int pipes[PIPE_COUNT][2];
+  UnmanagedFileDescriptor *readers[PIPE_COUNT];
+  for (unsigned int i = 0; i < PIPE_COUNT; i++) {
+    OLA_ASSERT_EQ(0, pipe(pipes[i]));
+    readers[i] = new UnmanagedFileDescriptor(pipes[i][0]);
+    readers[i]->SetOnData(
+        NewCallback(this, &SelectServerTest::ReadByte,
+                    static_cast<ola::io::ReadFileDescriptor*>(readers[i])));
+    OLA_ASSERT_TRUE(ss.AddReadDescriptor(readers[i]));
+    OLA_ASSERT_EQ(static_cast<ssize_t>(1), write(pipes[i][1], "a", 1));
+  }
+
+  // All the descriptors are readable, but each iteration only handles two.
+  ss.RunOnce(ola::TimeInterval(0, 100000));
+  if (using_epoll) {
+    OLA_ASSERT_EQ(2u, m_read_counter);
+  }
+  ss.RunOnce(ola::TimeInterval(0, 100000));
+  OLA_ASSERT_EQ(PIPE_COUNT, m_read_counter);
+
+  // This reader claims to drain the descriptor but only reads one byte, so
+  // with edge triggering it's not woken again until more data arrives.
+  ss.RemoveReadDescriptor(readers[0]);
+  readers[0]->SetReadsUntilEmpty(true);
+  OLA_ASSERT_TRUE(ss.AddReadDescriptor(readers[0]));
+  OLA_ASSERT_EQ(static_cast<ssize_t>(2), write(pipes[0][1], "ab", 2));
+  ss.RunOnce(ola::TimeInterval(0, 100000));
+  OLA_ASSERT_EQ(PIPE_COUNT + 1, m_read_counter);
+  ss.RunOnce(ola::TimeInterval(0, 10000));
+  if (using_epoll) {
+    OLA_ASSERT_EQ(PIPE_COUNT + 1, m_read_counter);
+  }
+
+  // A zero block interval still polls the descriptors once.
+  unsigned int read_count = m_read_counter;
+  OLA_ASSERT_EQ(static_cast<ssize_t>(1), write(pipes[1][1], "a", 1));
+  ss.RunOnce(ola::TimeInterval(0, 0));
+  OLA_ASSERT_EQ(read_count + 1, m_read_counter);
+
+  for (unsigned int i = 0; i < PIPE_COUNT; i++) {
+    ss.RemoveReadDescriptor(readers[i]);
+    delete readers[i];
+    close(pipes[i][0]);
+    close(pipes[i][1]);
+  }
+}
+#endif  // !_WIN32
@@ -21,6 +21,7 @@
 #include <cppunit/extensions/HelperMacros.h>
 
 #include <map>
+#include <vector>
 
 #include "common/io/TimeoutManager.h"
 #include "ola/Callback.h"
@@ -44,6 +45,9 @@ class TimeoutManagerTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testRepeatingTimeouts);
   CPPUNIT_TEST(testAbortedRepeatingTimeouts);
   CPPUNIT_TEST(testPendingEventShutdown);
+  CPPUNIT_TEST(testCancelFromCallback);
+  CPPUNIT_TEST(testLongTimeouts);
+  CPPUNIT_TEST(testManyTimeouts);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -51,6 +55,17 @@ class TimeoutManagerTest: public CppUnit::TestFixture {
     void testRepeatingTimeouts();
     void testAbortedRepeatingTimeouts();
     void testPendingEventShutdown();
+    void testCancelFromCallback();
+    void testLongTimeouts();
+    void testManyTimeouts();
+
+    void CheckSingleTimeouts(bool use_timer_wheel);
+    void CheckRepeatingTimeouts(bool use_timer_wheel);
+    void CheckAbortedRepeatingTimeouts(bool use_timer_wheel);
+    void CheckPendingEventShutdown(bool use_timer_wheel);
+    void CheckCancelFromCallback(bool use_timer_wheel);
+    void CheckLongTimeouts(bool use_timer_wheel);
+    void CheckManyTimeouts(bool use_timer_wheel);
 
     void HandleEvent(unsigned int event_id) {
       m_event_counters[event_id]++;
@@ -67,6 +82,12 @@ class TimeoutManagerTest: public CppUnit::TestFixture {
       return m_event_counters[event_id] < 2;
     }
 
+    bool HandleCancellingEvent(unsigned int event_id) {
+      m_event_counters[event_id]++;
+      m_timeout_manager->CancelTimeout(m_cancel_id);
+      return true;
+    }
+
     unsigned int GetEventCounter(unsigned int event_id) {
       return m_event_counters[event_id];
     }
@@ -74,6 +95,8 @@ class TimeoutManagerTest: public CppUnit::TestFixture {
  private:
     ExportMap m_map;
     std::map<unsigned int, unsigned int> m_event_counters;
+    TimeoutManager *m_timeout_manager;
+    timeout_id m_cancel_id;
 };
 
 
@@ -83,8 +106,14 @@ CPPUNIT_TEST_SUITE_REGISTRATION(TimeoutManagerTest);
  * Check RegisterSingleTimeout works.
  */
 void TimeoutManagerTest::testSingleTimeouts() {
+  CheckSingleTimeouts(false);
+  CheckSingleTimeouts(true);
+}
+
+void TimeoutManagerTest::CheckSingleTimeouts(bool use_timer_wheel) {
+  m_event_counters.clear();
   MockClock clock;
-  TimeoutManager timeout_manager(&m_map, &clock);
+  TimeoutManager timeout_manager(&m_map, &clock, use_timer_wheel);
 
   OLA_ASSERT_FALSE(timeout_manager.EventsPending());
 
@@ -137,8 +166,14 @@ void TimeoutManagerTest::testSingleTimeouts() {
  * Check RegisterRepeatingTimeout works.
  */
 void TimeoutManagerTest::testRepeatingTimeouts() {
+  CheckRepeatingTimeouts(false);
+  CheckRepeatingTimeouts(true);
+}
+
+void TimeoutManagerTest::CheckRepeatingTimeouts(bool use_timer_wheel) {
+  m_event_counters.clear();
   MockClock clock;
-  TimeoutManager timeout_manager(&m_map, &clock);
+  TimeoutManager timeout_manager(&m_map, &clock, use_timer_wheel);
 
   OLA_ASSERT_FALSE(timeout_manager.EventsPending());
 
@@ -191,8 +226,14 @@ void TimeoutManagerTest::testRepeatingTimeouts() {
  * Check returning false from a repeating timeout cancels the timeout.
  */
 void TimeoutManagerTest::testAbortedRepeatingTimeouts() {
+  CheckAbortedRepeatingTimeouts(false);
+  CheckAbortedRepeatingTimeouts(true);
+}
+
+void TimeoutManagerTest::CheckAbortedRepeatingTimeouts(bool use_timer_wheel) {
+  m_event_counters.clear();
   MockClock clock;
-  TimeoutManager timeout_manager(&m_map, &clock);
+  TimeoutManager timeout_manager(&m_map, &clock, use_timer_wheel);
 
   OLA_ASSERT_FALSE(timeout_manager.EventsPending());
 
@@ -223,8 +264,14 @@ void TimeoutManagerTest::testAbortedRepeatingTimeouts() {
  * destroyed.
  */
 void TimeoutManagerTest::testPendingEventShutdown() {
+  CheckPendingEventShutdown(false);
+  CheckPendingEventShutdown(true);
+}
+
+void TimeoutManagerTest::CheckPendingEventShutdown(bool use_timer_wheel) {
+  m_event_counters.clear();
   MockClock clock;
-  TimeoutManager timeout_manager(&m_map, &clock);
+  TimeoutManager timeout_manager(&m_map, &clock, use_timer_wheel);
 
   OLA_ASSERT_FALSE(timeout_manager.EventsPending());
 
@@ -241,3 +288,157 @@ void TimeoutManagerTest::testPendingEventShutdown() {
 
   OLA_ASSERT_TRUE(timeout_manager.EventsPending());
 }
+
+
+/*
+ * Check a timeout can cancel itself, and other timeouts, from a callback.
+ */
+void TimeoutManagerTest::testCancelFromCallback() {
+  CheckCancelFromCallback(false);
+  CheckCancelFromCallback(true);
+}
+
+void TimeoutManagerTest::CheckCancelFromCallback(bool use_timer_wheel) {
+  m_event_counters.clear();
+  MockClock clock;
+  TimeoutManager timeout_manager(&m_map, &clock, use_timer_wheel);
+  m_timeout_manager = &timeout_manager;
+
+  TimeInterval timeout_interval(1, 0);
+  m_cancel_id = timeout_manager.RegisterRepeatingTimeout(
+      timeout_interval,
+      NewCallback(this, &TimeoutManagerTest::HandleCancellingEvent, 1u));
+
+  TimeStamp last_checked_time;
+  clock.AdvanceTime(1, 0);
+  clock.CurrentTime(&last_checked_time);
+  timeout_manager.ExecuteTimeouts(&last_checked_time);
+  OLA_ASSERT_EQ(1u, GetEventCounter(1));
+
+  clock.AdvanceTime(1, 0);
+  clock.CurrentTime(&last_checked_time);
+  timeout_manager.ExecuteTimeouts(&last_checked_time);
+  OLA_ASSERT_EQ(1u, GetEventCounter(1));
+  OLA_ASSERT_FALSE(timeout_manager.EventsPending());
+
+  // Now cancel a timeout which expires in the same pass.
+  timeout_manager.RegisterRepeatingTimeout(
+      timeout_interval,
+      NewCallback(this, &TimeoutManagerTest::HandleCancellingEvent, 2u));
+  m_cancel_id = timeout_manager.RegisterSingleTimeout(
+      TimeInterval(1, 1),
+      NewSingleCallback(this, &TimeoutManagerTest::HandleEvent, 3u));
+
+  clock.AdvanceTime(2, 0);
+  clock.CurrentTime(&last_checked_time);
+  timeout_manager.ExecuteTimeouts(&last_checked_time);
+  OLA_ASSERT_EQ(1u, GetEventCounter(2));
+  OLA_ASSERT_EQ(0u, GetEventCounter(3));
+  OLA_ASSERT_TRUE(timeout_manager.EventsPending());
+  m_timeout_manager = NULL;
+}
+
+
+/*
+ * Check timeouts which are minutes, hours and days away.
+ */
+void TimeoutManagerTest::testLongTimeouts() {
+  CheckLongTimeouts(false);
+  CheckLongTimeouts(true);
+}
+
+void TimeoutManagerTest::CheckLongTimeouts(bool use_timer_wheel) {
+  m_event_counters.clear();
+  MockClock clock;
+  TimeoutManager timeout_manager(&m_map, &clock, use_timer_wheel);
+
+  // The MockClock follows the real clock, so allow some slack.
+  const TimeInterval slack(0, 10000);
+  const unsigned int intervals[] = {0, 1, 70, 300, 3600 * 5, 86400 * 60};
+  const unsigned int count = sizeof(intervals) / sizeof(intervals[0]);
+  TimeStamp start;
+  clock.CurrentTime(&start);
+  for (unsigned int i = 0; i < count; i++) {
+    timeout_manager.RegisterSingleTimeout(
+        TimeInterval(intervals[i], 20000),
+        NewSingleCallback(this, &TimeoutManagerTest::HandleEvent, i));
+  }
+
+  TimeStamp last_checked_time;
+  clock.CurrentTime(&last_checked_time);
+  TimeInterval next = timeout_manager.ExecuteTimeouts(&last_checked_time);
+  OLA_ASSERT_EQ(0u, GetEventCounter(0));
+  OLA_ASSERT_FALSE(next.IsZero());
+  OLA_ASSERT_LTE(next, TimeInterval(0, 20000));
+
+  // Jump to just before each timeout and then just after.
+  for (unsigned int i = 0; i < count; i++) {
+    TimeStamp expiry = start + TimeInterval(intervals[i], 20000);
+    clock.CurrentTime(&last_checked_time);
+    clock.AdvanceTime(
+        TimeInterval((expiry - last_checked_time).AsInt() - slack.AsInt()));
+    clock.CurrentTime(&last_checked_time);
+    next = timeout_manager.ExecuteTimeouts(&last_checked_time);
+    OLA_ASSERT_EQ(0u, GetEventCounter(i));
+    OLA_ASSERT_FALSE(next.IsZero());
+    OLA_ASSERT_LTE(next, TimeInterval(0, 20000));
+
+    clock.AdvanceTime(0, 20000);
+    clock.CurrentTime(&last_checked_time);
+    timeout_manager.ExecuteTimeouts(&last_checked_time);
+    OLA_ASSERT_EQ(1u, GetEventCounter(i));
+  }
+  OLA_ASSERT_FALSE(timeout_manager.EventsPending());
+}
+
+
+/*
+ * Add, cancel and run 100k timeouts. This also reports the time taken, so the
+ * two implementations can be compared.
+ */
+void TimeoutManagerTest::testManyTimeouts() {
+  CheckManyTimeouts(false);
+  CheckManyTimeouts(true);
+}
+
+void TimeoutManagerTest::CheckManyTimeouts(bool use_timer_wheel) {
+  m_event_counters.clear();
+  const unsigned int TIMEOUT_COUNT = 100000;
+  MockClock clock;
+  TimeoutManager timeout_manager(&m_map, &clock, use_timer_wheel);
+
+  ola::Clock real_clock;
+  TimeStamp start, end;
+  real_clock.CurrentTime(&start);
+
+  std::vector<timeout_id> ids;
+  ids.reserve(TIMEOUT_COUNT);
+  for (unsigned int i = 0; i < TIMEOUT_COUNT; i++) {
+    // Spread the timeouts over the next 10s
+    TimeInterval interval((i * 7919) % 10000 * 1000);
+    ids.push_back(timeout_manager.RegisterSingleTimeout(
+        interval,
+        NewSingleCallback(this, &TimeoutManagerTest::HandleEvent, 1u)));
+  }
+  OLA_ASSERT_EQ(static_cast<int>(TIMEOUT_COUNT),
+                m_map.GetIntegerVar(TimeoutManager::K_TIMER_VAR)->Get());
+
+  for (unsigned int i = 0; i < TIMEOUT_COUNT; i += 2) {
+    timeout_manager.CancelTimeout(ids[i]);
+  }
+
+  TimeStamp last_checked_time;
+  for (unsigned int i = 0; i <= 10000; i++) {
+    clock.AdvanceTime(0, 1000);
+    clock.CurrentTime(&last_checked_time);
+    timeout_manager.ExecuteTimeouts(&last_checked_time);
+  }
+  real_clock.CurrentTime(&end);
+
+  OLA_ASSERT_EQ(TIMEOUT_COUNT / 2, GetEventCounter(1));
+  OLA_ASSERT_FALSE(timeout_manager.EventsPending());
+  OLA_ASSERT_EQ(0, m_map.GetIntegerVar(TimeoutManager::K_TIMER_VAR)->Get());
+  OLA_INFO << TIMEOUT_COUNT << " timeouts using "
+           << (use_timer_wheel ? "the timer wheel" : "the priority queue")
+           << " took " << (end - start);
+}
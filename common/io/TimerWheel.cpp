@@ -0,0 +1,450 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * TimerWheel.cpp
+ * A hierarchical timer wheel.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "common/io/TimerWheel.h"
+
+namespace ola {
+namespace io {
+
+using ola::thread::INVALID_TIMEOUT;
+using ola::thread::timeout_id;
+
+const unsigned int TimerWheel::LEVELS;
+const unsigned int TimerWheel::SLOT_BITS;
+const unsigned int TimerWheel::SLOTS;
+const unsigned int TimerWheel::SLOT_MASK;
+const unsigned int TimerWheel::POOL_CHUNK_SIZE;
+
+TimerWheel::TimerWheel(ola::IntegerVariable *timer_count, Clock *clock)
+    : m_timer_count(timer_count),
+      m_clock(clock),
+      m_next_tick(0),
+      m_cascade_tick(~static_cast<uint64_t>(0)),
+      m_event_count(0),
+      m_free_nodes(NULL) {
+  m_clock->CurrentTime(&m_start);
+  for (unsigned int level = 0; level < LEVELS; level++) {
+    for (unsigned int slot = 0; slot < SLOTS; slot++) {
+      ListInit(&m_slots[level][slot]);
+    }
+  }
+  memset(m_occupied, 0, sizeof(m_occupied));
+  ListInit(&m_due);
+}
+
+TimerWheel::~TimerWheel() {
+  for (unsigned int level = 0; level < LEVELS; level++) {
+    for (unsigned int slot = 0; slot < SLOTS; slot++) {
+      while (!ListEmpty(&m_slots[level][slot])) {
+        Node *node = static_cast<Node*>(m_slots[level][slot].next);
+        Unlink(node);
+        ReleaseNode(node);
+      }
+    }
+  }
+
+  while (!ListEmpty(&m_due)) {
+    Node *node = static_cast<Node*>(m_due.next);
+    Unlink(node);
+    ReleaseNode(node);
+  }
+
+  std::vector<Node*>::iterator iter = m_chunks.begin();
+  for (; iter != m_chunks.end(); ++iter) {
+    delete[] *iter;
+  }
+}
+
+timeout_id TimerWheel::RegisterRepeatingTimeout(
+    const TimeInterval &interval,
+    ola::Callback0<bool> *closure) {
+  if (!closure) {
+    return INVALID_TIMEOUT;
+  }
+
+  Node *node = AllocateNode(interval);
+  node->repeating_closure = closure;
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+  Schedule(node, now);
+  return node;
+}
+
+timeout_id TimerWheel::RegisterSingleTimeout(
+    const TimeInterval &interval,
+    ola::SingleUseCallback0<void> *closure) {
+  if (!closure) {
+    return INVALID_TIMEOUT;
+  }
+
+  Node *node = AllocateNode(interval);
+  node->single_closure = closure;
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+  Schedule(node, now);
+  return node;
+}
+
+void TimerWheel::CancelTimeout(timeout_id id) {
+  if (id == INVALID_TIMEOUT) {
+    return;
+  }
+
+  Node *node = static_cast<Node*>(id);
+  if (node->state == NODE_PENDING) {
+    Unlink(node);
+    ReleaseNode(node);
+  } else if (node->state == NODE_RUNNING) {
+    // The node is released once the callback returns.
+    node->state = NODE_CANCELLED;
+  }
+}
+
+TimeInterval TimerWheel::ExecuteTimeouts(TimeStamp *now) {
+  if (!ListEmpty(&m_due)) {
+    ListNode due;
+    ListSplice(&m_due, &due);
+    RunList(&due, now);
+  }
+
+  uint64_t now_tick = TicksSinceStart(*now);
+  while (m_next_tick <= now_tick) {
+    unsigned int index = m_next_tick & SLOT_MASK;
+    if (index == 0 && m_cascade_tick != m_next_tick) {
+      // Move the timers from the higher levels down.
+      for (unsigned int level = 1; level < LEVELS; level++) {
+        unsigned int slot = (m_next_tick >> (level * SLOT_BITS)) & SLOT_MASK;
+        Cascade(level, slot);
+        if (slot) {
+          break;
+        }
+      }
+      m_cascade_tick = m_next_tick;
+    }
+
+    if (!IsOccupied(0, index)) {
+      // Skip ahead to the next tick with something to do.
+      uint64_t next_tick;
+      if (!NextTick(&next_tick) || next_tick > now_tick) {
+        m_next_tick = now_tick + 1;
+        break;
+      }
+      m_next_tick = next_tick;
+      continue;
+    }
+
+    m_next_tick++;
+    ListNode expired;
+    TakeSlot(0, index, &expired);
+    RunList(&expired, now);
+    now_tick = TicksSinceStart(*now);
+  }
+
+  TimeStamp next_time;
+  if (!NextEventTime(&next_time)) {
+    return TimeInterval();
+  }
+
+  if (next_time <= *now) {
+    // Timers were added or became due while running callbacks, run them on
+    // the next call.
+    return TimeInterval(0, 1);
+  }
+  return next_time - *now;
+}
+
+TimerWheel::Node *TimerWheel::AllocateNode(const TimeInterval &interval) {
+  if (!m_free_nodes) {
+    Node *chunk = new Node[POOL_CHUNK_SIZE];
+    m_chunks.push_back(chunk);
+    for (unsigned int i = 0; i < POOL_CHUNK_SIZE; i++) {
+      chunk[i].state = NODE_FREE;
+      chunk[i].next = m_free_nodes;
+      m_free_nodes = &chunk[i];
+    }
+  }
+
+  Node *node = m_free_nodes;
+  m_free_nodes = static_cast<Node*>(node->next);
+  node->prev = NULL;
+  node->next = NULL;
+  node->interval = interval;
+  node->expiry = TimeStamp();
+  node->tick = 0;
+  node->single_closure = NULL;
+  node->repeating_closure = NULL;
+  node->state = NODE_PENDING;
+  node->level = -1;
+  node->slot = 0;
+
+  m_event_count++;
+  if (m_timer_count) {
+    (*m_timer_count)++;
+  }
+  return node;
+}
+
+void TimerWheel::ReleaseNode(Node *node) {
+  delete node->single_closure;
+  delete node->repeating_closure;
+  node->single_closure = NULL;
+  node->repeating_closure = NULL;
+  node->state = NODE_FREE;
+  node->next = m_free_nodes;
+  m_free_nodes = node;
+
+  m_event_count--;
+  if (m_timer_count) {
+    (*m_timer_count)--;
+  }
+}
+
+void TimerWheel::Schedule(Node *node, const TimeStamp &now) {
+  node->expiry = now + node->interval;
+  node->tick = TicksSinceStart(node->expiry);
+  Insert(node);
+}
+
+void TimerWheel::Insert(Node *node) {
+  if (node->tick < m_next_tick) {
+    node->level = -1;
+    ListAppend(&m_due, node);
+    return;
+  }
+
+  uint64_t delta = node->tick - m_next_tick;
+  uint64_t tick = node->tick;
+  unsigned int level = 0;
+  while (level < LEVELS - 1 &&
+         delta >= (static_cast<uint64_t>(1) << ((level + 1) * SLOT_BITS))) {
+    level++;
+  }
+
+  const uint64_t max_delta = static_cast<uint64_t>(1) << (LEVELS * SLOT_BITS);
+  if (delta >= max_delta) {
+    // This is re-inserted using the real tick when the slot cascades.
+    tick = m_next_tick + max_delta - 1;
+  }
+
+  unsigned int slot = (tick >> (level * SLOT_BITS)) & SLOT_MASK;
+  node->level = level;
+  node->slot = slot;
+  ListAppend(&m_slots[level][slot], node);
+  m_occupied[level][slot / 64] |= static_cast<uint64_t>(1) << (slot % 64);
+}
+
+void TimerWheel::Unlink(Node *node) {
+  node->prev->next = node->next;
+  node->next->prev = node->prev;
+  node->prev = NULL;
+  node->next = NULL;
+
+  if (node->level >= 0) {
+    unsigned int level = node->level;
+    if (ListEmpty(&m_slots[level][node->slot])) {
+      m_occupied[level][node->slot / 64] &=
+          ~(static_cast<uint64_t>(1) << (node->slot % 64));
+    }
+  }
+}
+
+void TimerWheel::TakeSlot(unsigned int level, unsigned int slot,
+                          ListNode *list) {
+  ListSplice(&m_slots[level][slot], list);
+  m_occupied[level][slot / 64] &= ~(static_cast<uint64_t>(1) << (slot % 64));
+}
+
+void TimerWheel::Cascade(unsigned int level, unsigned int slot) {
+  ListNode list;
+  TakeSlot(level, slot, &list);
+  while (!ListEmpty(&list)) {
+    Node *node = static_cast<Node*>(list.next);
+    node->level = -1;
+    Unlink(node);
+    Insert(node);
+  }
+}
+
+/*
+ * Run the timers in a list which has been removed from the wheel. Timers
+ * which expire later in the current tick are moved to the due list.
+ */
+void TimerWheel::RunList(ListNode *list, TimeStamp *now) {
+  while (!ListEmpty(list)) {
+    Node *node = static_cast<Node*>(list->next);
+    // The node is no longer in a slot, so don't touch the occupied bits.
+    node->level = -1;
+    Unlink(node);
+
+    if (node->expiry > *now) {
+      ListAppend(&m_due, node);
+      continue;
+    }
+
+    node->state = NODE_RUNNING;
+    bool repeat = Trigger(node);
+    if (repeat && node->state == NODE_RUNNING) {
+      // true implies we need to run this again
+      node->state = NODE_PENDING;
+      Schedule(node, *now);
+    } else {
+      ReleaseNode(node);
+    }
+    m_clock->CurrentTime(now);
+  }
+}
+
+bool TimerWheel::Trigger(Node *node) {
+  if (node->single_closure) {
+    ola::BaseCallback0<void> *closure = node->single_closure;
+    // it deletes itself when run
+    node->single_closure = NULL;
+    closure->Run();
+    return false;
+  }
+  return node->repeating_closure->Run();
+}
+
+/*
+ * Find the earliest time we need to wake up at. This is the earliest timer in
+ * the due list or the next tick with something to do.
+ */
+bool TimerWheel::NextEventTime(TimeStamp *next) const {
+  bool found = false;
+  const ListNode *due = m_due.next;
+  for (; due != &m_due; due = due->next) {
+    const TimeStamp &expiry = static_cast<const Node*>(due)->expiry;
+    if (!found || expiry < *next) {
+      *next = expiry;
+      found = true;
+    }
+  }
+
+  uint64_t tick;
+  if (NextTick(&tick)) {
+    TimeStamp tick_time = m_start + TimeInterval(
+        static_cast<int64_t>(tick * ONE_THOUSAND));
+    if (!found || tick_time < *next) {
+      *next = tick_time;
+    }
+    found = true;
+  }
+  return found;
+}
+
+/*
+ * Find the next tick, at or after m_next_tick, where either a slot in the
+ * first level has timers to run, or an occupied slot in a higher level is
+ * cascaded.
+ */
+bool TimerWheel::NextTick(uint64_t *tick) const {
+  bool found = false;
+  for (unsigned int level = 0; level < LEVELS; level++) {
+    unsigned int shift = level * SLOT_BITS;
+    uint64_t level_period = static_cast<uint64_t>(1) << shift;
+    uint64_t rotation_period = level_period << SLOT_BITS;
+    uint64_t rotation_start = m_next_tick & ~(rotation_period - 1);
+    unsigned int index = (m_next_tick >> shift) & SLOT_MASK;
+
+    // Level 0 runs the slot for the current tick, higher levels cascade it
+    // if we're at the start of the slot and that hasn't happened yet.
+    bool current_pending = level == 0 ||
+        ((m_next_tick & (level_period - 1)) == 0 &&
+         m_cascade_tick != m_next_tick);
+
+    uint64_t candidate;
+    int slot = NextOccupied(level, current_pending ? index : index + 1);
+    if (slot >= 0) {
+      candidate = rotation_start + slot * level_period;
+    } else {
+      slot = NextOccupied(level, 0);
+      if (slot < 0) {
+        continue;
+      }
+      candidate = rotation_start + rotation_period + slot * level_period;
+    }
+
+    if (!found || candidate < *tick) {
+      *tick = candidate;
+      found = true;
+    }
+  }
+  return found;
+}
+
+/*
+ * Return the first occupied slot >= slot in a level, or -1 if there isn't
+ * one.
+ */
+int TimerWheel::NextOccupied(unsigned int level, unsigned int slot) const {
+  if (slot >= SLOTS) {
+    return -1;
+  }
+  for (unsigned int word = slot / 64; word < SLOTS / 64; word++) {
+    uint64_t bits = m_occupied[level][word];
+    if (word == slot / 64) {
+      bits &= ~static_cast<uint64_t>(0) << (slot % 64);
+    }
+    if (bits) {
+      return word * 64 + __builtin_ctzll(bits);
+    }
+  }
+  return -1;
+}
+
+uint64_t TimerWheel::TicksSinceStart(const TimeStamp &time) const {
+  if (time <= m_start) {
+    return 0;
+  }
+  return (time - m_start).AsInt() / ONE_THOUSAND;
+}
+
+void TimerWheel::ListInit(ListNode *list) {
+  list->prev = list;
+  list->next = list;
+}
+
+void TimerWheel::ListAppend(ListNode *list, ListNode *node) {
+  node->prev = list->prev;
+  node->next = list;
+  list->prev->next = node;
+  list->prev = node;
+}
+
+/*
+ * Move all the nodes from one list to another, empty list.
+ */
+void TimerWheel::ListSplice(ListNode *from, ListNode *to) {
+  if (ListEmpty(from)) {
+    ListInit(to);
+    return;
+  }
+  to->next = from->next;
+  to->prev = from->prev;
+  to->next->prev = to;
+  to->prev->next = to;
+  ListInit(from);
+}
+}  // namespace io
+}  // namespace ola
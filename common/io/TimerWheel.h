@@ -0,0 +1,154 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * TimerWheel.h
+ * A hierarchical timer wheel.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#ifndef COMMON_IO_TIMERWHEEL_H_
+#define COMMON_IO_TIMERWHEEL_H_
+
+#include <stdint.h>
+#include <vector>
+
+#include "ola/Callback.h"
+#include "ola/Clock.h"
+#include "ola/ExportMap.h"
+#include "ola/base/Macro.h"
+#include "ola/thread/SchedulerInterface.h"
+
+namespace ola {
+namespace io {
+
+/**
+ * @brief A hierarchical timer wheel.
+ *
+ * Timers are bucketed by the millisecond they expire in. There are four
+ * levels of 256 slots; the first level holds the timers due in the next 256ms
+ * and each higher level covers 256 times the range of the one below it. As
+ * time advances, the slots of the higher levels are cascaded down. Timers
+ * more than 2^32 ms away are clamped to the top level and re-bucketed when
+ * they cascade.
+ *
+ * Adding and cancelling timers is O(1), and the timer nodes are taken from a
+ * pool rather than being allocated each time.
+ *
+ * Timers which expire in the same millisecond fire in the order they were
+ * added, rather than strictly in order of expiry.
+ *
+ * This has the same interface as the TimeoutManager, which uses it as an
+ * alternate backend.
+ */
+class TimerWheel {
+ public:
+  /**
+   * @brief Create a new TimerWheel.
+   * @param timer_count the variable to update with the number of timers, may
+   *   be NULL.
+   * @param clock the Clock to use.
+   */
+  TimerWheel(ola::IntegerVariable *timer_count, Clock *clock);
+
+  ~TimerWheel();
+
+  ola::thread::timeout_id RegisterRepeatingTimeout(
+      const ola::TimeInterval &interval,
+      ola::Callback0<bool> *closure);
+
+  ola::thread::timeout_id RegisterSingleTimeout(
+      const ola::TimeInterval &interval,
+      ola::SingleUseCallback0<void> *closure);
+
+  void CancelTimeout(ola::thread::timeout_id id);
+
+  bool EventsPending() const { return m_event_count != 0; }
+
+  TimeInterval ExecuteTimeouts(TimeStamp *now);
+
+ private:
+  static const unsigned int LEVELS = 4;
+  static const unsigned int SLOT_BITS = 8;
+  static const unsigned int SLOTS = 1 << SLOT_BITS;
+  static const unsigned int SLOT_MASK = SLOTS - 1;
+  static const unsigned int POOL_CHUNK_SIZE = 256;
+
+  struct ListNode {
+    ListNode *prev;
+    ListNode *next;
+  };
+
+  enum NodeState {
+    NODE_FREE,
+    NODE_PENDING,
+    NODE_RUNNING,
+    NODE_CANCELLED,
+  };
+
+  struct Node : public ListNode {
+    TimeInterval interval;
+    TimeStamp expiry;
+    uint64_t tick;
+    ola::BaseCallback0<void> *single_closure;
+    ola::BaseCallback0<bool> *repeating_closure;
+    NodeState state;
+    int level;  // -1 for the due list
+    unsigned int slot;
+  };
+
+  ola::IntegerVariable *m_timer_count;
+  Clock *m_clock;
+  TimeStamp m_start;
+  uint64_t m_next_tick;  // the next tick to process
+  uint64_t m_cascade_tick;  // the last tick the higher levels were cascaded
+  unsigned int m_event_count;
+
+  ListNode m_slots[LEVELS][SLOTS];
+  uint64_t m_occupied[LEVELS][SLOTS / 64];  // a bit per non-empty slot
+  ListNode m_due;  // timers in a tick that has already been processed
+
+  std::vector<Node*> m_chunks;
+  Node *m_free_nodes;
+
+  Node *AllocateNode(const TimeInterval &interval);
+  void ReleaseNode(Node *node);
+  void Schedule(Node *node, const TimeStamp &now);
+  void Insert(Node *node);
+  void Unlink(Node *node);
+  void TakeSlot(unsigned int level, unsigned int slot, ListNode *list);
+  void Cascade(unsigned int level, unsigned int slot);
+  void RunList(ListNode *list, TimeStamp *now);
+  bool Trigger(Node *node);
+  bool NextEventTime(TimeStamp *next) const;
+  bool NextTick(uint64_t *tick) const;
+  int NextOccupied(unsigned int level, unsigned int slot) const;
+
+  bool IsOccupied(unsigned int level, unsigned int slot) const {
+    return m_occupied[level][slot / 64] &
+        (static_cast<uint64_t>(1) << (slot % 64));
+  }
+
+  uint64_t TicksSinceStart(const TimeStamp &time) const;
+
+  static void ListInit(ListNode *list);
+  static bool ListEmpty(const ListNode *list) { return list->next == list; }
+  static void ListAppend(ListNode *list, ListNode *node);
+  static void ListSplice(ListNode *from, ListNode *to);
+
+  DISALLOW_COPY_AND_ASSIGN(TimerWheel);
+};
+}  // namespace io
+}  // namespace ola
+#endif  // COMMON_IO_TIMERWHEEL_H_
@@ -0,0 +1,83 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * DatagramBatch.cpp
+ * Queue UDP datagrams and send them together.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include "ola/network/DatagramBatch.h"
+
+#include <vector>
+
+#include "ola/Callback.h"
+
+namespace ola {
+namespace network {
+
+DatagramBatch::~DatagramBatch() {
+  Clear();
+}
+
+void DatagramBatch::Add(const uint8_t *data, unsigned int size,
+                        const IPV4SocketAddress &destination) {
+  if (m_scheduler && m_flush_timeout == ola::thread::INVALID_TIMEOUT) {
+    m_flush_timeout = m_scheduler->RegisterSingleTimeout(
+        0, NewSingleCallback(this, &DatagramBatch::ScheduledFlush));
+  }
+
+  QueuedDatagram datagram;
+  datagram.offset = static_cast<unsigned int>(m_data.size());
+  datagram.size = size;
+  datagram.destination = destination;
+  m_queued.push_back(datagram);
+  m_data.insert(m_data.end(), data, data + size);
+}
+
+unsigned int DatagramBatch::Flush() {
+  if (m_queued.empty()) {
+    return 0;
+  }
+
+  // m_data may have been reallocated as datagrams were added, so the pointers
+  // are only calculated now.
+  m_outgoing.resize(m_queued.size());
+  for (unsigned int i = 0; i < m_queued.size(); i++) {
+    m_outgoing[i].data = &m_data[m_queued[i].offset];
+    m_outgoing[i].size = m_queued[i].size;
+    m_outgoing[i].destination = m_queued[i].destination;
+  }
+
+  unsigned int sent = m_socket->SendManyTo(
+      &m_outgoing[0], static_cast<unsigned int>(m_outgoing.size()));
+  Clear();
+  return sent;
+}
+
+void DatagramBatch::Clear() {
+  if (m_flush_timeout != ola::thread::INVALID_TIMEOUT) {
+    m_scheduler->RemoveTimeout(m_flush_timeout);
+    m_flush_timeout = ola::thread::INVALID_TIMEOUT;
+  }
+  m_data.clear();
+  m_queued.clear();
+}
+
+void DatagramBatch::ScheduledFlush() {
+  m_flush_timeout = ola::thread::INVALID_TIMEOUT;
+  Flush();
+}
+}  // namespace network
+}  // namespace ola
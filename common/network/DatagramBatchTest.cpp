@@ -0,0 +1,124 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * DatagramBatchTest.cpp
+ * Test fixture for the DatagramBatch class
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "ola/io/SelectServer.h"
+#include "ola/network/DatagramBatch.h"
+#include "ola/network/IPV4Address.h"
+#include "ola/network/SocketAddress.h"
+#include "ola/testing/MockUDPSocket.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::io::SelectServer;
+using ola::network::DatagramBatch;
+using ola::network::IPV4Address;
+using ola::network::IPV4SocketAddress;
+using ola::testing::MockUDPSocket;
+using ola::testing::SocketVerifier;
+
+class DatagramBatchTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(DatagramBatchTest);
+  CPPUNIT_TEST(testBatch);
+  CPPUNIT_TEST(testScheduledFlush);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void testBatch();
+    void testScheduledFlush();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DatagramBatchTest);
+
+
+/*
+ * Check datagrams are queued until the batch is flushed.
+ */
+void DatagramBatchTest::testBatch() {
+  MockUDPSocket socket;
+  OLA_ASSERT_TRUE(socket.Init());
+  DatagramBatch batch(&socket);
+  OLA_ASSERT_TRUE(batch.Empty());
+  OLA_ASSERT_EQ(0u, batch.Flush());
+
+  const IPV4Address ip1 = IPV4Address::FromStringOrDie("10.0.0.1");
+  const IPV4Address ip2 = IPV4Address::FromStringOrDie("10.0.0.2");
+  const uint8_t expected1[] = {1, 2, 3};
+  const uint8_t expected2[] = {4, 5};
+
+  {
+    SocketVerifier verifier(&socket);
+    // The batch takes a copy, so the buffer can be reused.
+    uint8_t data[3];
+    memcpy(data, expected1, sizeof(expected1));
+    batch.Add(data, sizeof(expected1), IPV4SocketAddress(ip1, 6454));
+    memcpy(data, expected2, sizeof(expected2));
+    batch.Add(data, sizeof(expected2), IPV4SocketAddress(ip2, 5568));
+    memset(data, 0, sizeof(data));
+    OLA_ASSERT_EQ(2u, batch.Size());
+
+    socket.AddExpectedData(expected1, sizeof(expected1), ip1, 6454);
+    socket.AddExpectedData(expected2, sizeof(expected2), ip2, 5568);
+    OLA_ASSERT_EQ(2u, batch.Flush());
+    OLA_ASSERT_TRUE(batch.Empty());
+  }
+
+  batch.Add(expected1, sizeof(expected1), IPV4SocketAddress(ip1, 6454));
+  batch.Clear();
+  OLA_ASSERT_TRUE(batch.Empty());
+  OLA_ASSERT_EQ(0u, batch.Flush());
+}
+
+
+/*
+ * Check the batch is flushed by the SelectServer.
+ */
+void DatagramBatchTest::testScheduledFlush() {
+  SelectServer ss;
+  MockUDPSocket socket;
+  OLA_ASSERT_TRUE(socket.Init());
+  DatagramBatch batch(&socket, &ss);
+
+  const IPV4Address ip = IPV4Address::FromStringOrDie("10.0.0.1");
+  const uint8_t expected1[] = {1, 2, 3};
+  const uint8_t expected2[] = {4, 5};
+
+  {
+    SocketVerifier verifier(&socket);
+    batch.Add(expected1, sizeof(expected1), IPV4SocketAddress(ip, 6454));
+    batch.Add(expected2, sizeof(expected2), IPV4SocketAddress(ip, 6454));
+
+    socket.AddExpectedData(expected1, sizeof(expected1), ip, 6454);
+    socket.AddExpectedData(expected2, sizeof(expected2), ip, 6454);
+    ss.RunOnce(ola::TimeInterval(0, 0));
+    OLA_ASSERT_TRUE(batch.Empty());
+  }
+
+  // A manual flush cancels the scheduled one.
+  {
+    SocketVerifier verifier(&socket);
+    batch.Add(expected1, sizeof(expected1), IPV4SocketAddress(ip, 6454));
+    socket.AddExpectedData(expected1, sizeof(expected1), ip, 6454);
+    OLA_ASSERT_EQ(1u, batch.Flush());
+    ss.RunOnce(ola::TimeInterval(0, 0));
+  }
+}
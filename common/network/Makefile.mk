@@ -2,6 +2,7 @@
 ##################################################
 common_libolacommon_la_SOURCES += \
     common/network/AdvancedTCPConnector.cpp \
+    common/network/DatagramBatch.cpp \
     common/network/FakeInterfacePicker.h \
     common/network/HealthCheckedConnection.cpp \
     common/network/IPV4Address.cpp \
@@ -43,6 +44,7 @@ common_network_HealthCheckedConnectionTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_network_HealthCheckedConnectionTester_LDADD = $(COMMON_TESTING_LIBS)
 
 common_network_NetworkTester_SOURCES = \
+    common/network/DatagramBatchTest.cpp \
     common/network/IPV4AddressTest.cpp \
     common/network/InterfacePickerTest.cpp \
     common/network/InterfaceTest.cpp \
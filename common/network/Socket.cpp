@@ -48,6 +48,7 @@
 #include <netinet/in.h>
 #endif  // HAVE_NETINET_IN_H
 
+#include <algorithm>
 #include <string>
 
 #include "common/network/SocketHelper.h"
@@ -69,15 +70,52 @@ bool ReceiveFrom(int fd, uint8_t *buffer, ssize_t *data_read,
 #ifdef _WIN32
     OLA_WARN << "recvfrom fd: " << fd << " failed: " << WSAGetLastError();
 #else
-    OLA_WARN << "recvfrom fd: " << fd << " failed: " << strerror(errno);
+    // A non-blocking socket which has been drained isn't an error.
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      OLA_WARN << "recvfrom fd: " << fd << " failed: " << strerror(errno);
+    }
 #endif  // _WIN32
     return false;
   }
   return true;
 }
 
+#if defined(HAVE_SENDMMSG) || defined(HAVE_RECVMMSG)
+// The maximum number of datagrams passed to each sendmmsg / recvmmsg call.
+const unsigned int MMSG_BATCH_SIZE = 64;
+#endif  // defined(HAVE_SENDMMSG) || defined(HAVE_RECVMMSG)
+
 }  // namespace
 
+// UDPSocketInterface
+// ------------------------------------------------
+
+unsigned int UDPSocketInterface::SendManyTo(const OutgoingDatagram *datagrams,
+                                            unsigned int count) const {
+  unsigned int datagrams_sent = 0;
+  for (unsigned int i = 0; i < count; i++) {
+    ssize_t bytes_sent = SendTo(datagrams[i].data, datagrams[i].size,
+                                datagrams[i].destination);
+    if (bytes_sent == static_cast<ssize_t>(datagrams[i].size)) {
+      datagrams_sent++;
+    }
+  }
+  return datagrams_sent;
+}
+
+unsigned int UDPSocketInterface::RecvMany(IncomingDatagram *datagrams,
+                                          unsigned int count) {
+  if (!count)
+    return 0;
+
+  ssize_t size = datagrams[0].size;
+  if (!RecvFrom(datagrams[0].data, &size, &datagrams[0].source)) {
+    return 0;
+  }
+  datagrams[0].size = size;
+  return 1;
+}
+
 // UDPSocket
 // ------------------------------------------------
 
@@ -179,6 +217,7 @@ bool UDPSocket::Close() {
 #endif  // _WIN32
   m_handle = ola::io::INVALID_DESCRIPTOR;
   m_bound_to_port = false;
+  m_reads_until_empty = false;
 #ifdef _WIN32
   if (closesocket(fd)) {
 #else
@@ -279,6 +318,55 @@ ssize_t UDPSocket::SendTo(ola::io::IOVecInterface *data,
   return bytes_sent;
 }
 
+unsigned int UDPSocket::SendManyTo(const OutgoingDatagram *datagrams,
+                                    unsigned int count) const {
+  if (!ValidWriteDescriptor())
+    return 0;
+
+#ifdef HAVE_SENDMMSG
+  unsigned int datagrams_sent = 0;
+  struct mmsghdr messages[MMSG_BATCH_SIZE];
+  struct sockaddr_in destinations[MMSG_BATCH_SIZE];
+  struct iovec iovs[MMSG_BATCH_SIZE];
+
+  unsigned int offset = 0;
+  while (offset < count) {
+    unsigned int batch_size = std::min(count - offset, MMSG_BATCH_SIZE);
+    for (unsigned int i = 0; i < batch_size; i++) {
+      const OutgoingDatagram &datagram = datagrams[offset + i];
+      datagram.destination.ToSockAddr(
+          reinterpret_cast<sockaddr*>(&destinations[i]),
+          sizeof(destinations[i]));
+      iovs[i].iov_base = const_cast<uint8_t*>(datagram.data);
+      iovs[i].iov_len = datagram.size;
+      memset(&messages[i], 0, sizeof(messages[i]));
+      messages[i].msg_hdr.msg_name = &destinations[i];
+      messages[i].msg_hdr.msg_namelen = sizeof(destinations[i]);
+      messages[i].msg_hdr.msg_iov = &iovs[i];
+      messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int sent = sendmmsg(m_handle, messages, batch_size, 0);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      // sendmmsg only returns an error if the first datagram failed, skip it
+      // and carry on with the rest.
+      OLA_DEBUG << "sendmmsg failed: " << datagrams[offset].destination
+                << " : " << strerror(errno);
+      offset++;
+    } else {
+      offset += sent;
+      datagrams_sent += sent;
+    }
+  }
+  return datagrams_sent;
+#else
+  return UDPSocketInterface::SendManyTo(datagrams, count);
+#endif  // HAVE_SENDMMSG
+}
+
 bool UDPSocket::RecvFrom(uint8_t *buffer, ssize_t *data_read) const {
   socklen_t length = 0;
 #ifdef _WIN32
@@ -342,6 +430,57 @@ bool UDPSocket::RecvFrom(uint8_t *buffer,
   return ok;
 }
 
+unsigned int UDPSocket::RecvMany(IncomingDatagram *datagrams,
+                                 unsigned int count) {
+  if (!count)
+    return 0;
+
+#ifdef HAVE_RECVMMSG
+  struct mmsghdr messages[MMSG_BATCH_SIZE];
+  struct sockaddr_in sources[MMSG_BATCH_SIZE];
+  struct iovec iovs[MMSG_BATCH_SIZE];
+
+  unsigned int batch_size = std::min(count, MMSG_BATCH_SIZE);
+  for (unsigned int i = 0; i < batch_size; i++) {
+    iovs[i].iov_base = datagrams[i].data;
+    iovs[i].iov_len = datagrams[i].size;
+    memset(&messages[i], 0, sizeof(messages[i]));
+    messages[i].msg_hdr.msg_name = &sources[i];
+    messages[i].msg_hdr.msg_namelen = sizeof(sources[i]);
+    messages[i].msg_hdr.msg_iov = &iovs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  // Block for the first datagram, then take whatever else is queued.
+  int received = recvmmsg(m_handle, messages, batch_size, MSG_WAITFORONE,
+                          NULL);
+  if (received < 0) {
+    if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      OLA_WARN << "recvmmsg fd: " << m_handle << " failed: "
+               << strerror(errno);
+    }
+    return 0;
+  }
+
+  for (int i = 0; i < received; i++) {
+    datagrams[i].size = messages[i].msg_len;
+    datagrams[i].source = IPV4SocketAddress(
+        IPV4Address(sources[i].sin_addr.s_addr),
+        NetworkToHost(sources[i].sin_port));
+  }
+  return received;
+#else
+  return UDPSocketInterface::RecvMany(datagrams, count);
+#endif  // HAVE_RECVMMSG
+}
+
+bool UDPSocket::SetReadsUntilEmpty() {
+  if (!ola::io::ConnectedDescriptor::SetNonBlocking(m_handle))
+    return false;
+  m_reads_until_empty = true;
+  return true;
+}
+
 bool UDPSocket::EnableBroadcast() {
   if (m_handle == ola::io::INVALID_DESCRIPTOR)
     return false;
@@ -41,6 +41,8 @@ using ola::io::SelectServer;
 using ola::network::IPV4Address;
 using ola::network::GenericSocketAddress;
 using ola::network::IPV4SocketAddress;
+using ola::network::IncomingDatagram;
+using ola::network::OutgoingDatagram;
 using ola::network::TCPAcceptingSocket;
 using ola::network::TCPSocket;
 using ola::network::UDPSocket;
@@ -56,6 +58,7 @@ class SocketTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testTCPSocketServerClose);
   CPPUNIT_TEST(testUDPSocket);
   CPPUNIT_TEST(testIOQueueUDPSend);
+  CPPUNIT_TEST(testUDPSendMany);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -65,6 +68,7 @@ class SocketTest: public CppUnit::TestFixture {
     void testTCPSocketServerClose();
     void testUDPSocket();
     void testIOQueueUDPSend();
+    void testUDPSendMany();
 
     // timing out indicates something went wrong
     void Timeout() {
@@ -279,6 +283,70 @@ void SocketTest::testIOQueueUDPSend() {
 }
 
 
+/*
+ * Test sending and receiving batches of datagrams.
+ */
+void SocketTest::testUDPSendMany() {
+  UDPSocket socket;
+  OLA_ASSERT_TRUE(socket.Init());
+  OLA_ASSERT_TRUE(socket.Bind(IPV4SocketAddress(IPV4Address::Loopback(), 0)));
+  IPV4SocketAddress local_address;
+  OLA_ASSERT_TRUE(socket.GetSocketAddress(&local_address));
+
+  UDPSocket client_socket;
+  OLA_ASSERT_TRUE(client_socket.Init());
+  OLA_ASSERT_TRUE(client_socket.Bind(
+      IPV4SocketAddress(IPV4Address::Loopback(), 0)));
+  IPV4SocketAddress client_address;
+  OLA_ASSERT_TRUE(client_socket.GetSocketAddress(&client_address));
+
+  // Each datagram is one byte longer than the last, and filled with its index.
+  const unsigned int DATAGRAM_COUNT = 5;
+  uint8_t data[DATAGRAM_COUNT][DATAGRAM_COUNT];
+  OutgoingDatagram outgoing[DATAGRAM_COUNT];
+  for (unsigned int i = 0; i < DATAGRAM_COUNT; i++) {
+    memset(data[i], i, sizeof(data[i]));
+    outgoing[i].data = data[i];
+    outgoing[i].size = i + 1;
+    outgoing[i].destination = local_address;
+  }
+  OLA_ASSERT_EQ(DATAGRAM_COUNT,
+                client_socket.SendManyTo(outgoing, DATAGRAM_COUNT));
+
+  // Loopback delivery is immediate, but RecvMany may return a partial batch
+  // on systems without recvmmsg.
+  unsigned int received = 0;
+  while (received < DATAGRAM_COUNT) {
+    uint8_t buffers[DATAGRAM_COUNT + 2][DATAGRAM_COUNT + 10];
+    IncomingDatagram incoming[DATAGRAM_COUNT + 2];
+    for (unsigned int i = 0; i < DATAGRAM_COUNT + 2; i++) {
+      incoming[i].data = buffers[i];
+      incoming[i].size = sizeof(buffers[i]);
+    }
+
+    unsigned int count = socket.RecvMany(incoming, DATAGRAM_COUNT + 2);
+    OLA_ASSERT_TRUE(count > 0);
+    OLA_ASSERT_TRUE(received + count <= DATAGRAM_COUNT);
+    for (unsigned int i = 0; i < count; i++) {
+      OLA_ASSERT_EQ(client_address, incoming[i].source);
+      OLA_ASSERT_DATA_EQUALS(data[received], received + 1,
+                             incoming[i].data, incoming[i].size);
+      received++;
+    }
+  }
+
+  // Once the socket reads until empty, a drained socket doesn't block.
+  OLA_ASSERT_FALSE(socket.ReadsUntilEmpty());
+  OLA_ASSERT_TRUE(socket.SetReadsUntilEmpty());
+  OLA_ASSERT_TRUE(socket.ReadsUntilEmpty());
+  uint8_t buffer[DATAGRAM_COUNT];
+  IncomingDatagram incoming;
+  incoming.data = buffer;
+  incoming.size = sizeof(buffer);
+  OLA_ASSERT_EQ(0u, socket.RecvMany(&incoming, 1));
+}
+
+
 /*
  * Receive some data and close the socket
  */
@@ -31,6 +31,7 @@ common_libolacommon_la_SOURCES += \
     common/rdm/PidStoreHelper.cpp \
     common/rdm/PidStoreLoader.cpp \
     common/rdm/PidStoreLoader.h \
+    common/rdm/PipelinedRDMController.cpp \
     common/rdm/QueueingRDMController.cpp \
     common/rdm/RDMAPI.cpp \
     common/rdm/RDMCommand.cpp \
@@ -78,6 +79,7 @@ EXTRA_DIST += \
 test_programs += \
     common/rdm/DiscoveryAgentTester \
     common/rdm/PidStoreTester \
+    common/rdm/PipelinedRDMControllerTester \
     common/rdm/QueueingRDMControllerTester \
     common/rdm/RDMAPITester \
     common/rdm/RDMCommandSerializerTester \
@@ -142,6 +144,11 @@ common_rdm_RDMCommandSerializerTester_SOURCES = \
 common_rdm_RDMCommandSerializerTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_rdm_RDMCommandSerializerTester_LDADD = $(COMMON_TESTING_LIBS)
 
+common_rdm_PipelinedRDMControllerTester_SOURCES = \
+    common/rdm/PipelinedRDMControllerTest.cpp
+common_rdm_PipelinedRDMControllerTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+common_rdm_PipelinedRDMControllerTester_LDADD = $(COMMON_TESTING_LIBS)
+
 common_rdm_QueueingRDMControllerTester_SOURCES = \
     common/rdm/QueueingRDMControllerTest.cpp \
     common/rdm/TestHelper.h
@@ -0,0 +1,366 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * PipelinedRDMController.cpp
+ * A RDM Controller that allows a request to each responder to be in flight.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <utility>
+#include <vector>
+#include "ola/ExportMap.h"
+#include "ola/Logging.h"
+#include "ola/rdm/PipelinedRDMController.h"
+#include "ola/rdm/RDMCommand.h"
+#include "ola/rdm/RDMEnums.h"
+#include "ola/rdm/UID.h"
+#include "ola/rdm/UIDSet.h"
+#include "ola/stl/STLUtils.h"
+
+namespace ola {
+namespace rdm {
+
+using std::vector;
+
+const unsigned int PipelinedRDMController::DEFAULT_MAX_IN_FLIGHT = 4;
+
+PipelinedRDMController::PipelinedRDMController(
+    RDMControllerInterface *controller,
+    unsigned int max_queue_size,
+    unsigned int max_in_flight)
+    : m_controller(controller),
+      m_max_queue_size(max_queue_size),
+      m_max_in_flight(max_in_flight ? max_in_flight : 1),
+      m_broadcast_in_flight(false),
+      m_active(true),
+      m_dispatching(false),
+      m_queue_depth_var(NULL),
+      m_latency_var(NULL) {
+}
+
+PipelinedRDMController::~PipelinedRDMController() {
+  while (!m_pending_requests.empty()) {
+    PendingRequest *pending = m_pending_requests.front();
+    m_pending_requests.pop_front();
+    if (pending->on_complete) {
+      RunRDMCallback(pending->on_complete, RDM_FAILED_TO_SEND);
+    }
+    delete pending->request;
+    delete pending;
+  }
+
+  // Fail the requests in flight as well, the underlying controller must not
+  // reply to them after this.
+  InFlightRequests::iterator iter = m_in_flight.begin();
+  for (; iter != m_in_flight.end(); ++iter) {
+    if (iter->second->on_complete) {
+      RunRDMCallback(iter->second->on_complete, RDM_FAILED_TO_SEND);
+    }
+    delete iter->second->request;
+    delete iter->second;
+  }
+  m_in_flight.clear();
+}
+
+void PipelinedRDMController::Pause() {
+  m_active = false;
+}
+
+void PipelinedRDMController::Resume() {
+  m_active = true;
+  TakeNextAction();
+}
+
+void PipelinedRDMController::SendRDMRequest(RDMRequest *request,
+                                            RDMCallback *on_complete) {
+  if (m_pending_requests.size() + m_in_flight.size() >= m_max_queue_size) {
+    OLA_WARN << "RDM Queue is full, dropping request";
+    if (on_complete) {
+      RunRDMCallback(on_complete, RDM_FAILED_TO_SEND);
+    }
+    delete request;
+    return;
+  }
+
+  PendingRequest *pending = new PendingRequest();
+  pending->request = request;
+  pending->on_complete = on_complete;
+  m_pending_requests.push_back(pending);
+  UpdateQueueDepth();
+  TakeNextAction();
+}
+
+void PipelinedRDMController::SetMetrics(IntegerVariable *queue_depth,
+                                        LatencyHistogram *latency) {
+  m_queue_depth_var = queue_depth;
+  m_latency_var = latency;
+  UpdateQueueDepth();
+}
+
+/**
+ * Do the next action.
+ */
+void PipelinedRDMController::TakeNextAction() {
+  if (CheckForBlockingCondition())
+    return;
+
+  MaybeSendRDMRequests();
+}
+
+/**
+ * This method runs before we decide to send more requests and allows sub
+ * classes (like the DiscoverablePipelinedRDMController) to insert other
+ * actions into the queue.
+ * @returns true if some other action is running, false otherwise.
+ */
+bool PipelinedRDMController::CheckForBlockingCondition() {
+  return !m_active;
+}
+
+/*
+ * Send queued requests until we reach the in-flight limit, or there are no
+ * more requests that can be sent.
+ */
+void PipelinedRDMController::MaybeSendRDMRequests() {
+  // The underlying controller may run the callback before SendRDMRequest()
+  // returns, so guard against recursion.
+  if (m_dispatching) {
+    return;
+  }
+  m_dispatching = true;
+
+  PendingRequests::iterator iter = m_pending_requests.begin();
+  while (iter != m_pending_requests.end() &&
+         !m_broadcast_in_flight &&
+         m_in_flight.size() < m_max_in_flight &&
+         !CheckForBlockingCondition()) {
+    PendingRequest *pending = *iter;
+    const UID &destination = pending->request->DestinationUID();
+
+    if (destination.IsBroadcast()) {
+      // A broadcast is sent on its own, and nothing is sent ahead of it.
+      if (iter != m_pending_requests.begin() || !m_in_flight.empty()) {
+        break;
+      }
+      m_broadcast_in_flight = true;
+    } else if (STLContains(m_in_flight, destination)) {
+      // Keep the requests for each responder in order.
+      ++iter;
+      continue;
+    }
+
+    m_pending_requests.erase(iter);
+    m_in_flight[destination] = pending;
+    m_clock.CurrentTime(&pending->sent_time);
+    UpdateQueueDepth();
+    DispatchRequest(pending);
+    // The callbacks may have changed the queue.
+    iter = m_pending_requests.begin();
+  }
+  m_dispatching = false;
+}
+
+/*
+ * Send a request to the underlying controller.
+ */
+void PipelinedRDMController::DispatchRequest(PendingRequest *pending) {
+  // We have to make a copy here because we pass ownership of the request to
+  // the underlying controller.
+  // We need to have the original request because we use it if we receive an
+  // ACK_OVERFLOW.
+  m_controller->SendRDMRequest(
+      pending->request->Duplicate(),
+      NewSingleCallback(this, &PipelinedRDMController::HandleRDMResponse,
+                        pending));
+}
+
+/*
+ * Handle the reply to a request.
+ */
+void PipelinedRDMController::HandleRDMResponse(PendingRequest *pending,
+                                               RDMReply *reply) {
+  bool was_ack_overflow = reply->StatusCode() == RDM_COMPLETED_OK &&
+                          reply->Response() &&
+                          reply->Response()->ResponseType() == ACK_OVERFLOW;
+
+  if (pending->response.get()) {
+    // We're part way through an ACK_OVERFLOW sequence.
+    pending->frames.insert(pending->frames.end(), reply->Frames().begin(),
+                           reply->Frames().end());
+    if (reply->StatusCode() != RDM_COMPLETED_OK || reply->Response() == NULL) {
+      RDMReply new_reply(reply->StatusCode(), NULL, pending->frames);
+      CompleteRequest(pending, &new_reply);
+      return;
+    }
+
+    pending->response.reset(RDMResponse::CombineResponses(
+        pending->response.get(), reply->Response()));
+    if (!pending->response.get()) {
+      RDMReply new_reply(RDM_INVALID_RESPONSE, NULL, pending->frames);
+      CompleteRequest(pending, &new_reply);
+    } else if (!was_ack_overflow) {
+      RDMReply new_reply(RDM_COMPLETED_OK, pending->response.release(),
+                         pending->frames);
+      CompleteRequest(pending, &new_reply);
+    } else {
+      DispatchRequest(pending);
+    }
+  } else if (was_ack_overflow) {
+    pending->response.reset(reply->Response()->Duplicate());
+    pending->frames.assign(reply->Frames().begin(), reply->Frames().end());
+    DispatchRequest(pending);
+  } else {
+    CompleteRequest(pending, reply);
+  }
+}
+
+/*
+ * Remove a request from the in-flight set, run the callback and send the next
+ * requests.
+ */
+void PipelinedRDMController::CompleteRequest(PendingRequest *pending,
+                                             RDMReply *reply) {
+  const UID &destination = pending->request->DestinationUID();
+  if (destination.IsBroadcast()) {
+    m_broadcast_in_flight = false;
+  }
+  m_in_flight.erase(destination);
+
+  if (m_latency_var) {
+    TimeStamp now;
+    m_clock.CurrentTime(&now);
+    m_latency_var->Record((now - pending->sent_time).AsInt());
+  }
+
+  if (pending->on_complete) {
+    pending->on_complete->Run(reply);
+  }
+  delete pending->request;
+  delete pending;
+  TakeNextAction();
+}
+
+void PipelinedRDMController::UpdateQueueDepth() {
+  if (m_queue_depth_var) {
+    m_queue_depth_var->Set(m_pending_requests.size());
+  }
+}
+
+
+/**
+ * Constructor for the DiscoverablePipelinedRDMController
+ */
+DiscoverablePipelinedRDMController::DiscoverablePipelinedRDMController(
+    DiscoverableRDMControllerInterface *controller,
+    unsigned int max_queue_size,
+    unsigned int max_in_flight)
+    : PipelinedRDMController(controller, max_queue_size, max_in_flight),
+      m_discoverable_controller(controller) {
+}
+
+/**
+ * Run the full RDM discovery routine. This will either run immediately or
+ * after the requests in flight complete.
+ */
+void DiscoverablePipelinedRDMController::RunFullDiscovery(
+    RDMDiscoveryCallback *callback) {
+  GenericDiscovery(callback, true);
+}
+
+/**
+ * Run the incremental RDM discovery routine. This will either run immediately
+ * or after the requests in flight complete.
+ */
+void DiscoverablePipelinedRDMController::RunIncrementalDiscovery(
+    RDMDiscoveryCallback *callback) {
+  GenericDiscovery(callback, false);
+}
+
+/**
+ * Override this so we can prioritize the discovery requests.
+ */
+void DiscoverablePipelinedRDMController::TakeNextAction() {
+  if (CheckForBlockingCondition())
+    return;
+
+  // prioritize discovery above RDM requests
+  if (m_pending_discovery_callbacks.empty()) {
+    MaybeSendRDMRequests();
+  } else {
+    StartRDMDiscovery();
+  }
+}
+
+/**
+ * Block if discovery is running, or if discovery is waiting for the requests
+ * in flight to complete.
+ */
+bool DiscoverablePipelinedRDMController::CheckForBlockingCondition() {
+  return (PipelinedRDMController::CheckForBlockingCondition() ||
+          !m_discovery_callbacks.empty() ||
+          (!m_pending_discovery_callbacks.empty() && !m_in_flight.empty()));
+}
+
+/**
+ * The generic discovery routine
+ */
+void DiscoverablePipelinedRDMController::GenericDiscovery(
+    RDMDiscoveryCallback *callback,
+    bool full) {
+  m_pending_discovery_callbacks.push_back(std::make_pair(full, callback));
+  TakeNextAction();
+}
+
+/**
+ * Run the rdm discovery routine for the underlying controller.
+ * @pre m_pending_discovery_callbacks is not empty()
+ */
+void DiscoverablePipelinedRDMController::StartRDMDiscovery() {
+  bool full = false;
+  m_discovery_callbacks.reserve(m_pending_discovery_callbacks.size());
+
+  PendingDiscoveryCallbacks::iterator iter =
+    m_pending_discovery_callbacks.begin();
+  for (; iter != m_pending_discovery_callbacks.end(); iter++) {
+    full |= iter->first;
+    m_discovery_callbacks.push_back(iter->second);
+  }
+  m_pending_discovery_callbacks.clear();
+
+  RDMDiscoveryCallback *callback = NewSingleCallback(
+      this,
+      &DiscoverablePipelinedRDMController::DiscoveryComplete);
+
+  if (full)
+    m_discoverable_controller->RunFullDiscovery(callback);
+  else
+    m_discoverable_controller->RunIncrementalDiscovery(callback);
+}
+
+/**
+ * Called when discovery completes
+ */
+void DiscoverablePipelinedRDMController::DiscoveryComplete(
+    const ola::rdm::UIDSet &uids) {
+  DiscoveryCallbacks::iterator iter = m_discovery_callbacks.begin();
+  for (; iter != m_discovery_callbacks.end(); ++iter) {
+    if (*iter)
+      (*iter)->Run(uids);
+  }
+  m_discovery_callbacks.clear();
+  TakeNextAction();
+}
+}  // namespace rdm
+}  // namespace ola
@@ -0,0 +1,446 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * PipelinedRDMControllerTest.cpp
+ * Test fixture for the PipelinedRDMController.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <memory>
+#include <vector>
+
+#include "ola/Callback.h"
+#include "ola/ExportMap.h"
+#include "ola/rdm/PipelinedRDMController.h"
+#include "ola/rdm/RDMControllerInterface.h"
+#include "ola/rdm/UID.h"
+#include "ola/rdm/UIDSet.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::ExportMap;
+using ola::NewSingleCallback;
+using ola::rdm::ACK_OVERFLOW;
+using ola::rdm::DiscoverablePipelinedRDMController;
+using ola::rdm::PipelinedRDMController;
+using ola::rdm::RDMCallback;
+using ola::rdm::RDMDiscoveryCallback;
+using ola::rdm::RDMGetResponse;
+using ola::rdm::RDMReply;
+using ola::rdm::RDMRequest;
+using ola::rdm::RDMResponse;
+using ola::rdm::RDMStatusCode;
+using ola::rdm::RDM_ACK;
+using ola::rdm::UID;
+using ola::rdm::UIDSet;
+using std::vector;
+
+namespace {
+
+RDMRequest *NewGetRequest(const UID &source, const UID &destination) {
+  return new ola::rdm::RDMGetRequest(source,
+                                     destination,
+                                     0,  // transaction #
+                                     1,  // port id
+                                     10,  // sub device
+                                     296,  // param id
+                                     NULL,  // data
+                                     0);  // data length
+}
+
+RDMResponse *NewGetResponse(const UID &source, const UID &destination,
+                            uint8_t response_type = RDM_ACK,
+                            const uint8_t *data = NULL,
+                            unsigned int length = 0) {
+  return new RDMGetResponse(source,
+                            destination,
+                            0,  // transaction #
+                            response_type,
+                            0,  // message count
+                            10,  // sub device
+                            296,  // param id
+                            data,
+                            length);
+}
+
+/*
+ * A controller which holds on to each request until it's replied to.
+ */
+class MockPipelinedController
+    : public ola::rdm::DiscoverableRDMControllerInterface {
+ public:
+  MockPipelinedController()
+      : full_discovery_count(0),
+        m_discovery_callback(NULL) {
+  }
+
+  ~MockPipelinedController() {
+    vector<Call>::iterator iter = m_calls.begin();
+    for (; iter != m_calls.end(); ++iter) {
+      delete iter->request;
+      delete iter->callback;
+    }
+  }
+
+  void SendRDMRequest(RDMRequest *request, RDMCallback *on_complete) {
+    Call call = {request, on_complete};
+    m_calls.push_back(call);
+  }
+
+  void RunFullDiscovery(RDMDiscoveryCallback *callback) {
+    full_discovery_count++;
+    m_discovery_callback = callback;
+  }
+
+  void RunIncrementalDiscovery(RDMDiscoveryCallback *callback) {
+    m_discovery_callback = callback;
+  }
+
+  unsigned int InFlight() const { return m_calls.size(); }
+
+  bool HasRequestFor(const UID &uid) const {
+    vector<Call>::const_iterator iter = m_calls.begin();
+    for (; iter != m_calls.end(); ++iter) {
+      if (iter->request->DestinationUID() == uid) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /*
+   * Reply to the request for a UID, this takes ownership of the response.
+   */
+  void Reply(const UID &uid, RDMStatusCode status,
+             RDMResponse *response = NULL) {
+    vector<Call>::iterator iter = m_calls.begin();
+    for (; iter != m_calls.end(); ++iter) {
+      if (iter->request->DestinationUID() == uid) {
+        Call call = *iter;
+        m_calls.erase(iter);
+        delete call.request;
+        RDMReply reply(status, response);
+        call.callback->Run(&reply);
+        return;
+      }
+    }
+    delete response;
+    OLA_FAIL("No request in flight");
+  }
+
+  void CompleteDiscovery(const UIDSet &uids) {
+    RDMDiscoveryCallback *callback = m_discovery_callback;
+    m_discovery_callback = NULL;
+    callback->Run(uids);
+  }
+
+  bool DiscoveryRunning() const { return m_discovery_callback != NULL; }
+
+  unsigned int full_discovery_count;
+
+ private:
+  struct Call {
+    RDMRequest *request;
+    RDMCallback *callback;
+  };
+
+  vector<Call> m_calls;
+  RDMDiscoveryCallback *m_discovery_callback;
+};
+}  // namespace
+
+
+class PipelinedRDMControllerTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(PipelinedRDMControllerTest);
+  CPPUNIT_TEST(testPipelining);
+  CPPUNIT_TEST(testBroadcast);
+  CPPUNIT_TEST(testAckOverflow);
+  CPPUNIT_TEST(testQueueOverflow);
+  CPPUNIT_TEST(testPauseAndResume);
+  CPPUNIT_TEST(testDiscovery);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  PipelinedRDMControllerTest()
+      : m_source(1, 2),
+        m_uid1(0x7a70, 1),
+        m_uid2(0x7a70, 2),
+        m_uid3(0x7a70, 3),
+        m_discovery_count(0) {
+  }
+
+  void setUp() {
+    m_replies.clear();
+    m_last_param_data_size = 0;
+    m_discovery_count = 0;
+  }
+
+  void testPipelining();
+  void testBroadcast();
+  void testAckOverflow();
+  void testQueueOverflow();
+  void testPauseAndResume();
+  void testDiscovery();
+
+ private:
+  struct ReceivedReply {
+    UID uid;
+    RDMStatusCode status;
+  };
+
+  const UID m_source;
+  const UID m_uid1, m_uid2, m_uid3;
+  vector<ReceivedReply> m_replies;
+  unsigned int m_last_param_data_size;
+  unsigned int m_discovery_count;
+
+  void Send(PipelinedRDMController *controller, const UID &uid) {
+    controller->SendRDMRequest(
+        NewGetRequest(m_source, uid),
+        NewSingleCallback(this, &PipelinedRDMControllerTest::HandleReply,
+                          uid));
+  }
+
+  void HandleReply(UID uid, RDMReply *reply) {
+    ReceivedReply received = {uid, reply->StatusCode()};
+    m_replies.push_back(received);
+    if (reply->Response()) {
+      m_last_param_data_size = reply->Response()->ParamDataSize();
+    }
+  }
+
+  void DiscoveryComplete(const UIDSet&) {
+    m_discovery_count++;
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(PipelinedRDMControllerTest);
+
+
+/*
+ * Check that requests to different UIDs are sent in parallel, and requests to
+ * the same UID are sent in order.
+ */
+void PipelinedRDMControllerTest::testPipelining() {
+  ExportMap export_map;
+  MockPipelinedController mock_controller;
+  PipelinedRDMController controller(&mock_controller, 10, 2);
+  controller.SetMetrics(export_map.GetIntegerVar("rdm-queue-depth"),
+                        export_map.GetLatencyMapVar("rdm-latency")
+                            ->Histogram("port"));
+
+  Send(&controller, m_uid1);
+  Send(&controller, m_uid2);
+  Send(&controller, m_uid3);
+  Send(&controller, m_uid1);
+
+  OLA_ASSERT_EQ(2u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid1));
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid2));
+  OLA_ASSERT_EQ(2u, controller.InFlightCount());
+  OLA_ASSERT_EQ(2u, controller.QueueDepth());
+  OLA_ASSERT_EQ(2, export_map.GetIntegerVar("rdm-queue-depth")->Get());
+
+  // The second request for uid1 can't be sent until the first completes, so
+  // uid3 goes next.
+  mock_controller.Reply(m_uid2, ola::rdm::RDM_TIMEOUT);
+  OLA_ASSERT_EQ(2u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid3));
+  OLA_ASSERT_EQ(1u, controller.QueueDepth());
+
+  mock_controller.Reply(m_uid3, ola::rdm::RDM_COMPLETED_OK,
+                        NewGetResponse(m_uid3, m_source));
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+  OLA_ASSERT_EQ(1u, controller.QueueDepth());
+
+  mock_controller.Reply(m_uid1, ola::rdm::RDM_COMPLETED_OK,
+                        NewGetResponse(m_uid1, m_source));
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid1));
+  OLA_ASSERT_EQ(0u, controller.QueueDepth());
+
+  mock_controller.Reply(m_uid1, ola::rdm::RDM_COMPLETED_OK,
+                        NewGetResponse(m_uid1, m_source));
+  OLA_ASSERT_EQ(0u, controller.InFlightCount());
+
+  OLA_ASSERT_EQ(static_cast<size_t>(4), m_replies.size());
+  OLA_ASSERT_EQ(m_uid2, m_replies[0].uid);
+  OLA_ASSERT_EQ(ola::rdm::RDM_TIMEOUT, m_replies[0].status);
+  OLA_ASSERT_EQ(m_uid3, m_replies[1].uid);
+  OLA_ASSERT_EQ(m_uid1, m_replies[2].uid);
+  OLA_ASSERT_EQ(m_uid1, m_replies[3].uid);
+  OLA_ASSERT_EQ(ola::rdm::RDM_COMPLETED_OK, m_replies[3].status);
+
+  OLA_ASSERT_EQ(static_cast<uint64_t>(4),
+                export_map.GetLatencyMapVar("rdm-latency")
+                    ->Histogram("port")->Count());
+}
+
+
+/*
+ * Check that broadcast requests are sent on their own.
+ */
+void PipelinedRDMControllerTest::testBroadcast() {
+  MockPipelinedController mock_controller;
+  PipelinedRDMController controller(&mock_controller, 10, 4);
+  UID broadcast = UID::AllDevices();
+
+  Send(&controller, m_uid1);
+  Send(&controller, broadcast);
+  Send(&controller, m_uid2);
+
+  // Nothing is sent ahead of the broadcast.
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid1));
+
+  mock_controller.Reply(m_uid1, ola::rdm::RDM_TIMEOUT);
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(broadcast));
+
+  mock_controller.Reply(broadcast, ola::rdm::RDM_WAS_BROADCAST);
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid2));
+
+  mock_controller.Reply(m_uid2, ola::rdm::RDM_TIMEOUT);
+  OLA_ASSERT_EQ(static_cast<size_t>(3), m_replies.size());
+  OLA_ASSERT_EQ(broadcast, m_replies[1].uid);
+  OLA_ASSERT_EQ(ola::rdm::RDM_WAS_BROADCAST, m_replies[1].status);
+}
+
+
+/*
+ * Check that ACK_OVERFLOW responses are combined, while other requests are in
+ * flight.
+ */
+void PipelinedRDMControllerTest::testAckOverflow() {
+  MockPipelinedController mock_controller;
+  PipelinedRDMController controller(&mock_controller, 10, 2);
+  uint8_t data[] = {0xaa, 0xbb};
+
+  Send(&controller, m_uid1);
+  Send(&controller, m_uid2);
+
+  mock_controller.Reply(
+      m_uid1, ola::rdm::RDM_COMPLETED_OK,
+      NewGetResponse(m_uid1, m_source, ACK_OVERFLOW, data, 1));
+  // The request for uid1 was sent again.
+  OLA_ASSERT_EQ(2u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid1));
+  OLA_ASSERT_TRUE(m_replies.empty());
+
+  mock_controller.Reply(m_uid2, ola::rdm::RDM_TIMEOUT);
+  OLA_ASSERT_EQ(static_cast<size_t>(1), m_replies.size());
+
+  mock_controller.Reply(
+      m_uid1, ola::rdm::RDM_COMPLETED_OK,
+      NewGetResponse(m_uid1, m_source, RDM_ACK, data + 1, 1));
+  OLA_ASSERT_EQ(static_cast<size_t>(2), m_replies.size());
+  OLA_ASSERT_EQ(m_uid1, m_replies[1].uid);
+  OLA_ASSERT_EQ(ola::rdm::RDM_COMPLETED_OK, m_replies[1].status);
+  OLA_ASSERT_EQ(2u, m_last_param_data_size);
+
+  // A failure part way through the sequence.
+  Send(&controller, m_uid1);
+  mock_controller.Reply(
+      m_uid1, ola::rdm::RDM_COMPLETED_OK,
+      NewGetResponse(m_uid1, m_source, ACK_OVERFLOW, data, 1));
+  mock_controller.Reply(m_uid1, ola::rdm::RDM_TIMEOUT);
+  OLA_ASSERT_EQ(static_cast<size_t>(3), m_replies.size());
+  OLA_ASSERT_EQ(ola::rdm::RDM_TIMEOUT, m_replies[2].status);
+  OLA_ASSERT_EQ(0u, controller.InFlightCount());
+}
+
+
+/*
+ * Check that requests are rejected when the queue is full.
+ */
+void PipelinedRDMControllerTest::testQueueOverflow() {
+  MockPipelinedController mock_controller;
+  std::auto_ptr<PipelinedRDMController> controller(
+      new PipelinedRDMController(&mock_controller, 3, 2));
+
+  Send(controller.get(), m_uid1);
+  Send(controller.get(), m_uid2);
+  Send(controller.get(), m_uid3);
+  OLA_ASSERT_TRUE(m_replies.empty());
+
+  Send(controller.get(), m_uid3);
+  OLA_ASSERT_EQ(static_cast<size_t>(1), m_replies.size());
+  OLA_ASSERT_EQ(ola::rdm::RDM_FAILED_TO_SEND, m_replies[0].status);
+
+  // Deleting the controller fails the outstanding requests.
+  controller.reset();
+  OLA_ASSERT_EQ(static_cast<size_t>(4), m_replies.size());
+  OLA_ASSERT_EQ(ola::rdm::RDM_FAILED_TO_SEND, m_replies[3].status);
+}
+
+
+/*
+ * Check that pausing stops new requests being sent.
+ */
+void PipelinedRDMControllerTest::testPauseAndResume() {
+  MockPipelinedController mock_controller;
+  PipelinedRDMController controller(&mock_controller, 10, 2);
+
+  Send(&controller, m_uid1);
+  controller.Pause();
+  Send(&controller, m_uid2);
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+
+  mock_controller.Reply(m_uid1, ola::rdm::RDM_TIMEOUT);
+  OLA_ASSERT_EQ(0u, mock_controller.InFlight());
+
+  controller.Resume();
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid2));
+  mock_controller.Reply(m_uid2, ola::rdm::RDM_TIMEOUT);
+}
+
+
+/*
+ * Check that discovery waits for the requests in flight, and blocks new ones.
+ */
+void PipelinedRDMControllerTest::testDiscovery() {
+  MockPipelinedController mock_controller;
+  DiscoverablePipelinedRDMController controller(&mock_controller, 10, 2);
+
+  Send(&controller, m_uid1);
+  Send(&controller, m_uid2);
+  controller.RunFullDiscovery(
+      NewSingleCallback(this, &PipelinedRDMControllerTest::DiscoveryComplete));
+  controller.RunIncrementalDiscovery(
+      NewSingleCallback(this, &PipelinedRDMControllerTest::DiscoveryComplete));
+  Send(&controller, m_uid3);
+
+  OLA_ASSERT_EQ(2u, mock_controller.InFlight());
+  OLA_ASSERT_FALSE(mock_controller.DiscoveryRunning());
+
+  mock_controller.Reply(m_uid1, ola::rdm::RDM_TIMEOUT);
+  // uid3 isn't sent because discovery is waiting.
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+  OLA_ASSERT_FALSE(mock_controller.DiscoveryRunning());
+
+  mock_controller.Reply(m_uid2, ola::rdm::RDM_TIMEOUT);
+  OLA_ASSERT_EQ(0u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.DiscoveryRunning());
+  OLA_ASSERT_EQ(1u, mock_controller.full_discovery_count);
+
+  mock_controller.CompleteDiscovery(UIDSet());
+  OLA_ASSERT_EQ(2u, m_discovery_count);
+  OLA_ASSERT_EQ(1u, mock_controller.InFlight());
+  OLA_ASSERT_TRUE(mock_controller.HasRequestFor(m_uid3));
+  mock_controller.Reply(m_uid3, ola::rdm::RDM_TIMEOUT);
+  OLA_ASSERT_EQ(static_cast<size_t>(3), m_replies.size());
+}
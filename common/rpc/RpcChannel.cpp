@@ -21,6 +21,7 @@
 #include "common/rpc/RpcChannel.h"
 
 #include <errno.h>
+#include <string.h>
 #include <google/protobuf/service.h>
 #include <google/protobuf/message.h>
 #include <google/protobuf/descriptor.h>
@@ -32,7 +33,9 @@
 #include "common/rpc/RpcController.h"
 #include "common/rpc/RpcHeader.h"
 #include "common/rpc/RpcService.h"
+#include "common/rpc/SerializedRequest.h"
 #include "ola/Callback.h"
+#include "ola/Constants.h"
 #include "ola/Logging.h"
 #include "ola/base/Array.h"
 #include "ola/stl/STLUtils.h"
@@ -52,10 +55,15 @@ const char RpcChannel::K_RPC_SENT_ERROR_VAR[] = "rpc-send-errors";
 const char RpcChannel::K_RPC_SENT_VAR[] = "rpc-sent";
 const char RpcChannel::STREAMING_NO_RESPONSE[] = "STREAMING_NO_RESPONSE";
 
-const char *RpcChannel::K_RPC_VARIABLES[] = {
-  K_RPC_RECEIVED_VAR,
-  K_RPC_SENT_ERROR_VAR,
-  K_RPC_SENT_VAR,
+// The keys in K_RPC_RECEIVED_TYPE_VAR, in the order of ReceivedType.
+const char *RpcChannel::K_RECEIVED_TYPES[] = {
+  "request",
+  "response",
+  "cancelled",
+  "failed",
+  "not-implemented",
+  "stream_request",
+  "dmx_frame",
 };
 
 class OutstandingRequest {
@@ -117,8 +125,11 @@ RpcChannel::RpcChannel(
       m_buffer_size(0),
       m_expected_size(0),
       m_current_size(0),
+      m_current_version(PROTOCOL_VERSION),
       m_export_map(export_map),
-      m_recv_type_map(NULL) {
+      m_received_var(NULL),
+      m_sent_var(NULL),
+      m_sent_error_var(NULL) {
   if (descriptor) {
     descriptor->SetOnData(
         ola::NewCallback(this, &RpcChannel::DescriptorReady));
@@ -126,12 +137,16 @@ RpcChannel::RpcChannel(
         ola::NewSingleCallback(this, &RpcChannel::HandleChannelClose));
   }
 
+  memset(m_recv_type_vars, 0, sizeof(m_recv_type_vars));
   if (m_export_map) {
-    for (unsigned int i = 0; i < arraysize(K_RPC_VARIABLES); ++i) {
-      m_export_map->GetCounterVar(string(K_RPC_VARIABLES[i]));
+    m_received_var = m_export_map->GetCounterVar(K_RPC_RECEIVED_VAR);
+    m_sent_var = m_export_map->GetCounterVar(K_RPC_SENT_VAR);
+    m_sent_error_var = m_export_map->GetCounterVar(K_RPC_SENT_ERROR_VAR);
+    CounterMap *recv_type_map = m_export_map->GetCounterMapVar(
+        K_RPC_RECEIVED_TYPE_VAR, "type");
+    for (unsigned int i = 0; i < RECEIVED_TYPE_COUNT; ++i) {
+      m_recv_type_vars[i] = recv_type_map->Counter(K_RECEIVED_TYPES[i]);
     }
-    m_recv_type_map = m_export_map->GetUIntMapVar(K_RPC_RECEIVED_TYPE_VAR,
-                                                  "type");
   }
 }
 
@@ -149,11 +164,12 @@ void RpcChannel::DescriptorReady() {
     if (!m_expected_size)
       return;
 
-    if (version != PROTOCOL_VERSION) {
+    if (version != PROTOCOL_VERSION && version != DMX_FRAME_VERSION) {
       OLA_WARN << "protocol mismatch " << version << " != " <<
         PROTOCOL_VERSION;
       return;
     }
+    m_current_version = version;
 
     if (m_expected_size > MAX_BUFFER_SIZE) {
       OLA_WARN << "Incoming message size " << m_expected_size
@@ -188,7 +204,10 @@ void RpcChannel::DescriptorReady() {
 
   if (m_current_size == m_expected_size) {
     // we've got all of this message so parse it.
-    if (!HandleNewMsg(m_buffer, m_expected_size)) {
+    bool ok = (m_current_version == DMX_FRAME_VERSION ?
+               HandleDmxFrame(m_buffer, m_expected_size) :
+               HandleNewMsg(m_buffer, m_expected_size));
+    if (!ok) {
       // this probably means we've messed the framing up, close the channel
       OLA_WARN << "Errors detected on RPC channel, closing";
       m_descriptor->Close();
@@ -234,26 +253,40 @@ void RpcChannel::CallMethod(const MethodDescriptor *method,
   if (is_streaming)
     return;
 
-  if (!r) {
-    // Send failed, call the handler now.
-    controller->SetFailed("Failed to send request");
-    done->Run();
-    return;
-  }
+  AddOutstandingResponse(r, message.id(), controller, reply, done);
+}
 
-  OutstandingResponse *response = new OutstandingResponse(
-      message.id(), controller, done, reply);
+void RpcChannel::CallMethod(const SerializedRequest &request,
+                            RpcController *controller,
+                            Message *reply,
+                            SingleUseCallback0<void> *done) {
+  const string &data = request.Data();
+  uint32_t id = m_sequence.Next();
 
-  auto_ptr<OutstandingResponse> old_response(
-      STLReplacePtr(&m_responses, message.id(), response));
+  // The frame is the header, the shared encoding and then the id field. The
+  // id is a varint, so it takes at most 5 bytes, plus 1 for the tag.
+  uint32_t header;
+  string output;
+  output.reserve(sizeof(header) + data.size() + 6);
+  output.append(sizeof(header), 0);
+  output.append(data);
+  // The tag is the field number and the wire type, which is 0 for varints.
+  output.push_back(static_cast<char>(RpcMessage::kIdFieldNumber << 3));
+  uint32_t value = id;
+  while (value >= 0x80) {
+    output.push_back(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  output.push_back(static_cast<char>(value));
 
-  if (old_response.get()) {
-    // fail any outstanding response with the same id
-    OLA_WARN << "response " << old_response->id << " already pending, failing "
-             << "now";
-    response->controller->SetFailed("Duplicate request found");
-    response->callback->Run();
-  }
+  RpcHeader::EncodeHeader(&header, PROTOCOL_VERSION,
+                          output.size() - sizeof(header));
+  output.replace(0, sizeof(header), reinterpret_cast<const char*>(&header),
+                 sizeof(header));
+
+  bool r = SendFrame(reinterpret_cast<const uint8_t*>(output.data()),
+                     output.size());
+  AddOutstandingResponse(r, id, controller, reply, done);
 }
 
 void RpcChannel::RequestComplete(OutstandingRequest *request) {
@@ -277,18 +310,71 @@ RpcSession *RpcChannel::Session() {
   return m_session.get();
 }
 
+bool RpcChannel::StreamDmx(unsigned int universe,
+                           uint8_t priority,
+                           const uint8_t *data,
+                           unsigned int length) {
+  if (length > DMX_UNIVERSE_SIZE) {
+    OLA_WARN << "DMX frame too large: " << length;
+    return false;
+  }
+
+  uint32_t header;
+  uint8_t frame[sizeof(header) + DMX_FRAME_HEADER_SIZE + DMX_UNIVERSE_SIZE];
+  RpcHeader::EncodeHeader(&header, DMX_FRAME_VERSION,
+                          DMX_FRAME_HEADER_SIZE + length);
+  memcpy(frame, &header, sizeof(header));
+
+  uint8_t *ptr = frame + sizeof(header);
+  *ptr++ = static_cast<uint8_t>(universe >> 24);
+  *ptr++ = static_cast<uint8_t>(universe >> 16);
+  *ptr++ = static_cast<uint8_t>(universe >> 8);
+  *ptr++ = static_cast<uint8_t>(universe);
+  *ptr++ = priority;
+  if (length) {
+    memcpy(ptr, data, length);
+  }
+  return SendFrame(frame, sizeof(header) + DMX_FRAME_HEADER_SIZE + length);
+}
+
 // private
 //-----------------------------------------------------------------------------
 
 /*
- * Write an RpcMessage to the write descriptor.
+ * Track a request we've sent, so we can run the callback once the reply
+ * arrives.
  */
-bool RpcChannel::SendMsg(RpcMessage *msg) {
-  if (!(m_descriptor && m_descriptor->ValidReadDescriptor())) {
-    OLA_WARN << "RPC descriptor closed, not sending messages";
-    return false;
+void RpcChannel::AddOutstandingResponse(bool sent,
+                                        uint32_t id,
+                                        RpcController *controller,
+                                        Message *reply,
+                                        SingleUseCallback0<void> *done) {
+  if (!sent) {
+    // Send failed, call the handler now.
+    controller->SetFailed("Failed to send request");
+    done->Run();
+    return;
+  }
+
+  OutstandingResponse *response = new OutstandingResponse(
+      id, controller, done, reply);
+
+  auto_ptr<OutstandingResponse> old_response(
+      STLReplacePtr(&m_responses, id, response));
+
+  if (old_response.get()) {
+    // fail any outstanding response with the same id
+    OLA_WARN << "response " << old_response->id << " already pending, failing "
+             << "now";
+    response->controller->SetFailed("Duplicate request found");
+    response->callback->Run();
   }
+}
 
+/*
+ * Write an RpcMessage to the write descriptor.
+ */
+bool RpcChannel::SendMsg(RpcMessage *msg) {
   uint32_t header;
   // reserve the first 4 bytes for the header
   string output(sizeof(header), 0);
@@ -301,14 +387,26 @@ bool RpcChannel::SendMsg(RpcMessage *msg) {
       0, sizeof(header),
       reinterpret_cast<const char*>(&header), sizeof(header));
 
-  ssize_t ret = m_descriptor->Send(
-      reinterpret_cast<const uint8_t*>(output.data()), length);
+  return SendFrame(reinterpret_cast<const uint8_t*>(output.data()), length);
+}
+
 
-  if (ret != length) {
+/*
+ * Write a complete frame, including the header, to the descriptor.
+ */
+bool RpcChannel::SendFrame(const uint8_t *data, unsigned int length) {
+  if (!(m_descriptor && m_descriptor->ValidReadDescriptor())) {
+    OLA_WARN << "RPC descriptor closed, not sending messages";
+    return false;
+  }
+
+  ssize_t ret = m_descriptor->Send(data, length);
+
+  if (ret != static_cast<ssize_t>(length)) {
     OLA_WARN << "Failed to send full RPC message, closing channel";
 
-    if (m_export_map) {
-      (*m_export_map->GetCounterVar(K_RPC_SENT_ERROR_VAR))++;
+    if (m_sent_error_var) {
+      (*m_sent_error_var)++;
     }
 
     // At this point there is no point using the descriptor since framing has
@@ -321,8 +419,8 @@ bool RpcChannel::SendMsg(RpcMessage *msg) {
     return false;
   }
 
-  if (m_export_map) {
-    (*m_export_map->GetCounterVar(K_RPC_SENT_VAR))++;
+  if (m_sent_var) {
+    (*m_sent_var)++;
   }
   return true;
 }
@@ -383,6 +481,16 @@ int RpcChannel::ReadHeader(unsigned int *version,
 }
 
 
+/*
+ * Count a received message by type.
+ */
+void RpcChannel::CountReceived(ReceivedType type) {
+  if (m_recv_type_vars[type]) {
+    (*m_recv_type_vars[type])++;
+  }
+}
+
+
 /*
  * Parse a new message and handle it.
  */
@@ -393,38 +501,32 @@ bool RpcChannel::HandleNewMsg(uint8_t *data, unsigned int size) {
     return false;
   }
 
-  if (m_export_map)
-    (*m_export_map->GetCounterVar(K_RPC_RECEIVED_VAR))++;
+  if (m_received_var)
+    (*m_received_var)++;
 
   switch (msg.type()) {
     case REQUEST:
-      if (m_recv_type_map)
-        (*m_recv_type_map)["request"]++;
+      CountReceived(RECEIVED_REQUEST);
       HandleRequest(&msg);
       break;
     case RESPONSE:
-      if (m_recv_type_map)
-        (*m_recv_type_map)["response"]++;
+      CountReceived(RECEIVED_RESPONSE);
       HandleResponse(&msg);
       break;
     case RESPONSE_CANCEL:
-      if (m_recv_type_map)
-        (*m_recv_type_map)["cancelled"]++;
+      CountReceived(RECEIVED_CANCELLED);
       HandleCanceledResponse(&msg);
       break;
     case RESPONSE_FAILED:
-      if (m_recv_type_map)
-        (*m_recv_type_map)["failed"]++;
+      CountReceived(RECEIVED_FAILED);
       HandleFailedResponse(&msg);
       break;
     case RESPONSE_NOT_IMPLEMENTED:
-      if (m_recv_type_map)
-        (*m_recv_type_map)["not-implemented"]++;
+      CountReceived(RECEIVED_NOT_IMPLEMENTED);
       HandleNotImplemented(&msg);
       break;
     case STREAM_REQUEST:
-      if (m_recv_type_map)
-        (*m_recv_type_map)["stream_request"]++;
+      CountReceived(RECEIVED_STREAM_REQUEST);
       HandleStreamRequest(&msg);
       break;
     default:
@@ -435,6 +537,37 @@ bool RpcChannel::HandleNewMsg(uint8_t *data, unsigned int size) {
 }
 
 
+/*
+ * Handle a raw DMX frame.
+ */
+bool RpcChannel::HandleDmxFrame(const uint8_t *data, unsigned int size) {
+  if (size < DMX_FRAME_HEADER_SIZE ||
+      size > DMX_FRAME_HEADER_SIZE + DMX_UNIVERSE_SIZE) {
+    OLA_WARN << "Invalid DMX frame size " << size;
+    return false;
+  }
+
+  if (m_received_var)
+    (*m_received_var)++;
+  CountReceived(RECEIVED_DMX_FRAME);
+
+  if (!m_service) {
+    OLA_WARN << "no service registered";
+    return true;
+  }
+
+  unsigned int universe = (static_cast<unsigned int>(data[0]) << 24) |
+                          (static_cast<unsigned int>(data[1]) << 16) |
+                          (static_cast<unsigned int>(data[2]) << 8) |
+                          data[3];
+  RpcController controller(m_session.get());
+  m_service->HandleDmxFrame(&controller, universe, data[4],
+                            data + DMX_FRAME_HEADER_SIZE,
+                            size - DMX_FRAME_HEADER_SIZE);
+  return true;
+}
+
+
 /*
  * Handle a new RPC method call.
  */
@@ -117,6 +117,23 @@ class RpcChannel {
                     google::protobuf::Message *response,
                     SingleUseCallback0<void> *done);
 
+    /**
+     * @brief Invoke an RPC method on this channel, using a request that has
+     * already been serialized.
+     *
+     * This allows the same request to be sent to many peers, while only
+     * serializing it once.
+     * @param request the SerializedRequest to send, the method must not be a
+     *   streaming method.
+     * @param controller the RpcController for the call.
+     * @param reply the message to store the reply in.
+     * @param done the callback to run when the call completes.
+     */
+    void CallMethod(const class SerializedRequest &request,
+                    class RpcController *controller,
+                    google::protobuf::Message *reply,
+                    SingleUseCallback0<void> *done);
+
     /**
      * @brief Invoked by the RPC completion handler when the server side
      * response is ready.
@@ -130,11 +147,38 @@ class RpcChannel {
      */
     RpcSession *Session();
 
+    /**
+     * @brief Send a DMX frame to the peer, without using protobufs.
+     *
+     * This is the fast path for streaming DMX. The frame is the usual 4 byte
+     * header, with the version set to DMX_FRAME_VERSION, followed by the
+     * universe (4 bytes, network byte order), the priority (1 byte) and then
+     * the slot data. The receiving end passes it to
+     * RpcService::HandleDmxFrame().
+     *
+     * Peers that only understand PROTOCOL_VERSION can't parse these frames,
+     * so only use this if you know the other end supports it.
+     * @param universe the universe id.
+     * @param priority the priority of the data.
+     * @param data the DMX slot data.
+     * @param length the number of slots, at most DMX_UNIVERSE_SIZE.
+     * @returns true if the frame was sent, false otherwise.
+     */
+    bool StreamDmx(unsigned int universe,
+                   uint8_t priority,
+                   const uint8_t *data,
+                   unsigned int length);
+
     /**
      * @brief the RPC protocol version.
      */
     static const unsigned int PROTOCOL_VERSION = 1;
 
+    /**
+     * @brief the version used for raw DMX frames.
+     */
+    static const unsigned int DMX_FRAME_VERSION = 2;
+
  private:
     typedef HASH_NAMESPACE::HASH_MAP_CLASS<int, class OutstandingResponse*>
       ResponseMap;
@@ -149,15 +193,41 @@ class RpcChannel {
     unsigned int m_buffer_size;  // size of the buffer
     unsigned int m_expected_size;  // the total size of the current msg
     unsigned int m_current_size;  // the amount of data read for the current msg
+    unsigned int m_current_version;  // the version of the current msg
     HASH_NAMESPACE::HASH_MAP_CLASS<int, class OutstandingRequest*> m_requests;
     ResponseMap m_responses;
     ExportMap *m_export_map;
-    UIntMap *m_recv_type_map;
+
+    enum ReceivedType {
+      RECEIVED_REQUEST,
+      RECEIVED_RESPONSE,
+      RECEIVED_CANCELLED,
+      RECEIVED_FAILED,
+      RECEIVED_NOT_IMPLEMENTED,
+      RECEIVED_STREAM_REQUEST,
+      RECEIVED_DMX_FRAME,
+      RECEIVED_TYPE_COUNT,
+    };
+
+    // The counters are looked up once, they're NULL if there's no ExportMap.
+    CounterVariable *m_received_var;
+    CounterVariable *m_sent_var;
+    CounterVariable *m_sent_error_var;
+    CounterVariable *m_recv_type_vars[RECEIVED_TYPE_COUNT];
+
+    void CountReceived(ReceivedType type);
 
     bool SendMsg(RpcMessage *msg);
+    void AddOutstandingResponse(bool sent,
+                                uint32_t id,
+                                class RpcController *controller,
+                                google::protobuf::Message *reply,
+                                SingleUseCallback0<void> *done);
+    bool SendFrame(const uint8_t *data, unsigned int length);
     int AllocateMsgBuffer(unsigned int size);
     int ReadHeader(unsigned int *version, unsigned int *size) const;
     bool HandleNewMsg(uint8_t *buffer, unsigned int size);
+    bool HandleDmxFrame(const uint8_t *data, unsigned int size);
     void HandleRequest(RpcMessage *msg);
     void HandleStreamRequest(RpcMessage *msg);
 
@@ -178,8 +248,10 @@ class RpcChannel {
     static const char K_RPC_RECEIVED_VAR[];
     static const char K_RPC_SENT_ERROR_VAR[];
     static const char K_RPC_SENT_VAR[];
-    static const char *K_RPC_VARIABLES[];
+    static const char *K_RECEIVED_TYPES[];
     static const char STREAMING_NO_RESPONSE[];
+    // universe + priority
+    static const unsigned int DMX_FRAME_HEADER_SIZE = 5;
     static const unsigned int INITIAL_BUFFER_SIZE = 1 << 11;  // 2k
     static const unsigned int MAX_BUFFER_SIZE = 1 << 20;  // 1M
 };
@@ -25,6 +25,7 @@
 
 #include "common/rpc/RpcChannel.h"
 #include "common/rpc/RpcController.h"
+#include "common/rpc/SerializedRequest.h"
 #include "common/rpc/TestService.h"
 #include "common/rpc/TestService.pb.h"
 #include "common/rpc/TestServiceService.pb.h"
@@ -42,6 +43,7 @@ using ola::rpc::EchoRequest;
 using ola::rpc::RpcChannel;
 using ola::rpc::RpcController;
 using ola::rpc::STREAMING_NO_RESPONSE;
+using ola::rpc::SerializedRequest;
 using ola::rpc::RpcController;
 using ola::rpc::TestService;
 using ola::rpc::TestService_Stub;
@@ -53,6 +55,8 @@ class RpcChannelTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testEcho);
   CPPUNIT_TEST(testFailedEcho);
   CPPUNIT_TEST(testStreamRequest);
+  CPPUNIT_TEST(testDmxFrame);
+  CPPUNIT_TEST(testSerializedRequest);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -61,10 +65,14 @@ class RpcChannelTest: public CppUnit::TestFixture {
   void testEcho();
   void testFailedEcho();
   void testStreamRequest();
+  void testDmxFrame();
+  void testSerializedRequest();
   void EchoComplete();
   void FailedEchoComplete();
+  void SerializedEchoComplete(RpcController *controller, EchoReply *reply);
 
  private:
+  unsigned int m_pending_echos;
   RpcController m_controller;
   EchoRequest m_request;
   EchoReply m_reply;
@@ -104,6 +112,17 @@ void RpcChannelTest::FailedEchoComplete() {
   OLA_ASSERT_TRUE(m_controller.Failed());
 }
 
+void RpcChannelTest::SerializedEchoComplete(RpcController *controller,
+                                            EchoReply *reply) {
+  OLA_ASSERT_FALSE(controller->Failed());
+  OLA_ASSERT_EQ(string("foo"), reply->data());
+  delete controller;
+  delete reply;
+  if (--m_pending_echos == 0) {
+    m_ss.Terminate();
+  }
+}
+
 /*
  * Check that we can call the echo method in the TestServiceImpl.
  */
@@ -139,3 +158,60 @@ void RpcChannelTest::testStreamRequest() {
   m_stub->Stream(NULL, &m_request, NULL, NULL);
   m_ss.Run();
 }
+
+/*
+ * Check raw DMX frames are passed to the service.
+ */
+void RpcChannelTest::testDmxFrame() {
+  const uint8_t data[] = {1, 2, 3, 255};
+  OLA_ASSERT_TRUE(m_channel->StreamDmx(0x12345678, 150, data, sizeof(data)));
+  m_ss.Run();
+  OLA_ASSERT_EQ(0x12345678u, m_service->dmx_universe);
+  OLA_ASSERT_EQ(static_cast<uint8_t>(150), m_service->dmx_priority);
+  OLA_ASSERT_DATA_EQUALS(data, sizeof(data),
+                         reinterpret_cast<const uint8_t*>(
+                             m_service->dmx_data.data()),
+                         m_service->dmx_data.size());
+
+  // an empty frame
+  OLA_ASSERT_TRUE(m_channel->StreamDmx(2, 100, NULL, 0));
+  m_ss.Run();
+  OLA_ASSERT_EQ(2u, m_service->dmx_universe);
+  OLA_ASSERT_TRUE(m_service->dmx_data.empty());
+
+  // frames larger than a universe are rejected
+  uint8_t large[513] = {0};
+  OLA_ASSERT_FALSE(m_channel->StreamDmx(1, 100, large, sizeof(large)));
+
+  // check the framing is still intact for regular RPCs
+  m_request.set_data("foo");
+  m_request.set_session_ptr(0);
+  m_stub->Echo(&m_controller,
+               &m_request,
+               &m_reply,
+               NewSingleCallback(this, &RpcChannelTest::EchoComplete));
+  m_ss.Run();
+}
+
+/*
+ * Check a SerializedRequest can be sent many times.
+ */
+void RpcChannelTest::testSerializedRequest() {
+  m_request.set_data("foo");
+  m_request.set_session_ptr(0);
+  SerializedRequest request(
+      TestService::descriptor()->FindMethodByName("Echo"), m_request);
+
+  // Enough that the later ids take more than one byte to encode.
+  m_pending_echos = 200;
+  for (unsigned int i = 0; i < 200; i++) {
+    RpcController *controller = new RpcController();
+    EchoReply *reply = new EchoReply();
+    m_channel->CallMethod(
+        request, controller, reply,
+        NewSingleCallback(this, &RpcChannelTest::SerializedEchoComplete,
+                          controller, reply));
+  }
+  m_ss.Run();
+  OLA_ASSERT_EQ(0u, m_pending_echos);
+}
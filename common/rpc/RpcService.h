@@ -23,6 +23,7 @@
 #ifndef COMMON_RPC_RPCSERVICE_H_
 #define COMMON_RPC_RPCSERVICE_H_
 
+#include <stdint.h>
 #include <google/protobuf/service.h>
 #include <string>
 #include "ola/Callback.h"
@@ -53,6 +54,15 @@ class RpcService {
         const google::protobuf::MethodDescriptor *method) const = 0;
     virtual const google::protobuf::Message& GetResponsePrototype(
         const google::protobuf::MethodDescriptor *method) const = 0;
+
+    // Handle a raw DMX frame, see RpcChannel::StreamDmx(). The default
+    // implementation drops the frame.
+    virtual void HandleDmxFrame(RpcController*,
+                                unsigned int,
+                                uint8_t,
+                                const uint8_t*,
+                                unsigned int) {
+    }
 };
 }  // namespace rpc
 }  // namespace ola
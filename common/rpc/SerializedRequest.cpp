@@ -0,0 +1,94 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SerializedRequest.cpp
+ * An RPC request that's serialized once and sent on many channels.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include "common/rpc/SerializedRequest.h"
+
+#include <string>
+
+#include "common/rpc/Rpc.pb.h"
+
+namespace ola {
+namespace rpc {
+
+using google::protobuf::Message;
+using google::protobuf::MethodDescriptor;
+using std::string;
+
+SerializedRequest::SerializedRequest()
+    : m_method(NULL),
+      m_data(NULL),
+      m_ref_count(NULL) {
+}
+
+SerializedRequest::SerializedRequest(const MethodDescriptor *method,
+                                     const Message &request)
+    : m_method(method),
+      m_data(new string()),
+      m_ref_count(new unsigned int(1)) {
+  RpcMessage message;
+  message.set_type(REQUEST);
+  message.set_name(method->name());
+  request.SerializeToString(message.mutable_buffer());
+  message.SerializeToString(m_data);
+}
+
+SerializedRequest::SerializedRequest(const SerializedRequest &other)
+    : m_method(other.m_method),
+      m_data(other.m_data),
+      m_ref_count(other.m_ref_count) {
+  if (m_ref_count) {
+    (*m_ref_count)++;
+  }
+}
+
+SerializedRequest::~SerializedRequest() {
+  Release();
+}
+
+SerializedRequest& SerializedRequest::operator=(
+    const SerializedRequest &other) {
+  if (this != &other) {
+    Release();
+    m_method = other.m_method;
+    m_data = other.m_data;
+    m_ref_count = other.m_ref_count;
+    if (m_ref_count) {
+      (*m_ref_count)++;
+    }
+  }
+  return *this;
+}
+
+const string &SerializedRequest::Data() const {
+  static const string empty;
+  return m_data ? *m_data : empty;
+}
+
+void SerializedRequest::Release() {
+  if (m_ref_count && --(*m_ref_count) == 0) {
+    delete m_data;
+    delete m_ref_count;
+  }
+  m_method = NULL;
+  m_data = NULL;
+  m_ref_count = NULL;
+}
+}  // namespace rpc
+}  // namespace ola
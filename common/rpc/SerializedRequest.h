@@ -0,0 +1,89 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SerializedRequest.h
+ * An RPC request that's serialized once and sent on many channels.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#ifndef COMMON_RPC_SERIALIZEDREQUEST_H_
+#define COMMON_RPC_SERIALIZEDREQUEST_H_
+
+#include <google/protobuf/descriptor.h>
+#include <google/protobuf/message.h>
+#include <string>
+
+namespace ola {
+namespace rpc {
+
+/**
+ * @brief An RPC request that's serialized once and sent on many channels.
+ *
+ * This holds the encoded RpcMessage for the request, minus the id, which
+ * differs for each channel. Since protobuf fields can appear in any order,
+ * RpcChannel appends the id to the shared encoding when it sends the
+ * request.
+ *
+ * Copies share the encoded data, so they're cheap to make. The data isn't
+ * protected by a lock, so all copies must be used from the same thread.
+ */
+class SerializedRequest {
+ public:
+  /**
+   * @brief Create an empty SerializedRequest.
+   */
+  SerializedRequest();
+
+  /**
+   * @brief Serialize a request.
+   * @param method the method to call, this must not be a streaming method.
+   * @param request the request message.
+   */
+  SerializedRequest(const google::protobuf::MethodDescriptor *method,
+                    const google::protobuf::Message &request);
+
+  SerializedRequest(const SerializedRequest &other);
+
+  ~SerializedRequest();
+
+  SerializedRequest& operator=(const SerializedRequest &other);
+
+  /**
+   * @brief Check if this object holds a request.
+   */
+  bool IsSet() const { return m_data != NULL; }
+
+  /**
+   * @brief The method the request is for, or NULL if this isn't set.
+   */
+  const google::protobuf::MethodDescriptor *Method() const {
+    return m_method;
+  }
+
+  /**
+   * @brief The encoded RpcMessage, without the id.
+   */
+  const std::string &Data() const;
+
+ private:
+  const google::protobuf::MethodDescriptor *m_method;
+  std::string *m_data;
+  unsigned int *m_ref_count;
+
+  void Release();
+};
+}  // namespace rpc
+}  // namespace ola
+#endif  // COMMON_RPC_SERIALIZEDREQUEST_H_
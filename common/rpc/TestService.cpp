@@ -76,6 +76,18 @@ void TestServiceImpl::Stream(RpcController* controller,
   m_ss->Terminate();
 }
 
+void TestServiceImpl::HandleDmxFrame(RpcController* controller,
+                                     unsigned int universe,
+                                     uint8_t priority,
+                                     const uint8_t *data,
+                                     unsigned int length) {
+  OLA_ASSERT_NOT_NULL(controller);
+  dmx_universe = universe;
+  dmx_priority = priority;
+  dmx_data.assign(reinterpret_cast<const char*>(data), length);
+  m_ss->Terminate();
+}
+
 
 TestClient::TestClient(SelectServer *ss,
                        const GenericSocketAddress &server_addr)
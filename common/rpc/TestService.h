@@ -21,7 +21,9 @@
 #ifndef COMMON_RPC_TESTSERVICE_H_
 #define COMMON_RPC_TESTSERVICE_H_
 
+#include <stdint.h>
 #include <memory>
+#include <string>
 
 #include "common/rpc/RpcController.h"
 #include "common/rpc/TestServiceService.pb.h"
@@ -31,7 +33,11 @@
 
 class TestServiceImpl: public ola::rpc::TestService {
  public:
-  explicit TestServiceImpl(ola::io::SelectServer *ss) : m_ss(ss) {}
+  explicit TestServiceImpl(ola::io::SelectServer *ss)
+      : dmx_universe(0),
+        dmx_priority(0),
+        m_ss(ss) {
+  }
   ~TestServiceImpl() {}
 
   void Echo(ola::rpc::RpcController* controller,
@@ -48,6 +54,18 @@ class TestServiceImpl: public ola::rpc::TestService {
               const ola::rpc::EchoRequest* request,
               ola::rpc::STREAMING_NO_RESPONSE* response,
               CompletionCallback* done);
+
+  void HandleDmxFrame(ola::rpc::RpcController* controller,
+                      unsigned int universe,
+                      uint8_t priority,
+                      const uint8_t *data,
+                      unsigned int length);
+
+  // The last DMX frame received.
+  unsigned int dmx_universe;
+  uint8_t dmx_priority;
+  std::string dmx_data;
+
  private:
   ola::io::SelectServer *m_ss;
 };
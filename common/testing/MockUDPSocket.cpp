@@ -206,6 +206,21 @@ bool MockUDPSocket::RecvFrom(
 }
 
 
+unsigned int MockUDPSocket::RecvMany(ola::network::IncomingDatagram *datagrams,
+                                     unsigned int count) {
+  // Like a real socket, this should only be called when there is data.
+  OLA_ASSERT_FALSE(m_received_data.empty());
+  unsigned int received = 0;
+  while (received < count && !m_received_data.empty()) {
+    ssize_t size = datagrams[received].size;
+    RecvFrom(datagrams[received].data, &size, &datagrams[received].source);
+    datagrams[received].size = size;
+    received++;
+  }
+  return received;
+}
+
+
 bool MockUDPSocket::EnableBroadcast() {
   m_broadcast_set = true;
   return true;
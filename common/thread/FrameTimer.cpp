@@ -0,0 +1,220 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * FrameTimer.cpp
+ * Precise frame timing for threaded DMX outputs.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif  // HAVE_CONFIG_H
+
+#include "ola/thread/FrameTimer.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+#include "ola/Logging.h"
+#include "ola/thread/Utils.h"
+
+namespace ola {
+namespace thread {
+
+namespace {
+const int64_t ONE_SECOND_IN_NS = 1000000000;
+const int64_t ONE_US_IN_NS = 1000;
+}  // namespace
+
+const char FrameTimer::FRAME_RATE_VAR[] = "dmx-output-frame-rate";
+const char FrameTimer::JITTER_VAR[] = "dmx-output-jitter-us";
+
+FrameTimer::FrameTimer(unsigned int frame_time,
+                       const Options &options,
+                       ExportMap *export_map,
+                       const std::string &name)
+    : m_options(options),
+      m_name(name),
+      m_frame_time(frame_time * ONE_US_IN_NS),
+      m_frame_start(0),
+      m_window_start(0),
+      m_window_frames(0),
+      m_window_jitter(0),
+      m_frame_rate(0),
+      m_jitter(0),
+      m_frame_count(0),
+      m_frame_rate_map(NULL),
+      m_jitter_map(NULL),
+      m_frame_rate_var(NULL),
+      m_jitter_var(NULL) {
+  if (export_map) {
+    // The entries are created here, so the output thread only updates them.
+    m_frame_rate_map = export_map->GetGaugeMapVar(FRAME_RATE_VAR, "output");
+    m_jitter_map = export_map->GetGaugeMapVar(JITTER_VAR, "output");
+    m_frame_rate_var = m_frame_rate_map->Gauge(m_name);
+    m_jitter_var = m_jitter_map->Gauge(m_name);
+  }
+}
+
+
+FrameTimer::~FrameTimer() {
+  if (m_frame_rate_map) {
+    m_frame_rate_map->Remove(m_name);
+    m_jitter_map->Remove(m_name);
+  }
+}
+
+
+bool FrameTimer::SetupThread() {
+  bool ok = true;
+  if (m_options.realtime) {
+    struct sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = m_options.priority ? m_options.priority :
+                           sched_get_priority_min(SCHED_FIFO);
+    ok &= SetSchedParam(pthread_self(), SCHED_FIFO, param);
+  }
+
+  if (m_options.cpu >= 0) {
+#ifdef HAVE_SCHED_SETAFFINITY
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(m_options.cpu, &cpu_set);
+    if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set)) {
+      OLA_WARN << "Failed to pin " << m_name << " to CPU " << m_options.cpu
+               << ": " << strerror(errno);
+      ok = false;
+    }
+#else
+    OLA_WARN << "CPU pinning isn't supported on this platform";
+    ok = false;
+#endif  // HAVE_SCHED_SETAFFINITY
+  }
+  return ok;
+}
+
+
+void FrameTimer::SetFrameTime(unsigned int frame_time) {
+  m_frame_time = frame_time * ONE_US_IN_NS;
+}
+
+
+void FrameTimer::StartFrame() {
+  int64_t now = Now();
+  if (!m_frame_start) {
+    m_frame_start = now;
+    m_window_start = now;
+    m_frame_count++;
+    return;
+  }
+
+  int64_t deadline = m_frame_start + m_frame_time;
+  if (deadline > now) {
+    SleepUntil(deadline);
+    now = Now();
+  }
+
+  // With no frame time, frames are sent back to back and are never late.
+  int64_t late = m_frame_time ? now - deadline : 0;
+  if (late > m_frame_time) {
+    // Don't try to catch up, just start the schedule again.
+    deadline = now;
+  }
+  m_frame_start = deadline;
+  m_frame_count++;
+  UpdateStats(now, late);
+}
+
+
+void FrameTimer::Delay(unsigned int delay) {
+  SleepUntil(Now() + delay * ONE_US_IN_NS);
+}
+
+
+/**
+ * Sleep until just before the deadline, then spin.
+ */
+void FrameTimer::SleepUntil(int64_t deadline) {
+  int64_t wake_up = deadline - m_options.spin_time * ONE_US_IN_NS;
+#if defined(HAVE_CLOCK_NANOSLEEP) && defined(HAVE_CLOCK_GETTIME)
+  struct timespec wake_up_time;
+  wake_up_time.tv_sec = wake_up / ONE_SECOND_IN_NS;
+  wake_up_time.tv_nsec = wake_up % ONE_SECOND_IN_NS;
+  if (wake_up > Now()) {
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_up_time,
+                           NULL) == EINTR) {
+    }
+  }
+#else
+  int64_t now = Now();
+  if (wake_up > now) {
+    usleep((wake_up - now) / ONE_US_IN_NS);
+  }
+#endif  // defined(HAVE_CLOCK_NANOSLEEP) && defined(HAVE_CLOCK_GETTIME)
+
+  while (Now() < deadline) {
+  }
+}
+
+
+/**
+ * Update the rate & jitter, these are calculated over one second windows.
+ */
+void FrameTimer::UpdateStats(int64_t now, int64_t late) {
+  m_window_frames++;
+  m_window_jitter = std::max(m_window_jitter, late);
+
+  int64_t window = now - m_window_start;
+  if (window < ONE_SECOND_IN_NS) {
+    return;
+  }
+
+  m_frame_rate = (m_window_frames * ONE_SECOND_IN_NS + window / 2) / window;
+  m_jitter = m_window_jitter / ONE_US_IN_NS;
+  if (m_frame_rate_var) {
+    m_frame_rate_var->Set(m_frame_rate);
+    m_jitter_var->Set(m_jitter);
+  }
+
+  m_window_start = now;
+  m_window_frames = 0;
+  m_window_jitter = 0;
+}
+
+
+/**
+ * Return a monotonic time in nanoseconds.
+ */
+int64_t FrameTimer::Now() {
+#ifdef HAVE_CLOCK_GETTIME
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec * ONE_SECOND_IN_NS + now.tv_nsec;
+#else
+  struct timeval now;
+  gettimeofday(&now, NULL);
+  return now.tv_sec * ONE_SECOND_IN_NS + now.tv_usec * ONE_US_IN_NS;
+#endif  // HAVE_CLOCK_GETTIME
+}
+}  // namespace thread
+}  // namespace ola
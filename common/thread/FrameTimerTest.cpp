@@ -0,0 +1,130 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * FrameTimerTest.cpp
+ * Test fixture for the FrameTimer class
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <unistd.h>
+#include <string>
+
+#include "ola/Clock.h"
+#include "ola/ExportMap.h"
+#include "ola/Logging.h"
+#include "ola/testing/TestUtils.h"
+#include "ola/thread/FrameTimer.h"
+
+using ola::Clock;
+using ola::ExportMap;
+using ola::GaugeMap;
+using ola::TimeStamp;
+using ola::thread::FrameTimer;
+using std::string;
+
+class FrameTimerTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(FrameTimerTest);
+  CPPUNIT_TEST(testFrameRate);
+  CPPUNIT_TEST(testDelay);
+  CPPUNIT_TEST(testOverrun);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void testFrameRate();
+  void testDelay();
+  void testOverrun();
+
+ private:
+  Clock m_clock;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(FrameTimerTest);
+
+
+/*
+ * Check frames are never early, and the stats are exported. This only
+ * asserts on bounds that hold however loaded the machine is.
+ */
+void FrameTimerTest::testFrameRate() {
+  ExportMap export_map;
+  GaugeMap *rate_map = export_map.GetGaugeMapVar(
+      FrameTimer::FRAME_RATE_VAR, "output");
+  GaugeMap *jitter_map = export_map.GetGaugeMapVar(
+      FrameTimer::JITTER_VAR, "output");
+
+  {
+    FrameTimer timer(5000, FrameTimer::Options(), &export_map, "port");
+    OLA_ASSERT_EQ(string("map:output port:0"), rate_map->Value());
+    OLA_ASSERT_EQ(string("map:output port:0"), jitter_map->Value());
+
+    TimeStamp start, end;
+    m_clock.CurrentTime(&start);
+    // Over a second, so the stats are updated at least once.
+    for (unsigned int i = 0; i < 210; i++) {
+      timer.StartFrame();
+      // Simulate the time taken to send the frame.
+      usleep(1000);
+    }
+    m_clock.CurrentTime(&end);
+
+    OLA_ASSERT_EQ(static_cast<uint64_t>(210), timer.FrameCount());
+    // The last frame can't start before 209 frame periods have passed.
+    OLA_ASSERT_TRUE((end - start).InMilliSeconds() >= 1045);
+
+    // Frames may be late, but are never sent faster than the frame time.
+    OLA_ASSERT_TRUE(timer.FrameRate() > 0);
+    OLA_ASSERT_TRUE(timer.FrameRate() <= 201);
+    OLA_ASSERT_EQ(timer.FrameRate(), rate_map->Gauge("port")->Get());
+    OLA_ASSERT_EQ(timer.Jitter(), jitter_map->Gauge("port")->Get());
+  }
+
+  // The stats are removed with the timer.
+  OLA_ASSERT_EQ(string("map:output"), rate_map->Value());
+  OLA_ASSERT_EQ(string("map:output"), jitter_map->Value());
+}
+
+
+/*
+ * Check Delay() blocks for at least the requested time.
+ */
+void FrameTimerTest::testDelay() {
+  FrameTimer timer(0);
+  TimeStamp start, end;
+  m_clock.CurrentTime(&start);
+  timer.Delay(110);
+  timer.Delay(16);
+  m_clock.CurrentTime(&end);
+  OLA_ASSERT_TRUE((end - start).AsInt() >= 126);
+}
+
+
+/*
+ * Check that if we fall behind, the frames don't bunch up.
+ */
+void FrameTimerTest::testOverrun() {
+  FrameTimer timer(2000);
+  timer.StartFrame();
+  usleep(10000);
+
+  // We're late, so this returns immediately and restarts the schedule. If it
+  // didn't, the next frame would also be sent straight away.
+  TimeStamp start, end;
+  m_clock.CurrentTime(&start);
+  timer.StartFrame();
+  timer.StartFrame();
+  m_clock.CurrentTime(&end);
+  OLA_ASSERT_TRUE((end - start).AsInt() >= 2000);
+}
@@ -3,6 +3,7 @@
 common_libolacommon_la_SOURCES += \
     common/thread/ConsumerThread.cpp \
     common/thread/ExecutorThread.cpp \
+    common/thread/FrameTimer.cpp \
     common/thread/Mutex.cpp \
     common/thread/PeriodicThread.cpp \
     common/thread/SignalThread.cpp \
@@ -10,13 +11,23 @@ common_libolacommon_la_SOURCES += \
     common/thread/ThreadPool.cpp \
     common/thread/Utils.cpp
 
+# PROGRAMS
+##################################################
+noinst_PROGRAMS += common/thread/ring_buffer_benchmark
+
+common_thread_ring_buffer_benchmark_SOURCES = \
+    common/thread/ring_buffer_benchmark.cpp
+common_thread_ring_buffer_benchmark_LDADD = common/libolacommon.la
+
 # TESTS
 ##################################################
 test_programs += common/thread/ExecutorThreadTester \
                  common/thread/ThreadTester \
-                 common/thread/FutureTester
+                 common/thread/FutureTester \
+                 common/thread/RingBufferTester
 
 common_thread_ThreadTester_SOURCES = \
+    common/thread/FrameTimerTest.cpp \
     common/thread/ThreadPoolTest.cpp \
     common/thread/ThreadTest.cpp
 common_thread_ThreadTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
@@ -30,3 +41,7 @@ common_thread_ExecutorThreadTester_SOURCES = \
     common/thread/ExecutorThreadTest.cpp
 common_thread_ExecutorThreadTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_thread_ExecutorThreadTester_LDADD = $(COMMON_TESTING_LIBS)
+
+common_thread_RingBufferTester_SOURCES = common/thread/RingBufferTest.cpp
+common_thread_RingBufferTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+common_thread_RingBufferTester_LDADD = $(COMMON_TESTING_LIBS)
@@ -0,0 +1,304 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * RingBufferTest.cpp
+ * Test fixture for the lock-free queues.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <sched.h>
+#include <string.h>
+#include <vector>
+
+#include "ola/Constants.h"
+#include "ola/DmxBuffer.h"
+#include "ola/thread/LatestValueSlot.h"
+#include "ola/thread/RingBuffer.h"
+#include "ola/thread/Thread.h"
+#include "ola/stl/STLUtils.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::DmxBuffer;
+using ola::thread::LatestValueSlot;
+using ola::thread::MPSCRingBuffer;
+using ola::thread::SPSCRingBuffer;
+using std::vector;
+
+class RingBufferTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(RingBufferTest);
+  CPPUNIT_TEST(testCapacity);
+  CPPUNIT_TEST(testSPSC);
+  CPPUNIT_TEST(testSPSCThreaded);
+  CPPUNIT_TEST(testMPSC);
+  CPPUNIT_TEST(testMPSCThreaded);
+  CPPUNIT_TEST(testLatestValue);
+  CPPUNIT_TEST(testLatestValueThreaded);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void testCapacity();
+    void testSPSC();
+    void testSPSCThreaded();
+    void testMPSC();
+    void testMPSCThreaded();
+    void testLatestValue();
+    void testLatestValueThreaded();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(RingBufferTest);
+
+static const unsigned int ITEMS_PER_PRODUCER = 10000;
+
+/*
+ * Pushes the numbers [start, start + ITEMS_PER_PRODUCER) into a queue.
+ */
+template <typename Queue>
+class ProducerThread: public ola::thread::Thread {
+ public:
+    ProducerThread(Queue *queue, unsigned int start)
+        : Thread(),
+          m_queue(queue),
+          m_start(start) {
+    }
+
+    void *Run() {
+      for (unsigned int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+        while (!m_queue->Push(m_start + i)) {
+          sched_yield();
+        }
+      }
+      return NULL;
+    }
+
+ private:
+    Queue *m_queue;
+    const unsigned int m_start;
+};
+
+/*
+ * Publishes DmxBuffers where every slot holds the frame number.
+ */
+class FrameWriterThread: public ola::thread::Thread {
+ public:
+    explicit FrameWriterThread(LatestValueSlot<DmxBuffer> *slot)
+        : Thread(),
+          m_slot(slot) {
+    }
+
+    void *Run() {
+      uint8_t data[ola::DMX_UNIVERSE_SIZE];
+      for (unsigned int i = 1; i <= FRAMES; i++) {
+        memset(data, i, sizeof(data));
+        m_slot->Writable()->Set(data, sizeof(data));
+        m_slot->Publish();
+      }
+      return NULL;
+    }
+
+    static const unsigned int FRAMES = 255;
+
+ private:
+    LatestValueSlot<DmxBuffer> *m_slot;
+};
+
+
+/*
+ * Check the capacity is rounded up to a power of two.
+ */
+void RingBufferTest::testCapacity() {
+  OLA_ASSERT_EQ(2u, ola::thread::RingBufferCapacity(0));
+  OLA_ASSERT_EQ(2u, ola::thread::RingBufferCapacity(2));
+  OLA_ASSERT_EQ(4u, ola::thread::RingBufferCapacity(3));
+  OLA_ASSERT_EQ(512u, ola::thread::RingBufferCapacity(512));
+  OLA_ASSERT_EQ(1024u, ola::thread::RingBufferCapacity(513));
+
+  SPSCRingBuffer<int> spsc(5);
+  OLA_ASSERT_EQ(8u, spsc.Capacity());
+  MPSCRingBuffer<int> mpsc(5);
+  OLA_ASSERT_EQ(8u, mpsc.Capacity());
+}
+
+
+/*
+ * Check the single producer queue from a single thread.
+ */
+void RingBufferTest::testSPSC() {
+  SPSCRingBuffer<unsigned int> queue(4);
+  unsigned int value;
+  OLA_ASSERT_TRUE(queue.Empty());
+  OLA_ASSERT_FALSE(queue.Pop(&value));
+
+  // wrap around a few times
+  for (unsigned int i = 0; i < 10; i++) {
+    OLA_ASSERT_TRUE(queue.Push(i));
+    OLA_ASSERT_TRUE(queue.Push(i + 1));
+    OLA_ASSERT_TRUE(queue.Push(i + 2));
+    OLA_ASSERT_TRUE(queue.Push(i + 3));
+    OLA_ASSERT_FALSE(queue.Push(i + 4));
+    OLA_ASSERT_FALSE(queue.Empty());
+
+    for (unsigned int j = 0; j < 4; j++) {
+      OLA_ASSERT_TRUE(queue.Pop(&value));
+      OLA_ASSERT_EQ(i + j, value);
+    }
+    OLA_ASSERT_FALSE(queue.Pop(&value));
+    OLA_ASSERT_TRUE(queue.Empty());
+  }
+}
+
+
+/*
+ * Check values arrive in order when the producer is another thread.
+ */
+void RingBufferTest::testSPSCThreaded() {
+  typedef SPSCRingBuffer<unsigned int> Queue;
+  Queue queue(64);
+  ProducerThread<Queue> producer(&queue, 0);
+  OLA_ASSERT_TRUE(producer.Start());
+
+  unsigned int expected = 0;
+  while (expected < ITEMS_PER_PRODUCER) {
+    unsigned int value;
+    if (queue.Pop(&value)) {
+      OLA_ASSERT_EQ(expected, value);
+      expected++;
+    } else {
+      sched_yield();
+    }
+  }
+  OLA_ASSERT_TRUE(producer.Join());
+  OLA_ASSERT_TRUE(queue.Empty());
+}
+
+
+/*
+ * Check the multi producer queue from a single thread.
+ */
+void RingBufferTest::testMPSC() {
+  MPSCRingBuffer<unsigned int> queue(4);
+  unsigned int value;
+  OLA_ASSERT_FALSE(queue.Pop(&value));
+
+  for (unsigned int i = 0; i < 10; i++) {
+    for (unsigned int j = 0; j < 4; j++) {
+      OLA_ASSERT_TRUE(queue.Push(i + j));
+    }
+    OLA_ASSERT_FALSE(queue.Push(i + 4));
+
+    for (unsigned int j = 0; j < 4; j++) {
+      OLA_ASSERT_TRUE(queue.Pop(&value));
+      OLA_ASSERT_EQ(i + j, value);
+    }
+    OLA_ASSERT_FALSE(queue.Pop(&value));
+  }
+}
+
+
+/*
+ * Check every value arrives exactly once, and in order for each producer.
+ */
+void RingBufferTest::testMPSCThreaded() {
+  typedef MPSCRingBuffer<unsigned int> Queue;
+  const unsigned int PRODUCERS = 4;
+  Queue queue(64);
+
+  vector<ProducerThread<Queue>*> producers;
+  for (unsigned int i = 0; i < PRODUCERS; i++) {
+    producers.push_back(
+        new ProducerThread<Queue>(&queue, i * ITEMS_PER_PRODUCER));
+    OLA_ASSERT_TRUE(producers.back()->Start());
+  }
+
+  vector<unsigned int> next(PRODUCERS);
+  for (unsigned int i = 0; i < PRODUCERS; i++) {
+    next[i] = i * ITEMS_PER_PRODUCER;
+  }
+
+  unsigned int received = 0;
+  while (received < PRODUCERS * ITEMS_PER_PRODUCER) {
+    unsigned int value;
+    if (queue.Pop(&value)) {
+      unsigned int producer = value / ITEMS_PER_PRODUCER;
+      OLA_ASSERT_LT(producer, PRODUCERS);
+      OLA_ASSERT_EQ(next[producer], value);
+      next[producer]++;
+      received++;
+    } else {
+      sched_yield();
+    }
+  }
+
+  for (unsigned int i = 0; i < PRODUCERS; i++) {
+    OLA_ASSERT_TRUE(producers[i]->Join());
+  }
+  ola::STLDeleteElements(&producers);
+  unsigned int value;
+  OLA_ASSERT_FALSE(queue.Pop(&value));
+}
+
+
+/*
+ * Check the latest value slot from a single thread.
+ */
+void RingBufferTest::testLatestValue() {
+  LatestValueSlot<int> slot;
+  OLA_ASSERT_FALSE(slot.Update());
+
+  *slot.Writable() = 1;
+  slot.Publish();
+  OLA_ASSERT_TRUE(slot.Update());
+  OLA_ASSERT_EQ(1, slot.Read());
+  OLA_ASSERT_FALSE(slot.Update());
+  OLA_ASSERT_EQ(1, slot.Read());
+
+  // Values the reader missed are dropped.
+  for (int i = 2; i < 10; i++) {
+    *slot.Writable() = i;
+    slot.Publish();
+  }
+  OLA_ASSERT_TRUE(slot.Update());
+  OLA_ASSERT_EQ(9, slot.Read());
+  OLA_ASSERT_FALSE(slot.Update());
+}
+
+
+/*
+ * Check the reader never sees a partially written frame, and frames never go
+ * backwards.
+ */
+void RingBufferTest::testLatestValueThreaded() {
+  LatestValueSlot<DmxBuffer> slot;
+  FrameWriterThread writer(&slot);
+  OLA_ASSERT_TRUE(writer.Start());
+
+  unsigned int last_frame = 0;
+  while (last_frame < FrameWriterThread::FRAMES) {
+    if (!slot.Update()) {
+      sched_yield();
+      continue;
+    }
+    const DmxBuffer &buffer = slot.Read();
+    OLA_ASSERT_EQ(static_cast<unsigned int>(ola::DMX_UNIVERSE_SIZE),
+                  buffer.Size());
+    unsigned int frame = buffer.Get(0);
+    OLA_ASSERT_GT(frame, last_frame);
+    for (unsigned int i = 1; i < buffer.Size(); i++) {
+      OLA_ASSERT_EQ(frame, static_cast<unsigned int>(buffer.Get(i)));
+    }
+    last_frame = frame;
+  }
+  OLA_ASSERT_TRUE(writer.Join());
+}
@@ -0,0 +1,177 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * ring_buffer_benchmark.cpp
+ * Compare the lock-free queues against a mutex protected std::queue.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <sched.h>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <vector>
+#include "ola/Clock.h"
+#include "ola/base/Array.h"
+#include "ola/base/Flags.h"
+#include "ola/base/Init.h"
+#include "ola/stl/STLUtils.h"
+#include "ola/thread/Mutex.h"
+#include "ola/thread/RingBuffer.h"
+#include "ola/thread/Thread.h"
+
+using ola::Clock;
+using ola::TimeInterval;
+using ola::TimeStamp;
+using ola::thread::MPSCRingBuffer;
+using ola::thread::Mutex;
+using ola::thread::MutexLocker;
+using ola::thread::SPSCRingBuffer;
+using std::cout;
+using std::endl;
+using std::vector;
+
+DEFINE_s_uint32(items, i, 1000000, "Number of items each producer sends");
+DEFINE_uint32(capacity, 1024, "The queue capacity");
+
+static const unsigned int PRODUCER_COUNTS[] = {1, 2, 4, 8};
+
+/**
+ * A bounded queue protected by a Mutex, this is what the threaded plugins
+ * used before the lock-free queues.
+ */
+class LockedQueue {
+ public:
+  explicit LockedQueue(unsigned int capacity) : m_capacity(capacity) {}
+
+  bool Push(unsigned int value) {
+    MutexLocker locker(&m_mutex);
+    if (m_queue.size() >= m_capacity) {
+      return false;
+    }
+    m_queue.push(value);
+    return true;
+  }
+
+  bool Pop(unsigned int *value) {
+    MutexLocker locker(&m_mutex);
+    if (m_queue.empty()) {
+      return false;
+    }
+    *value = m_queue.front();
+    m_queue.pop();
+    return true;
+  }
+
+ private:
+  const unsigned int m_capacity;
+  Mutex m_mutex;
+  std::queue<unsigned int> m_queue;
+};
+
+template <typename Queue>
+class Producer : public ola::thread::Thread {
+ public:
+  explicit Producer(Queue *queue) : Thread(), m_queue(queue) {}
+
+  void *Run() {
+    for (unsigned int i = 0; i < FLAGS_items; i++) {
+      while (!m_queue->Push(i)) {
+        sched_yield();
+      }
+    }
+    return NULL;
+  }
+
+ private:
+  Queue *m_queue;
+};
+
+/**
+ * Time how long it takes to pass all the items from the producers to this
+ * thread.
+ */
+template <typename Queue>
+TimeInterval RunProducers(Queue *queue, unsigned int producer_count) {
+  vector<Producer<Queue>*> producers;
+  for (unsigned int i = 0; i < producer_count; i++) {
+    producers.push_back(new Producer<Queue>(queue));
+  }
+
+  Clock clock;
+  TimeStamp start, end;
+  clock.CurrentTime(&start);
+  for (unsigned int i = 0; i < producer_count; i++) {
+    producers[i]->Start();
+  }
+
+  const unsigned int total = producer_count * FLAGS_items;
+  unsigned int received = 0;
+  unsigned int value;
+  while (received < total) {
+    if (queue->Pop(&value)) {
+      received++;
+    } else {
+      sched_yield();
+    }
+  }
+  clock.CurrentTime(&end);
+
+  for (unsigned int i = 0; i < producer_count; i++) {
+    producers[i]->Join();
+  }
+  ola::STLDeleteElements(&producers);
+  return end - start;
+}
+
+/**
+ * Return the throughput in millions of items per second.
+ */
+double Throughput(const TimeInterval &interval, unsigned int producers) {
+  return static_cast<double>(FLAGS_items) * producers / interval.AsInt();
+}
+
+int main(int argc, char* argv[]) {
+  ola::AppInit(&argc, argv, "[options]",
+               "Benchmark the lock-free queues under contention.");
+
+  cout << std::setw(10) << "producers" << std::setw(14) << "mutex M/s"
+       << std::setw(13) << "spsc M/s" << std::setw(13) << "mpsc M/s" << endl;
+
+  for (unsigned int p = 0; p < arraysize(PRODUCER_COUNTS); p++) {
+    const unsigned int producers = PRODUCER_COUNTS[p];
+
+    LockedQueue locked_queue(FLAGS_capacity);
+    TimeInterval locked = RunProducers(&locked_queue, producers);
+
+    MPSCRingBuffer<unsigned int> mpsc_queue(FLAGS_capacity);
+    TimeInterval mpsc = RunProducers(&mpsc_queue, producers);
+
+    cout << std::setw(10) << producers
+         << std::setw(14) << std::fixed << std::setprecision(2)
+         << Throughput(locked, producers);
+
+    // The SPSC queue only supports a single producer.
+    if (producers == 1) {
+      SPSCRingBuffer<unsigned int> spsc_queue(FLAGS_capacity);
+      TimeInterval spsc = RunProducers(&spsc_queue, producers);
+      cout << std::setw(13) << Throughput(spsc, producers);
+    } else {
+      cout << std::setw(13) << "-";
+    }
+    cout << std::setw(13) << Throughput(mpsc, producers) << endl;
+  }
+  return 0;
+}
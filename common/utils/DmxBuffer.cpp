@@ -36,6 +36,7 @@
 #include "ola/DmxBuffer.h"
 #include "ola/Logging.h"
 #include "ola/StringUtils.h"
+#include "ola/dmx/SlotKernels.h"
 
 namespace ola {
 
@@ -101,7 +102,7 @@ DmxBuffer& DmxBuffer::operator=(const DmxBuffer &other) {
 bool DmxBuffer::operator==(const DmxBuffer &other) const {
   return (m_length == other.m_length &&
           (m_data == other.m_data ||
-           0 == memcmp(m_data, other.m_data, m_length)));
+           ola::dmx::SlotsEqual(m_data, other.m_data, m_length)));
 }
 
 
@@ -121,9 +122,7 @@ bool DmxBuffer::HTPMerge(const DmxBuffer &other) {
                                   other.m_length);
   unsigned int merge_length = min(m_length, other.m_length);
 
-  for (unsigned int i = 0; i < merge_length; i++) {
-    m_data[i] = max(m_data[i], other.m_data[i]);
-  }
+  ola::dmx::MaxSlots(m_data, other.m_data, merge_length);
 
   if (other_length > m_length) {
     memcpy(m_data + merge_length, other.m_data + merge_length,
@@ -134,6 +133,60 @@ bool DmxBuffer::HTPMerge(const DmxBuffer &other) {
 }
 
 
+bool DmxBuffer::HTPMergeMany(const DmxBuffer *const *sources,
+                             unsigned int count) {
+  // If we're one of the sources, hold a reference to the current data so it
+  // isn't overwritten while it's being merged.
+  DmxBuffer self;
+  for (unsigned int i = 0; i < count; i++) {
+    if (sources[i] == this) {
+      self = *this;
+      break;
+    }
+  }
+
+  // The merge overwrites all of the data, so if it's shared there's no need to
+  // copy it, just drop our reference and start with a new block. If we're a
+  // source, self keeps the old data alive until the merge is done.
+  if (m_copy_on_write) {
+    if (*m_ref_count > 1)
+      CleanupMemory();
+    m_copy_on_write = false;
+  }
+  if (!m_data) {
+    if (!Init())
+      return false;
+  }
+
+  const uint8_t *batch_data[MERGE_BATCH_SIZE];
+  unsigned int batch_lengths[MERGE_BATCH_SIZE];
+  unsigned int batch_size = 0;
+  unsigned int length = 0;
+
+  for (unsigned int i = 0; i < count; i++) {
+    const DmxBuffer *source = sources[i] == this ? &self : sources[i];
+    if (!source->m_data || !source->m_length)
+      continue;
+
+    if (batch_size == MERGE_BATCH_SIZE) {
+      length = ola::dmx::MaxSlotsMany(m_data, batch_data, batch_lengths,
+                                      batch_size);
+      // carry the result so far into the next batch
+      batch_data[0] = m_data;
+      batch_lengths[0] = length;
+      batch_size = 1;
+    }
+    batch_data[batch_size] = source->m_data;
+    batch_lengths[batch_size] = source->m_length;
+    batch_size++;
+  }
+
+  m_length = ola::dmx::MaxSlotsMany(m_data, batch_data, batch_lengths,
+                                    batch_size);
+  return true;
+}
+
+
 bool DmxBuffer::Set(const uint8_t *data, unsigned int length) {
   if (!data)
     return false;
@@ -21,13 +21,17 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <string.h>
 #include <string>
+#include <vector>
 
 #include "ola/Constants.h"
 #include "ola/DmxBuffer.h"
+#include "ola/base/Array.h"
 #include "ola/testing/TestUtils.h"
 
 using std::ostringstream;
 using std::string;
+using std::vector;
+using ola::DMX_UNIVERSE_SIZE;
 using ola::DmxBuffer;
 
 class DmxBufferTest: public CppUnit::TestFixture {
@@ -38,6 +42,7 @@ class DmxBufferTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testAssign);
   CPPUNIT_TEST(testCopy);
   CPPUNIT_TEST(testMerge);
+  CPPUNIT_TEST(testMergeMany);
   CPPUNIT_TEST(testStringToDmx);
   CPPUNIT_TEST(testCopyOnWrite);
   CPPUNIT_TEST(testSetRange);
@@ -53,6 +58,7 @@ class DmxBufferTest: public CppUnit::TestFixture {
     void testStringGetSet();
     void testCopy();
     void testMerge();
+    void testMergeMany();
     void testStringToDmx();
     void testCopyOnWrite();
     void testSetRange();
@@ -286,6 +292,68 @@ void DmxBufferTest::testMerge() {
 }
 
 
+/*
+ * Check that HTPMergeMany works
+ */
+void DmxBufferTest::testMergeMany() {
+  DmxBuffer buffer1(TEST_DATA, sizeof(TEST_DATA));
+  DmxBuffer buffer2(TEST_DATA3, sizeof(TEST_DATA3));
+  DmxBuffer merge_result(MERGE_RESULT, sizeof(MERGE_RESULT));
+  DmxBuffer uninitialized_buffer;
+  DmxBuffer result;
+
+  // no sources
+  OLA_ASSERT_TRUE(result.HTPMergeMany(NULL, 0));
+  OLA_ASSERT_EQ(0u, result.Size());
+
+  const DmxBuffer *sources[] = {&buffer1, &uninitialized_buffer, &buffer2};
+  OLA_ASSERT_TRUE(result.HTPMergeMany(sources, arraysize(sources)));
+  OLA_ASSERT_DMX_EQUALS(merge_result, result);
+
+  // merging into a buffer which shares data with another leaves the other one
+  // alone
+  DmxBuffer shared(buffer2);
+  OLA_ASSERT_TRUE(shared.HTPMergeMany(sources, arraysize(sources)));
+  OLA_ASSERT_DMX_EQUALS(merge_result, shared);
+  OLA_ASSERT_DATA_EQUALS(TEST_DATA3, sizeof(TEST_DATA3), buffer2.GetRaw(),
+                         buffer2.Size());
+
+  // merge into one of the sources
+  const DmxBuffer test_buffer1(buffer1);
+  OLA_ASSERT_TRUE(buffer2.HTPMergeMany(sources, arraysize(sources)));
+  OLA_ASSERT_DMX_EQUALS(merge_result, buffer2);
+  OLA_ASSERT_DMX_EQUALS(test_buffer1, buffer1);
+
+  // merge into a source which shares data with another buffer
+  DmxBuffer buffer3(TEST_DATA3, sizeof(TEST_DATA3));
+  DmxBuffer shared_source(buffer3);
+  const DmxBuffer *shared_sources[] = {&buffer1, &shared_source};
+  OLA_ASSERT_TRUE(shared_source.HTPMergeMany(shared_sources,
+                                             arraysize(shared_sources)));
+  OLA_ASSERT_DMX_EQUALS(merge_result, shared_source);
+  OLA_ASSERT_DATA_EQUALS(TEST_DATA3, sizeof(TEST_DATA3), buffer3.GetRaw(),
+                         buffer3.Size());
+
+  // more sources than are merged in one pass
+  vector<DmxBuffer> buffers;
+  uint8_t data[DMX_UNIVERSE_SIZE];
+  uint8_t expected[DMX_UNIVERSE_SIZE];
+  memset(data, 0, sizeof(data));
+  for (unsigned int i = 0; i < 100; i++) {
+    data[i] = i + 1;
+    buffers.push_back(DmxBuffer(data, i + 1));
+    data[i] = 0;
+    expected[i] = i + 1;
+  }
+  vector<const DmxBuffer*> many_sources;
+  for (unsigned int i = 0; i < buffers.size(); i++) {
+    many_sources.push_back(&buffers[i]);
+  }
+  OLA_ASSERT_TRUE(result.HTPMergeMany(&many_sources[0], many_sources.size()));
+  OLA_ASSERT_DATA_EQUALS(expected, 100, result.GetRaw(), result.Size());
+}
+
+
 /*
  * Run the StringToDmxTest
  * @param input the string to parse
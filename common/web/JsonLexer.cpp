@@ -441,5 +441,10 @@ bool JsonLexer::Parse(const string &input,
   delete[] input_data;
   return result;
 }
+
+bool JsonLexer::ParseNumber(const char *input,
+                            JsonParserInterface *parser) {
+  return ola::web::ParseNumber(&input, parser) && *input == 0;
+}
 }  // namespace web
 }  // namespace ola
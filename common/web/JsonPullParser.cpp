@@ -0,0 +1,589 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * JsonPullParser.cpp
+ * An incremental JSON tokenizer.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include "ola/web/JsonPullParser.h"
+
+#include <stdint.h>
+#include <string>
+#include "ola/web/JsonLexer.h"
+
+namespace ola {
+namespace web {
+
+using std::string;
+
+namespace {
+
+bool IsWhitespace(char c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+
+bool IsNumberCharacter(char c) {
+  return IsDigit(c) || c == '-' || c == '+' || c == '.' || c == 'e' ||
+         c == 'E';
+}
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  } else if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  } else if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+  return -1;
+}
+
+/*
+ * Check a number matches -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+ */
+bool IsValidNumber(const char *input, size_t length) {
+  const char *end = input + length;
+  if (input != end && *input == '-') {
+    input++;
+  }
+
+  if (input == end) {
+    return false;
+  } else if (*input == '0') {
+    input++;
+  } else if (IsDigit(*input)) {
+    while (input != end && IsDigit(*input)) {
+      input++;
+    }
+  } else {
+    return false;
+  }
+
+  if (input != end && *input == '.') {
+    input++;
+    if (input == end || !IsDigit(*input)) {
+      return false;
+    }
+    while (input != end && IsDigit(*input)) {
+      input++;
+    }
+  }
+
+  if (input != end && (*input == 'e' || *input == 'E')) {
+    input++;
+    if (input != end && (*input == '+' || *input == '-')) {
+      input++;
+    }
+    if (input == end || !IsDigit(*input)) {
+      return false;
+    }
+    while (input != end && IsDigit(*input)) {
+      input++;
+    }
+  }
+  return input == end;
+}
+
+void AppendUTF8(uint32_t code_point, string *output) {
+  if (code_point < 0x80) {
+    output->push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800) {
+    output->push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  } else if (code_point < 0x10000) {
+    output->push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  } else {
+    output->push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  }
+}
+}  // namespace
+
+JsonPullParser::JsonPullParser()
+    : m_input(NULL),
+      m_input_end(NULL) {
+  Reset();
+}
+
+void JsonPullParser::Feed(const char *data, size_t length) {
+  m_input = data;
+  m_input_end = data + length;
+  m_string_start = data;
+}
+
+void JsonPullParser::Reset() {
+  m_input = m_input_end;
+  m_finished = false;
+  m_started = false;
+  m_state = EXPECT_VALUE;
+  m_containers.clear();
+  m_error.clear();
+  m_partial = PARTIAL_NONE;
+  m_string_start = m_input;
+  m_is_key = false;
+  m_copy_string = false;
+  m_escape_length = 0;
+  m_code_unit = 0;
+  m_high_surrogate = 0;
+  m_literal = NULL;
+  m_literal_offset = 0;
+  m_literal_token = TOKEN_NULL;
+  m_scratch.clear();
+  m_value = NULL;
+  m_value_length = 0;
+  m_bool_value = false;
+  m_pushed_begin = false;
+  m_pushed_end = false;
+}
+
+JsonPullParser::TokenType JsonPullParser::Next() {
+  if (m_state == FAILED) {
+    return TOKEN_ERROR;
+  } else if (m_state == DONE) {
+    return TOKEN_END;
+  }
+
+  switch (m_partial) {
+    case PARTIAL_STRING:
+      return ContinueString();
+    case PARTIAL_NUMBER:
+      return ContinueNumber();
+    case PARTIAL_LITERAL:
+      return ContinueLiteral();
+    default:
+      {}
+  }
+
+  while (true) {
+    while (m_input != m_input_end && IsWhitespace(*m_input)) {
+      m_input++;
+    }
+
+    if (m_input == m_input_end) {
+      if (!m_finished) {
+        return TOKEN_NEED_DATA;
+      } else if (m_state == EXPECT_NOTHING) {
+        m_state = DONE;
+        return TOKEN_END;
+      }
+      return SetError(m_started ? "Unexpected end of input" :
+                      "No JSON data found");
+    }
+
+    const char c = *m_input;
+    switch (m_state) {
+      case EXPECT_VALUE_OR_CLOSE:
+        if (c == ']') {
+          m_input++;
+          m_containers.pop_back();
+          return ValueComplete(TOKEN_CLOSE_ARRAY);
+        }
+        return StartValue(c);
+      case EXPECT_VALUE:
+        return StartValue(c);
+      case EXPECT_KEY_OR_CLOSE:
+        if (c == '}') {
+          m_input++;
+          m_containers.pop_back();
+          return ValueComplete(TOKEN_CLOSE_OBJECT);
+        }
+        // fall through
+        OLA_FALLTHROUGH
+      case EXPECT_KEY:
+        if (c != '"') {
+          return SetError("Expected key for object");
+        }
+        m_input++;
+        m_partial = PARTIAL_STRING;
+        m_is_key = true;
+        m_copy_string = false;
+        m_string_start = m_input;
+        m_scratch.clear();
+        return ContinueString();
+      case EXPECT_COLON:
+        if (c != ':') {
+          return SetError("Incorrect character after key, should be :");
+        }
+        m_input++;
+        m_state = EXPECT_VALUE;
+        break;
+      case EXPECT_SEPARATOR:
+        if (m_containers.back() == '{') {
+          if (c == '}') {
+            m_input++;
+            m_containers.pop_back();
+            return ValueComplete(TOKEN_CLOSE_OBJECT);
+          } else if (c != ',') {
+            return SetError("Expected either , or } after an object value");
+          }
+          m_state = EXPECT_KEY;
+        } else {
+          if (c == ']') {
+            m_input++;
+            m_containers.pop_back();
+            return ValueComplete(TOKEN_CLOSE_ARRAY);
+          } else if (c != ',') {
+            return SetError("Expected either , or ] after an array element");
+          }
+          m_state = EXPECT_VALUE;
+        }
+        m_input++;
+        break;
+      case EXPECT_NOTHING:
+        return SetError("Extra data after the JSON value");
+      default:
+        return SetError("Invalid parser state");
+    }
+  }
+}
+
+JsonPullParser::TokenType JsonPullParser::PushTokens(
+    JsonParserInterface *handler) {
+  while (true) {
+    TokenType token = Next();
+    if (token > TOKEN_ERROR && !m_pushed_begin) {
+      handler->Begin();
+      m_pushed_begin = true;
+    }
+
+    switch (token) {
+      case TOKEN_NEED_DATA:
+        return token;
+      case TOKEN_END:
+        if (!m_pushed_end) {
+          handler->End();
+          m_pushed_end = true;
+        }
+        return token;
+      case TOKEN_ERROR:
+        handler->SetError(m_error);
+        return token;
+      case TOKEN_OPEN_OBJECT:
+        handler->OpenObject();
+        break;
+      case TOKEN_CLOSE_OBJECT:
+        handler->CloseObject();
+        break;
+      case TOKEN_OPEN_ARRAY:
+        handler->OpenArray();
+        break;
+      case TOKEN_CLOSE_ARRAY:
+        handler->CloseArray();
+        break;
+      case TOKEN_KEY:
+        handler->ObjectKey(ValueInScratch());
+        break;
+      case TOKEN_STRING:
+        handler->String(ValueInScratch());
+        break;
+      case TOKEN_NUMBER:
+        // The syntax has already been checked.
+        JsonLexer::ParseNumber(ValueInScratch().c_str(), handler);
+        break;
+      case TOKEN_BOOL:
+        handler->Bool(m_bool_value);
+        break;
+      case TOKEN_NULL:
+        handler->Null();
+        break;
+    }
+  }
+}
+
+JsonPullParser::TokenType JsonPullParser::StartValue(char c) {
+  m_started = true;
+
+  switch (c) {
+    case '{':
+      m_input++;
+      m_containers.push_back('{');
+      m_state = EXPECT_KEY_OR_CLOSE;
+      return TOKEN_OPEN_OBJECT;
+    case '[':
+      m_input++;
+      m_containers.push_back('[');
+      m_state = EXPECT_VALUE_OR_CLOSE;
+      return TOKEN_OPEN_ARRAY;
+    case '"':
+      m_input++;
+      m_partial = PARTIAL_STRING;
+      m_is_key = false;
+      m_copy_string = false;
+      m_string_start = m_input;
+      m_scratch.clear();
+      return ContinueString();
+    case 't':
+      m_literal = "true";
+      m_literal_token = TOKEN_BOOL;
+      m_bool_value = true;
+      break;
+    case 'f':
+      m_literal = "false";
+      m_literal_token = TOKEN_BOOL;
+      m_bool_value = false;
+      break;
+    case 'n':
+      m_literal = "null";
+      m_literal_token = TOKEN_NULL;
+      break;
+    default:
+      if (c == '-' || IsDigit(c)) {
+        m_partial = PARTIAL_NUMBER;
+        m_scratch.clear();
+        return ContinueNumber();
+      }
+      return SetError("Invalid JSON value");
+  }
+  m_partial = PARTIAL_LITERAL;
+  m_literal_offset = 0;
+  return ContinueLiteral();
+}
+
+/*
+ * Strings without escapes are returned as a pointer into the input. Once we
+ * find an escape sequence, or run out of input, we switch to building the
+ * string in m_scratch.
+ */
+JsonPullParser::TokenType JsonPullParser::ContinueString() {
+  while (m_input != m_input_end) {
+    if (m_escape_length) {
+      if (!HandleEscape(*m_input++)) {
+        return SetError("Invalid string escape sequence");
+      }
+      if (!m_escape_length) {
+        m_string_start = m_input;
+      }
+      continue;
+    }
+
+    while (m_input != m_input_end && *m_input != '"' && *m_input != '\\') {
+      m_input++;
+    }
+    if (m_input == m_input_end) {
+      break;
+    }
+
+    if (*m_input == '\\') {
+      AppendPendingString();
+      m_copy_string = true;
+      m_escape_length = 1;
+      m_input++;
+      continue;
+    }
+
+    // The closing quote
+    if (m_copy_string) {
+      AppendPendingString();
+      FlushHighSurrogate();
+      m_value = m_scratch.data();
+      m_value_length = m_scratch.size();
+    } else {
+      m_value = m_string_start;
+      m_value_length = m_input - m_string_start;
+    }
+    m_input++;
+    m_partial = PARTIAL_NONE;
+
+    if (m_is_key) {
+      m_state = EXPECT_COLON;
+      return TOKEN_KEY;
+    }
+    return ValueComplete(TOKEN_STRING);
+  }
+
+  if (m_finished) {
+    return SetError("Unterminated string");
+  }
+
+  // The input is about to be replaced, so save what we have so far.
+  if (!m_escape_length) {
+    AppendPendingString();
+  }
+  m_copy_string = true;
+  return TOKEN_NEED_DATA;
+}
+
+JsonPullParser::TokenType JsonPullParser::ContinueNumber() {
+  const char *start = m_input;
+  while (m_input != m_input_end && IsNumberCharacter(*m_input)) {
+    m_input++;
+  }
+
+  if (m_input == m_input_end && !m_finished) {
+    // The number may continue in the next chunk.
+    m_scratch.append(start, m_input - start);
+    return TOKEN_NEED_DATA;
+  }
+
+  m_partial = PARTIAL_NONE;
+  if (m_scratch.empty()) {
+    m_value = start;
+    m_value_length = m_input - start;
+  } else {
+    m_scratch.append(start, m_input - start);
+    m_value = m_scratch.data();
+    m_value_length = m_scratch.size();
+  }
+
+  if (!IsValidNumber(m_value, m_value_length)) {
+    return SetError("Invalid number");
+  }
+  return ValueComplete(TOKEN_NUMBER);
+}
+
+JsonPullParser::TokenType JsonPullParser::ContinueLiteral() {
+  while (m_literal[m_literal_offset]) {
+    if (m_input == m_input_end) {
+      if (m_finished) {
+        return SetError("Invalid JSON value");
+      }
+      return TOKEN_NEED_DATA;
+    }
+    if (*m_input != m_literal[m_literal_offset]) {
+      return SetError("Invalid JSON value");
+    }
+    m_input++;
+    m_literal_offset++;
+  }
+  m_partial = PARTIAL_NONE;
+  return ValueComplete(m_literal_token);
+}
+
+/*
+ * Handle a character following a \. m_escape_length is 1 for the character
+ * after the \, and counts up to 6 for \uXXXX.
+ */
+bool JsonPullParser::HandleEscape(char c) {
+  if (m_escape_length == 1) {
+    char append_char = 0;
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        append_char = c;
+        break;
+      case 'b':
+        append_char = '\b';
+        break;
+      case 'f':
+        append_char = '\f';
+        break;
+      case 'n':
+        append_char = '\n';
+        break;
+      case 'r':
+        append_char = '\r';
+        break;
+      case 't':
+        append_char = '\t';
+        break;
+      case 'u':
+        m_escape_length++;
+        m_code_unit = 0;
+        return true;
+      default:
+        return false;
+    }
+    FlushHighSurrogate();
+    m_scratch.push_back(append_char);
+    m_escape_length = 0;
+    return true;
+  }
+
+  int value = HexValue(c);
+  if (value < 0) {
+    return false;
+  }
+  m_code_unit = static_cast<uint16_t>((m_code_unit << 4) | value);
+  if (++m_escape_length == 6) {
+    m_escape_length = 0;
+    AppendCodeUnit(m_code_unit);
+  }
+  return true;
+}
+
+/*
+ * Append a UTF-16 code unit from a \u escape as UTF-8. Surrogate pairs are
+ * combined, a lone surrogate is encoded as is.
+ */
+void JsonPullParser::AppendCodeUnit(uint16_t code_unit) {
+  if (m_high_surrogate && code_unit >= 0xdc00 && code_unit <= 0xdfff) {
+    uint32_t code_point = 0x10000 + ((m_high_surrogate - 0xd800) << 10) +
+                          (code_unit - 0xdc00);
+    m_high_surrogate = 0;
+    AppendUTF8(code_point, &m_scratch);
+    return;
+  }
+
+  FlushHighSurrogate();
+  if (code_unit >= 0xd800 && code_unit <= 0xdbff) {
+    m_high_surrogate = code_unit;
+  } else {
+    AppendUTF8(code_unit, &m_scratch);
+  }
+}
+
+void JsonPullParser::FlushHighSurrogate() {
+  if (m_high_surrogate) {
+    AppendUTF8(m_high_surrogate, &m_scratch);
+    m_high_surrogate = 0;
+  }
+}
+
+/*
+ * Copy the string data between m_string_start and m_input to m_scratch.
+ */
+void JsonPullParser::AppendPendingString() {
+  if (m_input != m_string_start) {
+    FlushHighSurrogate();
+    m_scratch.append(m_string_start, m_input - m_string_start);
+  }
+  m_string_start = m_input;
+}
+
+/*
+ * Make sure the value of the current token is in m_scratch. m_scratch isn't
+ * needed again until the next token starts.
+ */
+const string& JsonPullParser::ValueInScratch() {
+  if (m_value != m_scratch.data()) {
+    m_scratch.assign(m_value, m_value_length);
+    m_value = m_scratch.data();
+  }
+  return m_scratch;
+}
+
+JsonPullParser::TokenType JsonPullParser::ValueComplete(TokenType token) {
+  m_state = m_containers.empty() ? EXPECT_NOTHING : EXPECT_SEPARATOR;
+  return token;
+}
+
+JsonPullParser::TokenType JsonPullParser::SetError(const string &error) {
+  m_error = error;
+  m_state = FAILED;
+  m_partial = PARTIAL_NONE;
+  return TOKEN_ERROR;
+}
+}  // namespace web
+}  // namespace ola
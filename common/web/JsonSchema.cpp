@@ -35,7 +35,6 @@
 namespace ola {
 namespace web {
 
-using std::auto_ptr;
 using std::set;
 using std::string;
 using std::vector;
@@ -191,13 +190,31 @@ void ReferenceValidator::SetDescription(const std::string &) {}
 void ReferenceValidator::SetDefaultValue(const JsonValue *) {}
 const JsonValue *ReferenceValidator::GetDefaultValue() const { return NULL; }
 
-template <typename T>
-void ReferenceValidator::Validate(const T &value) {
+bool ReferenceValidator::AcceptsAnyValue() {
+  ValidatorInterface *validator = Resolve();
+  return validator ? validator->AcceptsAnyValue() : false;
+}
+
+const ObjectValidator *ReferenceValidator::StreamingObjectValidator() {
+  ValidatorInterface *validator = Resolve();
+  return validator ? validator->StreamingObjectValidator() : NULL;
+}
+
+const ArrayValidator *ReferenceValidator::StreamingArrayValidator() {
+  ValidatorInterface *validator = Resolve();
+  return validator ? validator->StreamingArrayValidator() : NULL;
+}
+
+ValidatorInterface *ReferenceValidator::Resolve() {
   if (!m_validator) {
     m_validator = m_definitions->Lookup(m_schema);
   }
+  return m_validator;
+}
 
-  if (m_validator) {
+template <typename T>
+void ReferenceValidator::Validate(const T &value) {
+  if (Resolve()) {
     value.Accept(m_validator);
   }
 }
@@ -318,50 +335,15 @@ void ObjectValidator::AddPropertyDependency(const string &property,
 }
 
 void ObjectValidator::Visit(const JsonObject &obj) {
-  m_is_valid = true;
-
-  if (obj.Size() < m_options.min_properties) {
-    m_is_valid = false;
-    return;
-  }
-
-  if (m_options.max_properties > 0 &&
-      obj.Size() > static_cast<size_t>(m_options.max_properties)) {
-    m_is_valid = false;
+  m_is_valid = CheckPropertyCount(obj.Size());
+  if (!m_is_valid) {
     return;
   }
 
   m_seen_properties.clear();
   obj.VisitProperties(this);
 
-  StringSet missing_properties;
-  std::set_difference(m_options.required_properties.begin(),
-                      m_options.required_properties.end(),
-                      m_seen_properties.begin(),
-                      m_seen_properties.end(),
-                      std::inserter(missing_properties,
-                                    missing_properties.end()));
-  if (!missing_properties.empty()) {
-    m_is_valid = false;
-  }
-
-  // Check PropertyDependencies
-  PropertyDependencies::const_iterator prop_iter =
-    m_property_dependencies.begin();
-  for (; prop_iter != m_property_dependencies.end() && m_is_valid;
-       ++prop_iter) {
-    if (!STLContains(m_seen_properties, prop_iter->first)) {
-      continue;
-    }
-
-    StringSet::const_iterator iter = prop_iter->second.begin();
-    for (; iter != prop_iter->second.end(); ++iter) {
-      if (!STLContains(m_seen_properties, *iter)) {
-        m_is_valid = false;
-        break;
-      }
-    }
-  }
+  m_is_valid = m_is_valid && CheckPropertyNames(m_seen_properties);
 
   // Check Schema Dependencies
   SchemaDependencies::const_iterator schema_iter =
@@ -382,6 +364,23 @@ void ObjectValidator::VisitProperty(const std::string &property,
                                     const JsonValue &value) {
   m_seen_properties.insert(property);
 
+  bool allowed = true;
+  ValidatorInterface *validator = PropertyValidator(property, &allowed);
+  if (validator) {
+    value.Accept(validator);
+    m_is_valid &= validator->IsValid();
+  } else if (!allowed) {
+    m_is_valid = false;
+  }
+}
+
+const ObjectValidator *ObjectValidator::StreamingObjectValidator() {
+  // Schema dependencies need the entire object.
+  return m_schema_dependencies.empty() ? this : NULL;
+}
+
+ValidatorInterface *ObjectValidator::PropertyValidator(const string &property,
+                                                       bool *allowed) const {
   // The algorithm is described in section 8.3.3
   ValidatorInterface *validator = STLFindOrNull(
       m_property_validators, property);
@@ -393,16 +392,48 @@ void ObjectValidator::VisitProperty(const std::string &property,
     validator = m_additional_property_validator.get();
   }
 
-  if (validator) {
-    value.Accept(validator);
-    m_is_valid &= validator->IsValid();
-  } else {
-    // No validator found
-    if (m_options.has_allow_additional_properties &&
-        !m_options.allow_additional_properties) {
-      m_is_valid &= false;
+  *allowed = validator || !m_options.has_allow_additional_properties ||
+             m_options.allow_additional_properties;
+  return validator;
+}
+
+bool ObjectValidator::CheckPropertyCount(size_t count) const {
+  if (count < m_options.min_properties) {
+    return false;
+  }
+
+  return !(m_options.max_properties > 0 &&
+           count > static_cast<size_t>(m_options.max_properties));
+}
+
+bool ObjectValidator::CheckPropertyNames(const StringSet &properties) const {
+  StringSet missing_properties;
+  std::set_difference(m_options.required_properties.begin(),
+                      m_options.required_properties.end(),
+                      properties.begin(),
+                      properties.end(),
+                      std::inserter(missing_properties,
+                                    missing_properties.end()));
+  if (!missing_properties.empty()) {
+    return false;
+  }
+
+  // Check PropertyDependencies
+  PropertyDependencies::const_iterator prop_iter =
+    m_property_dependencies.begin();
+  for (; prop_iter != m_property_dependencies.end(); ++prop_iter) {
+    if (!STLContains(properties, prop_iter->first)) {
+      continue;
+    }
+
+    StringSet::const_iterator iter = prop_iter->second.begin();
+    for (; iter != prop_iter->second.end(); ++iter) {
+      if (!STLContains(properties, *iter)) {
+        return false;
+      }
     }
   }
+  return true;
 }
 
 void ObjectValidator::ExtendSchema(JsonObject *schema) const {
@@ -479,30 +510,23 @@ ArrayValidator::~ArrayValidator() {}
 // items = array, additional = bool
 // items = array, additional = schema
 void ArrayValidator::Visit(const JsonArray &array) {
-  if (array.Size() < m_options.min_items) {
-    m_is_valid = false;
-    return;
-  }
-
-  if (m_options.max_items > 0 &&
-      array.Size() > static_cast<size_t>(m_options.max_items)) {
-    m_is_valid = false;
+  m_is_valid = CheckItemCount(array.Size());
+  if (!m_is_valid) {
     return;
   }
 
-
-  auto_ptr<ArrayElementValidator> element_validator(
-      ConstructElementValidator());
-
   for (unsigned int i = 0; i < array.Size(); i++) {
-    array.ElementAt(i)->Accept(element_validator.get());
-    if (!element_validator->IsValid()) {
-      break;
+    ValidatorInterface *validator = ItemValidator(i);
+    if (!validator) {
+      // additional items aren't allowed
+      m_is_valid = false;
+      return;
+    }
+    array.ElementAt(i)->Accept(validator);
+    if (!validator->IsValid()) {
+      m_is_valid = false;
+      return;
     }
-  }
-  m_is_valid = element_validator->IsValid();
-  if (!m_is_valid) {
-    return;
   }
 
   if (m_options.unique_items) {
@@ -517,6 +541,52 @@ void ArrayValidator::Visit(const JsonArray &array) {
   }
 }
 
+const ArrayValidator *ArrayValidator::StreamingArrayValidator() {
+  // Checking for unique items needs the entire array.
+  return m_options.unique_items ? NULL : this;
+}
+
+bool ArrayValidator::CheckItemCount(size_t count) const {
+  if (count < m_options.min_items) {
+    return false;
+  }
+
+  return !(m_options.max_items > 0 &&
+           count > static_cast<size_t>(m_options.max_items));
+}
+
+ValidatorInterface *ArrayValidator::ItemValidator(unsigned int index) const {
+  if (!m_items.get()) {
+    // no items, therefore it defaults to the empty (wildcard) schema.
+    return m_wildcard_validator.get();
+  }
+
+  if (m_items->Validator()) {
+    // 8.2.3.1, items is an object.
+    return m_items->Validator();
+  }
+
+  // 8.2.3.3, items is an array.
+  const ValidatorList &validators = m_items->Validators();
+  if (index < validators.size()) {
+    return validators[index];
+  }
+
+  // Check to see if additionalItems it defined.
+  if (!m_additional_items.get()) {
+    // additionalItems not provided, so it defaults to the empty schema
+    // (wildcard).
+    return m_wildcard_validator.get();
+  } else if (m_additional_items->Validator()) {
+    // additionalItems is an object
+    return m_additional_items->Validator();
+  } else if (m_additional_items->AllowAdditional()) {
+    // additionalItems is a bool, and true
+    return m_wildcard_validator.get();
+  }
+  return NULL;
+}
+
 void ArrayValidator::ExtendSchema(JsonObject *schema) const {
   if (m_options.min_items > 0) {
     schema->Add("minItems", m_options.min_items);
@@ -561,118 +631,6 @@ void ArrayValidator::ExtendSchema(JsonObject *schema) const {
   }
 }
 
-// TODO(simon): do this once at construction, rather than on every visit?
-ArrayValidator::ArrayElementValidator*
-    ArrayValidator::ConstructElementValidator() const {
-  if (m_items.get()) {
-    if (m_items->Validator()) {
-      // 8.2.3.1, items is an object.
-      ValidatorList empty_validators;
-      return new ArrayElementValidator(empty_validators, m_items->Validator());
-    } else {
-      // 8.2.3.3, items is an array.
-      const ValidatorList &validators = m_items->Validators();
-      ValidatorInterface *default_validator = NULL;
-
-      // Check to see if additionalItems it defined.
-      if (m_additional_items.get()) {
-        if (m_additional_items->Validator()) {
-          // additionalItems is an object
-          default_validator = m_additional_items->Validator();
-        } else if (m_additional_items->AllowAdditional()) {
-          // additionalItems is a bool, and true
-          default_validator = m_wildcard_validator.get();
-        }
-      } else {
-        // additionalItems not provided, so it defaults to the empty schema
-        // (wildcard).
-        default_validator = m_wildcard_validator.get();
-      }
-      return new ArrayElementValidator(validators, default_validator);
-    }
-  } else {
-    // no items, therefore it defaults to the empty (wildcard) schema.
-    ValidatorList empty_validators;
-    return new ArrayElementValidator(
-        empty_validators, m_wildcard_validator.get());
-  }
-}
-
-// ArrayValidator::ArrayElementValidator
-// -----------------------------------------------------------------------------
-ArrayValidator::ArrayElementValidator::ArrayElementValidator(
-    const ValidatorList &validators,
-    ValidatorInterface *default_validator)
-    : BaseValidator(JSON_UNDEFINED),
-      m_item_validators(validators.begin(), validators.end()),
-      m_default_validator(default_validator) {
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(
-    const JsonString &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(const JsonBool &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(const JsonNull &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(const JsonRawValue &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(const JsonObject &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(const JsonArray &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(const JsonUInt &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(
-    const JsonUInt64 &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(const JsonInt &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(const JsonInt64 &value) {
-  ValidateItem(value);
-}
-
-void ArrayValidator::ArrayElementValidator::Visit(
-    const JsonDouble &value) {
-  ValidateItem(value);
-}
-
-template <typename T>
-void ArrayValidator::ArrayElementValidator::ValidateItem(const T &item) {
-  ValidatorInterface *validator = NULL;
-
-  if (!m_item_validators.empty()) {
-    validator = m_item_validators.front();
-    m_item_validators.pop_front();
-  } else if (!m_default_validator) {
-    // additional items aren't allowed
-    m_is_valid = false;
-    return;
-  } else {
-    validator = m_default_validator;
-  }
-  item.Accept(validator);
-  m_is_valid = validator->IsValid();
-}
-
 // ConjunctionValidator
 // -----------------------------------------------------------------------------
 ConjunctionValidator::ConjunctionValidator(const string &keyword,
@@ -0,0 +1,349 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * JsonStreamValidator.cpp
+ * Validate JSON tokens against a schema.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include "ola/web/JsonStreamValidator.h"
+
+#include <string>
+#include "ola/web/Json.h"
+#include "ola/web/JsonSchema.h"
+
+namespace ola {
+namespace web {
+
+using std::string;
+
+JsonStreamValidator::JsonStreamValidator(ValidatorInterface *validator)
+    : m_root_validator(validator),
+      m_is_valid(false),
+      m_complete(false),
+      m_nested_depth(0),
+      m_nested_validator(NULL) {
+}
+
+void JsonStreamValidator::Begin() {
+  m_is_valid = true;
+  m_complete = false;
+  m_error.clear();
+  m_frames.clear();
+  m_nested_depth = 0;
+  m_nested_validator = NULL;
+}
+
+void JsonStreamValidator::End() {
+  m_complete = true;
+}
+
+void JsonStreamValidator::String(const string &value) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->String(value);
+    }
+    return;
+  }
+  JsonString json_value(value);
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::Number(uint32_t value) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->Number(value);
+    }
+    return;
+  }
+  JsonUInt json_value(value);
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::Number(int32_t value) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->Number(value);
+    }
+    return;
+  }
+  JsonInt json_value(value);
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::Number(uint64_t value) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->Number(value);
+    }
+    return;
+  }
+  JsonUInt64 json_value(value);
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::Number(int64_t value) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->Number(value);
+    }
+    return;
+  }
+  JsonInt64 json_value(value);
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::Number(
+    const JsonDouble::DoubleRepresentation &rep) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->Number(rep);
+    }
+    return;
+  }
+  JsonDouble json_value(rep);
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::Number(double value) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->Number(value);
+    }
+    return;
+  }
+  JsonDouble json_value(value);
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::Bool(bool value) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->Bool(value);
+    }
+    return;
+  }
+  JsonBool json_value(value);
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::Null() {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->Null();
+    }
+    return;
+  }
+  JsonNull json_value;
+  ValidateValue(json_value);
+}
+
+void JsonStreamValidator::OpenArray() {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    m_nested_depth++;
+    if (m_nested_validator) {
+      m_builder->OpenArray();
+    }
+    return;
+  }
+
+  bool allowed = true;
+  ValidatorInterface *validator = NextValidator(&allowed);
+  if (!allowed) {
+    m_is_valid = false;
+    return;
+  }
+
+  const ArrayValidator *array_validator = validator ?
+      validator->StreamingArrayValidator() : NULL;
+  if (array_validator) {
+    m_frames.push_back(Frame());
+    m_frames.back().array_validator = array_validator;
+  } else if (StartNested(validator)) {
+    m_builder->OpenArray();
+  }
+}
+
+void JsonStreamValidator::CloseArray() {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->CloseArray();
+    }
+    if (--m_nested_depth == 0) {
+      EndNested();
+    }
+    return;
+  }
+
+  const Frame &frame = m_frames.back();
+  m_is_valid = frame.array_validator->CheckItemCount(frame.item_count);
+  m_frames.pop_back();
+}
+
+void JsonStreamValidator::OpenObject() {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    m_nested_depth++;
+    if (m_nested_validator) {
+      m_builder->OpenObject();
+    }
+    return;
+  }
+
+  bool allowed = true;
+  ValidatorInterface *validator = NextValidator(&allowed);
+  if (!allowed) {
+    m_is_valid = false;
+    return;
+  }
+
+  const ObjectValidator *object_validator = validator ?
+      validator->StreamingObjectValidator() : NULL;
+  if (object_validator) {
+    m_frames.push_back(Frame());
+    m_frames.back().object_validator = object_validator;
+  } else if (StartNested(validator)) {
+    m_builder->OpenObject();
+  }
+}
+
+void JsonStreamValidator::ObjectKey(const string &key) {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->ObjectKey(key);
+    }
+    return;
+  }
+
+  Frame &frame = m_frames.back();
+  frame.properties.insert(key);
+
+  bool allowed = true;
+  frame.value_validator = frame.object_validator->PropertyValidator(
+      key, &allowed);
+  m_is_valid = allowed;
+}
+
+void JsonStreamValidator::CloseObject() {
+  if (!m_is_valid) {
+    return;
+  } else if (m_nested_depth) {
+    if (m_nested_validator) {
+      m_builder->CloseObject();
+    }
+    if (--m_nested_depth == 0) {
+      EndNested();
+    }
+    return;
+  }
+
+  const Frame &frame = m_frames.back();
+  m_is_valid = (
+      frame.object_validator->CheckPropertyCount(frame.properties.size()) &&
+      frame.object_validator->CheckPropertyNames(frame.properties));
+  m_frames.pop_back();
+}
+
+void JsonStreamValidator::SetError(const string &error) {
+  m_error = error;
+  m_is_valid = false;
+}
+
+/*
+ * Return the validator for the next value. A NULL validator with allowed set
+ * to true means the value can be anything.
+ */
+ValidatorInterface *JsonStreamValidator::NextValidator(bool *allowed) {
+  *allowed = true;
+  if (m_frames.empty()) {
+    return m_root_validator;
+  }
+
+  Frame &frame = m_frames.back();
+  if (frame.object_validator) {
+    return frame.value_validator;
+  }
+
+  ValidatorInterface *validator = frame.array_validator->ItemValidator(
+      frame.item_count++);
+  *allowed = validator != NULL;
+  return validator;
+}
+
+void JsonStreamValidator::ValidateValue(const JsonValue &value) {
+  bool allowed = true;
+  ValidatorInterface *validator = NextValidator(&allowed);
+  if (!allowed) {
+    m_is_valid = false;
+  } else if (validator) {
+    value.Accept(validator);
+    m_is_valid = validator->IsValid();
+  }
+}
+
+/*
+ * Start a value that can't be validated one token at a time.
+ * @returns true if the value needs to be built.
+ */
+bool JsonStreamValidator::StartNested(ValidatorInterface *validator) {
+  m_nested_depth = 1;
+  if (!validator || validator->AcceptsAnyValue()) {
+    m_nested_validator = NULL;
+    return false;
+  }
+
+  m_nested_validator = validator;
+  if (!m_builder.get()) {
+    m_builder.reset(new JsonParser());
+  }
+  m_builder->Begin();
+  return true;
+}
+
+void JsonStreamValidator::EndNested() {
+  if (m_nested_validator) {
+    m_builder->End();
+    m_builder->GetRoot()->Accept(m_nested_validator);
+    m_is_valid = m_nested_validator->IsValid();
+    m_nested_validator = NULL;
+  }
+}
+}  // namespace web
+}  // namespace ola
@@ -0,0 +1,293 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * JsonStreamWriter.cpp
+ * Write JSON text without building a tree of JsonValues.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <ctype.h>
+#include <inttypes.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+#include <algorithm>
+#include <string>
+#include "ola/web/Json.h"
+#include "ola/web/JsonStreamWriter.h"
+
+namespace ola {
+namespace web {
+
+using std::string;
+
+namespace {
+
+/*
+ * Writes a tree of JsonValues to a JsonStreamWriter.
+ */
+class ValueWriter : public JsonValueConstVisitorInterface,
+                           JsonObjectPropertyVisitor {
+ public:
+  explicit ValueWriter(JsonStreamWriter *writer) : m_writer(writer) {}
+
+  void Visit(const JsonString &value) { m_writer->Append(value.Value()); }
+  void Visit(const JsonBool &value) { m_writer->Append(value.Value()); }
+  void Visit(const JsonNull &) { m_writer->Append(); }
+  void Visit(const JsonRawValue &value) { m_writer->AppendRaw(value.Value()); }
+  void Visit(const JsonUInt &value) { m_writer->Append(value.Value()); }
+  void Visit(const JsonUInt64 &value) { m_writer->Append(value.Value()); }
+  void Visit(const JsonInt &value) { m_writer->Append(value.Value()); }
+  void Visit(const JsonInt64 &value) { m_writer->Append(value.Value()); }
+
+  void Visit(const JsonDouble &value) {
+    // Keep the original representation, as the JsonWriter does.
+    m_writer->AppendRaw(value.ToString());
+  }
+
+  void Visit(const JsonObject &value) {
+    m_writer->StartObject();
+    value.VisitProperties(this);
+    m_writer->EndObject();
+  }
+
+  void Visit(const JsonArray &value) {
+    m_writer->StartArray();
+    for (unsigned int i = 0; i < value.Size(); i++) {
+      value.ElementAt(i)->Accept(this);
+    }
+    m_writer->EndArray();
+  }
+
+  void VisitProperty(const string &property, const JsonValue &value) {
+    m_writer->Key(property);
+    value.Accept(this);
+  }
+
+ private:
+  JsonStreamWriter *m_writer;
+};
+}  // namespace
+
+void JsonStreamWriter::StartObject() {
+  StartValue();
+  m_output->push_back('{');
+  m_need_separator = false;
+}
+
+void JsonStreamWriter::StartObject(const string &key) {
+  Key(key);
+  StartObject();
+}
+
+void JsonStreamWriter::EndObject() {
+  m_output->push_back('}');
+  m_need_separator = true;
+}
+
+void JsonStreamWriter::StartArray() {
+  StartValue();
+  m_output->push_back('[');
+  m_need_separator = false;
+}
+
+void JsonStreamWriter::StartArray(const string &key) {
+  Key(key);
+  StartArray();
+}
+
+void JsonStreamWriter::EndArray() {
+  m_output->push_back(']');
+  m_need_separator = true;
+}
+
+void JsonStreamWriter::Key(const string &key) {
+  StartValue();
+  AppendString(key, false);
+  m_output->push_back(':');
+  m_need_separator = false;
+}
+
+void JsonStreamWriter::Add(const string &key, const string &value) {
+  Key(key);
+  Append(value);
+}
+
+void JsonStreamWriter::Add(const string &key, const char *value) {
+  Key(key);
+  Append(value);
+}
+
+void JsonStreamWriter::Add(const string &key, unsigned int i) {
+  Key(key);
+  Append(i);
+}
+
+void JsonStreamWriter::Add(const string &key, int i) {
+  Key(key);
+  Append(i);
+}
+
+void JsonStreamWriter::Add(const string &key, uint64_t i) {
+  Key(key);
+  Append(i);
+}
+
+void JsonStreamWriter::Add(const string &key, int64_t i) {
+  Key(key);
+  Append(i);
+}
+
+void JsonStreamWriter::Add(const string &key, double d) {
+  Key(key);
+  Append(d);
+}
+
+void JsonStreamWriter::Add(const string &key, bool value) {
+  Key(key);
+  Append(value);
+}
+
+void JsonStreamWriter::Add(const string &key) {
+  Key(key);
+  Append();
+}
+
+void JsonStreamWriter::AddRaw(const string &key, const string &value) {
+  Key(key);
+  AppendRaw(value);
+}
+
+void JsonStreamWriter::Append(const string &value) {
+  StartValue();
+  AppendString(value, true);
+  m_need_separator = true;
+}
+
+void JsonStreamWriter::Append(const char *value) {
+  Append(string(value));
+}
+
+void JsonStreamWriter::Append(unsigned int i) {
+  AppendNumber("%u", i);
+}
+
+void JsonStreamWriter::Append(int i) {
+  AppendNumber("%d", i);
+}
+
+void JsonStreamWriter::Append(uint64_t i) {
+  AppendNumber("%" PRIu64, i);
+}
+
+void JsonStreamWriter::Append(int64_t i) {
+  AppendNumber("%" PRId64, i);
+}
+
+void JsonStreamWriter::Append(double d) {
+  // This matches the default formatting of an ostream, which JsonDouble uses.
+  AppendNumber("%g", d);
+}
+
+void JsonStreamWriter::Append(bool value) {
+  AppendRaw(value ? "true" : "false");
+}
+
+void JsonStreamWriter::Append() {
+  AppendRaw("null");
+}
+
+void JsonStreamWriter::AppendRaw(const string &value) {
+  StartValue();
+  m_output->append(value);
+  m_need_separator = true;
+}
+
+void JsonStreamWriter::Append(const JsonValue &value) {
+  ValueWriter writer(this);
+  value.Accept(&writer);
+}
+
+void JsonStreamWriter::StartValue() {
+  if (m_need_separator) {
+    m_output->push_back(',');
+  }
+}
+
+/*
+ * Values are escaped in the same way as the JsonWriter: unprintable characters
+ * are hex encoded (see EncodeString()) and then the result is escaped (see
+ * Escape()). Keys are only escaped.
+ */
+void JsonStreamWriter::AppendString(const string &value, bool encode) {
+  static const char HEX[] = "0123456789abcdef";
+
+  m_output->push_back('"');
+  string::const_iterator iter = value.begin();
+  for (; iter != value.end(); ++iter) {
+    const char c = *iter;
+    if (encode && !isprint(static_cast<unsigned char>(c))) {
+      const uint8_t byte = static_cast<uint8_t>(c);
+      m_output->append("\\\\x");
+      m_output->push_back(HEX[byte >> 4]);
+      m_output->push_back(HEX[byte & 0x0f]);
+      continue;
+    }
+
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        m_output->push_back('\\');
+        m_output->push_back(c);
+        break;
+      case '\b':
+        m_output->append("\\b");
+        break;
+      case '\f':
+        m_output->append("\\f");
+        break;
+      case '\n':
+        m_output->append("\\n");
+        break;
+      case '\r':
+        m_output->append("\\r");
+        break;
+      case '\t':
+        m_output->append("\\t");
+        break;
+      default:
+        m_output->push_back(c);
+    }
+  }
+  m_output->push_back('"');
+}
+
+void JsonStreamWriter::AppendNumber(const char *format, ...) {
+  char buffer[32];
+  va_list args;
+  va_start(args, format);
+  int length = vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+
+  StartValue();
+  if (length > 0) {
+    m_output->append(buffer, std::min(static_cast<size_t>(length),
+                                      sizeof(buffer) - 1));
+  }
+  m_need_separator = true;
+}
+}  // namespace web
+}  // namespace ola
@@ -24,8 +24,11 @@ common_web_libolaweb_la_SOURCES = \
     common/web/JsonPatch.cpp \
     common/web/JsonPatchParser.cpp \
     common/web/JsonPointer.cpp \
+    common/web/JsonPullParser.cpp \
     common/web/JsonSchema.cpp \
     common/web/JsonSections.cpp \
+    common/web/JsonStreamValidator.cpp \
+    common/web/JsonStreamWriter.cpp \
     common/web/JsonTypes.cpp \
     common/web/JsonWriter.cpp \
     common/web/PointerTracker.cpp \
@@ -54,9 +57,11 @@ test_programs += \
     common/web/PtchTester \
     common/web/PointerTester \
     common/web/PointerTrackerTester \
+    common/web/PullParserTester \
     common/web/SchemaParserTester \
     common/web/SchemaTester \
-    common/web/SectionsTester
+    common/web/SectionsTester \
+    common/web/StreamWriterTester
 
 COMMON_WEB_TEST_LDADD = $(COMMON_TESTING_LIBS) \
                         common/web/libolaweb.la
@@ -85,6 +90,10 @@ common_web_PointerTrackerTester_SOURCES = common/web/PointerTrackerTest.cpp
 common_web_PointerTrackerTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_web_PointerTrackerTester_LDADD = $(COMMON_WEB_TEST_LDADD)
 
+common_web_PullParserTester_SOURCES = common/web/PullParserTest.cpp
+common_web_PullParserTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+common_web_PullParserTester_LDADD = $(COMMON_WEB_TEST_LDADD)
+
 common_web_SchemaParserTester_SOURCES = common/web/SchemaParserTest.cpp
 common_web_SchemaParserTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_web_SchemaParserTester_LDADD = $(COMMON_WEB_TEST_LDADD)
@@ -96,3 +105,7 @@ common_web_SchemaTester_LDADD = $(COMMON_WEB_TEST_LDADD)
 common_web_SectionsTester_SOURCES = common/web/SectionsTest.cpp
 common_web_SectionsTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 common_web_SectionsTester_LDADD = $(COMMON_WEB_TEST_LDADD)
+
+common_web_StreamWriterTester_SOURCES = common/web/StreamWriterTest.cpp
+common_web_StreamWriterTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+common_web_StreamWriterTester_LDADD = $(COMMON_WEB_TEST_LDADD)
@@ -0,0 +1,359 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * PullParserTest.cpp
+ * Unittest for the JsonPullParser.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include "ola/testing/TestUtils.h"
+#include "ola/web/Json.h"
+#include "ola/web/JsonParser.h"
+#include "ola/web/JsonPullParser.h"
+#include "ola/web/JsonWriter.h"
+
+using ola::web::JsonParser;
+using ola::web::JsonPullParser;
+using ola::web::JsonValue;
+using ola::web::JsonWriter;
+using std::auto_ptr;
+using std::string;
+
+class JsonPullParserTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(JsonPullParserTest);
+  CPPUNIT_TEST(testTokens);
+  CPPUNIT_TEST(testZeroCopy);
+  CPPUNIT_TEST(testChunkedInput);
+  CPPUNIT_TEST(testEscapes);
+  CPPUNIT_TEST(testNumbers);
+  CPPUNIT_TEST(testInvalidInput);
+  CPPUNIT_TEST(testPushTokens);
+  CPPUNIT_TEST(testReset);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void testTokens();
+  void testZeroCopy();
+  void testChunkedInput();
+  void testEscapes();
+  void testNumbers();
+  void testInvalidInput();
+  void testPushTokens();
+  void testReset();
+
+ private:
+  string Tokenize(const string &input, unsigned int chunk_size = 0);
+  string ParseError(const string &input);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(JsonPullParserTest);
+
+/*
+ * Convert the input into a string of tokens. If chunk_size is non-0 the input
+ * is fed in chunks of that size.
+ */
+string JsonPullParserTest::Tokenize(const string &input,
+                                    unsigned int chunk_size) {
+  JsonPullParser parser;
+  string output;
+  string::size_type offset = 0;
+
+  if (!chunk_size) {
+    parser.Feed(input);
+    parser.Finish();
+    offset = input.size();
+  }
+
+  while (true) {
+    JsonPullParser::TokenType token = parser.Next();
+    switch (token) {
+      case JsonPullParser::TOKEN_NEED_DATA:
+        if (offset < input.size()) {
+          unsigned int size = std::min(
+              static_cast<string::size_type>(chunk_size),
+              input.size() - offset);
+          parser.Feed(input.data() + offset, size);
+          offset += size;
+        } else {
+          parser.Finish();
+        }
+        continue;
+      case JsonPullParser::TOKEN_END:
+        return output;
+      case JsonPullParser::TOKEN_ERROR:
+        return output + "error";
+      case JsonPullParser::TOKEN_OPEN_OBJECT:
+        output.append("{ ");
+        break;
+      case JsonPullParser::TOKEN_CLOSE_OBJECT:
+        output.append("} ");
+        break;
+      case JsonPullParser::TOKEN_OPEN_ARRAY:
+        output.append("[ ");
+        break;
+      case JsonPullParser::TOKEN_CLOSE_ARRAY:
+        output.append("] ");
+        break;
+      case JsonPullParser::TOKEN_KEY:
+        output.append("k:" + parser.ValueAsString() + " ");
+        break;
+      case JsonPullParser::TOKEN_STRING:
+        output.append("s:" + parser.ValueAsString() + " ");
+        break;
+      case JsonPullParser::TOKEN_NUMBER:
+        output.append("n:" + parser.ValueAsString() + " ");
+        break;
+      case JsonPullParser::TOKEN_BOOL:
+        output.append(parser.BoolValue() ? "true " : "false ");
+        break;
+      case JsonPullParser::TOKEN_NULL:
+        output.append("null ");
+        break;
+    }
+  }
+}
+
+string JsonPullParserTest::ParseError(const string &input) {
+  JsonPullParser parser;
+  parser.Feed(input);
+  parser.Finish();
+  JsonPullParser::TokenType token;
+  while ((token = parser.Next()) > JsonPullParser::TOKEN_ERROR) {}
+  if (token != JsonPullParser::TOKEN_ERROR) {
+    return "";
+  }
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_ERROR, parser.Next());
+  return parser.Error();
+}
+
+/*
+ * Check the tokens for a document.
+ */
+void JsonPullParserTest::testTokens() {
+  OLA_ASSERT_EQ(string("s:foo "), Tokenize("\"foo\""));
+  OLA_ASSERT_EQ(string("n:12 "), Tokenize(" 12 "));
+  OLA_ASSERT_EQ(string("true "), Tokenize("true"));
+  OLA_ASSERT_EQ(string("false "), Tokenize("false"));
+  OLA_ASSERT_EQ(string("null "), Tokenize("null"));
+  OLA_ASSERT_EQ(string("[ ] "), Tokenize("[]"));
+  OLA_ASSERT_EQ(string("{ } "), Tokenize("{ }"));
+
+  const string input = (
+      "{\"name\": \"foo\", \"ports\": [1, -2, 3.5e2, true, null, {}],"
+      " \"empty\": [], \"nested\": {\"a\": [[]]}}");
+  OLA_ASSERT_EQ(
+      string("{ k:name s:foo k:ports [ n:1 n:-2 n:3.5e2 true null { } ] "
+             "k:empty [ ] k:nested { k:a [ [ ] ] } } "),
+      Tokenize(input));
+
+  // Check the depth as we go.
+  JsonPullParser parser;
+  parser.Feed("[{\"a\": 1}]");
+  parser.Finish();
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_OPEN_ARRAY, parser.Next());
+  OLA_ASSERT_EQ(1u, parser.Depth());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_OPEN_OBJECT, parser.Next());
+  OLA_ASSERT_EQ(2u, parser.Depth());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_KEY, parser.Next());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_NUMBER, parser.Next());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_CLOSE_OBJECT, parser.Next());
+  OLA_ASSERT_EQ(1u, parser.Depth());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_CLOSE_ARRAY, parser.Next());
+  OLA_ASSERT_EQ(0u, parser.Depth());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_END, parser.Next());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_END, parser.Next());
+}
+
+/*
+ * Check strings without escapes point into the input.
+ */
+void JsonPullParserTest::testZeroCopy() {
+  const string input = "{\"key\": \"value\", \"esc\": \"a\\nb\"}";
+  JsonPullParser parser;
+  parser.Feed(input);
+  parser.Finish();
+
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_OPEN_OBJECT, parser.Next());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_KEY, parser.Next());
+  OLA_ASSERT_EQ(input.data() + 2, parser.Value());
+  OLA_ASSERT_EQ(static_cast<size_t>(3), parser.ValueLength());
+
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_STRING, parser.Next());
+  OLA_ASSERT_EQ(input.data() + 9, parser.Value());
+  OLA_ASSERT_EQ(string("value"), parser.ValueAsString());
+
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_KEY, parser.Next());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_STRING, parser.Next());
+  // This one had to be copied.
+  OLA_ASSERT_FALSE(parser.Value() >= input.data() &&
+                   parser.Value() < input.data() + input.size());
+  OLA_ASSERT_EQ(string("a\nb"), parser.ValueAsString());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_CLOSE_OBJECT, parser.Next());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_END, parser.Next());
+}
+
+/*
+ * Check that splitting the input at any point gives the same tokens.
+ */
+void JsonPullParserTest::testChunkedInput() {
+  const string input = (
+      "{\"name\": \"f\\\"oo\", \"ports\": [1, -20, 3.5e-2, true, false, null],"
+      " \"u\": \"\\u00e9\\ud83d\\ude00\", \"nested\": {\"a\": [[]]}}  ");
+  const string expected = Tokenize(input);
+  OLA_ASSERT_EQ(
+      string("{ k:name s:f\"oo k:ports [ n:1 n:-20 n:3.5e-2 true false null ] "
+             "k:u s:\xc3\xa9\xf0\x9f\x98\x80 k:nested { k:a [ [ ] ] } } "),
+      expected);
+
+  for (unsigned int chunk_size = 1; chunk_size < 8; chunk_size++) {
+    OLA_ASSERT_EQ(expected, Tokenize(input, chunk_size));
+  }
+
+  // Numbers that end at the end of the input
+  OLA_ASSERT_EQ(string("n:1234 "), Tokenize("1234", 1));
+  OLA_ASSERT_EQ(string("n:-1.5 "), Tokenize("-1.5", 2));
+}
+
+/*
+ * Check escape sequences.
+ */
+void JsonPullParserTest::testEscapes() {
+  OLA_ASSERT_EQ(string("s:\"\\/\b\f\n\r\t "),
+                Tokenize("\"\\\"\\\\\\/\\b\\f\\n\\r\\t\""));
+  OLA_ASSERT_EQ(string("s:A\xc3\xa9\xe2\x82\xac "),
+                Tokenize("\"\\u0041\\u00E9\\u20ac\""));
+  // A surrogate pair
+  OLA_ASSERT_EQ(string("s:\xf0\x9f\x98\x80 "),
+                Tokenize("\"\\ud83d\\ude00\""));
+  // A lone high surrogate is encoded as is.
+  OLA_ASSERT_EQ(string("s:\xed\xa0\xbdx "), Tokenize("\"\\ud83dx\""));
+  // Keys are unescaped as well
+  OLA_ASSERT_EQ(string("{ k:a\"b n:1 } "), Tokenize("{\"a\\\"b\": 1}"));
+
+  OLA_ASSERT_EQ(string("Invalid string escape sequence"),
+                ParseError("\"\\x\""));
+  OLA_ASSERT_EQ(string("Invalid string escape sequence"),
+                ParseError("\"\\u12g4\""));
+}
+
+/*
+ * Check numbers are validated.
+ */
+void JsonPullParserTest::testNumbers() {
+  OLA_ASSERT_EQ(string("n:0 "), Tokenize("0"));
+  OLA_ASSERT_EQ(string("n:-0 "), Tokenize("-0"));
+  OLA_ASSERT_EQ(string("n:1.25 "), Tokenize("1.25"));
+  OLA_ASSERT_EQ(string("n:1E+10 "), Tokenize("1E+10"));
+  OLA_ASSERT_EQ(string("[ n:1 n:2 ] "), Tokenize("[1,2]"));
+
+  OLA_ASSERT_EQ(string("Invalid number"), ParseError("01"));
+  OLA_ASSERT_EQ(string("Invalid number"), ParseError("-"));
+  OLA_ASSERT_EQ(string("Invalid number"), ParseError("1."));
+  OLA_ASSERT_EQ(string("Invalid number"), ParseError("1e"));
+  OLA_ASSERT_EQ(string("Invalid number"), ParseError("1-2"));
+  OLA_ASSERT_EQ(string("Invalid number"), ParseError("[1.2.3]"));
+}
+
+/*
+ * Check invalid documents.
+ */
+void JsonPullParserTest::testInvalidInput() {
+  OLA_ASSERT_EQ(string("No JSON data found"), ParseError(""));
+  OLA_ASSERT_EQ(string("No JSON data found"), ParseError("  \n"));
+  OLA_ASSERT_EQ(string("Unexpected end of input"), ParseError("["));
+  OLA_ASSERT_EQ(string("Unexpected end of input"), ParseError("{\"a\": 1"));
+  OLA_ASSERT_EQ(string("Unterminated string"), ParseError("\"foo"));
+  OLA_ASSERT_EQ(string("Invalid JSON value"), ParseError("tru"));
+  OLA_ASSERT_EQ(string("Invalid JSON value"), ParseError("nul1"));
+  OLA_ASSERT_EQ(string("Invalid JSON value"), ParseError("[,]"));
+  OLA_ASSERT_EQ(string("Expected key for object"), ParseError("{1: 2}"));
+  OLA_ASSERT_EQ(string("Expected key for object"), ParseError("{\"a\":1,}"));
+  OLA_ASSERT_EQ(string("Incorrect character after key, should be :"),
+                ParseError("{\"a\" 1}"));
+  OLA_ASSERT_EQ(string("Expected either , or } after an object value"),
+                ParseError("{\"a\": 1]"));
+  OLA_ASSERT_EQ(string("Expected either , or ] after an array element"),
+                ParseError("[1}"));
+  OLA_ASSERT_EQ(string("Extra data after the JSON value"),
+                ParseError("[] []"));
+  OLA_ASSERT_EQ(string("Extra data after the JSON value"),
+                ParseError("truex"));
+
+  OLA_ASSERT_EQ(string(""), ParseError("[1, {\"a\": [true]}]"));
+}
+
+/*
+ * Check the tokens can be passed to a JsonParser to build a tree.
+ */
+void JsonPullParserTest::testPushTokens() {
+  const string input = (
+      "{\"name\": \"foo\", \"ports\": [1, -2, 4294967296, -2147483649,"
+      " 1.5, true, null], \"nested\": {\"s\": \"a\\tb\"}}");
+
+  string error;
+  auto_ptr<JsonValue> expected(JsonParser::Parse(input, &error));
+  OLA_ASSERT_NOT_NULL(expected.get());
+
+  JsonPullParser pull_parser;
+  JsonParser parser;
+  for (unsigned int i = 0; i < input.size(); i += 5) {
+    pull_parser.Feed(input.data() + i, std::min(static_cast<size_t>(5),
+                                                input.size() - i));
+    OLA_ASSERT_EQ(JsonPullParser::TOKEN_NEED_DATA,
+                  pull_parser.PushTokens(&parser));
+  }
+  pull_parser.Finish();
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_END, pull_parser.PushTokens(&parser));
+
+  auto_ptr<JsonValue> value(parser.ClaimRoot());
+  OLA_ASSERT_NOT_NULL(value.get());
+  OLA_ASSERT_TRUE(*expected == *value);
+  OLA_ASSERT_EQ(JsonWriter::AsString(*expected), JsonWriter::AsString(*value));
+
+  // Errors are passed on.
+  JsonPullParser bad_input;
+  JsonParser error_parser;
+  bad_input.Feed("[1, ");
+  bad_input.Finish();
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_ERROR,
+                bad_input.PushTokens(&error_parser));
+  OLA_ASSERT_EQ(string("Unexpected end of input"), error_parser.GetError());
+  OLA_ASSERT_NULL(error_parser.ClaimRoot());
+}
+
+/*
+ * Check a parser can be reused.
+ */
+void JsonPullParserTest::testReset() {
+  JsonPullParser parser;
+  parser.Feed("[1");
+  parser.Finish();
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_OPEN_ARRAY, parser.Next());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_NUMBER, parser.Next());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_ERROR, parser.Next());
+
+  parser.Reset();
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_NEED_DATA, parser.Next());
+  parser.Feed("\"foo\"");
+  parser.Finish();
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_STRING, parser.Next());
+  OLA_ASSERT_EQ(string("foo"), parser.ValueAsString());
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_END, parser.Next());
+}
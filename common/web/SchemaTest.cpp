@@ -19,6 +19,7 @@
  */
 
 #include <cppunit/extensions/HelperMacros.h>
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
@@ -28,7 +29,9 @@
 #include "ola/testing/TestUtils.h"
 #include "ola/web/Json.h"
 #include "ola/web/JsonParser.h"
+#include "ola/web/JsonPullParser.h"
 #include "ola/web/JsonSchema.h"
+#include "ola/web/JsonStreamValidator.h"
 
 using ola::web::AllOfValidator;
 using ola::web::AnyOfValidator;
@@ -41,6 +44,9 @@ using ola::web::JsonDouble;
 using ola::web::JsonInt;
 using ola::web::JsonNull;
 using ola::web::JsonParser;
+using ola::web::JsonPullParser;
+using ola::web::JsonSchema;
+using ola::web::JsonStreamValidator;
 using ola::web::JsonString;
 using ola::web::JsonString;
 using ola::web::JsonUInt;
@@ -80,6 +86,7 @@ class JsonSchemaTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testOneOfValidator);
   CPPUNIT_TEST(testNotValidator);
   CPPUNIT_TEST(testEnums);
+  CPPUNIT_TEST(testStreamValidator);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -98,6 +105,7 @@ class JsonSchemaTest: public CppUnit::TestFixture {
   void testOneOfValidator();
   void testNotValidator();
   void testEnums();
+  void testStreamValidator();
 
  private:
   auto_ptr<JsonBool> m_bool_value;
@@ -109,6 +117,8 @@ class JsonSchemaTest: public CppUnit::TestFixture {
   auto_ptr<JsonDouble> m_number_value;
   auto_ptr<JsonString> m_string_value;
   auto_ptr<JsonUInt> m_uint_value;
+
+  bool IsValid(JsonSchema *schema, const string &input);
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(JsonSchemaTest);
@@ -855,3 +865,128 @@ void JsonSchemaTest::testEnums() {
   uint_value2.Accept(&integer_validator);
   OLA_ASSERT_FALSE(integer_validator.IsValid());
 }
+
+/*
+ * Validate the input using both a JsonStreamValidator & a tree of JsonValues,
+ * and check they agree.
+ */
+bool JsonSchemaTest::IsValid(JsonSchema *schema, const string &input) {
+  string error;
+  auto_ptr<JsonValue> value(JsonParser::Parse(input, &error));
+  OLA_ASSERT_NOT_NULL(value.get());
+  bool is_valid = schema->IsValid(*value);
+
+  // Feed the input a few bytes at a time.
+  JsonStreamValidator validator(schema->RootValidator());
+  JsonPullParser parser;
+  for (unsigned int i = 0; i < input.size(); i += 3) {
+    parser.Feed(input.data() + i, std::min(static_cast<size_t>(3),
+                                           input.size() - i));
+    OLA_ASSERT_EQ(JsonPullParser::TOKEN_NEED_DATA,
+                  parser.PushTokens(&validator));
+  }
+  parser.Finish();
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_END, parser.PushTokens(&validator));
+  OLA_ASSERT_EQ(is_valid, validator.IsValid());
+  return is_valid;
+}
+
+void JsonSchemaTest::testStreamValidator() {
+  string error;
+  auto_ptr<JsonSchema> schema(JsonSchema::FromString(
+      "{"
+      "  \"type\": \"object\","
+      "  \"required\": [\"name\", \"ports\"],"
+      "  \"additionalProperties\": false,"
+      "  \"dependencies\": {\"priority\": [\"mode\"]},"
+      "  \"properties\": {"
+      "    \"name\": {\"type\": \"string\", \"maxLength\": 8},"
+      "    \"mode\": {\"type\": \"string\", \"enum\": [\"htp\", \"ltp\"]},"
+      "    \"priority\": {\"type\": \"integer\", \"maximum\": 200},"
+      "    \"ports\": {"
+      "      \"type\": \"array\","
+      "      \"maxItems\": 3,"
+      "      \"items\": {"
+      "        \"type\": \"object\","
+      "        \"properties\": {\"id\": {\"type\": \"integer\"}},"
+      "        \"required\": [\"id\"]"
+      "      }"
+      "    },"
+      "    \"tags\": {"
+      "      \"type\": \"array\","
+      "      \"uniqueItems\": true,"
+      "      \"items\": [{\"type\": \"string\"}],"
+      "      \"additionalItems\": {\"type\": \"integer\"}"
+      "    },"
+      "    \"extra\": {},"
+      "    \"either\": {\"anyOf\": ["
+      "      {\"type\": \"array\"},"
+      "      {\"type\": \"object\", \"minProperties\": 1}"
+      "    ]}"
+      "  }"
+      "}",
+      &error));
+  OLA_ASSERT_NOT_NULL(schema.get());
+
+  OLA_ASSERT_TRUE(IsValid(schema.get(), "{\"name\": \"a\", \"ports\": []}"));
+  OLA_ASSERT_TRUE(IsValid(
+      schema.get(),
+      "{\"name\": \"a\", \"ports\": [{\"id\": 1}, {\"id\": 2}],"
+      " \"mode\": \"htp\", \"priority\": 100, \"tags\": [\"x\", 1, 2],"
+      " \"extra\": {\"anything\": [1, {\"goes\": null}]},"
+      " \"either\": {\"a\": [1]}}"));
+  OLA_ASSERT_TRUE(IsValid(schema.get(),
+                          "{\"name\": \"a\", \"ports\": [], \"either\": []}"));
+
+  // not an object
+  OLA_ASSERT_FALSE(IsValid(schema.get(), "[]"));
+  OLA_ASSERT_FALSE(IsValid(schema.get(), "\"foo\""));
+  // missing required properties
+  OLA_ASSERT_FALSE(IsValid(schema.get(), "{\"name\": \"a\"}"));
+  // additional properties
+  OLA_ASSERT_FALSE(IsValid(schema.get(),
+                           "{\"name\": \"a\", \"ports\": [], \"foo\": 1}"));
+  // property dependency
+  OLA_ASSERT_FALSE(IsValid(
+      schema.get(), "{\"name\": \"a\", \"ports\": [], \"priority\": 1}"));
+  // scalar values
+  OLA_ASSERT_FALSE(IsValid(schema.get(),
+                           "{\"name\": \"too long name\", \"ports\": []}"));
+  OLA_ASSERT_FALSE(IsValid(
+      schema.get(),
+      "{\"name\": \"a\", \"ports\": [], \"mode\": \"foo\"}"));
+  OLA_ASSERT_FALSE(IsValid(
+      schema.get(),
+      "{\"name\": \"a\", \"ports\": [], \"mode\": \"htp\","
+      " \"priority\": 201}"));
+  // array items
+  OLA_ASSERT_FALSE(IsValid(schema.get(),
+                           "{\"name\": \"a\", \"ports\": [{\"id\": \"1\"}]}"));
+  OLA_ASSERT_FALSE(IsValid(schema.get(),
+                           "{\"name\": \"a\", \"ports\": [{}]}"));
+  OLA_ASSERT_FALSE(IsValid(
+      schema.get(),
+      "{\"name\": \"a\", \"ports\": [{\"id\": 1}, {\"id\": 2}, {\"id\": 3},"
+      " {\"id\": 4}]}"));
+  // uniqueItems & additionalItems
+  OLA_ASSERT_FALSE(IsValid(
+      schema.get(),
+      "{\"name\": \"a\", \"ports\": [], \"tags\": [\"x\", 1, 1]}"));
+  OLA_ASSERT_FALSE(IsValid(
+      schema.get(),
+      "{\"name\": \"a\", \"ports\": [], \"tags\": [\"x\", \"y\"]}"));
+  // anyOf
+  OLA_ASSERT_FALSE(IsValid(schema.get(),
+                           "{\"name\": \"a\", \"ports\": [], \"either\": {}}"));
+  OLA_ASSERT_FALSE(IsValid(schema.get(),
+                           "{\"name\": \"a\", \"ports\": [], \"either\": 1}"));
+
+  // A parse error means the document is invalid.
+  JsonStreamValidator validator(schema->RootValidator());
+  JsonPullParser parser;
+  parser.Feed("{\"name\": \"a\", \"ports\": [}");
+  parser.Finish();
+  OLA_ASSERT_EQ(JsonPullParser::TOKEN_ERROR, parser.PushTokens(&validator));
+  OLA_ASSERT_FALSE(validator.IsValid());
+  OLA_ASSERT_EQ(string("Invalid JSON value"), validator.GetError());
+}
@@ -0,0 +1,213 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * StreamWriterTest.cpp
+ * Unittest for the JsonStreamWriter.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <stdint.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <string>
+
+#include "ola/testing/TestUtils.h"
+#include "ola/web/Json.h"
+#include "ola/web/JsonParser.h"
+#include "ola/web/JsonStreamWriter.h"
+#include "ola/web/JsonWriter.h"
+
+using ola::web::JsonArray;
+using ola::web::JsonObject;
+using ola::web::JsonParser;
+using ola::web::JsonStreamWriter;
+using ola::web::JsonString;
+using ola::web::JsonValue;
+using ola::web::JsonWriter;
+using std::string;
+
+class StreamWriterTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(StreamWriterTest);
+  CPPUNIT_TEST(testValues);
+  CPPUNIT_TEST(testEmptyContainers);
+  CPPUNIT_TEST(testNesting);
+  CPPUNIT_TEST(testEscaping);
+  CPPUNIT_TEST(testAppendValue);
+  CPPUNIT_TEST(testBufferReuse);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void testValues();
+    void testEmptyContainers();
+    void testNesting();
+    void testEscaping();
+    void testAppendValue();
+    void testBufferReuse();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(StreamWriterTest);
+
+/*
+ * Test each type of value.
+ */
+void StreamWriterTest::testValues() {
+  string output;
+  JsonStreamWriter writer(&output);
+  writer.StartArray();
+  writer.Append("foo");
+  writer.Append(string("bar"));
+  writer.Append(10u);
+  writer.Append(-10);
+  writer.Append(static_cast<uint64_t>(8589934592ull));
+  writer.Append(static_cast<int64_t>(-8589934592ll));
+  writer.Append(1.5);
+  writer.Append(true);
+  writer.Append(false);
+  writer.Append();
+  writer.AppendRaw("1e3");
+  writer.EndArray();
+
+  OLA_ASSERT_EQ(
+      string("[\"foo\",\"bar\",10,-10,8589934592,-8589934592,1.5,true,false,"
+             "null,1e3]"),
+      output);
+
+  output.clear();
+  JsonStreamWriter writer2(&output);
+  writer2.StartObject();
+  writer2.Add("s", "foo");
+  writer2.Add("u", 1u);
+  writer2.Add("i", -1);
+  writer2.Add("b", true);
+  writer2.Add("n");
+  writer2.AddRaw("r", "[]");
+  writer2.EndObject();
+  OLA_ASSERT_EQ(
+      string("{\"s\":\"foo\",\"u\":1,\"i\":-1,\"b\":true,\"n\":null,"
+             "\"r\":[]}"),
+      output);
+}
+
+
+/*
+ * Test empty objects & arrays.
+ */
+void StreamWriterTest::testEmptyContainers() {
+  string output;
+  JsonStreamWriter writer(&output);
+  writer.StartArray();
+  writer.StartObject();
+  writer.EndObject();
+  writer.StartArray();
+  writer.EndArray();
+  writer.EndArray();
+  OLA_ASSERT_EQ(string("[{},[]]"), output);
+}
+
+
+/*
+ * Test nested objects & arrays, and check the parser agrees.
+ */
+void StreamWriterTest::testNesting() {
+  string output;
+  JsonStreamWriter writer(&output);
+  writer.StartObject();
+  writer.Add("id", 1u);
+  writer.StartArray("ports");
+  for (int i = 0; i < 2; i++) {
+    writer.StartObject();
+    writer.Add("id", i);
+    writer.StartObject("priority");
+    writer.Add("value", 100);
+    writer.EndObject();
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.StartArray("empty");
+  writer.EndArray();
+  writer.Add("name", "foo");
+  writer.EndObject();
+
+  OLA_ASSERT_EQ(
+      string("{\"id\":1,\"ports\":[{\"id\":0,\"priority\":{\"value\":100}},"
+             "{\"id\":1,\"priority\":{\"value\":100}}],\"empty\":[],"
+             "\"name\":\"foo\"}"),
+      output);
+
+  string error;
+  JsonValue *value = JsonParser::Parse(output, &error);
+  OLA_ASSERT_NOT_NULL(value);
+  OLA_ASSERT_EQ(string(""), error);
+  delete value;
+}
+
+
+/*
+ * Check strings are escaped in the same way as the JsonWriter.
+ */
+void StreamWriterTest::testEscaping() {
+  const string input("a\"b\\c/d\x01\x7f\n\t");
+
+  // The JsonWriter pretty prints, so compare a lone value.
+  JsonString value(input);
+  string output;
+  JsonStreamWriter writer(&output);
+  writer.Append(input);
+  OLA_ASSERT_EQ(JsonWriter::AsString(value), output);
+}
+
+
+/*
+ * Check a tree of JsonValues can be mixed in.
+ */
+void StreamWriterTest::testAppendValue() {
+  JsonObject object;
+  object.Add("name", "foo");
+  JsonArray *array = object.AddArray("values");
+  array->Append(1);
+  array->Append(true);
+  array->AppendObject();
+
+  string output;
+  JsonStreamWriter writer(&output);
+  writer.StartArray();
+  writer.Append(1);
+  writer.Append(object);
+  writer.Append(2);
+  writer.EndArray();
+
+  OLA_ASSERT_EQ(
+      string("[1,{\"name\":\"foo\",\"values\":[1,true,{}]},2]"),
+      output);
+}
+
+
+/*
+ * Check the output string can be reused.
+ */
+void StreamWriterTest::testBufferReuse() {
+  string output;
+  output.reserve(1024);
+  const size_t capacity = output.capacity();
+
+  for (unsigned int i = 0; i < 3; i++) {
+    output.clear();
+    JsonStreamWriter writer(&output);
+    writer.StartObject();
+    writer.Add("i", i);
+    writer.EndObject();
+  }
+  OLA_ASSERT_EQ(string("{\"i\":2}"), output);
+  OLA_ASSERT_EQ(capacity, output.capacity());
+}
@@ -0,0 +1,73 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * BinaryShowFormat.h
+ * The layout of binary show files.
+ * Copyright (C) 2026 Simon Newton
+ *
+ * All values are in network byte order. The file is:
+ *
+ *   header:
+ *     magic        16 bytes, "OLA Binary Show" followed by a NUL
+ *     version      uint16
+ *     reserved     uint16
+ *     frame_count  uint32, the number of frames, excluding snapshots
+ *     duration     uint32, the end of the show in ms, this may be after the
+ *                  last frame
+ *     index_count  uint32, the number of index entries
+ *     index_offset uint32, the file offset of the index
+ *   records, each of which is:
+ *     time         uint32, ms since the start of the show
+ *     universe     uint32
+ *     type         uint8, one of the FrameType values
+ *     slot_count   uint16, the number of slots in the frame
+ *     length       uint16, the length of the data
+ *     data         RLE encoded with ola::dmx::RunLengthEncoder
+ *   index, which is index_count entries of:
+ *     time         uint32
+ *     offset       uint32, the file offset of the record
+ *
+ * A keyframe holds the slot values, a delta frame holds the slot values
+ * XOR'ed with the previous frame for the same universe. Every
+ * SYNC_INTERVAL_MS the saver adds an index entry, followed by a snapshot of
+ * each universe seen so far. Snapshots aren't played; they provide the
+ * state to decode from when seeking to the index entry.
+ */
+
+#ifndef EXAMPLES_BINARYSHOWFORMAT_H_
+#define EXAMPLES_BINARYSHOWFORMAT_H_
+
+#include <stdint.h>
+
+namespace binary_show {
+
+typedef enum {
+  KEYFRAME = 0,
+  DELTA_FRAME = 1,
+  SNAPSHOT = 2,
+} FrameType;
+
+static const char MAGIC[] = "OLA Binary Show";
+static const unsigned int MAGIC_SIZE = 16;
+static const uint16_t FORMAT_VERSION = 1;
+
+static const unsigned int HEADER_SIZE = MAGIC_SIZE + 20;
+static const unsigned int RECORD_HEADER_SIZE = 13;
+static const unsigned int INDEX_ENTRY_SIZE = 8;
+
+// How often to add a seek point.
+static const unsigned int SYNC_INTERVAL_MS = 1000;
+}  // namespace binary_show
+#endif  // EXAMPLES_BINARYSHOWFORMAT_H_
@@ -0,0 +1,389 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * BinaryShowLoader.cpp
+ * Reads binary show files.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#if HAVE_CONFIG_H
+#include <config.h>
+#endif  // HAVE_CONFIG_H
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#endif  // HAVE_MMAP
+
+#include <ola/Constants.h>
+#include <ola/DmxBuffer.h>
+#include <ola/Logging.h>
+#include <ola/network/NetworkUtils.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "examples/BinaryShowFormat.h"
+#include "examples/BinaryShowLoader.h"
+
+using ola::DmxBuffer;
+using ola::network::NetworkToHost;
+using std::string;
+
+BinaryShowLoader::BinaryShowLoader(const string &filename)
+    : m_filename(filename),
+      m_data(NULL),
+      m_size(0),
+      m_mapped(false),
+      m_frame_count(0),
+      m_duration(0),
+      m_index_count(0),
+      m_index_offset(0),
+      m_offset(binary_show::HEADER_SIZE),
+      m_last_time(0) {
+}
+
+
+BinaryShowLoader::~BinaryShowLoader() {
+  Unmap();
+}
+
+
+bool BinaryShowLoader::IsBinaryShow(const string &filename) {
+  std::ifstream show_file(filename.data(), std::ios::in | std::ios::binary);
+  char magic[binary_show::MAGIC_SIZE];
+  show_file.read(magic, sizeof(magic));
+  return (show_file.gcount() == static_cast<int>(sizeof(magic)) &&
+          memcmp(magic, binary_show::MAGIC, sizeof(binary_show::MAGIC)) == 0);
+}
+
+
+/**
+ * Map the show file and check the header & index.
+ * @returns true if the file is valid, false otherwise.
+ */
+bool BinaryShowLoader::Load() {
+  if (!MapFile()) {
+    return false;
+  }
+
+  if (m_size < binary_show::HEADER_SIZE ||
+      memcmp(m_data, binary_show::MAGIC, sizeof(binary_show::MAGIC)) != 0) {
+    OLA_WARN << m_filename << " isn't a binary show file";
+    return false;
+  }
+
+  unsigned int offset = binary_show::MAGIC_SIZE;
+  uint16_t version = ReadUInt16(offset);
+  if (version != binary_show::FORMAT_VERSION) {
+    OLA_WARN << "Unknown binary show version " << version;
+    return false;
+  }
+  offset += 4;  // version & reserved
+  m_frame_count = ReadUInt32(offset);
+  offset += 4;
+  m_duration = ReadUInt32(offset);
+  offset += 4;
+  m_index_count = ReadUInt32(offset);
+  offset += 4;
+  m_index_offset = ReadUInt32(offset);
+
+  if (m_index_offset < binary_show::HEADER_SIZE ||
+      m_index_offset > m_size ||
+      (m_size - m_index_offset) / binary_show::INDEX_ENTRY_SIZE <
+          m_index_count) {
+    OLA_WARN << "Invalid index in " << m_filename
+             << ", the file may be truncated";
+    return false;
+  }
+
+  for (unsigned int i = 0; i < m_index_count; i++) {
+    if (IndexOffset(i) < binary_show::HEADER_SIZE ||
+        IndexOffset(i) > m_index_offset) {
+      OLA_WARN << "Invalid index entry " << i << " in " << m_filename;
+      return false;
+    }
+  }
+  Reset();
+  return true;
+}
+
+
+/**
+ * Reset to the start of the show
+ */
+void BinaryShowLoader::Reset() {
+  m_offset = binary_show::HEADER_SIZE;
+  m_last_time = 0;
+  m_universes.clear();
+}
+
+
+/**
+ * Get the time until the next frame.
+ * @param timeout a pointer to the timeout in ms
+ */
+BinaryShowLoader::State BinaryShowLoader::NextTimeout(unsigned int *timeout) {
+  if (m_offset >= m_index_offset) {
+    // The show may continue after the last frame.
+    if (m_last_time < m_duration) {
+      *timeout = m_duration - m_last_time;
+      return OK;
+    }
+    return END_OF_FILE;
+  }
+
+  Record record;
+  if (!ReadRecord(m_offset, &record)) {
+    return INVALID_LINE;
+  }
+  *timeout = record.time - m_last_time;
+  return OK;
+}
+
+
+/**
+ * Read the next DMX frame, applying any snapshots along the way.
+ * @param universe the universe to send on
+ * @param data the DMX data
+ */
+BinaryShowLoader::State BinaryShowLoader::NextFrame(unsigned int *universe,
+                                                    DmxBuffer *data) {
+  Record record;
+  do {
+    if (m_offset >= m_index_offset) {
+      return END_OF_FILE;
+    }
+
+    if (!ReadRecord(m_offset, &record) || !ApplyRecord(record)) {
+      return INVALID_LINE;
+    }
+    m_offset += binary_show::RECORD_HEADER_SIZE + record.length;
+  } while (record.type == binary_show::SNAPSHOT);
+
+  *universe = record.universe;
+  data->Set(m_universes[record.universe]);
+  m_last_time = record.time;
+  return OK;
+}
+
+
+/**
+ * Move to a point in the show. This finds the last sync point at or before
+ * the offset and decodes the records from there.
+ */
+BinaryShowLoader::State BinaryShowLoader::Seek(unsigned int offset,
+                                               UniverseFrames *frames,
+                                               unsigned int *timeout) {
+  // Find the first index entry after the offset.
+  unsigned int low = 0;
+  unsigned int high = m_index_count;
+  while (low < high) {
+    unsigned int middle = low + (high - low) / 2;
+    if (IndexTime(middle) <= offset) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  Reset();
+  if (low) {
+    m_offset = IndexOffset(low - 1);
+  }
+
+  Record record;
+  while (m_offset < m_index_offset) {
+    if (!ReadRecord(m_offset, &record)) {
+      return INVALID_LINE;
+    }
+    if (record.time > offset) {
+      break;
+    }
+    if (!ApplyRecord(record)) {
+      return INVALID_LINE;
+    }
+    m_offset += binary_show::RECORD_HEADER_SIZE + record.length;
+  }
+
+  *frames = m_universes;
+  if (m_offset >= m_index_offset) {
+    if (offset >= m_duration) {
+      return END_OF_FILE;
+    }
+    *timeout = m_duration - offset;
+  } else {
+    *timeout = record.time - offset;
+  }
+  m_last_time = offset;
+  return OK;
+}
+
+
+bool BinaryShowLoader::MapFile() {
+  Unmap();
+
+  int fd = open(m_filename.data(), O_RDONLY);
+  if (fd < 0) {
+    OLA_FATAL << "Can't open " << m_filename << ": " << strerror(errno);
+    return false;
+  }
+
+  struct stat file_stat;
+  if (fstat(fd, &file_stat)) {
+    OLA_WARN << "Failed to stat " << m_filename << ": " << strerror(errno);
+    close(fd);
+    return false;
+  }
+  m_size = file_stat.st_size;
+
+#ifdef HAVE_MMAP
+  if (m_size) {
+    void *ptr = mmap(NULL, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (ptr != MAP_FAILED) {
+      close(fd);
+      m_data = reinterpret_cast<const uint8_t*>(ptr);
+      m_mapped = true;
+      return true;
+    }
+    OLA_INFO << "mmap of " << m_filename << " failed: " << strerror(errno);
+  }
+#endif  // HAVE_MMAP
+
+  // Fall back to reading the whole file.
+  m_buffer.resize(m_size);
+  unsigned int total = 0;
+  while (total < m_size) {
+    ssize_t r = read(fd, &m_buffer[total], m_size - total);
+    if (r <= 0) {
+      OLA_WARN << "Failed to read " << m_filename << ": " << strerror(errno);
+      close(fd);
+      return false;
+    }
+    total += r;
+  }
+  close(fd);
+  m_data = m_size ? &m_buffer[0] : NULL;
+  return true;
+}
+
+
+void BinaryShowLoader::Unmap() {
+#ifdef HAVE_MMAP
+  if (m_mapped) {
+    munmap(const_cast<uint8_t*>(m_data), m_size);
+  }
+#endif  // HAVE_MMAP
+  m_mapped = false;
+  m_data = NULL;
+  m_size = 0;
+  m_buffer.clear();
+}
+
+
+/**
+ * Read the record at offset, checking that it's within the record section.
+ */
+bool BinaryShowLoader::ReadRecord(unsigned int offset, Record *record) const {
+  if (m_index_offset - offset < binary_show::RECORD_HEADER_SIZE) {
+    OLA_WARN << "Truncated record at offset " << offset;
+    return false;
+  }
+
+  record->time = ReadUInt32(offset);
+  record->universe = ReadUInt32(offset + 4);
+  record->type = m_data[offset + 8];
+  record->slot_count = ReadUInt16(offset + 9);
+  record->length = ReadUInt16(offset + 11);
+  record->data = m_data + offset + binary_show::RECORD_HEADER_SIZE;
+
+  if (m_index_offset - offset - binary_show::RECORD_HEADER_SIZE <
+      record->length) {
+    OLA_WARN << "Truncated record at offset " << offset;
+    return false;
+  }
+
+  if (record->slot_count > ola::DMX_UNIVERSE_SIZE ||
+      record->type > binary_show::SNAPSHOT) {
+    OLA_WARN << "Invalid record at offset " << offset;
+    return false;
+  }
+  return true;
+}
+
+
+/**
+ * Decode a record and update the data for the universe.
+ */
+bool BinaryShowLoader::ApplyRecord(const Record &record) {
+  static const uint8_t zeros[ola::DMX_UNIVERSE_SIZE] = {0};
+  DmxBuffer frame(zeros, record.slot_count);
+  if (!m_decoder.Decode(0, record.data, record.length, &frame) ||
+      frame.Size() != record.slot_count) {
+    OLA_WARN << "Failed to decode frame for universe " << record.universe;
+    return false;
+  }
+
+  DmxBuffer &current = m_universes[record.universe];
+  if (record.type != binary_show::DELTA_FRAME) {
+    current.Set(frame);
+    return true;
+  }
+
+  if (current.Size() != frame.Size()) {
+    OLA_WARN << "Delta frame for universe " << record.universe
+             << " doesn't match the previous frame";
+    return false;
+  }
+
+  uint8_t data[ola::DMX_UNIVERSE_SIZE];
+  const uint8_t *previous = current.GetRaw();
+  const uint8_t *delta = frame.GetRaw();
+  for (unsigned int i = 0; i < frame.Size(); i++) {
+    data[i] = previous[i] ^ delta[i];
+  }
+  current.Set(data, frame.Size());
+  return true;
+}
+
+
+uint32_t BinaryShowLoader::IndexTime(unsigned int entry) const {
+  return ReadUInt32(m_index_offset + entry * binary_show::INDEX_ENTRY_SIZE);
+}
+
+
+uint32_t BinaryShowLoader::IndexOffset(unsigned int entry) const {
+  return ReadUInt32(m_index_offset + entry * binary_show::INDEX_ENTRY_SIZE +
+                    4);
+}
+
+
+uint16_t BinaryShowLoader::ReadUInt16(unsigned int offset) const {
+  uint16_t value;
+  memcpy(&value, m_data + offset, sizeof(value));
+  return NetworkToHost(value);
+}
+
+
+uint32_t BinaryShowLoader::ReadUInt32(unsigned int offset) const {
+  uint32_t value;
+  memcpy(&value, m_data + offset, sizeof(value));
+  return NetworkToHost(value);
+}
@@ -0,0 +1,107 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * BinaryShowLoader.h
+ * Reads binary show files.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <ola/DmxBuffer.h>
+#include <ola/dmx/RunLengthEncoder.h>
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include "examples/ShowLoader.h"
+
+#ifndef EXAMPLES_BINARYSHOWLOADER_H_
+#define EXAMPLES_BINARYSHOWLOADER_H_
+
+/**
+ * Reads a binary show file, see BinaryShowFormat.h.
+ *
+ * The file is memory mapped, so loading doesn't depend on the size of the
+ * show, and Seek() uses the index to find the closest sync point.
+ */
+class BinaryShowLoader : public ShowLoaderInterface {
+ public:
+  explicit BinaryShowLoader(const std::string &filename);
+  ~BinaryShowLoader();
+
+  /**
+   * @brief Check if a file is a binary show file.
+   */
+  static bool IsBinaryShow(const std::string &filename);
+
+  bool Load();
+  void Reset();
+
+  State NextTimeout(unsigned int *timeout);
+  State NextFrame(unsigned int *universe, ola::DmxBuffer *data);
+  State Seek(unsigned int offset,
+             UniverseFrames *frames,
+             unsigned int *timeout);
+
+  /**
+   * @brief The number of frames in the show.
+   */
+  unsigned int FrameCount() const { return m_frame_count; }
+
+  /**
+   * @brief The length of the show, in ms. This may be after the last frame.
+   */
+  unsigned int Duration() const { return m_duration; }
+
+ private:
+  struct Record {
+    uint32_t time;
+    uint32_t universe;
+    uint8_t type;
+    uint16_t slot_count;
+    uint16_t length;
+    const uint8_t *data;
+  };
+
+  const std::string m_filename;
+  const uint8_t *m_data;
+  unsigned int m_size;
+  bool m_mapped;
+  // Used if mmap() isn't available.
+  std::vector<uint8_t> m_buffer;
+
+  uint32_t m_frame_count;
+  uint32_t m_duration;
+  uint32_t m_index_count;
+  uint32_t m_index_offset;
+
+  // The offset of the next record.
+  unsigned int m_offset;
+  // The time of the last frame.
+  uint32_t m_last_time;
+  // The current data for each universe, deltas are applied to this.
+  UniverseFrames m_universes;
+  ola::dmx::RunLengthEncoder m_decoder;
+
+  bool MapFile();
+  void Unmap();
+  bool ReadRecord(unsigned int offset, Record *record) const;
+  bool ApplyRecord(const Record &record);
+  uint32_t IndexTime(unsigned int entry) const;
+  uint32_t IndexOffset(unsigned int entry) const;
+  uint16_t ReadUInt16(unsigned int offset) const;
+  uint32_t ReadUInt32(unsigned int offset) const;
+};
+#endif  // EXAMPLES_BINARYSHOWLOADER_H_
@@ -0,0 +1,214 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * BinaryShowSaver.cpp
+ * Writes show data to a binary show file.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <ola/Constants.h>
+#include <ola/DmxBuffer.h>
+#include <ola/Logging.h>
+#include <ola/network/NetworkUtils.h>
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "examples/BinaryShowSaver.h"
+
+using ola::DmxBuffer;
+using ola::network::HostToNetwork;
+using std::string;
+
+BinaryShowSaver::BinaryShowSaver(const string &filename)
+    : m_filename(filename),
+      m_offset(0),
+      m_index_offset(0),
+      m_frame_count(0),
+      m_last_time(0),
+      m_end_time(0) {
+}
+
+
+BinaryShowSaver::~BinaryShowSaver() {
+  Close();
+}
+
+
+/**
+ * Open the show file for writing.
+ * @returns true if we could open the file, false otherwise.
+ */
+bool BinaryShowSaver::Open() {
+  m_show_file.open(m_filename.data(), std::ios::out | std::ios::binary);
+  if (!m_show_file.is_open()) {
+    OLA_FATAL << "Can't open " << m_filename << ": " << strerror(errno);
+    return false;
+  }
+
+  // The header is re-written with the counts once we're done.
+  WriteHeader();
+  return true;
+}
+
+
+/**
+ * Write the index and the final header, and close the show file.
+ */
+void BinaryShowSaver::Close() {
+  if (!m_show_file.is_open()) {
+    return;
+  }
+
+  m_index_offset = m_offset;
+  Index::const_iterator iter = m_index.begin();
+  for (; iter != m_index.end(); ++iter) {
+    WriteUInt32(iter->first);
+    WriteUInt32(iter->second);
+  }
+
+  m_show_file.seekp(0);
+  WriteHeader();
+  m_show_file.close();
+}
+
+
+/**
+ * Write a new frame
+ */
+bool BinaryShowSaver::NewFrame(const ola::TimeStamp &arrival_time,
+                               unsigned int universe,
+                               const DmxBuffer &data) {
+  if (!m_show_file.is_open()) {
+    return false;
+  }
+
+  if (!m_start_time.IsSet()) {
+    m_start_time = arrival_time;
+  }
+
+  uint32_t time = (arrival_time - m_start_time).InMilliSeconds();
+  // Don't let the time go backwards
+  time = std::max(time, m_last_time);
+
+  if (m_index.empty() ||
+      time - m_index.back().first >= binary_show::SYNC_INTERVAL_MS) {
+    AddSyncPoint(time);
+  }
+
+  bool ok;
+  UniverseMap::iterator iter = m_universes.find(universe);
+  if (iter == m_universes.end() || iter->second.Size() != data.Size()) {
+    ok = WriteRecord(time, universe, binary_show::KEYFRAME, data);
+  } else {
+    // Unchanged slots XOR to 0, which run length encodes well.
+    uint8_t delta[ola::DMX_UNIVERSE_SIZE];
+    const uint8_t *previous = iter->second.GetRaw();
+    const uint8_t *current = data.GetRaw();
+    for (unsigned int i = 0; i < data.Size(); i++) {
+      delta[i] = previous[i] ^ current[i];
+    }
+    ok = WriteRecord(time, universe, binary_show::DELTA_FRAME,
+                     DmxBuffer(delta, data.Size()));
+  }
+
+  m_universes[universe] = data;
+  m_last_time = time;
+  m_frame_count++;
+  return ok;
+}
+
+
+void BinaryShowSaver::SetEndTime(const ola::TimeStamp &end_time) {
+  if (m_start_time.IsSet() && end_time > m_start_time) {
+    m_end_time = (end_time - m_start_time).InMilliSeconds();
+  }
+}
+
+
+/**
+ * Add an index entry, followed by a snapshot of each universe.
+ */
+void BinaryShowSaver::AddSyncPoint(uint32_t time) {
+  m_index.push_back(std::make_pair(time, m_offset));
+  UniverseMap::const_iterator iter = m_universes.begin();
+  for (; iter != m_universes.end(); ++iter) {
+    WriteRecord(time, iter->first, binary_show::SNAPSHOT, iter->second);
+  }
+}
+
+
+bool BinaryShowSaver::WriteRecord(uint32_t time, unsigned int universe,
+                                  binary_show::FrameType type,
+                                  const DmxBuffer &data) {
+  // The worst case is one length byte for every 127 slots.
+  uint8_t encoded[2 * ola::DMX_UNIVERSE_SIZE];
+  unsigned int length = sizeof(encoded);
+  if (!m_encoder.Encode(data, encoded, &length)) {
+    OLA_WARN << "Failed to encode frame for universe " << universe;
+    return false;
+  }
+
+  WriteUInt32(time);
+  WriteUInt32(universe);
+  WriteUInt8(type);
+  WriteUInt16(data.Size());
+  WriteUInt16(length);
+  WriteBytes(encoded, length);
+  return m_show_file.good();
+}
+
+
+/**
+ * Write the header, see BinaryShowFormat.h.
+ */
+void BinaryShowSaver::WriteHeader() {
+  uint8_t magic[binary_show::MAGIC_SIZE];
+  memset(magic, 0, sizeof(magic));
+  memcpy(magic, binary_show::MAGIC, sizeof(binary_show::MAGIC));
+  WriteBytes(magic, sizeof(magic));
+  WriteUInt16(binary_show::FORMAT_VERSION);
+  WriteUInt16(0);
+  WriteUInt32(m_frame_count);
+  WriteUInt32(std::max(m_last_time, m_end_time));
+  WriteUInt32(m_index.size());
+  WriteUInt32(m_index_offset);
+}
+
+
+void BinaryShowSaver::WriteUInt8(uint8_t value) {
+  WriteBytes(&value, sizeof(value));
+}
+
+
+void BinaryShowSaver::WriteUInt16(uint16_t value) {
+  value = HostToNetwork(value);
+  WriteBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+}
+
+
+void BinaryShowSaver::WriteUInt32(uint32_t value) {
+  value = HostToNetwork(value);
+  WriteBytes(reinterpret_cast<uint8_t*>(&value), sizeof(value));
+}
+
+
+void BinaryShowSaver::WriteBytes(const uint8_t *data, unsigned int length) {
+  m_show_file.write(reinterpret_cast<const char*>(data), length);
+  m_offset += length;
+}
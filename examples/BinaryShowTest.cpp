@@ -0,0 +1,282 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * BinaryShowTest.cpp
+ * Test fixture for the BinaryShowSaver and BinaryShowLoader classes.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+
+#include "examples/BinaryShowFormat.h"
+#include "examples/BinaryShowLoader.h"
+#include "examples/BinaryShowSaver.h"
+#include "ola/Clock.h"
+#include "ola/DmxBuffer.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::DmxBuffer;
+using ola::TimeInterval;
+using ola::TimeStamp;
+using std::string;
+
+class BinaryShowTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(BinaryShowTest);
+  CPPUNIT_TEST(testFrames);
+  CPPUNIT_TEST(testSeek);
+  CPPUNIT_TEST(testNoTrailingTimeout);
+  CPPUNIT_TEST(testTruncated);
+  CPPUNIT_TEST(testCorrupt);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  BinaryShowTest()
+      : m_filename(TEST_BUILD_DIR "/examples/BinaryShowTest.show") {
+  }
+
+  void setUp();
+  void tearDown();
+  void testFrames();
+  void testSeek();
+  void testNoTrailingTimeout();
+  void testTruncated();
+  void testCorrupt();
+
+ private:
+  const string m_filename;
+  TimeStamp m_start;
+  DmxBuffer m_frame1, m_frame2, m_frame3, m_frame4;
+
+  void WriteShow(bool trailing_timeout);
+  void SaveFrame(BinaryShowSaver *saver, unsigned int time,
+                 unsigned int universe, const DmxBuffer &data);
+  void Overwrite(unsigned int offset, const uint8_t *data,
+                 unsigned int length);
+  void CheckFrame(BinaryShowLoader *loader, unsigned int expected_universe,
+                  const DmxBuffer &expected_data);
+  void CheckTimeout(BinaryShowLoader *loader, unsigned int expected_timeout);
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(BinaryShowTest);
+
+
+void BinaryShowTest::setUp() {
+  ola::Clock clock;
+  clock.CurrentTime(&m_start);
+
+  const uint8_t frame1[] = {1, 2, 3, 4};
+  const uint8_t frame2[] = {1, 2, 9, 4};
+  const uint8_t frame3[] = {5, 5, 5};
+  const uint8_t frame4[] = {1, 2, 9, 5};
+  m_frame1.Set(frame1, sizeof(frame1));
+  m_frame2.Set(frame2, sizeof(frame2));
+  m_frame3.Set(frame3, sizeof(frame3));
+  m_frame4.Set(frame4, sizeof(frame4));
+}
+
+
+void BinaryShowTest::tearDown() {
+  unlink(m_filename.c_str());
+}
+
+
+/**
+ * Check the frames are decoded, including deltas and the frame after a sync
+ * point, and that the show pauses for the trailing timeout.
+ */
+void BinaryShowTest::testFrames() {
+  WriteShow(true);
+  BinaryShowLoader loader(m_filename);
+  OLA_ASSERT_TRUE(BinaryShowLoader::IsBinaryShow(m_filename));
+  OLA_ASSERT_TRUE(loader.Load());
+  OLA_ASSERT_EQ(4u, loader.FrameCount());
+  OLA_ASSERT_EQ(1500u, loader.Duration());
+
+  CheckFrame(&loader, 1, m_frame1);
+  CheckTimeout(&loader, 100);
+  CheckFrame(&loader, 1, m_frame2);
+  CheckTimeout(&loader, 0);
+  CheckFrame(&loader, 2, m_frame3);
+  CheckTimeout(&loader, 1100);
+  CheckFrame(&loader, 1, m_frame4);
+  CheckTimeout(&loader, 300);
+
+  unsigned int universe;
+  DmxBuffer data;
+  OLA_ASSERT_EQ(ShowLoader::END_OF_FILE, loader.NextFrame(&universe, &data));
+
+  // Reset and play it again.
+  loader.Reset();
+  CheckFrame(&loader, 1, m_frame1);
+  CheckTimeout(&loader, 100);
+}
+
+
+/**
+ * Check seeking, both before & after a sync point and into the trailing
+ * timeout.
+ */
+void BinaryShowTest::testSeek() {
+  WriteShow(true);
+  BinaryShowLoader loader(m_filename);
+  OLA_ASSERT_TRUE(loader.Load());
+
+  ShowLoader::UniverseFrames frames;
+  unsigned int timeout = 0;
+  OLA_ASSERT_EQ(ShowLoader::OK, loader.Seek(0, &frames, &timeout));
+  OLA_ASSERT_EQ(100u, timeout);
+  OLA_ASSERT_EQ(static_cast<size_t>(1), frames.size());
+  OLA_ASSERT_EQ(m_frame1, frames[1]);
+
+  OLA_ASSERT_EQ(ShowLoader::OK, loader.Seek(150, &frames, &timeout));
+  OLA_ASSERT_EQ(1050u, timeout);
+  OLA_ASSERT_EQ(static_cast<size_t>(2), frames.size());
+  OLA_ASSERT_EQ(m_frame2, frames[1]);
+  OLA_ASSERT_EQ(m_frame3, frames[2]);
+  CheckFrame(&loader, 1, m_frame4);
+
+  OLA_ASSERT_EQ(ShowLoader::OK, loader.Seek(1300, &frames, &timeout));
+  OLA_ASSERT_EQ(200u, timeout);
+  OLA_ASSERT_EQ(static_cast<size_t>(2), frames.size());
+  OLA_ASSERT_EQ(m_frame4, frames[1]);
+  OLA_ASSERT_EQ(m_frame3, frames[2]);
+  CheckTimeout(&loader, 200);
+
+  OLA_ASSERT_EQ(ShowLoader::END_OF_FILE, loader.Seek(1500, &frames, &timeout));
+}
+
+
+/**
+ * Without an end time, the show ends with the last frame.
+ */
+void BinaryShowTest::testNoTrailingTimeout() {
+  WriteShow(false);
+  BinaryShowLoader loader(m_filename);
+  OLA_ASSERT_TRUE(loader.Load());
+  OLA_ASSERT_EQ(1200u, loader.Duration());
+
+  ShowLoader::UniverseFrames frames;
+  unsigned int timeout = 0;
+  OLA_ASSERT_EQ(ShowLoader::OK, loader.Seek(1100, &frames, &timeout));
+  OLA_ASSERT_EQ(100u, timeout);
+  CheckFrame(&loader, 1, m_frame4);
+  OLA_ASSERT_EQ(ShowLoader::END_OF_FILE, loader.NextTimeout(&timeout));
+}
+
+
+/**
+ * Check that truncated files fail to load.
+ */
+void BinaryShowTest::testTruncated() {
+  WriteShow(true);
+  OLA_ASSERT_EQ(0, truncate(m_filename.c_str(), binary_show::HEADER_SIZE - 1));
+  BinaryShowLoader loader(m_filename);
+  OLA_ASSERT_FALSE(loader.Load());
+
+  // Cut off part of the last index entry.
+  WriteShow(true);
+  std::ifstream show_file(m_filename.c_str(), std::ios::binary);
+  show_file.seekg(0, std::ios::end);
+  off_t size = show_file.tellg();
+  show_file.close();
+  OLA_ASSERT_EQ(0, truncate(m_filename.c_str(), size - 1));
+  BinaryShowLoader loader2(m_filename);
+  OLA_ASSERT_FALSE(loader2.Load());
+}
+
+
+/**
+ * Check that records which run past the end of the record section, or which
+ * contain truncated run length segments, are rejected.
+ */
+void BinaryShowTest::testCorrupt() {
+  unsigned int universe;
+  DmxBuffer data;
+
+  // The record length of the first record.
+  WriteShow(true);
+  const uint8_t length[] = {0xff, 0xff};
+  Overwrite(binary_show::HEADER_SIZE + 11, length, sizeof(length));
+  BinaryShowLoader loader(m_filename);
+  OLA_ASSERT_TRUE(loader.Load());
+  OLA_ASSERT_EQ(ShowLoader::INVALID_LINE, loader.NextFrame(&universe, &data));
+
+  // The first segment of the first record claims more data than it has.
+  WriteShow(true);
+  const uint8_t segment[] = {0x7f};
+  Overwrite(binary_show::HEADER_SIZE + binary_show::RECORD_HEADER_SIZE,
+            segment, sizeof(segment));
+  BinaryShowLoader loader2(m_filename);
+  OLA_ASSERT_TRUE(loader2.Load());
+  OLA_ASSERT_EQ(ShowLoader::INVALID_LINE, loader2.NextFrame(&universe, &data));
+}
+
+
+/**
+ * Write a show with a delta frame and a second sync point.
+ */
+void BinaryShowTest::WriteShow(bool trailing_timeout) {
+  BinaryShowSaver saver(m_filename);
+  OLA_ASSERT_TRUE(saver.Open());
+  SaveFrame(&saver, 0, 1, m_frame1);
+  SaveFrame(&saver, 100, 1, m_frame2);
+  SaveFrame(&saver, 100, 2, m_frame3);
+  SaveFrame(&saver, 1200, 1, m_frame4);
+  if (trailing_timeout) {
+    saver.SetEndTime(m_start + TimeInterval(1500 * 1000));
+  }
+  saver.Close();
+}
+
+
+void BinaryShowTest::SaveFrame(BinaryShowSaver *saver, unsigned int time,
+                               unsigned int universe, const DmxBuffer &data) {
+  OLA_ASSERT_TRUE(saver->NewFrame(m_start + TimeInterval(time * 1000),
+                                  universe, data));
+}
+
+
+void BinaryShowTest::Overwrite(unsigned int offset, const uint8_t *data,
+                               unsigned int length) {
+  std::fstream show_file(m_filename.c_str(),
+                         std::ios::in | std::ios::out | std::ios::binary);
+  OLA_ASSERT_TRUE(show_file.is_open());
+  show_file.seekp(offset);
+  show_file.write(reinterpret_cast<const char*>(data), length);
+}
+
+
+void BinaryShowTest::CheckFrame(BinaryShowLoader *loader,
+                                unsigned int expected_universe,
+                                const DmxBuffer &expected_data) {
+  unsigned int universe = 0;
+  DmxBuffer data;
+  OLA_ASSERT_EQ(ShowLoader::OK, loader->NextFrame(&universe, &data));
+  OLA_ASSERT_EQ(expected_universe, universe);
+  OLA_ASSERT_EQ(expected_data, data);
+}
+
+
+void BinaryShowTest::CheckTimeout(BinaryShowLoader *loader,
+                                  unsigned int expected_timeout) {
+  unsigned int timeout = 0;
+  OLA_ASSERT_EQ(ShowLoader::OK, loader->NextTimeout(&timeout));
+  OLA_ASSERT_EQ(expected_timeout, timeout);
+}
@@ -72,6 +72,11 @@ examples_ola_rdm_discover_LDADD = $(EXAMPLE_COMMON_LIBS)
 
 examples_ola_recorder_SOURCES = \
     examples/ola-recorder.cpp \
+    examples/BinaryShowFormat.h \
+    examples/BinaryShowLoader.h \
+    examples/BinaryShowLoader.cpp \
+    examples/BinaryShowSaver.h \
+    examples/BinaryShowSaver.cpp \
     examples/ShowLoader.h \
     examples/ShowLoader.cpp \
     examples/ShowPlayer.h \
@@ -79,6 +84,8 @@ examples_ola_recorder_SOURCES = \
     examples/ShowRecorder.h \
     examples/ShowRecorder.cpp \
     examples/ShowSaver.h \
+    examples/ShowScheduler.h \
+    examples/ShowScheduler.cpp \
     examples/ShowSaver.cpp
 examples_ola_recorder_LDADD = $(EXAMPLE_COMMON_LIBS)
 
@@ -135,11 +142,42 @@ EXTRA_DIST += \
 
 # TESTS
 ##################################################
+test_programs += \
+    examples/BinaryShowTester \
+    examples/ShowSchedulerTester
+
+examples_BinaryShowTester_SOURCES = \
+    examples/BinaryShowTest.cpp \
+    examples/BinaryShowFormat.h \
+    examples/BinaryShowLoader.h \
+    examples/BinaryShowLoader.cpp \
+    examples/BinaryShowSaver.h \
+    examples/BinaryShowSaver.cpp \
+    examples/ShowLoader.h \
+    examples/ShowSaver.h
+examples_BinaryShowTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+examples_BinaryShowTester_LDADD = $(COMMON_TESTING_LIBS)
+
+examples_ShowSchedulerTester_SOURCES = \
+    examples/ShowSchedulerTest.cpp \
+    examples/ShowScheduler.h \
+    examples/ShowScheduler.cpp
+examples_ShowSchedulerTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+examples_ShowSchedulerTester_LDADD = $(COMMON_TESTING_LIBS)
+
 test_scripts += examples/RecorderVerifyTest.sh
 
 examples/RecorderVerifyTest.sh: examples/Makefile.mk
 	echo "for FILE in ${srcdir}/examples/testdata/dos_line_endings ${srcdir}/examples/testdata/multiple_unis ${srcdir}/examples/testdata/partial_frames ${srcdir}/examples/testdata/single_uni ${srcdir}/examples/testdata/trailing_timeout; do echo \"Checking \$$FILE\"; ${top_builddir}/examples/ola_recorder${EXEEXT} --verify \$$FILE; STATUS=\$$?; if [ \$$STATUS -ne 0 ]; then echo \"FAIL: \$$FILE caused ola_recorder to exit with status \$$STATUS\"; exit \$$STATUS; fi; done; exit 0" > examples/RecorderVerifyTest.sh
 	chmod +x examples/RecorderVerifyTest.sh
 
-CLEANFILES += examples/RecorderVerifyTest.sh
+test_scripts += examples/RecorderConvertTest.sh
+
+examples/RecorderConvertTest.sh: examples/Makefile.mk
+	echo "for FILE in ${srcdir}/examples/testdata/dos_line_endings ${srcdir}/examples/testdata/multiple_unis ${srcdir}/examples/testdata/partial_frames ${srcdir}/examples/testdata/single_uni ${srcdir}/examples/testdata/trailing_timeout; do echo \"Converting \$$FILE\"; BINARY=examples/RecorderConvertTest.\$$\$$.show; TEXT=\$$BINARY.txt; ${top_builddir}/examples/ola_recorder${EXEEXT} --binary --convert \$$FILE --output \$$BINARY || exit 1; ${top_builddir}/examples/ola_recorder${EXEEXT} --convert \$$BINARY --output \$$TEXT || exit 1; ${top_builddir}/examples/ola_recorder${EXEEXT} --verify \$$FILE > \$$BINARY.expected; ${top_builddir}/examples/ola_recorder${EXEEXT} --verify \$$BINARY > \$$BINARY.actual; ${top_builddir}/examples/ola_recorder${EXEEXT} --verify \$$TEXT > \$$TEXT.actual; diff \$$BINARY.expected \$$BINARY.actual && diff \$$BINARY.expected \$$TEXT.actual; STATUS=\$$?; rm -f \$$BINARY \$$TEXT \$$BINARY.expected \$$BINARY.actual \$$TEXT.actual; if [ \$$STATUS -ne 0 ]; then echo \"FAIL: \$$FILE changed when converted to a binary show and back\"; exit \$$STATUS; fi; done; exit 0" > examples/RecorderConvertTest.sh
+	chmod +x examples/RecorderConvertTest.sh
+
+CLEANFILES += \
+    examples/RecorderConvertTest.sh \
+    examples/RecorderVerifyTest.sh
 endif
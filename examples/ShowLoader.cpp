@@ -35,6 +35,7 @@
 #include <string>
 #include <vector>
 
+#include "examples/BinaryShowLoader.h"
 #include "examples/ShowLoader.h"
 
 using std::vector;
@@ -44,6 +45,13 @@ using ola::DmxBuffer;
 
 const char ShowLoader::OLA_SHOW_HEADER[] = "OLA Show";
 
+ShowLoaderInterface *NewShowLoader(const string &filename) {
+  if (BinaryShowLoader::IsBinaryShow(filename)) {
+    return new BinaryShowLoader(filename);
+  }
+  return new ShowLoader(filename);
+}
+
 ShowLoader::ShowLoader(const string &filename)
     : m_filename(filename),
       m_line(0) {
@@ -141,6 +149,41 @@ ShowLoader::State ShowLoader::NextFrame(unsigned int *universe,
 }
 
 
+/**
+ * Move to a point in the show. Text files don't have an index, so this reads
+ * from the start of the file.
+ */
+ShowLoader::State ShowLoader::Seek(unsigned int offset,
+                                   UniverseFrames *frames,
+                                   unsigned int *timeout) {
+  Reset();
+  frames->clear();
+
+  unsigned int frame_time = 0;
+  while (true) {
+    unsigned int universe;
+    DmxBuffer data;
+    State state = NextFrame(&universe, &data);
+    if (state != OK) {
+      return state;
+    }
+    (*frames)[universe] = data;
+
+    unsigned int delay;
+    state = NextTimeout(&delay);
+    if (state != OK) {
+      return state;
+    }
+
+    if (frame_time + delay > offset) {
+      *timeout = frame_time + delay - offset;
+      return OK;
+    }
+    frame_time += delay;
+  }
+}
+
+
 void ShowLoader::ReadLine(string *line) {
   getline(m_show_file, *line);
   ola::StripSuffix(line, "\r");
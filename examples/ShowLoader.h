@@ -20,31 +20,75 @@
 
 #include <ola/DmxBuffer.h>
 
-#include <string>
 #include <fstream>
+#include <map>
+#include <string>
 
 #ifndef EXAMPLES_SHOWLOADER_H_
 #define EXAMPLES_SHOWLOADER_H_
 
 /**
- * Loads a show file and reads the DMX data.
+ * The interface for reading show files.
+ *
+ * Shows are read as a frame, followed by the time to wait before the next
+ * frame, followed by the next frame and so on.
  */
-class ShowLoader {
+class ShowLoaderInterface {
  public:
-  explicit ShowLoader(const std::string &filename);
-  ~ShowLoader();
-
   typedef enum {
     OK,
     INVALID_LINE,
     END_OF_FILE,
   } State;
 
+  // The DMX data for each universe.
+  typedef std::map<unsigned int, ola::DmxBuffer> UniverseFrames;
+
+  virtual ~ShowLoaderInterface() {}
+
+  virtual bool Load() = 0;
+  virtual void Reset() = 0;
+
+  virtual State NextTimeout(unsigned int *timeout) = 0;
+  virtual State NextFrame(unsigned int *universe, ola::DmxBuffer *data) = 0;
+
+  /**
+   * @brief Move to a point in the show.
+   * @param offset the time in ms from the start of the show.
+   * @param[out] frames the data for each universe at that point.
+   * @param[out] timeout the time from offset until the next frame.
+   * @returns OK if there are more frames, END_OF_FILE if the show finishes
+   *   before offset, or INVALID_LINE.
+   */
+  virtual State Seek(unsigned int offset,
+                     UniverseFrames *frames,
+                     unsigned int *timeout) = 0;
+};
+
+
+/**
+ * Create a loader for a show file, this checks if it's a binary or a text
+ * show file.
+ */
+ShowLoaderInterface *NewShowLoader(const std::string &filename);
+
+
+/**
+ * Loads a text show file and reads the DMX data.
+ */
+class ShowLoader : public ShowLoaderInterface {
+ public:
+  explicit ShowLoader(const std::string &filename);
+  ~ShowLoader();
+
   bool Load();
   void Reset();
 
   State NextTimeout(unsigned int *timeout);
   State NextFrame(unsigned int *universe, ola::DmxBuffer *data);
+  State Seek(unsigned int offset,
+             UniverseFrames *frames,
+             unsigned int *timeout);
 
  private:
   const std::string m_filename;
@@ -32,6 +32,8 @@
 #include <ola/base/SysExits.h>
 #include <ola/client/ClientWrapper.h>
 #include <ola/client/OlaClient.h>
+#include <ola/timecode/TimeCode.h>
+#include <ola/timecode/TimeCodeEnums.h>
 #include <fstream>
 #include <iostream>
 #include <string>
@@ -42,10 +44,18 @@
 using std::vector;
 using std::string;
 using ola::DmxBuffer;
+using ola::TimeStamp;
 
+// The rate timecode is sent at, this matches TIMECODE_SMPTE.
+static const unsigned int TIMECODE_FPS = 30;
 
-ShowPlayer::ShowPlayer(const string &filename)
-    : m_loader(filename),
+
+ShowPlayer::ShowPlayer(const string &filename,
+                       ShowScheduler::LatePolicy late_policy,
+                       bool send_timecode)
+    : m_filename(filename),
+      m_late_policy(late_policy),
+      m_send_timecode(send_timecode),
       m_infinite_loop(false),
       m_iteration_remaining(0),
       m_loop_delay(0) {
@@ -59,81 +69,138 @@ int ShowPlayer::Init() {
     return ola::EXIT_UNAVAILABLE;
   }
 
-  if (!m_loader.Load()) {
+  m_loader.reset(NewShowLoader(m_filename));
+  if (!m_loader->Load()) {
     return ola::EXIT_NOINPUT;
   }
+  m_scheduler.reset(new ShowScheduler(m_loader.get(), m_late_policy));
 
   return ola::EXIT_OK;
 }
 
 int ShowPlayer::Playback(unsigned int iterations,
                          unsigned int duration,
-                         unsigned int delay) {
+                         unsigned int delay,
+                         unsigned int start) {
   m_infinite_loop = iterations == 0 || duration != 0;
   m_iteration_remaining = iterations;
   m_loop_delay = delay;
-  SendNextFrame();
+
+  TimeStamp now;
+  m_clock.CurrentTime(&now);
+  ShowScheduler::FrameBatch frames;
+  ShowLoader::State state = m_scheduler->Start(now, start, &frames);
+  if (state == ShowLoader::INVALID_LINE) {
+    return ola::EXIT_DATAERR;
+  }
+  SendFrames(frames);
+  if (state == ShowLoader::END_OF_FILE) {
+    OLA_WARN << "Start offset " << start << "ms is past the end of the show";
+    HandleEndOfFile();
+  } else {
+    SendDueFrames();
+  }
 
   ola::io::SelectServer *ss = m_client.GetSelectServer();
 
+  if (m_send_timecode) {
+    ss->RegisterRepeatingTimeout(
+        1000 / TIMECODE_FPS,
+        ola::NewCallback(this, &ShowPlayer::SendTimeCode));
+  }
+
   if (duration != 0) {
     ss->RegisterSingleTimeout(
         duration * 1000,
         ola::NewSingleCallback(ss, &ola::io::SelectServer::Terminate));
   }
   ss->Run();
+
+  if (m_scheduler->SkippedFrames()) {
+    OLA_INFO << "Skipped " << m_scheduler->SkippedFrames()
+             << " late frames";
+  }
   return ola::EXIT_OK;
 }
 
-void ShowPlayer::SendNextFrame() {
-  DmxBuffer buffer;
-  unsigned int universe;
-  ShowLoader::State state = m_loader.NextFrame(&universe, &buffer);
-  switch (state) {
-    case ShowLoader::END_OF_FILE:
-      HandleEndOfFile();
-      return;
-    case ShowLoader::INVALID_LINE:
-      m_client.GetSelectServer()->Terminate();
-      return;
-    default:
-      {}
+
+/**
+ * Send all frames which are due, and schedule the next ones.
+ */
+void ShowPlayer::SendDueFrames() {
+  TimeStamp now;
+  m_clock.CurrentTime(&now);
+  ShowScheduler::FrameBatch frames;
+  ShowLoader::State state = m_scheduler->FramesDue(now, &frames);
+  if (state == ShowLoader::INVALID_LINE) {
+    m_client.GetSelectServer()->Terminate();
+    return;
   }
 
-  state = RegisterNextTimeout();
-
-  OLA_INFO << "Universe: " << universe << ": " << buffer.ToString();
-  ola::client::SendDMXArgs args;
-  m_client.GetClient()->SendDMX(universe, buffer, args);
-
-  switch (state) {
-    case ShowLoader::END_OF_FILE:
-      HandleEndOfFile();
-      return;
-    case ShowLoader::INVALID_LINE:
-      m_client.GetSelectServer()->Terminate();
-      return;
-    default:
-      {}
+  SendFrames(frames);
+
+  if (state == ShowLoader::END_OF_FILE) {
+    HandleEndOfFile();
+  } else {
+    ScheduleNextFrames();
+  }
+}
+
+
+void ShowPlayer::SendFrames(const ShowScheduler::FrameBatch &frames) {
+  ShowScheduler::FrameBatch::const_iterator iter = frames.begin();
+  for (; iter != frames.end(); ++iter) {
+    OLA_INFO << "Universe: " << iter->first << ": "
+             << iter->second.ToString();
+    ola::client::SendDMXArgs args;
+    m_client.GetClient()->SendDMX(iter->first, iter->second, args);
   }
 }
 
 
 /**
- * Get the next time offset
+ * Register a timeout for the next deadline on the show timeline.
  */
-ShowLoader::State ShowPlayer::RegisterNextTimeout() {
-  unsigned int timeout;
-  ShowLoader::State state = m_loader.NextTimeout(&timeout);
-  if (state != ShowLoader::OK) {
-    return state;
+void ShowPlayer::ScheduleNextFrames() {
+  TimeStamp now;
+  m_clock.CurrentTime(&now);
+  TimeStamp deadline = m_scheduler->NextDeadline();
+  ola::TimeInterval timeout;
+  if (deadline > now) {
+    timeout = deadline - now;
   }
 
-  OLA_INFO << "Registering timeout for " << timeout << "ms";
+  OLA_INFO << "Registering timeout for " << timeout;
   m_client.GetSelectServer()->RegisterSingleTimeout(
       timeout,
-      ola::NewSingleCallback(this, &ShowPlayer::SendNextFrame));
-  return state;
+      ola::NewSingleCallback(this, &ShowPlayer::SendDueFrames));
+}
+
+
+/**
+ * Send the position in the show as timecode.
+ */
+bool ShowPlayer::SendTimeCode() {
+  TimeStamp now;
+  m_clock.CurrentTime(&now);
+  unsigned int position = m_scheduler->Position(now);
+  unsigned int seconds = position / 1000;
+  ola::timecode::TimeCode timecode(
+      ola::timecode::TIMECODE_SMPTE,
+      (seconds / 3600) % 24,
+      (seconds / 60) % 60,
+      seconds % 60,
+      (position % 1000) * TIMECODE_FPS / 1000);
+  m_client.GetClient()->SendTimeCode(
+      timecode, ola::NewSingleCallback(this, &ShowPlayer::TimeCodeSent));
+  return true;
+}
+
+
+void ShowPlayer::TimeCodeSent(const ola::client::Result &result) {
+  if (!result.Success()) {
+    OLA_WARN << "Failed to send timecode: " << result.Error();
+  }
 }
 
 
@@ -143,10 +210,8 @@ ShowLoader::State ShowPlayer::RegisterNextTimeout() {
 void ShowPlayer::HandleEndOfFile() {
   m_iteration_remaining--;
   if (m_infinite_loop || m_iteration_remaining > 0) {
-    m_loader.Reset();
-    m_client.GetSelectServer()->RegisterSingleTimeout(
-        m_loop_delay,
-        ola::NewSingleCallback(this, &ShowPlayer::SendNextFrame));
+    m_scheduler->Loop(m_loop_delay);
+    ScheduleNextFrames();
     return;
   } else {
     // stop the show
@@ -18,13 +18,17 @@
  * Copyright (C) 2011 Simon Newton
  */
 
+#include <ola/Clock.h>
 #include <ola/DmxBuffer.h>
 #include <ola/client/ClientWrapper.h>
+#include <ola/client/Result.h>
 
 #include <string>
 #include <fstream>
+#include <memory>
 
 #include "examples/ShowLoader.h"
+#include "examples/ShowScheduler.h"
 
 #ifndef EXAMPLES_SHOWPLAYER_H_
 #define EXAMPLES_SHOWPLAYER_H_
@@ -37,8 +41,13 @@ class ShowPlayer {
   /**
    * @brief Create a new ShowPlayer
    * @param filename the show file to play
+   * @param late_policy what to do with frames if playback falls behind.
+   * @param send_timecode send SMPTE timecode for the show position.
    */
-  explicit ShowPlayer(const std::string &filename);
+  explicit ShowPlayer(
+      const std::string &filename,
+      ShowScheduler::LatePolicy late_policy = ShowScheduler::CATCH_UP,
+      bool send_timecode = false);
   ~ShowPlayer();
 
   /**
@@ -53,21 +62,30 @@ class ShowPlayer {
    * @param duration the duration in seconds after which playback is stopped.
    * @param delay the hold time at the end of a show before playback starts
    * from the beginning again.
+   * @param start the offset in ms into the show to start playback from.
    */
   int Playback(unsigned int iterations,
                unsigned int duration,
-               unsigned int delay);
+               unsigned int delay,
+               unsigned int start = 0);
 
  private:
   ola::client::OlaClientWrapper m_client;
-  ShowLoader m_loader;
+  const std::string m_filename;
+  std::auto_ptr<ShowLoaderInterface> m_loader;
+  std::auto_ptr<ShowScheduler> m_scheduler;
+  const ShowScheduler::LatePolicy m_late_policy;
+  const bool m_send_timecode;
+  ola::Clock m_clock;
   bool m_infinite_loop;
   unsigned int m_iteration_remaining;
   unsigned int m_loop_delay;
 
-  void SendNextFrame();
-  ShowLoader::State RegisterNextTimeout();
-  bool ReadNextFrame(unsigned int *universe, ola::DmxBuffer *data);
+  void SendDueFrames();
+  void SendFrames(const ShowScheduler::FrameBatch &frames);
+  void ScheduleNextFrames();
+  bool SendTimeCode();
+  void TimeCodeSent(const ola::client::Result &result);
   void HandleEndOfFile();
 };
 #endif  // EXAMPLES_SHOWPLAYER_H_
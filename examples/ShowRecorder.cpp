@@ -38,6 +38,7 @@
 #include <string>
 #include <vector>
 
+#include "examples/BinaryShowSaver.h"
 #include "examples/ShowRecorder.h"
 
 using ola::DmxBuffer;
@@ -47,8 +48,11 @@ using std::vector;
 
 
 ShowRecorder::ShowRecorder(const string &filename,
-                           const vector<unsigned int> &universes)
-    : m_saver(filename),
+                           const vector<unsigned int> &universes,
+                           bool binary)
+    : m_saver(binary ?
+              static_cast<ShowSaverInterface*>(new BinaryShowSaver(filename)) :
+              new ShowSaver(filename)),
       m_universes(universes),
       m_frame_count(0) {
 }
@@ -67,7 +71,7 @@ int ShowRecorder::Init() {
     return ola::EXIT_UNAVAILABLE;
   }
 
-  if (!m_saver.Open()) {
+  if (!m_saver->Open()) {
     return ola::EXIT_CANTCREAT;
   }
 
@@ -110,7 +114,7 @@ void ShowRecorder::NewFrame(const ola::client::DMXMetadata &meta,
                             const ola::DmxBuffer &data) {
   ola::TimeStamp now;
   m_clock.CurrentTime(&now);
-  m_saver.NewFrame(now, meta.universe, data);
+  m_saver->NewFrame(now, meta.universe, data);
   m_frame_count++;
 }
 
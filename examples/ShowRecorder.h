@@ -24,6 +24,7 @@
 #include <stdint.h>
 #include <string>
 #include <fstream>
+#include <memory>
 #include <vector>
 
 #include "examples/ShowSaver.h"
@@ -36,8 +37,15 @@
  */
 class ShowRecorder {
  public:
+  /**
+   * @brief Create a new ShowRecorder
+   * @param filename the show file to write
+   * @param universes the universes to record
+   * @param binary write a binary show file rather than a text one
+   */
   ShowRecorder(const std::string &filename,
-               const std::vector<unsigned int> &universes);
+               const std::vector<unsigned int> &universes,
+               bool binary = false);
   ~ShowRecorder();
 
   int Init();
@@ -48,7 +56,7 @@ class ShowRecorder {
 
  private:
   ola::client::OlaClientWrapper m_client;
-  ShowSaver m_saver;
+  std::auto_ptr<ShowSaverInterface> m_saver;
   std::vector<unsigned int> m_universes;
   ola::Clock m_clock;
   uint64_t m_frame_count;
@@ -68,12 +68,17 @@ bool ShowSaver::Open() {
 
 
 /**
- * Close the show file
+ * Write the delay until the end of the show, and close the show file
  */
 void ShowSaver::Close() {
-  if (m_show_file.is_open()) {
-    m_show_file.close();
+  if (!m_show_file.is_open()) {
+    return;
+  }
+
+  if (m_last_frame.IsSet() && m_end_time > m_last_frame) {
+    m_show_file << (m_end_time - m_last_frame).InMilliSeconds() << endl;
   }
+  m_show_file.close();
 }
 
 
@@ -94,3 +99,8 @@ bool ShowSaver::NewFrame(const ola::TimeStamp &arrival_time,
   m_show_file << universe << " " << data.ToString() << endl;
   return true;
 }
+
+
+void ShowSaver::SetEndTime(const ola::TimeStamp &end_time) {
+  m_end_time = end_time;
+}
@@ -27,10 +27,34 @@
 #ifndef EXAMPLES_SHOWSAVER_H_
 #define EXAMPLES_SHOWSAVER_H_
 
+/**
+ * The interface for writing show files.
+ */
+class ShowSaverInterface {
+ public:
+  virtual ~ShowSaverInterface() {}
+
+  virtual bool Open() = 0;
+  virtual void Close() = 0;
+
+  virtual bool NewFrame(const ola::TimeStamp &arrival_time,
+                        unsigned int universe,
+                        const ola::DmxBuffer &data) = 0;
+
+  /**
+   * @brief Set the time the show ends, this must be called before Close().
+   *
+   * If this is after the last frame, the show pauses for the difference
+   * before ending.
+   */
+  virtual void SetEndTime(const ola::TimeStamp &end_time) = 0;
+};
+
+
 /**
  * Write show data to a file.
  */
-class ShowSaver {
+class ShowSaver : public ShowSaverInterface {
  public:
   explicit ShowSaver(const std::string &filename);
   ~ShowSaver();
@@ -41,11 +65,13 @@ class ShowSaver {
   bool NewFrame(const ola::TimeStamp &arrival_time,
                 unsigned int universe,
                 const ola::DmxBuffer &data);
+  void SetEndTime(const ola::TimeStamp &end_time);
 
  private:
   const std::string m_filename;
   std::ofstream m_show_file;
   ola::TimeStamp m_last_frame;
+  ola::TimeStamp m_end_time;
 
   static const char OLA_SHOW_HEADER[];
 };
@@ -0,0 +1,137 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * ShowScheduler.cpp
+ * Works out which frames of a show are due.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <ola/Clock.h>
+#include <ola/DmxBuffer.h>
+#include <utility>
+
+#include "examples/ShowScheduler.h"
+
+using ola::DmxBuffer;
+using ola::TimeInterval;
+using ola::TimeStamp;
+
+ShowScheduler::ShowScheduler(ShowLoaderInterface *loader,
+                             LatePolicy policy)
+    : m_loader(loader),
+      m_policy(policy),
+      m_next_time(0),
+      m_end_of_show(false),
+      m_skipped_frames(0) {
+}
+
+
+ShowLoaderInterface::State ShowScheduler::Start(const TimeStamp &now,
+                                                unsigned int offset,
+                                                FrameBatch *frames) {
+  m_anchor = now - TimeInterval(static_cast<int64_t>(offset) * 1000);
+  m_next_time = 0;
+  m_end_of_show = false;
+
+  if (!offset) {
+    m_loader->Reset();
+    return ShowLoaderInterface::OK;
+  }
+
+  ShowLoaderInterface::UniverseFrames state;
+  unsigned int timeout = 0;
+  ShowLoaderInterface::State result = m_loader->Seek(offset, &state,
+                                                     &timeout);
+  ShowLoaderInterface::UniverseFrames::const_iterator iter = state.begin();
+  for (; iter != state.end(); ++iter) {
+    frames->push_back(*iter);
+  }
+
+  m_next_time = offset + timeout;
+  m_end_of_show = result != ShowLoaderInterface::OK;
+  return result;
+}
+
+
+ShowLoaderInterface::State ShowScheduler::FramesDue(const TimeStamp &now,
+                                                    FrameBatch *frames) {
+  uint64_t position = Position(now);
+  while (!m_end_of_show && m_next_time <= position) {
+    unsigned int universe;
+    DmxBuffer data;
+    ShowLoaderInterface::State state = m_loader->NextFrame(&universe, &data);
+    if (state == ShowLoaderInterface::INVALID_LINE) {
+      return state;
+    } else if (state == ShowLoaderInterface::END_OF_FILE) {
+      m_end_of_show = true;
+      break;
+    }
+    AddFrame(universe, data, frames);
+
+    unsigned int timeout;
+    state = m_loader->NextTimeout(&timeout);
+    if (state == ShowLoaderInterface::INVALID_LINE) {
+      return state;
+    } else if (state == ShowLoaderInterface::END_OF_FILE) {
+      m_end_of_show = true;
+      break;
+    }
+    m_next_time += timeout;
+  }
+  return m_end_of_show ? ShowLoaderInterface::END_OF_FILE :
+                         ShowLoaderInterface::OK;
+}
+
+
+void ShowScheduler::Loop(unsigned int delay) {
+  // m_next_time is the end of the show, including any trailing timeout.
+  m_anchor += TimeInterval(static_cast<int64_t>(m_next_time + delay) * 1000);
+  m_next_time = 0;
+  m_end_of_show = false;
+  m_loader->Reset();
+}
+
+
+TimeStamp ShowScheduler::NextDeadline() const {
+  return m_anchor + TimeInterval(static_cast<int64_t>(m_next_time) * 1000);
+}
+
+
+unsigned int ShowScheduler::Position(const TimeStamp &now) const {
+  if (now <= m_anchor) {
+    return 0;
+  }
+  return (now - m_anchor).InMilliSeconds();
+}
+
+
+/**
+ * Add a frame to the batch, applying the late policy.
+ */
+void ShowScheduler::AddFrame(unsigned int universe, const DmxBuffer &data,
+                             FrameBatch *frames) {
+  if (m_policy == SKIP_LATE) {
+    // An earlier frame for this universe in the batch has been superseded.
+    FrameBatch::iterator iter = frames->begin();
+    for (; iter != frames->end(); ++iter) {
+      if (iter->first == universe) {
+        iter->second = data;
+        m_skipped_frames++;
+        return;
+      }
+    }
+  }
+  frames->push_back(std::make_pair(universe, data));
+}
@@ -0,0 +1,114 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * ShowScheduler.h
+ * Works out which frames of a show are due.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <ola/Clock.h>
+#include <ola/DmxBuffer.h>
+#include <stdint.h>
+
+#include <utility>
+#include <vector>
+
+#include "examples/ShowLoader.h"
+
+#ifndef EXAMPLES_SHOWSCHEDULER_H_
+#define EXAMPLES_SHOWSCHEDULER_H_
+
+/**
+ * @brief Schedules show frames against an absolute timeline.
+ *
+ * The timeline is anchored to the TimeStamp of the start of the show, and
+ * each frame is due at the anchor plus the sum of the recorded delays. Since
+ * deadlines don't depend on when the previous frame was actually sent,
+ * scheduling and processing delays don't accumulate over the show.
+ */
+class ShowScheduler {
+ public:
+  /**
+   * @brief What to do with frames that are overdue.
+   */
+  typedef enum {
+    CATCH_UP,  /**< Send every overdue frame, in order. */
+    SKIP_LATE,  /**< Only send the latest overdue frame for each universe. */
+  } LatePolicy;
+
+  typedef std::vector<std::pair<unsigned int, ola::DmxBuffer> > FrameBatch;
+
+  /**
+   * @brief Create a new ShowScheduler
+   * @param loader the show to schedule, ownership is not transferred.
+   * @param policy the policy for overdue frames.
+   */
+  explicit ShowScheduler(ShowLoaderInterface *loader,
+                         LatePolicy policy = CATCH_UP);
+
+  /**
+   * @brief Start the show.
+   * @param now the current time, which becomes the anchor for offset.
+   * @param offset the offset in ms into the show to start from.
+   * @param frames filled with the state of each universe at offset.
+   */
+  ShowLoaderInterface::State Start(const ola::TimeStamp &now,
+                                   unsigned int offset,
+                                   FrameBatch *frames);
+
+  /**
+   * @brief Collect the frames which are due.
+   * @param now the current time
+   * @param frames the frames to send, in order.
+   * @returns END_OF_FILE once the last frame has been returned.
+   */
+  ShowLoaderInterface::State FramesDue(const ola::TimeStamp &now,
+                                       FrameBatch *frames);
+
+  /**
+   * @brief Restart the show once it's ended.
+   * @param delay the time in ms between the end of the show and the start of
+   *   the next iteration.
+   */
+  void Loop(unsigned int delay);
+
+  /**
+   * @brief The time the next frame is due.
+   */
+  ola::TimeStamp NextDeadline() const;
+
+  /**
+   * @brief The position in the show, in ms.
+   */
+  unsigned int Position(const ola::TimeStamp &now) const;
+
+  /**
+   * @brief The number of frames dropped by the SKIP_LATE policy.
+   */
+  unsigned int SkippedFrames() const { return m_skipped_frames; }
+
+ private:
+  ShowLoaderInterface *m_loader;
+  const LatePolicy m_policy;
+  ola::TimeStamp m_anchor;
+  // The offset of the next frame from the anchor, in ms.
+  uint64_t m_next_time;
+  bool m_end_of_show;
+  unsigned int m_skipped_frames;
+
+  void AddFrame(unsigned int universe, const ola::DmxBuffer &data,
+                FrameBatch *frames);
+};
+#endif  // EXAMPLES_SHOWSCHEDULER_H_
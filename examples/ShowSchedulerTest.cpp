@@ -0,0 +1,317 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * ShowSchedulerTest.cpp
+ * Test fixture for the ShowScheduler class.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdint.h>
+#include <algorithm>
+
+#include "examples/ShowLoader.h"
+#include "examples/ShowScheduler.h"
+#include "ola/Clock.h"
+#include "ola/DmxBuffer.h"
+#include "ola/Logging.h"
+#include "ola/testing/TestUtils.h"
+
+using ola::DmxBuffer;
+using ola::TimeInterval;
+using ola::TimeStamp;
+
+namespace {
+
+const unsigned int FRAME_INTERVAL = 25;  // ms
+const unsigned int UNIVERSE_COUNT = 3;
+
+/**
+ * A show where every FRAME_INTERVAL, each of UNIVERSE_COUNT universes gets a
+ * frame. The tick number is stored in the first three slots.
+ */
+class SyntheticShow : public ShowLoaderInterface {
+ public:
+  explicit SyntheticShow(unsigned int ticks)
+      : m_ticks(ticks),
+        m_tick(0),
+        m_universe(0),
+        m_timeout(0) {
+  }
+
+  bool Load() { return true; }
+
+  void Reset() {
+    m_tick = 0;
+    m_universe = 0;
+  }
+
+  State NextTimeout(unsigned int *timeout) {
+    if (m_tick >= m_ticks) {
+      return END_OF_FILE;
+    }
+    *timeout = m_timeout;
+    return OK;
+  }
+
+  State NextFrame(unsigned int *universe, DmxBuffer *data) {
+    if (m_tick >= m_ticks) {
+      return END_OF_FILE;
+    }
+    *universe = m_universe;
+    data->Set(Frame(m_tick));
+
+    m_timeout = 0;
+    if (++m_universe == UNIVERSE_COUNT) {
+      m_universe = 0;
+      m_tick++;
+      m_timeout = FRAME_INTERVAL;
+    }
+    return OK;
+  }
+
+  State Seek(unsigned int offset, UniverseFrames *frames,
+             unsigned int *timeout) {
+    unsigned int tick = offset / FRAME_INTERVAL;
+    bool end = tick >= m_ticks;
+    if (end) {
+      tick = m_ticks - 1;
+    }
+    for (unsigned int i = 0; i < UNIVERSE_COUNT; i++) {
+      (*frames)[i] = Frame(tick);
+    }
+    if (end) {
+      return END_OF_FILE;
+    }
+    m_tick = tick + 1;
+    m_universe = 0;
+    *timeout = m_tick * FRAME_INTERVAL - offset;
+    return OK;
+  }
+
+  static DmxBuffer Frame(unsigned int tick) {
+    uint8_t data[] = {
+      static_cast<uint8_t>(tick >> 16),
+      static_cast<uint8_t>(tick >> 8),
+      static_cast<uint8_t>(tick)
+    };
+    return DmxBuffer(data, sizeof(data));
+  }
+
+  static unsigned int Tick(const DmxBuffer &data) {
+    const uint8_t *raw = data.GetRaw();
+    return (raw[0] << 16) | (raw[1] << 8) | raw[2];
+  }
+
+ private:
+  const unsigned int m_ticks;
+  unsigned int m_tick;
+  unsigned int m_universe;
+  unsigned int m_timeout;
+};
+
+TimeInterval MilliSeconds(int64_t ms) {
+  return TimeInterval(ms * 1000);
+}
+}  // namespace
+
+
+class ShowSchedulerTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(ShowSchedulerTest);
+  CPPUNIT_TEST(testDrift);
+  CPPUNIT_TEST(testCatchUp);
+  CPPUNIT_TEST(testSkipLate);
+  CPPUNIT_TEST(testStartOffset);
+  CPPUNIT_TEST(testLoop);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  void setUp() {
+    ola::Clock clock;
+    clock.CurrentTime(&m_start);
+  }
+
+  void testDrift();
+  void testCatchUp();
+  void testSkipLate();
+  void testStartOffset();
+  void testLoop();
+
+ private:
+  TimeStamp m_start;
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(ShowSchedulerTest);
+
+
+/*
+ * Play a 1 hour show, where every wake up is late by up to 2.5ms, and check
+ * the lateness doesn't accumulate.
+ */
+void ShowSchedulerTest::testDrift() {
+  const unsigned int ticks = 3600 * 1000 / FRAME_INTERVAL;
+  SyntheticShow show(ticks);
+  ShowScheduler scheduler(&show);
+  ShowScheduler::FrameBatch frames;
+  OLA_ASSERT_EQ(ShowLoaderInterface::OK,
+                scheduler.Start(m_start, 0, &frames));
+  OLA_ASSERT_TRUE(frames.empty());
+
+  TimeStamp now = m_start;
+  // What relative scheduling would have done, each timeout starts late.
+  int64_t relative_drift = 0;
+  int64_t max_drift = 0;
+  int64_t final_drift = 0;
+  unsigned int frame_count = 0;
+  uint32_t seed = 1;
+  ShowLoaderInterface::State state = ShowLoaderInterface::OK;
+
+  while (state == ShowLoaderInterface::OK) {
+    frames.clear();
+    state = scheduler.FramesDue(now, &frames);
+    OLA_ASSERT_NE(ShowLoaderInterface::INVALID_LINE, state);
+
+    // Every universe recorded in the same tick is sent in one batch.
+    OLA_ASSERT_EQ(static_cast<size_t>(UNIVERSE_COUNT), frames.size());
+    unsigned int tick = SyntheticShow::Tick(frames[0].second);
+    for (unsigned int i = 0; i < frames.size(); i++) {
+      OLA_ASSERT_EQ(i, frames[i].first);
+      OLA_ASSERT_EQ(tick, SyntheticShow::Tick(frames[i].second));
+    }
+    frame_count += frames.size();
+
+    TimeStamp ideal = m_start + MilliSeconds(tick * FRAME_INTERVAL);
+    final_drift = (now - ideal).AsInt();
+    max_drift = std::max(max_drift, final_drift);
+
+    // Wake up between 0.5 and 2.5ms late.
+    seed = seed * 1103515245 + 12345;
+    TimeInterval latency(500 + (seed >> 16) % 2000);
+    relative_drift += latency.AsInt();
+    now = std::max(now, scheduler.NextDeadline()) + latency;
+  }
+
+  OLA_INFO << "Absolute scheduling: max drift " << max_drift
+           << "us, final drift " << final_drift << "us";
+  OLA_INFO << "Relative scheduling would have drifted by "
+           << relative_drift / 1000 << "ms";
+
+  OLA_ASSERT_EQ(ticks * UNIVERSE_COUNT, frame_count);
+  OLA_ASSERT_EQ(0u, scheduler.SkippedFrames());
+  OLA_ASSERT_TRUE(max_drift < 2500);
+  OLA_ASSERT_TRUE(final_drift < 2500);
+  OLA_ASSERT_TRUE(relative_drift > 1000 * 1000 * 60);
+}
+
+
+/*
+ * Check that CATCH_UP sends every overdue frame.
+ */
+void ShowSchedulerTest::testCatchUp() {
+  SyntheticShow show(100);
+  ShowScheduler scheduler(&show, ShowScheduler::CATCH_UP);
+  ShowScheduler::FrameBatch frames;
+  scheduler.Start(m_start, 0, &frames);
+
+  // Stall for a second, ticks 0 - 40 are due.
+  OLA_ASSERT_EQ(ShowLoaderInterface::OK,
+                scheduler.FramesDue(m_start + MilliSeconds(1000), &frames));
+  OLA_ASSERT_EQ(static_cast<size_t>(41 * UNIVERSE_COUNT), frames.size());
+  for (unsigned int i = 0; i < frames.size(); i++) {
+    OLA_ASSERT_EQ(i / UNIVERSE_COUNT, SyntheticShow::Tick(frames[i].second));
+  }
+  OLA_ASSERT_EQ(0u, scheduler.SkippedFrames());
+  OLA_ASSERT_EQ(m_start + MilliSeconds(1025), scheduler.NextDeadline());
+}
+
+
+/*
+ * Check that SKIP_LATE only sends the latest frame for each universe.
+ */
+void ShowSchedulerTest::testSkipLate() {
+  SyntheticShow show(100);
+  ShowScheduler scheduler(&show, ShowScheduler::SKIP_LATE);
+  ShowScheduler::FrameBatch frames;
+  scheduler.Start(m_start, 0, &frames);
+
+  OLA_ASSERT_EQ(ShowLoaderInterface::OK,
+                scheduler.FramesDue(m_start + MilliSeconds(1000), &frames));
+  OLA_ASSERT_EQ(static_cast<size_t>(UNIVERSE_COUNT), frames.size());
+  for (unsigned int i = 0; i < frames.size(); i++) {
+    OLA_ASSERT_EQ(i, frames[i].first);
+    OLA_ASSERT_EQ(40u, SyntheticShow::Tick(frames[i].second));
+  }
+  OLA_ASSERT_EQ(40 * UNIVERSE_COUNT, scheduler.SkippedFrames());
+
+  // Back on time, nothing is skipped.
+  frames.clear();
+  scheduler.FramesDue(m_start + MilliSeconds(1025), &frames);
+  OLA_ASSERT_EQ(static_cast<size_t>(UNIVERSE_COUNT), frames.size());
+  OLA_ASSERT_EQ(40 * UNIVERSE_COUNT, scheduler.SkippedFrames());
+}
+
+
+/*
+ * Check starting part way through a show.
+ */
+void ShowSchedulerTest::testStartOffset() {
+  SyntheticShow show(100);
+  ShowScheduler scheduler(&show);
+  ShowScheduler::FrameBatch frames;
+  OLA_ASSERT_EQ(ShowLoaderInterface::OK,
+                scheduler.Start(m_start, 1010, &frames));
+  OLA_ASSERT_EQ(static_cast<size_t>(UNIVERSE_COUNT), frames.size());
+  OLA_ASSERT_EQ(40u, SyntheticShow::Tick(frames[0].second));
+  OLA_ASSERT_EQ(1010u, scheduler.Position(m_start));
+  OLA_ASSERT_EQ(m_start + MilliSeconds(15), scheduler.NextDeadline());
+
+  frames.clear();
+  scheduler.FramesDue(m_start + MilliSeconds(15), &frames);
+  OLA_ASSERT_EQ(static_cast<size_t>(UNIVERSE_COUNT), frames.size());
+  OLA_ASSERT_EQ(41u, SyntheticShow::Tick(frames[0].second));
+
+  // Past the end of the show
+  frames.clear();
+  OLA_ASSERT_EQ(ShowLoaderInterface::END_OF_FILE,
+                scheduler.Start(m_start, 5000, &frames));
+  OLA_ASSERT_EQ(static_cast<size_t>(UNIVERSE_COUNT), frames.size());
+  OLA_ASSERT_EQ(99u, SyntheticShow::Tick(frames[0].second));
+}
+
+
+/*
+ * Check the next iteration is anchored to the end of the previous one.
+ */
+void ShowSchedulerTest::testLoop() {
+  SyntheticShow show(10);
+  ShowScheduler scheduler(&show);
+  ShowScheduler::FrameBatch frames;
+  scheduler.Start(m_start, 0, &frames);
+
+  // Run the whole show late.
+  OLA_ASSERT_EQ(ShowLoaderInterface::END_OF_FILE,
+                scheduler.FramesDue(m_start + MilliSeconds(500), &frames));
+  OLA_ASSERT_EQ(static_cast<size_t>(10 * UNIVERSE_COUNT), frames.size());
+
+  // The last frame was at 225ms
+  scheduler.Loop(100);
+  OLA_ASSERT_EQ(m_start + MilliSeconds(325), scheduler.NextDeadline());
+
+  frames.clear();
+  OLA_ASSERT_EQ(ShowLoaderInterface::OK,
+                scheduler.FramesDue(m_start + MilliSeconds(325), &frames));
+  OLA_ASSERT_EQ(static_cast<size_t>(UNIVERSE_COUNT), frames.size());
+  OLA_ASSERT_EQ(0u, SyntheticShow::Tick(frames[0].second));
+}
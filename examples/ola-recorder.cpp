@@ -19,6 +19,7 @@
  */
 
 #include <ola/Callback.h>
+#include <ola/Clock.h>
 #include <ola/DmxBuffer.h>
 #include <ola/Logging.h>
 #include <ola/StringUtils.h>
@@ -32,9 +33,11 @@
 #include <string>
 #include <vector>
 
+#include "examples/BinaryShowSaver.h"
 #include "examples/ShowPlayer.h"
 #include "examples/ShowLoader.h"
 #include "examples/ShowRecorder.h"
+#include "examples/ShowSaver.h"
 
 // On MinGW, SignalThread.h pulls in pthread.h which pulls in Windows.h, which
 // needs to be after WinSock2.h, hence this order
@@ -50,6 +53,10 @@ using std::string;
 DEFINE_s_string(playback, p, "", "The show file to playback.");
 DEFINE_s_string(record, r, "", "The show file to record data to.");
 DEFINE_string(verify, "", "The show file to verify.");
+DEFINE_string(convert, "", "The show file to convert, use with --output.");
+DEFINE_s_string(output, o, "", "The file to write the converted show to.");
+DEFINE_default_bool(binary, false,
+                    "Write binary show files when recording or converting.");
 DEFINE_s_string(universes, u, "",
                 "A comma separated list of universes to record");
 DEFINE_s_uint32(delay, d, 0, "The delay in ms between successive iterations.");
@@ -57,6 +64,13 @@ DEFINE_uint32(duration, 0, "The length of time (seconds) to run for.");
 // 0 means infinite looping
 DEFINE_s_uint32(iterations, i, 1,
                 "The number of times to repeat the show, 0 means unlimited.");
+DEFINE_uint32(start, 0, "The offset in ms to start playback from.");
+DEFINE_default_bool(skip_late, false,
+                    "If playback falls behind, skip to the latest frame for "
+                    "each universe rather than sending every frame.");
+DEFINE_default_bool(timecode, false,
+                    "Send SMPTE timecode for the show position during "
+                    "playback.");
 
 void TerminateRecorder(ShowRecorder *recorder) {
   recorder->Stop();
@@ -84,7 +98,7 @@ int RecordShow() {
     universes.push_back(universe);
   }
 
-  ShowRecorder show_recorder(FLAGS_record.str(), universes);
+  ShowRecorder show_recorder(FLAGS_record.str(), universes, FLAGS_binary);
   int status = show_recorder.Init();
   if (status)
     return status;
@@ -110,8 +124,8 @@ int RecordShow() {
  * Verify a show file is valid
  */
 int VerifyShow(const string &filename) {
-  ShowLoader loader(filename);
-  if (!loader.Load())
+  auto_ptr<ShowLoaderInterface> loader(NewShowLoader(filename));
+  if (!loader->Load())
     return ola::EXIT_NOINPUT;
 
   map<unsigned int, unsigned int> frames_by_universe;
@@ -122,12 +136,12 @@ int VerifyShow(const string &filename) {
   unsigned int timeout;
   ShowLoader::State state;
   while (true) {
-    state = loader.NextFrame(&universe, &buffer);
+    state = loader->NextFrame(&universe, &buffer);
     if (state != ShowLoader::OK)
       break;
     frames_by_universe[universe]++;
 
-    state = loader.NextTimeout(&timeout);
+    state = loader->NextTimeout(&timeout);
     if (state != ShowLoader::OK)
       break;
     total_time += timeout;
@@ -154,28 +168,92 @@ int VerifyShow(const string &filename) {
   }
 }
 
+/**
+ * Convert a show file between the text and binary formats
+ */
+int ConvertShow(const string &filename, const string &output) {
+  if (output.empty()) {
+    OLA_FATAL << "No output file specified, use --output";
+    return ola::EXIT_USAGE;
+  }
+
+  auto_ptr<ShowLoaderInterface> loader(NewShowLoader(filename));
+  if (!loader->Load())
+    return ola::EXIT_NOINPUT;
+
+  auto_ptr<ShowSaverInterface> saver;
+  if (FLAGS_binary) {
+    saver.reset(new BinaryShowSaver(output));
+  } else {
+    saver.reset(new ShowSaver(output));
+  }
+  if (!saver->Open())
+    return ola::EXIT_CANTCREAT;
+
+  // The savers work with arrival times, so offset from an arbitrary start.
+  ola::Clock clock;
+  ola::TimeStamp start;
+  clock.CurrentTime(&start);
+  int64_t offset = 0;
+  unsigned int frame_count = 0;
+
+  unsigned int universe;
+  ola::DmxBuffer buffer;
+  unsigned int timeout;
+  ShowLoader::State state;
+  while (true) {
+    state = loader->NextFrame(&universe, &buffer);
+    if (state != ShowLoader::OK)
+      break;
+    saver->NewFrame(start + ola::TimeInterval(offset * 1000), universe,
+                    buffer);
+    frame_count++;
+
+    state = loader->NextTimeout(&timeout);
+    if (state != ShowLoader::OK)
+      break;
+    offset += timeout;
+  }
+  saver->SetEndTime(start + ola::TimeInterval(offset * 1000));
+  saver->Close();
+
+  if (state == ShowLoader::INVALID_LINE) {
+    OLA_FATAL << "Error loading show, got state " << state;
+    return ola::EXIT_DATAERR;
+  }
+  cout << "Converted " << frame_count << " frames" << endl;
+  return ola::EXIT_OK;
+}
+
 /*
  * Main
  */
 int main(int argc, char *argv[]) {
   ola::AppInit(&argc, argv,
                "[--record <file> --universes <universe_list>] [--playback "
-               "<file>] [--verify <file>]",
+               "<file>] [--verify <file>] [--convert <file> --output <file>]",
                "Record a series of universes, or playback a previously "
                "recorded show.");
 
   if (!FLAGS_playback.str().empty()) {
-    ShowPlayer player(FLAGS_playback.str());
+    ShowPlayer player(FLAGS_playback.str(),
+                      FLAGS_skip_late ? ShowScheduler::SKIP_LATE :
+                                        ShowScheduler::CATCH_UP,
+                      FLAGS_timecode);
     int status = player.Init();
     if (!status)
-      status = player.Playback(FLAGS_iterations, FLAGS_duration, FLAGS_delay);
+      status = player.Playback(FLAGS_iterations, FLAGS_duration, FLAGS_delay,
+                               FLAGS_start);
     return status;
   } else if (!FLAGS_record.str().empty()) {
     return RecordShow();
   } else if (!FLAGS_verify.str().empty()) {
     return VerifyShow(FLAGS_verify.str());
+  } else if (!FLAGS_convert.str().empty()) {
+    return ConvertShow(FLAGS_convert.str(), FLAGS_output.str());
   } else {
-    OLA_FATAL << "One of --record or --playback or --verify must be provided";
+    OLA_FATAL << "One of --record, --playback, --verify or --convert must be "
+                 "provided";
     ola::DisplayUsage();
   }
   return ola::EXIT_OK;
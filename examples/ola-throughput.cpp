@@ -25,7 +25,7 @@
 #include <ola/base/Init.h>
 #include <ola/DmxBuffer.h>
 #include <ola/Logging.h>
-#include <ola/StreamingClient.h>
+#include <ola/client/StreamingClient.h>
 #include <ola/StringUtils.h>
 
 #include <iostream>
@@ -34,10 +34,16 @@
 using std::cout;
 using std::endl;
 using std::string;
-using ola::StreamingClient;
+using ola::client::StreamingClient;
 
 DEFINE_s_uint32(universe, u, 1, "The universe to send data on");
 DEFINE_s_uint32(sleep, s, 40000, "Time between DMX updates in micro-seconds");
+DEFINE_default_bool(raw_dmx, false,
+                    "Send raw DMX frames rather than protobufs, this needs a "
+                    "version of olad that supports them");
+DEFINE_default_bool(shared_memory, false,
+                    "Write DMX to shared memory if olad was started with "
+                    "--shared-memory-dmx");
 
 /*
  * Main
@@ -45,7 +51,10 @@ DEFINE_s_uint32(sleep, s, 40000, "Time between DMX updates in micro-seconds");
 int main(int argc, char *argv[]) {
   ola::AppInit(&argc, argv, "[options]", "Send DMX512 data to OLA.");
 
-  StreamingClient ola_client;
+  StreamingClient::Options options;
+  options.raw_dmx = FLAGS_raw_dmx;
+  options.shared_memory = FLAGS_shared_memory;
+  StreamingClient ola_client(options);
   if (!ola_client.Setup()) {
     OLA_FATAL << "Setup failed";
     exit(1);
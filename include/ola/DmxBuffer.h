@@ -117,6 +117,19 @@ class DmxBuffer {
      */
     bool HTPMerge(const DmxBuffer &other);
 
+    /**
+     * @brief Set this DmxBuffer to the HTP merge of many DmxBuffers.
+     *
+     * This is equivalent to calling Reset() followed by HTPMerge() for each
+     * source, but the result is computed in a single pass and doesn't copy
+     * the existing data if it's shared with another DmxBuffer.
+     * @param sources the DmxBuffers to merge, this DmxBuffer may be one of
+     *   them.
+     * @param count the number of sources.
+     * @return false if the merge failed, and true if merge was successful
+     */
+    bool HTPMergeMany(const DmxBuffer *const *sources, unsigned int count);
+
     /**
      * @brief Set the contents of this DmxBuffer
      * @param data is a pointer to an array of uint8_t values
@@ -265,6 +278,9 @@ class DmxBuffer {
     std::string ToString() const;
 
  private:
+    // The number of sources HTPMergeMany() merges in each pass.
+    static const unsigned int MERGE_BATCH_SIZE = 32;
+
     bool Init();
     bool DuplicateIfNeeded();
     void CopyFromOther(const DmxBuffer &other);
@@ -32,6 +32,9 @@
 
 #include <ola/base/Macro.h>
 #include <ola/StringUtils.h>
+#include <ola/thread/Atomic.h>
+#include <ola/thread/Mutex.h>
+#include <stdint.h>
 #include <stdlib.h>
 
 #include <functional>
@@ -170,28 +173,86 @@ class IntegerVariable: public BaseVariable {
 };
 
 
-/*
- * Represents a counter which can only be added to.
+/**
+ * @brief A counter which can only be added to.
+ *
+ * Counters can be updated from any thread without locking. The count is split
+ * into shards, each on its own cache line, and each thread adds to one shard
+ * so that threads don't contend with each other. Get() sums the shards.
+ *
+ * Callers should look up the counter once and keep the pointer, rather than
+ * calling ExportMap::GetCounterVar() for each update.
  */
 class CounterVariable: public BaseVariable {
  public:
-  explicit CounterVariable(const std::string &name)
+  explicit CounterVariable(const std::string &name);
+  ~CounterVariable() {}
+
+  void operator++(int) { Add(1); }
+  void operator+=(unsigned int value) { Add(value); }
+
+  /**
+   * @brief Reset the counter to 0.
+   *
+   * Additions made by other threads while this runs may be lost.
+   */
+  void Reset();
+
+  unsigned int Get() const;
+  const std::string Value() const;
+
+ private:
+  static const unsigned int SHARDS = 8;
+
+  struct Shard {
+    unsigned int value;
+    uint8_t padding[ola::thread::CACHE_LINE_SIZE - sizeof(unsigned int)];
+  };
+
+  Shard m_shards[SHARDS];
+
+  void Add(unsigned int value) {
+    ola::thread::AtomicFetchAdd(&m_shards[ThreadShard()].value, value);
+  }
+
+  static unsigned int ThreadShard();
+
+  DISALLOW_COPY_AND_ASSIGN(CounterVariable);
+};
+
+
+/**
+ * @brief A value which is sampled rather than counted, e.g. a rate.
+ *
+ * The value can be set from one thread and read from any other without
+ * locking. Each Set() replaces the value, so if there's more than one writer
+ * the last one wins.
+ */
+class GaugeVariable: public BaseVariable {
+ public:
+  explicit GaugeVariable(const std::string &name)
       : BaseVariable(name),
         m_value(0) {}
-  ~CounterVariable() {}
+  ~GaugeVariable() {}
+
+  void Set(unsigned int value) {
+    ola::thread::AtomicStoreRelaxed(&m_value, value);
+  }
+
+  unsigned int Get() const {
+    return ola::thread::AtomicLoadRelaxed(&m_value);
+  }
 
-  void operator++(int) { m_value++; }
-  void operator+=(unsigned int value) { m_value += value; }
-  void Reset() { m_value = 0; }
-  unsigned int Get() const { return m_value; }
   const std::string Value() const {
     std::ostringstream out;
-    out << m_value;
+    out << Get();
     return out.str();
   }
 
  private:
   unsigned int m_value;
+
+  DISALLOW_COPY_AND_ASSIGN(GaugeVariable);
 };
 
 
@@ -250,6 +311,195 @@ class UIntMap: public MapVariable<unsigned int> {
 };
 
 
+/**
+ * @brief A map of string -> counter.
+ *
+ * The counters can be updated from any thread. Look up the counter for a key
+ * once with Counter() and then update it directly; the pointer is valid until
+ * the key is removed.
+ */
+class CounterMap: public BaseVariable {
+ public:
+  CounterMap(const std::string &name, const std::string &label)
+      : BaseVariable(name),
+        m_label(label) {}
+  ~CounterMap();
+
+  /**
+   * @brief Lookup or create the counter for a key.
+   * @param key the key to lookup.
+   * @returns the counter for the key.
+   */
+  CounterVariable *Counter(const std::string &key);
+
+  /**
+   * @brief Remove a key, this deletes the counter.
+   * @param key the key to remove.
+   */
+  void Remove(const std::string &key);
+
+  const std::string Value() const;
+  const std::string Label() const { return m_label; }
+
+ private:
+  typedef std::map<std::string, CounterVariable*> CounterMapType;
+
+  mutable ola::thread::Mutex m_mutex;
+  CounterMapType m_counters;
+  std::string m_label;
+
+  DISALLOW_COPY_AND_ASSIGN(CounterMap);
+};
+
+
+/**
+ * @brief A map of string -> gauge.
+ *
+ * Like the CounterMap, look up the gauge for a key once with Gauge() and then
+ * set it directly; the pointer is valid until the key is removed.
+ */
+class GaugeMap: public BaseVariable {
+ public:
+  GaugeMap(const std::string &name, const std::string &label)
+      : BaseVariable(name),
+        m_label(label) {}
+  ~GaugeMap();
+
+  /**
+   * @brief Lookup or create the gauge for a key.
+   * @param key the key to lookup.
+   * @returns the gauge for the key.
+   */
+  GaugeVariable *Gauge(const std::string &key);
+
+  /**
+   * @brief Remove a key, this deletes the gauge.
+   * @param key the key to remove.
+   */
+  void Remove(const std::string &key);
+
+  const std::string Value() const;
+  const std::string Label() const { return m_label; }
+
+ private:
+  typedef std::map<std::string, GaugeVariable*> GaugeMapType;
+
+  mutable ola::thread::Mutex m_mutex;
+  GaugeMapType m_gauges;
+  std::string m_label;
+
+  DISALLOW_COPY_AND_ASSIGN(GaugeMap);
+};
+
+
+/**
+ * @brief A histogram of latencies, in microseconds.
+ *
+ * Values are stored in log-linear buckets: each power of two is split into
+ * 16 buckets, so percentiles are accurate to within about 6%. Recording a
+ * value and reading the histogram are both lock free, so the histogram can
+ * be read from any thread while another thread records into it.
+ *
+ * Values larger than 2^32 - 1 microseconds are clamped.
+ */
+class LatencyHistogram: public BaseVariable {
+ public:
+  explicit LatencyHistogram(const std::string &name);
+  ~LatencyHistogram() {}
+
+  /**
+   * @brief Record a latency.
+   * @param usec the latency in microseconds, negative values are recorded as
+   *   0.
+   */
+  void Record(int64_t usec);
+
+  void Reset();
+
+  /**
+   * @brief The number of values recorded.
+   */
+  uint64_t Count() const;
+
+  /**
+   * @brief The largest value recorded.
+   */
+  uint32_t Max() const;
+
+  /**
+   * @brief Get a percentile.
+   * @param percentile the percentile to fetch, between 0 and 100.
+   * @returns the upper bound of the bucket which contains the percentile, or
+   *   0 if no values have been recorded.
+   */
+  uint32_t Percentile(double percentile) const;
+
+  const std::string Value() const;
+
+ private:
+  static const unsigned int SUB_BUCKET_BITS = 4;
+  static const unsigned int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+  static const unsigned int BUCKETS = SUB_BUCKETS * (33 - SUB_BUCKET_BITS);
+
+  unsigned int m_buckets[BUCKETS];
+  uint32_t m_max;
+
+  static unsigned int BucketIndex(uint32_t value);
+  static uint32_t BucketUpperBound(unsigned int index);
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogram);
+};
+
+
+/**
+ * @brief A map of string keys to LatencyHistograms.
+ *
+ * Like the CounterMap, the pointers returned by Histogram() remain valid until
+ * the key is removed.
+ */
+class LatencyHistogramMap: public BaseVariable {
+ public:
+  LatencyHistogramMap(const std::string &name, const std::string &label)
+      : BaseVariable(name),
+        m_label(label) {}
+  ~LatencyHistogramMap();
+
+  /**
+   * @brief Lookup or create the histogram for a key.
+   * @param key the key to lookup.
+   * @returns the histogram for the key.
+   */
+  LatencyHistogram *Histogram(const std::string &key);
+
+  /**
+   * @brief Remove a key, this deletes the histogram.
+   * @param key the key to remove.
+   */
+  void Remove(const std::string &key);
+
+  const std::string Value() const;
+  const std::string Label() const { return m_label; }
+
+ private:
+  typedef std::map<std::string, LatencyHistogram*> HistogramMapType;
+
+  mutable ola::thread::Mutex m_mutex;
+  HistogramMapType m_histograms;
+  std::string m_label;
+
+  DISALLOW_COPY_AND_ASSIGN(LatencyHistogramMap);
+};
+
+
+/**
+ * @brief The value of a variable at a point in time.
+ */
+struct VariableSnapshot {
+  std::string name;
+  std::string value;
+};
+
+
 /*
  * Return a value from the Map Variable, this will create an entry in the map
  * if the variable doesn't exist.
@@ -371,6 +621,12 @@ class ExportMap {
   IntMap *GetIntMapVar(const std::string &name, const std::string &label = "");
   UIntMap *GetUIntMapVar(const std::string &name,
                          const std::string &label = "");
+  CounterMap *GetCounterMapVar(const std::string &name,
+                               const std::string &label = "");
+  GaugeMap *GetGaugeMapVar(const std::string &name,
+                           const std::string &label = "");
+  LatencyHistogramMap *GetLatencyMapVar(const std::string &name,
+                                        const std::string &label = "");
 
   /**
    * @brief Fetch a list of all known variables.
@@ -378,7 +634,20 @@ class ExportMap {
    */
   std::vector<BaseVariable*> AllVariables() const;
 
+  /**
+   * @brief Take a snapshot of the value of every variable.
+   * @param[out] snapshot the variables, sorted by name.
+   *
+   * No variables can be added while the snapshot is taken, and counters are
+   * read without stopping the threads which update them. This can be called
+   * from any thread, unlike the non-counter variables which must only be used
+   * by the thread that owns them.
+   */
+  void Snapshot(std::vector<VariableSnapshot> *snapshot) const;
+
  private :
+  void SortedVariables(std::vector<BaseVariable*> *variables) const;
+
   template<typename Type>
   Type *GetVar(std::map<std::string, Type*> *var_map,
                const std::string &name);
@@ -396,6 +665,12 @@ class ExportMap {
   std::map<std::string, StringMap*> m_str_map_variables;
   std::map<std::string, IntMap*> m_int_map_variables;
   std::map<std::string, UIntMap*> m_uint_map_variables;
+  std::map<std::string, CounterMap*> m_counter_map_variables;
+  std::map<std::string, GaugeMap*> m_gauge_map_variables;
+  std::map<std::string, LatencyHistogramMap*> m_latency_map_variables;
+
+  // Protects the maps above, so variables can be looked up from any thread.
+  mutable ola::thread::Mutex m_mutex;
 
   DISALLOW_COPY_AND_ASSIGN(ExportMap);
 };
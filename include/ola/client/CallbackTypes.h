@@ -106,6 +106,15 @@ typedef SingleUseCallback2<void, const Result&, const std::vector<OlaUniverse>&>
 typedef SingleUseCallback2<void, const Result&, const OlaUniverse&>
     UniverseInfoCallback;
 
+/**
+ * @brief Invoked when OlaClient::FetchLatencyStats() completes.
+ * @param result the Result of the API call.
+ * @param universes the latency of each universe.
+ */
+typedef SingleUseCallback2<void, const Result&,
+                           const std::vector<UniverseLatency>&>
+    LatencyStatsCallback;
+
 /**
  * @brief Invoked when OlaClient::ConfigureDevice() completes.
  * @param result the Result of the API call.
@@ -133,6 +142,14 @@ typedef SingleUseCallback2<void, const Result&, const ola::rdm::UIDSet&>
 typedef SingleUseCallback3<void, const Result&, const DMXMetadata&,
                            const DmxBuffer&> DMXCallback;
 
+/**
+ * @brief Called once when OlaClient::FetchDMXBatch() completes.
+ * @param result the Result of the API call.
+ * @param frames a vector of UniverseDMX, one for each requested universe.
+ */
+typedef SingleUseCallback2<void, const Result&,
+                           const std::vector<UniverseDMX>&> DMXBatchCallback;
+
 /**
  * @brief Called when new DMX data arrives.
  * @param metadata the DMXMetadata associated with the frame.
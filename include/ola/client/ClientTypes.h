@@ -21,13 +21,16 @@
 #ifndef INCLUDE_OLA_CLIENT_CLIENTTYPES_H_
 #define INCLUDE_OLA_CLIENT_CLIENTTYPES_H_
 
+#include <ola/DmxBuffer.h>
 #include <ola/dmx/SourcePriorities.h>
 #include <ola/rdm/RDMFrame.h>
 #include <ola/rdm/RDMResponseCodes.h>
 
 #include <olad/PortConstants.h>
+#include <stdint.h>
 
 #include <string>
+#include <utility>
 #include <vector>
 
 /**
@@ -273,13 +276,17 @@ class OlaUniverse {
               const std::string &name,
               const std::vector<OlaInputPort> &input_ports,
               const std::vector<OlaOutputPort> &output_ports,
-              unsigned int rdm_device_count):
+              unsigned int rdm_device_count,
+              unsigned int rdm_discovery_queued = 0,
+              unsigned int rdm_discovery_running = 0):
     m_id(id),
     m_merge_mode(m),
     m_name(name),
     m_input_ports(input_ports),
     m_output_ports(output_ports),
-    m_rdm_device_count(rdm_device_count) {}
+    m_rdm_device_count(rdm_device_count),
+    m_rdm_discovery_queued(rdm_discovery_queued),
+    m_rdm_discovery_running(rdm_discovery_running) {}
   ~OlaUniverse() {}
 
   unsigned int Id() const { return m_id;}
@@ -289,6 +296,20 @@ class OlaUniverse {
   unsigned int OutputPortCount() const { return m_output_ports.size(); }
   unsigned int RDMDeviceCount() const { return m_rdm_device_count; }
 
+  /**
+   * @brief The number of output ports waiting to start RDM discovery.
+   */
+  unsigned int RDMDiscoveryQueuedCount() const {
+    return m_rdm_discovery_queued;
+  }
+
+  /**
+   * @brief The number of output ports running RDM discovery.
+   */
+  unsigned int RDMDiscoveryRunningCount() const {
+    return m_rdm_discovery_running;
+  }
+
   const std::vector<OlaInputPort> &InputPorts() const {
     return m_input_ports;
   }
@@ -303,6 +324,51 @@ class OlaUniverse {
   std::vector<OlaInputPort> m_input_ports;
   std::vector<OlaOutputPort> m_output_ports;
   unsigned int m_rdm_device_count;
+  unsigned int m_rdm_discovery_queued;
+  unsigned int m_rdm_discovery_running;
+};
+
+/**
+ * @brief A summary of a latency histogram. All times are in microseconds.
+ *
+ * Percentiles are accurate to within about 6%.
+ */
+struct LatencyStats {
+  /**
+   * @brief The number of DMX frames measured.
+   */
+  uint64_t count;
+  unsigned int p50;
+  unsigned int p90;
+  unsigned int p99;
+  unsigned int p999;
+  unsigned int max;
+
+  LatencyStats() : count(0), p50(0), p90(0), p99(0), p999(0), max(0) {}
+};
+
+/**
+ * @brief The latency of a universe.
+ *
+ * This is the time from DMX data arriving at olad, on an input port or from a
+ * client, until it's written to the output ports.
+ */
+struct UniverseLatency {
+  /**
+   * @brief The universe id.
+   */
+  unsigned int universe;
+  /**
+   * @brief The time until the data was written to all output ports.
+   */
+  LatencyStats latency;
+  /**
+   * @brief The time until the data was written to each output port, keyed by
+   * the unique id of the port.
+   */
+  std::vector<std::pair<std::string, LatencyStats> > output_ports;
+
+  UniverseLatency() : universe(0) {}
 };
 
 /**
@@ -325,6 +391,37 @@ struct DMXMetadata {
   }
 };
 
+/**
+ * @brief The DMX data for one universe, used by the batch methods.
+ */
+struct UniverseDMX {
+  /**
+   * @brief The universe the DMX frame is for.
+   */
+  unsigned int universe;
+  /**
+   * @brief The priority of the DMX frame.
+   */
+  uint8_t priority;
+  /**
+   * @brief The DMX frame.
+   */
+  DmxBuffer data;
+
+  UniverseDMX()
+      : universe(0),
+        priority(ola::dmx::SOURCE_PRIORITY_DEFAULT) {
+  }
+
+  UniverseDMX(unsigned int _universe,
+              const DmxBuffer &_data,
+              uint8_t _priority = ola::dmx::SOURCE_PRIORITY_DEFAULT)
+      : universe(_universe),
+        priority(_priority),
+        data(_data) {
+  }
+};
+
 
 /**
  * @brief Metadata that accompanies RDM Responses.
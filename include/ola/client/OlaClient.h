@@ -189,6 +189,12 @@ class OlaClient {
   void FetchUniverseInfo(unsigned int universe,
                          UniverseInfoCallback *callback);
 
+  /**
+   * @brief Fetch the DMX latency histograms for all universes.
+   * @param callback the LatencyStatsCallback to invoke upon completion.
+   */
+  void FetchLatencyStats(LatencyStatsCallback *callback);
+
   /**
    * @brief Set the name of a universe.
    * @param universe the id of the universe
@@ -248,6 +254,18 @@ class OlaClient {
                const DmxBuffer &data,
                const SendDMXArgs &args);
 
+  /**
+   * @brief Send DMX data for many universes in a single request.
+   *
+   * The universes are updated together; if any of them don't exist in olad,
+   * none of the data is applied.
+   * @param frames the UniverseDMX to send.
+   * @param callback the GeneralSetCallback to invoke upon completion. If
+   *   NULL, the data is streamed and no response is sent.
+   */
+  void SendDMXBatch(const std::vector<UniverseDMX> &frames,
+                    GeneralSetCallback *callback = NULL);
+
   /**
    * @brief Fetch the latest DMX data for a universe.
    * @param universe the universe id to get data for.
@@ -255,6 +273,14 @@ class OlaClient {
    */
   void FetchDMX(unsigned int universe, DMXCallback *callback);
 
+  /**
+   * @brief Fetch the latest DMX data for many universes.
+   * @param universes the universe ids to get data for.
+   * @param callback the DMXBatchCallback to invoke upon completion.
+   */
+  void FetchDMXBatch(const std::vector<unsigned int> &universes,
+                     DMXBatchCallback *callback);
+
   /**
    * @brief Trigger discovery for a universe.
    * @param universe the universe id to run discovery on.
@@ -28,10 +28,14 @@
 #include <ola/Constants.h>
 #include <ola/DmxBuffer.h>
 #include <ola/base/Macro.h>
+#include <ola/client/ClientTypes.h>
 #include <ola/dmx/SourcePriorities.h>
+#include <map>
+#include <vector>
 
 namespace ola {
 
+namespace dmx { class SharedMemoryUniverseTable; }
 namespace io { class SelectServer; }
 namespace network { class TCPSocket; }
 namespace proto { class OlaServerService_Stub; }
@@ -74,6 +78,8 @@ class StreamingClientInterface {
   virtual bool SendDMX(unsigned int universe,
                        const DmxBuffer &data,
                        const SendArgs &args) = 0;
+
+  virtual bool SendDMXBatch(const std::vector<UniverseDMX> &frames) = 0;
 };
 
 /**
@@ -97,7 +103,12 @@ class StreamingClient : public StreamingClientInterface {
      * Create a new options structure with the default options. This
      * includes automatically starting olad if it's not already running.
      */
-    Options() : auto_start(true), server_port(OLA_DEFAULT_PORT) {}
+    Options()
+        : auto_start(true),
+          server_port(OLA_DEFAULT_PORT),
+          raw_dmx(false),
+          shared_memory(false) {
+    }
 
     /**
      * If true, the client will automatically start olad if it's not
@@ -109,6 +120,20 @@ class StreamingClient : public StreamingClientInterface {
      * The RPC port olad is listening on.
      */
     uint16_t server_port;
+
+    /**
+     * If true, DMX data is sent as raw frames rather than protobufs. This
+     * is faster, but requires a version of olad that supports it; older
+     * versions will close the connection.
+     */
+    bool raw_dmx;
+
+    /**
+     * If true, DMX data is written to shared memory rather than sent over the
+     * RPC connection. This requires olad to be running on the same host with
+     * --shared-memory-dmx, if it isn't the RPC connection is used.
+     */
+    bool shared_memory;
   };
 
   /**
@@ -164,18 +189,39 @@ class StreamingClient : public StreamingClientInterface {
                const DmxBuffer &data,
                const SendArgs &args);
 
+  /**
+   * @brief Send DMX data for many universes in a single message.
+   *
+   * If any of the universes don't exist in olad, none of the data is
+   * applied. Frames written to shared memory or sent as raw frames are
+   * applied individually.
+   * @param frames the UniverseDMX to send.
+   * @returns true if sent successfully, false if the connection to the server
+   *   has been closed.
+   */
+  bool SendDMXBatch(const std::vector<UniverseDMX> &frames);
+
   void ChannelClosed(ola::rpc::RpcSession *session);
 
  private:
   bool m_auto_start;
   uint16_t m_server_port;
+  bool m_raw_dmx;
+  bool m_shared_memory;
   ola::network::TCPSocket *m_socket;
   ola::io::SelectServer *m_ss;
   class ola::rpc::RpcChannel *m_channel;
   class ola::proto::OlaServerService_Stub *m_stub;
   bool m_socket_closed;
+  ola::dmx::SharedMemoryUniverseTable *m_shm_table;
+  std::map<unsigned int, unsigned int> m_shm_slots;
 
   bool Send(unsigned int universe, uint8_t priority, const DmxBuffer &data);
+  bool StartSend();
+  bool FinishSend();
+  bool SendSharedMemory(unsigned int universe,
+                        uint8_t priority,
+                        const DmxBuffer &data);
 
   DISALLOW_COPY_AND_ASSIGN(StreamingClient);
 };
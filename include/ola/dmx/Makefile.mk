@@ -1,4 +1,6 @@
 oladmxincludedir = $(pkgincludedir)/dmx/
 oladmxinclude_HEADERS = \
     include/ola/dmx/RunLengthEncoder.h \
+    include/ola/dmx/SharedMemoryUniverseTable.h \
+    include/ola/dmx/SlotKernels.h \
     include/ola/dmx/SourcePriorities.h
@@ -59,7 +59,8 @@ class RunLengthEncoder {
    * @param[in] data the encoded frame.
    * @param[in] length the length of the encoded frame.
    * @param[out] output the DmxBuffer to store the frame in
-   * @returns true if decoding was successful, false otherwise.
+   * @returns true if decoding was successful, false if the last segment was
+   *   truncated. The segments before it are still written to output.
    */
   bool Decode(unsigned int start_channel,
               const uint8_t *data,
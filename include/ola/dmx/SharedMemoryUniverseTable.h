@@ -0,0 +1,227 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SharedMemoryUniverseTable.h
+ * DMX frames passed between processes through shared memory.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @file SharedMemoryUniverseTable.h
+ * @brief DMX frames passed between processes through shared memory.
+ *
+ * olad creates the table, local clients attach to it. The table is an array
+ * of slots, each holding one frame for one universe. A client claims a slot
+ * for a universe and writes frames to it, which olad merges like any other
+ * source. Clients still receive DMX through the RPC UpdateDmxData push.
+ *
+ * Each slot is protected by a sequence lock, so readers never block the
+ * writer. Readers poll for changes by comparing sequence numbers. When a
+ * client writes a frame it calls Notify(), which sends a datagram to olad on
+ * the notification socket, unless there is already one pending. This means a
+ * busy writer doesn't need a system call for every frame.
+ */
+
+#ifndef INCLUDE_OLA_DMX_SHAREDMEMORYUNIVERSETABLE_H_
+#define INCLUDE_OLA_DMX_SHAREDMEMORYUNIVERSETABLE_H_
+
+#include <stdint.h>
+#include <ola/DmxBuffer.h>
+#include <ola/base/Macro.h>
+#include <ola/io/Descriptor.h>
+#include <memory>
+#include <string>
+
+namespace ola {
+namespace dmx {
+
+/**
+ * @brief A table of universe frames in POSIX shared memory.
+ */
+class SharedMemoryUniverseTable {
+ public:
+  /**
+   * @brief The direction of a slot.
+   */
+  enum Direction {
+    INPUT_SLOT = 1,  /**< Written by a client, read by olad */
+  };
+
+  /**
+   * @brief Information about a claimed slot.
+   */
+  struct SlotInfo {
+    Direction direction;
+    unsigned int universe;
+    unsigned int owner;  /**< The pid of the process that claimed the slot */
+  };
+
+  SharedMemoryUniverseTable();
+
+  /**
+   * @brief Destructor, this calls Close().
+   */
+  ~SharedMemoryUniverseTable();
+
+  /**
+   * @brief Create a new table, replacing any existing one with the same name.
+   *
+   * This is called by olad. The creator also owns the notification socket.
+   * @param name the name of the shared memory object, see NameForPort().
+   * @param slot_count the number of slots in the table.
+   * @returns true if the table was created, false otherwise.
+   */
+  bool Create(const std::string &name,
+              unsigned int slot_count = DEFAULT_SLOT_COUNT);
+
+  /**
+   * @brief Attach to an existing table.
+   * @param name the name of the shared memory object, see NameForPort().
+   * @returns true if the table was opened, false otherwise.
+   */
+  bool Attach(const std::string &name);
+
+  /**
+   * @brief Unmap the table. If this end created it, it's also removed.
+   */
+  void Close();
+
+  /**
+   * @brief Check if the table has been created or attached.
+   */
+  bool IsOpen() const { return m_header != NULL; }
+
+  /**
+   * @brief The number of slots in the table.
+   */
+  unsigned int SlotCount() const;
+
+  /**
+   * @brief Claim a free slot.
+   * @param direction the direction of the slot.
+   * @param universe the universe the slot is for.
+   * @returns the slot index, or INVALID_SLOT if all slots are in use.
+   */
+  unsigned int ClaimSlot(Direction direction, unsigned int universe);
+
+  /**
+   * @brief Release a slot claimed with ClaimSlot().
+   */
+  void ReleaseSlot(unsigned int slot);
+
+  /**
+   * @brief Release a slot on behalf of another process.
+   *
+   * This is used to clean up after clients which exit without releasing
+   * their slots.
+   * @param slot the slot index.
+   * @param owner the pid the slot is expected to belong to.
+   * @returns true if the slot was released.
+   */
+  bool ReclaimSlot(unsigned int slot, unsigned int owner);
+
+  /**
+   * @brief Get the information for a claimed slot.
+   * @param slot the slot index.
+   * @param[out] info the slot information.
+   * @returns false if the slot isn't in use.
+   */
+  bool GetSlotInfo(unsigned int slot, SlotInfo *info) const;
+
+  /**
+   * @brief Write a frame to a slot.
+   *
+   * Only one process should write to each slot.
+   * @param slot the slot index.
+   * @param priority the priority of the data.
+   * @param buffer the DMX data.
+   */
+  void Write(unsigned int slot, uint8_t priority, const DmxBuffer &buffer);
+
+  /**
+   * @brief Read a frame from a slot, if it has changed.
+   * @param slot the slot index.
+   * @param[in,out] sequence the sequence number of the last frame read from
+   *   this slot, this is updated if a new frame is returned. Start with 0.
+   * @param[out] priority the priority of the data.
+   * @param[out] buffer the DMX data.
+   * @returns true if a new frame was read, false if the slot hasn't changed
+   *   or a consistent copy couldn't be read.
+   */
+  bool Read(unsigned int slot,
+            uint32_t *sequence,
+            uint8_t *priority,
+            DmxBuffer *buffer) const;
+
+  /**
+   * @brief Wake up the creator of the table, unless it's already been woken.
+   */
+  void Notify();
+
+  /**
+   * @brief The descriptor notifications arrive on.
+   *
+   * This is only available to the creator of the table. Once the descriptor
+   * is readable call ClearNotifications() and then check the slots.
+   * @returns the descriptor, or NULL if this end didn't create the table.
+   */
+  ola::io::UnmanagedFileDescriptor *NotificationDescriptor() {
+    return m_notify_descriptor.get();
+  }
+
+  /**
+   * @brief Drain the notification socket and allow new notifications.
+   */
+  void ClearNotifications();
+
+  /**
+   * @brief Get the shared memory name used by the olad on a RPC port.
+   */
+  static std::string NameForPort(uint16_t port);
+
+  /**
+   * @brief The default number of slots.
+   */
+  static const unsigned int DEFAULT_SLOT_COUNT = 64;
+
+  /**
+   * @brief Returned by ClaimSlot() if there are no free slots.
+   */
+  static const unsigned int INVALID_SLOT = 0xffffffff;
+
+ private:
+  struct SegmentHeader;
+  struct Slot;
+
+  SegmentHeader *m_header;
+  Slot *m_slots;
+  size_t m_size;
+  bool m_creator;
+  int m_notify_fd;
+  std::string m_name;
+  std::string m_socket_path;
+  std::auto_ptr<ola::io::UnmanagedFileDescriptor> m_notify_descriptor;
+
+  bool Map(int fd, size_t size);
+  bool OpenNotificationSocket(bool bind_socket);
+  Slot *GetSlot(unsigned int slot) const;
+
+  static std::string SocketPath(const std::string &name);
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryUniverseTable);
+};
+}  // namespace dmx
+}  // namespace ola
+#endif  // INCLUDE_OLA_DMX_SHAREDMEMORYUNIVERSETABLE_H_
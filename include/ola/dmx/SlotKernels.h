@@ -0,0 +1,159 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * SlotKernels.h
+ * Bulk operations on arrays of DMX slots.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @file SlotKernels.h
+ * @brief Bulk operations on arrays of DMX slots.
+ *
+ * These are the inner loops used when merging, comparing and copying DMX
+ * data. On x86 there are SSE2 and AVX2 implementations and on ARM a NEON
+ * one, the best implementation the CPU supports is selected the first time
+ * any of these functions are called.
+ */
+
+#ifndef INCLUDE_OLA_DMX_SLOTKERNELS_H_
+#define INCLUDE_OLA_DMX_SLOTKERNELS_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+namespace ola {
+namespace dmx {
+
+/**
+ * @brief The implementations of the slot kernels.
+ */
+typedef enum {
+  SLOT_KERNEL_SCALAR,  /**< Plain C++, always available */
+  SLOT_KERNEL_SSE2,  /**< x86 SSE2 */
+  SLOT_KERNEL_AVX2,  /**< x86 AVX2 */
+  SLOT_KERNEL_NEON,  /**< ARM NEON */
+} SlotKernelType;
+
+/**
+ * @brief Check if a slot kernel implementation can be used on this machine.
+ * @param type the implementation to check.
+ * @returns true if the implementation was compiled in and the CPU supports
+ *   it.
+ */
+bool SlotKernelSupported(SlotKernelType type);
+
+/**
+ * @brief Return the slot kernel implementation in use.
+ */
+SlotKernelType ActiveSlotKernel();
+
+/**
+ * @brief Override the slot kernel implementation.
+ *
+ * This is intended for tests and benchmarks, it must be called before any
+ * other threads use the slot kernels.
+ * @param type the implementation to use.
+ * @returns false if the implementation isn't supported on this machine, in
+ *   which case the active implementation is left unchanged.
+ */
+bool SetSlotKernel(SlotKernelType type);
+
+/**
+ * @brief Return the name of a slot kernel implementation.
+ */
+std::string SlotKernelName(SlotKernelType type);
+
+/**
+ * @brief HTP merge one array of slots into another.
+ * @param[in,out] dest the slots to merge into, dest[i] = max(dest[i], src[i])
+ * @param src the slots to merge from.
+ * @param length the number of slots.
+ */
+void MaxSlots(uint8_t *dest, const uint8_t *src, unsigned int length);
+
+/**
+ * @brief HTP merge many arrays of slots in a single pass.
+ *
+ * Sources may have different lengths, a source doesn't contribute to slots
+ * past its length.
+ * @param[out] dest where to write the merged slots, this must have space for
+ *   the longest source. dest may also be one of the sources.
+ * @param sources the arrays of slots to merge.
+ * @param lengths the length of each source.
+ * @param count the number of sources.
+ * @returns the length of the longest source, which is the number of slots
+ *   written to dest.
+ */
+unsigned int MaxSlotsMany(uint8_t *dest,
+                          const uint8_t *const *sources,
+                          const unsigned int *lengths,
+                          unsigned int count);
+
+/**
+ * @brief Check if two arrays of slots are the same.
+ * @param a the first array of slots.
+ * @param b the second array of slots.
+ * @param length the number of slots to compare.
+ * @returns true if the first length slots are equal.
+ */
+bool SlotsEqual(const uint8_t *a, const uint8_t *b, unsigned int length);
+
+/**
+ * @brief Build a mask of the slots which differ between two arrays.
+ * @param a the first array of slots.
+ * @param b the second array of slots.
+ * @param[out] mask set to 0xff for each slot that differs, 0 otherwise. This
+ *   must have space for length bytes.
+ * @param length the number of slots to compare.
+ */
+void SlotDiffMask(const uint8_t *a, const uint8_t *b, uint8_t *mask,
+                  unsigned int length);
+
+/**
+ * @brief Build a bitmap of the slots which have changed.
+ * @param old_slots the previous slot values.
+ * @param new_slots the new slot values.
+ * @param[out] bitmap bit (i % 8) of byte (i / 8) is set if slot i changed.
+ *   This must have space for (length + 7) / 8 bytes.
+ * @param length the number of slots to compare.
+ * @returns the number of slots that changed.
+ */
+unsigned int ChangedSlotBitmap(const uint8_t *old_slots,
+                               const uint8_t *new_slots,
+                               uint8_t *bitmap,
+                               unsigned int length);
+
+/**
+ * @brief LTP copy an array of slots.
+ *
+ * The C library's memcpy is already vectorized, so this is simply a memcpy,
+ * it exists so all the slot operations can be found in one place.
+ */
+inline void CopySlots(uint8_t *dest, const uint8_t *src, unsigned int length) {
+  memcpy(dest, src, length);
+}
+
+/**
+ * @brief Set an array of slots to a single value.
+ * @sa CopySlots
+ */
+inline void FillSlots(uint8_t *dest, uint8_t value, unsigned int length) {
+  memset(dest, value, length);
+}
+}  // namespace dmx
+}  // namespace ola
+#endif  // INCLUDE_OLA_DMX_SLOTKERNELS_H_
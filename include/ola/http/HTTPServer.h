@@ -102,6 +102,15 @@ class HTTPResponse {
     m_status_code(MHD_HTTP_OK) {}
 
   void Append(const std::string &data) { m_data.append(data); }
+
+  /**
+   * @brief The buffer the response body is built in.
+   *
+   * This can be passed to a JsonStreamWriter so the body is written in place,
+   * then call Send().
+   */
+  std::string *Body() { return &m_data; }
+
   void SetContentType(const std::string &type);
   void SetHeader(const std::string &key, const std::string &value);
   void SetStatus(unsigned int status) { m_status_code = status; }
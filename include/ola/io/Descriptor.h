@@ -161,6 +161,16 @@ class ReadFileDescriptor {
    * This is usually called by the SelectServer.
    */
   virtual void PerformRead() = 0;
+
+  /**
+   * @brief Check if PerformRead() reads until the descriptor would block.
+   *
+   * If the SelectServer is using edge-triggered events, descriptors which
+   * return true are only woken up when new data arrives, rather than on every
+   * iteration while data remains.
+   * @returns true if PerformRead() drains the descriptor, false otherwise.
+   */
+  virtual bool ReadsUntilEmpty() const { return false; }
 };
 
 
@@ -255,11 +265,25 @@ class UnmanagedFileDescriptor: public BidirectionalFileDescriptor {
   DescriptorHandle ReadDescriptor() const { return m_handle; }
   DescriptorHandle WriteDescriptor() const { return m_handle; }
 
+  /**
+   * @brief Indicate that the on-data callback reads until the descriptor
+   *   would block.
+   * @param reads_until_empty true if the callback drains the descriptor.
+   * @sa ReadFileDescriptor::ReadsUntilEmpty()
+   */
+  void SetReadsUntilEmpty(bool reads_until_empty) {
+    m_reads_until_empty = reads_until_empty;
+  }
+
+  bool ReadsUntilEmpty() const { return m_reads_until_empty; }
+
  protected:
   // This is only protected because WIN32-specific subclasses need access.
   DescriptorHandle m_handle;
 
  private:
+  bool m_reads_until_empty;
+
   DISALLOW_COPY_AND_ASSIGN(UnmanagedFileDescriptor);
 };
 
@@ -66,6 +66,10 @@ class SelectServer: public SelectServerInterface {
    public:
     Options()
         : force_select(false),
+          use_timer_wheel(false),
+          use_io_uring(false),
+          poll_batch_size(0),
+          edge_triggered(false),
           export_map(NULL),
           clock(NULL) {
     }
@@ -76,6 +80,48 @@ class SelectServer: public SelectServerInterface {
      */
     bool force_select;
 
+    /**
+     * @brief Use a hierarchical timer wheel for timeouts.
+     *
+     * This is faster when there are many timeouts, but timeouts may fire up
+     * to 1ms late. The --use-timer-wheel flag also enables this.
+     */
+    bool use_timer_wheel;
+
+    /**
+     * @brief Use io_uring rather than epoll.
+     *
+     * If the kernel doesn't support io_uring this falls back to epoll. The
+     * --use-io-uring flag also enables this.
+     */
+    bool use_io_uring;
+
+    /**
+     * @brief The maximum number of events to handle from each call to
+     * epoll_wait().
+     *
+     * 0 uses the value of --poll-batch-size. This is only used with epoll and
+     * io_uring.
+     */
+    unsigned int poll_batch_size;
+
+    /**
+     * @brief Use edge-triggered events for descriptors that read until they
+     * are empty.
+     *
+     * @sa ReadFileDescriptor::ReadsUntilEmpty(). This is only used with epoll,
+     * the --poll-edge-triggered flag also enables it.
+     */
+    bool edge_triggered;
+
+    /**
+     * @brief Poll without sleeping for up to this long before blocking.
+     *
+     * This uses more CPU but reduces latency, and runs timeouts which are less
+     * than 1ms away on time. Zero disables it. This is only used with epoll.
+     */
+    TimeInterval busy_poll_interval;
+
     /**
      * @brief The export map to use.
      */
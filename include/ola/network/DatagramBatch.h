@@ -0,0 +1,127 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * DatagramBatch.h
+ * Queue UDP datagrams and send them together.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @addtogroup network
+ * @{
+ * @file DatagramBatch.h
+ * @brief Queue UDP datagrams and send them together.
+ * @}
+ */
+
+#ifndef INCLUDE_OLA_NETWORK_DATAGRAMBATCH_H_
+#define INCLUDE_OLA_NETWORK_DATAGRAMBATCH_H_
+
+#include <stdint.h>
+#include <ola/base/Macro.h>
+#include <ola/network/Socket.h>
+#include <ola/network/SocketAddress.h>
+#include <ola/thread/SchedulerInterface.h>
+#include <vector>
+
+namespace ola {
+namespace network {
+
+/**
+ * @brief Collects datagrams so they can be sent with a single call to
+ *   UDPSocketInterface::SendManyTo().
+ *
+ * The data is copied when it's added, so the caller can reuse its buffer
+ * straight away. The storage is kept between flushes, so once the batch has
+ * reached its working size, adding datagrams doesn't allocate.
+ *
+ * If a scheduler is provided, adding the first datagram registers a zero
+ * length timeout which flushes the batch. The SelectServer runs timeouts after
+ * the I/O handlers, so everything queued during one iteration of the loop is
+ * sent together.
+ */
+class DatagramBatch {
+ public:
+  /**
+   * @brief Create a new DatagramBatch.
+   * @param socket the socket to send on, ownership is not transferred.
+   * @param scheduler the scheduler to use to flush the batch, or NULL if
+   *   the caller will call Flush() itself.
+   */
+  explicit DatagramBatch(UDPSocketInterface *socket,
+                         ola::thread::SchedulerInterface *scheduler = NULL)
+      : m_socket(socket),
+        m_scheduler(scheduler),
+        m_flush_timeout(ola::thread::INVALID_TIMEOUT) {
+  }
+
+  /**
+   * @brief Destructor, any queued datagrams are discarded.
+   */
+  ~DatagramBatch();
+
+  /**
+   * @brief Queue a datagram.
+   * @param data the data to send.
+   * @param size the size of the data.
+   * @param destination the IP:Port to send to.
+   */
+  void Add(const uint8_t *data, unsigned int size,
+           const IPV4SocketAddress &destination);
+
+  /**
+   * @brief The number of queued datagrams.
+   */
+  unsigned int Size() const {
+    return static_cast<unsigned int>(m_queued.size());
+  }
+
+  /**
+   * @brief Check if there are any queued datagrams.
+   */
+  bool Empty() const { return m_queued.empty(); }
+
+  /**
+   * @brief Send all the queued datagrams.
+   * @returns the number of datagrams sent.
+   */
+  unsigned int Flush();
+
+  /**
+   * @brief Discard all the queued datagrams.
+   */
+  void Clear();
+
+ private:
+  struct QueuedDatagram {
+    unsigned int offset;
+    unsigned int size;
+    IPV4SocketAddress destination;
+  };
+
+  UDPSocketInterface *m_socket;
+  ola::thread::SchedulerInterface *m_scheduler;
+  ola::thread::timeout_id m_flush_timeout;
+  std::vector<uint8_t> m_data;
+  std::vector<QueuedDatagram> m_queued;
+  std::vector<OutgoingDatagram> m_outgoing;
+
+  void ScheduledFlush();
+
+  DISALLOW_COPY_AND_ASSIGN(DatagramBatch);
+};
+}  // namespace network
+}  // namespace ola
+#endif  // INCLUDE_OLA_NETWORK_DATAGRAMBATCH_H_
@@ -1,6 +1,7 @@
 olanetworkincludedir = $(pkgincludedir)/network/
 olanetworkinclude_HEADERS = \
     include/ola/network/AdvancedTCPConnector.h\
+    include/ola/network/DatagramBatch.h \
     include/ola/network/HealthCheckedConnection.h \
     include/ola/network/IPV4Address.h \
     include/ola/network/Interface.h \
@@ -39,6 +39,29 @@
 namespace ola {
 namespace network {
 
+/**
+ * @brief A datagram to send with UDPSocketInterface::SendManyTo().
+ */
+struct OutgoingDatagram {
+  const uint8_t *data;  /**< The data to send */
+  unsigned int size;  /**< The size of the data */
+  IPV4SocketAddress destination;  /**< The IP:Port to send to */
+};
+
+/**
+ * @brief A buffer to receive a datagram into with
+ *   UDPSocketInterface::RecvMany().
+ */
+struct IncomingDatagram {
+  uint8_t *data;  /**< The buffer to store the data in */
+  /**
+   * The size of the buffer, updated with the number of bytes read. Datagrams
+   * larger than the buffer are truncated.
+   */
+  unsigned int size;
+  IPV4SocketAddress source;  /**< Set to the source of the datagram */
+};
+
 /**
  * @brief The interface for UDPSockets.
  *
@@ -135,6 +158,20 @@ class UDPSocketInterface: public ola::io::BidirectionalFileDescriptor {
   virtual ssize_t SendTo(ola::io::IOVecInterface *data,
                          const IPV4SocketAddress &dest) const = 0;
 
+  /**
+   * @brief Send multiple datagrams, using as few system calls as possible.
+   * @param datagrams the datagrams to send.
+   * @param count the number of datagrams.
+   * @return the number of datagrams sent.
+   *
+   * A datagram that fails to send is logged and skipped, the remaining
+   * datagrams are still sent.
+   *
+   * The default implementation calls SendTo() once per datagram.
+   */
+  virtual unsigned int SendManyTo(const OutgoingDatagram *datagrams,
+                                  unsigned int count) const;
+
   /**
    * @brief Receive data
    * @param buffer the buffer to store the data
@@ -188,6 +225,32 @@ class UDPSocketInterface: public ola::io::BidirectionalFileDescriptor {
                         ssize_t *data_read,
                         IPV4SocketAddress *source) = 0;
 
+  /**
+   * @brief Receive multiple datagrams, using as few system calls as possible.
+   * @param datagrams the buffers to receive into.
+   * @param count the number of buffers.
+   * @return the number of datagrams received, 0 if the receive failed.
+   *
+   * This should be called when the socket is readable. It'll block until the
+   * first datagram arrives and then return any others which are already
+   * queued, up to count.
+   *
+   * The default implementation calls RecvFrom() once and returns a single
+   * datagram, since a second call may block.
+   */
+  virtual unsigned int RecvMany(IncomingDatagram *datagrams,
+                                unsigned int count);
+
+  /**
+   * @brief Make the socket non-blocking and mark it as read until empty.
+   * @return true if it worked, false otherwise.
+   *
+   * This must be called after Init(). The on-data callback must then call
+   * RecvMany() until it returns 0.
+   * @sa ola::io::ReadFileDescriptor::ReadsUntilEmpty()
+   */
+  virtual bool SetReadsUntilEmpty() { return false; }
+
   /**
    * @brief Enable broadcasting for this socket.
    * @return true if it worked, false otherwise
@@ -240,7 +303,8 @@ class UDPSocket: public UDPSocketInterface {
   UDPSocket()
       : UDPSocketInterface(),
         m_handle(ola::io::INVALID_DESCRIPTOR),
-        m_bound_to_port(false) {}
+        m_bound_to_port(false),
+        m_reads_until_empty(false) {}
   ~UDPSocket() { Close(); }
   bool Init();
   bool Bind(const IPV4SocketAddress &endpoint);
@@ -262,6 +326,8 @@ class UDPSocket: public UDPSocketInterface {
                  unsigned short port) const;
   ssize_t SendTo(ola::io::IOVecInterface *data,
                  const IPV4SocketAddress &dest) const;
+  unsigned int SendManyTo(const OutgoingDatagram *datagrams,
+                          unsigned int count) const;
 
   bool RecvFrom(uint8_t *buffer, ssize_t *data_read) const;
   bool RecvFrom(uint8_t *buffer,
@@ -275,6 +341,10 @@ class UDPSocket: public UDPSocketInterface {
   bool RecvFrom(uint8_t *buffer,
                 ssize_t *data_read,
                 IPV4SocketAddress *source);
+  unsigned int RecvMany(IncomingDatagram *datagrams, unsigned int count);
+
+  bool SetReadsUntilEmpty();
+  bool ReadsUntilEmpty() const { return m_reads_until_empty; }
 
   bool EnableBroadcast();
   bool SetMulticastInterface(const IPV4Address &iface);
@@ -289,6 +359,7 @@ class UDPSocket: public UDPSocketInterface {
  private:
   ola::io::DescriptorHandle m_handle;
   bool m_bound_to_port;
+  bool m_reads_until_empty;
 
   DISALLOW_COPY_AND_ASSIGN(UDPSocket);
 };
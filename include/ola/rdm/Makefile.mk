@@ -19,6 +19,7 @@ olardminclude_HEADERS = \
     include/ola/rdm/OpenLightingEnums.h \
     include/ola/rdm/PidStore.h \
     include/ola/rdm/PidStoreHelper.h \
+    include/ola/rdm/PipelinedRDMController.h \
     include/ola/rdm/QueueingRDMController.h \
     include/ola/rdm/RDMAPI.h \
     include/ola/rdm/RDMAPIImplInterface.h \
@@ -0,0 +1,203 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * PipelinedRDMController.h
+ * A RDM Controller that allows a request to each responder to be in flight.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @addtogroup rdm_controller
+ * @{
+ * @file PipelinedRDMController.h
+ * @brief An RDM Controller that queues messages, and sends requests to
+ * different responders in parallel.
+ * @}
+ */
+#ifndef INCLUDE_OLA_RDM_PIPELINEDRDMCONTROLLER_H_
+#define INCLUDE_OLA_RDM_PIPELINEDRDMCONTROLLER_H_
+
+#include <ola/Clock.h>
+#include <ola/base/Macro.h>
+#include <ola/rdm/RDMControllerInterface.h>
+#include <ola/rdm/UID.h>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ola {
+
+class IntegerVariable;
+class LatencyHistogram;
+
+namespace rdm {
+
+/**
+ * @addtogroup rdm_controller
+ * @{
+ */
+
+/**
+ * @brief An RDM controller that allows several requests to be in flight.
+ *
+ * This is for transports that can match responses to requests by UID, such as
+ * Art-Net. At most one request to each UID is in flight at once, so the
+ * requests to a responder are sent in the order they were queued, and a slow
+ * responder doesn't hold up the requests for the others.
+ *
+ * Broadcast and vendorcast requests wait for all the in-flight requests to
+ * complete, and are sent on their own.
+ *
+ * ACK_TIMER responses are passed back to the caller like any other response,
+ * so the follow up GET QUEUED_MESSAGE request is queued behind any other
+ * requests for that responder, rather than blocking the line. ACK_OVERFLOW
+ * responses are combined, as the QueueingRDMController does.
+ */
+class PipelinedRDMController: public RDMControllerInterface {
+ public:
+  /**
+   * @brief Create a new PipelinedRDMController.
+   * @param controller the controller to send requests with, this must be able
+   *   to handle up to max_in_flight requests at once.
+   * @param max_queue_size the maximum number of requests, including the ones
+   *   in flight.
+   * @param max_in_flight the maximum number of requests in flight.
+   */
+  PipelinedRDMController(RDMControllerInterface *controller,
+                         unsigned int max_queue_size,
+                         unsigned int max_in_flight = DEFAULT_MAX_IN_FLIGHT);
+  virtual ~PipelinedRDMController();
+
+  /**
+   * @brief Pause the sending of RDM requests. This won't cancel any requests
+   * in flight.
+   */
+  void Pause();
+
+  /**
+   * @brief Resume the sending of RDM requests.
+   */
+  void Resume();
+
+  /**
+   * @brief Queue an RDM request for sending.
+   */
+  void SendRDMRequest(RDMRequest *request, RDMCallback *on_complete);
+
+  /**
+   * @brief The number of requests waiting to be sent.
+   */
+  unsigned int QueueDepth() const { return m_pending_requests.size(); }
+
+  /**
+   * @brief The number of requests in flight.
+   */
+  unsigned int InFlightCount() const { return m_in_flight.size(); }
+
+  /**
+   * @brief Export the queue depth and the request latency.
+   * @param queue_depth the variable to update with the queue depth, may be
+   *   NULL.
+   * @param latency the histogram to record the time from sending each
+   *   request until the reply is received, may be NULL.
+   *
+   * Ownership of the variables is not transferred.
+   */
+  void SetMetrics(IntegerVariable *queue_depth, LatencyHistogram *latency);
+
+  static const unsigned int DEFAULT_MAX_IN_FLIGHT;
+
+ protected:
+  struct PendingRequest {
+    const RDMRequest *request;
+    RDMCallback *on_complete;
+    TimeStamp sent_time;
+    // Used to combine ACK_OVERFLOW responses
+    std::auto_ptr<RDMResponse> response;
+    RDMFrames frames;
+  };
+
+  typedef std::deque<PendingRequest*> PendingRequests;
+  typedef std::map<UID, PendingRequest*> InFlightRequests;
+
+  RDMControllerInterface *m_controller;
+  const unsigned int m_max_queue_size;
+  const unsigned int m_max_in_flight;
+  PendingRequests m_pending_requests;
+  InFlightRequests m_in_flight;
+  bool m_broadcast_in_flight;
+  bool m_active;  // true if the controller is active
+  bool m_dispatching;
+  Clock m_clock;
+  IntegerVariable *m_queue_depth_var;
+  LatencyHistogram *m_latency_var;
+
+  virtual void TakeNextAction();
+  virtual bool CheckForBlockingCondition();
+  void MaybeSendRDMRequests();
+
+ private:
+  void DispatchRequest(PendingRequest *pending);
+  void HandleRDMResponse(PendingRequest *pending, RDMReply *reply);
+  void CompleteRequest(PendingRequest *pending, RDMReply *reply);
+  void UpdateQueueDepth();
+
+  DISALLOW_COPY_AND_ASSIGN(PipelinedRDMController);
+};
+
+
+/**
+ * @brief A PipelinedRDMController that also handles discovery.
+ *
+ * Discovery has a higher precedence than RDM requests. Once discovery has been
+ * requested, no more RDM requests are sent, and discovery starts when the
+ * requests in flight have completed.
+ */
+class DiscoverablePipelinedRDMController: public PipelinedRDMController {
+ public:
+  DiscoverablePipelinedRDMController(
+      DiscoverableRDMControllerInterface *controller,
+      unsigned int max_queue_size,
+      unsigned int max_in_flight = DEFAULT_MAX_IN_FLIGHT);
+
+  ~DiscoverablePipelinedRDMController() {}
+
+  // These can be called multiple times and the requests will be queued
+  void RunFullDiscovery(RDMDiscoveryCallback *callback);
+  void RunIncrementalDiscovery(RDMDiscoveryCallback *callback);
+
+ private:
+  typedef std::vector<RDMDiscoveryCallback*> DiscoveryCallbacks;
+  typedef std::vector<std::pair<bool, RDMDiscoveryCallback*> >
+      PendingDiscoveryCallbacks;
+
+  DiscoverableRDMControllerInterface *m_discoverable_controller;
+  DiscoveryCallbacks m_discovery_callbacks;
+  PendingDiscoveryCallbacks m_pending_discovery_callbacks;
+
+  void TakeNextAction();
+  bool CheckForBlockingCondition();
+  void GenericDiscovery(RDMDiscoveryCallback *callback, bool full);
+  void StartRDMDiscovery();
+  void DiscoveryComplete(const ola::rdm::UIDSet &uids);
+
+  DISALLOW_COPY_AND_ASSIGN(DiscoverablePipelinedRDMController);
+};
+/** @} */
+}  // namespace rdm
+}  // namespace ola
+#endif  // INCLUDE_OLA_RDM_PIPELINEDRDMCONTROLLER_H_
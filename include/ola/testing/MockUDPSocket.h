@@ -93,6 +93,8 @@ class MockUDPSocket: public ola::network::UDPSocketInterface {
   bool RecvFrom(uint8_t *buffer,
                 ssize_t *data_read,
                 ola::network::IPV4SocketAddress *source);
+  unsigned int RecvMany(ola::network::IncomingDatagram *datagrams,
+                        unsigned int count);
   bool EnableBroadcast();
   bool SetMulticastInterface(const ola::network::IPV4Address &iface);
   bool JoinMulticast(const ola::network::IPV4Address &iface,
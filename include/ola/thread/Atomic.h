@@ -0,0 +1,119 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * Atomic.h
+ * Atomic operations on integers and pointers.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @file Atomic.h
+ * @brief Atomic operations on integers and pointers.
+ *
+ * We still build as C++98, so std::atomic isn't available. These wrap the
+ * GCC / clang __atomic builtins, which take the same memory orders as the C++11
+ * atomics.
+ */
+
+#ifndef INCLUDE_OLA_THREAD_ATOMIC_H_
+#define INCLUDE_OLA_THREAD_ATOMIC_H_
+
+namespace ola {
+namespace thread {
+
+/**
+ * @brief The size of a cache line, used to pad data shared between threads.
+ */
+static const unsigned int CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Load a value, with no ordering constraints.
+ */
+template <typename T>
+inline T AtomicLoadRelaxed(const T *ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Load a value, later reads & writes can't be moved before this.
+ */
+template <typename T>
+inline T AtomicLoadAcquire(const T *ptr) {
+  return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Store a value, with no ordering constraints.
+ */
+template <typename T>
+inline void AtomicStoreRelaxed(T *ptr, T value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Store a value, earlier reads & writes can't be moved after this.
+ */
+template <typename T>
+inline void AtomicStoreRelease(T *ptr, T value) {
+  __atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Replace a value, returning the old one.
+ */
+template <typename T>
+inline T AtomicExchange(T *ptr, T value) {
+  return __atomic_exchange_n(ptr, value, __ATOMIC_ACQ_REL);
+}
+
+/**
+ * @brief Replace a value if it matches the expected one.
+ * @param ptr the value to update.
+ * @param[in,out] expected the expected value, if the update fails this is set
+ *   to the current value.
+ * @param desired the new value.
+ * @returns true if the value was updated.
+ */
+template <typename T>
+inline bool AtomicCompareExchange(T *ptr, T *expected, T desired) {
+  return __atomic_compare_exchange_n(ptr, expected, desired, false,
+                                     __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief Add to a value, returning the old one. There are no ordering
+ *   constraints, so this is suitable for counters.
+ */
+template <typename T>
+inline T AtomicFetchAdd(T *ptr, T value) {
+  return __atomic_fetch_add(ptr, value, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief A fence, reads after this can't be moved before reads prior to it.
+ */
+inline void AtomicFenceAcquire() {
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+/**
+ * @brief A fence, writes after this can't be moved before writes prior to it.
+ */
+inline void AtomicFenceRelease() {
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+}  // namespace thread
+}  // namespace ola
+#endif  // INCLUDE_OLA_THREAD_ATOMIC_H_
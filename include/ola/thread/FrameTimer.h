@@ -0,0 +1,169 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * FrameTimer.h
+ * Precise frame timing for threaded DMX outputs.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#ifndef INCLUDE_OLA_THREAD_FRAMETIMER_H_
+#define INCLUDE_OLA_THREAD_FRAMETIMER_H_
+
+#include <ola/ExportMap.h>
+#include <ola/base/Macro.h>
+#include <stdint.h>
+#include <string>
+
+namespace ola {
+namespace thread {
+
+/**
+ * @brief Times the frames, breaks and MABs of a threaded DMX output.
+ *
+ * Frames are scheduled against absolute deadlines, so the time spent
+ * sending a frame doesn't add to the frame period. Where
+ * clock_nanosleep() is available the thread sleeps until just before each
+ * deadline, and then spins for the last few microseconds, which avoids the
+ * coarse granularity of usleep().
+ *
+ * All methods other than the constructor and destructor should be called
+ * from the output thread. The exported stats can be read from any thread.
+ */
+class FrameTimer {
+ public:
+  struct Options {
+   public:
+    /**
+     * @brief The time to spin before each deadline, in microseconds.
+     */
+    unsigned int spin_time;
+
+    /**
+     * @brief Switch the output thread to SCHED_FIFO.
+     */
+    bool realtime;
+
+    /**
+     * @brief The SCHED_FIFO priority, 0 uses the minimum for the platform.
+     */
+    int priority;
+
+    /**
+     * @brief The CPU to pin the output thread to, or -1 to not pin it.
+     */
+    int cpu;
+
+    Options()
+        : spin_time(DEFAULT_SPIN_TIME),
+          realtime(false),
+          priority(0),
+          cpu(-1) {
+    }
+  };
+
+  /**
+   * @brief Create a new FrameTimer.
+   * @param frame_time the time between the start of each frame, in
+   *   microseconds. 0 means frames are sent back to back.
+   * @param options the Options to use.
+   * @param export_map the ExportMap to export the refresh rate and jitter to,
+   *   may be NULL.
+   * @param name the name of the output, used as the ExportMap key.
+   */
+  FrameTimer(unsigned int frame_time,
+             const Options &options = Options(),
+             ExportMap *export_map = NULL,
+             const std::string &name = "");
+
+  /**
+   * @brief Destructor, this removes the exported stats for the output.
+   */
+  ~FrameTimer();
+
+  /**
+   * @brief Apply the scheduling Options to the calling thread.
+   * @returns true if the options were applied, false otherwise.
+   */
+  bool SetupThread();
+
+  /**
+   * @brief Change the frame time.
+   * @param frame_time the time between the start of each frame, in
+   *   microseconds.
+   */
+  void SetFrameTime(unsigned int frame_time);
+
+  /**
+   * @brief Block until the next frame is due.
+   *
+   * The first call returns immediately. If we fall more than a frame behind,
+   * the schedule restarts from the current time rather than sending a burst
+   * of frames.
+   */
+  void StartFrame();
+
+  /**
+   * @brief Block for a precise interval, e.g. for a break or MAB.
+   * @param delay the time to block for, in microseconds.
+   */
+  void Delay(unsigned int delay);
+
+  /**
+   * @brief The number of frames sent in the last second.
+   */
+  unsigned int FrameRate() const { return m_frame_rate; }
+
+  /**
+   * @brief The largest time in microseconds between when a frame was due and
+   *   when it started, over the last second.
+   */
+  unsigned int Jitter() const { return m_jitter; }
+
+  /**
+   * @brief The number of frames since the FrameTimer was created.
+   */
+  uint64_t FrameCount() const { return m_frame_count; }
+
+  static const char FRAME_RATE_VAR[];
+  static const char JITTER_VAR[];
+
+ private:
+  const Options m_options;
+  const std::string m_name;
+  int64_t m_frame_time;
+  int64_t m_frame_start;
+  int64_t m_window_start;
+  unsigned int m_window_frames;
+  int64_t m_window_jitter;
+  unsigned int m_frame_rate;
+  unsigned int m_jitter;
+  uint64_t m_frame_count;
+  GaugeMap *m_frame_rate_map;
+  GaugeMap *m_jitter_map;
+  GaugeVariable *m_frame_rate_var;
+  GaugeVariable *m_jitter_var;
+
+  void SleepUntil(int64_t deadline);
+  void UpdateStats(int64_t now, int64_t late);
+
+  static int64_t Now();
+
+  static const unsigned int DEFAULT_SPIN_TIME = 100;
+
+  DISALLOW_COPY_AND_ASSIGN(FrameTimer);
+};
+}  // namespace thread
+}  // namespace ola
+#endif  // INCLUDE_OLA_THREAD_FRAMETIMER_H_
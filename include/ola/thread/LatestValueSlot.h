@@ -0,0 +1,122 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * LatestValueSlot.h
+ * Pass the most recent value from one thread to another.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @file LatestValueSlot.h
+ * @brief Pass the most recent value from one thread to another.
+ */
+
+#ifndef INCLUDE_OLA_THREAD_LATESTVALUESLOT_H_
+#define INCLUDE_OLA_THREAD_LATESTVALUESLOT_H_
+
+#include <ola/base/Macro.h>
+#include <ola/thread/Atomic.h>
+
+namespace ola {
+namespace thread {
+
+/**
+ * @brief Pass values from a writer thread to a reader thread, where the reader
+ *   only cares about the most recent value.
+ *
+ * This is a triple buffer, the writer and reader each own one of the values
+ * and the third is swapped between them. Neither side blocks, and values
+ * the reader never got to are overwritten rather than queued, which suits
+ * DMX frames.
+ *
+ * Values are written and read in place, so they're never copied between
+ * threads. For DmxBuffer, copy into and out of the slot with
+ * DmxBuffer::Set(), rather than operator=, so that the slot's data isn't
+ * shared with a buffer on another thread.
+ *
+ * @code
+ *   // writer thread
+ *   slot.Writable()->Set(buffer);
+ *   slot.Publish();
+ *
+ *   // reader thread
+ *   if (slot.Update()) {
+ *     output.Set(slot.Read());
+ *   }
+ * @endcode
+ */
+template <typename T>
+class LatestValueSlot {
+ public:
+  LatestValueSlot()
+      : m_front(0),
+        m_middle(1),
+        m_back(2) {
+  }
+
+  /**
+   * @brief Return the value the writer should fill in, called by the writer.
+   *
+   * This will contain an old value, not necessarily the last one published.
+   */
+  T *Writable() { return &m_values[m_back]; }
+
+  /**
+   * @brief Make the value returned by Writable() available to the reader,
+   *   called by the writer.
+   */
+  void Publish() {
+    m_back = AtomicExchange(&m_middle, m_back | FRESH) & INDEX_MASK;
+  }
+
+  /**
+   * @brief Switch to the latest published value, called by the reader.
+   * @returns true if a new value was published since the last call, false if
+   *   Read() still returns the same value.
+   */
+  bool Update() {
+    if (!(AtomicLoadAcquire(&m_middle) & FRESH)) {
+      return false;
+    }
+    m_front = AtomicExchange(&m_middle, m_front) & INDEX_MASK;
+    return true;
+  }
+
+  /**
+   * @brief Return the value selected by the last call to Update(), called by
+   *   the reader.
+   */
+  const T &Read() const { return m_values[m_front]; }
+
+ private:
+  static const unsigned int INDEX_MASK = 0x3;
+  static const unsigned int FRESH = 0x4;
+
+  T m_values[3];
+  // Owned by the reader.
+  unsigned int m_front;
+  char m_pad0[CACHE_LINE_SIZE];
+  // Shared, the index of the spare value and a flag if it's newer than
+  // m_front.
+  unsigned int m_middle;
+  char m_pad1[CACHE_LINE_SIZE];
+  // Owned by the writer.
+  unsigned int m_back;
+
+  DISALLOW_COPY_AND_ASSIGN(LatestValueSlot);
+};
+}  // namespace thread
+}  // namespace ola
+#endif  // INCLUDE_OLA_THREAD_LATESTVALUESLOT_H_
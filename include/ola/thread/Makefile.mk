@@ -1,13 +1,17 @@
 olathreadincludedir = $(pkgincludedir)/thread/
 olathreadinclude_HEADERS = \
+    include/ola/thread/Atomic.h \
     include/ola/thread/CallbackThread.h \
     include/ola/thread/ConsumerThread.h \
     include/ola/thread/ExecutorInterface.h \
     include/ola/thread/ExecutorThread.h \
+    include/ola/thread/FrameTimer.h \
     include/ola/thread/Future.h \
     include/ola/thread/FuturePrivate.h \
+    include/ola/thread/LatestValueSlot.h \
     include/ola/thread/Mutex.h \
     include/ola/thread/PeriodicThread.h \
+    include/ola/thread/RingBuffer.h \
     include/ola/thread/SchedulerInterface.h \
     include/ola/thread/SchedulingExecutorInterface.h \
     include/ola/thread/SignalThread.h \
@@ -0,0 +1,242 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * RingBuffer.h
+ * Bounded lock-free queues for passing data between threads.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @file RingBuffer.h
+ * @brief Bounded lock-free queues for passing data between threads.
+ *
+ * Values are copied in and out with operator=. Don't use these with types that
+ * share data between copies without atomic reference counts, like DmxBuffer;
+ * use ola::thread::LatestValueSlot for DMX frames instead.
+ */
+
+#ifndef INCLUDE_OLA_THREAD_RINGBUFFER_H_
+#define INCLUDE_OLA_THREAD_RINGBUFFER_H_
+
+#include <ola/base/Macro.h>
+#include <ola/thread/Atomic.h>
+
+namespace ola {
+namespace thread {
+
+/**
+ * @brief Round a ring buffer capacity up to a power of two.
+ * @param capacity the requested capacity.
+ * @returns the smallest power of two >= capacity, with a minimum of 2.
+ */
+inline unsigned int RingBufferCapacity(unsigned int capacity) {
+  unsigned int size = 2;
+  while (size < capacity) {
+    size <<= 1;
+  }
+  return size;
+}
+
+/**
+ * @brief A bounded queue with a single producer thread and a single consumer
+ *   thread.
+ *
+ * Push() must only be called from the producer thread and Pop() from the
+ * consumer thread. Neither call blocks or takes a lock.
+ */
+template <typename T>
+class SPSCRingBuffer {
+ public:
+  /**
+   * @brief Create a new SPSCRingBuffer.
+   * @param capacity the maximum number of queued values, this is rounded up
+   *   to a power of two.
+   */
+  explicit SPSCRingBuffer(unsigned int capacity)
+      : m_mask(RingBufferCapacity(capacity) - 1),
+        m_slots(new T[m_mask + 1]),
+        m_head(0),
+        m_cached_tail(0),
+        m_tail(0),
+        m_cached_head(0) {
+  }
+
+  ~SPSCRingBuffer() { delete[] m_slots; }
+
+  /**
+   * @brief The maximum number of values that can be queued.
+   */
+  unsigned int Capacity() const { return m_mask + 1; }
+
+  /**
+   * @brief Add a value to the queue, called by the producer.
+   * @returns true if the value was queued, false if the queue was full.
+   */
+  bool Push(const T &value) {
+    const unsigned int tail = m_tail;
+    if (tail - m_cached_head > m_mask) {
+      m_cached_head = AtomicLoadAcquire(&m_head);
+      if (tail - m_cached_head > m_mask) {
+        return false;
+      }
+    }
+    m_slots[tail & m_mask] = value;
+    AtomicStoreRelease(&m_tail, tail + 1);
+    return true;
+  }
+
+  /**
+   * @brief Remove a value from the queue, called by the consumer.
+   * @param[out] value the value removed from the queue.
+   * @returns true if a value was returned, false if the queue was empty.
+   */
+  bool Pop(T *value) {
+    const unsigned int head = m_head;
+    if (head == m_cached_tail) {
+      m_cached_tail = AtomicLoadAcquire(&m_tail);
+      if (head == m_cached_tail) {
+        return false;
+      }
+    }
+    *value = m_slots[head & m_mask];
+    AtomicStoreRelease(&m_head, head + 1);
+    return true;
+  }
+
+  /**
+   * @brief Check if the queue is empty, this is only accurate when called
+   *   from the consumer.
+   */
+  bool Empty() const {
+    return AtomicLoadAcquire(&m_tail) == AtomicLoadAcquire(&m_head);
+  }
+
+ private:
+  const unsigned int m_mask;
+  T *m_slots;
+
+  // The consumer and producer indices live on separate cache lines so the two
+  // threads don't keep stealing the line from each other. Each side keeps a
+  // copy of the other's index and only reloads it when the queue appears
+  // empty or full.
+  char m_pad0[CACHE_LINE_SIZE];
+  unsigned int m_head;
+  unsigned int m_cached_tail;
+  char m_pad1[CACHE_LINE_SIZE];
+  unsigned int m_tail;
+  unsigned int m_cached_head;
+  char m_pad2[CACHE_LINE_SIZE];
+
+  DISALLOW_COPY_AND_ASSIGN(SPSCRingBuffer);
+};
+
+
+/**
+ * @brief A bounded queue with any number of producer threads and a single
+ *   consumer thread.
+ *
+ * Producers claim a slot with a compare and swap and then mark it as full
+ * once the value has been written, so a slow producer only holds up the
+ * consumer, never the other producers.
+ */
+template <typename T>
+class MPSCRingBuffer {
+ public:
+  /**
+   * @brief Create a new MPSCRingBuffer.
+   * @param capacity the maximum number of queued values, this is rounded up
+   *   to a power of two.
+   */
+  explicit MPSCRingBuffer(unsigned int capacity)
+      : m_mask(RingBufferCapacity(capacity) - 1),
+        m_cells(new Cell[m_mask + 1]),
+        m_head(0),
+        m_tail(0) {
+    for (unsigned int i = 0; i <= m_mask; i++) {
+      m_cells[i].sequence = i;
+    }
+  }
+
+  ~MPSCRingBuffer() { delete[] m_cells; }
+
+  /**
+   * @brief The maximum number of values that can be queued.
+   */
+  unsigned int Capacity() const { return m_mask + 1; }
+
+  /**
+   * @brief Add a value to the queue, this may be called from any thread.
+   * @returns true if the value was queued, false if the queue was full.
+   */
+  bool Push(const T &value) {
+    unsigned int position = AtomicLoadRelaxed(&m_tail);
+    Cell *cell;
+    while (true) {
+      cell = &m_cells[position & m_mask];
+      int diff = static_cast<int>(AtomicLoadAcquire(&cell->sequence) -
+                                  position);
+      if (diff == 0) {
+        if (AtomicCompareExchange(&m_tail, &position, position + 1)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        position = AtomicLoadRelaxed(&m_tail);
+      }
+    }
+    cell->value = value;
+    AtomicStoreRelease(&cell->sequence, position + 1);
+    return true;
+  }
+
+  /**
+   * @brief Remove a value from the queue, called by the consumer.
+   * @param[out] value the value removed from the queue.
+   * @returns true if a value was returned, false if the queue was empty.
+   */
+  bool Pop(T *value) {
+    Cell *cell = &m_cells[m_head & m_mask];
+    int diff = static_cast<int>(AtomicLoadAcquire(&cell->sequence) -
+                                (m_head + 1));
+    if (diff < 0) {
+      return false;
+    }
+    *value = cell->value;
+    AtomicStoreRelease(&cell->sequence, m_head + m_mask + 1);
+    m_head++;
+    return true;
+  }
+
+ private:
+  struct Cell {
+    unsigned int sequence;
+    T value;
+  };
+
+  const unsigned int m_mask;
+  Cell *m_cells;
+
+  char m_pad0[CACHE_LINE_SIZE];
+  unsigned int m_head;
+  char m_pad1[CACHE_LINE_SIZE];
+  unsigned int m_tail;
+  char m_pad2[CACHE_LINE_SIZE];
+
+  DISALLOW_COPY_AND_ASSIGN(MPSCRingBuffer);
+};
+}  // namespace thread
+}  // namespace ola
+#endif  // INCLUDE_OLA_THREAD_RINGBUFFER_H_
@@ -61,6 +61,15 @@ class JsonLexer {
    */
   static bool Parse(const std::string &input,
                     class JsonParserInterface *handler);
+
+  /**
+   * @brief Parse a single JSON number.
+   * @param input the null terminated text of the number.
+   * @param handler the JsonParserInterface to pass the number to.
+   * @return true if the input was a number, false otherwise.
+   */
+  static bool ParseNumber(const char *input,
+                          class JsonParserInterface *handler);
 };
 
 /**
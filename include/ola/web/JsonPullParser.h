@@ -0,0 +1,233 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * JsonPullParser.h
+ * An incremental JSON tokenizer.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @addtogroup json
+ * @{
+ * @file JsonPullParser.h
+ * @brief An incremental JSON tokenizer.
+ * @}
+ */
+
+#ifndef INCLUDE_OLA_WEB_JSONPULLPARSER_H_
+#define INCLUDE_OLA_WEB_JSONPULLPARSER_H_
+
+#include <ola/base/Macro.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ola {
+namespace web {
+
+class JsonParserInterface;
+
+/**
+ * @addtogroup json
+ * @{
+ */
+
+/**
+ * @brief Split JSON text into tokens, as the text arrives.
+ *
+ * Unlike the JsonLexer, which needs the entire document up front, the input
+ * can be passed to the JsonPullParser in chunks, and each call to Next()
+ * returns the next token. Strings are not copied unless they contain escape
+ * sequences or are split across chunks; Value() points into the input
+ * instead.
+ *
+ * @code
+ *   JsonPullParser parser;
+ *   parser.Feed(chunk.data(), chunk.size());
+ *   JsonPullParser::TokenType token;
+ *   while ((token = parser.Next()) > JsonPullParser::TOKEN_ERROR) {
+ *     ...
+ *   }
+ *   // token is TOKEN_NEED_DATA, so feed the next chunk, or call Finish()
+ *   // if there isn't one.
+ * @endcode
+ *
+ * The caller must keep each chunk valid until Next() returns TOKEN_NEED_DATA.
+ */
+class JsonPullParser {
+ public:
+  enum TokenType {
+    TOKEN_NEED_DATA,  /**< All the input has been consumed. */
+    TOKEN_END,  /**< The document is complete. */
+    TOKEN_ERROR,  /**< The input wasn't valid JSON, see Error(). */
+    TOKEN_OPEN_OBJECT,
+    TOKEN_CLOSE_OBJECT,
+    TOKEN_OPEN_ARRAY,
+    TOKEN_CLOSE_ARRAY,
+    TOKEN_KEY,  /**< An object key, see Value(). */
+    TOKEN_STRING,  /**< A string, see Value(). */
+    TOKEN_NUMBER,  /**< A number, Value() holds the text. */
+    TOKEN_BOOL,  /**< A bool, see BoolValue(). */
+    TOKEN_NULL,
+  };
+
+  JsonPullParser();
+
+  /**
+   * @brief Provide the next chunk of input.
+   * @param data the input, this must remain valid until Next() returns
+   *   TOKEN_NEED_DATA.
+   * @param length the size of the input.
+   */
+  void Feed(const char *data, size_t length);
+
+  /**
+   * @brief Provide the next chunk of input.
+   */
+  void Feed(const std::string &data) { Feed(data.data(), data.size()); }
+
+  /**
+   * @brief Signal that there is no more input.
+   */
+  void Finish() { m_finished = true; }
+
+  /**
+   * @brief Reset the parser so it can be used for another document.
+   */
+  void Reset();
+
+  /**
+   * @brief Return the next token.
+   */
+  TokenType Next();
+
+  /**
+   * @brief Pass tokens to a JsonParserInterface until more data is needed.
+   * @param handler the JsonParserInterface to pass tokens to.
+   * @returns the last token, which is one of TOKEN_NEED_DATA, TOKEN_END or
+   *   TOKEN_ERROR.
+   *
+   * This allows the JsonParser, or any other JsonParserInterface, to be used
+   * with chunked input.
+   */
+  TokenType PushTokens(JsonParserInterface *handler);
+
+  /**
+   * @brief The text of the last TOKEN_KEY, TOKEN_STRING or TOKEN_NUMBER.
+   *
+   * This is only valid until the next call to Next() or Feed(). It is not
+   * null terminated.
+   */
+  const char *Value() const { return m_value; }
+
+  /**
+   * @brief The size of Value().
+   */
+  size_t ValueLength() const { return m_value_length; }
+
+  /**
+   * @brief Copy the text of the last token into a string.
+   */
+  std::string ValueAsString() const {
+    return std::string(m_value, m_value_length);
+  }
+
+  /**
+   * @brief The value of the last TOKEN_BOOL.
+   */
+  bool BoolValue() const { return m_bool_value; }
+
+  /**
+   * @brief The number of objects and arrays enclosing the current token.
+   */
+  unsigned int Depth() const { return m_containers.size(); }
+
+  /**
+   * @brief The error if Next() returned TOKEN_ERROR.
+   */
+  const std::string& Error() const { return m_error; }
+
+ private:
+  // What we expect to see next, ignoring whitespace.
+  enum ParseState {
+    EXPECT_VALUE,
+    EXPECT_VALUE_OR_CLOSE,  // after a [
+    EXPECT_KEY,
+    EXPECT_KEY_OR_CLOSE,  // after a {
+    EXPECT_COLON,
+    EXPECT_SEPARATOR,  // a , or the close of the container
+    EXPECT_NOTHING,  // after the top level value
+    DONE,
+    FAILED,
+  };
+
+  // The token we're part way through.
+  enum PartialToken {
+    PARTIAL_NONE,
+    PARTIAL_STRING,
+    PARTIAL_NUMBER,
+    PARTIAL_LITERAL,
+  };
+
+  const char *m_input;
+  const char *m_input_end;
+  bool m_finished;
+  bool m_started;
+  ParseState m_state;
+  std::vector<char> m_containers;
+  std::string m_error;
+
+  PartialToken m_partial;
+  // For strings: the start of the text that hasn't been copied yet, whether
+  // we had to copy, and the escape sequence state.
+  const char *m_string_start;
+  bool m_is_key;
+  bool m_copy_string;
+  unsigned int m_escape_length;
+  uint16_t m_code_unit;
+  uint16_t m_high_surrogate;
+  // For true, false & null.
+  const char *m_literal;
+  unsigned int m_literal_offset;
+  TokenType m_literal_token;
+
+  std::string m_scratch;
+  const char *m_value;
+  size_t m_value_length;
+  bool m_bool_value;
+
+  // Used by PushTokens()
+  bool m_pushed_begin;
+  bool m_pushed_end;
+
+  TokenType StartValue(char c);
+  TokenType ContinueString();
+  TokenType ContinueNumber();
+  TokenType ContinueLiteral();
+  bool HandleEscape(char c);
+  void AppendCodeUnit(uint16_t code_unit);
+  void FlushHighSurrogate();
+  void AppendPendingString();
+  const std::string& ValueInScratch();
+  TokenType ValueComplete(TokenType token);
+  TokenType SetError(const std::string &error);
+
+  DISALLOW_COPY_AND_ASSIGN(JsonPullParser);
+};
+/**@}*/
+}  // namespace web
+}  // namespace ola
+#endif  // INCLUDE_OLA_WEB_JSONPULLPARSER_H_
@@ -33,7 +33,6 @@
 #include <ola/stl/STLUtils.h>
 #include <ola/web/Json.h>
 #include <ola/web/JsonTypes.h>
-#include <deque>
 #include <map>
 #include <memory>
 #include <set>
@@ -48,6 +47,8 @@ namespace web {
  * @{
  */
 
+class ArrayValidator;
+class ObjectValidator;
 class SchemaDefinitions;
 
 /**
@@ -112,6 +113,33 @@ class ValidatorInterface : public JsonValueConstVisitorInterface {
    * lifetime of the validator.
    */
   virtual const JsonValue *GetDefaultValue() const = 0;
+
+  /**
+   * @name Streaming validation
+   * These are used by the JsonStreamValidator to validate objects & arrays
+   * one token at a time.
+   * @{
+   */
+
+  /**
+   * @brief Check if this validator accepts every value.
+   */
+  virtual bool AcceptsAnyValue() { return false; }
+
+  /**
+   * @brief Get the validator to check an object one property at a time.
+   * @returns an ObjectValidator, or NULL if the object has to be built and
+   *   then visited.
+   */
+  virtual const ObjectValidator *StreamingObjectValidator() { return NULL; }
+
+  /**
+   * @brief Get the validator to check an array one item at a time.
+   * @returns an ArrayValidator, or NULL if the array has to be built and
+   *   then visited.
+   */
+  virtual const ArrayValidator *StreamingArrayValidator() { return NULL; }
+  /** @} */
 };
 
 /**
@@ -241,6 +269,8 @@ class WildcardValidator : public BaseValidator {
   WildcardValidator() : BaseValidator(JSON_UNDEFINED) {}
 
   bool IsValid() const { return true; }
+
+  bool AcceptsAnyValue() { return true; }
 };
 
 /**
@@ -279,11 +309,17 @@ class ReferenceValidator : public ValidatorInterface {
   void SetDefaultValue(const JsonValue *value);
   const JsonValue *GetDefaultValue() const;
 
+  bool AcceptsAnyValue();
+  const ObjectValidator *StreamingObjectValidator();
+  const ArrayValidator *StreamingArrayValidator();
+
  private:
   const SchemaDefinitions *m_definitions;
   const std::string m_schema;
   ValidatorInterface *m_validator;
 
+  ValidatorInterface *Resolve();
+
   template <typename T>
   void Validate(const T &value);
 };
@@ -597,6 +633,32 @@ class ObjectValidator : public BaseValidator, JsonObjectPropertyVisitor {
 
   void VisitProperty(const std::string &property, const JsonValue &value);
 
+  /**
+   * @brief Objects can be streamed unless there are schema dependencies.
+   */
+  const ObjectValidator *StreamingObjectValidator();
+
+  /**
+   * @brief Find the validator for a property.
+   * @param property the name of the property.
+   * @param[out] allowed set to false if the property isn't allowed.
+   * @returns the validator for the value of the property, or NULL if there
+   *   isn't one.
+   */
+  ValidatorInterface *PropertyValidator(const std::string &property,
+                                        bool *allowed) const;
+
+  /**
+   * @brief Check the number of properties is within the limits.
+   */
+  bool CheckPropertyCount(size_t count) const;
+
+  /**
+   * @brief Check the required properties & property dependencies.
+   * @param properties the names of the properties in the object.
+   */
+  bool CheckPropertyNames(const std::set<std::string> &properties) const;
+
  private:
   typedef std::set<std::string> StringSet;
   typedef std::map<std::string, ValidatorInterface*> PropertyValidators;
@@ -702,9 +764,24 @@ class ArrayValidator : public BaseValidator {
 
   void Visit(const JsonArray &array);
 
- private:
-  typedef std::deque<ValidatorInterface*> ValidatorQueue;
+  /**
+   * @brief Arrays can be streamed unless the items must be unique.
+   */
+  const ArrayValidator *StreamingArrayValidator();
+
+  /**
+   * @brief Check the number of items is within the limits.
+   */
+  bool CheckItemCount(size_t count) const;
+
+  /**
+   * @brief Find the validator for an item.
+   * @param index the index of the item in the array.
+   * @returns the validator for the item, or NULL if the item isn't allowed.
+   */
+  ValidatorInterface *ItemValidator(unsigned int index) const;
 
+ private:
   const std::auto_ptr<Items> m_items;
   const std::auto_ptr<AdditionalItems> m_additional_items;
   const Options m_options;
@@ -712,35 +789,7 @@ class ArrayValidator : public BaseValidator {
   // This is used if items is missing, or if additionalItems is true.
   std::auto_ptr<WildcardValidator> m_wildcard_validator;
 
-  class ArrayElementValidator : public BaseValidator {
-   public:
-    ArrayElementValidator(const ValidatorList &validators,
-                          ValidatorInterface *default_validator);
-
-    void Visit(const JsonString&);
-    void Visit(const JsonBool&);
-    void Visit(const JsonNull&);
-    void Visit(const JsonRawValue&);
-    void Visit(const JsonObject&);
-    void Visit(const JsonArray &array);
-    void Visit(const JsonUInt&);
-    void Visit(const JsonUInt64&);
-    void Visit(const JsonInt&);
-    void Visit(const JsonInt64&);
-    void Visit(const JsonDouble&);
-
-   private:
-    ValidatorQueue m_item_validators;
-    ValidatorInterface *m_default_validator;
-
-    template <typename T>
-    void ValidateItem(const T &item);
-
-    DISALLOW_COPY_AND_ASSIGN(ArrayElementValidator);
-  };
-
   void ExtendSchema(JsonObject *schema) const;
-  ArrayElementValidator* ConstructElementValidator() const;
 
   DISALLOW_COPY_AND_ASSIGN(ArrayValidator);
 };
@@ -981,6 +1030,14 @@ class JsonSchema {
    */
   bool IsValid(const JsonValue &value);
 
+  /**
+   * @brief The validator for the root of the document.
+   * @returns the ValidatorInterface, ownership is not transferred.
+   *
+   * This can be passed to a JsonStreamValidator.
+   */
+  ValidatorInterface *RootValidator() { return m_root_validator.get(); }
+
   /**
    * @brief Return the schema as Json.
    */
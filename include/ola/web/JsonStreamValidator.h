@@ -0,0 +1,145 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * JsonStreamValidator.h
+ * Validate JSON tokens against a schema.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @addtogroup json
+ * @{
+ * @file JsonStreamValidator.h
+ * @brief Validate JSON tokens against a schema.
+ * @}
+ */
+
+#ifndef INCLUDE_OLA_WEB_JSONSTREAMVALIDATOR_H_
+#define INCLUDE_OLA_WEB_JSONSTREAMVALIDATOR_H_
+
+#include <ola/base/Macro.h>
+#include <ola/web/JsonLexer.h>
+#include <ola/web/JsonParser.h>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace ola {
+namespace web {
+
+class ArrayValidator;
+class ObjectValidator;
+class ValidatorInterface;
+
+/**
+ * @addtogroup json
+ * @{
+ */
+
+/**
+ * @brief A JsonParserInterface that validates a document against a schema,
+ * without building a tree of JsonValues.
+ *
+ * Objects & arrays are checked one property or item at a time, and scalar
+ * values are checked as they arrive. A tree is only built for the values
+ * that can't be checked this way, for example those matched against
+ * allOf / anyOf / oneOf / not, or arrays with uniqueItems.
+ *
+ * This can be used with the JsonLexer, or with the JsonPullParser for chunked
+ * input.
+ */
+class JsonStreamValidator : public JsonParserInterface {
+ public:
+  /**
+   * @brief Create a new JsonStreamValidator.
+   * @param validator the validator for the root of the document, see
+   *   JsonSchema::RootValidator(). Ownership is not transferred.
+   */
+  explicit JsonStreamValidator(ValidatorInterface *validator);
+
+  void Begin();
+  void End();
+
+  void String(const std::string &value);
+  void Number(uint32_t value);
+  void Number(int32_t value);
+  void Number(uint64_t value);
+  void Number(int64_t value);
+  void Number(const JsonDouble::DoubleRepresentation &rep);
+  void Number(double value);
+  void Bool(bool value);
+  void Null();
+  void OpenArray();
+  void CloseArray();
+  void OpenObject();
+  void ObjectKey(const std::string &key);
+  void CloseObject();
+
+  void SetError(const std::string &error);
+
+  /**
+   * @brief Check if the document was valid.
+   * @returns true if the entire document has been seen, and it matched the
+   *   schema.
+   */
+  bool IsValid() const { return m_complete && m_is_valid; }
+
+  /**
+   * @brief The parse error, if there was one.
+   */
+  std::string GetError() const { return m_error; }
+
+ private:
+  // An object or array we're validating one token at a time.
+  struct Frame {
+    Frame()
+        : object_validator(NULL),
+          array_validator(NULL),
+          item_count(0),
+          value_validator(NULL) {
+    }
+
+    const ObjectValidator *object_validator;
+    const ArrayValidator *array_validator;
+    unsigned int item_count;
+    std::set<std::string> properties;
+    // The validator for the value that follows the current key.
+    ValidatorInterface *value_validator;
+  };
+
+  ValidatorInterface *m_root_validator;
+  bool m_is_valid;
+  bool m_complete;
+  std::string m_error;
+  std::vector<Frame> m_frames;
+
+  // Values that can't be validated a token at a time are either skipped, if
+  // they match anything, or built with m_builder and then visited.
+  unsigned int m_nested_depth;
+  ValidatorInterface *m_nested_validator;
+  std::auto_ptr<JsonParser> m_builder;
+
+  ValidatorInterface *NextValidator(bool *allowed);
+  void ValidateValue(const JsonValue &value);
+  bool StartNested(ValidatorInterface *validator);
+  void EndNested();
+
+  DISALLOW_COPY_AND_ASSIGN(JsonStreamValidator);
+};
+/**@}*/
+}  // namespace web
+}  // namespace ola
+#endif  // INCLUDE_OLA_WEB_JSONSTREAMVALIDATOR_H_
@@ -0,0 +1,183 @@
+/*
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ *
+ * JsonStreamWriter.h
+ * Write JSON text without building a tree of JsonValues.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+/**
+ * @addtogroup json
+ * @{
+ * @file JsonStreamWriter.h
+ * @brief Write JSON text without building a tree of JsonValues.
+ * @}
+ */
+
+#ifndef INCLUDE_OLA_WEB_JSONSTREAMWRITER_H_
+#define INCLUDE_OLA_WEB_JSONSTREAMWRITER_H_
+
+#include <ola/base/Macro.h>
+#include <ola/web/Json.h>
+#include <stdint.h>
+#include <string>
+
+namespace ola {
+namespace web {
+
+/**
+ * @addtogroup json
+ * @{
+ */
+
+/**
+ * @brief Write JSON directly to a string.
+ *
+ * Rather than building a JsonObject and then serializing it with the
+ * JsonWriter, the JsonStreamWriter appends each value to the output as it's
+ * added. Nothing is allocated apart from the output string itself, so if the
+ * same string is reused for many documents, its capacity is reused too.
+ *
+ * The output is compact, and the caller is responsible for producing a valid
+ * document, i.e. matching each Start call with an End call, and using keys
+ * inside objects only.
+ *
+ * @code
+ *   string output;
+ *   JsonStreamWriter writer(&output);
+ *   writer.StartObject();
+ *   writer.Add("name", "foo");
+ *   writer.StartArray("ports");
+ *   writer.Append(1);
+ *   writer.Append(2);
+ *   writer.EndArray();
+ *   writer.EndObject();
+ *   // output is now {"name":"foo","ports":[1,2]}
+ * @endcode
+ */
+class JsonStreamWriter {
+ public:
+  /**
+   * @brief Create a new JsonStreamWriter.
+   * @param output the string to append to. Ownership is not transferred.
+   */
+  explicit JsonStreamWriter(std::string *output)
+      : m_output(output),
+        m_need_separator(false) {
+  }
+
+  /**
+   * @brief Start an object, either at the top level or in an array.
+   */
+  void StartObject();
+
+  /**
+   * @brief Start an object as the value of a key.
+   * @param key the key in the enclosing object.
+   */
+  void StartObject(const std::string &key);
+
+  void EndObject();
+
+  /**
+   * @brief Start an array, either at the top level or in an array.
+   */
+  void StartArray();
+
+  /**
+   * @brief Start an array as the value of a key.
+   * @param key the key in the enclosing object.
+   */
+  void StartArray(const std::string &key);
+
+  void EndArray();
+
+  /**
+   * @brief Write a key in an object, this must be followed by a value.
+   * @param key the key.
+   */
+  void Key(const std::string &key);
+
+  /**
+   * @name Add a key and value to the current object.
+   * @{
+   */
+  void Add(const std::string &key, const std::string &value);
+  void Add(const std::string &key, const char *value);
+  void Add(const std::string &key, unsigned int i);
+  void Add(const std::string &key, int i);
+  void Add(const std::string &key, uint64_t i);
+  void Add(const std::string &key, int64_t i);
+  void Add(const std::string &key, double d);
+  void Add(const std::string &key, bool value);
+  /** @} */
+
+  /**
+   * @brief Add a key with a null value to the current object.
+   */
+  void Add(const std::string &key);
+
+  /**
+   * @brief Add a key and a value which is already JSON.
+   */
+  void AddRaw(const std::string &key, const std::string &value);
+
+  /**
+   * @name Append a value to the current array, or write a value after a Key().
+   * @{
+   */
+  void Append(const std::string &value);
+  void Append(const char *value);
+  void Append(unsigned int i);
+  void Append(int i);
+  void Append(uint64_t i);
+  void Append(int64_t i);
+  void Append(double d);
+  void Append(bool value);
+  /** @} */
+
+  /**
+   * @brief Append a null value.
+   */
+  void Append();
+
+  /**
+   * @brief Append a value which is already JSON.
+   */
+  void AppendRaw(const std::string &value);
+
+  /**
+   * @brief Append a tree of JsonValues.
+   *
+   * This allows code which already builds JsonValues to be mixed with the
+   * streaming writer.
+   */
+  void Append(const JsonValue &value);
+
+ private:
+  std::string *m_output;
+  // true if a comma is needed before the next key or value.
+  bool m_need_separator;
+
+  void StartValue();
+  void AppendString(const std::string &value, bool encode);
+  void AppendNumber(const char *format, ...);
+
+  DISALLOW_COPY_AND_ASSIGN(JsonStreamWriter);
+};
+/**@}*/
+}  // namespace web
+}  // namespace ola
+#endif  // INCLUDE_OLA_WEB_JSONSTREAMWRITER_H_
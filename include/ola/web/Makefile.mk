@@ -7,8 +7,11 @@ olawebinclude_HEADERS = \
     include/ola/web/JsonPatch.h \
     include/ola/web/JsonPatchParser.h \
     include/ola/web/JsonPointer.h \
+    include/ola/web/JsonPullParser.h \
     include/ola/web/JsonSchema.h \
     include/ola/web/JsonSections.h \
+    include/ola/web/JsonStreamValidator.h \
+    include/ola/web/JsonStreamWriter.h \
     include/ola/web/JsonTypes.h \
     include/ola/web/JsonWriter.h \
     include/ola/web/OptionalItem.h
@@ -172,6 +172,15 @@ class OutputPort: public Port, ola::rdm::DiscoverableRDMControllerInterface {
    */
   virtual bool WriteDMX(const DmxBuffer &buffer, uint8_t priority) = 0;
 
+  /**
+   * @brief Check if this port keeps sending the last frame it was given.
+   *
+   * The universe doesn't write frames which are the same as the previous one
+   * to these ports.
+   * @return true if the port repeats the last frame.
+   */
+  virtual bool RepeatsLastFrame() const = 0;
+
   /**
    * @brief Called if the universe name changes
    */
@@ -303,6 +312,9 @@ class BasicOutputPort: public OutputPort {
     (void) new_name;
   }
 
+  // Most ports only send when they're given new data.
+  virtual bool RepeatsLastFrame() const { return false; }
+
   port_priority_capability PriorityCapability() const {
     return SupportsPriorities() ? CAPABILITY_FULL : CAPABILITY_NONE;
   }
@@ -22,6 +22,7 @@
 #define INCLUDE_OLAD_UNIVERSE_H_
 
 #include <ola/Clock.h>
+#include <ola/Constants.h>
 #include <ola/DmxBuffer.h>
 #include <ola/ExportMap.h>
 #include <ola/base/Macro.h>
@@ -130,19 +131,61 @@ class Universe: public ola::rdm::RDMControllerInterface {
                         ola::rdm::RDMCallback *callback);
     void RunRDMDiscovery(ola::rdm::RDMDiscoveryCallback *on_complete,
                          bool full = true);
+    // Incremental discovery, ports that haven't changed recently may be
+    // answered from the cache.
+    void RunPeriodicRDMDiscovery();
     void NewUIDList(OutputPort *port, const ola::rdm::UIDSet &uids);
     void GetUIDs(ola::rdm::UIDSet *uids) const;
     unsigned int UIDCount() const;
     uint8_t GetRDMTransactionNumber();
 
+    /**
+     * @brief Update the progress of RDM discovery on an output port.
+     * @param port the OutputPort.
+     * @param queued true if discovery is waiting to start on the port.
+     * @param running true if discovery is running on the port.
+     */
+    void RDMDiscoveryProgress(OutputPort *port, bool queued, bool running);
+
+    /**
+     * @brief The number of output ports waiting to start RDM discovery.
+     */
+    unsigned int RDMDiscoveryQueuedCount() const {
+      return m_discovery_queued.size();
+    }
+
+    /**
+     * @brief The number of output ports running RDM discovery.
+     */
+    unsigned int RDMDiscoveryRunningCount() const {
+      return m_discovery_running.size();
+    }
+
+    /**
+     * @brief The time from DMX data arriving on an input port or from a
+     * client, until it has been written to all the output ports.
+     */
+    const LatencyHistogram *Latency() const { return m_latency; }
+
+    /**
+     * @brief The time from DMX data arriving, until it has been written to a
+     * particular output port.
+     * @returns the histogram, or NULL if the port isn't part of this
+     * universe.
+     */
+    const LatencyHistogram *OutputPortLatency(const OutputPort *port) const;
+
     bool operator==(const Universe &other) {
       return m_universe_id == other.UniverseId();
     }
 
+    static const char K_CHANGED_SLOTS_VAR[];
     static const char K_FPS_VAR[];
     static const char K_MERGE_HTP_STR[];
     static const char K_MERGE_LTP_STR[];
+    static const char K_OUTPUT_PORT_LATENCY_VAR[];
     static const char K_UNIVERSE_INPUT_PORT_VAR[];
+    static const char K_UNIVERSE_LATENCY_VAR[];
     static const char K_UNIVERSE_MODE_VAR[];
     static const char K_UNIVERSE_NAME_VAR[];
     static const char K_UNIVERSE_OUTPUT_PORT_VAR[];
@@ -152,6 +195,9 @@ class Universe: public ola::rdm::RDMControllerInterface {
     static const char K_UNIVERSE_UID_COUNT_VAR[];
 
  private:
+    // The most sources we track per-slot ownership for, see HTPMergeSource()
+    static const unsigned int MAX_TRACKED_SOURCES = 255;
+
     typedef struct {
       unsigned int expected_count;
       unsigned int current_count;
@@ -161,6 +207,16 @@ class Universe: public ola::rdm::RDMControllerInterface {
     } broadcast_request_tracker;
 
     typedef std::map<Client*, bool> SourceClientMap;
+    typedef std::map<const OutputPort*, LatencyHistogram*> PortLatencyMap;
+
+    /**
+     * A source that is contributing at the active priority. Exactly one of
+     * port or client is non-NULL.
+     */
+    typedef struct {
+      const InputPort *port;
+      const Client *client;
+    } merge_source;
 
     std::string m_universe_name;
     unsigned int m_universe_id;
@@ -178,25 +234,72 @@ class Universe: public ola::rdm::RDMControllerInterface {
     class UniverseStore *m_universe_store;
     DmxBuffer m_buffer;
     ExportMap *m_export_map;
+    // These are updated for every frame / request, so they're looked up once.
+    CounterVariable *m_frame_counter;
+    CounterVariable *m_changed_slot_counter;
+    CounterVariable *m_rdm_request_counter;
+    LatencyHistogram *m_latency;
+    PortLatencyMap m_output_latency;
     std::map<ola::rdm::UID, OutputPort*> m_output_uids;
+    std::set<OutputPort*> m_discovery_queued;
+    std::set<OutputPort*> m_discovery_running;
     Clock *m_clock;
     TimeInterval m_rdm_discovery_interval;
     TimeStamp m_last_discovery_time;
     ola::SequenceNumber<uint8_t> m_transaction_number_sequence;
 
+    /*
+     * Persistent merge state. m_active_sources holds the sources at
+     * m_active_priority, and m_active_data the last DmxSource seen for each of
+     * them. For HTP, m_merge_data holds the merged result and m_slot_owner
+     * the index of the source which provided each slot's value.
+     * m_merge_sources and m_merge_lengths are scratch space for
+     * HTPMergeSources(). All the vectors keep their capacity between frames so
+     * the steady state doesn't allocate.
+     */
+    std::vector<merge_source> m_active_sources;
+    std::vector<DmxSource> m_active_data;
+    std::vector<const uint8_t*> m_merge_sources;
+    std::vector<unsigned int> m_merge_lengths;
+    uint8_t m_merge_data[DMX_UNIVERSE_SIZE];
+    uint8_t m_slot_owner[DMX_UNIVERSE_SIZE];
+    unsigned int m_merge_length;
+    bool m_merge_state_valid;
+    // When the data that triggered the next update arrived. This isn't set
+    // for updates from SetDMX().
+    TimeStamp m_source_time;
+    /*
+     * The last frame written to the output ports. Ports which repeat the last
+     * frame aren't sent frames that are the same as this.
+     */
+    uint8_t m_last_frame[DMX_UNIVERSE_SIZE];
+    unsigned int m_last_frame_length;
+    uint8_t m_last_frame_priority;
+    bool m_last_frame_valid;
+
     void HandleBroadcastAck(broadcast_request_tracker *tracker,
                             ola::rdm::RDMReply *reply);
     void HandleBroadcastDiscovery(broadcast_request_tracker *tracker,
                                   ola::rdm::RDMReply *reply);
     bool UpdateDependants();
+    bool UpdateLastFrame();
     void UpdateName();
     void UpdateMode();
-    void HTPMergeSources(const std::vector<DmxSource> &sources);
+    void HTPMergeSources();
+    void HTPMergeSource(unsigned int index);
     bool MergeAll(const InputPort *port, const Client *client);
+    DmxSource MergeSourceData(const merge_source &source) const;
+    void PruneActiveSources(const TimeStamp &now);
+    void RebuildActiveSources(const TimeStamp &now);
+    int FindActiveSource(const InputPort *port, const Client *client) const;
+    void RemoveActiveSource(const InputPort *port, const Client *client);
     void PortDiscoveryComplete(BaseCallback0<void> *on_complete,
                                OutputPort *output_port,
                                const ola::rdm::UIDSet &uids);
     void DiscoveryComplete(ola::rdm::RDMDiscoveryCallback *on_complete);
+    void StartRDMDiscovery(ola::rdm::RDMDiscoveryCallback *on_complete,
+                           bool full,
+                           bool periodic);
 
     void SafeIncrement(const std::string &name);
     void SafeDecrement(const std::string &name);
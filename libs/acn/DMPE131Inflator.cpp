@@ -20,7 +20,6 @@
 
 #include <sys/time.h>
 #include <algorithm>
-#include <map>
 #include <memory>
 #include <vector>
 #include "ola/Logging.h"
@@ -34,19 +33,18 @@ namespace acn {
 using ola::Callback0;
 using ola::acn::CID;
 using ola::io::OutputStream;
-using std::map;
-using std::pair;
 using std::vector;
 
 const TimeInterval DMPE131Inflator::EXPIRY_INTERVAL(2500000);
 
 
 DMPE131Inflator::~DMPE131Inflator() {
-  UniverseHandlers::iterator iter;
-  for (iter = m_handlers.begin(); iter != m_handlers.end(); ++iter) {
-    delete iter->second.closure;
+  vector<uint16_t> universes;
+  m_handlers.Universes(&universes);
+  vector<uint16_t>::const_iterator iter = universes.begin();
+  for (; iter != universes.end(); ++iter) {
+    delete m_handlers.Find(*iter)->closure;
   }
-  m_handlers.clear();
 }
 
 
@@ -62,16 +60,15 @@ bool DMPE131Inflator::HandlePDUData(uint32_t vector,
     return true;
   }
 
-  E131Header e131_header = headers.GetE131Header();
-  UniverseHandlers::iterator universe_iter =
-      m_handlers.find(e131_header.Universe());
+  const E131Header &e131_header = headers.GetE131Header();
+  universe_handler *universe_data = m_handlers.Find(e131_header.Universe());
 
   if (e131_header.PreviewData() && m_ignore_preview) {
     OLA_DEBUG << "Ignoring preview data";
     return true;
   }
 
-  if (universe_iter == m_handlers.end())
+  if (!universe_data)
     return true;
 
   DMPHeader dmp_header = headers.GetDMPHeader();
@@ -123,8 +120,7 @@ bool DMPE131Inflator::HandlePDUData(uint32_t vector,
   }
 
   DmxBuffer *target_buffer;
-  if (!TrackSourceIfRequired(&universe_iter->second, headers,
-                             &target_buffer)) {
+  if (!TrackSourceIfRequired(universe_data, headers, &target_buffer)) {
     // no need to continue processing
     return true;
   }
@@ -138,27 +134,27 @@ bool DMPE131Inflator::HandlePDUData(uint32_t vector,
      target_buffer->Set(data + available_length + 1, channels - 1);
   }
 
-  if (universe_iter->second.priority)
-    *universe_iter->second.priority = universe_iter->second.active_priority;
+  if (universe_data->priority)
+    *universe_data->priority = universe_data->active_priority;
 
   // merge the sources
-  switch (universe_iter->second.sources.size()) {
+  switch (universe_data->source_count) {
     case 0:
-      universe_iter->second.buffer->Reset();
+      universe_data->buffer->Reset();
       break;
     case 1:
-      universe_iter->second.buffer->Set(
-          universe_iter->second.sources[0].buffer);
-      universe_iter->second.closure->Run();
+      universe_data->buffer->Set(universe_data->sources[0].buffer);
+      universe_data->closure->Run();
       break;
-    default:
+    default: {
       // HTP Merge
-      universe_iter->second.buffer->Reset();
-      std::vector<dmx_source>::const_iterator source_iter =
-        universe_iter->second.sources.begin();
-      for (; source_iter != universe_iter->second.sources.end(); ++source_iter)
-        universe_iter->second.buffer->HTPMerge(source_iter->buffer);
-      universe_iter->second.closure->Run();
+      const DmxBuffer *source_buffers[MAX_MERGE_SOURCES];
+      unsigned int source_count = universe_data->source_count;
+      for (unsigned int i = 0; i < source_count; i++)
+        source_buffers[i] = &universe_data->sources[i].buffer;
+      universe_data->buffer->HTPMergeMany(source_buffers, source_count);
+      universe_data->closure->Run();
+    }
   }
   return true;
 }
@@ -178,20 +174,22 @@ bool DMPE131Inflator::SetHandler(uint16_t universe,
   if (!closure || !buffer)
     return false;
 
-  UniverseHandlers::iterator iter = m_handlers.find(universe);
+  universe_handler *universe_data = m_handlers.Find(universe);
 
-  if (iter == m_handlers.end()) {
+  if (!universe_data) {
     universe_handler handler;
     handler.buffer = buffer;
     handler.closure = closure;
     handler.active_priority = 0;
     handler.priority = priority;
-    m_handlers[universe] = handler;
+    handler.source_count = 0;
+    handler.last_source = 0;
+    m_handlers.Insert(universe, handler);
   } else {
-    Callback0<void> *old_closure = iter->second.closure;
-    iter->second.closure = closure;
-    iter->second.buffer = buffer;
-    iter->second.priority = priority;
+    Callback0<void> *old_closure = universe_data->closure;
+    universe_data->closure = closure;
+    universe_data->buffer = buffer;
+    universe_data->priority = priority;
     delete old_closure;
   }
   return true;
@@ -204,11 +202,11 @@ bool DMPE131Inflator::SetHandler(uint16_t universe,
  * @param true if removed, false if it didn't exist
  */
 bool DMPE131Inflator::RemoveHandler(uint16_t universe) {
-  UniverseHandlers::iterator iter = m_handlers.find(universe);
+  universe_handler *universe_data = m_handlers.Find(universe);
 
-  if (iter != m_handlers.end()) {
-    Callback0<void> *old_closure = iter->second.closure;
-    m_handlers.erase(iter);
+  if (universe_data) {
+    Callback0<void> *old_closure = universe_data->closure;
+    m_handlers.Remove(universe);
     delete old_closure;
     return true;
   }
@@ -222,11 +220,8 @@ bool DMPE131Inflator::RemoveHandler(uint16_t universe) {
  *   universes that have handlers installed.
  */
 void DMPE131Inflator::RegisteredUniverses(vector<uint16_t> *universes) {
-  universes->clear();
-  UniverseHandlers::iterator iter;
-  for (iter = m_handlers.begin(); iter != m_handlers.end(); ++iter) {
-    universes->push_back(iter->first);
-  }
+  m_handlers.Universes(universes);
+  std::sort(universes->begin(), universes->end());
 }
 
 
@@ -249,31 +244,29 @@ bool DMPE131Inflator::TrackSourceIfRequired(
   ola::TimeStamp now;
   m_clock.CurrentTime(&now);
   const E131Header &e131_header = headers.GetE131Header();
+  const CID &cid = headers.GetRootHeader().GetCid();
   uint8_t priority = e131_header.Priority();
-  vector<dmx_source> &sources = universe_data->sources;
-  vector<dmx_source>::iterator iter = sources.begin();
+  dmx_source *sources = universe_data->sources;
 
-  while (iter != sources.end()) {
-    if (iter->cid != headers.GetRootHeader().GetCid()) {
-      TimeStamp expiry_time = iter->last_heard_from + EXPIRY_INTERVAL;
+  unsigned int i = 0;
+  while (i < universe_data->source_count) {
+    if (sources[i].cid != cid) {
+      TimeStamp expiry_time = sources[i].last_heard_from + EXPIRY_INTERVAL;
       if (now > expiry_time) {
-        OLA_INFO << "source " << iter->cid.ToString() << " has expired";
-        iter = sources.erase(iter);
+        OLA_INFO << "source " << sources[i].cid.ToString() << " has expired";
+        RemoveSource(universe_data, i);
         continue;
       }
     }
-    iter++;
+    i++;
   }
 
-  if (sources.empty())
+  if (!universe_data->source_count)
     universe_data->active_priority = 0;
 
-  for (iter = sources.begin(); iter != sources.end(); ++iter) {
-    if (iter->cid == headers.GetRootHeader().GetCid())
-      break;
-  }
+  int index = FindSource(universe_data, cid);
 
-  if (iter == sources.end()) {
+  if (index < 0) {
     // This is an untracked source
     if (e131_header.StreamTerminated() ||
         priority < universe_data->active_priority)
@@ -284,72 +277,114 @@ bool DMPE131Inflator::TrackSourceIfRequired(
         e131_header.Universe() << " from " <<
         static_cast<int>(universe_data->active_priority) << " to " <<
         static_cast<int>(priority);
-      sources.clear();
+      universe_data->source_count = 0;
       universe_data->active_priority = priority;
     }
 
-    if (sources.size() == MAX_MERGE_SOURCES) {
+    if (universe_data->source_count == MAX_MERGE_SOURCES) {
       // TODO(simon): flag this in the export map
       OLA_WARN << "Max merge sources reached for universe " <<
-        e131_header.Universe() << ", " <<
-        headers.GetRootHeader().GetCid().ToString() << " won't be tracked";
+        e131_header.Universe() << ", " << cid.ToString() <<
+        " won't be tracked";
         return false;
     } else {
-      OLA_INFO << "Added new E1.31 source: " <<
-        headers.GetRootHeader().GetCid().ToString();
-      dmx_source new_source;
-      new_source.cid = headers.GetRootHeader().GetCid();
+      OLA_INFO << "Added new E1.31 source: " << cid.ToString();
+      dmx_source &new_source = sources[universe_data->source_count];
+      new_source.cid = cid;
       new_source.sequence = e131_header.Sequence();
       new_source.last_heard_from = now;
-      iter = sources.insert(sources.end(), new_source);
-      *buffer = &iter->buffer;
+      new_source.buffer.Reset();
+      universe_data->last_source = universe_data->source_count++;
+      *buffer = &new_source.buffer;
       return true;
     }
 
   } else {
     // We already know about this one, check the seq #
+    dmx_source *source = &sources[index];
     int8_t seq_diff = static_cast<int8_t>(e131_header.Sequence() -
-                                          iter->sequence);
+                                          source->sequence);
     if (seq_diff <= 0 && seq_diff > SEQUENCE_DIFF_THRESHOLD) {
       OLA_INFO << "Old packet received, ignoring, this # " <<
         static_cast<int>(e131_header.Sequence()) << ", last " <<
-        static_cast<int>(iter->sequence);
+        static_cast<int>(source->sequence);
       return false;
     }
-    iter->sequence = e131_header.Sequence();
+    source->sequence = e131_header.Sequence();
 
     if (e131_header.StreamTerminated()) {
-      OLA_INFO << "CID " << headers.GetRootHeader().GetCid().ToString() <<
+      OLA_INFO << "CID " << cid.ToString() <<
         " sent a termination for universe " << e131_header.Universe();
-      sources.erase(iter);
-      if (sources.empty())
+      RemoveSource(universe_data, index);
+      if (!universe_data->source_count)
         universe_data->active_priority = 0;
       // We need to trigger a merge here else the buffer will be stale, we keep
       // the buffer as NULL though so we don't use the data.
       return true;
     }
 
-    iter->last_heard_from = now;
+    source->last_heard_from = now;
     if (priority < universe_data->active_priority) {
-      if (sources.size() == 1) {
+      if (universe_data->source_count == 1) {
         universe_data->active_priority = priority;
       } else {
-        sources.erase(iter);
+        RemoveSource(universe_data, index);
         return true;
       }
     } else if (priority > universe_data->active_priority) {
       // new active priority
       universe_data->active_priority = priority;
-      if (sources.size() != 1) {
+      if (universe_data->source_count != 1) {
         // clear all sources other than this one
-        dmx_source this_source = *iter;
-        sources.clear();
-        iter = sources.insert(sources.end(), this_source);
+        if (index) {
+          sources[0] = *source;
+          source = &sources[0];
+        }
+        universe_data->source_count = 1;
+        universe_data->last_source = 0;
       }
     }
-    *buffer = &iter->buffer;
+    *buffer = &source->buffer;
     return true;
   }
 }
+
+
+/*
+ * Find the index of a source, or -1 if this universe isn't tracking it.
+ * Sources tend to send a burst of packets, so the last source is checked
+ * first.
+ */
+int DMPE131Inflator::FindSource(universe_handler *universe_data,
+                                const CID &cid) {
+  const dmx_source *sources = universe_data->sources;
+  if (universe_data->last_source < universe_data->source_count &&
+      sources[universe_data->last_source].cid == cid) {
+    return universe_data->last_source;
+  }
+
+  for (uint8_t i = 0; i < universe_data->source_count; i++) {
+    if (sources[i].cid == cid) {
+      universe_data->last_source = i;
+      return i;
+    }
+  }
+  return -1;
+}
+
+
+/*
+ * Stop tracking a source, this moves the last source into the gap.
+ */
+void DMPE131Inflator::RemoveSource(universe_handler *universe_data,
+                                   unsigned int index) {
+  uint8_t last = static_cast<uint8_t>(universe_data->source_count - 1);
+  if (index != last) {
+    universe_data->sources[index] = universe_data->sources[last];
+  }
+  universe_data->sources[last].buffer.Reset();
+  universe_data->source_count = last;
+  universe_data->last_source = 0;
+}
 }  // namespace acn
 }  // namespace ola
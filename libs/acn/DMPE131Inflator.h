@@ -22,12 +22,12 @@
 #ifndef LIBS_ACN_DMPE131INFLATOR_H_
 #define LIBS_ACN_DMPE131INFLATOR_H_
 
-#include <map>
 #include <vector>
 #include "ola/Clock.h"
 #include "ola/Callback.h"
 #include "ola/DmxBuffer.h"
 #include "libs/acn/DMPInflator.h"
+#include "libs/acn/UniverseTable.h"
 
 namespace ola {
 namespace acn {
@@ -48,6 +48,13 @@ class DMPE131Inflator: public DMPInflator {
 
     void RegisteredUniverses(std::vector<uint16_t> *universes);
 
+    /*
+     * Check if there is a handler for a universe.
+     */
+    bool HasHandler(uint16_t universe) {
+      return m_handlers.Contains(universe);
+    }
+
  protected:
     virtual bool HandlePDUData(uint32_t vector,
                                const HeaderSet &headers,
@@ -55,6 +62,9 @@ class DMPE131Inflator: public DMPInflator {
                                unsigned int pdu_len);
 
  private:
+    // The max number of sources we'll track per universe.
+    static const uint8_t MAX_MERGE_SOURCES = 6;
+
     typedef struct {
       ola::acn::CID cid;
       uint8_t sequence;
@@ -67,10 +77,14 @@ class DMPE131Inflator: public DMPInflator {
       Callback0<void> *closure;
       uint8_t active_priority;
       uint8_t *priority;
-      std::vector<dmx_source> sources;
+      // The sources at the active priority, in no particular order.
+      dmx_source sources[MAX_MERGE_SOURCES];
+      uint8_t source_count;
+      // The index of the source we last received from.
+      uint8_t last_source;
     } universe_handler;
 
-    typedef std::map<uint16_t, universe_handler> UniverseHandlers;
+    typedef UniverseTable<universe_handler> UniverseHandlers;
 
     UniverseHandlers m_handlers;
     bool m_ignore_preview;
@@ -79,9 +93,9 @@ class DMPE131Inflator: public DMPInflator {
     bool TrackSourceIfRequired(universe_handler *universe_data,
                                const HeaderSet &headers,
                                DmxBuffer **buffer);
+    int FindSource(universe_handler *universe_data, const CID &cid);
+    void RemoveSource(universe_handler *universe_data, unsigned int index);
 
-    // The max number of sources we'll track per universe.
-    static const uint8_t MAX_MERGE_SOURCES = 6;
     // The max merge priority.
     static const uint8_t MAX_E131_PRIORITY = 200;
     // ignore packets that differ by less than this amount from the last one
@@ -27,8 +27,10 @@
 #include <vector>
 #include "ola/Constants.h"
 #include "ola/Logging.h"
+#include "ola/acn/ACNVectors.h"
 #include "ola/network/InterfacePicker.h"
 #include "ola/stl/STLUtils.h"
+#include "ola/util/Utils.h"
 #include "libs/acn/E131Node.h"
 
 namespace ola {
@@ -39,6 +41,7 @@ using ola::DmxBuffer;
 using ola::network::IPV4Address;
 using ola::network::IPV4SocketAddress;
 using ola::network::HostToNetwork;
+using ola::utils::JoinUInt8;
 using std::auto_ptr;
 using std::map;
 using std::string;
@@ -115,19 +118,17 @@ E131Node::E131Node(ola::thread::SchedulerInterface *ss,
       m_options(options),
       m_preferred_ip(ip_address),
       m_cid(cid),
+      m_batch(&m_socket, ss),
       m_root_sender(m_cid),
       m_e131_sender(&m_socket, &m_root_sender),
       m_dmp_inflator(options.ignore_preview),
       m_discovery_inflator(NewCallback(this, &E131Node::NewDiscoveryPage)),
       m_incoming_udp_transport(&m_socket, &m_root_inflator),
-      m_send_buffer(NULL),
       m_discovery_timeout(ola::thread::INVALID_TIMEOUT) {
 
 
-  if (!m_options.use_rev2) {
-    // Allocate a buffer for the dmx data + start code
-    m_send_buffer = new uint8_t[DMX_UNIVERSE_SIZE + 1];
-    m_send_buffer[0] = 0;  // start code is 0
+  if (m_options.batch_sends) {
+    m_e131_sender.SetBatch(&m_batch);
   }
 
   // setup all the inflators
@@ -152,8 +153,6 @@ E131Node::~E131Node() {
   }
 
   Stop();
-  if (m_send_buffer)
-    delete[] m_send_buffer;
 
   STLDeleteValues(&m_discovered_sources);
 }
@@ -181,8 +180,12 @@ bool E131Node::Start() {
   m_socket.SetTos(m_options.dscp);
   m_socket.SetMulticastInterface(m_interface.ip_address);
 
+  // Receive() drains the socket, so this allows edge triggered polling.
+  m_socket.SetReadsUntilEmpty();
   m_socket.SetOnData(NewCallback(&m_incoming_udp_transport,
                                  &IncomingUDPTransport::Receive));
+  m_incoming_udp_transport.SetPacketFilter(
+      NewCallback(this, &E131Node::WantPacket));
 
   if (m_options.enable_draft_discovery) {
     IPV4Address addr;
@@ -202,6 +205,7 @@ bool E131Node::Start() {
 bool E131Node::Stop() {
   m_ss->RemoveTimeout(m_discovery_timeout);
   m_discovery_timeout = ola::thread::INVALID_TIMEOUT;
+  m_batch.Flush();
   return true;
 }
 
@@ -211,8 +215,10 @@ bool E131Node::SetSourceName(uint16_t universe, const string &source) {
   if (iter == m_tx_universes.end()) {
     tx_universe *settings = SetupOutgoingSettings(universe);
     settings->source = source;
+    settings->packet.SetSource(source);
   } else {
     iter->second.source = source;
+    iter->second.packet.SetSource(source);
   }
   return true;
 }
@@ -261,19 +267,38 @@ bool E131Node::SendDMXWithSequenceOffset(uint16_t universe,
     settings = &iter->second;
   }
 
-  const uint8_t *dmp_data;
-  unsigned int dmp_data_length;
+  const uint8_t sequence = static_cast<uint8_t>(
+      settings->sequence + sequence_offset);
+  bool result;
 
   if (m_options.use_rev2) {
-    dmp_data = buffer.GetRaw();
-    dmp_data_length = buffer.Size();
+    result = SendRev2DMX(universe, *settings, buffer, sequence, priority,
+                         preview);
   } else {
-    unsigned int data_size = DMX_UNIVERSE_SIZE;
-    buffer.Get(m_send_buffer + 1, &data_size);
-    dmp_data = m_send_buffer;
-    dmp_data_length = data_size + 1;
+    unsigned int length;
+    const uint8_t *packet = settings->packet.Pack(buffer, priority, sequence,
+                                                  preview, false, &length);
+    result = packet && m_e131_sender.SendPacket(
+        packet, length, settings->packet.Destination());
   }
 
+  if (result && !sequence_offset)
+    settings->sequence++;
+  return result;
+}
+
+/*
+ * Rev2 doesn't use a start code, so the packet templates don't apply.
+ */
+bool E131Node::SendRev2DMX(uint16_t universe,
+                           const tx_universe &settings,
+                           const ola::DmxBuffer &buffer,
+                           uint8_t sequence,
+                           uint8_t priority,
+                           bool preview) {
+  const uint8_t *dmp_data = buffer.GetRaw();
+  unsigned int dmp_data_length = buffer.Size();
+
   TwoByteRangeDMPAddress range_addr(0, 1, (uint16_t) dmp_data_length);
   DMPAddressData<TwoByteRangeDMPAddress> range_chunk(&range_addr,
                                                      dmp_data,
@@ -284,17 +309,15 @@ bool E131Node::SendDMXWithSequenceOffset(uint16_t universe,
                                                        false,
                                                        ranged_chunks);
 
-  E131Header header(settings->source,
+  E131Header header(settings.source,
                     priority,
-                    static_cast<uint8_t>(settings->sequence + sequence_offset),
+                    sequence,
                     universe,
                     preview,  // preview
                     false,  // terminated
-                    m_options.use_rev2);
+                    true);
 
   bool result = m_e131_sender.SendDMP(header, pdu);
-  if (result && !sequence_offset)
-    settings->sequence++;
   delete pdu;
   return result;
 }
@@ -304,42 +327,26 @@ bool E131Node::SendStreamTerminated(uint16_t universe,
                                     uint8_t priority) {
   ActiveTxUniverses::iterator iter = m_tx_universes.find(universe);
 
-  string source_name;
-  uint8_t sequence_number;
+  unsigned int length;
+  const uint8_t *packet;
+  bool result;
 
   if (iter == m_tx_universes.end()) {
-    source_name = m_options.source_name;
-    sequence_number = 0;
+    E131PacketTemplate packet_template(m_cid, universe,
+                                       m_options.source_name);
+    packet = packet_template.Pack(buffer, priority, 0, false, true, &length);
+    result = packet && m_e131_sender.SendPacket(
+        packet, length, packet_template.Destination());
   } else {
-    source_name = iter->second.source;
-    sequence_number = iter->second.sequence;
+    tx_universe *settings = &iter->second;
+    packet = settings->packet.Pack(buffer, priority, settings->sequence,
+                                   false, true, &length);
+    result = packet && m_e131_sender.SendPacket(
+        packet, length, settings->packet.Destination());
+    // only update if we were previously tracking this universe
+    if (result)
+      settings->sequence++;
   }
-
-  unsigned int data_size = DMX_UNIVERSE_SIZE;
-  buffer.Get(m_send_buffer + 1, &data_size);
-  data_size++;
-
-  TwoByteRangeDMPAddress range_addr(0, 1, (uint16_t) data_size);
-  DMPAddressData<TwoByteRangeDMPAddress> range_chunk(
-      &range_addr, m_send_buffer, data_size);
-  vector<DMPAddressData<TwoByteRangeDMPAddress> > ranged_chunks;
-  ranged_chunks.push_back(range_chunk);
-  const DMPPDU *pdu = NewRangeDMPSetProperty<uint16_t>(
-      true, false, ranged_chunks);
-
-  E131Header header(source_name,
-                    priority,
-                    sequence_number,
-                    universe,
-                    false,  // preview
-                    true,  // terminated
-                    false);
-
-  bool result = m_e131_sender.SendDMP(header, pdu);
-  // only update if we were previously tracking this universe
-  if (result && iter != m_tx_universes.end())
-    iter->second.sequence++;
-  delete pdu;
   return result;
 }
 
@@ -396,15 +403,41 @@ void E131Node::GetKnownControllers(std::vector<KnownController> *controllers) {
  * Create a settings entry for an outgoing universe
  */
 E131Node::tx_universe *E131Node::SetupOutgoingSettings(uint16_t universe) {
-  tx_universe settings;
-  settings.source = m_options.source_name;
-  settings.sequence = 0;
+  tx_universe settings(m_cid, universe, m_options.source_name);
   ActiveTxUniverses::iterator iter =
       m_tx_universes.insert(std::make_pair(universe, settings)).first;
   return &iter->second;
 }
 
 
+/*
+ * Drop E1.31 data packets for universes we don't have a handler for, without
+ * inflating them. The fields are at fixed offsets as long as none of the PDUs
+ * inherit their vector, header or data, anything else is left to the
+ * inflators.
+ */
+bool E131Node::WantPacket(const uint8_t *data, unsigned int size) {
+  if (size < E131PacketTemplate::DMP_PDU_OFFSET) {
+    return true;
+  }
+
+  const uint8_t *root_pdu = data + E131PacketTemplate::ROOT_PDU_OFFSET;
+  const uint8_t *e131_pdu = data + E131PacketTemplate::E131_PDU_OFFSET;
+  // Also checks the extended length flag isn't set.
+  const uint8_t flags = PDU::VFLAG_MASK | PDU::HFLAG_MASK | PDU::DFLAG_MASK;
+  if ((root_pdu[0] & 0xf0) != flags || (e131_pdu[0] & 0xf0) != flags ||
+      JoinUInt8(root_pdu[2], root_pdu[3], root_pdu[4], root_pdu[5]) !=
+        ola::acn::VECTOR_ROOT_E131 ||
+      JoinUInt8(e131_pdu[2], e131_pdu[3], e131_pdu[4], e131_pdu[5]) !=
+        ola::acn::VECTOR_E131_DATA) {
+    return true;
+  }
+
+  const uint8_t *universe = data + E131PacketTemplate::UNIVERSE_OFFSET;
+  return m_dmp_inflator.HasHandler(JoinUInt8(universe[0], universe[1]));
+}
+
+
 bool E131Node::PerformDiscoveryHousekeeping() {
   // Send the Universe Discovery packets.
   vector<uint16_t> universes;
@@ -34,11 +34,13 @@
 #include "ola/base/Macro.h"
 #include "ola/io/SelectServerInterface.h"
 #include "ola/thread/SchedulerInterface.h"
+#include "ola/network/DatagramBatch.h"
 #include "ola/network/Interface.h"
 #include "ola/network/Socket.h"
 #include "libs/acn/DMPE131Inflator.h"
 #include "libs/acn/E131DiscoveryInflator.h"
 #include "libs/acn/E131Inflator.h"
+#include "libs/acn/E131PacketTemplate.h"
 #include "libs/acn/E131Sender.h"
 #include "libs/acn/RootInflator.h"
 #include "libs/acn/RootSender.h"
@@ -60,7 +62,8 @@ class E131Node {
          enable_draft_discovery(false),
          dscp(0),
          port(ola::acn::ACN_PORT),
-         source_name(ola::OLA_DEFAULT_INSTANCE_NAME) {
+         source_name(ola::OLA_DEFAULT_INSTANCE_NAME),
+         batch_sends(false) {
     }
 
     bool use_rev2;  /**< Use Revision 0.2 of the 2009 draft */
@@ -69,6 +72,11 @@ class E131Node {
     uint8_t dscp;  /**< The DSCP value to tag packets with */
     uint16_t port; /**< The UDP port to use, defaults to ACN_PORT */
     std::string source_name; /**< The source name to use */
+    /**
+     * Queue the packets produced during each SelectServer iteration and send
+     * them with as few system calls as possible.
+     */
+    bool batch_sends;
   };
 
   struct KnownController {
@@ -209,8 +217,17 @@ class E131Node {
 
  private:
   struct tx_universe {
+    tx_universe(const ola::acn::CID &cid, uint16_t universe,
+                const std::string &source_name)
+        : source(source_name),
+          sequence(0),
+          packet(cid, universe, source_name) {
+    }
+
     std::string source;
     uint8_t sequence;
+    // Only used for the ratified version of E1.31, not rev2.
+    E131PacketTemplate packet;
   };
 
   typedef std::map<uint16_t, tx_universe> ActiveTxUniverses;
@@ -223,6 +240,7 @@ class E131Node {
 
   ola::network::Interface m_interface;
   ola::network::UDPSocket m_socket;
+  ola::network::DatagramBatch m_batch;
   // senders
   RootSender m_root_sender;
   E131Sender m_e131_sender;
@@ -235,14 +253,20 @@ class E131Node {
 
   IncomingUDPTransport m_incoming_udp_transport;
   ActiveTxUniverses m_tx_universes;
-  uint8_t *m_send_buffer;
 
   // Discovery members
   ola::thread::timeout_id m_discovery_timeout;
   TrackedSources m_discovered_sources;
 
   tx_universe *SetupOutgoingSettings(uint16_t universe);
+  bool SendRev2DMX(uint16_t universe,
+                   const tx_universe &settings,
+                   const ola::DmxBuffer &buffer,
+                   uint8_t sequence,
+                   uint8_t priority,
+                   bool preview);
 
+  bool WantPacket(const uint8_t *data, unsigned int size);
   bool PerformDiscoveryHousekeeping();
   void NewDiscoveryPage(const HeaderSet &headers,
                         const E131DiscoveryInflator::DiscoveryPage &page);
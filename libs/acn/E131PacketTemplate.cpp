@@ -0,0 +1,168 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * E131PacketTemplate.cpp
+ * A pre-built E1.31 data packet for a single universe.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <string.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "ola/Logging.h"
+#include "ola/acn/ACNPort.h"
+#include "ola/acn/ACNVectors.h"
+#include "ola/network/IPV4Address.h"
+#include "ola/strings/Utils.h"
+#include "libs/acn/DMPAddress.h"
+#include "libs/acn/DMPPDU.h"
+#include "libs/acn/E131Header.h"
+#include "libs/acn/E131PDU.h"
+#include "libs/acn/E131PacketTemplate.h"
+#include "libs/acn/E131Sender.h"
+#include "libs/acn/PreamblePacker.h"
+#include "libs/acn/RootPDU.h"
+
+namespace ola {
+namespace acn {
+
+using ola::network::IPV4Address;
+using ola::network::IPV4SocketAddress;
+using std::string;
+using std::vector;
+
+/*
+ * Create a new template, this packs a full universe using the PDU classes so
+ * the layout always matches what E131Sender::SendDMP() would send.
+ * @param cid the CID to send in the Root PDU.
+ * @param universe the universe this packet is for.
+ * @param source the source name.
+ */
+E131PacketTemplate::E131PacketTemplate(const CID &cid,
+                                       uint16_t universe,
+                                       const string &source)
+    : m_slot_count(DMX_UNIVERSE_SIZE),
+      m_valid_universe(false) {
+  uint8_t dmp_data[DMX_UNIVERSE_SIZE + 1];
+  memset(dmp_data, 0, sizeof(dmp_data));
+
+  TwoByteRangeDMPAddress range_addr(0, 1, sizeof(dmp_data));
+  DMPAddressData<TwoByteRangeDMPAddress> range_chunk(&range_addr,
+                                                     dmp_data,
+                                                     sizeof(dmp_data));
+  vector<DMPAddressData<TwoByteRangeDMPAddress> > ranged_chunks;
+  ranged_chunks.push_back(range_chunk);
+  std::auto_ptr<const DMPPDU> dmp_pdu(
+      NewRangeDMPSetProperty<uint16_t>(true, false, ranged_chunks));
+
+  E131Header header(source, 0, 0, universe);
+  E131PDU e131_pdu(ola::acn::VECTOR_E131_DATA, header, dmp_pdu.get());
+  PDUBlock<PDU> e131_block;
+  e131_block.AddPDU(&e131_pdu);
+  RootPDU root_pdu(ola::acn::VECTOR_ROOT_E131, cid, &e131_block);
+  PDUBlock<PDU> root_block;
+  root_block.AddPDU(&root_pdu);
+
+  memcpy(m_packet, PreamblePacker::ACN_HEADER,
+         PreamblePacker::ACN_HEADER_SIZE);
+  unsigned int size = MAX_PACKET_SIZE - PreamblePacker::ACN_HEADER_SIZE;
+  if (!root_block.Pack(m_packet + PreamblePacker::ACN_HEADER_SIZE, &size) ||
+      size + PreamblePacker::ACN_HEADER_SIZE != MAX_PACKET_SIZE) {
+    OLA_WARN << "Unexpected E1.31 packet size " << size;
+  }
+
+  IPV4Address address;
+  m_valid_universe = E131Sender::UniverseIP(universe, &address);
+  m_destination = IPV4SocketAddress(address, ola::acn::ACN_PORT);
+}
+
+
+/*
+ * Change the source name
+ */
+void E131PacketTemplate::SetSource(const string &source) {
+  strings::CopyToFixedLengthBuffer(
+      source, reinterpret_cast<char*>(m_packet + SOURCE_OFFSET),
+      E131Header::SOURCE_NAME_LEN);
+}
+
+
+/*
+ * Copy a frame into the packet.
+ * @param buffer the DMX data, anything past 512 slots is ignored.
+ * @param priority the priority of the data.
+ * @param sequence the sequence number.
+ * @param preview true if this is preview data.
+ * @param terminated true if the stream has terminated.
+ * @param[out] length the length of the packet.
+ * @returns a pointer to the packet, this is valid until the next call to
+ *   Pack() or SetSource(). NULL is returned if the universe isn't a valid
+ *   E1.31 universe.
+ */
+const uint8_t *E131PacketTemplate::Pack(const DmxBuffer &buffer,
+                                        uint8_t priority,
+                                        uint8_t sequence,
+                                        bool preview,
+                                        bool terminated,
+                                        unsigned int *length) {
+  if (!m_valid_universe) {
+    return NULL;
+  }
+
+  unsigned int slot_count = DMX_UNIVERSE_SIZE;
+  buffer.Get(m_packet + DMX_DATA_OFFSET, &slot_count);
+  if (slot_count != m_slot_count) {
+    SetLengths(slot_count);
+  }
+
+  m_packet[PRIORITY_OFFSET] = priority;
+  m_packet[SEQUENCE_OFFSET] = sequence;
+  m_packet[OPTIONS_OFFSET] = static_cast<uint8_t>(
+      (preview ? E131Header::PREVIEW_DATA_MASK : 0) |
+      (terminated ? E131Header::STREAM_TERMINATED_MASK : 0));
+  *length = DMX_DATA_OFFSET + slot_count;
+  return m_packet;
+}
+
+
+/*
+ * Update the PDU lengths and DMP property count for a new number of slots.
+ */
+void E131PacketTemplate::SetLengths(unsigned int slot_count) {
+  const unsigned int size = DMX_DATA_OFFSET + slot_count;
+  SetPDULength(ROOT_PDU_OFFSET, size - ROOT_PDU_OFFSET);
+  SetPDULength(E131_PDU_OFFSET, size - E131_PDU_OFFSET);
+  SetPDULength(DMP_PDU_OFFSET, size - DMP_PDU_OFFSET);
+
+  // The property count includes the start code.
+  const unsigned int property_count = slot_count + 1;
+  m_packet[PROPERTY_COUNT_OFFSET] = static_cast<uint8_t>(property_count >> 8);
+  m_packet[PROPERTY_COUNT_OFFSET + 1] = static_cast<uint8_t>(property_count);
+  m_slot_count = slot_count;
+}
+
+
+/*
+ * Set the length of the PDU at offset, leaving the flags as they are.
+ */
+void E131PacketTemplate::SetPDULength(unsigned int offset,
+                                      unsigned int length) {
+  m_packet[offset] = static_cast<uint8_t>(
+      (m_packet[offset] & 0xf0) | ((length >> 8) & 0x0f));
+  m_packet[offset + 1] = static_cast<uint8_t>(length);
+}
+}  // namespace acn
+}  // namespace ola
@@ -0,0 +1,91 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * E131PacketTemplate.h
+ * A pre-built E1.31 data packet for a single universe.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#ifndef LIBS_ACN_E131PACKETTEMPLATE_H_
+#define LIBS_ACN_E131PACKETTEMPLATE_H_
+
+#include <stdint.h>
+#include <string>
+#include "ola/Constants.h"
+#include "ola/DmxBuffer.h"
+#include "ola/acn/CID.h"
+#include "ola/network/SocketAddress.h"
+
+namespace ola {
+namespace acn {
+
+/*
+ * An E1.31 data packet for one universe, packed once.
+ *
+ * Only the sequence number, priority, options, DMX data and the lengths change
+ * from one frame to the next, so Pack() patches these in place rather than
+ * building the Root, E1.31 & DMP PDUs each time.
+ *
+ * This only supports the ratified version of E1.31, not revision 2.
+ */
+class E131PacketTemplate {
+ public:
+    E131PacketTemplate(const ola::acn::CID &cid,
+                       uint16_t universe,
+                       const std::string &source);
+
+    void SetSource(const std::string &source);
+
+    const uint8_t *Pack(const DmxBuffer &buffer,
+                        uint8_t priority,
+                        uint8_t sequence,
+                        bool preview,
+                        bool terminated,
+                        unsigned int *length);
+
+    const ola::network::IPV4SocketAddress &Destination() const {
+      return m_destination;
+    }
+
+    // The offsets of the fields within the packet.
+    enum {
+      ROOT_PDU_OFFSET = 16,
+      E131_PDU_OFFSET = 38,
+      SOURCE_OFFSET = 44,
+      PRIORITY_OFFSET = 108,
+      SEQUENCE_OFFSET = 111,
+      OPTIONS_OFFSET = 112,
+      UNIVERSE_OFFSET = 113,
+      DMP_PDU_OFFSET = 115,
+      PROPERTY_COUNT_OFFSET = 123,
+      START_CODE_OFFSET = 125,
+      DMX_DATA_OFFSET = 126,
+    };
+
+    static const unsigned int MAX_PACKET_SIZE =
+        DMX_DATA_OFFSET + DMX_UNIVERSE_SIZE;
+
+ private:
+    uint8_t m_packet[MAX_PACKET_SIZE];
+    unsigned int m_slot_count;
+    bool m_valid_universe;
+    ola::network::IPV4SocketAddress m_destination;
+
+    void SetLengths(unsigned int slot_count);
+    void SetPDULength(unsigned int offset, unsigned int length);
+};
+}  // namespace acn
+}  // namespace ola
+#endif  // LIBS_ACN_E131PACKETTEMPLATE_H_
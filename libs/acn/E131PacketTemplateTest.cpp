@@ -0,0 +1,213 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * E131PacketTemplateTest.cpp
+ * Test fixture for the E131PacketTemplate class
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ola/Constants.h"
+#include "ola/DmxBuffer.h"
+#include "ola/acn/ACNPort.h"
+#include "ola/acn/ACNVectors.h"
+#include "ola/acn/CID.h"
+#include "ola/network/SocketAddress.h"
+#include "libs/acn/DMPAddress.h"
+#include "libs/acn/DMPPDU.h"
+#include "libs/acn/E131Header.h"
+#include "libs/acn/E131PDU.h"
+#include "libs/acn/E131PacketTemplate.h"
+#include "libs/acn/PreamblePacker.h"
+#include "libs/acn/RootPDU.h"
+#include "ola/testing/TestUtils.h"
+
+namespace ola {
+namespace acn {
+
+using ola::DmxBuffer;
+using ola::acn::CID;
+using ola::network::IPV4SocketAddress;
+using std::string;
+using std::vector;
+
+class E131PacketTemplateTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(E131PacketTemplateTest);
+  CPPUNIT_TEST(testFullUniverse);
+  CPPUNIT_TEST(testChangingSize);
+  CPPUNIT_TEST(testOptions);
+  CPPUNIT_TEST(testSourceName);
+  CPPUNIT_TEST(testInvalidUniverse);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void setUp() { m_cid = CID::Generate(); }
+
+    void testFullUniverse();
+    void testChangingSize();
+    void testOptions();
+    void testSourceName();
+    void testInvalidUniverse();
+
+ private:
+    CID m_cid;
+    PreamblePacker m_packer;
+
+    void CheckPacket(E131PacketTemplate *packet_template,
+                     const DmxBuffer &buffer,
+                     const E131Header &header);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(E131PacketTemplateTest);
+
+
+/*
+ * Check the template matches the packet built from the PDU classes.
+ */
+void E131PacketTemplateTest::CheckPacket(E131PacketTemplate *packet_template,
+                                         const DmxBuffer &buffer,
+                                         const E131Header &header) {
+  uint8_t dmp_data[DMX_UNIVERSE_SIZE + 1];
+  dmp_data[0] = 0;
+  unsigned int data_size = DMX_UNIVERSE_SIZE;
+  buffer.Get(dmp_data + 1, &data_size);
+  data_size++;
+
+  TwoByteRangeDMPAddress range_addr(0, 1, (uint16_t) data_size);
+  DMPAddressData<TwoByteRangeDMPAddress> range_chunk(
+      &range_addr, dmp_data, data_size);
+  vector<DMPAddressData<TwoByteRangeDMPAddress> > ranged_chunks;
+  ranged_chunks.push_back(range_chunk);
+  std::auto_ptr<const DMPPDU> dmp_pdu(
+      NewRangeDMPSetProperty<uint16_t>(true, false, ranged_chunks));
+
+  E131PDU e131_pdu(ola::acn::VECTOR_E131_DATA, header, dmp_pdu.get());
+  PDUBlock<PDU> e131_block;
+  e131_block.AddPDU(&e131_pdu);
+  RootPDU root_pdu(ola::acn::VECTOR_ROOT_E131, m_cid, &e131_block);
+  PDUBlock<PDU> root_block;
+  root_block.AddPDU(&root_pdu);
+
+  unsigned int expected_length;
+  const uint8_t *expected = m_packer.Pack(root_block, &expected_length);
+  OLA_ASSERT_NOT_NULL(expected);
+
+  unsigned int length;
+  const uint8_t *packet = packet_template->Pack(
+      buffer, header.Priority(), header.Sequence(), header.PreviewData(),
+      header.StreamTerminated(), &length);
+  OLA_ASSERT_NOT_NULL(packet);
+  OLA_ASSERT_DATA_EQUALS(expected, expected_length, packet, length);
+}
+
+
+/*
+ * Check a full universe
+ */
+void E131PacketTemplateTest::testFullUniverse() {
+  E131PacketTemplate packet_template(m_cid, 1, "foo");
+  OLA_ASSERT_EQ(IPV4SocketAddress::FromStringOrDie("239.255.0.1:5568"),
+                packet_template.Destination());
+
+  DmxBuffer buffer;
+  buffer.SetRangeToValue(0, 255, DMX_UNIVERSE_SIZE);
+  CheckPacket(&packet_template, buffer, E131Header("foo", 100, 0, 1));
+  OLA_ASSERT_EQ(638u,
+                static_cast<unsigned int>(E131PacketTemplate::MAX_PACKET_SIZE));
+
+  buffer.SetChannel(10, 20);
+  CheckPacket(&packet_template, buffer, E131Header("foo", 100, 1, 1));
+}
+
+
+/*
+ * Check the lengths are updated as the number of slots changes.
+ */
+void E131PacketTemplateTest::testChangingSize() {
+  E131PacketTemplate packet_template(m_cid, 0x1234, "foo");
+
+  DmxBuffer buffer;
+  buffer.SetFromString("1,2,3,4");
+  CheckPacket(&packet_template, buffer, E131Header("foo", 100, 0, 0x1234));
+
+  buffer.Reset();
+  CheckPacket(&packet_template, buffer, E131Header("foo", 100, 1, 0x1234));
+
+  buffer.Blackout();
+  CheckPacket(&packet_template, buffer, E131Header("foo", 100, 2, 0x1234));
+
+  buffer.SetFromString("10,9,8");
+  CheckPacket(&packet_template, buffer, E131Header("foo", 100, 3, 0x1234));
+}
+
+
+/*
+ * Check the priority, sequence number and option flags
+ */
+void E131PacketTemplateTest::testOptions() {
+  E131PacketTemplate packet_template(m_cid, 2, "foo");
+  DmxBuffer buffer;
+  buffer.SetFromString("1,2,3,4");
+
+  CheckPacket(&packet_template, buffer,
+              E131Header("foo", 200, 255, 2, true, false));
+  CheckPacket(&packet_template, buffer,
+              E131Header("foo", 0, 0, 2, false, true));
+  CheckPacket(&packet_template, buffer,
+              E131Header("foo", 150, 10, 2, true, true));
+  CheckPacket(&packet_template, buffer,
+              E131Header("foo", 100, 11, 2, false, false));
+}
+
+
+/*
+ * Check the source name can be changed
+ */
+void E131PacketTemplateTest::testSourceName() {
+  E131PacketTemplate packet_template(m_cid, 3, "a long source name");
+  DmxBuffer buffer;
+  buffer.SetFromString("1,2,3,4");
+  CheckPacket(&packet_template, buffer,
+              E131Header("a long source name", 100, 0, 3));
+
+  packet_template.SetSource("bar");
+  CheckPacket(&packet_template, buffer, E131Header("bar", 100, 1, 3));
+
+  const string long_name(100, 'x');
+  packet_template.SetSource(long_name);
+  CheckPacket(&packet_template, buffer, E131Header(long_name, 100, 2, 3));
+}
+
+
+/*
+ * Check nothing is packed for the reserved universes.
+ */
+void E131PacketTemplateTest::testInvalidUniverse() {
+  DmxBuffer buffer;
+  buffer.SetFromString("1,2,3,4");
+  unsigned int length;
+
+  E131PacketTemplate zero(m_cid, 0, "foo");
+  OLA_ASSERT_NULL(zero.Pack(buffer, 100, 0, false, false, &length));
+
+  E131PacketTemplate max(m_cid, 0xffff, "foo");
+  OLA_ASSERT_NULL(max.Pack(buffer, 100, 0, false, false, &length));
+}
+}  // namespace acn
+}  // namespace ola
@@ -44,6 +44,22 @@ class E131Sender {
   bool SendDiscoveryData(const E131Header &header, const uint8_t *data,
                          unsigned int data_size);
 
+  /**
+   * @brief Send an already packed E1.31 datagram.
+   */
+  bool SendPacket(const uint8_t *data, unsigned int length,
+                  const ola::network::IPV4SocketAddress &destination) {
+    return m_transport_impl.Send(data, length, destination);
+  }
+
+  /**
+   * @brief Queue packets in a batch rather than sending them immediately.
+   * @param batch the DatagramBatch to use, or NULL to send immediately.
+   */
+  void SetBatch(ola::network::DatagramBatch *batch) {
+    m_transport_impl.SetBatch(batch);
+  }
+
   static bool UniverseIP(uint16_t universe,
                          class ola::network::IPV4Address *addr);
 
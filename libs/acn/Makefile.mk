@@ -49,6 +49,8 @@ libs_acn_libolae131core_la_SOURCES = \
     libs/acn/E131Node.h \
     libs/acn/E131PDU.cpp \
     libs/acn/E131PDU.h \
+    libs/acn/E131PacketTemplate.cpp \
+    libs/acn/E131PacketTemplate.h \
     libs/acn/E131Sender.cpp \
     libs/acn/E131Sender.h \
     libs/acn/E133Header.h \
@@ -82,7 +84,8 @@ libs_acn_libolae131core_la_SOURCES = \
     libs/acn/Transport.h \
     libs/acn/TransportHeader.h \
     libs/acn/UDPTransport.cpp \
-    libs/acn/UDPTransport.h
+    libs/acn/UDPTransport.h \
+    libs/acn/UniverseTable.h
 
 libs_acn_libolae131core_la_CXXFLAGS = \
     $(COMMON_E131_CXXFLAGS) $(uuid_CFLAGS)
@@ -118,11 +121,13 @@ libs_acn_E131Tester_SOURCES = \
     libs/acn/DMPPDUTest.cpp \
     libs/acn/E131InflatorTest.cpp \
     libs/acn/E131PDUTest.cpp \
+    libs/acn/E131PacketTemplateTest.cpp \
     libs/acn/HeaderSetTest.cpp \
     libs/acn/PDUTest.cpp \
     libs/acn/RootInflatorTest.cpp \
     libs/acn/RootPDUTest.cpp \
-    libs/acn/RootSenderTest.cpp
+    libs/acn/RootSenderTest.cpp \
+    libs/acn/UniverseTableTest.cpp
 libs_acn_E131Tester_CPPFLAGS = $(COMMON_TESTING_FLAGS)
 # For some completely messed up reason on mac CPPUNIT_LIBS has to come after
 # the ossp uuid library.
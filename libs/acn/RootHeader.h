@@ -34,7 +34,7 @@ class RootHeader {
     RootHeader() {}
     ~RootHeader() {}
     void SetCid(ola::acn::CID cid) { m_cid = cid; }
-    ola::acn::CID GetCid() const { return m_cid; }
+    const ola::acn::CID &GetCid() const { return m_cid; }
 
     bool operator==(const RootHeader &other) const {
       return m_cid == other.m_cid;
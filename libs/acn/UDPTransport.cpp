@@ -57,7 +57,24 @@ bool OutgoingUDPTransportImpl::Send(const PDUBlock<PDU> &pdu_block,
   if (!data)
     return false;
 
-  return m_socket->SendTo(data, data_size, destination);
+  return Send(data, data_size, destination);
+}
+
+
+/*
+ * Send an already packed datagram, this must include the ACN preamble.
+ * @param data the datagram to send
+ * @param length the length of the datagram
+ * @param destination the ipv4 address & port to send to
+ */
+bool OutgoingUDPTransportImpl::Send(const uint8_t *data,
+                                    unsigned int length,
+                                    const IPV4SocketAddress &destination) {
+  if (m_batch) {
+    m_batch->Add(data, length, destination);
+    return true;
+  }
+  return m_socket->SendTo(data, length, destination);
 }
 
 
@@ -66,7 +83,8 @@ IncomingUDPTransport::IncomingUDPTransport(ola::network::UDPSocket *socket,
                                            BaseInflator *inflator)
     : m_socket(socket),
       m_inflator(inflator),
-      m_recv_buffer(NULL) {
+      m_recv_buffer(NULL),
+      m_filter(NULL) {
 }
 
 
@@ -74,35 +92,60 @@ IncomingUDPTransport::IncomingUDPTransport(ola::network::UDPSocket *socket,
  * Called when new data arrives.
  */
 void IncomingUDPTransport::Receive() {
-  if (!m_recv_buffer)
-    m_recv_buffer = new uint8_t[PreamblePacker::MAX_DATAGRAM_SIZE];
+  if (!m_recv_buffer) {
+    m_recv_buffer = new uint8_t[
+        RECEIVE_BATCH_SIZE * PreamblePacker::MAX_DATAGRAM_SIZE];
+  }
 
-  ssize_t size = PreamblePacker::MAX_DATAGRAM_SIZE;
-  ola::network::IPV4SocketAddress source;
+  ola::network::IncomingDatagram datagrams[RECEIVE_BATCH_SIZE];
+
+  // If the socket reads until empty, keep going until it would block.
+  unsigned int count;
+  do {
+    // RecvMany() sets the size to the length of each datagram, so this needs
+    // to be reset for every batch.
+    for (unsigned int i = 0; i < RECEIVE_BATCH_SIZE; i++) {
+      datagrams[i].data = m_recv_buffer +
+                          i * PreamblePacker::MAX_DATAGRAM_SIZE;
+      datagrams[i].size = PreamblePacker::MAX_DATAGRAM_SIZE;
+    }
+    count = m_socket->RecvMany(datagrams, RECEIVE_BATCH_SIZE);
+    for (unsigned int i = 0; i < count; i++) {
+      HandleDatagram(datagrams[i].data, datagrams[i].size,
+                     datagrams[i].source);
+    }
+  } while (count && m_socket->ReadsUntilEmpty());
+}
 
-  if (!m_socket->RecvFrom(m_recv_buffer, &size, &source))
-    return;
 
+/*
+ * Inflate a single datagram.
+ */
+void IncomingUDPTransport::HandleDatagram(
+    const uint8_t *data,
+    unsigned int size,
+    const ola::network::IPV4SocketAddress &source) {
   unsigned int header_size = PreamblePacker::ACN_HEADER_SIZE;
-  if (size < static_cast<ssize_t>(header_size)) {
+  if (size < header_size) {
     OLA_WARN << "short ACN frame, discarding";
     return;
   }
 
-  if (memcmp(m_recv_buffer, PreamblePacker::ACN_HEADER, header_size)) {
+  if (memcmp(data, PreamblePacker::ACN_HEADER, header_size)) {
     OLA_WARN << "ACN header is bad, discarding";
     return;
   }
 
+  if (m_filter && !m_filter->Run(data, size)) {
+    return;
+  }
+
   HeaderSet header_set;
   TransportHeader transport_header(source, TransportHeader::UDP);
   header_set.SetTransportHeader(transport_header);
 
-  m_inflator->InflatePDUBlock(
-      &header_set,
-      m_recv_buffer + header_size,
-      static_cast<unsigned int>(size) - header_size);
-  return;
+  m_inflator->InflatePDUBlock(&header_set, data + header_size,
+                              size - header_size);
 }
 }  // namespace acn
 }  // namespace ola
@@ -21,8 +21,10 @@
 #ifndef LIBS_ACN_UDPTRANSPORT_H_
 #define LIBS_ACN_UDPTRANSPORT_H_
 
+#include "ola/Callback.h"
 #include "ola/acn/ACNPort.h"
 #include "ola/base/Macro.h"
+#include "ola/network/DatagramBatch.h"
 #include "ola/network/IPV4Address.h"
 #include "ola/network/Socket.h"
 #include "libs/acn/PDU.h"
@@ -65,7 +67,8 @@ class OutgoingUDPTransportImpl {
                              PreamblePacker *packer = NULL)
         : m_socket(socket),
           m_packer(packer),
-          m_free_packer(false) {
+          m_free_packer(false),
+          m_batch(NULL) {
       if (!m_packer) {
         m_packer = new PreamblePacker();
         m_free_packer = true;
@@ -78,11 +81,21 @@ class OutgoingUDPTransportImpl {
 
     bool Send(const PDUBlock<PDU> &pdu_block,
               const ola::network::IPV4SocketAddress &destination);
+    bool Send(const uint8_t *data, unsigned int length,
+              const ola::network::IPV4SocketAddress &destination);
+
+    /**
+     * @brief Queue datagrams in a batch rather than sending them immediately.
+     * @param batch the DatagramBatch to use, or NULL to send immediately.
+     *   Ownership is not transferred.
+     */
+    void SetBatch(ola::network::DatagramBatch *batch) { m_batch = batch; }
 
  private:
     ola::network::UDPSocket *m_socket;
     PreamblePacker *m_packer;
     bool m_free_packer;
+    ola::network::DatagramBatch *m_batch;
 };
 
 
@@ -93,19 +106,41 @@ class OutgoingUDPTransportImpl {
  */
 class IncomingUDPTransport {
  public:
+    /*
+     * Called with each datagram, including the ACN preamble. Return false to
+     * drop the datagram before it's inflated.
+     */
+    typedef ola::Callback2<bool, const uint8_t*, unsigned int> PacketFilter;
+
     IncomingUDPTransport(ola::network::UDPSocket *socket,
                          class BaseInflator *inflator);
     ~IncomingUDPTransport() {
       if (m_recv_buffer)
         delete[] m_recv_buffer;
+      delete m_filter;
     }
 
     void Receive();
 
+    /*
+     * Set the filter to run before inflation, ownership is transferred.
+     */
+    void SetPacketFilter(PacketFilter *filter) {
+      delete m_filter;
+      m_filter = filter;
+    }
+
  private:
+    // The maximum number of datagrams read per call to Receive().
+    static const unsigned int RECEIVE_BATCH_SIZE = 16;
+
     ola::network::UDPSocket *m_socket;
     class BaseInflator *m_inflator;
     uint8_t *m_recv_buffer;
+    PacketFilter *m_filter;
+
+    void HandleDatagram(const uint8_t *data, unsigned int size,
+                        const ola::network::IPV4SocketAddress &source);
 };
 }  // namespace acn
 }  // namespace ola
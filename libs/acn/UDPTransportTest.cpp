@@ -41,18 +41,22 @@ using ola::network::IPV4SocketAddress;
 class UDPTransportTest: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(UDPTransportTest);
   CPPUNIT_TEST(testUDPTransport);
+  CPPUNIT_TEST(testDrainMixedSizes);
   CPPUNIT_TEST_SUITE_END();
 
  public:
-    UDPTransportTest(): TestFixture(), m_ss(NULL) {}
+    UDPTransportTest(): TestFixture(), m_ss(NULL), m_pdu_count(0) {}
     void testUDPTransport();
+    void testDrainMixedSizes();
     void setUp();
     void tearDown();
     void Stop();
     void FatalStop() { OLA_ASSERT(false); }
+    void PDUReceived() { m_pdu_count++; }
 
  private:
     ola::io::SelectServer *m_ss;
+    unsigned int m_pdu_count;
     static const int ABORT_TIMEOUT_IN_MS = 1000;
 };
 
@@ -112,5 +116,54 @@ void UDPTransportTest::testUDPTransport() {
   m_ss->RegisterSingleTimeout(ABORT_TIMEOUT_IN_MS, closure);
   m_ss->Run();
 }
+
+
+/*
+ * Check that a socket which reads until empty receives every datagram when
+ * more than one batch is queued, and the datagrams have different sizes.
+ */
+void UDPTransportTest::testDrainMixedSizes() {
+  CID cid;
+  std::auto_ptr<Callback0<void> > pdu_closure(
+      NewCallback(this, &UDPTransportTest::PDUReceived));
+  MockInflator inflator(cid, pdu_closure.get());
+
+  ola::network::UDPSocket socket;
+  OLA_ASSERT(socket.Init());
+  OLA_ASSERT(socket.Bind(IPV4SocketAddress(IPV4Address::Loopback(), 0)));
+  OLA_ASSERT(socket.SetReadsUntilEmpty());
+  IPV4SocketAddress local_address;
+  OLA_ASSERT(socket.GetSocketAddress(&local_address));
+
+  IncomingUDPTransport incoming_udp_transport(&socket, &inflator);
+  OutgoingUDPTransportImpl udp_transport_impl(&socket);
+  OutgoingUDPTransport outgoing_udp_transport(&udp_transport_impl,
+      IPV4Address::Loopback(), local_address.Port());
+
+  PDUBlock<PDU> small_block;
+  MockPDU mock_pdu(4, 8);
+  small_block.AddPDU(&mock_pdu);
+
+  PDUBlock<PDU> large_block;
+  MockPDU mock_pdu2(5, 10);
+  MockPDU mock_pdu3(6, 12);
+  large_block.AddPDU(&mock_pdu);
+  large_block.AddPDU(&mock_pdu2);
+  large_block.AddPDU(&mock_pdu3);
+
+  // The transport reads 16 datagrams at a time. Alternate between runs of 16
+  // small and 16 large datagrams, so each slot holds a small datagram
+  // before a large one.
+  const unsigned int DATAGRAM_COUNT = 72;
+  unsigned int expected_pdus = 0;
+  for (unsigned int i = 0; i < DATAGRAM_COUNT; i++) {
+    bool large = (i / 16) % 2;
+    OLA_ASSERT(outgoing_udp_transport.Send(large ? large_block : small_block));
+    expected_pdus += large ? 3 : 1;
+  }
+
+  incoming_udp_transport.Receive();
+  OLA_ASSERT_EQ(expected_pdus, m_pdu_count);
+}
 }  // namespace acn
 }  // namespace ola
@@ -0,0 +1,185 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * UniverseTable.h
+ * An open addressed hash table keyed by universe.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#ifndef LIBS_ACN_UNIVERSETABLE_H_
+#define LIBS_ACN_UNIVERSETABLE_H_
+
+#include <stdint.h>
+#include <vector>
+#include "ola/base/Macro.h"
+
+namespace ola {
+namespace acn {
+
+/*
+ * A hash table from universe to T, using linear probing.
+ *
+ * This is used on the receive path, where every packet needs a universe lookup
+ * and most lookups miss. The entries live in a single array, so a lookup is a
+ * multiply and usually a single cache line, rather than walking a tree.
+ *
+ * Pointers returned by Find() and Insert() are invalidated by the next
+ * Insert() or Remove().
+ */
+template <typename T>
+class UniverseTable {
+ public:
+    UniverseTable()
+        : m_size(0),
+          m_shift(32 - INITIAL_CAPACITY_BITS),
+          m_slots(1u << INITIAL_CAPACITY_BITS) {
+    }
+
+    unsigned int Size() const { return m_size; }
+
+    /*
+     * Return the value for a universe, or NULL if there isn't one.
+     */
+    T *Find(uint16_t universe) {
+      for (unsigned int i = Hash(universe); ; i = Next(i)) {
+        Slot &slot = m_slots[i];
+        if (!slot.in_use) {
+          return NULL;
+        } else if (slot.universe == universe) {
+          return &slot.value;
+        }
+      }
+    }
+
+    bool Contains(uint16_t universe) { return Find(universe) != NULL; }
+
+    /*
+     * Add or replace the value for a universe.
+     * @returns a pointer to the stored value.
+     */
+    T *Insert(uint16_t universe, const T &value) {
+      T *existing = Find(universe);
+      if (existing) {
+        *existing = value;
+        return existing;
+      }
+
+      // Keep the load factor at or below 1/2.
+      if (2 * (m_size + 1) > m_slots.size()) {
+        Grow();
+      }
+
+      unsigned int i = Hash(universe);
+      while (m_slots[i].in_use) {
+        i = Next(i);
+      }
+      m_slots[i].in_use = true;
+      m_slots[i].universe = universe;
+      m_slots[i].value = value;
+      m_size++;
+      return &m_slots[i].value;
+    }
+
+    /*
+     * Remove a universe.
+     * @returns true if the universe was removed, false if it didn't exist.
+     */
+    bool Remove(uint16_t universe) {
+      unsigned int i = Hash(universe);
+      for (; m_slots[i].universe != universe; i = Next(i)) {
+        if (!m_slots[i].in_use) {
+          return false;
+        }
+      }
+      if (!m_slots[i].in_use) {
+        return false;
+      }
+
+      // Shift any later entries in the probe sequence back, so there's never a
+      // gap between an entry and its home slot.
+      unsigned int hole = i;
+      for (unsigned int j = Next(i); m_slots[j].in_use; j = Next(j)) {
+        unsigned int home = Hash(m_slots[j].universe);
+        // Move the entry if its home slot isn't in (hole, j].
+        bool between = (hole < j) ? (home > hole && home <= j)
+                                  : (home > hole || home <= j);
+        if (!between) {
+          m_slots[hole] = m_slots[j];
+          hole = j;
+        }
+      }
+      m_slots[hole].in_use = false;
+      m_slots[hole].value = T();
+      m_size--;
+      return true;
+    }
+
+    /*
+     * Get the universes in the table, in no particular order.
+     */
+    void Universes(std::vector<uint16_t> *universes) const {
+      universes->clear();
+      typename std::vector<Slot>::const_iterator iter = m_slots.begin();
+      for (; iter != m_slots.end(); ++iter) {
+        if (iter->in_use) {
+          universes->push_back(iter->universe);
+        }
+      }
+    }
+
+ private:
+    struct Slot {
+      Slot() : in_use(false), universe(0), value() {}
+
+      bool in_use;
+      uint16_t universe;
+      T value;
+    };
+
+    unsigned int m_size;
+    // 32 - log2(the number of slots)
+    unsigned int m_shift;
+    std::vector<Slot> m_slots;
+
+    // Fibonacci hashing, this takes the top bits of the product so every bit
+    // of the universe affects the slot.
+    unsigned int Hash(uint16_t universe) const {
+      return static_cast<uint32_t>(universe * 2654435769u) >> m_shift;
+    }
+
+    unsigned int Next(unsigned int i) const {
+      return (i + 1) & static_cast<unsigned int>(m_slots.size() - 1);
+    }
+
+    void Grow() {
+      std::vector<Slot> old_slots(2 * m_slots.size());
+      old_slots.swap(m_slots);
+      m_shift--;
+      m_size = 0;
+      typename std::vector<Slot>::const_iterator iter = old_slots.begin();
+      for (; iter != old_slots.end(); ++iter) {
+        if (iter->in_use) {
+          Insert(iter->universe, iter->value);
+        }
+      }
+    }
+
+    static const unsigned int INITIAL_CAPACITY_BITS = 4;
+
+    DISALLOW_COPY_AND_ASSIGN(UniverseTable);
+};
+}  // namespace acn
+}  // namespace ola
+#endif  // LIBS_ACN_UNIVERSETABLE_H_
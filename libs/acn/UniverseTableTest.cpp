@@ -0,0 +1,150 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * UniverseTableTest.cpp
+ * Test fixture for the UniverseTable class
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdlib.h>
+#include <map>
+#include <vector>
+
+#include "libs/acn/UniverseTable.h"
+#include "ola/testing/TestUtils.h"
+
+namespace ola {
+namespace acn {
+
+using std::map;
+using std::vector;
+
+class UniverseTableTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(UniverseTableTest);
+  CPPUNIT_TEST(testInsertAndFind);
+  CPPUNIT_TEST(testRemove);
+  CPPUNIT_TEST(testRandomOperations);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void testInsertAndFind();
+    void testRemove();
+    void testRandomOperations();
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(UniverseTableTest);
+
+
+/*
+ * Check we can add universes and look them up, including across a resize.
+ */
+void UniverseTableTest::testInsertAndFind() {
+  UniverseTable<int> table;
+  OLA_ASSERT_EQ(0u, table.Size());
+  OLA_ASSERT_NULL(table.Find(1));
+  OLA_ASSERT_FALSE(table.Contains(0));
+
+  OLA_ASSERT_EQ(10, *table.Insert(0, 10));
+  OLA_ASSERT_EQ(11, *table.Insert(1, 11));
+  OLA_ASSERT_EQ(2u, table.Size());
+  OLA_ASSERT_EQ(10, *table.Find(0));
+  OLA_ASSERT_EQ(11, *table.Find(1));
+
+  // replace an existing value
+  table.Insert(1, 12);
+  OLA_ASSERT_EQ(2u, table.Size());
+  OLA_ASSERT_EQ(12, *table.Find(1));
+
+  for (unsigned int i = 0; i < 1000; i++) {
+    uint16_t universe = static_cast<uint16_t>(i * 64);
+    table.Insert(universe, i);
+  }
+  OLA_ASSERT_EQ(1001u, table.Size());
+  for (unsigned int i = 0; i < 1000; i++) {
+    uint16_t universe = static_cast<uint16_t>(i * 64);
+    OLA_ASSERT_EQ(static_cast<int>(i), *table.Find(universe));
+  }
+  OLA_ASSERT_EQ(12, *table.Find(1));
+  OLA_ASSERT_NULL(table.Find(2));
+  OLA_ASSERT_NULL(table.Find(65535));
+
+  vector<uint16_t> universes;
+  table.Universes(&universes);
+  OLA_ASSERT_EQ(static_cast<size_t>(1001), universes.size());
+}
+
+
+/*
+ * Check removing universes.
+ */
+void UniverseTableTest::testRemove() {
+  UniverseTable<int> table;
+  OLA_ASSERT_FALSE(table.Remove(1));
+
+  for (uint16_t i = 1; i <= 6; i++) {
+    table.Insert(i, i);
+  }
+  OLA_ASSERT_TRUE(table.Remove(3));
+  OLA_ASSERT_FALSE(table.Remove(3));
+  OLA_ASSERT_EQ(5u, table.Size());
+  OLA_ASSERT_NULL(table.Find(3));
+  for (uint16_t i = 1; i <= 6; i++) {
+    if (i != 3) {
+      OLA_ASSERT_EQ(static_cast<int>(i), *table.Find(i));
+    }
+  }
+
+  table.Insert(3, 30);
+  OLA_ASSERT_EQ(30, *table.Find(3));
+  OLA_ASSERT_EQ(6u, table.Size());
+}
+
+
+/*
+ * Compare the table against a std::map, this exercises the probe sequences
+ * wrapping around and the entries being shifted back on removal.
+ */
+void UniverseTableTest::testRandomOperations() {
+  UniverseTable<unsigned int> table;
+  map<uint16_t, unsigned int> expected;
+  unsigned int seed = 42;
+
+  for (unsigned int i = 0; i < 20000; i++) {
+    // Keep the universes in a small range so there are lots of collisions.
+    uint16_t universe = static_cast<uint16_t>(rand_r(&seed) % 512);
+    if (rand_r(&seed) % 3) {
+      table.Insert(universe, i);
+      expected[universe] = i;
+    } else {
+      OLA_ASSERT_EQ(expected.erase(universe) == 1, table.Remove(universe));
+    }
+  }
+
+  OLA_ASSERT_EQ(static_cast<unsigned int>(expected.size()), table.Size());
+  for (unsigned int universe = 0; universe < 512; universe++) {
+    map<uint16_t, unsigned int>::const_iterator iter = expected.find(
+        static_cast<uint16_t>(universe));
+    unsigned int *value = table.Find(static_cast<uint16_t>(universe));
+    if (iter == expected.end()) {
+      OLA_ASSERT_NULL(value);
+    } else {
+      OLA_ASSERT_NOT_NULL(value);
+      OLA_ASSERT_EQ(iter->second, *value);
+    }
+  }
+}
+}  // namespace acn
+}  // namespace ola
@@ -18,10 +18,14 @@
  * Copyright (C) 2013 Simon Newton
  */
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <sys/resource.h>
 #include <algorithm>
+#include <iostream>
 #include <string>
 #include "ola/Callback.h"
+#include "ola/Clock.h"
 #include "ola/DmxBuffer.h"
 #include "ola/Logging.h"
 #include "ola/base/Flags.h"
@@ -33,19 +37,51 @@ using ola::DmxBuffer;
 using ola::io::SelectServer;
 using ola::acn::E131Node;
 using ola::NewCallback;
+using std::cout;
+using std::endl;
 using std::min;
 
 DEFINE_s_uint32(fps, s, 10, "Frames per second per universe [1 - 40]");
 DEFINE_s_uint16(universes, u, 1, "Number of universes to send");
+DEFINE_default_bool(batch, false,
+                    "Send all the universes in a frame with a single system "
+                    "call");
+DEFINE_uint32(report_interval, 5,
+              "Seconds between CPU usage reports, 0 to disable");
 
 /**
  * Send N DMX frames using E1.31, where N is given by number_of_universes.
  */
 bool SendFrames(E131Node *node, DmxBuffer *buffer,
-                uint16_t number_of_universes) {
+                uint16_t number_of_universes, unsigned int *frames_sent) {
   for (uint16_t i = 1; i < number_of_universes + 1; i++) {
     node->SendDMX(i, *buffer);
   }
+  *frames_sent += number_of_universes;
+  return true;
+}
+
+/**
+ * Print the CPU time used per universe frame since the last report.
+ */
+bool ReportUsage(const unsigned int *frames_sent) {
+  static unsigned int last_frames = 0;
+  static uint64_t last_cpu_usec = 0;
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  uint64_t cpu_usec = (
+      static_cast<uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+      ola::USEC_IN_SECONDS + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+
+  unsigned int frames = *frames_sent - last_frames;
+  if (frames) {
+    cout << frames << " universe frames, "
+         << static_cast<double>(cpu_usec - last_cpu_usec) / frames
+         << " us CPU per universe frame" << endl;
+  }
+  last_frames = *frames_sent;
+  last_cpu_usec = cpu_usec;
   return true;
 }
 
@@ -62,14 +98,23 @@ int main(int argc, char* argv[]) {
   output.Blackout();
   SelectServer ss;
 
-  E131Node node(&ss, "", E131Node::Options());
+  E131Node::Options options;
+  options.batch_sends = FLAGS_batch;
+  E131Node node(&ss, "", options);
   if (!node.Start())
     return -1;
 
   ss.AddReadDescriptor(node.GetSocket());
+  unsigned int frames_sent = 0;
   ss.RegisterRepeatingTimeout(
       1000 / fps,
-      NewCallback(&SendFrames, &node, &output, universes));
+      NewCallback(&SendFrames, &node, &output, universes, &frames_sent));
+  if (FLAGS_report_interval) {
+    ss.RegisterRepeatingTimeout(
+        FLAGS_report_interval * 1000,
+        NewCallback(&ReportUsage,
+                    static_cast<const unsigned int*>(&frames_sent)));
+  }
   OLA_INFO << "Starting loadtester...";
   ss.Run();
 }
@@ -126,8 +126,25 @@ OlaUniverse ClientTypesFactory::UniverseFromProtobuf(
                      universe_info.name(),
                      input_ports,
                      output_ports,
-                     universe_info.rdm_devices());
+                     universe_info.rdm_devices(),
+                     universe_info.rdm_discovery_queued(),
+                     universe_info.rdm_discovery_running());
 }
 
+
+/*
+ * Create a LatencyStats object from a protobuf.
+ */
+LatencyStats ClientTypesFactory::LatencyFromProtobuf(
+    const ola::proto::LatencyStats &latency_stats) {
+  LatencyStats stats;
+  stats.count = latency_stats.count();
+  stats.p50 = latency_stats.p50();
+  stats.p90 = latency_stats.p90();
+  stats.p99 = latency_stats.p99();
+  stats.p999 = latency_stats.p999();
+  stats.max = latency_stats.max();
+  return stats;
+}
 }  // namespace client
 }  // namespace ola
@@ -43,6 +43,8 @@ class ClientTypesFactory {
       const ola::proto::DeviceInfo &device_info);
   static OlaUniverse UniverseFromProtobuf(
       const ola::proto::UniverseInfo &universe_info);
+  static LatencyStats LatencyFromProtobuf(
+      const ola::proto::LatencyStats &latency_stats);
 };
 
 }  // namespace client
@@ -444,7 +444,9 @@ void OlaCallbackClient::HandleUniverseInfo(
       universe.Name(),
       universe.InputPorts(),
       universe.OutputPorts(),
-      universe.RDMDeviceCount());
+      universe.RDMDeviceCount(),
+      universe.RDMDiscoveryQueuedCount(),
+      universe.RDMDiscoveryRunningCount());
   callback->Run(new_universe, result.Error());
 }
 
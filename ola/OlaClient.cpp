@@ -131,6 +131,10 @@ void OlaClient::FetchUniverseInfo(unsigned int universe,
   m_core->FetchUniverseInfo(universe, callback);
 }
 
+void OlaClient::FetchLatencyStats(LatencyStatsCallback *callback) {
+  m_core->FetchLatencyStats(callback);
+}
+
 void OlaClient::SetUniverseName(unsigned int universe,
                                 const string &name,
                                 SetCallback *callback) {
@@ -164,10 +168,20 @@ void OlaClient::SendDMX(unsigned int universe,
   m_core->SendDMX(universe, data, args);
 }
 
+void OlaClient::SendDMXBatch(const vector<UniverseDMX> &frames,
+                             GeneralSetCallback *callback) {
+  m_core->SendDMXBatch(frames, callback);
+}
+
 void OlaClient::FetchDMX(unsigned int universe, DMXCallback *callback) {
   m_core->FetchDMX(universe, callback);
 }
 
+void OlaClient::FetchDMXBatch(const vector<unsigned int> &universes,
+                              DMXBatchCallback *callback) {
+  m_core->FetchDMXBatch(universes, callback);
+}
+
 void OlaClient::RunDiscovery(unsigned int universe,
                              DiscoveryType discovery_type,
                              DiscoveryCallback *callback) {
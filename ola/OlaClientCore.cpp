@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/protocol/Ola.pb.h"
@@ -365,6 +366,23 @@ void OlaClientCore::FetchUniverseInfo(unsigned int universe_id,
   }
 }
 
+void OlaClientCore::FetchLatencyStats(LatencyStatsCallback *callback) {
+  RpcController *controller = new RpcController();
+  ola::proto::OptionalUniverseRequest request;
+  ola::proto::LatencyReply *reply = new ola::proto::LatencyReply();
+
+  if (m_connected) {
+    CompletionCallback *cb = ola::NewSingleCallback(
+        this,
+        &OlaClientCore::HandleLatencyStats,
+        controller, reply, callback);
+    m_stub->GetLatencyStats(controller, &request, reply, cb);
+  } else {
+    controller->SetFailed(NOT_CONNECTED_ERROR);
+    HandleLatencyStats(controller, reply, callback);
+  }
+}
+
 void OlaClientCore::SetUniverseName(unsigned int universe,
                                     const string &name,
                                     SetCallback *callback) {
@@ -495,6 +513,38 @@ void OlaClientCore::SendDMX(unsigned int universe,
   }
 }
 
+void OlaClientCore::SendDMXBatch(const vector<UniverseDMX> &frames,
+                                 GeneralSetCallback *callback) {
+  ola::proto::DmxDataBatch request;
+  vector<UniverseDMX>::const_iterator iter = frames.begin();
+  for (; iter != frames.end(); ++iter) {
+    ola::proto::DmxData *dmx_data = request.add_data();
+    dmx_data->set_universe(iter->universe);
+    dmx_data->set_data(iter->data.Get());
+    dmx_data->set_priority(iter->priority);
+  }
+
+  if (callback) {
+    // Full request
+    RpcController *controller = new RpcController();
+    ola::proto::Ack *reply = new ola::proto::Ack();
+
+    if (m_connected) {
+      CompletionCallback *cb = ola::NewSingleCallback(
+          this,
+          &OlaClientCore::HandleGeneralAck,
+          controller, reply, callback);
+      m_stub->UpdateDmxDataBatch(controller, &request, reply, cb);
+    } else {
+      controller->SetFailed(NOT_CONNECTED_ERROR);
+      HandleGeneralAck(controller, reply, callback);
+    }
+  } else if (m_connected) {
+    // stream data
+    m_stub->StreamDmxDataBatch(NULL, &request, NULL, NULL);
+  }
+}
+
 void OlaClientCore::FetchDMX(unsigned int universe,
                              DMXCallback *callback) {
   ola::proto::UniverseRequest request;
@@ -515,6 +565,29 @@ void OlaClientCore::FetchDMX(unsigned int universe,
   }
 }
 
+void OlaClientCore::FetchDMXBatch(const vector<unsigned int> &universes,
+                                  DMXBatchCallback *callback) {
+  ola::proto::UniverseBatchRequest request;
+  RpcController *controller = new RpcController();
+  ola::proto::DmxDataBatch *reply = new ola::proto::DmxDataBatch();
+
+  vector<unsigned int>::const_iterator iter = universes.begin();
+  for (; iter != universes.end(); ++iter) {
+    request.add_universe(*iter);
+  }
+
+  if (m_connected) {
+    CompletionCallback *cb = NewSingleCallback(
+        this,
+        &OlaClientCore::HandleGetDmxBatch,
+        controller, reply, callback);
+    m_stub->GetDmxBatch(controller, &request, reply, cb);
+  } else {
+    controller->SetFailed(NOT_CONNECTED_ERROR);
+    HandleGetDmxBatch(controller, reply, callback);
+  }
+}
+
 void OlaClientCore::RunDiscovery(unsigned int universe,
                                  DiscoveryType discovery_type,
                                  DiscoveryCallback *callback) {
@@ -829,6 +902,39 @@ void OlaClientCore::HandleUniverseList(RpcController *controller_ptr,
   callback->Run(result, ola_universes);
 }
 
+void OlaClientCore::HandleLatencyStats(RpcController *controller_ptr,
+                                       ola::proto::LatencyReply *reply_ptr,
+                                       LatencyStatsCallback *callback) {
+  auto_ptr<RpcController> controller(controller_ptr);
+  auto_ptr<ola::proto::LatencyReply> reply(reply_ptr);
+
+  if (!callback) {
+    return;
+  }
+
+  Result result(controller->Failed() ? controller->ErrorText() : "");
+  vector<UniverseLatency> universes;
+
+  if (!controller->Failed()) {
+    for (int i = 0; i < reply->universe_size(); ++i) {
+      const ola::proto::UniverseLatency &universe_latency = reply->universe(i);
+      UniverseLatency universe;
+      universe.universe = universe_latency.universe();
+      universe.latency = ClientTypesFactory::LatencyFromProtobuf(
+          universe_latency.latency());
+      for (int j = 0; j < universe_latency.output_ports_size(); ++j) {
+        const ola::proto::OutputPortLatency &port =
+            universe_latency.output_ports(j);
+        universe.output_ports.push_back(std::make_pair(
+            port.port_id(),
+            ClientTypesFactory::LatencyFromProtobuf(port.latency())));
+      }
+      universes.push_back(universe);
+    }
+  }
+  callback->Run(result, universes);
+}
+
 void OlaClientCore::HandleUniverseInfo(RpcController *controller_ptr,
                                        ola::proto::UniverseInfoReply *reply_ptr,
                                        UniverseInfoCallback *callback) {
@@ -886,6 +992,31 @@ void OlaClientCore::HandleGetDmx(RpcController *controller_ptr,
   callback->Run(result, metadata, buffer);
 }
 
+void OlaClientCore::HandleGetDmxBatch(RpcController *controller_ptr,
+                                      ola::proto::DmxDataBatch *reply_ptr,
+                                      DMXBatchCallback *callback) {
+  auto_ptr<RpcController> controller(controller_ptr);
+  auto_ptr<ola::proto::DmxDataBatch> reply(reply_ptr);
+
+  if (!callback) {
+    return;
+  }
+
+  Result result(controller->Failed() ? controller->ErrorText() : "");
+  vector<UniverseDMX> frames;
+
+  if (!controller->Failed()) {
+    frames.reserve(reply->data_size());
+    for (int i = 0; i < reply->data_size(); i++) {
+      const ola::proto::DmxData &dmx_data = reply->data(i);
+      frames.push_back(UniverseDMX(dmx_data.universe(),
+                                   DmxBuffer(dmx_data.data()),
+                                   dmx_data.priority()));
+    }
+  }
+  callback->Run(result, frames);
+}
+
 void OlaClientCore::HandleUIDList(RpcController *controller_ptr,
                                   ola::proto::UIDListReply *reply_ptr,
                                   DiscoveryCallback *callback) {
@@ -23,6 +23,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "common/protocol/Ola.pb.h"
 #include "common/protocol/OlaService.pb.h"
@@ -189,6 +190,12 @@ class OlaClientCore: public ola::proto::OlaClientService {
   void FetchUniverseInfo(unsigned int universe,
                          UniverseInfoCallback *callback);
 
+  /**
+   * @brief Fetch the DMX latency histograms for all universes.
+   * @param callback the LatencyStatsCallback to invoke upon completion.
+   */
+  void FetchLatencyStats(LatencyStatsCallback *callback);
+
   /**
    * @brief Set the name of a universe.
    * @param universe the id of the universe
@@ -246,6 +253,18 @@ class OlaClientCore: public ola::proto::OlaClientService {
                const DmxBuffer &data,
                const SendDMXArgs &args);
 
+  /**
+   * @brief Send DMX data for many universes in a single request.
+   *
+   * The universes are updated together; if any of them don't exist in olad,
+   * none of the data is applied.
+   * @param frames the UniverseDMX to send.
+   * @param callback the GeneralSetCallback to invoke upon completion. If
+   *   NULL, the data is streamed and no response is sent.
+   */
+  void SendDMXBatch(const std::vector<UniverseDMX> &frames,
+                    GeneralSetCallback *callback = NULL);
+
   /**
    * @brief Fetch the latest DMX data for a universe.
    * @param universe the universe id to get data for.
@@ -253,6 +272,14 @@ class OlaClientCore: public ola::proto::OlaClientService {
    */
   void FetchDMX(unsigned int universe, DMXCallback *callback);
 
+  /**
+   * @brief Fetch the latest DMX data for many universes.
+   * @param universes the universe ids to get data for.
+   * @param callback the DMXBatchCallback to invoke upon completion.
+   */
+  void FetchDMXBatch(const std::vector<unsigned int> &universes,
+                     DMXBatchCallback *callback);
+
   /**
    * @brief Trigger discovery for a universe.
    * @param universe the universe id to run discovery on.
@@ -394,6 +421,13 @@ class OlaClientCore: public ola::proto::OlaClientService {
                           ola::proto::UniverseInfoReply *reply,
                           UniverseInfoCallback *callback);
 
+  /**
+   * @brief Called when a GetLatencyStats() request completes.
+   */
+  void HandleLatencyStats(ola::rpc::RpcController *controller,
+                          ola::proto::LatencyReply *reply,
+                          LatencyStatsCallback *callback);
+
   /**
    * @brief Called when a GetDmx() request completes.
    */
@@ -401,6 +435,13 @@ class OlaClientCore: public ola::proto::OlaClientService {
                     ola::proto::DmxData *reply,
                     DMXCallback *callback);
 
+  /**
+   * @brief Called when a GetDmxBatch() request completes.
+   */
+  void HandleGetDmxBatch(ola::rpc::RpcController *controller,
+                         ola::proto::DmxDataBatch *reply,
+                         DMXBatchCallback *callback);
+
   /**
    * @brief Called when a RunDiscovery() request completes.
    */
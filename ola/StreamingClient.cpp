@@ -25,19 +25,24 @@
 #include <ola/DmxBuffer.h>
 #include <ola/Logging.h>
 #include <ola/client/StreamingClient.h>
+#include <ola/dmx/SharedMemoryUniverseTable.h>
 #include <ola/io/SelectServer.h>
 #include <ola/network/IPV4Address.h>
 #include <ola/network/SocketAddress.h>
 #include <ola/network/TCPSocket.h>
 
+#include <vector>
+
 #include "common/protocol/Ola.pb.h"
 #include "common/protocol/OlaService.pb.h"
 #include "common/rpc/RpcChannel.h"
 #include "common/rpc/RpcSession.h"
+#include "ola/stl/STLUtils.h"
 
 namespace ola {
 namespace client {
 
+using ola::dmx::SharedMemoryUniverseTable;
 using ola::io::SelectServer;
 using ola::network::TCPSocket;
 using ola::proto::OlaServerService_Stub;
@@ -46,21 +51,27 @@ using ola::rpc::RpcChannel;
 StreamingClient::StreamingClient(bool auto_start)
     : m_auto_start(auto_start),
       m_server_port(OLA_DEFAULT_PORT),
+      m_raw_dmx(false),
+      m_shared_memory(false),
       m_socket(NULL),
       m_ss(NULL),
       m_channel(NULL),
       m_stub(NULL),
-      m_socket_closed(false) {
+      m_socket_closed(false),
+      m_shm_table(NULL) {
 }
 
 StreamingClient::StreamingClient(const Options &options)
     : m_auto_start(options.auto_start),
       m_server_port(options.server_port),
+      m_raw_dmx(options.raw_dmx),
+      m_shared_memory(options.shared_memory),
       m_socket(NULL),
       m_ss(NULL),
       m_channel(NULL),
       m_stub(NULL),
-      m_socket_closed(false) {
+      m_socket_closed(false),
+      m_shm_table(NULL) {
 }
 
 StreamingClient::~StreamingClient() {
@@ -105,10 +116,29 @@ bool StreamingClient::Setup() {
   m_channel->SetChannelCloseHandler(
       NewSingleCallback(this, &StreamingClient::ChannelClosed));
 
+  if (m_shared_memory) {
+    m_shm_table = new SharedMemoryUniverseTable();
+    if (!m_shm_table->Attach(
+            SharedMemoryUniverseTable::NameForPort(m_server_port))) {
+      OLA_INFO << "Shared memory isn't available, using the RPC connection";
+      delete m_shm_table;
+      m_shm_table = NULL;
+    }
+  }
   return true;
 }
 
 void StreamingClient::Stop() {
+  if (m_shm_table) {
+    std::map<unsigned int, unsigned int>::const_iterator iter =
+        m_shm_slots.begin();
+    for (; iter != m_shm_slots.end(); ++iter) {
+      m_shm_table->ReleaseSlot(iter->second);
+    }
+    m_shm_table->Notify();
+    delete m_shm_table;
+  }
+
   if (m_stub)
     delete m_stub;
 
@@ -125,6 +155,8 @@ void StreamingClient::Stop() {
   m_socket = NULL;
   m_ss = NULL;
   m_stub = NULL;
+  m_shm_table = NULL;
+  m_shm_slots.clear();
 }
 
 bool StreamingClient::SendDmx(unsigned int universe,
@@ -138,8 +170,59 @@ bool StreamingClient::SendDMX(unsigned int universe,
   return Send(universe, args.priority, data);
 }
 
+bool StreamingClient::SendDMXBatch(const std::vector<UniverseDMX> &frames) {
+  if (!StartSend()) {
+    return false;
+  }
+
+  ola::proto::DmxDataBatch request;
+  std::vector<UniverseDMX>::const_iterator iter = frames.begin();
+  for (; iter != frames.end(); ++iter) {
+    if (m_shm_table &&
+        SendSharedMemory(iter->universe, iter->priority, iter->data)) {
+      continue;
+    } else if (m_raw_dmx) {
+      m_channel->StreamDmx(iter->universe, iter->priority,
+                           iter->data.GetRaw(), iter->data.Size());
+    } else {
+      ola::proto::DmxData *dmx_data = request.add_data();
+      dmx_data->set_universe(iter->universe);
+      dmx_data->set_data(iter->data.Get());
+      dmx_data->set_priority(iter->priority);
+    }
+  }
+
+  if (request.data_size()) {
+    m_stub->StreamDmxDataBatch(NULL, &request, NULL, NULL);
+  }
+  return FinishSend();
+}
+
 bool StreamingClient::Send(unsigned int universe, uint8_t priority,
                            const DmxBuffer &data) {
+  if (!StartSend()) {
+    return false;
+  }
+
+  if (m_shm_table && SendSharedMemory(universe, priority, data)) {
+    return true;
+  } else if (m_raw_dmx) {
+    m_channel->StreamDmx(universe, priority, data.GetRaw(), data.Size());
+  } else {
+    ola::proto::DmxData request;
+    request.set_universe(universe);
+    request.set_data(data.Get());
+    request.set_priority(priority);
+    m_stub->StreamDmxData(NULL, &request, NULL, NULL);
+  }
+  return FinishSend();
+}
+
+/*
+ * Check the connection is still open before sending.
+ * @returns false if the connection has been closed.
+ */
+bool StreamingClient::StartSend() {
   if (!m_stub || !m_socket->ValidReadDescriptor())
     return false;
 
@@ -153,13 +236,13 @@ bool StreamingClient::Send(unsigned int universe, uint8_t priority,
     Stop();
     return false;
   }
+  return true;
+}
 
-  ola::proto::DmxData request;
-  request.set_universe(universe);
-  request.set_data(data.Get());
-  request.set_priority(priority);
-  m_stub->StreamDmxData(NULL, &request, NULL, NULL);
-
+/*
+ * Check if the connection was closed while sending.
+ */
+bool StreamingClient::FinishSend() {
   if (m_socket_closed) {
     Stop();
     return false;
@@ -167,6 +250,28 @@ bool StreamingClient::Send(unsigned int universe, uint8_t priority,
   return true;
 }
 
+/*
+ * Write a frame to shared memory.
+ * @returns false if there are no free slots.
+ */
+bool StreamingClient::SendSharedMemory(unsigned int universe,
+                                       uint8_t priority,
+                                       const DmxBuffer &data) {
+  unsigned int *slot = STLFind(&m_shm_slots, universe);
+  if (!slot) {
+    unsigned int new_slot = m_shm_table->ClaimSlot(
+        SharedMemoryUniverseTable::INPUT_SLOT, universe);
+    if (new_slot == SharedMemoryUniverseTable::INVALID_SLOT) {
+      return false;
+    }
+    slot = &(m_shm_slots[universe] = new_slot);
+  }
+
+  m_shm_table->Write(*slot, priority, data);
+  m_shm_table->Notify();
+  return true;
+}
+
 void StreamingClient::ChannelClosed(OLA_UNUSED ola::rpc::RpcSession *session) {
   m_socket_closed = true;
   OLA_WARN << "The RPC socket has been closed, this is more than likely due"
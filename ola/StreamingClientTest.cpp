@@ -21,11 +21,13 @@
 #include <cppunit/extensions/HelperMacros.h>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "ola/DmxBuffer.h"
 #include "ola/Logging.h"
 #include "ola/StreamingClient.h"
 #include "ola/base/Flags.h"
+#include "ola/dmx/SharedMemoryUniverseTable.h"
 #include "ola/network/SocketAddress.h"
 #include "ola/testing/TestUtils.h"
 #include "ola/thread/Thread.h"
@@ -37,6 +39,8 @@ static unsigned int TEST_UNIVERSE = 1;
 
 using ola::OlaDaemon;
 using ola::StreamingClient;
+using ola::client::UniverseDMX;
+using ola::dmx::SharedMemoryUniverseTable;
 using ola::network::GenericSocketAddress;
 using ola::thread::ConditionVariable;
 using ola::thread::Mutex;
@@ -45,12 +49,18 @@ using std::auto_ptr;
 class StreamingClientTest: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(StreamingClientTest);
   CPPUNIT_TEST(testSendDMX);
+  CPPUNIT_TEST(testSendRawDMX);
+  CPPUNIT_TEST(testSendDMXBatch);
+  CPPUNIT_TEST(testSendSharedMemoryDMX);
   CPPUNIT_TEST_SUITE_END();
 
  public:
     void setUp();
     void tearDown();
     void testSendDMX();
+    void testSendRawDMX();
+    void testSendDMXBatch();
+    void testSendSharedMemoryDMX();
 
  private:
     class OlaServerThread *m_server_thread;
@@ -94,6 +104,11 @@ bool OlaServerThread::Setup() {
   ola_options.http_enable_quit = false;
   ola_options.http_port = 0;
   ola_options.http_data_dir = "";
+  ola_options.rdm_discovery_concurrency = 0;
+  ola_options.rdm_discovery_max_backoff = 0;
+  ola_options.shared_memory_dmx = true;
+  ola_options.client_max_rate = 0;
+  ola_options.busy_poll_usec = 0;
 
   // pick an unused port
   auto_ptr<OlaDaemon> olad(new OlaDaemon(ola_options, NULL));
@@ -221,3 +236,105 @@ void StreamingClientTest::testSendDMX() {
 
   OLA_ASSERT_FALSE(ola_client.Setup());
 }
+
+
+/*
+ * Check that sending raw DMX frames works.
+ */
+void StreamingClientTest::testSendRawDMX() {
+  m_server_thread->WaitForStart();
+  GenericSocketAddress server_address = m_server_thread->RPCAddress();
+  StreamingClient::Options options;
+  options.auto_start = false;
+  options.server_port = server_address.V4Addr().Port();
+  options.raw_dmx = true;
+  StreamingClient ola_client(options);
+
+  ola::DmxBuffer buffer;
+  buffer.SetFromString("1,2,3,4");
+
+  OLA_ASSERT_TRUE(ola_client.Setup());
+  // If the server didn't understand the frames it would close the connection
+  // and the later sends would fail.
+  for (unsigned int i = 0; i < 10; i++) {
+    OLA_ASSERT_TRUE(ola_client.SendDmx(TEST_UNIVERSE, buffer));
+    buffer.SetChannel(0, static_cast<uint8_t>(i));
+  }
+  StreamingClient::SendArgs args;
+  args.priority = 150;
+  OLA_ASSERT_TRUE(ola_client.SendDMX(TEST_UNIVERSE, buffer, args));
+  ola_client.Stop();
+}
+
+
+/*
+ * Check that sending a batch of DMX frames works.
+ */
+void StreamingClientTest::testSendDMXBatch() {
+  m_server_thread->WaitForStart();
+  GenericSocketAddress server_address = m_server_thread->RPCAddress();
+  StreamingClient::Options options;
+  options.auto_start = false;
+  options.server_port = server_address.V4Addr().Port();
+  StreamingClient ola_client(options);
+
+  ola::DmxBuffer buffer;
+  buffer.SetFromString("1,2,3,4");
+  std::vector<UniverseDMX> frames;
+  frames.push_back(UniverseDMX(TEST_UNIVERSE, buffer));
+  frames.push_back(UniverseDMX(TEST_UNIVERSE + 1, buffer, 150));
+
+  // Not connected yet
+  OLA_ASSERT_FALSE(ola_client.SendDMXBatch(frames));
+
+  OLA_ASSERT_TRUE(ola_client.Setup());
+  for (unsigned int i = 0; i < 10; i++) {
+    OLA_ASSERT_TRUE(ola_client.SendDMXBatch(frames));
+    frames[0].data.SetChannel(0, static_cast<uint8_t>(i));
+  }
+  // An empty batch is fine as well.
+  OLA_ASSERT_TRUE(ola_client.SendDMXBatch(std::vector<UniverseDMX>()));
+  ola_client.Stop();
+}
+
+
+/*
+ * Check that the client can send DMX through shared memory.
+ */
+void StreamingClientTest::testSendSharedMemoryDMX() {
+  m_server_thread->WaitForStart();
+  GenericSocketAddress server_address = m_server_thread->RPCAddress();
+  StreamingClient::Options options;
+  options.auto_start = false;
+  options.server_port = server_address.V4Addr().Port();
+  options.shared_memory = true;
+  StreamingClient ola_client(options);
+
+  ola::DmxBuffer buffer;
+  buffer.SetFromString("1,2,3,4");
+
+  OLA_ASSERT_TRUE(ola_client.Setup());
+  StreamingClient::SendArgs args;
+  args.priority = 150;
+  OLA_ASSERT_TRUE(ola_client.SendDMX(TEST_UNIVERSE, buffer, args));
+
+  // The frame should be in the table olad created.
+  SharedMemoryUniverseTable table;
+  OLA_ASSERT_TRUE(table.Attach(SharedMemoryUniverseTable::NameForPort(
+      options.server_port)));
+  SharedMemoryUniverseTable::SlotInfo info;
+  OLA_ASSERT_TRUE(table.GetSlotInfo(0, &info));
+  OLA_ASSERT_EQ(SharedMemoryUniverseTable::INPUT_SLOT, info.direction);
+  OLA_ASSERT_EQ(TEST_UNIVERSE, info.universe);
+
+  uint32_t sequence = 0;
+  uint8_t priority = 0;
+  ola::DmxBuffer received;
+  OLA_ASSERT_TRUE(table.Read(0, &sequence, &priority, &received));
+  OLA_ASSERT_EQ(buffer, received);
+  OLA_ASSERT_EQ(static_cast<uint8_t>(150), priority);
+
+  // Stopping the client releases the slot.
+  ola_client.Stop();
+  OLA_ASSERT_FALSE(table.GetSlotInfo(0, &info));
+}
@@ -22,7 +22,9 @@ ola_server_sources = \
     olad/PluginLoader.h \
     olad/PluginManager.cpp \
     olad/PluginManager.h \
-    olad/RDMHTTPModule.h
+    olad/RDMHTTPModule.h \
+    olad/SharedMemoryTransport.cpp \
+    olad/SharedMemoryTransport.h
 ola_server_additional_libs =
 
 if HAVE_DNSSD
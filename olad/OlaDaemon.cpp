@@ -33,6 +33,7 @@
 #endif  // _WIN32
 #include <string>
 
+#include "ola/Clock.h"
 #include "ola/ExportMap.h"
 #include "ola/Logging.h"
 #include "ola/base/Credentials.h"
@@ -68,11 +69,24 @@ const char OlaDaemon::GID_KEY[] = "gid";
 const char OlaDaemon::USER_NAME_KEY[] = "user";
 const char OlaDaemon::GROUP_NAME_KEY[] = "group";
 
+namespace {
+
+SelectServer::Options SelectServerOptions(const OlaServer::Options &options,
+                                          ExportMap *export_map) {
+  SelectServer::Options ss_options;
+  ss_options.export_map = export_map;
+  ss_options.busy_poll_interval = TimeInterval(
+      static_cast<int64_t>(options.busy_poll_usec));
+  return ss_options;
+}
+
+}  // namespace
+
 OlaDaemon::OlaDaemon(const OlaServer::Options &options,
                      ExportMap *export_map)
     : m_options(options),
       m_export_map(export_map),
-      m_ss(m_export_map) {
+      m_ss(SelectServerOptions(options, export_map)) {
   if (m_export_map) {
     uid_t uid;
     if (GetUID(&uid)) {
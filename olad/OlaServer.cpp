@@ -34,10 +34,12 @@
 #include "common/rpc/RpcChannel.h"
 #include "common/rpc/RpcServer.h"
 #include "common/rpc/RpcSession.h"
+#include "ola/Clock.h"
 #include "ola/Constants.h"
 #include "ola/ExportMap.h"
 #include "ola/Logging.h"
 #include "ola/base/Flags.h"
+#include "ola/dmx/SharedMemoryUniverseTable.h"
 #include "ola/network/InterfacePicker.h"
 #include "ola/network/Socket.h"
 #include "ola/rdm/PidStore.h"
@@ -53,6 +55,7 @@
 #include "olad/Port.h"
 #include "olad/PortBroker.h"
 #include "olad/Preferences.h"
+#include "olad/SharedMemoryTransport.h"
 #include "olad/Universe.h"
 #include "olad/plugin_api/Client.h"
 #include "olad/plugin_api/DeviceManager.h"
@@ -123,6 +126,7 @@ OlaServer::~OlaServer() {
   // Order is important during shutdown.
   // Shutdown the RPC server first since it depends on almost everything else.
   m_rpc_server.reset();
+  m_shm_transport.reset();
 
   if (m_housekeeping_timeout != ola::thread::INVALID_TIMEOUT) {
     m_ss->RemoveTimeout(m_housekeeping_timeout);
@@ -210,7 +214,10 @@ bool OlaServer::Init() {
   universe_preferences->Load();
 
   auto_ptr<UniverseStore> universe_store(
-      new UniverseStore(universe_preferences, m_export_map));
+      new UniverseStore(
+          universe_preferences, m_export_map,
+          m_options.rdm_discovery_concurrency,
+          TimeInterval(m_options.rdm_discovery_max_backoff, 0)));
 
   auto_ptr<PortBroker> port_broker(new PortBroker());
 
@@ -253,6 +260,21 @@ bool OlaServer::Init() {
     return false;
   }
 
+  auto_ptr<SharedMemoryTransport> shm_transport;
+  if (m_options.shared_memory_dmx) {
+    shm_transport.reset(new SharedMemoryTransport(
+        universe_store.get(), m_ss->WakeUpTime(), m_default_uid));
+    ola::network::IPV4SocketAddress rpc_address =
+        rpc_server->ListenAddress().V4Addr();
+    if (!shm_transport->Init(
+            ola::dmx::SharedMemoryUniverseTable::NameForPort(
+                rpc_address.Port()),
+            m_ss)) {
+      OLA_WARN << "Failed to create the shared memory DMX transport";
+      shm_transport.reset();
+    }
+  }
+
   // Discovery
   auto_ptr<DiscoveryAgentInterface> discovery_agent;
   if (FLAGS_register_with_dns_sd) {
@@ -304,6 +326,7 @@ bool OlaServer::Init() {
   m_port_manager.reset(port_manager.release());
   m_rpc_server.reset(rpc_server.release());
   m_service_impl.reset(service_impl.release());
+  m_shm_transport.reset(shm_transport.release());
   m_universe_store.reset(universe_store.release());
 
   UpdatePidStore(pid_store.release());
@@ -356,7 +379,9 @@ ola::network::GenericSocketAddress OlaServer::LocalRPCAddress() const {
 
 void OlaServer::NewClient(RpcSession *session) {
   OlaClientService_Stub *stub = new OlaClientService_Stub(session->Channel());
-  Client *client = new Client(stub, m_default_uid);
+  Client::Options client_options;
+  client_options.max_rate = m_options.client_max_rate;
+  Client *client = new Client(stub, m_default_uid, client_options, m_ss);
   session->SetData(static_cast<void*>(client));
   m_broker->AddClient(client);
 }
@@ -383,6 +408,11 @@ void OlaServer::ClientRemoved(RpcSession *session) {
  */
 bool OlaServer::RunHousekeeping() {
   OLA_DEBUG << "Garbage collecting";
+  if (m_shm_transport.get()) {
+    // This also catches any notifications we missed.
+    m_shm_transport->ReclaimDeadSlots();
+    m_shm_transport->CheckSlots();
+  }
   m_universe_store->GarbageCollectUniverses();
 
   // Give the universes an opportunity to run discovery
@@ -397,7 +427,7 @@ bool OlaServer::RunHousekeeping() {
         (*iter)->RDMDiscoveryInterval().Seconds() &&
         *now - (*iter)->LastRDMDiscovery() > (*iter)->RDMDiscoveryInterval()) {
       // run incremental discovery
-      (*iter)->RunRDMDiscovery(NULL, false);
+      (*iter)->RunPeriodicRDMDiscovery();
     }
   }
   return true;
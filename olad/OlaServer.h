@@ -72,6 +72,30 @@ class OlaServer : public ola::rpc::RpcSessionHandlerInterface {
     std::string http_data_dir;
     std::string network_interface;
     std::string pid_data_dir;  /** @brief Directory with the PID definitions */
+    /**
+     * @brief The number of ports that can run RDM discovery at once, 0 means
+     * no limit.
+     */
+    unsigned int rdm_discovery_concurrency;
+    /**
+     * @brief The longest, in seconds, that periodic RDM discovery on a port
+     * can be backed off for when nothing changes, 0 disables backoff.
+     */
+    unsigned int rdm_discovery_max_backoff;
+    /**
+     * @brief Exchange DMX data with local clients through shared memory.
+     */
+    bool shared_memory_dmx;
+    /**
+     * @brief The most DMX updates per second to push to each client, for each
+     * universe, 0 means no limit.
+     */
+    unsigned int client_max_rate;
+    /**
+     * @brief Poll for up to this many microseconds before sleeping in the
+     * main loop, 0 disables busy polling.
+     */
+    unsigned int busy_poll_usec;
   };
 
   /**
@@ -193,6 +217,7 @@ class OlaServer : public ola::rpc::RpcSessionHandlerInterface {
   std::auto_ptr<const ola::rdm::RootPidStore> m_pid_store;
   std::auto_ptr<class DiscoveryAgentInterface> m_discovery_agent;
   std::auto_ptr<ola::rpc::RpcServer> m_rpc_server;
+  std::auto_ptr<class SharedMemoryTransport> m_shm_transport;
   class Preferences *m_server_preferences;
   class Preferences *m_universe_preferences;
   std::string m_instance_name;
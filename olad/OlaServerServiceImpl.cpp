@@ -20,6 +20,7 @@
  */
 
 #include <algorithm>
+#include <set>
 #include <string>
 #include <vector>
 #include "common/protocol/Ola.pb.h"
@@ -27,6 +28,7 @@
 #include "ola/Callback.h"
 #include "ola/CallbackRunner.h"
 #include "ola/DmxBuffer.h"
+#include "ola/ExportMap.h"
 #include "ola/Logging.h"
 #include "ola/rdm/RDMCommand.h"
 #include "ola/rdm/UIDSet.h"
@@ -56,6 +58,9 @@ using ola::proto::DeviceInfo;
 using ola::proto::DeviceInfoReply;
 using ola::proto::DeviceInfoRequest;
 using ola::proto::DmxData;
+using ola::proto::DmxDataBatch;
+using ola::proto::LatencyReply;
+using ola::proto::LatencyStats;
 using ola::proto::MergeModeRequest;
 using ola::proto::OptionalUniverseRequest;
 using ola::proto::PatchPortRequest;
@@ -69,12 +74,14 @@ using ola::proto::RegisterDmxRequest;
 using ola::proto::UniverseInfo;
 using ola::proto::UniverseInfoReply;
 using ola::proto::UniverseNameRequest;
+using ola::proto::UniverseBatchRequest;
 using ola::proto::UniverseRequest;
 using ola::rdm::RDMRequest;
 using ola::rdm::RDMResponse;
 using ola::rdm::UID;
 using ola::rdm::UIDSet;
 using ola::rpc::RpcController;
+using std::set;
 using std::string;
 using std::vector;
 
@@ -106,6 +113,15 @@ RDMRequest::OverrideOptions RDMRequestOptionsFromProto(
   }
   return options;
 }
+
+void PopulateLatency(const LatencyHistogram &histogram, LatencyStats *stats) {
+  stats->set_count(histogram.Count());
+  stats->set_p50(histogram.Percentile(50));
+  stats->set_p90(histogram.Percentile(90));
+  stats->set_p99(histogram.Percentile(99));
+  stats->set_p999(histogram.Percentile(99.9));
+  stats->set_max(histogram.Max());
+}
 }  // namespace
 
 typedef CallbackRunner<ola::rpc::RpcService::CompletionCallback> ClosureRunner;
@@ -143,6 +159,31 @@ void OlaServerServiceImpl::GetDmx(
   response->set_universe(request->universe());
 }
 
+void OlaServerServiceImpl::GetDmxBatch(
+    RpcController* controller,
+    const UniverseBatchRequest* request,
+    DmxDataBatch* response,
+    ola::rpc::RpcService::CompletionCallback* done) {
+  ClosureRunner runner(done);
+  vector<Universe*> universes;
+  universes.reserve(request->universe_size());
+  for (int i = 0; i < request->universe_size(); i++) {
+    Universe *universe = m_universe_store->GetUniverse(request->universe(i));
+    if (!universe) {
+      return MissingUniverseError(controller);
+    }
+    universes.push_back(universe);
+  }
+
+  vector<Universe*>::const_iterator iter = universes.begin();
+  for (; iter != universes.end(); ++iter) {
+    DmxData *dmx_data = response->add_data();
+    dmx_data->set_universe((*iter)->UniverseId());
+    dmx_data->set_data((*iter)->GetDMX().Get());
+    dmx_data->set_priority((*iter)->ActivePriority());
+  }
+}
+
 void OlaServerServiceImpl::RegisterForDmx(
     RpcController* controller,
     const RegisterDmxRequest* request,
@@ -191,32 +232,46 @@ void OlaServerServiceImpl::UpdateDmxData(
   universe->SourceClientDataChanged(client);
 }
 
+void OlaServerServiceImpl::UpdateDmxDataBatch(
+    RpcController* controller,
+    const DmxDataBatch* request,
+    Ack*,
+    ola::rpc::RpcService::CompletionCallback* done) {
+  ClosureRunner runner(done);
+  if (!ApplyDmxBatch(controller, *request, false)) {
+    return MissingUniverseError(controller);
+  }
+}
+
 void OlaServerServiceImpl::StreamDmxData(
     RpcController *controller,
     const ola::proto::DmxData* request,
     ola::proto::STREAMING_NO_RESPONSE*,
     ola::rpc::RpcService::CompletionCallback*) {
-  Universe *universe = m_universe_store->GetUniverse(request->universe());
-
-  if (!universe) {
-    return;
-  }
-
-  Client *client = GetClient(controller);
-  DmxBuffer buffer;
-  buffer.Set(request->data());
-
   uint8_t priority = ola::dmx::SOURCE_PRIORITY_DEFAULT;
   if (request->has_priority()) {
     priority = request->priority();
-    priority = std::max(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MIN),
-                        priority);
-    priority = std::min(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MAX),
-                        priority);
   }
-  DmxSource source(buffer, *m_wake_up_time, priority);
-  client->DMXReceived(request->universe(), source);
-  universe->SourceClientDataChanged(client);
+  DmxBuffer buffer;
+  buffer.Set(request->data());
+  StreamDmx(controller, request->universe(), priority, buffer);
+}
+
+void OlaServerServiceImpl::StreamDmxDataBatch(
+    RpcController *controller,
+    const DmxDataBatch* request,
+    ola::proto::STREAMING_NO_RESPONSE*,
+    ola::rpc::RpcService::CompletionCallback*) {
+  // There's no response to report an error in, so apply what we can.
+  ApplyDmxBatch(controller, *request, true);
+}
+
+void OlaServerServiceImpl::HandleDmxFrame(RpcController *controller,
+                                          unsigned int universe,
+                                          uint8_t priority,
+                                          const uint8_t *data,
+                                          unsigned int length) {
+  StreamDmx(controller, universe, priority, DmxBuffer(data, length));
 }
 
 void OlaServerServiceImpl::SetUniverseName(
@@ -363,6 +418,9 @@ void OlaServerServiceImpl::AddUniverse(
   universe_info->set_input_port_count(universe->InputPortCount());
   universe_info->set_output_port_count(universe->OutputPortCount());
   universe_info->set_rdm_devices(universe->UIDCount());
+  universe_info->set_rdm_discovery_queued(universe->RDMDiscoveryQueuedCount());
+  universe_info->set_rdm_discovery_running(
+      universe->RDMDiscoveryRunningCount());
 
   std::vector<InputPort*> input_ports;
   std::vector<InputPort*>::const_iterator input_it;
@@ -385,6 +443,35 @@ void OlaServerServiceImpl::AddUniverse(
   }
 }
 
+void OlaServerServiceImpl::AddUniverseLatency(
+    const Universe *universe,
+    ola::proto::LatencyReply *reply) const {
+  if (!universe->Latency()) {
+    // latency isn't tracked without an ExportMap
+    return;
+  }
+
+  ola::proto::UniverseLatency *universe_latency = reply->add_universe();
+  universe_latency->set_universe(universe->UniverseId());
+  PopulateLatency(*universe->Latency(), universe_latency->mutable_latency());
+
+  std::vector<OutputPort*> output_ports;
+  std::vector<OutputPort*>::const_iterator output_it;
+  universe->OutputPorts(&output_ports);
+  for (output_it = output_ports.begin();
+       output_it != output_ports.end();
+       output_it++) {
+    const LatencyHistogram *histogram = universe->OutputPortLatency(
+        *output_it);
+    if (histogram) {
+      ola::proto::OutputPortLatency *port_latency =
+          universe_latency->add_output_ports();
+      port_latency->set_port_id((*output_it)->UniqueId());
+      PopulateLatency(*histogram, port_latency->mutable_latency());
+    }
+  }
+}
+
 void OlaServerServiceImpl::GetUniverseInfo(
     RpcController* controller,
     const OptionalUniverseRequest* request,
@@ -412,6 +499,31 @@ void OlaServerServiceImpl::GetUniverseInfo(
   }
 }
 
+void OlaServerServiceImpl::GetLatencyStats(
+    RpcController* controller,
+    const OptionalUniverseRequest* request,
+    LatencyReply* response,
+    ola::rpc::RpcService::CompletionCallback* done) {
+  ClosureRunner runner(done);
+
+  if (request->has_universe()) {
+    Universe *universe = m_universe_store->GetUniverse(request->universe());
+    if (!universe) {
+      return MissingUniverseError(controller);
+    }
+
+    AddUniverseLatency(universe, response);
+  } else {
+    vector<Universe*> uni_list;
+    m_universe_store->GetList(&uni_list);
+    vector<Universe*>::const_iterator iter;
+
+    for (iter = uni_list.begin(); iter != uni_list.end(); ++iter) {
+      AddUniverseLatency(*iter, response);
+    }
+  }
+}
+
 void OlaServerServiceImpl::GetPlugins(
     RpcController*,
     const PluginListRequest*,
@@ -1035,6 +1147,88 @@ void OlaServerServiceImpl::SetProtoUID(const ola::rdm::UID &uid,
   pb_uid->set_device_id(uid.DeviceId());
 }
 
+/*
+ * Pass a streaming DMX update to a universe.
+ */
+void OlaServerServiceImpl::StreamDmx(RpcController *controller,
+                                     unsigned int universe_id,
+                                     uint8_t priority,
+                                     const DmxBuffer &buffer) {
+  Universe *universe = m_universe_store->GetUniverse(universe_id);
+
+  if (!universe) {
+    return;
+  }
+
+  Client *client = GetClient(controller);
+  priority = std::max(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MIN),
+                      priority);
+  priority = std::min(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MAX),
+                      priority);
+  DmxSource source(buffer, *m_wake_up_time, priority);
+  client->DMXReceived(universe_id, source);
+  universe->SourceClientDataChanged(client);
+}
+
+/*
+ * Pass a batch of DMX updates to the universes.
+ * @param skip_missing if true, updates for universes that don't exist are
+ *   skipped and the rest are applied.
+ * @returns false if any of the universes don't exist and skip_missing is
+ *   false, in which case none of the updates are applied.
+ */
+bool OlaServerServiceImpl::ApplyDmxBatch(RpcController *controller,
+                                         const DmxDataBatch &batch,
+                                         bool skip_missing) {
+  vector<Universe*> universes;
+  vector<const DmxData*> updates;
+  universes.reserve(batch.data_size());
+  updates.reserve(batch.data_size());
+  for (int i = 0; i < batch.data_size(); i++) {
+    Universe *universe = m_universe_store->GetUniverse(
+        batch.data(i).universe());
+    if (!universe) {
+      if (!skip_missing) {
+        return false;
+      }
+      OLA_WARN << "Universe " << batch.data(i).universe()
+               << " doesn't exist, skipping it";
+      continue;
+    }
+    universes.push_back(universe);
+    updates.push_back(&batch.data(i));
+  }
+
+  Client *client = GetClient(controller);
+  vector<const DmxData*>::const_iterator update_iter = updates.begin();
+  for (; update_iter != updates.end(); ++update_iter) {
+    const DmxData &dmx_data = **update_iter;
+    uint8_t priority = ola::dmx::SOURCE_PRIORITY_DEFAULT;
+    if (dmx_data.has_priority()) {
+      priority = dmx_data.priority();
+      priority = std::max(
+          static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MIN), priority);
+      priority = std::min(
+          static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MAX), priority);
+    }
+    DmxBuffer buffer;
+    buffer.Set(dmx_data.data());
+    client->DMXReceived(dmx_data.universe(),
+                        DmxSource(buffer, *m_wake_up_time, priority));
+  }
+
+  // Only merge once all of the client's data has been updated, and only once
+  // per universe, even if it appears more than once in the batch.
+  set<Universe*> merged;
+  vector<Universe*>::iterator iter = universes.begin();
+  for (; iter != universes.end(); ++iter) {
+    if (merged.insert(*iter).second) {
+      (*iter)->SourceClientDataChanged(client);
+    }
+  }
+  return true;
+}
+
 Client* OlaServerServiceImpl::GetClient(ola::rpc::RpcController *controller) {
   return reinterpret_cast<Client*>(controller->Session()->GetData());
 }
@@ -18,12 +18,14 @@
  * Copyright (C) 2005 Simon Newton
  */
 
+#include <stdint.h>
 #include <memory>
 #include <string>
 #include <vector>
 #include "common/protocol/Ola.pb.h"
 #include "common/protocol/OlaService.pb.h"
 #include "ola/Callback.h"
+#include "ola/DmxBuffer.h"
 #include "ola/rdm/RDMCommand.h"
 #include "ola/rdm/RDMControllerInterface.h"
 #include "ola/rdm/UID.h"
@@ -75,6 +77,14 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
               ola::proto::DmxData* response,
               ola::rpc::RpcService::CompletionCallback* done);
 
+  /**
+   * @brief Returns the current DMX values for many universes.
+   */
+  void GetDmxBatch(ola::rpc::RpcController* controller,
+                   const ola::proto::UniverseBatchRequest* request,
+                   ola::proto::DmxDataBatch* response,
+                   ola::rpc::RpcService::CompletionCallback* done);
+
 
   /**
    * @brief Register a client to receive DMX data.
@@ -99,6 +109,34 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
                      ::ola::proto::STREAMING_NO_RESPONSE* response,
                      ola::rpc::RpcService::CompletionCallback* done);
 
+  /**
+   * @brief Update the DMX values for many universes.
+   *
+   * If any of the universes don't exist, none of the data is applied.
+   */
+  void UpdateDmxDataBatch(ola::rpc::RpcController* controller,
+                          const ola::proto::DmxDataBatch* request,
+                          ola::proto::Ack* response,
+                          ola::rpc::RpcService::CompletionCallback* done);
+
+  /**
+   * @brief Handle a streaming DMX update for many universes, no response is
+   * sent.
+   */
+  void StreamDmxDataBatch(ola::rpc::RpcController* controller,
+                          const ::ola::proto::DmxDataBatch* request,
+                          ::ola::proto::STREAMING_NO_RESPONSE* response,
+                          ola::rpc::RpcService::CompletionCallback* done);
+
+  /**
+   * @brief Handle a streaming DMX update sent as a raw frame.
+   */
+  void HandleDmxFrame(ola::rpc::RpcController* controller,
+                      unsigned int universe,
+                      uint8_t priority,
+                      const uint8_t *data,
+                      unsigned int length);
+
 
   /**
    * @brief Sets the name of a universe.
@@ -140,6 +178,14 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
                        ola::proto::UniverseInfoReply* response,
                        ola::rpc::RpcService::CompletionCallback* done);
 
+  /**
+   * @brief Returns the DMX latency histograms for the active universes.
+   */
+  void GetLatencyStats(ola::rpc::RpcController* controller,
+                       const ola::proto::OptionalUniverseRequest* request,
+                       ola::proto::LatencyReply* response,
+                       ola::rpc::RpcService::CompletionCallback* done);
+
   /**
    * @brief Return info on available plugins.
    */
@@ -281,6 +327,8 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
                  ola::proto::DeviceInfoReply* response) const;
   void AddUniverse(const Universe *universe,
                    ola::proto::UniverseInfoReply *universe_info_reply) const;
+  void AddUniverseLatency(const Universe *universe,
+                          ola::proto::LatencyReply *reply) const;
 
   template <class PortClass>
   void PopulatePort(const PortClass &port,
@@ -290,6 +338,15 @@ class OlaServerServiceImpl : public ola::proto::OlaServerService {
 
   class Client* GetClient(ola::rpc::RpcController *controller);
 
+  void StreamDmx(ola::rpc::RpcController *controller,
+                 unsigned int universe_id,
+                 uint8_t priority,
+                 const ola::DmxBuffer &buffer);
+
+  bool ApplyDmxBatch(ola::rpc::RpcController *controller,
+                     const ola::proto::DmxDataBatch &batch,
+                     bool skip_missing);
+
   UniverseStore *m_universe_store;
   DeviceManager *m_device_manager;
   class PluginManager *m_plugin_manager;
@@ -33,6 +33,7 @@
 #include "ola/DmxBuffer.h"
 #include "ola/ExportMap.h"
 #include "ola/Logging.h"
+#include "ola/dmx/SourcePriorities.h"
 #include "ola/rdm/UID.h"
 #include "ola/testing/TestUtils.h"
 #include "olad/OlaServerServiceImpl.h"
@@ -56,10 +57,14 @@ using std::string;
 class OlaServerServiceImplTest: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(OlaServerServiceImplTest);
   CPPUNIT_TEST(testGetDmx);
+  CPPUNIT_TEST(testGetDmxBatch);
   CPPUNIT_TEST(testRegisterForDmx);
   CPPUNIT_TEST(testUpdateDmxData);
+  CPPUNIT_TEST(testUpdateDmxDataBatch);
+  CPPUNIT_TEST(testStreamDmxDataBatch);
   CPPUNIT_TEST(testSetUniverseName);
   CPPUNIT_TEST(testSetMergeMode);
+  CPPUNIT_TEST(testGetLatencyStats);
   CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -72,10 +77,14 @@ class OlaServerServiceImplTest: public CppUnit::TestFixture {
     }
 
     void testGetDmx();
+    void testGetDmxBatch();
     void testRegisterForDmx();
     void testUpdateDmxData();
+    void testUpdateDmxDataBatch();
+    void testStreamDmxDataBatch();
     void testSetUniverseName();
     void testSetMergeMode();
+    void testGetLatencyStats();
 
  private:
     ola::rdm::UID m_uid;
@@ -84,6 +93,9 @@ class OlaServerServiceImplTest: public CppUnit::TestFixture {
     void CallGetDmx(OlaServerServiceImpl *service,
                     int universe_id,
                     class GetDmxCheck *check);
+    void CallGetDmxBatch(OlaServerServiceImpl *service,
+                         const ola::proto::UniverseBatchRequest &request,
+                         class GetDmxBatchCheck *check);
     void CallRegisterForDmx(OlaServerServiceImpl *service,
                             int universe_id,
                             ola::proto::RegisterAction action,
@@ -93,6 +105,10 @@ class OlaServerServiceImplTest: public CppUnit::TestFixture {
                            int universe_id,
                            const DmxBuffer &data,
                            class UpdateDmxDataCheck *check);
+    void CallUpdateDmxDataBatch(OlaServerServiceImpl *service,
+                                Client *client,
+                                const ola::proto::DmxDataBatch &request,
+                                class UpdateDmxDataCheck *check);
     void CallSetUniverseName(OlaServerServiceImpl *service,
                              int universe_id,
                              const string &name,
@@ -147,6 +163,36 @@ class GetDmxValidDataCheck: public GetDmxCheck {
 };
 
 
+/*
+ * The GetDmxBatch Checks
+ */
+class GetDmxBatchCheck {
+ public:
+  virtual ~GetDmxBatchCheck() {}
+  virtual void Check(RpcController *controller,
+                     ola::proto::DmxDataBatch *reply) = 0;
+};
+
+
+/*
+ * Assert that the first universe has the test data, and the second is empty.
+ */
+class GetDmxBatchValidDataCheck: public GetDmxBatchCheck {
+ public:
+  void Check(RpcController *controller,
+             ola::proto::DmxDataBatch *reply) {
+    OLA_ASSERT_FALSE(controller->Failed());
+    OLA_ASSERT_EQ(2, reply->data_size());
+    OLA_ASSERT_EQ(1, reply->data(0).universe());
+    OLA_ASSERT_EQ(
+        DmxBuffer(SAMPLE_DMX_DATA, sizeof(SAMPLE_DMX_DATA)),
+        DmxBuffer(reply->data(0).data()));
+    OLA_ASSERT_EQ(2, reply->data(1).universe());
+    OLA_ASSERT_EQ(DmxBuffer(), DmxBuffer(reply->data(1).data()));
+  }
+};
+
+
 /*
  * RegisterForDmxChecks
  */
@@ -269,6 +315,57 @@ void OlaServerServiceImplTest::CallGetDmx(OlaServerServiceImpl *service,
 }
 
 
+/*
+ * Check that the GetDmxBatch method works
+ */
+void OlaServerServiceImplTest::testGetDmxBatch() {
+  UniverseStore store(NULL, NULL);
+  OlaServerServiceImpl service(&store, NULL, NULL, NULL, NULL, NULL, NULL);
+
+  GenericMissingUniverseCheck<GetDmxBatchCheck, ola::proto::DmxDataBatch>
+    missing_universe_check;
+  GetDmxBatchValidDataCheck valid_data_check;
+
+  ola::proto::UniverseBatchRequest request;
+  request.add_universe(1);
+  request.add_universe(2);
+
+  // Neither universe exists
+  CallGetDmxBatch(&service, request, &missing_universe_check);
+
+  // If one of the universes is missing, the whole request fails
+  Universe *universe = store.GetUniverseOrCreate(1);
+  OLA_ASSERT_NOT_NULL(universe);
+  universe->SetDMX(DmxBuffer(SAMPLE_DMX_DATA, sizeof(SAMPLE_DMX_DATA)));
+  CallGetDmxBatch(&service, request, &missing_universe_check);
+
+  OLA_ASSERT_NOT_NULL(store.GetUniverseOrCreate(2));
+  CallGetDmxBatch(&service, request, &valid_data_check);
+}
+
+/*
+ * Call the GetDmxBatch method
+ * @param impl the OlaServerServiceImpl to use
+ * @param request the UniverseBatchRequest to send
+ * @param check the GetDmxBatchCheck class to use for the callback check
+ */
+void OlaServerServiceImplTest::CallGetDmxBatch(
+    OlaServerServiceImpl *service,
+    const ola::proto::UniverseBatchRequest &request,
+    GetDmxBatchCheck *check) {
+  RpcSession session(NULL);
+  RpcController controller(&session);
+  ola::proto::DmxDataBatch response;
+
+  SingleUseCallback0<void> *closure = NewSingleCallback(
+      check,
+      &GetDmxBatchCheck::Check,
+      &controller,
+      &response);
+
+  service->GetDmxBatch(&controller, &request, &response, closure);
+}
+
 /*
  * Check the RegisterForDmx method works
  */
@@ -422,6 +519,126 @@ void OlaServerServiceImplTest::CallUpdateDmxData(
   service->UpdateDmxData(&controller, &request, &response, closure);
 }
 
+/*
+ * Check the UpdateDmxDataBatch method works
+ */
+void OlaServerServiceImplTest::testUpdateDmxDataBatch() {
+  UniverseStore store(NULL, NULL);
+  ola::TimeStamp time1;
+  ola::Client client1(NULL, m_uid);
+  OlaServerServiceImpl service(&store, NULL, NULL, NULL, NULL,
+                               &time1, NULL);
+
+  GenericMissingUniverseCheck<UpdateDmxDataCheck, ola::proto::Ack>
+    missing_universe_check;
+  GenericAckCheck<UpdateDmxDataCheck> ack_check;
+  DmxBuffer dmx_data("this is a test");
+  DmxBuffer dmx_data2("different data hmm");
+
+  ola::proto::DmxDataBatch request;
+  ola::proto::DmxData *update = request.add_data();
+  update->set_universe(1);
+  update->set_data(dmx_data.Get());
+  update = request.add_data();
+  update->set_universe(2);
+  update->set_data(dmx_data2.Get());
+  update->set_priority(250);
+
+  // One of the universes doesn't exist, so nothing is applied
+  m_clock.CurrentTime(&time1);
+  Universe *universe1 = store.GetUniverseOrCreate(1);
+  CallUpdateDmxDataBatch(&service, &client1, request,
+                         &missing_universe_check);
+  OLA_ASSERT_EQ(DmxBuffer(), universe1->GetDMX());
+  OLA_ASSERT_FALSE(store.GetUniverse(2));
+
+  // Now both exist
+  Universe *universe2 = store.GetUniverseOrCreate(2);
+  CallUpdateDmxDataBatch(&service, &client1, request, &ack_check);
+  OLA_ASSERT_EQ(dmx_data, universe1->GetDMX());
+  OLA_ASSERT_EQ(dmx_data2, universe2->GetDMX());
+  OLA_ASSERT_EQ(ola::dmx::SOURCE_PRIORITY_DEFAULT,
+                universe1->ActivePriority());
+  // The priority is clamped
+  OLA_ASSERT_EQ(ola::dmx::SOURCE_PRIORITY_MAX, universe2->ActivePriority());
+
+  // If a universe appears more than once, the last update wins
+  m_clock.CurrentTime(&time1);
+  update = request.add_data();
+  update->set_universe(1);
+  update->set_data(dmx_data2.Get());
+  CallUpdateDmxDataBatch(&service, &client1, request, &ack_check);
+  OLA_ASSERT_EQ(dmx_data2, universe1->GetDMX());
+  OLA_ASSERT_EQ(dmx_data2, universe2->GetDMX());
+}
+
+/*
+ * Check that the StreamDmxDataBatch method applies the universes that exist
+ */
+void OlaServerServiceImplTest::testStreamDmxDataBatch() {
+  UniverseStore store(NULL, NULL);
+  ola::TimeStamp time1;
+  ola::Client client1(NULL, m_uid);
+  OlaServerServiceImpl service(&store, NULL, NULL, NULL, NULL,
+                               &time1, NULL);
+
+  DmxBuffer dmx_data("this is a test");
+  DmxBuffer dmx_data2("different data hmm");
+
+  ola::proto::DmxDataBatch request;
+  ola::proto::DmxData *update = request.add_data();
+  update->set_universe(1);
+  update->set_data(dmx_data.Get());
+  update = request.add_data();
+  update->set_universe(2);
+  update->set_data(dmx_data2.Get());
+
+  RpcSession session(NULL);
+  session.SetData(&client1);
+  RpcController controller(&session);
+
+  // Universe 2 doesn't exist, so it's skipped
+  m_clock.CurrentTime(&time1);
+  Universe *universe1 = store.GetUniverseOrCreate(1);
+  service.StreamDmxDataBatch(&controller, &request, NULL, NULL);
+  OLA_ASSERT_FALSE(controller.Failed());
+  OLA_ASSERT_EQ(dmx_data, universe1->GetDMX());
+  OLA_ASSERT_FALSE(store.GetUniverse(2));
+  OLA_ASSERT_FALSE(client1.SourceData(2).IsSet());
+
+  // Once it exists, the data is applied
+  m_clock.CurrentTime(&time1);
+  Universe *universe2 = store.GetUniverseOrCreate(2);
+  service.StreamDmxDataBatch(&controller, &request, NULL, NULL);
+  OLA_ASSERT_EQ(dmx_data, universe1->GetDMX());
+  OLA_ASSERT_EQ(dmx_data2, universe2->GetDMX());
+}
+
+/*
+ * Call the UpdateDmxDataBatch method
+ * @param impl the OlaServerServiceImpl to use
+ * @param client the Client sending the data
+ * @param request the DmxDataBatch to send
+ * @param check the UpdateDmxDataCheck to use for the callback check
+ */
+void OlaServerServiceImplTest::CallUpdateDmxDataBatch(
+    OlaServerServiceImpl *service,
+    Client *client,
+    const ola::proto::DmxDataBatch &request,
+    UpdateDmxDataCheck *check) {
+  RpcSession session(NULL);
+  session.SetData(client);
+  RpcController controller(&session);
+  ola::proto::Ack response;
+  SingleUseCallback0<void> *closure = NewSingleCallback(
+      check,
+      &UpdateDmxDataCheck::Check,
+      &controller,
+      &response);
+
+  service->UpdateDmxDataBatch(&controller, &request, &response, closure);
+}
+
 /*
  * Check the SetUniverseName method works
  */
@@ -535,3 +752,59 @@ void OlaServerServiceImplTest::CallSetMergeMode(
   request.set_merge_mode(merge_mode);
   service->SetMergeMode(&controller, &request, &response, closure);
 }
+
+
+static void Noop() {}
+
+/*
+ * Check the GetLatencyStats method works
+ */
+void OlaServerServiceImplTest::testGetLatencyStats() {
+  ola::ExportMap export_map;
+  UniverseStore store(NULL, &export_map);
+  OlaServerServiceImpl service(&store, NULL, NULL, NULL, NULL, NULL, NULL);
+  RpcSession session(NULL);
+
+  // a universe that doesn't exist
+  {
+    RpcController controller(&session);
+    ola::proto::OptionalUniverseRequest request;
+    ola::proto::LatencyReply response;
+    request.set_universe(1);
+    service.GetLatencyStats(&controller, &request, &response,
+                            NewSingleCallback(&Noop));
+    OLA_ASSERT(controller.Failed());
+  }
+
+  store.GetUniverseOrCreate(1);
+  store.GetUniverseOrCreate(2);
+
+  // a single universe
+  {
+    RpcController controller(&session);
+    ola::proto::OptionalUniverseRequest request;
+    ola::proto::LatencyReply response;
+    request.set_universe(2);
+    service.GetLatencyStats(&controller, &request, &response,
+                            NewSingleCallback(&Noop));
+    OLA_ASSERT_FALSE(controller.Failed());
+    OLA_ASSERT_EQ(1, response.universe_size());
+    OLA_ASSERT_EQ(2, response.universe(0).universe());
+    OLA_ASSERT_EQ(static_cast<uint64_t>(0),
+                  response.universe(0).latency().count());
+    OLA_ASSERT_EQ(0, response.universe(0).output_ports_size());
+  }
+
+  // all universes
+  {
+    RpcController controller(&session);
+    ola::proto::OptionalUniverseRequest request;
+    ola::proto::LatencyReply response;
+    service.GetLatencyStats(&controller, &request, &response,
+                            NewSingleCallback(&Noop));
+    OLA_ASSERT_FALSE(controller.Failed());
+    OLA_ASSERT_EQ(2, response.universe_size());
+    OLA_ASSERT_EQ(1, response.universe(0).universe());
+    OLA_ASSERT_EQ(2, response.universe(1).universe());
+  }
+}
@@ -62,6 +62,22 @@ DEFINE_string(pid_location, "",
               "The directory containing the PID definitions.");
 DEFINE_s_uint16(http_port, p, ola::OlaServer::DEFAULT_HTTP_PORT,
                 "The port to run the http server on. Defaults to 9090.");
+DEFINE_uint16(rdm_discovery_concurrency, 16,
+              "The number of ports that can run RDM discovery at once. 0 "
+              "means no limit.");
+DEFINE_uint16(rdm_discovery_max_backoff, 0,
+              "The longest, in seconds, that periodic RDM discovery on a port "
+              "can be backed off for when nothing has changed. 0 disables "
+              "backoff.");
+DEFINE_default_bool(shared_memory_dmx, false,
+                    "Exchange DMX data with local clients through shared "
+                    "memory.");
+DEFINE_uint16(client_max_rate, 0,
+              "The most DMX updates per second to push to each client, for "
+              "each universe. 0 means no limit.");
+DEFINE_uint32(busy_poll_usec, 0,
+              "Poll for up to this many microseconds before sleeping. This "
+              "uses more CPU but reduces latency.");
 
 /**
  * This is called by the SelectServer loop to start up the SignalThread. If the
@@ -135,6 +151,11 @@ int main(int argc, char *argv[]) {
   options.http_data_dir = FLAGS_http_data_dir.str();
   options.network_interface = FLAGS_interface.str();
   options.pid_data_dir = FLAGS_pid_location.str();
+  options.rdm_discovery_concurrency = FLAGS_rdm_discovery_concurrency;
+  options.rdm_discovery_max_backoff = FLAGS_rdm_discovery_max_backoff;
+  options.shared_memory_dmx = FLAGS_shared_memory_dmx;
+  options.client_max_rate = FLAGS_client_max_rate;
+  options.busy_poll_usec = FLAGS_busy_poll_usec;
 
   std::auto_ptr<OlaDaemon> olad(new OlaDaemon(options, &export_map));
   if (!olad.get()) {
@@ -52,6 +52,7 @@ using ola::http::HTTPServer;
 using ola::io::ConnectedDescriptor;
 using ola::web::JsonArray;
 using ola::web::JsonObject;
+using ola::web::JsonStreamWriter;
 using std::cout;
 using std::endl;
 using std::ostringstream;
@@ -454,6 +455,14 @@ int OladHTTPServer::JsonServerStats(const HTTPRequest*,
   json.Add("up_since", start_time_str);
   json.Add("quit_enabled", m_enable_quit);
 
+  vector<ola::VariableSnapshot> variables;
+  m_export_map->Snapshot(&variables);
+  JsonObject *variables_json = json.AddObject("variables");
+  vector<ola::VariableSnapshot>::const_iterator iter = variables.begin();
+  for (; iter != variables.end(); ++iter) {
+    variables_json->Add(iter->name, iter->value);
+  }
+
   response->SetNoCache();
   response->SetContentType(HTTPServer::CONTENT_TYPE_PLAIN);
   int r = response->SendJson(json);
@@ -968,8 +977,6 @@ void OladHTTPServer::HandleUniverseInfo(HTTPResponse *response,
     return;
   }
 
-  JsonObject *json = new JsonObject();
-
   // fire off the device/port request now. the main server is running in a
   // separate thread.
   m_client.FetchDeviceInfo(
@@ -977,56 +984,66 @@ void OladHTTPServer::HandleUniverseInfo(HTTPResponse *response,
       NewSingleCallback(this,
                         &OladHTTPServer::HandlePortsForUniverse,
                         response,
-                        json,
-                        universe.Id()));
-
-  json->Add("id", universe.Id());
-  json->Add("name", universe.Name());
-  json->Add("merge_mode",
-           (universe.MergeMode() == OlaUniverse::MERGE_HTP ? "HTP" : "LTP"));
+                        universe.Id(),
+                        universe.Name(),
+                        universe.MergeMode() == OlaUniverse::MERGE_HTP));
 }
 
 
+/**
+ * @brief Send the universe info, along with the ports patched to it.
+ *
+ * This is written directly to the response, since there may be thousands of
+ * ports.
+ */
 void OladHTTPServer::HandlePortsForUniverse(
     HTTPResponse *response,
-    JsonObject *json,
     unsigned int universe_id,
+    string name,
+    bool is_htp,
     const client::Result &result,
     const vector<OlaDevice> &devices) {
+  JsonStreamWriter writer(response->Body());
+  writer.StartObject();
+  writer.Add("id", universe_id);
+  writer.Add("name", name);
+  writer.Add("merge_mode", is_htp ? "HTP" : "LTP");
+
   if (result.Success()) {
-    vector<OlaDevice>::const_iterator iter = devices.begin();
+    vector<OlaDevice>::const_iterator iter;
     vector<OlaInputPort>::const_iterator input_iter;
     vector<OlaOutputPort>::const_iterator output_iter;
 
-    JsonArray *output_ports_json = json->AddArray("output_ports");
-    JsonArray *input_ports_json = json->AddArray("input_ports");
-
-    for (; iter != devices.end(); ++iter) {
+    writer.StartArray("input_ports");
+    for (iter = devices.begin(); iter != devices.end(); ++iter) {
       const vector<OlaInputPort> &input_ports = iter->InputPorts();
       for (input_iter = input_ports.begin(); input_iter != input_ports.end();
            ++input_iter) {
         if (input_iter->IsActive() && input_iter->Universe() == universe_id) {
-          JsonObject *obj = input_ports_json->AppendObject();
-          PortToJson(obj, *iter, *input_iter, false);
+          PortToJson(&writer, *iter, *input_iter, false);
         }
       }
+    }
+    writer.EndArray();
 
+    writer.StartArray("output_ports");
+    for (iter = devices.begin(); iter != devices.end(); ++iter) {
       const vector<OlaOutputPort> &output_ports = iter->OutputPorts();
       for (output_iter = output_ports.begin();
            output_iter != output_ports.end(); ++output_iter) {
         if (output_iter->IsActive() &&
             output_iter->Universe() == universe_id) {
-          JsonObject *obj = output_ports_json->AppendObject();
-          PortToJson(obj, *iter, *output_iter, true);
+          PortToJson(&writer, *iter, *output_iter, true);
         }
       }
     }
+    writer.EndArray();
   }
+  writer.EndObject();
 
   response->SetNoCache();
   response->SetContentType(HTTPServer::CONTENT_TYPE_PLAIN);
-  response->SendJson(*json);
-  delete json;
+  response->Send();
   delete response;
 }
 
@@ -1050,26 +1067,26 @@ void OladHTTPServer::HandleCandidatePorts(
   vector<OlaInputPort>::const_iterator input_iter;
   vector<OlaOutputPort>::const_iterator output_iter;
 
-  JsonArray json;
+  JsonStreamWriter writer(response->Body());
+  writer.StartArray();
   for (; iter != devices.end(); ++iter) {
     const vector<OlaInputPort> &input_ports = iter->InputPorts();
     for (input_iter = input_ports.begin(); input_iter != input_ports.end();
          ++input_iter) {
-      JsonObject *obj = json.AppendObject();
-      PortToJson(obj, *iter, *input_iter, false);
+      PortToJson(&writer, *iter, *input_iter, false);
     }
 
     const vector<OlaOutputPort> &output_ports = iter->OutputPorts();
     for (output_iter = output_ports.begin();
          output_iter != output_ports.end(); ++output_iter) {
-      JsonObject *obj = json.AppendObject();
-      PortToJson(obj, *iter, *output_iter, true);
+      PortToJson(&writer, *iter, *output_iter, true);
     }
   }
+  writer.EndArray();
 
   response->SetNoCache();
   response->SetContentType(HTTPServer::CONTENT_TYPE_PLAIN);
-  response->SendJson(json);
+  response->Send();
   delete response;
 }
 
@@ -1214,21 +1231,22 @@ void OladHTTPServer::HandleBoolResponse(HTTPResponse *response,
 
 
 /**
- * @brief Add the json representation of this port to the ostringstream
+ * @brief Write the json representation of this port
  */
-void OladHTTPServer::PortToJson(JsonObject *json,
+void OladHTTPServer::PortToJson(JsonStreamWriter *writer,
                                 const OlaDevice &device,
                                 const OlaPort &port,
                                 bool is_output) {
   ostringstream str;
   str << device.Alias() << "-" << (is_output ? "O" : "I") << "-" << port.Id();
 
-  json->Add("device", device.Name());
-  json->Add("description", port.Description());
-  json->Add("id", str.str());
-  json->Add("is_output", is_output);
+  writer->StartObject();
+  writer->Add("device", device.Name());
+  writer->Add("description", port.Description());
+  writer->Add("id", str.str());
+  writer->Add("is_output", is_output);
 
-  JsonObject *priority_json = json->AddObject("priority");
+  writer->StartObject("priority");
   if (port.PriorityCapability() != CAPABILITY_NONE) {
     // This can be used as the default value for the priority input and because
     // inherit ports can return a 0 priority we shall set it to the default
@@ -1238,13 +1256,15 @@ void OladHTTPServer::PortToJson(JsonObject *json,
       // We check here because 0 is an invalid priority outside of Olad
       priority = dmx::SOURCE_PRIORITY_DEFAULT;
     }
-    priority_json->Add("value", static_cast<int>(priority));
-    priority_json->Add(
+    writer->Add("value", static_cast<int>(priority));
+    writer->Add(
       "current_mode",
       (port.PriorityMode() == PRIORITY_MODE_INHERIT ?  "inherit" : "static"));
-    priority_json->Add("priority_capability",
+    writer->Add("priority_capability",
       (port.PriorityCapability() == CAPABILITY_STATIC ? "static" : "full"));
   }
+  writer->EndObject();
+  writer->EndObject();
 }
 
 
@@ -31,6 +31,7 @@
 #include "ola/http/OlaHTTPServer.h"
 #include "ola/network/Interface.h"
 #include "ola/rdm/PidStore.h"
+#include "ola/web/JsonStreamWriter.h"
 #include "olad/RDMHTTPModule.h"
 
 namespace ola {
@@ -113,8 +114,9 @@ class OladHTTPServer: public ola::http::OlaHTTPServer {
                           const client::OlaUniverse &universe);
 
   void HandlePortsForUniverse(ola::http::HTTPResponse *response,
-                              ola::web::JsonObject *json,
                               unsigned int universe_id,
+                              std::string name,
+                              bool is_htp,
                               const client::Result &result,
                               const std::vector<client::OlaDevice> &devices);
 
@@ -167,7 +169,7 @@ class OladHTTPServer: public ola::http::OlaHTTPServer {
   void HandleBoolResponse(ola::http::HTTPResponse *response,
                           const client::Result &result);
 
-  void PortToJson(ola::web::JsonObject *object,
+  void PortToJson(ola::web::JsonStreamWriter *writer,
                   const client::OlaDevice &device,
                   const client::OlaPort &port,
                   bool is_output);
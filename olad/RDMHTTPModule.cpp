@@ -42,6 +42,7 @@
 #include "ola/thread/Mutex.h"
 #include "ola/web/Json.h"
 #include "ola/web/JsonSections.h"
+#include "ola/web/JsonStreamWriter.h"
 #include "olad/OlaServer.h"
 #include "olad/OladHTTPServer.h"
 #include "olad/RDMHTTPModule.h"
@@ -62,6 +63,7 @@ using ola::web::HiddenItem;
 using ola::web::JsonArray;
 using ola::web::JsonObject;
 using ola::web::JsonSection;
+using ola::web::JsonStreamWriter;
 using ola::web::SelectItem;
 using ola::web::StringItem;
 using ola::web::UIntItem;
@@ -713,9 +715,10 @@ void RDMHTTPModule::HandleUIDList(HTTPResponse *response,
        uid_iter != uid_state->resolved_uids.end(); ++uid_iter)
     uid_iter->second.active = false;
 
-  JsonObject json;
-  json.Add("universe", universe_id);
-  JsonArray *json_uids = json.AddArray("uids");
+  JsonStreamWriter writer(response->Body());
+  writer.StartObject();
+  writer.Add("universe", universe_id);
+  writer.StartArray("uids");
 
   for (; iter != uids.End(); ++iter) {
     uid_iter = uid_state->resolved_uids.find(*iter);
@@ -736,17 +739,20 @@ void RDMHTTPModule::HandleUIDList(HTTPResponse *response,
       uid_iter->second.active = true;
     }
 
-    JsonObject *json_uid = json_uids->AppendObject();
-    json_uid->Add("manufacturer_id", iter->ManufacturerId());
-    json_uid->Add("device_id", iter->DeviceId());
-    json_uid->Add("device", device);
-    json_uid->Add("manufacturer", manufacturer);
-    json_uid->Add("uid", iter->ToString());
+    writer.StartObject();
+    writer.Add("manufacturer_id", iter->ManufacturerId());
+    writer.Add("device_id", iter->DeviceId());
+    writer.Add("device", device);
+    writer.Add("manufacturer", manufacturer);
+    writer.Add("uid", iter->ToString());
+    writer.EndObject();
   }
+  writer.EndArray();
+  writer.EndObject();
 
   response->SetNoCache();
   response->SetContentType(HTTPServer::CONTENT_TYPE_PLAIN);
-  response->SendJson(json);
+  response->Send();
   delete response;
 
   // remove any old UIDs
@@ -1180,18 +1186,21 @@ void RDMHTTPModule::SupportedSectionsDeviceInfoHandler(
 
   sort(sections.begin(), sections.end(), lt_section_info());
 
-  JsonArray json;
+  JsonStreamWriter writer(response->Body());
+  writer.StartArray();
   vector<section_info>::const_iterator section_iter = sections.begin();
   for (; section_iter != sections.end(); ++section_iter) {
-    JsonObject *json_obj = json.AppendObject();
-    json_obj->Add("id", section_iter->id);
-    json_obj->Add("name", section_iter->name);
-    json_obj->Add("hint",  section_iter->hint);
+    writer.StartObject();
+    writer.Add("id", section_iter->id);
+    writer.Add("name", section_iter->name);
+    writer.Add("hint",  section_iter->hint);
+    writer.EndObject();
   }
+  writer.EndArray();
 
   response->SetNoCache();
   response->SetContentType(HTTPServer::CONTENT_TYPE_PLAIN);
-  response->SendJson(json);
+  response->Send();
   delete response;
 }
 
@@ -0,0 +1,188 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * SharedMemoryTransport.cpp
+ * Exchanges DMX data with local clients through shared memory.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <errno.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "ola/Callback.h"
+#include "ola/DmxBuffer.h"
+#include "ola/Logging.h"
+#include "ola/dmx/SourcePriorities.h"
+#include "olad/DmxSource.h"
+#include "olad/SharedMemoryTransport.h"
+#include "olad/Universe.h"
+#include "olad/plugin_api/Client.h"
+#include "olad/plugin_api/UniverseStore.h"
+
+namespace ola {
+
+using ola::dmx::SharedMemoryUniverseTable;
+using std::string;
+
+SharedMemoryTransport::SharedMemoryTransport(UniverseStore *universe_store,
+                                             const TimeStamp *wake_up_time,
+                                             const ola::rdm::UID &uid)
+    : m_universe_store(universe_store),
+      m_wake_up_time(wake_up_time),
+      m_uid(uid),
+      m_ss(NULL) {
+}
+
+
+SharedMemoryTransport::~SharedMemoryTransport() {
+  std::vector<SlotState>::iterator iter = m_slots.begin();
+  for (; iter != m_slots.end(); ++iter) {
+    RemoveSlot(&(*iter));
+  }
+
+  if (m_ss && m_table.NotificationDescriptor()) {
+    m_ss->RemoveReadDescriptor(m_table.NotificationDescriptor());
+  }
+}
+
+
+bool SharedMemoryTransport::Init(const string &name,
+                                 ola::io::SelectServerInterface *ss) {
+  if (m_table.IsOpen()) {
+    return false;
+  }
+
+  if (!m_table.Create(name)) {
+    return false;
+  }
+
+  SlotState empty_state;
+  empty_state.client = NULL;
+  empty_state.sequence = 0;
+  m_slots.assign(m_table.SlotCount(), empty_state);
+
+  ola::io::UnmanagedFileDescriptor *descriptor =
+      m_table.NotificationDescriptor();
+  descriptor->SetOnData(
+      NewCallback(this, &SharedMemoryTransport::NotificationReceived));
+  // ClearNotifications() empties the socket.
+  descriptor->SetReadsUntilEmpty(true);
+  if (!ss->AddReadDescriptor(descriptor)) {
+    m_table.Close();
+    return false;
+  }
+  m_ss = ss;
+  OLA_INFO << "Shared memory DMX transport using " << name;
+  return true;
+}
+
+
+void SharedMemoryTransport::CheckSlots() {
+  for (unsigned int i = 0; i < m_slots.size(); i++) {
+    SharedMemoryUniverseTable::SlotInfo info;
+    bool active = m_table.GetSlotInfo(i, &info);
+    SlotState *state = &m_slots[i];
+
+    if (state->client &&
+        (!active || info.direction != state->info.direction ||
+         info.universe != state->info.universe ||
+         info.owner != state->info.owner)) {
+      RemoveSlot(state);
+    }
+
+    if (!active || info.direction != SharedMemoryUniverseTable::INPUT_SLOT) {
+      continue;
+    }
+
+    if (!state->client) {
+      AddSlot(i, info);
+    }
+    ReadInput(i, state);
+  }
+}
+
+
+void SharedMemoryTransport::ReclaimDeadSlots() {
+#ifndef _WIN32
+  for (unsigned int i = 0; i < m_slots.size(); i++) {
+    SharedMemoryUniverseTable::SlotInfo info;
+    if (!m_table.GetSlotInfo(i, &info)) {
+      continue;
+    }
+
+    if (kill(static_cast<pid_t>(info.owner), 0) < 0 && errno == ESRCH) {
+      OLA_INFO << "Releasing shared memory slot " << i << " held by "
+               << info.owner;
+      m_table.ReclaimSlot(i, info.owner);
+    }
+  }
+#endif  // _WIN32
+}
+
+
+void SharedMemoryTransport::NotificationReceived() {
+  m_table.ClearNotifications();
+  CheckSlots();
+}
+
+
+void SharedMemoryTransport::AddSlot(
+    unsigned int slot,
+    const SharedMemoryUniverseTable::SlotInfo &info) {
+  SlotState *state = &m_slots[slot];
+  state->info = info;
+  state->sequence = 0;
+  state->client = new Client(NULL, m_uid);
+}
+
+
+void SharedMemoryTransport::RemoveSlot(SlotState *state) {
+  if (!state->client) {
+    return;
+  }
+
+  Universe *universe = m_universe_store->GetUniverse(state->info.universe);
+  if (universe) {
+    universe->RemoveSourceClient(state->client);
+  }
+  delete state->client;
+  state->client = NULL;
+}
+
+
+void SharedMemoryTransport::ReadInput(unsigned int slot, SlotState *state) {
+  uint8_t priority;
+  DmxBuffer buffer;
+  if (!m_table.Read(slot, &state->sequence, &priority, &buffer)) {
+    return;
+  }
+
+  Universe *universe = m_universe_store->GetUniverse(state->info.universe);
+  if (!universe) {
+    return;
+  }
+
+  priority = std::max(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MIN),
+                      priority);
+  priority = std::min(static_cast<uint8_t>(ola::dmx::SOURCE_PRIORITY_MAX),
+                      priority);
+  DmxSource source(buffer, *m_wake_up_time, priority);
+  state->client->DMXReceived(state->info.universe, source);
+  universe->SourceClientDataChanged(state->client);
+}
+}  // namespace ola
@@ -0,0 +1,98 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * SharedMemoryTransport.h
+ * Exchanges DMX data with local clients through shared memory.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#ifndef OLAD_SHAREDMEMORYTRANSPORT_H_
+#define OLAD_SHAREDMEMORYTRANSPORT_H_
+
+#include <string>
+#include <vector>
+#include "ola/Clock.h"
+#include "ola/base/Macro.h"
+#include "ola/dmx/SharedMemoryUniverseTable.h"
+#include "ola/io/SelectServerInterface.h"
+#include "ola/rdm/UID.h"
+
+namespace ola {
+
+/**
+ * @brief The olad end of the shared memory DMX transport.
+ *
+ * This creates the SharedMemoryUniverseTable. Each claimed slot is given its
+ * own Client, so the frames are merged like any other source client.
+ *
+ * The protobuf RPCs are still used for everything else.
+ */
+class SharedMemoryTransport {
+ public:
+  /**
+   * @brief Create a new SharedMemoryTransport.
+   * @param universe_store the UniverseStore to pass data to / from.
+   * @param wake_up_time the time the SelectServer woke up.
+   * @param uid the UID to use for the clients.
+   */
+  SharedMemoryTransport(class UniverseStore *universe_store,
+                        const TimeStamp *wake_up_time,
+                        const ola::rdm::UID &uid);
+  ~SharedMemoryTransport();
+
+  /**
+   * @brief Create the table and start listening for notifications.
+   * @param name the name of the shared memory object.
+   * @param ss the SelectServer to register the notification socket with.
+   * @returns true if the table was created, false otherwise.
+   */
+  bool Init(const std::string &name, ola::io::SelectServerInterface *ss);
+
+  /**
+   * @brief Check for new or released slots, and new input frames.
+   */
+  void CheckSlots();
+
+  /**
+   * @brief Release any slots held by processes that have exited.
+   *
+   * Call CheckSlots() afterwards to remove their clients.
+   */
+  void ReclaimDeadSlots();
+
+ private:
+  struct SlotState {
+    class Client *client;  // NULL if the slot isn't in use.
+    ola::dmx::SharedMemoryUniverseTable::SlotInfo info;
+    uint32_t sequence;
+  };
+
+  class UniverseStore *m_universe_store;
+  const TimeStamp *m_wake_up_time;
+  const ola::rdm::UID m_uid;
+  ola::io::SelectServerInterface *m_ss;
+  ola::dmx::SharedMemoryUniverseTable m_table;
+  std::vector<SlotState> m_slots;
+
+  void NotificationReceived();
+  void AddSlot(unsigned int slot,
+               const ola::dmx::SharedMemoryUniverseTable::SlotInfo &info);
+  void RemoveSlot(SlotState *state);
+  void ReadInput(unsigned int slot, SlotState *state);
+
+  DISALLOW_COPY_AND_ASSIGN(SharedMemoryTransport);
+};
+}  // namespace ola
+#endif  // OLAD_SHAREDMEMORYTRANSPORT_H_
@@ -22,6 +22,7 @@
 #include <utility>
 #include "common/protocol/Ola.pb.h"
 #include "common/protocol/OlaService.pb.h"
+#include "common/rpc/RpcChannel.h"
 #include "ola/Callback.h"
 #include "ola/Logging.h"
 #include "ola/rdm/UID.h"
@@ -32,39 +33,67 @@ namespace ola {
 
 using ola::rdm::UID;
 using ola::rpc::RpcController;
+using ola::rpc::SerializedRequest;
 using std::map;
 
+const SerializedRequest &DmxUpdate::Request() const {
+  if (!m_request.IsSet()) {
+    static const google::protobuf::MethodDescriptor *method =
+        ola::proto::OlaClientService::descriptor()->FindMethodByName(
+            "UpdateDmxData");
+
+    ola::proto::DmxData dmx_data;
+    dmx_data.set_priority(m_priority);
+    dmx_data.set_universe(m_universe);
+    dmx_data.set_data(m_data.Get());
+    m_request = SerializedRequest(method, dmx_data);
+  }
+  return m_request;
+}
+
+
 Client::Client(ola::proto::OlaClientService_Stub *client_stub,
-               const ola::rdm::UID &uid)
+               const ola::rdm::UID &uid,
+               const Options &options,
+               ola::thread::SchedulerInterface *scheduler)
     : m_client_stub(client_stub),
-      m_uid(uid) {
+      m_uid(uid),
+      m_scheduler(scheduler),
+      m_coalesced_updates(0) {
+  if (options.max_rate && scheduler) {
+    m_min_interval = TimeInterval(USEC_IN_SECONDS / options.max_rate);
+  }
 }
 
 Client::~Client() {
+  OutputMap::iterator iter = m_outputs.begin();
+  for (; iter != m_outputs.end(); ++iter) {
+    if (iter->second.timeout != ola::thread::INVALID_TIMEOUT) {
+      m_scheduler->RemoveTimeout(iter->second.timeout);
+    }
+  }
   m_data_map.clear();
 }
 
-bool Client::SendDMX(unsigned int universe, uint8_t priority,
-                     const DmxBuffer &buffer) {
+bool Client::SendDMX(const DmxUpdate &update) {
   if (!m_client_stub.get()) {
     OLA_FATAL << "client_stub is null";
     return false;
   }
 
-  RpcController *controller = new RpcController();
-  ola::proto::DmxData dmx_data;
-  ola::proto::Ack *ack = new ola::proto::Ack();
-
-  dmx_data.set_priority(priority);
-  dmx_data.set_universe(universe);
-  dmx_data.set_data(buffer.Get());
+  UniverseOutput *output = &m_outputs[update.Universe()];
+  // If the client hasn't caught up yet, only the latest update is kept.
+  if (output->has_pending) {
+    m_coalesced_updates++;
+  }
+  output->pending = update;
+  output->has_pending = true;
 
-  m_client_stub->UpdateDmxData(
-      controller,
-      &dmx_data,
-      ack,
-      ola::NewSingleCallback(this, &ola::Client::SendDMXCallback,
-                             controller, ack));
+  if (!output->in_flight &&
+      output->timeout == ola::thread::INVALID_TIMEOUT &&
+      !DeferPending(update.Universe(), output)) {
+    SendPending(update.Universe());
+  }
   return true;
 }
 
@@ -92,13 +121,92 @@ void Client::SetUID(const ola::rdm::UID &uid) {
   m_uid = uid;
 }
 
+/*
+ * Send an update to the client.
+ */
+void Client::Push(const DmxUpdate &update, UniverseOutput *output) {
+  RpcController *controller = new RpcController();
+  ola::proto::Ack *ack = new ola::proto::Ack();
+
+  output->in_flight = true;
+  if (m_min_interval.AsInt()) {
+    m_clock.CurrentTime(&output->last_sent);
+  }
+
+  ola::SingleUseCallback0<void> *callback = ola::NewSingleCallback(
+      this, &ola::Client::SendDMXCallback, controller, ack,
+      update.Universe());
+
+  ola::rpc::RpcChannel *channel = m_client_stub->channel();
+  if (channel) {
+    channel->CallMethod(update.Request(), controller, ack, callback);
+  } else {
+    // The stub isn't backed by a channel, so build the request.
+    ola::proto::DmxData dmx_data;
+    dmx_data.set_priority(update.Priority());
+    dmx_data.set_universe(update.Universe());
+    dmx_data.set_data(update.Data().Get());
+    m_client_stub->UpdateDmxData(controller, &dmx_data, ack, callback);
+  }
+}
+
+
+/*
+ * If the last update for the universe was sent too recently, schedule the
+ * pending update to be sent once the rate limit allows.
+ * @returns true if the update was deferred, false if it can be sent now.
+ */
+bool Client::DeferPending(unsigned int universe, UniverseOutput *output) {
+  if (!m_min_interval.AsInt() || !output->last_sent.IsSet()) {
+    return false;
+  }
+
+  TimeStamp now;
+  m_clock.CurrentTime(&now);
+  TimeStamp next_send = output->last_sent + m_min_interval;
+  if (next_send <= now) {
+    return false;
+  }
+  output->timeout = m_scheduler->RegisterSingleTimeout(
+      next_send - now,
+      ola::NewSingleCallback(this, &Client::SendPending, universe));
+  return true;
+}
+
+
+/*
+ * Send the pending update for a universe, if there is one.
+ */
+void Client::SendPending(unsigned int universe) {
+  UniverseOutput *output = &m_outputs[universe];
+  output->timeout = ola::thread::INVALID_TIMEOUT;
+  if (output->in_flight || !output->has_pending) {
+    return;
+  }
+  output->has_pending = false;
+  // Release our reference to the data once it's sent.
+  DmxUpdate update = output->pending;
+  output->pending = DmxUpdate();
+  Push(update, output);
+}
+
+
 /*
  * Called when UpdateDmxData completes.
  */
 void Client::SendDMXCallback(RpcController *controller,
-                             ola::proto::Ack *reply) {
+                             ola::proto::Ack *reply,
+                             unsigned int universe) {
   delete controller;
   delete reply;
+
+  UniverseOutput *output = &m_outputs[universe];
+  output->in_flight = false;
+  if (output->has_pending &&
+      output->timeout == ola::thread::INVALID_TIMEOUT &&
+      !DeferPending(universe, output)) {
+    SendPending(universe);
+  }
 }
 
 
@@ -21,11 +21,16 @@
 #ifndef OLAD_PLUGIN_API_CLIENT_H_
 #define OLAD_PLUGIN_API_CLIENT_H_
 
+#include <stdint.h>
 #include <map>
 #include <memory>
 #include "common/rpc/RpcController.h"
+#include "common/rpc/SerializedRequest.h"
+#include "ola/Clock.h"
+#include "ola/DmxBuffer.h"
 #include "ola/base/Macro.h"
 #include "ola/rdm/UID.h"
+#include "ola/thread/SchedulerInterface.h"
 #include "olad/DmxSource.h"
 
 namespace ola {
@@ -37,35 +42,92 @@ class Ack;
 
 namespace ola {
 
+/**
+ * @brief A DMX update for a universe, which is pushed to the sink clients.
+ *
+ * The DmxData request is serialized the first time the update is sent over
+ * an RPC channel, after that it's shared by all the clients, and any copies
+ * of the update.
+ */
+class DmxUpdate {
+ public:
+  DmxUpdate() : m_universe(0), m_priority(0) {}
+
+  DmxUpdate(unsigned int universe, uint8_t priority, const DmxBuffer &data)
+      : m_universe(universe),
+        m_priority(priority),
+        m_data(data) {
+  }
+
+  unsigned int Universe() const { return m_universe; }
+  uint8_t Priority() const { return m_priority; }
+  const DmxBuffer &Data() const { return m_data; }
+
+  /**
+   * @brief Return the serialized UpdateDmxData request for this update.
+   */
+  const ola::rpc::SerializedRequest &Request() const;
+
+ private:
+  unsigned int m_universe;
+  uint8_t m_priority;
+  DmxBuffer m_data;
+  mutable ola::rpc::SerializedRequest m_request;
+};
+
+
 /**
  * @brief Represents a connected OLA client on the OLA server side.
  *
  * This stores the state of the client (i.e. DMX data) and allows us to push
  * DMX updates to the client via the OlaClientService_Stub.
+ *
+ * Only one update per universe is in flight to the client at once. If more
+ * updates arrive before the client acks the last one, only the latest is
+ * kept, so a slow client never backs up the send queue.
  */
 class Client {
  public :
+  struct Options {
+   public:
+    /**
+     * @brief The most updates per second to push for each universe, 0 means
+     *   no limit. Updates that arrive too soon are coalesced.
+     */
+    unsigned int max_rate;
+
+    Options() : max_rate(0) {}
+  };
+
   /**
    * @brief Create a new client.
    * @param client_stub The OlaClientService_Stub to use to communicate with
    *   the client. Ownership is transferred to the client.
    * @param uid The default UID to use for this client. The client may set its
    *   own UID later.
+   * @param options the Options for the client.
+   * @param scheduler the scheduler to use to send rate limited updates,
+   *   required if Options::max_rate is set.
    */
   Client(ola::proto::OlaClientService_Stub *client_stub,
-         const ola::rdm::UID &uid);
+         const ola::rdm::UID &uid,
+         const Options &options = Options(),
+         ola::thread::SchedulerInterface *scheduler = NULL);
 
   virtual ~Client();
 
   /**
    * @brief Push a DMX update to this client.
-   * @param universe_id the universe the DMX data belongs to
-   * @param priority the priority of the DMX data
-   * @param buffer the DMX data.
-   * @return true if the update was sent, false otherwise
+   * @param update the DmxUpdate to push.
+   * @return true if the update was sent or queued, false otherwise
    */
-  virtual bool SendDMX(unsigned int universe_id, uint8_t priority,
-                       const DmxBuffer &buffer);
+  virtual bool SendDMX(const DmxUpdate &update);
+
+  /**
+   * @brief The number of updates that were replaced by a newer update before
+   * they could be sent.
+   */
+  unsigned int CoalescedUpdates() const { return m_coalesced_updates; }
 
   /**
    * @brief Called when this client sends us new data
@@ -96,12 +158,38 @@ class Client {
   void SetUID(const ola::rdm::UID &uid);
 
  private:
+  // The updates for a universe that we're pushing to the client.
+  struct UniverseOutput {
+    UniverseOutput()
+        : in_flight(false),
+          has_pending(false),
+          timeout(ola::thread::INVALID_TIMEOUT) {
+    }
+
+    bool in_flight;
+    bool has_pending;
+    DmxUpdate pending;
+    TimeStamp last_sent;
+    ola::thread::timeout_id timeout;
+  };
+
+  typedef std::map<unsigned int, UniverseOutput> OutputMap;
+
+  void Push(const DmxUpdate &update, UniverseOutput *output);
+  bool DeferPending(unsigned int universe, UniverseOutput *output);
+  void SendPending(unsigned int universe);
   void SendDMXCallback(ola::rpc::RpcController *controller,
-                       ola::proto::Ack *ack);
+                       ola::proto::Ack *ack,
+                       unsigned int universe);
 
   std::auto_ptr<class ola::proto::OlaClientService_Stub> m_client_stub;
   std::map<unsigned int, DmxSource> m_data_map;
   ola::rdm::UID m_uid;
+  ola::thread::SchedulerInterface *m_scheduler;
+  TimeInterval m_min_interval;
+  OutputMap m_outputs;
+  unsigned int m_coalesced_updates;
+  Clock m_clock;
 
   DISALLOW_COPY_AND_ASSIGN(Client);
 };
@@ -20,6 +20,7 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <string>
+#include <vector>
 
 #include "common/protocol/Ola.pb.h"
 #include "common/protocol/OlaService.pb.h"
@@ -28,6 +29,7 @@
 #include "ola/Clock.h"
 #include "ola/Constants.h"
 #include "ola/DmxBuffer.h"
+#include "ola/io/SelectServer.h"
 #include "ola/rdm/UID.h"
 #include "ola/testing/TestUtils.h"
 #include "olad/DmxSource.h"
@@ -41,18 +43,24 @@ static const char TEST_DATA2[] = "another set of test data";
 
 using ola::Client;
 using ola::DmxBuffer;
+using ola::DmxUpdate;
 using std::string;
+using std::vector;
 
 class ClientTest: public CppUnit::TestFixture {
   CPPUNIT_TEST_SUITE(ClientTest);
   CPPUNIT_TEST(testSendDMX);
   CPPUNIT_TEST(testGetSetDMX);
+  CPPUNIT_TEST(testCoalescing);
+  CPPUNIT_TEST(testRateLimit);
   CPPUNIT_TEST_SUITE_END();
 
  public:
   ClientTest() : m_test_uid(ola::OPEN_LIGHTING_ESTA_CODE, 0) {}
   void testSendDMX();
   void testGetSetDMX();
+  void testCoalescing();
+  void testRateLimit();
 
  private:
   ola::Clock m_clock;
@@ -87,6 +95,43 @@ void MockClientStub::UpdateDmxData(
   done->Run();
 }
 
+
+/*
+ * A ClientStub that doesn't ack the updates until we tell it to.
+ */
+class SlowClientStub: public ola::proto::OlaClientService_Stub {
+ public:
+  SlowClientStub(): ola::proto::OlaClientService_Stub(NULL) {}
+
+  ~SlowClientStub() {
+    // The Client is being destroyed, so don't run the callbacks.
+    for (unsigned int i = 0; i < m_pending_acks.size(); i++) {
+      delete m_pending_acks[i];
+    }
+  }
+
+  void UpdateDmxData(ola::rpc::RpcController*,
+                     const ola::proto::DmxData *request,
+                     ola::proto::Ack*,
+                     ola::rpc::RpcService::CompletionCallback *done) {
+    updates.push_back(*request);
+    m_pending_acks.push_back(done);
+  }
+
+  void AckAll() {
+    vector<ola::rpc::RpcService::CompletionCallback*> acks;
+    acks.swap(m_pending_acks);
+    for (unsigned int i = 0; i < acks.size(); i++) {
+      acks[i]->Run();
+    }
+  }
+
+  vector<ola::proto::DmxData> updates;
+
+ private:
+  vector<ola::rpc::RpcService::CompletionCallback*> m_pending_acks;
+};
+
 /*
  * Check that the SendDMX method works correctly.
  */
@@ -95,11 +140,12 @@ void ClientTest::testSendDMX() {
   const DmxBuffer buffer(TEST_DATA);
   uint8_t priority = 100;
   Client client(NULL, m_test_uid);
-  client.SendDMX(TEST_UNIVERSE, priority, buffer);
+  OLA_ASSERT_FALSE(client.SendDMX(DmxUpdate(TEST_UNIVERSE, priority, buffer)));
 
   // check the stub is called correctly
   Client client2(new MockClientStub(), m_test_uid);
-  client2.SendDMX(TEST_UNIVERSE, priority, buffer);
+  OLA_ASSERT_TRUE(client2.SendDMX(DmxUpdate(TEST_UNIVERSE, priority,
+                                            buffer)));
 }
 
 /*
@@ -142,3 +188,73 @@ void ClientTest::testGetSetDMX() {
   OLA_ASSERT_FALSE(source4.IsSet());
   OLA_ASSERT_DMX_EQUALS(empty, source4.Data());
 }
+
+
+/*
+ * Check that updates to a slow client are coalesced.
+ */
+void ClientTest::testCoalescing() {
+  SlowClientStub *stub = new SlowClientStub();
+  Client client(stub, m_test_uid);
+
+  const DmxBuffer buffer(TEST_DATA);
+  const DmxBuffer buffer2(TEST_DATA2);
+  OLA_ASSERT_TRUE(client.SendDMX(DmxUpdate(TEST_UNIVERSE, 100, buffer)));
+  OLA_ASSERT_EQ(static_cast<size_t>(1), stub->updates.size());
+
+  // The first update hasn't been acked, so these are held back, and only the
+  // latest is sent.
+  for (unsigned int i = 0; i < 10; i++) {
+    client.SendDMX(DmxUpdate(TEST_UNIVERSE, 100, buffer));
+  }
+  client.SendDMX(DmxUpdate(TEST_UNIVERSE, 120, buffer2));
+  // Other universes aren't held back.
+  client.SendDMX(DmxUpdate(TEST_UNIVERSE2, 100, buffer));
+  OLA_ASSERT_EQ(static_cast<size_t>(2), stub->updates.size());
+  OLA_ASSERT_EQ(TEST_UNIVERSE2,
+                static_cast<unsigned int>(stub->updates[1].universe()));
+  OLA_ASSERT_EQ(10u, client.CoalescedUpdates());
+
+  stub->AckAll();
+  OLA_ASSERT_EQ(static_cast<size_t>(3), stub->updates.size());
+  OLA_ASSERT_EQ(TEST_UNIVERSE,
+                static_cast<unsigned int>(stub->updates[2].universe()));
+  OLA_ASSERT_EQ(120, stub->updates[2].priority());
+  OLA_ASSERT_EQ(string(TEST_DATA2), stub->updates[2].data());
+
+  // Nothing else is pending.
+  stub->AckAll();
+  OLA_ASSERT_EQ(static_cast<size_t>(3), stub->updates.size());
+}
+
+
+/*
+ * Check that the update rate can be limited.
+ */
+void ClientTest::testRateLimit() {
+  ola::io::SelectServer ss;
+  SlowClientStub *stub = new SlowClientStub();
+  Client::Options options;
+  options.max_rate = 20;  // 50ms between updates
+  Client client(stub, m_test_uid, options, &ss);
+
+  const DmxBuffer buffer(TEST_DATA);
+  const DmxBuffer buffer2(TEST_DATA2);
+  ola::TimeStamp start;
+  m_clock.CurrentTime(&start);
+  client.SendDMX(DmxUpdate(TEST_UNIVERSE, 100, buffer));
+  stub->AckAll();
+  client.SendDMX(DmxUpdate(TEST_UNIVERSE, 100, buffer));
+  stub->AckAll();
+  client.SendDMX(DmxUpdate(TEST_UNIVERSE, 100, buffer2));
+  OLA_ASSERT_EQ(static_cast<size_t>(1), stub->updates.size());
+  OLA_ASSERT_EQ(1u, client.CoalescedUpdates());
+
+  // The latest update is sent once the interval has passed.
+  ss.RegisterSingleTimeout(100, ola::NewSingleCallback(
+      &ss, &ola::io::SelectServer::Terminate));
+  ss.Run();
+  OLA_ASSERT_EQ(static_cast<size_t>(2), stub->updates.size());
+  OLA_ASSERT_EQ(string(TEST_DATA2), stub->updates[1].data());
+}
+
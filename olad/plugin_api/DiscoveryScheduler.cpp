@@ -0,0 +1,294 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * DiscoveryScheduler.cpp
+ * Runs RDM discovery across many ports, with a limit on concurrency.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include "olad/plugin_api/DiscoveryScheduler.h"
+
+#include <vector>
+
+#include "ola/ExportMap.h"
+#include "ola/Logging.h"
+#include "ola/stl/STLUtils.h"
+#include "olad/Port.h"
+
+namespace ola {
+
+using ola::rdm::RDMDiscoveryCallback;
+using ola::rdm::UIDSet;
+using std::vector;
+
+const unsigned int DiscoveryScheduler::DEFAULT_MAX_RUNNING = 16;
+const TimeInterval DiscoveryScheduler::INITIAL_BACKOFF(60, 0);
+
+const char DiscoveryScheduler::K_DISCOVERY_QUEUED_VAR[] =
+    "rdm-discovery-queued";
+const char DiscoveryScheduler::K_DISCOVERY_RUNNING_VAR[] =
+    "rdm-discovery-running";
+const char DiscoveryScheduler::K_DISCOVERY_RUNS_VAR[] = "rdm-discovery-runs";
+const char DiscoveryScheduler::K_DISCOVERY_CACHE_HITS_VAR[] =
+    "rdm-discovery-cache-hits";
+
+DiscoveryScheduler::DiscoveryScheduler(const Clock *clock,
+                                       ExportMap *export_map,
+                                       unsigned int max_running,
+                                       const TimeInterval &max_backoff)
+    : m_clock(clock),
+      m_max_running(max_running),
+      m_max_backoff(max_backoff),
+      m_starting_jobs(false),
+      m_queued_var(NULL),
+      m_running_var(NULL),
+      m_runs_var(NULL),
+      m_cache_hits_var(NULL) {
+  if (export_map) {
+    m_queued_var = export_map->GetIntegerVar(K_DISCOVERY_QUEUED_VAR);
+    m_running_var = export_map->GetIntegerVar(K_DISCOVERY_RUNNING_VAR);
+    m_runs_var = export_map->GetCounterVar(K_DISCOVERY_RUNS_VAR);
+    m_cache_hits_var = export_map->GetCounterVar(K_DISCOVERY_CACHE_HITS_VAR);
+  }
+}
+
+DiscoveryScheduler::~DiscoveryScheduler() {
+  JobQueue::iterator queue_iter = m_queue.begin();
+  for (; queue_iter != m_queue.end(); ++queue_iter) {
+    STLDeleteElements(&(*queue_iter)->callbacks);
+    delete *queue_iter;
+  }
+
+  RunningJobs::iterator running_iter = m_running.begin();
+  for (; running_iter != m_running.end(); ++running_iter) {
+    STLDeleteElements(&running_iter->second->callbacks);
+    delete running_iter->second;
+  }
+}
+
+void DiscoveryScheduler::Schedule(OutputPort *port,
+                                  DiscoveryType type,
+                                  RDMDiscoveryCallback *on_complete) {
+  if (type == PERIODIC_DISCOVERY && ServeFromCache(port)) {
+    // Copy the UIDs, since the callback may remove the port.
+    UIDSet uids = m_port_states[port].uids;
+    if (m_cache_hits_var) {
+      (*m_cache_hits_var)++;
+    }
+    on_complete->Run(uids);
+    return;
+  }
+
+  JobQueue::iterator iter = m_queue.begin();
+  for (; iter != m_queue.end(); ++iter) {
+    if ((*iter)->port == port) {
+      // Merge with the discovery that's already queued.
+      (*iter)->callbacks.push_back(on_complete);
+      (*iter)->full |= (type == FULL_DISCOVERY);
+      (*iter)->periodic &= (type == PERIODIC_DISCOVERY);
+      return;
+    }
+  }
+
+  DiscoveryJob *job = new DiscoveryJob();
+  job->port = port;
+  job->full = type == FULL_DISCOVERY;
+  job->periodic = type == PERIODIC_DISCOVERY;
+  job->callbacks.push_back(on_complete);
+  m_queue.push_back(job);
+  UpdateVariables();
+  ReportProgress(port);
+  StartJobs();
+}
+
+void DiscoveryScheduler::RemovePort(OutputPort *port) {
+  m_port_states.erase(port);
+
+  vector<DiscoveryJob*> removed_jobs;
+  JobQueue::iterator iter = m_queue.begin();
+  while (iter != m_queue.end()) {
+    if ((*iter)->port == port) {
+      removed_jobs.push_back(*iter);
+      iter = m_queue.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+
+  // If discovery is running, the result is ignored when it completes.
+  DiscoveryJob *running_job = STLLookupAndRemovePtr(&m_running, port);
+  if (running_job) {
+    removed_jobs.push_back(running_job);
+  }
+
+  UIDSet uids;
+  vector<DiscoveryJob*>::iterator job_iter = removed_jobs.begin();
+  for (; job_iter != removed_jobs.end(); ++job_iter) {
+    CompleteJob(*job_iter, uids);
+  }
+  UpdateVariables();
+  StartJobs();
+}
+
+/*
+ * Check if a port is backed off, and the cached result can be used.
+ */
+bool DiscoveryScheduler::ServeFromCache(OutputPort *port) {
+  const PortState *state = STLFind(&m_port_states, port);
+  if (!state || !state->backoff.InMilliSeconds()) {
+    return false;
+  }
+
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+  return now - state->last_run < state->backoff;
+}
+
+/*
+ * Start queued discovery until we hit the concurrency limit.
+ */
+void DiscoveryScheduler::StartJobs() {
+  // Discovery may complete before RunFullDiscovery() returns, so guard against
+  // recursion.
+  if (m_starting_jobs) {
+    return;
+  }
+  m_starting_jobs = true;
+
+  JobQueue::iterator iter = m_queue.begin();
+  while (iter != m_queue.end() &&
+         (!m_max_running || m_running.size() < m_max_running)) {
+    if (STLContains(m_running, (*iter)->port)) {
+      // Wait until the port has finished the current discovery.
+      ++iter;
+      continue;
+    }
+
+    DiscoveryJob *job = *iter;
+    m_queue.erase(iter);
+    StartJob(job);
+    // The callbacks may have changed the queue.
+    iter = m_queue.begin();
+  }
+  m_starting_jobs = false;
+  UpdateVariables();
+}
+
+void DiscoveryScheduler::StartJob(DiscoveryJob *job) {
+  m_running[job->port] = job;
+  if (m_runs_var) {
+    (*m_runs_var)++;
+  }
+  UpdateVariables();
+  ReportProgress(job->port);
+
+  RDMDiscoveryCallback *callback = NewSingleCallback(
+      this, &DiscoveryScheduler::PortComplete, job->port);
+  if (job->full) {
+    job->port->RunFullDiscovery(callback);
+  } else {
+    job->port->RunIncrementalDiscovery(callback);
+  }
+}
+
+/*
+ * Called when discovery completes on a port.
+ */
+void DiscoveryScheduler::PortComplete(OutputPort *port, const UIDSet &uids) {
+  DiscoveryJob *job = STLLookupAndRemovePtr(&m_running, port);
+  if (!job) {
+    // The port was removed while discovery was running.
+    return;
+  }
+
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+
+  bool unchanged = false;
+  PortStates::iterator state_iter = m_port_states.find(port);
+  if (state_iter == m_port_states.end()) {
+    state_iter = m_port_states.insert(
+        PortStates::value_type(port, PortState())).first;
+  } else {
+    unchanged = state_iter->second.uids == uids;
+  }
+
+  PortState *state = &state_iter->second;
+  if (job->periodic && unchanged && !m_max_backoff.IsZero()) {
+    if (state->backoff < INITIAL_BACKOFF) {
+      state->backoff = INITIAL_BACKOFF;
+    } else {
+      state->backoff = state->backoff * 2;
+    }
+    if (state->backoff > m_max_backoff) {
+      state->backoff = m_max_backoff;
+    }
+    OLA_DEBUG << "No RDM changes on port " << port->UniqueId()
+              << ", backing off for " << state->backoff;
+  } else {
+    state->backoff = TimeInterval();
+  }
+  state->uids = uids;
+  state->last_run = now;
+
+  CompleteJob(job, uids);
+  StartJobs();
+}
+
+/*
+ * Run the callbacks for a job, and delete it.
+ */
+void DiscoveryScheduler::CompleteJob(DiscoveryJob *job, const UIDSet &uids) {
+  ReportProgress(job->port);
+  DiscoveryCallbacks::iterator iter = job->callbacks.begin();
+  for (; iter != job->callbacks.end(); ++iter) {
+    (*iter)->Run(uids);
+  }
+  delete job;
+}
+
+/*
+ * Run the progress callback with the current state of a port. A port can have
+ * discovery queued while it's running, so running takes precedence.
+ */
+void DiscoveryScheduler::ReportProgress(OutputPort *port) {
+  if (!m_progress_callback.get()) {
+    return;
+  }
+
+  PortProgress progress = DISCOVERY_IDLE;
+  if (STLContains(m_running, port)) {
+    progress = DISCOVERY_RUNNING;
+  } else {
+    JobQueue::const_iterator iter = m_queue.begin();
+    for (; iter != m_queue.end(); ++iter) {
+      if ((*iter)->port == port) {
+        progress = DISCOVERY_QUEUED;
+        break;
+      }
+    }
+  }
+  m_progress_callback->Run(port, progress);
+}
+
+void DiscoveryScheduler::UpdateVariables() {
+  if (m_queued_var) {
+    m_queued_var->Set(m_queue.size());
+  }
+  if (m_running_var) {
+    m_running_var->Set(m_running.size());
+  }
+}
+}  // namespace ola
@@ -0,0 +1,208 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * DiscoveryScheduler.h
+ * Runs RDM discovery across many ports, with a limit on concurrency.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#ifndef OLAD_PLUGIN_API_DISCOVERYSCHEDULER_H_
+#define OLAD_PLUGIN_API_DISCOVERYSCHEDULER_H_
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "ola/Callback.h"
+#include "ola/Clock.h"
+#include "ola/base/Macro.h"
+#include "ola/rdm/RDMControllerInterface.h"
+#include "ola/rdm/UIDSet.h"
+
+namespace ola {
+
+class ExportMap;
+class OutputPort;
+
+/**
+ * @brief Schedules RDM discovery on output ports.
+ *
+ * Each port runs discovery independently of the others, so discovery for
+ * different ports, and different universes, is run in parallel. The number
+ * of ports running discovery at once is capped, and the rest are queued in
+ * the order they were requested.
+ *
+ * The result of the last run is cached for each port. If a maximum backoff is
+ * set, periodic discovery on a port that found no changes last time is backed
+ * off, up to the maximum, and while backed off the cached UIDs are returned
+ * without touching the port. Full discovery, incremental discovery requested
+ * by a client, or a change in the UIDs, resets the backoff. Backoff is
+ * disabled by default, since it delays periodic discovery beyond the
+ * configured interval, and until it's enabled the cache is never used.
+ *
+ * The progress of discovery on each port is reported to the
+ * ProgressCallback, which the UniverseStore uses to keep each universe's
+ * discovery state up to date for clients.
+ */
+class DiscoveryScheduler {
+ public:
+  enum DiscoveryType {
+    FULL_DISCOVERY,  /**< Run full discovery on the port. */
+    INCREMENTAL_DISCOVERY,  /**< Run incremental discovery on the port. */
+    /**
+     * Incremental discovery that may be answered from the cache if the port
+     * is backed off.
+     */
+    PERIODIC_DISCOVERY,
+  };
+
+  /**
+   * @brief The progress of discovery on a port.
+   */
+  enum PortProgress {
+    DISCOVERY_QUEUED,  /**< Discovery is waiting to start. */
+    DISCOVERY_RUNNING,  /**< Discovery is running. */
+    DISCOVERY_IDLE,  /**< Discovery completed, or was cancelled. */
+  };
+
+  /**
+   * @brief Called each time the progress of discovery on a port changes.
+   */
+  typedef ola::Callback2<void, OutputPort*, PortProgress> ProgressCallback;
+
+  /**
+   * @brief Create a new DiscoveryScheduler.
+   * @param clock the Clock to use for the backoff, ownership is not
+   *   transferred.
+   * @param export_map the ExportMap to use for stats, may be NULL.
+   * @param max_running the number of ports that can run discovery at once, 0
+   *   means no limit.
+   * @param max_backoff the longest periodic discovery on an unchanged port
+   *   can be backed off for, 0 disables backoff.
+   */
+  DiscoveryScheduler(const Clock *clock,
+                     ExportMap *export_map,
+                     unsigned int max_running = DEFAULT_MAX_RUNNING,
+                     const TimeInterval &max_backoff = TimeInterval());
+
+  /**
+   * @brief Destructor.
+   *
+   * The callbacks for any queued discovery are deleted without being run.
+   */
+  ~DiscoveryScheduler();
+
+  /**
+   * @brief Schedule discovery on a port.
+   * @param port the OutputPort to run discovery on.
+   * @param type the type of discovery to run.
+   * @param on_complete the callback to run when discovery completes on the
+   *   port, ownership is transferred.
+   *
+   * If the port already has discovery queued, the requests are merged, and a
+   * full discovery takes precedence over an incremental one. The callback may
+   * be run before this returns.
+   */
+  void Schedule(OutputPort *port,
+                DiscoveryType type,
+                ola::rdm::RDMDiscoveryCallback *on_complete);
+
+  /**
+   * @brief Stop tracking a port.
+   * @param port the OutputPort to remove.
+   *
+   * This is called when a port is removed from a universe. Queued or running
+   * discovery for the port completes with an empty UIDSet, and the cached
+   * result is discarded.
+   */
+  void RemovePort(OutputPort *port);
+
+  /**
+   * @brief The number of ports waiting to start discovery.
+   */
+  unsigned int QueuedCount() const { return m_queue.size(); }
+
+  /**
+   * @brief The number of ports running discovery.
+   */
+  unsigned int RunningCount() const { return m_running.size(); }
+
+  /**
+   * @brief Set the callback to run as the progress of discovery on a port
+   *   changes.
+   * @param callback the ProgressCallback to run, ownership is transferred.
+   *
+   * The callback is run when discovery is queued, before it starts on the
+   * port, and when it finishes, before the discovery callbacks are run.
+   */
+  void SetProgressCallback(ProgressCallback *callback) {
+    m_progress_callback.reset(callback);
+  }
+
+  static const unsigned int DEFAULT_MAX_RUNNING;
+  static const TimeInterval INITIAL_BACKOFF;
+
+ private:
+  typedef std::vector<ola::rdm::RDMDiscoveryCallback*> DiscoveryCallbacks;
+
+  struct DiscoveryJob {
+    OutputPort *port;
+    bool full;
+    bool periodic;  // true if all the requests were PERIODIC_DISCOVERY
+    DiscoveryCallbacks callbacks;
+  };
+
+  struct PortState {
+    ola::rdm::UIDSet uids;
+    TimeStamp last_run;
+    TimeInterval backoff;
+  };
+
+  typedef std::deque<DiscoveryJob*> JobQueue;
+  typedef std::map<OutputPort*, DiscoveryJob*> RunningJobs;
+  typedef std::map<OutputPort*, PortState> PortStates;
+
+  const Clock *m_clock;
+  const unsigned int m_max_running;
+  const TimeInterval m_max_backoff;
+  JobQueue m_queue;
+  RunningJobs m_running;
+  PortStates m_port_states;
+  bool m_starting_jobs;
+  std::auto_ptr<ProgressCallback> m_progress_callback;
+
+  class IntegerVariable *m_queued_var;
+  class IntegerVariable *m_running_var;
+  class CounterVariable *m_runs_var;
+  class CounterVariable *m_cache_hits_var;
+
+  bool ServeFromCache(OutputPort *port);
+  void StartJobs();
+  void StartJob(DiscoveryJob *job);
+  void PortComplete(OutputPort *port, const ola::rdm::UIDSet &uids);
+  void CompleteJob(DiscoveryJob *job, const ola::rdm::UIDSet &uids);
+  void ReportProgress(OutputPort *port);
+  void UpdateVariables();
+
+  static const char K_DISCOVERY_QUEUED_VAR[];
+  static const char K_DISCOVERY_RUNNING_VAR[];
+  static const char K_DISCOVERY_RUNS_VAR[];
+  static const char K_DISCOVERY_CACHE_HITS_VAR[];
+
+  DISALLOW_COPY_AND_ASSIGN(DiscoveryScheduler);
+};
+}  // namespace ola
+#endif  // OLAD_PLUGIN_API_DISCOVERYSCHEDULER_H_
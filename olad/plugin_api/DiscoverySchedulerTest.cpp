@@ -0,0 +1,458 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * DiscoverySchedulerTest.cpp
+ * Test fixture for the DiscoveryScheduler class.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <cppunit/extensions/HelperMacros.h>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "ola/Callback.h"
+#include "ola/Clock.h"
+#include "ola/ExportMap.h"
+#include "ola/rdm/UID.h"
+#include "ola/rdm/UIDSet.h"
+#include "ola/testing/TestUtils.h"
+#include "olad/Preferences.h"
+#include "olad/Universe.h"
+#include "olad/plugin_api/DiscoveryScheduler.h"
+#include "olad/plugin_api/TestCommon.h"
+#include "olad/plugin_api/UniverseStore.h"
+
+using ola::DiscoveryScheduler;
+using ola::ExportMap;
+using ola::MockClock;
+using ola::NewCallback;
+using ola::NewSingleCallback;
+using ola::OutputPort;
+using ola::TimeInterval;
+using ola::Universe;
+using ola::rdm::RDMDiscoveryCallback;
+using ola::rdm::UID;
+using ola::rdm::UIDSet;
+using std::pair;
+using std::vector;
+
+/*
+ * An OutputPort which holds on to the discovery callback until Complete() is
+ * called.
+ */
+class DeferredDiscoveryPort: public TestMockOutputPort {
+ public:
+  explicit DeferredDiscoveryPort(unsigned int port_id)
+      : TestMockOutputPort(NULL, port_id, false, true),
+        full_count(0),
+        incremental_count(0) {
+  }
+
+  void RunFullDiscovery(RDMDiscoveryCallback *on_complete) {
+    full_count++;
+    m_callback.reset(on_complete);
+  }
+
+  void RunIncrementalDiscovery(RDMDiscoveryCallback *on_complete) {
+    incremental_count++;
+    m_callback.reset(on_complete);
+  }
+
+  bool Running() const { return m_callback.get() != NULL; }
+
+  void Complete(const UIDSet &uids) {
+    RDMDiscoveryCallback *callback = m_callback.release();
+    callback->Run(uids);
+  }
+
+  unsigned int full_count;
+  unsigned int incremental_count;
+
+ private:
+  std::auto_ptr<RDMDiscoveryCallback> m_callback;
+};
+
+
+class DiscoverySchedulerTest: public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(DiscoverySchedulerTest);
+  CPPUNIT_TEST(testConcurrencyLimit);
+  CPPUNIT_TEST(testMergeRequests);
+  CPPUNIT_TEST(testNoBackoff);
+  CPPUNIT_TEST(testBackoff);
+  CPPUNIT_TEST(testRemovePort);
+  CPPUNIT_TEST(testProgress);
+  CPPUNIT_TEST(testUniverseProgress);
+  CPPUNIT_TEST_SUITE_END();
+
+ public:
+  DiscoverySchedulerTest()
+      : m_completed(0) {
+  }
+
+  void testConcurrencyLimit();
+  void testMergeRequests();
+  void testNoBackoff();
+  void testBackoff();
+  void testRemovePort();
+  void testProgress();
+  void testUniverseProgress();
+
+ private:
+  typedef vector<pair<OutputPort*, DiscoveryScheduler::PortProgress> >
+      ProgressList;
+
+  MockClock m_clock;
+  unsigned int m_completed;
+  UIDSet m_last_uids;
+  ProgressList m_progress;
+
+  void DiscoveryComplete(const UIDSet &uids) {
+    m_completed++;
+    m_last_uids = uids;
+  }
+
+  void Progress(OutputPort *port, DiscoveryScheduler::PortProgress progress) {
+    m_progress.push_back(std::make_pair(port, progress));
+  }
+
+  void CheckProgress(unsigned int line, OutputPort *port,
+                     DiscoveryScheduler::PortProgress progress) {
+    std::ostringstream str;
+    str << "Line " << line;
+    OLA_ASSERT_FALSE_MSG(m_progress.empty(), str.str());
+    OLA_ASSERT_EQ_MSG(port, m_progress.front().first, str.str());
+    OLA_ASSERT_EQ_MSG(progress, m_progress.front().second, str.str());
+    m_progress.erase(m_progress.begin());
+  }
+
+  RDMDiscoveryCallback *NewDiscoveryCallback() {
+    return NewSingleCallback(this, &DiscoverySchedulerTest::DiscoveryComplete);
+  }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(DiscoverySchedulerTest);
+
+
+/*
+ * Check that no more than max_running ports run discovery at once.
+ */
+void DiscoverySchedulerTest::testConcurrencyLimit() {
+  ExportMap export_map;
+  DiscoveryScheduler scheduler(&m_clock, &export_map, 2);
+
+  DeferredDiscoveryPort port1(1), port2(2), port3(3);
+  scheduler.Schedule(&port1, DiscoveryScheduler::FULL_DISCOVERY,
+                     NewDiscoveryCallback());
+  scheduler.Schedule(&port2, DiscoveryScheduler::INCREMENTAL_DISCOVERY,
+                     NewDiscoveryCallback());
+  scheduler.Schedule(&port3, DiscoveryScheduler::FULL_DISCOVERY,
+                     NewDiscoveryCallback());
+
+  OLA_ASSERT_TRUE(port1.Running());
+  OLA_ASSERT_TRUE(port2.Running());
+  OLA_ASSERT_FALSE(port3.Running());
+  OLA_ASSERT_EQ(1u, port1.full_count);
+  OLA_ASSERT_EQ(1u, port2.incremental_count);
+  OLA_ASSERT_EQ(2u, scheduler.RunningCount());
+  OLA_ASSERT_EQ(1u, scheduler.QueuedCount());
+  OLA_ASSERT_EQ(2, export_map.GetIntegerVar("rdm-discovery-running")->Get());
+  OLA_ASSERT_EQ(1, export_map.GetIntegerVar("rdm-discovery-queued")->Get());
+
+  // Completing a port starts the next one.
+  UIDSet uids;
+  uids.AddUID(UID(0x7a70, 1));
+  port2.Complete(uids);
+  OLA_ASSERT_EQ(1u, m_completed);
+  OLA_ASSERT_EQ(uids, m_last_uids);
+  OLA_ASSERT_TRUE(port3.Running());
+  OLA_ASSERT_EQ(2u, scheduler.RunningCount());
+  OLA_ASSERT_EQ(0u, scheduler.QueuedCount());
+
+  port1.Complete(UIDSet());
+  port3.Complete(UIDSet());
+  OLA_ASSERT_EQ(3u, m_completed);
+  OLA_ASSERT_EQ(0u, scheduler.RunningCount());
+  OLA_ASSERT_EQ(3u, export_map.GetCounterVar("rdm-discovery-runs")->Get());
+}
+
+
+/*
+ * Check that requests for a port that's already queued are merged.
+ */
+void DiscoverySchedulerTest::testMergeRequests() {
+  DiscoveryScheduler scheduler(&m_clock, NULL, 1);
+
+  DeferredDiscoveryPort port1(1), port2(2);
+  scheduler.Schedule(&port1, DiscoveryScheduler::INCREMENTAL_DISCOVERY,
+                     NewDiscoveryCallback());
+  scheduler.Schedule(&port2, DiscoveryScheduler::INCREMENTAL_DISCOVERY,
+                     NewDiscoveryCallback());
+  scheduler.Schedule(&port2, DiscoveryScheduler::FULL_DISCOVERY,
+                     NewDiscoveryCallback());
+  // port1 is running, so this is queued behind it.
+  scheduler.Schedule(&port1, DiscoveryScheduler::INCREMENTAL_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_EQ(1u, scheduler.RunningCount());
+  OLA_ASSERT_EQ(2u, scheduler.QueuedCount());
+
+  port1.Complete(UIDSet());
+  OLA_ASSERT_EQ(1u, m_completed);
+  // port2 runs a single full discovery for both requests.
+  OLA_ASSERT_TRUE(port2.Running());
+  OLA_ASSERT_EQ(1u, port2.full_count);
+  OLA_ASSERT_EQ(0u, port2.incremental_count);
+
+  port2.Complete(UIDSet());
+  OLA_ASSERT_EQ(3u, m_completed);
+  OLA_ASSERT_TRUE(port1.Running());
+  OLA_ASSERT_EQ(2u, port1.incremental_count);
+
+  port1.Complete(UIDSet());
+  OLA_ASSERT_EQ(4u, m_completed);
+  OLA_ASSERT_EQ(0u, scheduler.QueuedCount());
+  OLA_ASSERT_EQ(0u, scheduler.RunningCount());
+}
+
+
+/*
+ * Check that without a maximum backoff, periodic discovery always runs.
+ */
+void DiscoverySchedulerTest::testNoBackoff() {
+  ExportMap export_map;
+  DiscoveryScheduler scheduler(&m_clock, &export_map);
+
+  DeferredDiscoveryPort port(1);
+  UIDSet uids;
+  uids.AddUID(UID(0x7a70, 1));
+
+  for (unsigned int i = 0; i < 5; i++) {
+    scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                       NewDiscoveryCallback());
+    OLA_ASSERT_TRUE(port.Running());
+    port.Complete(uids);
+    m_clock.AdvanceTime(30, 0);
+  }
+  OLA_ASSERT_EQ(5u, port.incremental_count);
+  OLA_ASSERT_EQ(0u,
+                export_map.GetCounterVar("rdm-discovery-cache-hits")->Get());
+}
+
+
+/*
+ * Check that periodic discovery backs off when nothing changes.
+ */
+void DiscoverySchedulerTest::testBackoff() {
+  ExportMap export_map;
+  const TimeInterval max_backoff(300, 0);
+  DiscoveryScheduler scheduler(&m_clock, &export_map,
+                               DiscoveryScheduler::DEFAULT_MAX_RUNNING,
+                               max_backoff);
+
+  DeferredDiscoveryPort port(1);
+  UIDSet uids;
+  uids.AddUID(UID(0x7a70, 1));
+
+  // The first run has nothing to compare against, so the next one runs.
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  port.Complete(uids);
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_TRUE(port.Running());
+  port.Complete(uids);
+  OLA_ASSERT_EQ(2u, port.incremental_count);
+
+  // Nothing changed, so within the initial backoff the cached result is
+  // used.
+  m_clock.AdvanceTime(30, 0);
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_FALSE(port.Running());
+  OLA_ASSERT_EQ(3u, m_completed);
+  OLA_ASSERT_EQ(uids, m_last_uids);
+  OLA_ASSERT_EQ(2u, port.incremental_count);
+  OLA_ASSERT_EQ(1u,
+                export_map.GetCounterVar("rdm-discovery-cache-hits")->Get());
+
+  // Incremental discovery from a client always runs, and resets the backoff.
+  scheduler.Schedule(&port, DiscoveryScheduler::INCREMENTAL_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_TRUE(port.Running());
+  port.Complete(uids);
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_TRUE(port.Running());
+  port.Complete(uids);
+  OLA_ASSERT_EQ(4u, port.incremental_count);
+
+  // The backoff doubles each time nothing changes, but never exceeds the
+  // maximum.
+  m_clock.AdvanceTime(DiscoveryScheduler::INITIAL_BACKOFF);
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_TRUE(port.Running());
+  port.Complete(uids);
+  m_clock.AdvanceTime(DiscoveryScheduler::INITIAL_BACKOFF);
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_FALSE(port.Running());
+  m_clock.AdvanceTime(DiscoveryScheduler::INITIAL_BACKOFF);
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_TRUE(port.Running());
+  port.Complete(uids);
+
+  for (unsigned int i = 0; i < 5; i++) {
+    m_clock.AdvanceTime(max_backoff);
+    scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                       NewDiscoveryCallback());
+    OLA_ASSERT_TRUE(port.Running());
+    port.Complete(uids);
+  }
+
+  // A change resets the backoff.
+  m_clock.AdvanceTime(max_backoff);
+  uids.AddUID(UID(0x7a70, 2));
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  port.Complete(uids);
+  scheduler.Schedule(&port, DiscoveryScheduler::PERIODIC_DISCOVERY,
+                     NewDiscoveryCallback());
+  OLA_ASSERT_TRUE(port.Running());
+  port.Complete(uids);
+}
+
+
+/*
+ * Check that removing a port completes its discovery.
+ */
+void DiscoverySchedulerTest::testRemovePort() {
+  DiscoveryScheduler scheduler(&m_clock, NULL, 1);
+
+  DeferredDiscoveryPort port1(1), port2(2);
+  UIDSet uids;
+  uids.AddUID(UID(0x7a70, 1));
+
+  scheduler.Schedule(&port1, DiscoveryScheduler::FULL_DISCOVERY,
+                     NewDiscoveryCallback());
+  scheduler.Schedule(&port2, DiscoveryScheduler::FULL_DISCOVERY,
+                     NewDiscoveryCallback());
+
+  // Remove the queued port.
+  scheduler.RemovePort(&port2);
+  OLA_ASSERT_EQ(1u, m_completed);
+  OLA_ASSERT_EQ(0u, m_last_uids.Size());
+  OLA_ASSERT_EQ(0u, scheduler.QueuedCount());
+
+  // Remove the running port, the result is ignored when it arrives.
+  scheduler.RemovePort(&port1);
+  OLA_ASSERT_EQ(2u, m_completed);
+  OLA_ASSERT_EQ(0u, scheduler.RunningCount());
+  port1.Complete(uids);
+  OLA_ASSERT_EQ(2u, m_completed);
+  OLA_ASSERT_EQ(0u, m_last_uids.Size());
+}
+
+
+/*
+ * Check the progress callback is run as discovery is queued, started and
+ * completed on each port.
+ */
+void DiscoverySchedulerTest::testProgress() {
+  DiscoveryScheduler scheduler(&m_clock, NULL, 1);
+  scheduler.SetProgressCallback(
+      NewCallback(this, &DiscoverySchedulerTest::Progress));
+
+  DeferredDiscoveryPort port1(1), port2(2);
+  scheduler.Schedule(&port1, DiscoveryScheduler::FULL_DISCOVERY,
+                     NewDiscoveryCallback());
+  scheduler.Schedule(&port2, DiscoveryScheduler::FULL_DISCOVERY,
+                     NewDiscoveryCallback());
+  CheckProgress(__LINE__, &port1, DiscoveryScheduler::DISCOVERY_QUEUED);
+  CheckProgress(__LINE__, &port1, DiscoveryScheduler::DISCOVERY_RUNNING);
+  CheckProgress(__LINE__, &port2, DiscoveryScheduler::DISCOVERY_QUEUED);
+  OLA_ASSERT_TRUE(m_progress.empty());
+
+  // A request for a running port is queued behind it.
+  scheduler.Schedule(&port1, DiscoveryScheduler::INCREMENTAL_DISCOVERY,
+                     NewDiscoveryCallback());
+  CheckProgress(__LINE__, &port1, DiscoveryScheduler::DISCOVERY_RUNNING);
+
+  port1.Complete(UIDSet());
+  CheckProgress(__LINE__, &port1, DiscoveryScheduler::DISCOVERY_QUEUED);
+  CheckProgress(__LINE__, &port2, DiscoveryScheduler::DISCOVERY_RUNNING);
+  OLA_ASSERT_TRUE(m_progress.empty());
+
+  port2.Complete(UIDSet());
+  CheckProgress(__LINE__, &port2, DiscoveryScheduler::DISCOVERY_IDLE);
+  CheckProgress(__LINE__, &port1, DiscoveryScheduler::DISCOVERY_RUNNING);
+
+  // Removing a port cancels the discovery.
+  scheduler.RemovePort(&port1);
+  CheckProgress(__LINE__, &port1, DiscoveryScheduler::DISCOVERY_IDLE);
+  OLA_ASSERT_TRUE(m_progress.empty());
+  OLA_ASSERT_EQ(3u, m_completed);
+}
+
+
+/*
+ * Check the UniverseStore passes the progress to each universe.
+ */
+void DiscoverySchedulerTest::testUniverseProgress() {
+  ola::MemoryPreferences preferences("foo");
+  ola::UniverseStore store(&preferences, NULL, 1);
+  Universe *universe = store.GetUniverseOrCreate(1);
+  OLA_ASSERT_NOT_NULL(universe);
+
+  DeferredDiscoveryPort port1(1), port2(2);
+  port1.SetUniverse(universe);
+  port2.SetUniverse(universe);
+  universe->AddPort(&port1);
+  universe->AddPort(&port2);
+  OLA_ASSERT_EQ(0u, universe->RDMDiscoveryQueuedCount());
+  OLA_ASSERT_EQ(0u, universe->RDMDiscoveryRunningCount());
+
+  universe->RunRDMDiscovery(NewDiscoveryCallback(), true);
+  OLA_ASSERT_EQ(1u, universe->RDMDiscoveryQueuedCount());
+  OLA_ASSERT_EQ(1u, universe->RDMDiscoveryRunningCount());
+
+  UIDSet uids;
+  uids.AddUID(UID(0x7a70, 1));
+  if (port1.Running()) {
+    port1.Complete(uids);
+  } else {
+    port2.Complete(uids);
+  }
+  OLA_ASSERT_EQ(0u, universe->RDMDiscoveryQueuedCount());
+  OLA_ASSERT_EQ(1u, universe->RDMDiscoveryRunningCount());
+  // The UIDs from the first port are available before discovery completes.
+  OLA_ASSERT_EQ(1u, universe->UIDCount());
+  OLA_ASSERT_EQ(0u, m_completed);
+
+  if (port1.Running()) {
+    port1.Complete(UIDSet());
+  } else {
+    port2.Complete(UIDSet());
+  }
+  OLA_ASSERT_EQ(0u, universe->RDMDiscoveryQueuedCount());
+  OLA_ASSERT_EQ(0u, universe->RDMDiscoveryRunningCount());
+  OLA_ASSERT_EQ(1u, m_completed);
+  OLA_ASSERT_EQ(uids, m_last_uids);
+
+  universe->RemovePort(&port1);
+  universe->RemovePort(&port2);
+}
@@ -17,6 +17,8 @@ olad_plugin_api_libolaserverplugininterface_la_SOURCES = \
     olad/plugin_api/Device.cpp \
     olad/plugin_api/DeviceManager.cpp \
     olad/plugin_api/DeviceManager.h \
+    olad/plugin_api/DiscoveryScheduler.cpp \
+    olad/plugin_api/DiscoveryScheduler.h \
     olad/plugin_api/DmxSource.cpp \
     olad/plugin_api/Plugin.cpp \
     olad/plugin_api/PluginAdaptor.cpp \
@@ -40,6 +42,7 @@ olad_plugin_api_libolaserverplugininterface_la_LIBADD = \
 test_programs += \
     olad/plugin_api/ClientTester \
     olad/plugin_api/DeviceTester \
+    olad/plugin_api/DiscoverySchedulerTester \
     olad/plugin_api/DmxSourceTester \
     olad/plugin_api/PortTester \
     olad/plugin_api/PreferencesTester \
@@ -60,6 +63,12 @@ olad_plugin_api_DeviceTester_SOURCES = olad/plugin_api/DeviceManagerTest.cpp \
 olad_plugin_api_DeviceTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 olad_plugin_api_DeviceTester_LDADD = $(COMMON_OLAD_PLUGIN_API_TEST_LDADD)
 
+olad_plugin_api_DiscoverySchedulerTester_SOURCES = \
+    olad/plugin_api/DiscoverySchedulerTest.cpp
+olad_plugin_api_DiscoverySchedulerTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
+olad_plugin_api_DiscoverySchedulerTester_LDADD = \
+    $(COMMON_OLAD_PLUGIN_API_TEST_LDADD)
+
 olad_plugin_api_DmxSourceTester_SOURCES = olad/plugin_api/DmxSourceTest.cpp
 olad_plugin_api_DmxSourceTester_CXXFLAGS = $(COMMON_TESTING_FLAGS)
 olad_plugin_api_DmxSourceTester_LDADD = $(COMMON_OLAD_PLUGIN_API_TEST_LDADD)
@@ -30,6 +30,7 @@
  *   A list of sink clients, which we update whenever the DmxBuffer changes.
  */
 
+#include <string.h>
 #include <algorithm>
 #include <iterator>
 #include <map>
@@ -40,6 +41,7 @@
 #include <vector>
 
 #include "ola/base/Array.h"
+#include "ola/dmx/SlotKernels.h"
 #include "ola/Logging.h"
 #include "ola/MultiCallback.h"
 #include "ola/rdm/RDMCommand.h"
@@ -67,10 +69,13 @@ using std::string;
 using std::vector;
 
 const char Universe::K_UNIVERSE_UID_COUNT_VAR[] = "universe-uids";
+const char Universe::K_CHANGED_SLOTS_VAR[] = "universe-changed-slots";
 const char Universe::K_FPS_VAR[] = "universe-dmx-frames";
 const char Universe::K_MERGE_HTP_STR[] = "htp";
 const char Universe::K_MERGE_LTP_STR[] = "ltp";
+const char Universe::K_OUTPUT_PORT_LATENCY_VAR[] = "output-port-latency-us";
 const char Universe::K_UNIVERSE_INPUT_PORT_VAR[] = "universe-input-ports";
+const char Universe::K_UNIVERSE_LATENCY_VAR[] = "universe-latency-us";
 const char Universe::K_UNIVERSE_MODE_VAR[] = "universe-mode";
 const char Universe::K_UNIVERSE_NAME_VAR[] = "universe-name";
 const char Universe::K_UNIVERSE_OUTPUT_PORT_VAR[] = "universe-output-ports";
@@ -94,10 +99,19 @@ Universe::Universe(unsigned int universe_id, UniverseStore *store,
       m_merge_mode(Universe::MERGE_LTP),
       m_universe_store(store),
       m_export_map(export_map),
+      m_frame_counter(NULL),
+      m_changed_slot_counter(NULL),
+      m_rdm_request_counter(NULL),
+      m_latency(NULL),
       m_clock(clock),
       m_rdm_discovery_interval(),
       m_last_discovery_time(),
-      m_transaction_number_sequence() {
+      m_transaction_number_sequence(),
+      m_merge_length(0),
+      m_merge_state_valid(false),
+      m_last_frame_length(0),
+      m_last_frame_priority(0),
+      m_last_frame_valid(false) {
   ostringstream universe_id_str, universe_name_str;
   universe_id_str << universe_id;
   m_universe_id_str = universe_id_str.str();
@@ -108,10 +122,8 @@ Universe::Universe(unsigned int universe_id, UniverseStore *store,
   UpdateMode();
 
   const char *vars[] = {
-    K_FPS_VAR,
     K_UNIVERSE_INPUT_PORT_VAR,
     K_UNIVERSE_OUTPUT_PORT_VAR,
-    K_UNIVERSE_RDM_REQUESTS,
     K_UNIVERSE_SINK_CLIENTS_VAR,
     K_UNIVERSE_SOURCE_CLIENTS_VAR,
     K_UNIVERSE_UID_COUNT_VAR,
@@ -121,6 +133,14 @@ Universe::Universe(unsigned int universe_id, UniverseStore *store,
     for (unsigned int i = 0; i < arraysize(vars); ++i) {
       (*m_export_map->GetUIntMapVar(vars[i]))[m_universe_id_str] = 0;
     }
+    m_frame_counter = m_export_map->GetCounterMapVar(K_FPS_VAR)->Counter(
+        m_universe_id_str);
+    m_changed_slot_counter = m_export_map->GetCounterMapVar(
+        K_CHANGED_SLOTS_VAR)->Counter(m_universe_id_str);
+    m_rdm_request_counter = m_export_map->GetCounterMapVar(
+        K_UNIVERSE_RDM_REQUESTS)->Counter(m_universe_id_str);
+    m_latency = m_export_map->GetLatencyMapVar(K_UNIVERSE_LATENCY_VAR)->
+        Histogram(m_universe_id_str);
   }
 
   // We set the last discovery time to now, since most ports will trigger
@@ -139,10 +159,8 @@ Universe::~Universe() {
   };
 
   const char *uint_vars[] = {
-    K_FPS_VAR,
     K_UNIVERSE_INPUT_PORT_VAR,
     K_UNIVERSE_OUTPUT_PORT_VAR,
-    K_UNIVERSE_RDM_REQUESTS,
     K_UNIVERSE_SINK_CLIENTS_VAR,
     K_UNIVERSE_SOURCE_CLIENTS_VAR,
     K_UNIVERSE_UID_COUNT_VAR,
@@ -155,6 +173,20 @@ Universe::~Universe() {
     for (unsigned int i = 0; i < arraysize(uint_vars); ++i) {
       m_export_map->GetUIntMapVar(uint_vars[i])->Remove(m_universe_id_str);
     }
+    m_export_map->GetCounterMapVar(K_FPS_VAR)->Remove(m_universe_id_str);
+    m_export_map->GetCounterMapVar(K_CHANGED_SLOTS_VAR)->Remove(
+        m_universe_id_str);
+    m_export_map->GetCounterMapVar(K_UNIVERSE_RDM_REQUESTS)->Remove(
+        m_universe_id_str);
+    m_export_map->GetLatencyMapVar(K_UNIVERSE_LATENCY_VAR)->Remove(
+        m_universe_id_str);
+
+    LatencyHistogramMap *port_latency = m_export_map->GetLatencyMapVar(
+        K_OUTPUT_PORT_LATENCY_VAR);
+    PortLatencyMap::const_iterator iter = m_output_latency.begin();
+    for (; iter != m_output_latency.end(); ++iter) {
+      port_latency->Remove(iter->first->UniqueId());
+    }
   }
 }
 
@@ -181,6 +213,7 @@ void Universe::SetName(const string &name) {
  */
 void Universe::SetMergeMode(enum merge_mode merge_mode) {
   m_merge_mode = merge_mode;
+  m_merge_state_valid = false;
   UpdateMode();
 }
 
@@ -199,7 +232,19 @@ bool Universe::AddPort(InputPort *port) {
  * @param port the port to add
  */
 bool Universe::AddPort(OutputPort *port) {
-  return GenericAddPort(port, &m_output_ports);
+  if (!GenericAddPort(port, &m_output_ports)) {
+    return false;
+  }
+
+  // Make sure the new port is sent the next frame.
+  m_last_frame_valid = false;
+
+  // The histogram is removed again in RemovePort().
+  if (m_export_map && !STLContains(m_output_latency, port)) {
+    m_output_latency[port] = m_export_map->GetLatencyMapVar(
+        K_OUTPUT_PORT_LATENCY_VAR)->Histogram(port->UniqueId());
+  }
+  return true;
 }
 
 
@@ -209,6 +254,7 @@ bool Universe::AddPort(OutputPort *port) {
  * @return true if the port was removed, false if it didn't exist
  */
 bool Universe::RemovePort(InputPort *port) {
+  RemoveActiveSource(port, NULL);
   return GenericRemovePort(port, &m_input_ports);
 }
 
@@ -220,6 +266,15 @@ bool Universe::RemovePort(InputPort *port) {
  */
 bool Universe::RemovePort(OutputPort *port) {
   bool ret = GenericRemovePort(port, &m_output_ports, &m_output_uids);
+  if (ret && m_universe_store) {
+    m_universe_store->GetDiscoveryScheduler()->RemovePort(port);
+  }
+  RDMDiscoveryProgress(port, false, false);
+
+  if (m_export_map && STLRemove(&m_output_latency, port)) {
+    m_export_map->GetLatencyMapVar(K_OUTPUT_PORT_LATENCY_VAR)->Remove(
+        port->UniqueId());
+  }
 
   if (m_export_map) {
     (*m_export_map->GetUIntMapVar(K_UNIVERSE_UID_COUNT_VAR))[m_universe_id_str]
@@ -303,6 +358,7 @@ bool Universe::RemoveSourceClient(Client *client) {
     return false;
   }
 
+  RemoveActiveSource(NULL, client);
   SafeDecrement(K_UNIVERSE_SOURCE_CLIENTS_VAR);
 
   OLA_INFO << "Source client " << client << " has been removed from uni "
@@ -389,6 +445,7 @@ bool Universe::SetDMX(const DmxBuffer &buffer) {
     return true;
   }
   m_buffer.Set(buffer);
+  m_source_time = TimeStamp();
   return UpdateDependants();
 }
 
@@ -434,6 +491,7 @@ void Universe::CleanStaleSourceClients() {
   while (iter != m_source_clients.end()) {
     if (iter->second) {
       // if stale remove it
+      RemoveActiveSource(NULL, iter->first);
       m_source_clients.erase(iter++);
       SafeDecrement(K_UNIVERSE_SOURCE_CLIENTS_VAR);
       OLA_INFO << "Removed Stale Client";
@@ -464,7 +522,9 @@ void Universe::SendRDMRequest(RDMRequest *request_ptr,
            << ToHex(request->ParamId()) << ", PDL: "
            << request->ParamDataSize();
 
-  SafeIncrement(K_UNIVERSE_RDM_REQUESTS);
+  if (m_rdm_request_counter) {
+    (*m_rdm_request_counter)++;
+  }
 
   if (request->DestinationUID().IsBroadcast()) {
     if (m_output_ports.empty()) {
@@ -525,38 +585,17 @@ void Universe::RunRDMDiscovery(RDMDiscoveryCallback *on_complete, bool full) {
     OLA_INFO << "Incremental RDM discovery triggered for universe "
              << m_universe_id;
   }
+  StartRDMDiscovery(on_complete, full, false);
+}
 
-  m_clock->CurrentTime(&m_last_discovery_time);
-
-  // we need to make a copy of the ports first, because the callback may run at
-  // any time so we need to guard against the port list changing.
-  vector<OutputPort*> output_ports(m_output_ports.size());
-  copy(m_output_ports.begin(), m_output_ports.end(), output_ports.begin());
 
-  // the multicallback that indicates when discovery is done
-  BaseCallback0<void> *discovery_complete = NewMultiCallback(
-      output_ports.size(),
-      NewSingleCallback(this, &Universe::DiscoveryComplete, on_complete));
-
-  // Send Discovery requests to all ports, as each of these return they'll
-  // update the UID map. When all ports callbacks have run, the MultiCallback
-  // will trigger, running the DiscoveryCallback.
-  vector<OutputPort*>::iterator iter;
-  for (iter = output_ports.begin(); iter != output_ports.end(); ++iter) {
-    if (full) {
-      (*iter)->RunFullDiscovery(
-          NewSingleCallback(this,
-                            &Universe::PortDiscoveryComplete,
-                            discovery_complete,
-                            *iter));
-    } else {
-      (*iter)->RunIncrementalDiscovery(
-          NewSingleCallback(this,
-                            &Universe::PortDiscoveryComplete,
-                            discovery_complete,
-                            *iter));
-    }
-  }
+/*
+ * Trigger the periodic RDM discovery for this universe
+ */
+void Universe::RunPeriodicRDMDiscovery() {
+  OLA_DEBUG << "Periodic RDM discovery triggered for universe "
+            << m_universe_id;
+  StartRDMDiscovery(NULL, false, true);
 }
 
 
@@ -601,6 +640,25 @@ void Universe::GetUIDs(ola::rdm::UIDSet *uids) const {
 }
 
 
+/*
+ * Track which output ports are waiting for, or running, RDM discovery.
+ */
+void Universe::RDMDiscoveryProgress(OutputPort *port, bool queued,
+                                    bool running) {
+  if (queued) {
+    m_discovery_queued.insert(port);
+  } else {
+    m_discovery_queued.erase(port);
+  }
+
+  if (running) {
+    m_discovery_running.insert(port);
+  } else {
+    m_discovery_running.erase(port);
+  }
+}
+
+
 /**
  * Return the number of uids in the universe
  */
@@ -615,6 +673,15 @@ uint8_t Universe::GetRDMTransactionNumber() {
   return m_transaction_number_sequence.Next();
 }
 
+/*
+ * Return the latency histogram for an output port.
+ */
+const LatencyHistogram *Universe::OutputPortLatency(
+    const OutputPort *port) const {
+  return STLFindOrNull(m_output_latency, port);
+}
+
+
 /*
  * Return true if this universe is in use (has at least one port or client).
  */
@@ -637,23 +704,83 @@ bool Universe::UpdateDependants() {
   vector<OutputPort*>::const_iterator iter;
   set<Client*>::const_iterator client_iter;
 
+  // Latency is only tracked if we know when the data arrived.
+  bool track_latency = m_latency && m_source_time.IsSet();
+  TimeStamp now;
+  bool frame_changed = UpdateLastFrame();
+
   // write to all ports assigned to this universe
   for (iter = m_output_ports.begin(); iter != m_output_ports.end(); ++iter) {
+    if (!frame_changed && (*iter)->RepeatsLastFrame()) {
+      continue;
+    }
     (*iter)->WriteDMX(m_buffer, m_active_priority);
+    if (track_latency) {
+      LatencyHistogram *port_latency = STLFindOrNull(m_output_latency, *iter);
+      if (port_latency) {
+        m_clock->CurrentTime(&now);
+        port_latency->Record((now - m_source_time).AsInt());
+      }
+    }
   }
 
-  // write to all clients
-  for (client_iter = m_sink_clients.begin();
-       client_iter != m_sink_clients.end();
-       ++client_iter) {
-    (*client_iter)->SendDMX(m_universe_id, m_active_priority, m_buffer);
+  if (track_latency) {
+    // If there are no output ports this is the time taken to merge.
+    if (m_output_ports.empty()) {
+      m_clock->CurrentTime(&now);
+    }
+    m_latency->Record((now - m_source_time).AsInt());
+    m_source_time = TimeStamp();
   }
 
-  SafeIncrement(K_FPS_VAR);
+  // write to all clients, they share the update so it's only serialized once
+  if (!m_sink_clients.empty()) {
+    const DmxUpdate update(m_universe_id, m_active_priority, m_buffer);
+    for (client_iter = m_sink_clients.begin();
+         client_iter != m_sink_clients.end();
+         ++client_iter) {
+      (*client_iter)->SendDMX(update);
+    }
+  }
+
+  if (m_frame_counter) {
+    (*m_frame_counter)++;
+  }
   return true;
 }
 
 
+/*
+ * Compare the merged data with the last frame, and then save it as the last
+ * frame.
+ * @return true if the data or priority changed.
+ */
+bool Universe::UpdateLastFrame() {
+  const unsigned int length = m_buffer.Size();
+  const unsigned int common_length = std::min(length, m_last_frame_length);
+
+  uint8_t bitmap[(DMX_UNIVERSE_SIZE + 7) / 8];
+  unsigned int changed_slots = ola::dmx::ChangedSlotBitmap(
+      m_last_frame, m_buffer.GetRaw(), bitmap, common_length);
+  // Slots which were added or removed count as changed.
+  changed_slots += std::max(length, m_last_frame_length) - common_length;
+
+  bool changed = (!m_last_frame_valid || changed_slots ||
+                  m_last_frame_priority != m_active_priority);
+  if (m_changed_slot_counter) {
+    (*m_changed_slot_counter) += changed_slots;
+  }
+
+  if (length) {
+    memcpy(m_last_frame, m_buffer.GetRaw(), length);
+  }
+  m_last_frame_length = length;
+  m_last_frame_priority = m_active_priority;
+  m_last_frame_valid = true;
+  return changed;
+}
+
+
 /*
  * Update the name in the export map.
  */
@@ -680,16 +807,92 @@ void Universe::UpdateMode() {
 
 
 /*
- * HTP Merge all sources (clients/ports)
- * @pre sources.size >= 2
- * @param sources the list of DmxSources to merge
+ * HTP Merge all active sources from scratch, this rebuilds the per-slot owner
+ * map.
+ * @pre m_active_data holds the data for each of the active sources.
  */
-void Universe::HTPMergeSources(const vector<DmxSource> &sources) {
-  vector<DmxSource>::const_iterator iter;
-  m_buffer.Reset();
+void Universe::HTPMergeSources() {
+  // clear() keeps the capacity, so these only allocate if a new source
+  // appears.
+  vector<const uint8_t*> &sources = m_merge_sources;
+  vector<unsigned int> &lengths = m_merge_lengths;
+  sources.clear();
+  lengths.clear();
+  vector<DmxSource>::const_iterator iter = m_active_data.begin();
+  for (; iter != m_active_data.end(); ++iter) {
+    sources.push_back(iter->Data().GetRaw());
+    lengths.push_back(iter->Data().Size());
+  }
+  if (sources.empty()) {
+    m_merge_length = 0;
+    m_merge_state_valid = true;
+    return;
+  }
 
-  for (iter = sources.begin(); iter != sources.end(); ++iter) {
-    m_buffer.HTPMerge(iter->Data());
+  m_merge_length = ola::dmx::MaxSlotsMany(m_merge_data, &sources[0],
+                                          &lengths[0], sources.size());
+  m_merge_state_valid = m_active_data.size() <= MAX_TRACKED_SOURCES;
+  if (!m_merge_state_valid) {
+    return;
+  }
+
+  // The owner of a slot is the first source with the merged value, walk the
+  // sources backwards so earlier ones win.
+  memset(m_slot_owner, 0, sizeof(m_slot_owner));
+  for (unsigned int i = sources.size(); i-- > 0;) {
+    for (unsigned int slot = 0; slot < lengths[i]; slot++) {
+      if (sources[i][slot] == m_merge_data[slot]) {
+        m_slot_owner[slot] = i;
+      }
+    }
+  }
+}
+
+
+/*
+ * Update the HTP merge result with new data from a single source.
+ *
+ * Each slot remembers which source provided its current value. If the new
+ * value is at least the current one the source takes ownership of the slot.
+ * Only if the owner lowers its value do we need to look at the other sources
+ * for that slot.
+ * @param index the index of the source in m_active_data that changed.
+ * @pre m_merge_state_valid is true.
+ */
+void Universe::HTPMergeSource(unsigned int index) {
+  const DmxBuffer &data = m_active_data[index].Data();
+  const uint8_t *slots = data.GetRaw();
+  unsigned int length = data.Size();
+
+  if (length > m_merge_length) {
+    memset(m_merge_data + m_merge_length, 0, length - m_merge_length);
+    memset(m_slot_owner + m_merge_length, index, length - m_merge_length);
+  }
+  unsigned int old_length = std::max(length, m_merge_length);
+
+  for (unsigned int slot = 0; slot < old_length; slot++) {
+    uint8_t value = slot < length ? slots[slot] : 0;
+    if (value >= m_merge_data[slot]) {
+      m_merge_data[slot] = value;
+      m_slot_owner[slot] = index;
+    } else if (m_slot_owner[slot] == index) {
+      // the owner went down, find the new highest value
+      m_merge_data[slot] = value;
+      for (unsigned int i = 0; i < m_active_data.size(); i++) {
+        const DmxBuffer &other = m_active_data[i].Data();
+        if (slot < other.Size() && other.GetRaw()[slot] > m_merge_data[slot]) {
+          m_merge_data[slot] = other.GetRaw()[slot];
+          m_slot_owner[slot] = i;
+        }
+      }
+    }
+  }
+
+  // the merged length is the longest of the active sources
+  m_merge_length = 0;
+  vector<DmxSource>::const_iterator iter = m_active_data.begin();
+  for (; iter != m_active_data.end(); ++iter) {
+    m_merge_length = std::max(m_merge_length, iter->Data().Size());
   }
 }
 
@@ -698,105 +901,214 @@ void Universe::HTPMergeSources(const vector<DmxSource> &sources) {
  * Merge all port/client sources.
  * This does a priority based merge as documented at:
  * https://wiki.openlighting.org/index.php/OLA_Merging_Algorithms
+ *
+ * Rather than scanning every port and client on each frame, we track the set
+ * of sources at the active priority. A source below the active priority can
+ * be dropped without looking at anything else, and we only rescan all sources
+ * once every source at the active priority has gone away.
  * @param port the input port that changed or NULL
  * @param client the client that changed or NULL
  * @returns true if the data for this universe changed, false otherwise
  */
 bool Universe::MergeAll(const InputPort *port, const Client *client) {
-  vector<DmxSource> active_sources;
+  TimeStamp now;
+  m_clock->CurrentTime(&now);
+
+  merge_source changed = {port, client};
+  DmxSource changed_source = MergeSourceData(changed);
+  bool changed_source_is_live = (changed_source.IsSet() &&
+                                 changed_source.IsActive(now) &&
+                                 changed_source.Data().Size());
+
+  // This also drops the changed source if it has left the active priority.
+  PruneActiveSources(now);
+  int index = FindActiveSource(port, client);
+
+  if (m_active_sources.empty()) {
+    RebuildActiveSources(now);
+    index = FindActiveSource(port, client);
+  } else if (changed_source_is_live) {
+    if (changed_source.Priority() > m_active_priority) {
+      m_active_sources.clear();
+      m_active_data.clear();
+      m_active_priority = changed_source.Priority();
+      m_merge_state_valid = false;
+    }
+
+    if (changed_source.Priority() == m_active_priority && index < 0) {
+      m_active_sources.push_back(changed);
+      m_active_data.push_back(changed_source);
+      index = m_active_sources.size() - 1;
+      if (m_active_sources.size() > MAX_TRACKED_SOURCES) {
+        m_merge_state_valid = false;
+      }
+    } else if (index >= 0) {
+      m_active_data[index] = changed_source;
+    }
+  }
+
+  if (m_active_sources.empty()) {
+    OLA_WARN << "Something changed but we didn't find any active sources "
+             << " for universe " << UniverseId();
+    return false;
+  }
+
+  if (index < 0) {
+    // this source didn't have any effect, skip
+    return false;
+  }
+
+  m_source_time = changed_source.Timestamp();
+
+  // only one source at the active priority
+  if (m_active_sources.size() == 1) {
+    m_buffer.Set(m_active_data[0].Data());
+    m_merge_state_valid = false;
+  } else {
+    // multi source merge
+    if (m_merge_mode == Universe::MERGE_LTP) {
+      // check that the current port/client is newer than all other active
+      // sources
+      vector<DmxSource>::const_iterator source_iter = m_active_data.begin();
+      for (; source_iter != m_active_data.end(); source_iter++) {
+        if (changed_source.Timestamp() < source_iter->Timestamp()) {
+          return false;
+        }
+      }
+      // if we made it to here this is the newest source
+      m_buffer.Set(changed_source.Data());
+    } else {
+      if (m_merge_state_valid) {
+        HTPMergeSource(index);
+      } else {
+        HTPMergeSources();
+      }
+      m_buffer.Set(m_merge_data, m_merge_length);
+    }
+  }
+  return true;
+}
+
+
+/*
+ * Return the current data for a source.
+ */
+DmxSource Universe::MergeSourceData(const merge_source &source) const {
+  if (source.port) {
+    return source.port->SourceData();
+  }
+  return source.client->SourceData(UniverseId());
+}
+
+
+/*
+ * Refresh the data for the active sources, and drop any that have timed out
+ * or are no longer at the active priority.
+ * @param now the current time
+ */
+void Universe::PruneActiveSources(const TimeStamp &now) {
+  bool removed = false;
+  unsigned int i = 0;
+  while (i < m_active_sources.size()) {
+    m_active_data[i] = MergeSourceData(m_active_sources[i]);
+    const DmxSource &source = m_active_data[i];
+    if (source.IsSet() && source.IsActive(now) && source.Data().Size() &&
+        source.Priority() == m_active_priority) {
+      i++;
+    } else {
+      m_active_sources.erase(m_active_sources.begin() + i);
+      m_active_data.erase(m_active_data.begin() + i);
+      removed = true;
+    }
+  }
+  if (removed) {
+    m_merge_state_valid = false;
+  }
+}
 
-  vector<InputPort*>::const_iterator iter;
-  SourceClientMap::const_iterator client_iter;
 
+/*
+ * Scan all ports and clients for the highest priority active sources.
+ * @param now the current time
+ */
+void Universe::RebuildActiveSources(const TimeStamp &now) {
+  m_active_sources.clear();
+  m_active_data.clear();
   m_active_priority = ola::dmx::SOURCE_PRIORITY_MIN;
-  TimeStamp now;
-  m_clock->CurrentTime(&now);
-  bool changed_source_is_active = false;
+  m_merge_state_valid = false;
 
   // Find the highest active ports
-  for (iter = m_input_ports.begin(); iter != m_input_ports.end(); ++iter) {
-    DmxSource source = (*iter)->SourceData();
+  vector<InputPort*>::const_iterator iter = m_input_ports.begin();
+  for (; iter != m_input_ports.end(); ++iter) {
+    const DmxSource &source = (*iter)->SourceData();
     if (!source.IsSet() || !source.IsActive(now) || !source.Data().Size()) {
       continue;
     }
 
     if (source.Priority() > m_active_priority) {
-      changed_source_is_active = false;
-      active_sources.clear();
+      m_active_sources.clear();
+      m_active_data.clear();
       m_active_priority = source.Priority();
     }
 
     if (source.Priority() == m_active_priority) {
-      active_sources.push_back(source);
-      if (*iter == port) {
-        changed_source_is_active = true;
-      }
+      merge_source active = {*iter, NULL};
+      m_active_sources.push_back(active);
+      m_active_data.push_back(source);
     }
   }
 
   // find the highest priority active clients
-  for (client_iter = m_source_clients.begin();
-       client_iter != m_source_clients.end();
-       ++client_iter) {
-    const DmxSource &source = client_iter->first->SourceData(UniverseId());
-
+  SourceClientMap::const_iterator client_iter = m_source_clients.begin();
+  for (; client_iter != m_source_clients.end(); ++client_iter) {
+    const DmxSource source = client_iter->first->SourceData(UniverseId());
     if (!source.IsSet() || !source.IsActive(now) || !source.Data().Size()) {
       continue;
     }
 
     if (source.Priority() > m_active_priority) {
-      changed_source_is_active = false;
-      active_sources.clear();
+      m_active_sources.clear();
+      m_active_data.clear();
       m_active_priority = source.Priority();
     }
 
     if (source.Priority() == m_active_priority) {
-      active_sources.push_back(source);
-      if (client_iter->first == client) {
-        changed_source_is_active = true;
-      }
+      merge_source active = {NULL, client_iter->first};
+      m_active_sources.push_back(active);
+      m_active_data.push_back(source);
     }
   }
+}
 
-  if (active_sources.empty()) {
-    OLA_WARN << "Something changed but we didn't find any active sources "
-             << " for universe " << UniverseId();
-    return false;
-  }
 
-  if (!changed_source_is_active) {
-    // this source didn't have any effect, skip
-    return false;
+/*
+ * Find a source in the active set.
+ * @returns the index of the source, or -1 if it isn't active.
+ */
+int Universe::FindActiveSource(const InputPort *port,
+                               const Client *client) const {
+  for (unsigned int i = 0; i < m_active_sources.size(); i++) {
+    if (m_active_sources[i].port == port &&
+        m_active_sources[i].client == client) {
+      return i;
+    }
   }
+  return -1;
+}
 
-  // only one source at the active priority
-  if (active_sources.size() == 1) {
-    m_buffer.Set(active_sources[0].Data());
-  } else {
-    // multi source merge
-    if (m_merge_mode == Universe::MERGE_LTP) {
-      vector<DmxSource>::const_iterator source_iter = active_sources.begin();
-      DmxSource changed_source;
-      if (port) {
-        changed_source = port->SourceData();
-      } else {
-        changed_source = client->SourceData(UniverseId());
-      }
 
-      // check that the current port/client is newer than all other active
-      // sources
-      for (; source_iter != active_sources.end(); source_iter++) {
-        if (changed_source.Timestamp() < source_iter->Timestamp()) {
-          return false;
-        }
-      }
-      // if we made it to here this is the newest source
-      m_buffer.Set(changed_source.Data());
-    } else {
-      HTPMergeSources(active_sources);
-    }
+/*
+ * Remove a source from the active set, if it's present.
+ */
+void Universe::RemoveActiveSource(const InputPort *port,
+                                  const Client *client) {
+  int index = FindActiveSource(port, client);
+  if (index < 0) {
+    return;
   }
-  return true;
+  m_active_sources.erase(m_active_sources.begin() + index);
+  m_active_data.erase(m_active_data.begin() + index);
+  m_merge_state_valid = false;
 }
 
 
@@ -823,6 +1135,49 @@ void Universe::DiscoveryComplete(RDMDiscoveryCallback *on_complete) {
 }
 
 
+/**
+ * Start discovery on each of the output ports.
+ */
+void Universe::StartRDMDiscovery(RDMDiscoveryCallback *on_complete,
+                                 bool full,
+                                 bool periodic) {
+  m_clock->CurrentTime(&m_last_discovery_time);
+
+  // we need to make a copy of the ports first, because the callback may run at
+  // any time so we need to guard against the port list changing.
+  vector<OutputPort*> output_ports(m_output_ports.size());
+  copy(m_output_ports.begin(), m_output_ports.end(), output_ports.begin());
+
+  // the multicallback that indicates when discovery is done
+  BaseCallback0<void> *discovery_complete = NewMultiCallback(
+      output_ports.size(),
+      NewSingleCallback(this, &Universe::DiscoveryComplete, on_complete));
+
+  DiscoveryScheduler::DiscoveryType type = DiscoveryScheduler::FULL_DISCOVERY;
+  if (!full) {
+    type = periodic ? DiscoveryScheduler::PERIODIC_DISCOVERY :
+        DiscoveryScheduler::INCREMENTAL_DISCOVERY;
+  }
+
+  // Hand the ports to the DiscoveryScheduler, as each of these return they'll
+  // update the UID map. When all ports callbacks have run, the MultiCallback
+  // will trigger, running the DiscoveryCallback.
+  vector<OutputPort*>::iterator iter;
+  for (iter = output_ports.begin(); iter != output_ports.end(); ++iter) {
+    RDMDiscoveryCallback *port_complete = NewSingleCallback(
+        this, &Universe::PortDiscoveryComplete, discovery_complete, *iter);
+    if (m_universe_store) {
+      m_universe_store->GetDiscoveryScheduler()->Schedule(
+          *iter, type, port_complete);
+    } else if (full) {
+      (*iter)->RunFullDiscovery(port_complete);
+    } else {
+      (*iter)->RunIncrementalDiscovery(port_complete);
+    }
+  }
+}
+
+
 /**
  * Track fan-out responses for a broadcast request.
  * This increments the port counter until we reach the expected value, and
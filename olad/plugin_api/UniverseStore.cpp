@@ -28,10 +28,12 @@
 #include <utility>
 #include <vector>
 
+#include "ola/Callback.h"
 #include "ola/ExportMap.h"
 #include "ola/Logging.h"
 #include "ola/StringUtils.h"
 #include "ola/stl/STLUtils.h"
+#include "olad/Port.h"
 #include "olad/Preferences.h"
 #include "olad/Universe.h"
 
@@ -45,15 +47,29 @@ using std::vector;
 const unsigned int UniverseStore::MINIMUM_RDM_DISCOVERY_INTERVAL = 30;
 
 UniverseStore::UniverseStore(Preferences *preferences,
-                             ExportMap *export_map)
+                             ExportMap *export_map,
+                             unsigned int discovery_concurrency,
+                             const TimeInterval &discovery_max_backoff)
     : m_preferences(preferences),
-      m_export_map(export_map) {
+      m_export_map(export_map),
+      m_discovery_scheduler(&m_clock, export_map, discovery_concurrency,
+                            discovery_max_backoff) {
+  m_discovery_scheduler.SetProgressCallback(
+      NewCallback(this, &UniverseStore::PortDiscoveryProgress));
+
   if (export_map) {
     export_map->GetStringMapVar(Universe::K_UNIVERSE_NAME_VAR, "universe");
     export_map->GetStringMapVar(Universe::K_UNIVERSE_MODE_VAR, "universe");
 
+    export_map->GetCounterMapVar(Universe::K_FPS_VAR, "universe");
+    export_map->GetCounterMapVar(Universe::K_CHANGED_SLOTS_VAR, "universe");
+    export_map->GetCounterMapVar(Universe::K_UNIVERSE_RDM_REQUESTS,
+                                 "universe");
+    export_map->GetLatencyMapVar(Universe::K_UNIVERSE_LATENCY_VAR,
+                                 "universe");
+    export_map->GetLatencyMapVar(Universe::K_OUTPUT_PORT_LATENCY_VAR, "port");
+
     const char *vars[] = {
-      Universe::K_FPS_VAR,
       Universe::K_UNIVERSE_INPUT_PORT_VAR,
       Universe::K_UNIVERSE_OUTPUT_PORT_VAR,
       Universe::K_UNIVERSE_SINK_CLIENTS_VAR,
@@ -128,6 +144,22 @@ void UniverseStore::GarbageCollectUniverses() {
 }
 
 
+/*
+ * Pass the progress of discovery on a port to the port's universe.
+ */
+void UniverseStore::PortDiscoveryProgress(
+    OutputPort *port,
+    DiscoveryScheduler::PortProgress progress) {
+  Universe *universe = port->GetUniverse();
+  if (universe) {
+    universe->RDMDiscoveryProgress(
+        port,
+        progress == DiscoveryScheduler::DISCOVERY_QUEUED,
+        progress == DiscoveryScheduler::DISCOVERY_RUNNING);
+  }
+}
+
+
 /*
  * Restore a universe's settings
  * @param uni  the universe to update
@@ -28,6 +28,7 @@
 
 #include "ola/Clock.h"
 #include "ola/base/Macro.h"
+#include "olad/plugin_api/DiscoveryScheduler.h"
 
 namespace ola {
 
@@ -42,8 +43,15 @@ class UniverseStore {
    * @brief Create a new UniverseStore.
    * @param preferences The Preferences store.
    * @param export_map the ExportMap to use for stats, may be NULL.
+   * @param discovery_concurrency the number of ports that can run RDM
+   *   discovery at once, 0 means no limit.
+   * @param discovery_max_backoff the longest periodic RDM discovery can be
+   *   backed off for when nothing changes, 0 disables backoff.
    */
-  UniverseStore(class Preferences *preferences, class ExportMap *export_map);
+  UniverseStore(class Preferences *preferences, class ExportMap *export_map,
+                unsigned int discovery_concurrency =
+                    DiscoveryScheduler::DEFAULT_MAX_RUNNING,
+                const TimeInterval &discovery_max_backoff = TimeInterval());
 
   /**
    * @brief Destructor.
@@ -92,6 +100,13 @@ class UniverseStore {
    */
   void GarbageCollectUniverses();
 
+  /**
+   * @brief The DiscoveryScheduler used to run RDM discovery on the ports.
+   */
+  DiscoveryScheduler *GetDiscoveryScheduler() {
+    return &m_discovery_scheduler;
+  }
+
  private:
   typedef std::map<unsigned int, Universe*> UniverseMap;
 
@@ -101,7 +116,10 @@ class UniverseStore {
   std::set<Universe*> m_deletion_candiates;  // list of universes we may be
                                              // able to delete
   Clock m_clock;
+  DiscoveryScheduler m_discovery_scheduler;
 
+  void PortDiscoveryProgress(OutputPort *port,
+                             DiscoveryScheduler::PortProgress progress);
   bool RestoreUniverseSettings(Universe *universe) const;
   bool SaveUniverseSettings(Universe *universe) const;
 
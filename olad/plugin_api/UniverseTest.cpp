@@ -27,6 +27,7 @@
 #include "ola/Constants.h"
 #include "ola/Clock.h"
 #include "ola/DmxBuffer.h"
+#include "ola/ExportMap.h"
 #include "ola/rdm/RDMCommand.h"
 #include "ola/rdm/RDMReply.h"
 #include "ola/rdm/RDMResponseCodes.h"
@@ -47,8 +48,11 @@
 using ola::AbstractDevice;
 using ola::Clock;
 using ola::DmxBuffer;
+using ola::ExportMap;
+using ola::LatencyHistogram;
 using ola::NewCallback;
 using ola::NewSingleCallback;
+using ola::TimeInterval;
 using ola::TimeStamp;
 using ola::Universe;
 using ola::rdm::NewDiscoveryUniqueBranchRequest;
@@ -71,11 +75,13 @@ class UniverseTest: public CppUnit::TestFixture {
   CPPUNIT_TEST(testLifecycle);
   CPPUNIT_TEST(testSetGetDmx);
   CPPUNIT_TEST(testSendDmx);
+  CPPUNIT_TEST(testUnchangedFrames);
   CPPUNIT_TEST(testReceiveDmx);
   CPPUNIT_TEST(testSourceClients);
   CPPUNIT_TEST(testSinkClients);
   CPPUNIT_TEST(testLtpMerging);
   CPPUNIT_TEST(testHtpMerging);
+  CPPUNIT_TEST(testLatency);
   CPPUNIT_TEST(testRDMDiscovery);
   CPPUNIT_TEST(testRDMSend);
   CPPUNIT_TEST_SUITE_END();
@@ -86,11 +92,13 @@ class UniverseTest: public CppUnit::TestFixture {
   void testLifecycle();
   void testSetGetDmx();
   void testSendDmx();
+  void testUnchangedFrames();
   void testReceiveDmx();
   void testSourceClients();
   void testSinkClients();
   void testLtpMerging();
   void testHtpMerging();
+  void testLatency();
   void testRDMDiscovery();
   void testRDMSend();
 
@@ -123,11 +131,10 @@ class MockClient: public ola::Client {
         m_dmx_set(false) {
   }
 
-  bool SendDMX(unsigned int universe_id, uint8_t priority,
-               const DmxBuffer &buffer) {
-    OLA_ASSERT_EQ(TEST_UNIVERSE, universe_id);
-    OLA_ASSERT_EQ(ola::dmx::SOURCE_PRIORITY_MIN, priority);
-    OLA_ASSERT_EQ(string(TEST_DATA), buffer.Get());
+  bool SendDMX(const ola::DmxUpdate &update) {
+    OLA_ASSERT_EQ(TEST_UNIVERSE, update.Universe());
+    OLA_ASSERT_EQ(ola::dmx::SOURCE_PRIORITY_MIN, update.Priority());
+    OLA_ASSERT_EQ(string(TEST_DATA), update.Data().Get());
     m_dmx_set = true;
     return true;
   }
@@ -135,6 +142,27 @@ class MockClient: public ola::Client {
 };
 
 
+/*
+ * An output port which repeats the last frame, and counts the writes.
+ */
+class RepeatingOutputPort: public TestMockOutputPort {
+ public:
+  RepeatingOutputPort(ola::AbstractDevice *parent, unsigned int port_id)
+      : TestMockOutputPort(parent, port_id),
+        writes(0) {
+  }
+
+  bool WriteDMX(const ola::DmxBuffer &buffer, uint8_t priority) {
+    writes++;
+    return TestMockOutputPort::WriteDMX(buffer, priority);
+  }
+
+  bool RepeatsLastFrame() const { return true; }
+
+  unsigned int writes;
+};
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(UniverseTest);
 
 
@@ -233,6 +261,64 @@ void UniverseTest::testSendDmx() {
 }
 
 
+/*
+ * Check that ports which repeat the last frame aren't sent unchanged frames.
+ */
+void UniverseTest::testUnchangedFrames() {
+  ExportMap export_map;
+  ola::UniverseStore store(m_preferences, &export_map);
+  Universe *universe = store.GetUniverseOrCreate(TEST_UNIVERSE);
+  OLA_ASSERT(universe);
+  ola::CounterMap *changed_slots = export_map.GetCounterMapVar(
+      Universe::K_CHANGED_SLOTS_VAR);
+
+  TestMockOutputPort port(NULL, 1);
+  RepeatingOutputPort repeating_port(NULL, 2);
+  universe->AddPort(&port);
+  universe->AddPort(&repeating_port);
+
+  OLA_ASSERT(universe->SetDMX(m_buffer));
+  OLA_ASSERT_EQ(1u, repeating_port.writes);
+  OLA_ASSERT_DMX_EQUALS(m_buffer, repeating_port.ReadDMX());
+  OLA_ASSERT_EQ(m_buffer.Size(), changed_slots->Counter("1")->Get());
+
+  // The same data again is only sent to the port which doesn't repeat.
+  DmxBuffer same_data(m_buffer);
+  OLA_ASSERT(universe->SetDMX(same_data));
+  OLA_ASSERT_EQ(1u, repeating_port.writes);
+  OLA_ASSERT_DMX_EQUALS(m_buffer, port.ReadDMX());
+  OLA_ASSERT_EQ(m_buffer.Size(), changed_slots->Counter("1")->Get());
+
+  // Change two slots.
+  DmxBuffer new_data(m_buffer);
+  new_data.SetChannel(0, 0);
+  new_data.SetChannel(10, 0);
+  OLA_ASSERT(universe->SetDMX(new_data));
+  OLA_ASSERT_EQ(2u, repeating_port.writes);
+  OLA_ASSERT_DMX_EQUALS(new_data, repeating_port.ReadDMX());
+  OLA_ASSERT_EQ(m_buffer.Size() + 2, changed_slots->Counter("1")->Get());
+
+  // A shorter frame is a change.
+  DmxBuffer short_data(new_data.GetRaw(), 5);
+  OLA_ASSERT(universe->SetDMX(short_data));
+  OLA_ASSERT_EQ(3u, repeating_port.writes);
+  OLA_ASSERT_DMX_EQUALS(short_data, repeating_port.ReadDMX());
+
+  // A port which is added is sent the next frame, even if it's unchanged.
+  RepeatingOutputPort new_port(NULL, 3);
+  universe->AddPort(&new_port);
+  OLA_ASSERT(universe->SetDMX(short_data));
+  OLA_ASSERT_EQ(1u, new_port.writes);
+  OLA_ASSERT_DMX_EQUALS(short_data, new_port.ReadDMX());
+
+  universe->RemovePort(&port);
+  universe->RemovePort(&repeating_port);
+  universe->RemovePort(&new_port);
+  store.DeleteAll();
+  OLA_ASSERT_EQ(string("map:universe"), changed_slots->Value());
+}
+
+
 /*
  * Check that we update when ports have new data
  */
@@ -271,6 +357,70 @@ void UniverseTest::testReceiveDmx() {
 }
 
 
+/*
+ * Check that we track the time from data arriving on an input port until it's
+ * written to the output ports.
+ */
+void UniverseTest::testLatency() {
+  ExportMap export_map;
+  ola::UniverseStore store(m_preferences, &export_map);
+  ola::PortBroker broker;
+  ola::PortManager port_manager(&store, &broker);
+  TimeStamp time_stamp;
+  MockSelectServer ss(&time_stamp);
+  ola::PluginAdaptor plugin_adaptor(NULL, &ss, NULL, NULL, NULL, NULL);
+
+  MockDevice device(NULL, "foo");
+  TestMockInputPort input_port(&device, 1, &plugin_adaptor);
+  TestMockOutputPort output_port(&device, 1);
+  port_manager.PatchPort(&input_port, TEST_UNIVERSE);
+  port_manager.PatchPort(&output_port, TEST_UNIVERSE);
+
+  Universe *universe = store.GetUniverse(TEST_UNIVERSE);
+  OLA_ASSERT(universe);
+  const LatencyHistogram *latency = universe->Latency();
+  const LatencyHistogram *port_latency = universe->OutputPortLatency(
+      &output_port);
+  OLA_ASSERT(latency);
+  OLA_ASSERT(port_latency);
+  OLA_ASSERT_FALSE(universe->OutputPortLatency(NULL));
+
+  // The data arrived 10ms ago.
+  m_clock.CurrentTime(&time_stamp);
+  time_stamp -= TimeInterval(0, 10000);
+  input_port.WriteDMX(m_buffer);
+  input_port.DmxChanged();
+  OLA_ASSERT_DMX_EQUALS(m_buffer, output_port.ReadDMX());
+
+  OLA_ASSERT_EQ(static_cast<uint64_t>(1), latency->Count());
+  OLA_ASSERT_EQ(static_cast<uint64_t>(1), port_latency->Count());
+  OLA_ASSERT_TRUE(latency->Max() >= 10000);
+  OLA_ASSERT_TRUE(latency->Max() < 1000000);
+  OLA_ASSERT_TRUE(port_latency->Max() >= 10000);
+  OLA_ASSERT_TRUE(port_latency->Max() <= latency->Max());
+
+  // SetDMX doesn't have a source time, so it isn't recorded.
+  universe->SetDMX(m_buffer);
+  OLA_ASSERT_EQ(static_cast<uint64_t>(1), latency->Count());
+
+  string value = export_map.GetLatencyMapVar(
+      Universe::K_UNIVERSE_LATENCY_VAR)->Value();
+  OLA_ASSERT_EQ(string("map:universe 1:\"count=1 "), value.substr(0, 24));
+  value = export_map.GetLatencyMapVar(
+      Universe::K_OUTPUT_PORT_LATENCY_VAR)->Value();
+  OLA_ASSERT_EQ(string("map:port ") + output_port.UniqueId() + ":",
+                value.substr(0, 10 + output_port.UniqueId().size()));
+
+  // Unpatching the output port removes its histogram.
+  port_manager.UnPatchPort(&output_port);
+  OLA_ASSERT_FALSE(universe->OutputPortLatency(&output_port));
+  OLA_ASSERT_EQ(string("map:port"),
+                export_map.GetLatencyMapVar(
+                    Universe::K_OUTPUT_PORT_LATENCY_VAR)->Value());
+  port_manager.UnPatchPort(&input_port);
+}
+
+
 /*
  * Check that we can add/remove source clients from this universes
  */
@@ -513,6 +663,18 @@ void UniverseTest::testHtpMerging() {
                        universe->GetDMX().Size());
   OLA_ASSERT_DMX_EQUALS(client_htp_merge_result, universe->GetDMX());
 
+  // now lower the client's values, the slots it owned should fall back to the
+  // ports
+  DmxBuffer lower_client_buffer;
+  lower_client_buffer.SetFromString("0,0,0,0");
+  m_clock.CurrentTime(&time_stamp);
+  ola::DmxSource lower_source(lower_client_buffer, time_stamp, new_priority);
+  input_client.DMXReceived(TEST_UNIVERSE, lower_source);
+  universe->SourceClientDataChanged(&input_client);
+  OLA_ASSERT_EQ(new_priority, universe->ActivePriority());
+  OLA_ASSERT_EQ(htp_buffer.Size(), universe->GetDMX().Size());
+  OLA_ASSERT_DMX_EQUALS(htp_buffer, universe->GetDMX());
+
   // clean up
   universe->RemoveSourceClient(&input_client);
   universe->RemovePort(&port);
@@ -57,6 +57,7 @@ using std::string;
 using std::vector;
 
 const char ArtNetDevice::K_ALWAYS_BROADCAST_KEY[] = "always_broadcast";
+const char ArtNetDevice::K_BATCH_SENDS_KEY[] = "batch_sends";
 const char ArtNetDevice::K_DEVICE_NAME[] = "ArtNet";
 const char ArtNetDevice::K_IP_KEY[] = "ip";
 const char ArtNetDevice::K_LIMITED_BROADCAST_KEY[] = "use_limited_broadcast";
@@ -104,6 +105,7 @@ bool ArtNetDevice::StartHook() {
       K_ALWAYS_BROADCAST_KEY);
   node_options.use_limited_broadcast_address = m_preferences->GetValueAsBool(
       K_LIMITED_BROADCAST_KEY);
+  node_options.batch_sends = m_preferences->GetValueAsBool(K_BATCH_SENDS_KEY);
   // OLA Output ports are ArtNet input ports
   node_options.input_port_count = StringToIntOrDefault(
       m_preferences->GetValue(K_OUTPUT_PORT_KEY),
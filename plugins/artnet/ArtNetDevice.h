@@ -72,6 +72,7 @@ class ArtNetDevice: public Device {
                  ConfigureCallback *done);
 
   static const char K_ALWAYS_BROADCAST_KEY[];
+  static const char K_BATCH_SENDS_KEY[];
   static const char K_DEVICE_NAME[];
   static const char K_IP_KEY[];
   static const char K_LIMITED_BROADCAST_KEY[];
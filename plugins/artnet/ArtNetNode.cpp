@@ -81,6 +81,17 @@ const char ArtNetNodeImpl::ARTNET_ID[] = "Art-Net";
 // saw it in an ArtTod message.
 typedef map<UID, std::pair<IPV4Address, uint8_t> > uid_map;
 
+// An RDM request that's waiting for a response.
+struct PendingRDMRequest {
+  const RDMRequest *request;
+  RDMCallback *callback;
+  IPV4Address ip_destination;
+  ola::thread::timeout_id timeout;
+};
+
+// The in-flight requests, keyed by destination UID.
+typedef map<UID, PendingRDMRequest*> pending_rdm_map;
+
 // Input ports are ones that send data using ArtNet
 class ArtNetNodeImpl::InputPort {
  public:
@@ -89,9 +100,6 @@ class ArtNetNodeImpl::InputPort {
         sequence_number(0),
         discovery_callback(NULL),
         discovery_timeout(ola::thread::INVALID_TIMEOUT),
-        rdm_request_callback(NULL),
-        pending_request(NULL),
-        rdm_send_timeout(ola::thread::INVALID_TIMEOUT),
         m_port_address(0),
         m_tod_callback(NULL) {
   }
@@ -168,13 +176,8 @@ class ArtNetNodeImpl::InputPort {
   set<IPV4Address> discovery_node_set;
   // the timeout_id for the discovery timer
   ola::thread::timeout_id discovery_timeout;
-  // the in-flight request and it's callback
-  RDMCallback *rdm_request_callback;
-  const RDMRequest *pending_request;
-  IPV4Address rdm_ip_destination;
-
-  // these control the sending of RDM requests.
-  ola::thread::timeout_id rdm_send_timeout;
+  // the in-flight requests, at most one per responder
+  pending_rdm_map pending_requests;
 
  private:
   uint8_t m_port_address;
@@ -207,15 +210,13 @@ ArtNetNodeImpl::ArtNetNodeImpl(const ola::network::Interface &iface,
       m_ss(ss),
       m_always_broadcast(options.always_broadcast),
       m_use_limited_broadcast_address(options.use_limited_broadcast_address),
+      m_batch_sends(options.batch_sends),
       m_in_configuration_mode(false),
       m_artpoll_required(false),
       m_artpollreply_required(false),
       m_interface(iface),
-      m_socket(socket) {
-
-  if (!m_socket.get()) {
-    m_socket.reset(new UDPSocket());
-  }
+      m_socket(socket ? socket : new UDPSocket()),
+      m_batch(m_socket.get(), ss) {
 
   for (unsigned int i = 0; i < options.input_port_count; i++) {
     m_input_ports.push_back(new InputPort());
@@ -285,23 +286,18 @@ bool ArtNetNodeImpl::Stop() {
     port->RunDiscoveryCallback();
 
     // clean up request state
-    if (port->rdm_send_timeout != ola::thread::INVALID_TIMEOUT) {
-      m_ss->RemoveTimeout(port->rdm_send_timeout);
-      port->rdm_send_timeout = ola::thread::INVALID_TIMEOUT;
-    }
-
-    if (port->pending_request) {
-      delete port->pending_request;
-      port->pending_request = NULL;
-    }
-
-    if (port->rdm_request_callback) {
-      RDMCallback *callback = port->rdm_request_callback;
-      port->rdm_request_callback = NULL;
-      RunRDMCallback(callback, ola::rdm::RDM_TIMEOUT);
+    while (!port->pending_requests.empty()) {
+      pending_rdm_map::iterator pending_iter = port->pending_requests.begin();
+      PendingRDMRequest *pending = pending_iter->second;
+      port->pending_requests.erase(pending_iter);
+      m_ss->RemoveTimeout(pending->timeout);
+      delete pending->request;
+      RunRDMCallback(pending->callback, ola::rdm::RDM_TIMEOUT);
+      delete pending;
     }
   }
 
+  m_batch.Flush();
   m_ss->RemoveReadDescriptor(m_socket.get());
 
   m_running = false;
@@ -671,14 +667,15 @@ void ArtNetNodeImpl::SendRDMRequest(uint8_t port_id,
     return;
   }
 
-  if (port->rdm_request_callback) {
-    OLA_FATAL << "Previous request hasn't completed yet, dropping request";
+  const UID uid_destination = request->DestinationUID();
+  if (STLContains(port->pending_requests, uid_destination)) {
+    OLA_FATAL << "Previous request to " << uid_destination
+              << " hasn't completed yet, dropping request";
     RunRDMCallback(on_complete, ola::rdm::RDM_FAILED_TO_SEND);
     return;
   }
 
-  port->rdm_ip_destination = m_interface.bcast_address;
-  const UID &uid_destination = request->DestinationUID();
+  IPV4Address ip_destination = m_interface.bcast_address;
   uid_map::const_iterator iter = port->uids.find(uid_destination);
   if (iter == port->uids.end()) {
     if (!uid_destination.IsBroadcast()) {
@@ -686,23 +683,22 @@ void ArtNetNodeImpl::SendRDMRequest(uint8_t port_id,
                << " in the uid map, broadcasting packet";
     }
   } else {
-    port->rdm_ip_destination = iter->second.first;
+    ip_destination = iter->second.first;
   }
 
-  port->rdm_request_callback = on_complete;
-  port->pending_request = request.release();
-  bool r = SendRDMCommand(*port->pending_request,
-                          port->rdm_ip_destination,
-                          port->PortAddress());
+  bool r = SendRDMCommand(*request, ip_destination, port->PortAddress());
 
   if (r && !uid_destination.IsBroadcast()) {
-    port->rdm_send_timeout = m_ss->RegisterSingleTimeout(
+    PendingRDMRequest *pending = new PendingRDMRequest();
+    pending->request = request.release();
+    pending->callback = on_complete;
+    pending->ip_destination = ip_destination;
+    pending->timeout = m_ss->RegisterSingleTimeout(
       RDM_REQUEST_TIMEOUT_MS,
-      ola::NewSingleCallback(this, &ArtNetNodeImpl::TimeoutRDMRequest, port));
+      ola::NewSingleCallback(this, &ArtNetNodeImpl::TimeoutRDMRequest, port,
+                             uid_destination));
+    port->pending_requests[uid_destination] = pending;
   } else {
-    delete port->pending_request;
-    port->pending_request = NULL;
-    port->rdm_request_callback = NULL;
     RunRDMCallback(
         on_complete,
         uid_destination.IsBroadcast() ? ola::rdm::RDM_WAS_BROADCAST :
@@ -851,17 +847,23 @@ bool ArtNetNodeImpl::SendTimeCode(const ola::timecode::TimeCode &timecode) {
 }
 
 void ArtNetNodeImpl::SocketReady() {
-  artnet_packet packet;
-  ssize_t packet_size = sizeof(packet);
-  ola::network::IPV4SocketAddress source;
-
-  if (!m_socket->RecvFrom(reinterpret_cast<uint8_t*>(&packet),
-                          &packet_size,
-                          &source)) {
-    return;
-  }
-
-  HandlePacket(source.Host(), packet, packet_size);
+  artnet_packet packets[RECEIVE_BATCH_SIZE];
+  ola::network::IncomingDatagram datagrams[RECEIVE_BATCH_SIZE];
+
+  // If the socket reads until empty, keep going until it would block.
+  unsigned int count;
+  do {
+    // RecvMany() sets the size to the length of each datagram, so this needs
+    // to be reset for every batch.
+    for (unsigned int i = 0; i < RECEIVE_BATCH_SIZE; i++) {
+      datagrams[i].data = reinterpret_cast<uint8_t*>(&packets[i]);
+      datagrams[i].size = sizeof(packets[i]);
+    }
+    count = m_socket->RecvMany(datagrams, RECEIVE_BATCH_SIZE);
+    for (unsigned int i = 0; i < count; i++) {
+      HandlePacket(datagrams[i].source.Host(), packets[i], datagrams[i].size);
+    }
+  } while (count && m_socket->ReadsUntilEmpty());
 }
 
 bool ArtNetNodeImpl::SendPollIfAllowed() {
@@ -1353,11 +1355,18 @@ void ArtNetNodeImpl::HandleRDMResponse(InputPort *port,
     return;
   }
 
-  if (!port->pending_request) {
+  pending_rdm_map::iterator pending_iter =
+      port->pending_requests.find(reply->Response()->SourceUID());
+  if (pending_iter == port->pending_requests.end()) {
+    if (!port->pending_requests.empty()) {
+      OLA_INFO << "Got response from unexpected UID "
+               << reply->Response()->SourceUID();
+    }
     return;
   }
 
-  const RDMRequest *request = port->pending_request;
+  PendingRDMRequest *pending = pending_iter->second;
+  const RDMRequest *request = pending->request;
   if (request->SourceUID() != reply->Response()->DestinationUID() ||
       request->DestinationUID() != reply->Response()->SourceUID()) {
     OLA_INFO << "Got response from/to unexpected UID: req "
@@ -1399,23 +1408,18 @@ void ArtNetNodeImpl::HandleRDMResponse(InputPort *port,
     return;
   }
 
-  if (port->rdm_ip_destination != m_interface.bcast_address &&
-      port->rdm_ip_destination != source_address) {
+  if (pending->ip_destination != m_interface.bcast_address &&
+      pending->ip_destination != source_address) {
     OLA_INFO << "IP address of RDM response didn't match";
     return;
   }
 
   // at this point we've decided it's for us
-  port->pending_request = NULL;
+  port->pending_requests.erase(pending_iter);
+  m_ss->RemoveTimeout(pending->timeout);
+  RDMCallback *callback = pending->callback;
   delete request;
-  RDMCallback *callback = port->rdm_request_callback;
-  port->rdm_request_callback = NULL;
-
-  // remove the timeout
-  if (port->rdm_send_timeout != ola::thread::INVALID_TIMEOUT) {
-    m_ss->RemoveTimeout(port->rdm_send_timeout);
-    port->rdm_send_timeout = ola::thread::INVALID_TIMEOUT;
-  }
+  delete pending;
 
   callback->Run(reply.get());
 }
@@ -1447,6 +1451,12 @@ bool ArtNetNodeImpl::SendPacket(const artnet_packet &packet,
                                 unsigned int size,
                                 const IPV4Address &ip_destination) {
   size += sizeof(packet.id) + sizeof(packet.op_code);
+  if (m_batch_sends) {
+    m_batch.Add(reinterpret_cast<const uint8_t*>(&packet), size,
+                IPV4SocketAddress(ip_destination, ARTNET_PORT));
+    return true;
+  }
+
   unsigned int bytes_sent = m_socket->SendTo(
       reinterpret_cast<const uint8_t*>(&packet),
       size,
@@ -1459,13 +1469,16 @@ bool ArtNetNodeImpl::SendPacket(const artnet_packet &packet,
   return true;
 }
 
-void ArtNetNodeImpl::TimeoutRDMRequest(InputPort *port) {
-  OLA_INFO << "RDM Request timed out.";
-  port->rdm_send_timeout = ola::thread::INVALID_TIMEOUT;
-  delete port->pending_request;
-  port->pending_request = NULL;
-  RDMCallback *callback = port->rdm_request_callback;
-  port->rdm_request_callback = NULL;
+void ArtNetNodeImpl::TimeoutRDMRequest(InputPort *port, UID uid) {
+  OLA_INFO << "RDM Request to " << uid << " timed out.";
+  PendingRDMRequest *pending = STLLookupAndRemovePtr(&port->pending_requests,
+                                                     uid);
+  if (!pending) {
+    return;
+  }
+  delete pending->request;
+  RDMCallback *callback = pending->callback;
+  delete pending;
   RunRDMCallback(callback, ola::rdm::RDM_TIMEOUT);
 }
 
@@ -1549,17 +1562,14 @@ void ArtNetNodeImpl::UpdatePortFromSource(OutputPort *port,
     (*port->buffer) = source.buffer;
   } else {
     // HTP merge
-    bool first = true;
+    const DmxBuffer *source_buffers[MAX_MERGE_SOURCES];
+    unsigned int source_count = 0;
     for (unsigned int i = 0; i < MAX_MERGE_SOURCES; i++) {
       if (!port->sources[i].address.IsWildcard()) {
-        if (first) {
-          (*port->buffer) = port->sources[i].buffer;
-          first = false;
-        } else {
-          port->buffer->HTPMerge(port->sources[i].buffer);
-        }
+        source_buffers[source_count++] = &port->sources[i].buffer;
       }
     }
+    port->buffer->HTPMergeMany(source_buffers, source_count);
   }
   port->on_data->Run();
 }
@@ -1675,6 +1685,8 @@ bool ArtNetNodeImpl::InitNetwork() {
     return false;
   }
 
+  // SocketReady() drains the socket, so this allows edge triggered polling.
+  m_socket->SetReadsUntilEmpty();
   m_socket->SetOnData(NewCallback(this, &ArtNetNodeImpl::SocketReady));
   m_ss->AddReadDescriptor(m_socket.get());
   return true;
@@ -1749,7 +1761,7 @@ bool ArtNetNodeImpl::StartDiscoveryProcess(InputPort *port,
                                            RDMDiscoveryCallback *callback) {
   if (port->discovery_callback) {
     OLA_FATAL << "ArtNet UID discovery already running, something has gone "
-                 "wrong with the DiscoverableQueueingRDMController.";
+                 "wrong with the DiscoverablePipelinedRDMController.";
     port->RunTodCallback();
     return false;
   }
@@ -1801,8 +1813,8 @@ ArtNetNode::ArtNetNode(const ola::network::Interface &iface,
     ArtNetNodeImplRDMWrapper *wrapper = new ArtNetNodeImplRDMWrapper(&m_impl,
                                                                      i);
     m_wrappers.push_back(wrapper);
-    m_controllers.push_back(new ola::rdm::DiscoverableQueueingRDMController(
-        wrapper, options.rdm_queue_size));
+    m_controllers.push_back(new ola::rdm::DiscoverablePipelinedRDMController(
+        wrapper, options.rdm_queue_size, options.rdm_max_in_flight));
   }
 }
 
@@ -30,11 +30,12 @@
 #include "ola/Callback.h"
 #include "ola/Clock.h"
 #include "ola/DmxBuffer.h"
+#include "ola/network/DatagramBatch.h"
 #include "ola/network/IPV4Address.h"
 #include "ola/network/Interface.h"
 #include "ola/io/SelectServerInterface.h"
 #include "ola/network/Socket.h"
-#include "ola/rdm/QueueingRDMController.h"
+#include "ola/rdm/PipelinedRDMController.h"
 #include "ola/rdm/RDMCommand.h"
 #include "ola/rdm/RDMFrame.h"
 #include "ola/rdm/RDMControllerInterface.h"
@@ -68,15 +69,27 @@ class ArtNetNodeOptions {
       : always_broadcast(false),
         use_limited_broadcast_address(false),
         rdm_queue_size(20),
+        rdm_max_in_flight(4),
         broadcast_threshold(30),
-        input_port_count(4) {
+        input_port_count(4),
+        batch_sends(false) {
   }
 
   bool always_broadcast;
   bool use_limited_broadcast_address;
   unsigned int rdm_queue_size;
+  /**
+   * The number of RDM requests on each port that can be waiting for a
+   * response. Only one request to each responder is in flight at once.
+   */
+  unsigned int rdm_max_in_flight;
   unsigned int broadcast_threshold;
   uint8_t input_port_count;
+  /**
+   * Queue the packets produced during each SelectServer iteration and send
+   * them with as few system calls as possible.
+   */
+  bool batch_sends;
 };
 
 
@@ -259,8 +272,8 @@ class ArtNetNodeImpl {
   /**
    * @brief Flush the TOD and force a full discovery.
    *
-   * The DiscoverableQueueingRDMController ensures this is only called one at a
-   * time.
+   * The DiscoverablePipelinedRDMController ensures this is only called one at
+   * a time.
    * @param port_id port to discover on
    * @param callback the RDMDiscoveryCallback to run when discovery completes
    */
@@ -271,7 +284,7 @@ class ArtNetNodeImpl {
    * @brief Run an 'incremental' discovery. This just involves fetching the TOD from
    * all nodes.
    *
-   * The DiscoverableQueueingRDMController ensures only one discovery process
+   * The DiscoverablePipelinedRDMController ensures only one discovery process
    * is running per port at any time.
    * @param port_id port to send on
    * @param callback the RDMDiscoveryCallback to run when discovery completes
@@ -288,8 +301,8 @@ class ArtNetNodeImpl {
    * @param request the RDMRequest object
    * @param on_complete the RDMCallback to run
    *
-   * Because this is wrapped in the QueueingRDMController this will only be
-   * called one-at-a-time (per port)
+   * Because this is wrapped in the PipelinedRDMController there will only be
+   * one request in flight to each UID (per port)
    */
   void SendRDMRequest(uint8_t port_id,
                       ola::rdm::RDMRequest *request,
@@ -397,6 +410,7 @@ class ArtNetNodeImpl {
   ola::io::SelectServerInterface *m_ss;
   bool m_always_broadcast;
   bool m_use_limited_broadcast_address;
+  bool m_batch_sends;
 
   // The following keep track of "Configuration mode"
   bool m_in_configuration_mode;
@@ -407,6 +421,7 @@ class ArtNetNodeImpl {
   OutputPort m_output_ports[ARTNET_MAX_PORTS];
   ola::network::Interface m_interface;
   std::auto_ptr<ola::network::UDPSocketInterface> m_socket;
+  ola::network::DatagramBatch m_batch;
 
   /**
    * @brief Called when there is data on this socket
@@ -540,9 +555,10 @@ class ArtNetNodeImpl {
 
   /**
    * @brief Timeout a pending RDM request
-   * @param port the id of the port to timeout.
+   * @param port the port the request was sent on.
+   * @param uid the destination of the request.
    */
-  void TimeoutRDMRequest(InputPort *port);
+  void TimeoutRDMRequest(InputPort *port, ola::rdm::UID uid);
 
   /**
    * @brief Send a generic ArtRdm message
@@ -649,6 +665,8 @@ class ArtNetNodeImpl {
   // The maximum number of requests we'll allow in the queue. This is a per
   // port (universe) limit.
   static const unsigned int RDM_REQUEST_QUEUE_LIMIT = 100;
+  // The maximum number of datagrams read per call to SocketReady().
+  static const unsigned int RECEIVE_BATCH_SIZE = 16;
   // How long to wait for a response to an RDM Request
   static const unsigned int RDM_REQUEST_TIMEOUT_MS = 2000;
 
@@ -657,7 +675,7 @@ class ArtNetNodeImpl {
 
 
 /**
- * This glues the ArtNetNodeImpl together with the QueueingRDMController.
+ * This glues the ArtNetNodeImpl together with the PipelinedRDMController.
  * The ArtNetNodeImpl takes a port id so we need this extra layer.
  */
 class ArtNetNodeImplRDMWrapper
@@ -846,7 +864,7 @@ class ArtNetNode {
  private:
   ArtNetNodeImpl m_impl;
   std::vector<ArtNetNodeImplRDMWrapper*> m_wrappers;
-  std::vector<ola::rdm::DiscoverableQueueingRDMController*> m_controllers;
+  std::vector<ola::rdm::DiscoverablePipelinedRDMController*> m_controllers;
 
   /**
    * @brief Check that the port_id is a valid input port.
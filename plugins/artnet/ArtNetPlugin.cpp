@@ -104,6 +104,9 @@ bool ArtNetPlugin::SetDefaultPreferences() {
   save |= m_preferences->SetDefaultValue(ArtNetDevice::K_ALWAYS_BROADCAST_KEY,
                                          BoolValidator(),
                                          false);
+  save |= m_preferences->SetDefaultValue(ArtNetDevice::K_BATCH_SENDS_KEY,
+                                         BoolValidator(),
+                                         false);
   save |= m_preferences->SetDefaultValue(ArtNetDevice::K_LIMITED_BROADCAST_KEY,
                                          BoolValidator(),
                                          false);
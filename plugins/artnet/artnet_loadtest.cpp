@@ -18,11 +18,14 @@
  * Copyright (C) 2013 Simon Newton
  */
 
+#include <stdint.h>
 #include <stdlib.h>
+#include <sys/resource.h>
 #include <algorithm>
 #include <memory>
 #include <string>
 #include "ola/Callback.h"
+#include "ola/Clock.h"
 #include "ola/DmxBuffer.h"
 #include "ola/Logging.h"
 #include "ola/base/Flags.h"
@@ -46,15 +49,45 @@ using std::min;
 DEFINE_s_uint32(fps, f, 10, "Frames per second per universe [1 - 1000]");
 DEFINE_s_uint16(universes, u, 1, "Number of universes to send");
 DEFINE_string(iface, "", "The interface to send from");
+DEFINE_default_bool(batch, false,
+                    "Send all the universes in a frame with a single system "
+                    "call");
+DEFINE_uint32(report_interval, 5,
+              "Seconds between CPU usage reports, 0 to disable");
 
 /**
  * Send N DMX frames using ArtNet, where N is given by number_of_universes.
  */
 bool SendFrames(ArtNetNode *node, DmxBuffer *buffer,
-                uint16_t number_of_universes) {
+                uint16_t number_of_universes, unsigned int *frames_sent) {
   for (uint16_t i = 0; i < number_of_universes; i++) {
     node->SendDMX(i, *buffer);
   }
+  *frames_sent += number_of_universes;
+  return true;
+}
+
+/**
+ * Print the CPU time used per universe frame since the last report.
+ */
+bool ReportUsage(const unsigned int *frames_sent) {
+  static unsigned int last_frames = 0;
+  static uint64_t last_cpu_usec = 0;
+
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  uint64_t cpu_usec = (
+      static_cast<uint64_t>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) *
+      ola::USEC_IN_SECONDS + usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+
+  unsigned int frames = *frames_sent - last_frames;
+  if (frames) {
+    cout << frames << " universe frames, "
+         << static_cast<double>(cpu_usec - last_cpu_usec) / frames
+         << " us CPU per universe frame" << endl;
+  }
+  last_frames = *frames_sent;
+  last_cpu_usec = cpu_usec;
   return true;
 }
 
@@ -82,6 +115,7 @@ int main(int argc, char* argv[]) {
 
   ArtNetNodeOptions options;
   options.always_broadcast = true;
+  options.batch_sends = FLAGS_batch;
 
   SelectServer ss;
   ArtNetNode node(iface, &ss, options);
@@ -96,9 +130,16 @@ int main(int argc, char* argv[]) {
     return -1;
   }
 
+  unsigned int frames_sent = 0;
   ss.RegisterRepeatingTimeout(
       1000 / fps,
-      NewCallback(&SendFrames, &node, &output, universes));
+      NewCallback(&SendFrames, &node, &output, universes, &frames_sent));
+  if (FLAGS_report_interval) {
+    ss.RegisterRepeatingTimeout(
+        FLAGS_report_interval * 1000,
+        NewCallback(&ReportUsage,
+                    static_cast<const unsigned int*>(&frames_sent)));
+  }
   cout << "Starting loadtester: " << universes << " universe(s), " << fps
        << " fps" << endl;
   ss.Run();
@@ -38,6 +38,7 @@ namespace e131 {
 using ola::acn::CID;
 using std::string;
 
+const char E131Plugin::BATCH_SENDS_KEY[] = "batch_sends";
 const char E131Plugin::CID_KEY[] = "cid";
 const unsigned int E131Plugin::DEFAULT_DSCP_VALUE = 0;
 const char E131Plugin::DSCP_KEY[] = "dscp";
@@ -68,6 +69,7 @@ bool E131Plugin::StartHook() {
       IGNORE_PREVIEW_DATA_KEY);
   options.enable_draft_discovery = m_preferences->GetValueAsBool(
       DRAFT_DISCOVERY_KEY);
+  options.batch_sends = m_preferences->GetValueAsBool(BATCH_SENDS_KEY);
   if (m_preferences->GetValueAsBool(PREPEND_HOSTNAME_KEY)) {
     std::ostringstream str;
     str << ola::network::Hostname() << "-" << m_plugin_adaptor->InstanceName();
@@ -148,6 +150,11 @@ bool E131Plugin::SetDefaultPreferences() {
     save = true;
   }
 
+  save |= m_preferences->SetDefaultValue(
+      BATCH_SENDS_KEY,
+      BoolValidator(),
+      false);
+
   save |= m_preferences->SetDefaultValue(
       DSCP_KEY,
       UIntValidator(0, 63),
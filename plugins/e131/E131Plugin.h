@@ -49,6 +49,7 @@ class E131Plugin: public ola::Plugin {
     bool SetDefaultPreferences();
 
     E131Device *m_device;
+    static const char BATCH_SENDS_KEY[];
     static const char CID_KEY[];
     static const unsigned int DEFAULT_DSCP_VALUE;
     static const unsigned int DEFAULT_PORT_COUNT;
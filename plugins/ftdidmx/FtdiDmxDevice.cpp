@@ -33,14 +33,19 @@ namespace ola {
 namespace plugin {
 namespace ftdidmx {
 
+using ola::thread::FrameTimer;
 using std::string;
 
 FtdiDmxDevice::FtdiDmxDevice(AbstractPlugin *owner,
                              const FtdiWidgetInfo &widget_info,
-                             unsigned int frequency)
+                             unsigned int frequency,
+                             const FrameTimer::Options &timer_options,
+                             ExportMap *export_map)
     : Device(owner, widget_info.Description()),
       m_widget_info(widget_info),
-      m_frequency(frequency) {
+      m_frequency(frequency),
+      m_timer_options(timer_options),
+      m_export_map(export_map) {
   m_widget = new FtdiWidget(widget_info.Serial(),
                             widget_info.Name(),
                             widget_info.Id(),
@@ -64,7 +69,8 @@ bool FtdiDmxDevice::StartHook() {
     FtdiInterface *port = new FtdiInterface(m_widget,
                                             static_cast<ftdi_interface>(i));
     if (port->SetupOutput()) {
-      AddPort(new FtdiDmxOutputPort(this, port, i, m_frequency));
+      AddPort(new FtdiDmxOutputPort(this, port, i, m_frequency,
+                                    m_timer_options, m_export_map));
       successfully_added += 1;
     } else {
       OLA_WARN << "Failed to add interface: " << i;
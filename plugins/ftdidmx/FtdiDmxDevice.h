@@ -29,6 +29,8 @@
 #include <string>
 #include <memory>
 #include "ola/DmxBuffer.h"
+#include "ola/ExportMap.h"
+#include "ola/thread/FrameTimer.h"
 #include "olad/Device.h"
 #include "olad/Preferences.h"
 #include "plugins/ftdidmx/FtdiWidget.h"
@@ -41,7 +43,9 @@ class FtdiDmxDevice : public Device {
  public:
   FtdiDmxDevice(AbstractPlugin *owner,
                 const FtdiWidgetInfo &widget_info,
-                unsigned int frequency);
+                unsigned int frequency,
+                const ola::thread::FrameTimer::Options &timer_options,
+                ExportMap *export_map);
   ~FtdiDmxDevice();
 
   std::string DeviceId() const { return m_widget->Serial(); }
@@ -55,6 +59,8 @@ class FtdiDmxDevice : public Device {
   FtdiWidget *m_widget;
   const FtdiWidgetInfo m_widget_info;
   unsigned int m_frequency;
+  const ola::thread::FrameTimer::Options m_timer_options;
+  ExportMap *m_export_map;
 };
 }  // namespace ftdidmx
 }  // namespace plugin
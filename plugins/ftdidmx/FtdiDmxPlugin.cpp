@@ -41,7 +41,9 @@ namespace ftdidmx {
 using std::string;
 using std::vector;
 
+const char FtdiDmxPlugin::K_CPU[] = "cpu";
 const char FtdiDmxPlugin::K_FREQUENCY[] = "frequency";
+const char FtdiDmxPlugin::K_REALTIME[] = "realtime";
 const char FtdiDmxPlugin::PLUGIN_NAME[] = "FTDI USB DMX";
 const char FtdiDmxPlugin::PLUGIN_PREFIX[] = "ftdidmx";
 
@@ -73,9 +75,16 @@ bool FtdiDmxPlugin::StartHook() {
       m_preferences->GetValue(K_FREQUENCY),
       DEFAULT_FREQUENCY);
 
+  ola::thread::FrameTimer::Options timer_options;
+  timer_options.realtime = m_preferences->GetValueAsBool(K_REALTIME);
+  if (!StringToInt(m_preferences->GetValue(K_CPU), &timer_options.cpu)) {
+    timer_options.cpu = -1;
+  }
+
   FtdiWidgetInfoVector::const_iterator iter;
   for (iter = widgets.begin(); iter != widgets.end(); ++iter) {
-    AddDevice(new FtdiDmxDevice(this, *iter, frequency));
+    AddDevice(new FtdiDmxDevice(this, *iter, frequency, timer_options,
+                                m_plugin_adaptor->GetExportMap()));
   }
   return true;
 }
@@ -112,9 +121,16 @@ bool FtdiDmxPlugin::SetDefaultPreferences() {
     return false;
   }
 
-  if (m_preferences->SetDefaultValue(FtdiDmxPlugin::K_FREQUENCY,
-                                     UIntValidator(1, 44),
-                                     DEFAULT_FREQUENCY)) {
+  bool save = m_preferences->SetDefaultValue(FtdiDmxPlugin::K_FREQUENCY,
+                                            UIntValidator(1, 44),
+                                            DEFAULT_FREQUENCY);
+  save |= m_preferences->SetDefaultValue(FtdiDmxPlugin::K_REALTIME,
+                                         BoolValidator(),
+                                         false);
+  save |= m_preferences->SetDefaultValue(FtdiDmxPlugin::K_CPU,
+                                         IntValidator(-1, 1023),
+                                         -1);
+  if (save) {
     m_preferences->Save();
   }
 
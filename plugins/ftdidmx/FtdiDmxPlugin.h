@@ -65,7 +65,9 @@ class FtdiDmxPlugin : public Plugin {
 
   static const uint8_t DEFAULT_FREQUENCY = 30;
 
+  static const char K_CPU[];
   static const char K_FREQUENCY[];
+  static const char K_REALTIME[];
   static const char PLUGIN_NAME[];
   static const char PLUGIN_PREFIX[];
 };
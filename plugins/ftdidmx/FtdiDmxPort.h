@@ -29,6 +29,8 @@
 #include <string>
 
 #include "ola/DmxBuffer.h"
+#include "ola/ExportMap.h"
+#include "ola/thread/FrameTimer.h"
 #include "olad/Port.h"
 #include "olad/Preferences.h"
 #include "plugins/ftdidmx/FtdiDmxDevice.h"
@@ -44,10 +46,12 @@ class FtdiDmxOutputPort : public ola::BasicOutputPort {
     FtdiDmxOutputPort(FtdiDmxDevice *parent,
                       FtdiInterface *interface,
                       unsigned int id,
-                      unsigned int freq)
+                      unsigned int freq,
+                      const ola::thread::FrameTimer::Options &timer_options,
+                      ExportMap *export_map)
         : BasicOutputPort(parent, id),
           m_interface(interface),
-          m_thread(interface, freq) {
+          m_thread(interface, freq, timer_options, export_map) {
       m_thread.Start();
     }
     ~FtdiDmxOutputPort() {
@@ -59,6 +63,9 @@ class FtdiDmxOutputPort : public ola::BasicOutputPort {
       return m_thread.WriteDMX(buffer);
     }
 
+    // The output thread sends the last frame until it's given a new one.
+    bool RepeatsLastFrame() const { return true; }
+
     std::string Description() const { return m_interface->Description(); }
 
  private:
@@ -23,9 +23,6 @@
  * by E.S. Rosenberg a.k.a. Keeper of the Keys 5774/2014
  */
 
-#include <math.h>
-#include <unistd.h>
-
 #include <string>
 
 #include "ola/Clock.h"
@@ -38,11 +35,15 @@ namespace ola {
 namespace plugin {
 namespace ftdidmx {
 
-FtdiDmxThread::FtdiDmxThread(FtdiInterface *interface, unsigned int frequency)
-  : m_granularity(UNKNOWN),
-    m_interface(interface),
+FtdiDmxThread::FtdiDmxThread(
+    FtdiInterface *interface,
+    unsigned int frequency,
+    const ola::thread::FrameTimer::Options &timer_options,
+    ExportMap *export_map)
+  : m_interface(interface),
     m_term(false),
-    m_frequency(frequency) {
+    m_timer(USEC_IN_SECONDS / frequency, timer_options, export_map,
+            interface->Description()) {
 }
 
 FtdiDmxThread::~FtdiDmxThread() {
@@ -78,13 +79,8 @@ bool FtdiDmxThread::WriteDMX(const DmxBuffer &buffer) {
  * @brief The method called by the thread
  */
 void *FtdiDmxThread::Run() {
-  TimeStamp ts1, ts2, ts3;
-  Clock clock;
-  CheckTimeGranularity();
   DmxBuffer buffer;
-
-  int frameTime = static_cast<int>(floor(
-    (static_cast<double>(1000) / m_frequency) + static_cast<double>(0.5)));
+  m_timer.SetupThread();
 
   // Setup the interface
   if (!m_interface->IsOpen()) {
@@ -104,77 +100,25 @@ void *FtdiDmxThread::Run() {
       buffer.Set(m_buffer);
     }
 
-    clock.CurrentTime(&ts1);
+    // Wait for the start of the next frame
+    m_timer.StartFrame();
 
     if (!m_interface->SetBreak(true)) {
-      goto framesleep;
+      continue;
     }
 
-    if (m_granularity == GOOD) {
-      usleep(DMX_BREAK);
-    }
+    m_timer.Delay(DMX_BREAK);
 
     if (!m_interface->SetBreak(false)) {
-      goto framesleep;
+      continue;
     }
 
-    if (m_granularity == GOOD) {
-      usleep(DMX_MAB);
-    }
+    m_timer.Delay(DMX_MAB);
 
-    if (!m_interface->Write(buffer)) {
-      goto framesleep;
-    }
-
-  framesleep:
-    // Sleep for the remainder of the DMX frame time
-    clock.CurrentTime(&ts2);
-    TimeInterval elapsed = ts2 - ts1;
-
-    if (m_granularity == GOOD) {
-      while (elapsed.InMilliSeconds() < frameTime) {
-        usleep(1000);
-        clock.CurrentTime(&ts2);
-        elapsed = ts2 - ts1;
-      }
-    } else {
-      // See if we can drop out of bad mode.
-      usleep(1000);
-      clock.CurrentTime(&ts3);
-      TimeInterval interval = ts3 - ts2;
-      if (interval.InMilliSeconds() < BAD_GRANULARITY_LIMIT) {
-        m_granularity = GOOD;
-        OLA_INFO << "Switching from BAD to GOOD granularity for ftdi thread";
-      }
-
-      elapsed = ts3 - ts1;
-      while (elapsed.InMilliSeconds() < frameTime) {
-        clock.CurrentTime(&ts2);
-        elapsed = ts2 - ts1;
-      }
-    }
+    m_interface->Write(buffer);
   }
   return NULL;
 }
-
-
-/**
- * @brief Check the granularity of usleep.
- */
-void FtdiDmxThread::CheckTimeGranularity() {
-  TimeStamp ts1, ts2;
-  Clock clock;
-
-  clock.CurrentTime(&ts1);
-  usleep(1000);
-  clock.CurrentTime(&ts2);
-
-  TimeInterval interval = ts2 - ts1;
-  m_granularity = (interval.InMilliSeconds() > BAD_GRANULARITY_LIMIT) ?
-      BAD : GOOD;
-  OLA_INFO << "Granularity for FTDI thread is "
-           << ((m_granularity == GOOD) ? "GOOD" : "BAD");
-}
 }  // namespace ftdidmx
 }  // namespace plugin
 }  // namespace ola
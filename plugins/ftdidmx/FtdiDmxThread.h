@@ -26,7 +26,10 @@
 #ifndef PLUGINS_FTDIDMX_FTDIDMXTHREAD_H_
 #define PLUGINS_FTDIDMX_FTDIDMXTHREAD_H_
 
+#include <string>
 #include "ola/DmxBuffer.h"
+#include "ola/ExportMap.h"
+#include "ola/thread/FrameTimer.h"
 #include "ola/thread/Thread.h"
 
 namespace ola {
@@ -35,7 +38,10 @@ namespace ftdidmx {
 
 class FtdiDmxThread : public ola::thread::Thread {
  public:
-    FtdiDmxThread(FtdiInterface *interface, unsigned int frequency);
+    FtdiDmxThread(FtdiInterface *interface,
+                  unsigned int frequency,
+                  const ola::thread::FrameTimer::Options &timer_options,
+                  ExportMap *export_map);
     ~FtdiDmxThread();
 
     bool Stop();
@@ -43,21 +49,15 @@ class FtdiDmxThread : public ola::thread::Thread {
     bool WriteDMX(const DmxBuffer &buffer);
 
  private:
-    enum TimerGranularity { UNKNOWN, GOOD, BAD };
-
-    TimerGranularity m_granularity;
     FtdiInterface *m_interface;
     bool m_term;
-    unsigned int m_frequency;
+    ola::thread::FrameTimer m_timer;
     DmxBuffer m_buffer;
     ola::thread::Mutex m_term_mutex;
     ola::thread::Mutex m_buffer_mutex;
 
-    void CheckTimeGranularity();
-
     static const uint32_t DMX_MAB = 16;
     static const uint32_t DMX_BREAK = 110;
-    static const uint32_t BAD_GRANULARITY_LIMIT = 3;
 };
 }  // namespace ftdidmx
 }  // namespace plugin
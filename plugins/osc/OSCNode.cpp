@@ -27,6 +27,7 @@
 #include <ola/ExportMap.h>
 #include <ola/Logging.h>
 #include <ola/StringUtils.h>
+#include <ola/dmx/SlotKernels.h>
 #include <ola/stl/STLUtils.h>
 #include <algorithm>
 #include <string>
@@ -596,9 +597,13 @@ bool OSCNode::SendIndividualMessages(const DmxBuffer &dmx_data,
 
   vector<SlotMessage> messages;
 
-  // We only send the slots that have changed.
+  // We only send the slots that have changed, and any new slots.
+  const unsigned int common_length = min(dmx_data.Size(), group->dmx.Size());
+  uint8_t changed[DMX_UNIVERSE_SIZE];
+  ola::dmx::SlotDiffMask(dmx_data.GetRaw(), group->dmx.GetRaw(), changed,
+                         common_length);
   for (unsigned int i = 0; i < dmx_data.Size(); ++i) {
-    if (i > group->dmx.Size() || dmx_data.Get(i) != group->dmx.Get(i)) {
+    if (i >= common_length || changed[i]) {
       SlotMessage message = {i, lo_message_new()};
       if (osc_type == "i") {
         lo_message_add_int32(message.message, dmx_data.Get(i));
@@ -31,6 +31,15 @@ plugins_spi_libolaspi_la_LIBADD = \
     olad/plugin_api/libolaserverplugininterface.la \
     plugins/spi/libolaspicore.la
 
+# PROGRAMS
+##################################################
+noinst_PROGRAMS += plugins/spi/spi_output_benchmark
+
+plugins_spi_spi_output_benchmark_SOURCES = \
+    plugins/spi/spi_output_benchmark.cpp
+plugins_spi_spi_output_benchmark_LDADD = plugins/spi/libolaspicore.la \
+                                         common/libolacommon.la
+
 # TESTS
 ##################################################
 test_programs += plugins/spi/SPITester
@@ -73,6 +73,43 @@ using std::min;
 using std::string;
 using std::vector;
 
+namespace {
+
+// These build 256 entry lookup tables at compile time, by evaluating f(n)
+// for each slot value.
+#define SPI_TABLE_4(f, n) f(n), f((n) + 1), f((n) + 2), f((n) + 3)
+#define SPI_TABLE_16(f, n) \
+    SPI_TABLE_4(f, n), SPI_TABLE_4(f, (n) + 4), \
+    SPI_TABLE_4(f, (n) + 8), SPI_TABLE_4(f, (n) + 12)
+#define SPI_TABLE_64(f, n) \
+    SPI_TABLE_16(f, n), SPI_TABLE_16(f, (n) + 16), \
+    SPI_TABLE_16(f, (n) + 32), SPI_TABLE_16(f, (n) + 48)
+#define SPI_TABLE_256(f, n) \
+    SPI_TABLE_64(f, n), SPI_TABLE_64(f, (n) + 64), \
+    SPI_TABLE_64(f, (n) + 128), SPI_TABLE_64(f, (n) + 192)
+
+#define LPD8806_VALUE(n) static_cast<uint8_t>(0x80 | ((n) >> 1))
+#define APA102_HEADER(n) static_cast<uint8_t>(0xE0 | ((n) >> 3))
+
+// The LPD8806 takes 7 bits per color, with the high bit set.
+const uint8_t LPD8806_TABLE[256] = {
+  SPI_TABLE_256(LPD8806_VALUE, 0)
+};
+
+// The first byte of an APA102 LED frame, 3 bits of start mark (111) followed
+// by 5 bits of pixel brightness. The 8 bit DMX value is mapped to 0 - 31.
+const uint8_t APA102_HEADER_TABLE[256] = {
+  SPI_TABLE_256(APA102_HEADER, 0)
+};
+
+#undef APA102_HEADER
+#undef LPD8806_VALUE
+#undef SPI_TABLE_256
+#undef SPI_TABLE_64
+#undef SPI_TABLE_16
+#undef SPI_TABLE_4
+}  // namespace
+
 const uint16_t SPIOutput::SPI_DELAY = 0;
 const uint8_t SPIOutput::SPI_BITS_PER_WORD = 8;
 const uint8_t SPIOutput::SPI_MODE = 0;
@@ -94,7 +131,6 @@ const uint16_t SPIOutput::P9813_SPI_BYTES_PER_PIXEL = 4;
 const uint16_t SPIOutput::APA102_SPI_BYTES_PER_PIXEL = 4;
 
 const uint16_t SPIOutput::APA102_START_FRAME_BYTES = 4;
-const uint8_t SPIOutput::APA102_LEDFRAME_START_MARK = 0xE0;
 
 SPIOutput::RDMOps *SPIOutput::RDMOps::instance = NULL;
 
@@ -424,17 +460,15 @@ void SPIOutput::CombinedWS2801Control(const DmxBuffer &buffer) {
     return;
   }
 
-  for (unsigned int i = 0; i < m_pixel_count; i++) {
-    memcpy(output + (i * WS2801_SLOTS_PER_PIXEL), pixel_data,
-           pixel_data_length);
-  }
+  FillPixels(pixel_data, WS2801_SLOTS_PER_PIXEL, m_pixel_count, output);
   m_backend->Commit(m_output_number);
 }
 
 void SPIOutput::IndividualLPD8806Control(const DmxBuffer &buffer) {
   const uint8_t latch_bytes = (m_pixel_count + 31) / 32;
   const unsigned int first_slot = m_start_address - 1;  // 0 offset
-  if (buffer.Size() - first_slot < LPD8806_SLOTS_PER_PIXEL) {
+  const unsigned int available = AvailableSlots(buffer, first_slot);
+  if (available < LPD8806_SLOTS_PER_PIXEL) {
     // not even 3 bytes of data, don't bother updating
     return;
   }
@@ -447,19 +481,9 @@ void SPIOutput::IndividualLPD8806Control(const DmxBuffer &buffer) {
   if (!output)
     return;
 
-  const unsigned int length = min(m_pixel_count * LPD8806_SLOTS_PER_PIXEL,
-                                       buffer.Size() - first_slot);
-
-  for (unsigned int i = 0; i < length / LPD8806_SLOTS_PER_PIXEL; i++) {
-    // Convert RGB to GRB
-    unsigned int offset = first_slot + i * LPD8806_SLOTS_PER_PIXEL;
-    uint8_t r = buffer.Get(offset);
-    uint8_t g = buffer.Get(offset + 1);
-    uint8_t b = buffer.Get(offset + 2);
-    output[i * LPD8806_SLOTS_PER_PIXEL] = 0x80 | (g >> 1);
-    output[i * LPD8806_SLOTS_PER_PIXEL + 1] = 0x80 | (r >> 1);
-    output[i * LPD8806_SLOTS_PER_PIXEL + 2] = 0x80 | (b >> 1);
-  }
+  const unsigned int pixels = min(m_pixel_count,
+                                  available / LPD8806_SLOTS_PER_PIXEL);
+  EncodeLPD8806Pixels(buffer.GetRaw() + first_slot, pixels, output);
   m_backend->Commit(m_output_number);
 }
 
@@ -475,21 +499,15 @@ void SPIOutput::CombinedLPD8806Control(const DmxBuffer &buffer) {
     return;
   }
 
-  // The leds are GRB format so convert here
-  uint8_t temp = pixel_data[1];
-  pixel_data[1] = pixel_data[0];
-  pixel_data[0] = temp;
+  uint8_t encoded_data[LPD8806_SLOTS_PER_PIXEL];
+  EncodeLPD8806Pixels(pixel_data, 1, encoded_data);
 
   const unsigned int length = m_pixel_count * LPD8806_SLOTS_PER_PIXEL;
   uint8_t *output = m_backend->Checkout(m_output_number, length, latch_bytes);
   if (!output)
     return;
 
-  for (unsigned int i = 0; i < m_pixel_count; i++) {
-    for (unsigned int j = 0; j < LPD8806_SLOTS_PER_PIXEL; j++) {
-      output[i * LPD8806_SLOTS_PER_PIXEL + j] = 0x80 | (pixel_data[j] >> 1);
-    }
-  }
+  FillPixels(encoded_data, LPD8806_SLOTS_PER_PIXEL, m_pixel_count, output);
   m_backend->Commit(m_output_number);
 }
 
@@ -498,7 +516,8 @@ void SPIOutput::IndividualP9813Control(const DmxBuffer &buffer) {
   // the end
   const uint8_t latch_bytes = 3 * P9813_SPI_BYTES_PER_PIXEL;
   const unsigned int first_slot = m_start_address - 1;  // 0 offset
-  if (buffer.Size() - first_slot < P9813_SLOTS_PER_PIXEL) {
+  const unsigned int available = AvailableSlots(buffer, first_slot);
+  if (available < P9813_SLOTS_PER_PIXEL) {
     // not even 3 bytes of data, don't bother updating
     return;
   }
@@ -513,24 +532,22 @@ void SPIOutput::IndividualP9813Control(const DmxBuffer &buffer) {
     return;
   }
 
-  for (unsigned int i = 0; i < m_pixel_count; i++) {
-    // Convert RGB to P9813 Pixel
-    unsigned int offset = first_slot + i * P9813_SLOTS_PER_PIXEL;
-    // We need to avoid the first 4 bytes of the buffer since that acts as a
-    // start of frame delimiter
-    unsigned int spi_offset = (i + 1) * P9813_SPI_BYTES_PER_PIXEL;
-    uint8_t r = 0;
-    uint8_t b = 0;
-    uint8_t g = 0;
-    if (buffer.Size() - offset >= P9813_SLOTS_PER_PIXEL) {
-      r = buffer.Get(offset);
-      g = buffer.Get(offset + 1);
-      b = buffer.Get(offset + 2);
-    }
-    output[spi_offset] = P9813CreateFlag(r, g, b);
-    output[spi_offset + 1] = b;
-    output[spi_offset + 2] = g;
-    output[spi_offset + 3] = r;
+  // We need to avoid the first 4 bytes of the buffer since that acts as a
+  // start of frame delimiter
+  output += P9813_SPI_BYTES_PER_PIXEL;
+
+  const unsigned int pixels = min(m_pixel_count,
+                                  available / P9813_SLOTS_PER_PIXEL);
+  EncodeP9813Pixels(buffer.GetRaw() + first_slot, pixels, output);
+
+  // The pixels we don't have data for are set to black.
+  if (pixels < m_pixel_count) {
+    const uint8_t black[P9813_SLOTS_PER_PIXEL] = {0, 0, 0};
+    uint8_t encoded_black[P9813_SPI_BYTES_PER_PIXEL];
+    EncodeP9813Pixels(black, 1, encoded_black);
+    FillPixels(encoded_black, P9813_SPI_BYTES_PER_PIXEL,
+               m_pixel_count - pixels,
+               output + pixels * P9813_SPI_BYTES_PER_PIXEL);
   }
   m_backend->Commit(m_output_number);
 }
@@ -538,19 +555,16 @@ void SPIOutput::IndividualP9813Control(const DmxBuffer &buffer) {
 void SPIOutput::CombinedP9813Control(const DmxBuffer &buffer) {
   const uint8_t latch_bytes = 3 * P9813_SPI_BYTES_PER_PIXEL;
   const unsigned int first_slot = m_start_address - 1;  // 0 offset
+  const unsigned int available = AvailableSlots(buffer, first_slot);
 
-  if (buffer.Size() - first_slot < P9813_SLOTS_PER_PIXEL) {
+  if (available < P9813_SLOTS_PER_PIXEL) {
     OLA_INFO << "Insufficient DMX data, required " << P9813_SLOTS_PER_PIXEL
-             << ", got " << buffer.Size() - first_slot;
+             << ", got " << available;
     return;
   }
 
   uint8_t pixel_data[P9813_SPI_BYTES_PER_PIXEL];
-  pixel_data[3] = buffer.Get(first_slot);  // Get Red
-  pixel_data[2] = buffer.Get(first_slot + 1);  // Get Green
-  pixel_data[1] = buffer.Get(first_slot + 2);  // Get Blue
-  pixel_data[0] = P9813CreateFlag(pixel_data[3], pixel_data[2],
-                                  pixel_data[1]);
+  EncodeP9813Pixels(buffer.GetRaw() + first_slot, 1, pixel_data);
 
   const unsigned int length = m_pixel_count * P9813_SPI_BYTES_PER_PIXEL;
   uint8_t *output = m_backend->Checkout(m_output_number, length, latch_bytes);
@@ -558,10 +572,8 @@ void SPIOutput::CombinedP9813Control(const DmxBuffer &buffer) {
     return;
   }
 
-  for (unsigned int i = 0; i < m_pixel_count; i++) {
-    memcpy(&output[(i + 1) * P9813_SPI_BYTES_PER_PIXEL], pixel_data,
-           P9813_SPI_BYTES_PER_PIXEL);
-  }
+  FillPixels(pixel_data, P9813_SPI_BYTES_PER_PIXEL, m_pixel_count,
+             output + P9813_SPI_BYTES_PER_PIXEL);
   m_backend->Commit(m_output_number);
 }
 
@@ -588,11 +600,12 @@ void SPIOutput::IndividualAPA102Control(const DmxBuffer &buffer) {
 
   // calculate DMX-start-address
   const unsigned int first_slot = m_start_address - 1;  // 0 offset
+  const unsigned int available = AvailableSlots(buffer, first_slot);
 
   // only do something if at least 1 pixel can be updated..
-  if ((buffer.Size() - first_slot) < APA102_SLOTS_PER_PIXEL) {
+  if (available < APA102_SLOTS_PER_PIXEL) {
     OLA_INFO << "Insufficient DMX data, required " << APA102_SLOTS_PER_PIXEL
-             << ", got " << buffer.Size() - first_slot;
+             << ", got " << available;
     return;
   }
 
@@ -617,34 +630,18 @@ void SPIOutput::IndividualAPA102Control(const DmxBuffer &buffer) {
   if (m_output_number == 0) {
     // set APA102_START_FRAME_BYTES to zero
     memset(output, 0, APA102_START_FRAME_BYTES);
+    output += APA102_START_FRAME_BYTES;
   }
 
-  for (uint16_t i = 0; i < m_pixel_count; i++) {
-    // Convert RGB to APA102 Pixel
-    uint16_t offset = first_slot + (i * APA102_SLOTS_PER_PIXEL);
+  // only write pixel data if buffer has complete data for this pixel
+  const unsigned int pixels = min(m_pixel_count,
+                                  available / APA102_SLOTS_PER_PIXEL);
+  EncodeAPA102Pixels(buffer.GetRaw() + first_slot, pixels, output);
 
-
-    uint16_t spi_offset = (i * APA102_SPI_BYTES_PER_PIXEL);
-    // only skip APA102_START_FRAME_BYTES on the first port!!
-    if (m_output_number == 0) {
-      // We need to avoid the first 4 bytes of the buffer since that acts as a
-      // start of frame delimiter
-      spi_offset += APA102_START_FRAME_BYTES;
-    }
-    // set pixel data
-    // first Byte contains:
-    // 3 bits start mark (111) + 5 bits global brightness
-    // set global brightness fixed to 31 --> that reduces flickering
-    // that can be written as 0xE0 & 0x1F
-    output[spi_offset] = 0xFF;
-    // only write pixel data if buffer has complete data for this pixel:
-    if ((buffer.Size() - offset) >= APA102_SLOTS_PER_PIXEL) {
-      // Convert RGB to APA102 Pixel
-      // skip spi_offset + 0 (is already set)
-      output[spi_offset + 1] = buffer.Get(offset + 2);  // blue
-      output[spi_offset + 2] = buffer.Get(offset + 1);  // green
-      output[spi_offset + 3] = buffer.Get(offset);      // red
-    }
+  // The remaining pixels keep their color, but still need the LED frame
+  // start mark.
+  for (uint16_t i = pixels; i < m_pixel_count; i++) {
+    output[i * APA102_SPI_BYTES_PER_PIXEL] = 0xFF;
   }
 
   // write output back
@@ -665,11 +662,12 @@ void SPIOutput::IndividualAPA102ControlPixelBrightness(
 
   // calculate DMX-start-address
   const unsigned int first_slot = m_start_address - 1;  // 0 offset
+  const unsigned int available = AvailableSlots(buffer, first_slot);
 
   // only do something if at least 1 pixel can be updated..
-  if ((buffer.Size() - first_slot) < APA102_PB_SLOTS_PER_PIXEL) {
+  if (available < APA102_PB_SLOTS_PER_PIXEL) {
     OLA_INFO << "Insufficient DMX data, required " << APA102_PB_SLOTS_PER_PIXEL
-             << ", got " << buffer.Size() - first_slot;
+             << ", got " << available;
     return;
   }
 
@@ -694,33 +692,14 @@ void SPIOutput::IndividualAPA102ControlPixelBrightness(
   if (m_output_number == 0) {
     // set APA102_START_FRAME_BYTES to zero
     memset(output, 0, APA102_START_FRAME_BYTES);
+    output += APA102_START_FRAME_BYTES;
   }
 
-  for (uint16_t i = 0; i < m_pixel_count; i++) {
-    // Convert RGB to APA102 Pixel
-    uint16_t offset = first_slot + (i * APA102_PB_SLOTS_PER_PIXEL);
-
-    uint16_t spi_offset = (i * APA102_SPI_BYTES_PER_PIXEL);
-    // only skip APA102_START_FRAME_BYTES on the first port!!
-    if (m_output_number == 0) {
-      // We need to avoid the first 4 bytes of the buffer since that acts as a
-      // start of frame delimiter
-      spi_offset += APA102_START_FRAME_BYTES;
-    }
-    // set pixel data
-    // only write pixel data if buffer has complete data for this pixel:
-    if ((buffer.Size() - offset) >= APA102_PB_SLOTS_PER_PIXEL) {
-      // first Byte:
-      // 3 bits start mark (111) (APA102_LEDFRAME_START_MARK) +
-      // 5 bits pixel brightness (datasheet name: global brightness)
-      output[spi_offset + 0] = (SPIOutput::APA102_LEDFRAME_START_MARK |
-          CalculateAPA102PixelBrightness(buffer.Get(offset + 0)));
-      // Convert RGB to APA102 Pixel
-      output[spi_offset + 1] = buffer.Get(offset + 3);  // blue
-      output[spi_offset + 2] = buffer.Get(offset + 2);  // green
-      output[spi_offset + 3] = buffer.Get(offset + 1);  // red
-    }
-  }
+  // only write pixel data if buffer has complete data for this pixel
+  const unsigned int pixels = min(m_pixel_count,
+                                  available / APA102_PB_SLOTS_PER_PIXEL);
+  EncodeAPA102PixelBrightnessPixels(buffer.GetRaw() + first_slot, pixels,
+                                    output);
 
   // write output back
   m_backend->Commit(m_output_number);
@@ -731,11 +710,12 @@ void SPIOutput::CombinedAPA102Control(const DmxBuffer &buffer) {
 
   // calculate DMX-start-address
   const uint16_t first_slot = m_start_address - 1;  // 0 offset
+  const unsigned int available = AvailableSlots(buffer, first_slot);
 
   // check if enough data is there.
-  if ((buffer.Size() - first_slot) < APA102_SLOTS_PER_PIXEL) {
+  if (available < APA102_SLOTS_PER_PIXEL) {
     OLA_INFO << "Insufficient DMX data, required " << APA102_SLOTS_PER_PIXEL
-             << ", got " << buffer.Size() - first_slot;
+             << ", got " << available;
     return;
   }
 
@@ -760,24 +740,15 @@ void SPIOutput::CombinedAPA102Control(const DmxBuffer &buffer) {
   if (m_output_number == 0) {
     // set APA102_START_FRAME_BYTES to zero
     memset(output, 0, APA102_START_FRAME_BYTES);
+    output += APA102_START_FRAME_BYTES;
   }
 
   // create Pixel Data
   uint8_t pixel_data[APA102_SPI_BYTES_PER_PIXEL];
-  pixel_data[0] = 0xFF;
-  pixel_data[1] = buffer.Get(first_slot + 2);  // Get Blue
-  pixel_data[2] = buffer.Get(first_slot + 1);  // Get Green
-  pixel_data[3] = buffer.Get(first_slot);      // Get Red
+  EncodeAPA102Pixels(buffer.GetRaw() + first_slot, 1, pixel_data);
 
   // set all pixel to same value
-  for (uint16_t i = 0; i < m_pixel_count; i++) {
-    uint16_t spi_offset = (i * APA102_SPI_BYTES_PER_PIXEL);
-    if (m_output_number == 0) {
-      spi_offset += APA102_START_FRAME_BYTES;
-    }
-    memcpy(&output[spi_offset], pixel_data,
-           APA102_SPI_BYTES_PER_PIXEL);
-  }
+  FillPixels(pixel_data, APA102_SPI_BYTES_PER_PIXEL, m_pixel_count, output);
 
   // write output back...
   m_backend->Commit(m_output_number);
@@ -788,11 +759,12 @@ void SPIOutput::CombinedAPA102ControlPixelBrightness(const DmxBuffer &buffer) {
   // for Protocol details see IndividualAPA102Control
   // calculate DMX-start-address
   const uint16_t first_slot = m_start_address - 1;  // 0 offset
+  const unsigned int available = AvailableSlots(buffer, first_slot);
 
   // check if enough data is there.
-  if ((buffer.Size() - first_slot) < APA102_PB_SLOTS_PER_PIXEL) {
+  if (available < APA102_PB_SLOTS_PER_PIXEL) {
     OLA_INFO << "Insufficient DMX data, required " << APA102_PB_SLOTS_PER_PIXEL
-             << ", got " << buffer.Size() - first_slot;
+             << ", got " << available;
     return;
   }
 
@@ -817,29 +789,16 @@ void SPIOutput::CombinedAPA102ControlPixelBrightness(const DmxBuffer &buffer) {
   if (m_output_number == 0) {
     // set APA102_START_FRAME_BYTES to zero
     memset(output, 0, APA102_START_FRAME_BYTES);
+    output += APA102_START_FRAME_BYTES;
   }
 
   // create Pixel Data
   uint8_t pixel_data[APA102_SPI_BYTES_PER_PIXEL];
-  // first Byte:
-  // 3 bits start mark (111) (APA102_LEDFRAME_START_MARK) +
-  // 5 bits pixel brightness (datasheet name: global brightness)
-  pixel_data[0] = (SPIOutput::APA102_LEDFRAME_START_MARK |
-      CalculateAPA102PixelBrightness(buffer.Get(first_slot + 0)));
-  // color data
-  pixel_data[1] = buffer.Get(first_slot + 3);  // Get Blue
-  pixel_data[2] = buffer.Get(first_slot + 2);  // Get Green
-  pixel_data[3] = buffer.Get(first_slot + 1);  // Get Red
+  EncodeAPA102PixelBrightnessPixels(buffer.GetRaw() + first_slot, 1,
+                                    pixel_data);
 
   // set all pixel to same value
-  for (uint16_t i = 0; i < m_pixel_count; i++) {
-    uint16_t spi_offset = (i * APA102_SPI_BYTES_PER_PIXEL);
-    if (m_output_number == 0) {
-      spi_offset += APA102_START_FRAME_BYTES;
-    }
-    memcpy(&output[spi_offset], pixel_data,
-           APA102_SPI_BYTES_PER_PIXEL);
-  }
+  FillPixels(pixel_data, APA102_SPI_BYTES_PER_PIXEL, m_pixel_count, output);
 
   // write output back...
   m_backend->Commit(m_output_number);
@@ -862,16 +821,112 @@ uint8_t SPIOutput::CalculateAPA102LatchBytes(uint16_t pixel_count) {
   return latch_bytes;
 }
 
+/*
+ * The pixel encoders below convert pixel_count pixels of DMX data, which must
+ * all be present in input, into the SPI format. They don't branch per pixel,
+ * so the compiler is free to unroll and vectorize them.
+ */
+
+/**
+ * Convert RGB to LPD8806 GRB, 7 bits per color with the high bit set.
+ */
+void SPIOutput::EncodeLPD8806Pixels(const uint8_t *input,
+                                    unsigned int pixel_count,
+                                    uint8_t *output) {
+  for (unsigned int i = 0; i < pixel_count; i++) {
+    const uint8_t r = input[0];
+    const uint8_t g = input[1];
+    const uint8_t b = input[2];
+    output[0] = LPD8806_TABLE[g];
+    output[1] = LPD8806_TABLE[r];
+    output[2] = LPD8806_TABLE[b];
+    input += LPD8806_SLOTS_PER_PIXEL;
+    output += LPD8806_SLOTS_PER_PIXEL;
+  }
+}
+
+/**
+ * Convert RGB to a P9813 flag byte followed by BGR.
+ */
+void SPIOutput::EncodeP9813Pixels(const uint8_t *input,
+                                  unsigned int pixel_count,
+                                  uint8_t *output) {
+  for (unsigned int i = 0; i < pixel_count; i++) {
+    const uint8_t r = input[0];
+    const uint8_t g = input[1];
+    const uint8_t b = input[2];
+    output[0] = P9813CreateFlag(r, g, b);
+    output[1] = b;
+    output[2] = g;
+    output[3] = r;
+    input += P9813_SLOTS_PER_PIXEL;
+    output += P9813_SPI_BYTES_PER_PIXEL;
+  }
+}
+
+/**
+ * Convert RGB to an APA102 LED frame, at full brightness.
+ */
+void SPIOutput::EncodeAPA102Pixels(const uint8_t *input,
+                                   unsigned int pixel_count,
+                                   uint8_t *output) {
+  for (unsigned int i = 0; i < pixel_count; i++) {
+    // 3 bits start mark (111) + 5 bits global brightness
+    // set global brightness fixed to 31 --> that reduces flickering
+    output[0] = 0xFF;
+    output[1] = input[2];  // blue
+    output[2] = input[1];  // green
+    output[3] = input[0];  // red
+    input += APA102_SLOTS_PER_PIXEL;
+    output += APA102_SPI_BYTES_PER_PIXEL;
+  }
+}
+
+/**
+ * Convert brightness & RGB to an APA102 LED frame.
+ */
+void SPIOutput::EncodeAPA102PixelBrightnessPixels(const uint8_t *input,
+                                                  unsigned int pixel_count,
+                                                  uint8_t *output) {
+  for (unsigned int i = 0; i < pixel_count; i++) {
+    output[0] = APA102_HEADER_TABLE[input[0]];
+    output[1] = input[3];  // blue
+    output[2] = input[2];  // green
+    output[3] = input[1];  // red
+    input += APA102_PB_SLOTS_PER_PIXEL;
+    output += APA102_SPI_BYTES_PER_PIXEL;
+  }
+}
+
 /**
- * Calculate Pixel Brightness for APA102:
- * Map Input to Output range:
- * Input is 8bit value (0..255)
- * Output is 5bit value (0..31)
+ * Copy a single encoded pixel to pixel_count pixels of output. This doubles
+ * the amount copied each time, so long strings only need a few memcpy calls.
  */
-uint8_t SPIOutput::CalculateAPA102PixelBrightness(uint8_t brightness) {
-  return (brightness >> 3);
+void SPIOutput::FillPixels(const uint8_t *pixel_data,
+                           unsigned int pixel_size,
+                           unsigned int pixel_count,
+                           uint8_t *output) {
+  if (!pixel_count) {
+    return;
+  }
+
+  const unsigned int length = pixel_size * pixel_count;
+  memcpy(output, pixel_data, pixel_size);
+  unsigned int filled = pixel_size;
+  while (filled < length) {
+    const unsigned int chunk = min(filled, length - filled);
+    memcpy(output + filled, output, chunk);
+    filled += chunk;
+  }
 }
 
+/**
+ * Return the number of slots available from first_slot onwards.
+ */
+unsigned int SPIOutput::AvailableSlots(const DmxBuffer &buffer,
+                                       unsigned int first_slot) {
+  return buffer.Size() > first_slot ? buffer.Size() - first_slot : 0;
+}
 
 
 RDMResponse *SPIOutput::GetDeviceInfo(const RDMRequest *request) {
@@ -197,9 +197,26 @@ class SPIOutput: public ola::rdm::DiscoverableRDMControllerInterface {
       const ola::rdm::RDMRequest *request);
 
   // Helpers
-  uint8_t P9813CreateFlag(uint8_t red, uint8_t green, uint8_t blue);
+  static uint8_t P9813CreateFlag(uint8_t red, uint8_t green, uint8_t blue);
+  static void EncodeLPD8806Pixels(const uint8_t *input,
+                                  unsigned int pixel_count,
+                                  uint8_t *output);
+  static void EncodeP9813Pixels(const uint8_t *input,
+                                unsigned int pixel_count,
+                                uint8_t *output);
+  static void EncodeAPA102Pixels(const uint8_t *input,
+                                 unsigned int pixel_count,
+                                 uint8_t *output);
+  static void EncodeAPA102PixelBrightnessPixels(const uint8_t *input,
+                                                unsigned int pixel_count,
+                                                uint8_t *output);
+  static void FillPixels(const uint8_t *pixel_data,
+                         unsigned int pixel_size,
+                         unsigned int pixel_count,
+                         uint8_t *output);
+  static unsigned int AvailableSlots(const DmxBuffer &buffer,
+                                     unsigned int first_slot);
   static uint8_t CalculateAPA102LatchBytes(uint16_t pixel_count);
-  static uint8_t CalculateAPA102PixelBrightness(uint8_t brightness);
 
   static const uint8_t SPI_MODE;
   static const uint8_t SPI_BITS_PER_WORD;
@@ -213,7 +230,6 @@ class SPIOutput: public ola::rdm::DiscoverableRDMControllerInterface {
   static const uint16_t APA102_PB_SLOTS_PER_PIXEL;
   static const uint16_t APA102_SPI_BYTES_PER_PIXEL;
   static const uint16_t APA102_START_FRAME_BYTES;
-  static const uint8_t APA102_LEDFRAME_START_MARK;
 
   static const ola::rdm::ResponderOps<SPIOutput>::ParamHandler
       PARAM_HANDLERS[];
@@ -0,0 +1,108 @@
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * spi_output_benchmark.cpp
+ * Measure the frames per second each SPI personality can produce.
+ * Copyright (C) 2026 Simon Newton
+ */
+
+#include <stdlib.h>
+#include <iomanip>
+#include <iostream>
+#include "ola/Clock.h"
+#include "ola/Constants.h"
+#include "ola/DmxBuffer.h"
+#include "ola/base/Array.h"
+#include "ola/base/Flags.h"
+#include "ola/base/Init.h"
+#include "ola/rdm/UID.h"
+#include "plugins/spi/SPIBackend.h"
+#include "plugins/spi/SPIOutput.h"
+
+using ola::Clock;
+using ola::DmxBuffer;
+using ola::TimeInterval;
+using ola::TimeStamp;
+using ola::plugin::spi::FakeSPIBackend;
+using ola::plugin::spi::SPIOutput;
+using std::cout;
+using std::endl;
+
+DEFINE_s_uint32(iterations, i, 100000, "Number of frames per personality");
+DEFINE_s_uint8(pixel_count, p, 170, "Number of pixels on the output");
+
+struct Personality {
+  SPIOutput::SPI_PERSONALITY personality;
+  const char *name;
+};
+
+static const Personality PERSONALITIES[] = {
+  {SPIOutput::PERS_WS2801_INDIVIDUAL, "WS2801 Individual"},
+  {SPIOutput::PERS_WS2801_COMBINED, "WS2801 Combined"},
+  {SPIOutput::PERS_LDP8806_INDIVIDUAL, "LPD8806 Individual"},
+  {SPIOutput::PERS_LDP8806_COMBINED, "LPD8806 Combined"},
+  {SPIOutput::PERS_P9813_INDIVIDUAL, "P9813 Individual"},
+  {SPIOutput::PERS_P9813_COMBINED, "P9813 Combined"},
+  {SPIOutput::PERS_APA102_INDIVIDUAL, "APA102 Individual"},
+  {SPIOutput::PERS_APA102_COMBINED, "APA102 Combined"},
+  {SPIOutput::PERS_APA102_PB_INDIVIDUAL, "APA102 PB Individual"},
+  {SPIOutput::PERS_APA102_PB_COMBINED, "APA102 PB Combined"},
+};
+
+/**
+ * Write the buffer FLAGS_iterations times.
+ */
+TimeInterval TimeWrites(SPIOutput *output, const DmxBuffer &buffer) {
+  Clock clock;
+  TimeStamp start, end;
+  clock.CurrentTime(&start);
+  for (unsigned int i = 0; i < FLAGS_iterations; i++) {
+    output->WriteDMX(buffer);
+  }
+  clock.CurrentTime(&end);
+  return end - start;
+}
+
+int main(int argc, char* argv[]) {
+  ola::AppInit(&argc, argv, "[options]",
+               "Benchmark the SPI pixel conversion for each personality.");
+
+  uint8_t data[ola::DMX_UNIVERSE_SIZE];
+  for (unsigned int i = 0; i < arraysize(data); i++) {
+    data[i] = random();
+  }
+  DmxBuffer buffer(data, arraysize(data));
+
+  FakeSPIBackend backend(1);
+  SPIOutput::Options options(0, "Benchmark");
+  options.pixel_count = FLAGS_pixel_count;
+  SPIOutput output(ola::rdm::UID(0x7a70, 1), &backend, options);
+
+  cout << std::setw(22) << "personality" << std::setw(16) << "frames/s"
+       << std::setw(16) << "pixels/s" << endl;
+
+  for (unsigned int p = 0; p < arraysize(PERSONALITIES); p++) {
+    output.SetPersonality(PERSONALITIES[p].personality);
+    TimeInterval interval = TimeWrites(&output, buffer);
+    double frames_per_second = static_cast<double>(FLAGS_iterations) *
+                               ola::ONE_THOUSAND * ola::ONE_THOUSAND /
+                               interval.AsInt();
+    cout << std::setw(22) << PERSONALITIES[p].name
+         << std::setw(16) << std::fixed << std::setprecision(0)
+         << frames_per_second
+         << std::setw(16) << frames_per_second * FLAGS_pixel_count << endl;
+  }
+  return 0;
+}
@@ -30,6 +30,7 @@ namespace ola {
 namespace plugin {
 namespace uartdmx {
 
+using ola::thread::FrameTimer;
 using std::string;
 
 const char UartDmxDevice::K_MALF[] = "-malf";
@@ -41,11 +42,15 @@ const unsigned int UartDmxDevice::DEFAULT_MALF = 100;
 UartDmxDevice::UartDmxDevice(AbstractPlugin *owner,
                              class Preferences *preferences,
                              const string &name,
-                             const string &path)
+                             const string &path,
+                             const FrameTimer::Options &timer_options,
+                             ExportMap *export_map)
     : Device(owner, name),
       m_preferences(preferences),
       m_name(name),
-      m_path(path) {
+      m_path(path),
+      m_timer_options(timer_options),
+      m_export_map(export_map) {
   // set up some per-device default configuration if not already set
   SetDefaults();
   // now read per-device configuration
@@ -67,7 +72,8 @@ UartDmxDevice::~UartDmxDevice() {
 }
 
 bool UartDmxDevice::StartHook() {
-  AddPort(new UartDmxOutputPort(this, 0, m_widget.get(), m_breakt, m_malft));
+  AddPort(new UartDmxOutputPort(this, 0, m_widget.get(), m_breakt, m_malft,
+                                m_timer_options, m_export_map));
   return true;
 }
 
@@ -27,6 +27,8 @@
 #include <memory>
 #include "ola/DmxBuffer.h"
 #include "olad/Device.h"
+#include "ola/ExportMap.h"
+#include "ola/thread/FrameTimer.h"
 #include "olad/Preferences.h"
 #include "plugins/uartdmx/UartWidget.h"
 
@@ -39,7 +41,9 @@ class UartDmxDevice : public Device {
   UartDmxDevice(AbstractPlugin *owner,
                 class Preferences *preferences,
                 const std::string &name,
-                const std::string &path);
+                const std::string &path,
+                const ola::thread::FrameTimer::Options &timer_options,
+                ExportMap *export_map);
   ~UartDmxDevice();
 
   std::string DeviceId() const { return m_path; }
@@ -60,6 +64,8 @@ class UartDmxDevice : public Device {
   const std::string m_path;
   unsigned int m_breakt;
   unsigned int m_malft;
+  const ola::thread::FrameTimer::Options m_timer_options;
+  ExportMap *m_export_map;
 
   static const unsigned int DEFAULT_MALF;
   static const char K_MALF[];
@@ -44,7 +44,9 @@ using std::vector;
 
 const char UartDmxPlugin::PLUGIN_NAME[] = "UART native DMX";
 const char UartDmxPlugin::PLUGIN_PREFIX[] = "uartdmx";
+const char UartDmxPlugin::K_CPU[] = "cpu";
 const char UartDmxPlugin::K_DEVICE[] = "device";
+const char UartDmxPlugin::K_REALTIME[] = "realtime";
 const char UartDmxPlugin::DEFAULT_DEVICE[] = "/dev/ttyACM0";
 
 /*
@@ -55,6 +57,12 @@ bool UartDmxPlugin::StartHook() {
   vector<string> devices = m_preferences->GetMultipleValue(K_DEVICE);
   vector<string>::const_iterator iter;  // iterate over devices
 
+  ola::thread::FrameTimer::Options timer_options;
+  timer_options.realtime = m_preferences->GetValueAsBool(K_REALTIME);
+  if (!StringToInt(m_preferences->GetValue(K_CPU), &timer_options.cpu)) {
+    timer_options.cpu = -1;
+  }
+
   // start counting device ids from 0
 
   for (iter = devices.begin(); iter != devices.end(); ++iter) {
@@ -75,7 +83,8 @@ bool UartDmxPlugin::StartHook() {
     // can open device, so shut the temporary file descriptor
     close(fd);
     std::auto_ptr<UartDmxDevice> device(new UartDmxDevice(
-        this, m_preferences, PLUGIN_NAME, *iter));
+        this, m_preferences, PLUGIN_NAME, *iter, timer_options,
+        m_plugin_adaptor->GetExportMap()));
 
     // got a device, now lets see if we can configure it before we announce
     // it to the world
@@ -131,6 +140,8 @@ bool UartDmxPlugin::SetDefaultPreferences() {
   // only insert default device name, no others at this stage
   bool save = m_preferences->SetDefaultValue(K_DEVICE, StringValidator(),
                                              DEFAULT_DEVICE);
+  save |= m_preferences->SetDefaultValue(K_REALTIME, BoolValidator(), false);
+  save |= m_preferences->SetDefaultValue(K_CPU, IntValidator(-1, 1023), -1);
   if (save) {
     m_preferences->Save();
   }
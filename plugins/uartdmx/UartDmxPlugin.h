@@ -62,7 +62,9 @@ class UartDmxPlugin : public Plugin {
 
   static const char PLUGIN_NAME[];
   static const char PLUGIN_PREFIX[];
+  static const char K_CPU[];
   static const char K_DEVICE[];
+  static const char K_REALTIME[];
   static const char DEFAULT_DEVICE[];
 
   DISALLOW_COPY_AND_ASSIGN(UartDmxPlugin);
@@ -41,10 +41,12 @@ class UartDmxOutputPort : public ola::BasicOutputPort {
                     unsigned int id,
                     UartWidget *widget,
                     unsigned int breakt,
-                    unsigned int malft)
+                    unsigned int malft,
+                    const ola::thread::FrameTimer::Options &timer_options,
+                    ExportMap *export_map)
       : BasicOutputPort(parent, id),
         m_widget(widget),
-        m_thread(widget, breakt, malft) {
+        m_thread(widget, breakt, malft, timer_options, export_map) {
     m_thread.Start();
   }
   ~UartDmxOutputPort() { m_thread.Stop(); }
@@ -53,6 +55,9 @@ class UartDmxOutputPort : public ola::BasicOutputPort {
     return m_thread.WriteDMX(buffer);
   }
 
+  // The output thread sends the last frame until it's given a new one.
+  bool RepeatsLastFrame() const { return true; }
+
   std::string Description() const { return m_widget->Description(); }
 
  private:
@@ -19,10 +19,7 @@
  * Copyright (C) 2014 Richard Ash
  */
 
-#include <math.h>
-#include <unistd.h>
 #include <string>
-#include "ola/Clock.h"
 #include "ola/Logging.h"
 #include "ola/StringUtils.h"
 #include "plugins/uartdmx/UartWidget.h"
@@ -32,13 +29,17 @@ namespace ola {
 namespace plugin {
 namespace uartdmx {
 
-UartDmxThread::UartDmxThread(UartWidget *widget, unsigned int breakt,
-                             unsigned int malft)
-  : m_granularity(UNKNOWN),
-    m_widget(widget),
+UartDmxThread::UartDmxThread(
+    UartWidget *widget,
+    unsigned int breakt,
+    unsigned int malft,
+    const ola::thread::FrameTimer::Options &timer_options,
+    ExportMap *export_map)
+  : m_widget(widget),
     m_term(false),
     m_breakt(breakt),
-    m_malft(malft) {
+    m_malft(malft),
+    m_timer(0, timer_options, export_map, widget->Description()) {
 }
 
 UartDmxThread::~UartDmxThread() {
@@ -62,8 +63,8 @@ bool UartDmxThread::Stop() {
  * Copy a DMXBuffer to the output thread
  */
 bool UartDmxThread::WriteDMX(const DmxBuffer &buffer) {
-  ola::thread::MutexLocker locker(&m_buffer_mutex);
-  m_buffer.Set(buffer);
+  m_buffer.Writable()->Set(buffer);
+  m_buffer.Publish();
   return true;
 }
 
@@ -72,10 +73,8 @@ bool UartDmxThread::WriteDMX(const DmxBuffer &buffer) {
  * The method called by the thread
  */
 void *UartDmxThread::Run() {
-  TimeStamp ts1, ts2;
-  Clock clock;
-  CheckTimeGranularity();
   DmxBuffer buffer;
+  m_timer.SetupThread();
 
   // Setup the widget
   if (!m_widget->IsOpen())
@@ -88,54 +87,33 @@ void *UartDmxThread::Run() {
         break;
     }
 
-    {
-      ola::thread::MutexLocker locker(&m_buffer_mutex);
-      buffer.Set(m_buffer);
+    if (m_buffer.Update()) {
+      buffer.Set(m_buffer.Read());
     }
 
+    // Wait for the start of the next frame
+    m_timer.StartFrame();
+
     if (!m_widget->SetBreak(true))
-      goto framesleep;
+      continue;
 
-    if (m_granularity == GOOD)
-      usleep(m_breakt);
+    m_timer.Delay(m_breakt);
 
     if (!m_widget->SetBreak(false))
-      goto framesleep;
+      continue;
 
-    if (m_granularity == GOOD)
-      usleep(DMX_MAB);
+    m_timer.Delay(DMX_MAB);
 
     if (!m_widget->Write(buffer))
-      goto framesleep;
+      continue;
 
-  framesleep:
-    // Sleep for the remainder of the DMX frame time
-    usleep(m_malft);
+    // The write returns once the data is queued, so the next frame starts
+    // once the start code and slots have been sent, plus the MALF.
+    m_timer.SetFrameTime(m_breakt + DMX_MAB +
+                         (buffer.Size() + 1) * SLOT_TIME + m_malft);
   }
   return NULL;
 }
-
-
-/**
- * Check the granularity of usleep.
- */
-void UartDmxThread::CheckTimeGranularity() {
-  TimeStamp ts1, ts2;
-  Clock clock;
-  /** If sleeping for 1ms takes longer than this, don't trust
-   * usleep for this session
-   */
-  const int threshold = 3;
-
-  clock.CurrentTime(&ts1);
-  usleep(1000);
-  clock.CurrentTime(&ts2);
-
-  TimeInterval interval = ts2 - ts1;
-  m_granularity = interval.InMilliSeconds() > threshold ? BAD : GOOD;
-  OLA_INFO << "Granularity for UART thread is "
-           << (m_granularity == GOOD ? "GOOD" : "BAD");
-}
 }  // namespace uartdmx
 }  // namespace plugin
 }  // namespace ola
@@ -23,6 +23,9 @@
 #define PLUGINS_UARTDMX_UARTDMXTHREAD_H_
 
 #include "ola/DmxBuffer.h"
+#include "ola/ExportMap.h"
+#include "ola/thread/FrameTimer.h"
+#include "ola/thread/LatestValueSlot.h"
 #include "ola/thread/Thread.h"
 
 namespace ola {
@@ -31,7 +34,9 @@ namespace uartdmx {
 
 class UartDmxThread : public ola::thread::Thread {
  public:
-  UartDmxThread(UartWidget *widget, unsigned int breakt, unsigned int malft);
+  UartDmxThread(UartWidget *widget, unsigned int breakt, unsigned int malft,
+                const ola::thread::FrameTimer::Options &timer_options,
+                ExportMap *export_map);
   ~UartDmxThread();
 
   bool Stop();
@@ -39,20 +44,17 @@ class UartDmxThread : public ola::thread::Thread {
   bool WriteDMX(const DmxBuffer &buffer);
 
  private:
-  enum TimerGranularity { UNKNOWN, GOOD, BAD };
-
-  TimerGranularity m_granularity;
   UartWidget *m_widget;
   bool m_term;
   unsigned int m_breakt;
   unsigned int m_malft;
-  DmxBuffer m_buffer;
+  ola::thread::LatestValueSlot<DmxBuffer> m_buffer;
   ola::thread::Mutex m_term_mutex;
-  ola::thread::Mutex m_buffer_mutex;
-
-  void CheckTimeGranularity();
+  ola::thread::FrameTimer m_timer;
 
   static const uint32_t DMX_MAB = 16;
+  // The time to send one slot at 250kbps, in microseconds.
+  static const uint32_t SLOT_TIME = 44;
 
   DISALLOW_COPY_AND_ASSIGN(UartDmxThread);
 };
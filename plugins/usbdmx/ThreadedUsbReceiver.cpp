@@ -82,10 +82,8 @@ void *ThreadedUsbReceiver::Run() {
     }
 
     if (buffer_updated) {
-      {
-        ola::thread::MutexLocker locker(&m_data_mutex);
-        m_buffer.Set(buffer);
-      }
+      m_buffer.Writable()->Set(buffer);
+      m_buffer.Publish();
       if (m_receive_callback.get()) {
         m_plugin_adaptor->Execute(m_receive_callback.get());
       }
@@ -26,6 +26,7 @@
 #include "ola/base/Macro.h"
 #include "ola/Callback.h"
 #include "ola/DmxBuffer.h"
+#include "ola/thread/LatestValueSlot.h"
 #include "ola/thread/Thread.h"
 #include "olad/PluginAdaptor.h"
 
@@ -85,9 +86,14 @@ class ThreadedUsbReceiver: private ola::thread::Thread {
   /**
    * @brief Get DMX Buffer
    * @returns DmxBuffer with current input values.
+   *
+   * This should be called in the main thread.
    */
   const DmxBuffer &GetDmxInBuffer() const {
-    return m_buffer;
+    if (m_buffer.Update()) {
+      m_in_buffer.Set(m_buffer.Read());
+    }
+    return m_in_buffer;
   }
 
  protected:
@@ -112,8 +118,10 @@ class ThreadedUsbReceiver: private ola::thread::Thread {
   int const m_interface_number;
   PluginAdaptor* const m_plugin_adaptor;
   std::auto_ptr<Callback0<void> > m_receive_callback;
-  DmxBuffer m_buffer;
-  ola::thread::Mutex m_data_mutex;
+  // Written by the receiver thread, read by the main thread.
+  mutable ola::thread::LatestValueSlot<DmxBuffer> m_buffer;
+  // The main thread's copy, which may be shared with other DmxBuffers.
+  mutable DmxBuffer m_in_buffer;
   ola::thread::Mutex m_term_mutex;
 
   DISALLOW_COPY_AND_ASSIGN(ThreadedUsbReceiver);
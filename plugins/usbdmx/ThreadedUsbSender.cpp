@@ -33,7 +33,8 @@ ThreadedUsbSender::ThreadedUsbSender(libusb_device *usb_device,
     : m_term(false),
       m_usb_device(usb_device),
       m_usb_handle(usb_handle),
-      m_interface_number(interface_number) {
+      m_interface_number(interface_number),
+      m_timer(0) {
   libusb_ref_device(usb_device);
 }
 
@@ -69,12 +70,14 @@ void *ThreadedUsbSender::Run() {
         break;
     }
 
-    {
-      ola::thread::MutexLocker locker(&m_data_mutex);
-      buffer.Set(m_buffer);
+    if (m_buffer.Update()) {
+      buffer.Set(m_buffer.Read());
     }
 
     if (buffer.Size()) {
+      m_timer.SetFrameTime(DMX_BREAK + DMX_MAB +
+                           (buffer.Size() + 1) * SLOT_TIME);
+      m_timer.StartFrame();
       if (!TransmitBuffer(m_usb_handle, buffer)) {
         OLA_WARN << "Send failed, stopping thread...";
         break;
@@ -90,9 +93,9 @@ void *ThreadedUsbSender::Run() {
 }
 
 bool ThreadedUsbSender::SendDMX(const DmxBuffer &buffer) {
-  // Store the new data in the shared buffer.
-  ola::thread::MutexLocker locker(&m_data_mutex);
-  m_buffer.Set(buffer);
+  // Hand the new data to the sender thread.
+  m_buffer.Writable()->Set(buffer);
+  m_buffer.Publish();
   return true;
 }
 }  // namespace usbdmx
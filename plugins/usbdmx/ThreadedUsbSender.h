@@ -24,6 +24,8 @@
 #include <libusb.h>
 #include "ola/base/Macro.h"
 #include "ola/DmxBuffer.h"
+#include "ola/thread/FrameTimer.h"
+#include "ola/thread/LatestValueSlot.h"
 #include "ola/thread/Thread.h"
 
 namespace ola {
@@ -41,6 +43,10 @@ namespace usbdmx {
  * code, leaving the subclass to implement TransmitBuffer(), which performs the
  * actual transfer.
  *
+ * Transfers are paced with a FrameTimer, so a widget that returns from a
+ * transfer quickly isn't sent frames faster than they can be output on the
+ * DMX line.
+ *
  * ThreadedUsbSender can be used as a building block for synchronous widgets.
  */
 class ThreadedUsbSender: private ola::thread::Thread {
@@ -94,9 +100,14 @@ class ThreadedUsbSender: private ola::thread::Thread {
   libusb_device* const m_usb_device;
   libusb_device_handle* const m_usb_handle;
   int const m_interface_number;
-  DmxBuffer m_buffer;
-  ola::thread::Mutex m_data_mutex;
+  ola::thread::LatestValueSlot<DmxBuffer> m_buffer;
   ola::thread::Mutex m_term_mutex;
+  ola::thread::FrameTimer m_timer;
+
+  // The minimum break, MAB and slot times from E1.11, in microseconds.
+  static const unsigned int DMX_BREAK = 92;
+  static const unsigned int DMX_MAB = 12;
+  static const unsigned int SLOT_TIME = 44;
 
   DISALLOW_COPY_AND_ASSIGN(ThreadedUsbSender);
 };
@@ -861,6 +861,31 @@ class OlaClient(Ola_pb2.OlaClientService):
       raise OLADNotRunningException()
     return True
 
+  def FetchDmxBatch(self, universes, callback):
+    """Fetch DMX data for many universes from the server
+
+    Args:
+      universes: a list of universes to fetch the data for
+      callback: The function to call once complete, takes two arguments, a
+        RequestStatus object and a list of (universe, dmx data) tuples.
+
+    Returns:
+      True if the request was sent, False otherwise.
+    """
+    if self._socket is None:
+      return False
+
+    controller = SimpleRpcController()
+    request = Ola_pb2.UniverseBatchRequest()
+    request.universe.extend(universes)
+    try:
+      self._stub.GetDmxBatch(
+          controller, request,
+          lambda x, y: self._GetDmxBatchComplete(callback, x, y))
+    except socket.error:
+      raise OLADNotRunningException()
+    return True
+
   def SendDmx(self, universe, data, callback=None):
     """Send DMX data to the server
 
@@ -888,6 +913,39 @@ class OlaClient(Ola_pb2.OlaClientService):
       raise OLADNotRunningException()
     return True
 
+  def SendDmxBatch(self, frames, callback=None):
+    """Send DMX data for many universes to the server in a single request.
+
+    If any of the universes don't exist, none of the data is applied.
+
+    Args:
+      frames: a list of (universe, data) or (universe, data, priority)
+        tuples, where data is an array object with the DMX data
+      callback: The function to call once complete, takes one argument, a
+        RequestStatus object.
+
+    Returns:
+      True if the request was sent, False otherwise.
+    """
+    if self._socket is None:
+      return False
+
+    controller = SimpleRpcController()
+    request = Ola_pb2.DmxDataBatch()
+    for frame in frames:
+      dmx_data = request.data.add()
+      dmx_data.universe = frame[0]
+      dmx_data.data = frame[1].tostring()
+      if len(frame) > 2:
+        dmx_data.priority = frame[2]
+    try:
+      self._stub.UpdateDmxDataBatch(
+          controller, request,
+          lambda x, y: self._AckMessageComplete(callback, x, y))
+    except socket.error:
+      raise OLADNotRunningException()
+    return True
+
   def SetUniverseName(self, universe, name, callback=None):
     """Set the name of a universe.
 
@@ -1402,6 +1460,28 @@ class OlaClient(Ola_pb2.OlaClientService):
 
     callback(status, universe, data)
 
+  def _GetDmxBatchComplete(self, callback, controller, response):
+    """Called when the GetDmxBatch request returns.
+
+    Args:
+      callback: the callback to run
+      controller: an RpcController
+      response: a DmxDataBatch message.
+    """
+    if not callback:
+      return
+    status = RequestStatus(controller)
+    frames = None
+
+    if status.Succeeded():
+      frames = []
+      for dmx_data in response.data:
+        data = array.array('B')
+        data.fromstring(dmx_data.data)
+        frames.append((dmx_data.universe, data))
+
+    callback(status, frames)
+
   def _AckMessageComplete(self, callback, controller, response):
     """Called when an rpc that returns an Ack completes.
 